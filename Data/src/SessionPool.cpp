@@ -15,6 +15,7 @@
 #include "Poco/Data/SessionPool.h"
 #include "Poco/Data/SessionFactory.h"
 #include "Poco/Data/DataException.h"
+#include "Poco/MetricRegistry.h"
 #include <algorithm>
 
 
@@ -22,6 +23,37 @@ namespace Poco {
 namespace Data {
 
 
+namespace
+{
+	struct SessionPoolMetrics
+	{
+		SessionPoolMetrics():
+			acquired(Poco::MetricRegistry::defaultRegistry().counter("poco_data_sessionpool_sessions_acquired_total",
+				"Total number of sessions obtained from session pools.")),
+			created(Poco::MetricRegistry::defaultRegistry().counter("poco_data_sessionpool_sessions_created_total",
+				"Total number of sessions created by session pools.")),
+			exhausted(Poco::MetricRegistry::defaultRegistry().counter("poco_data_sessionpool_exhausted_total",
+				"Total number of session requests that failed because a session pool was exhausted.")),
+			active(Poco::MetricRegistry::defaultRegistry().gauge("poco_data_sessionpool_sessions_active",
+				"Number of pooled sessions currently in use."))
+		{
+		}
+
+		Poco::MetricCounter& acquired;
+		Poco::MetricCounter& created;
+		Poco::MetricCounter& exhausted;
+		Poco::MetricGauge&   active;
+	};
+
+
+	SessionPoolMetrics& sessionPoolMetrics()
+	{
+		static SessionPoolMetrics metrics;
+		return metrics;
+	}
+}
+
+
 SessionPool::SessionPool(const std::string& connector, const std::string& connectionString, int minSessions, int maxSessions, int idleTime):
 	_connector(connector),
 	_connectionString(connectionString),
@@ -79,8 +111,13 @@ Session SessionPool::get()
 			PooledSessionHolderPtr pHolder(new PooledSessionHolder(*this, newSession.impl()));
 			_idleSessions.push_front(pHolder);
 			++_nSessions;
+			sessionPoolMetrics().created.inc();
+		}
+		else
+		{
+			sessionPoolMetrics().exhausted.inc();
+			throw SessionPoolExhaustedException(_connector);
 		}
-		else throw SessionPoolExhaustedException(_connector);
 	}
 
 	PooledSessionHolderPtr pHolder(_idleSessions.front());
@@ -88,6 +125,8 @@ Session SessionPool::get()
 	
 	_activeSessions.push_front(pHolder);
 	_idleSessions.pop_front();
+	sessionPoolMetrics().acquired.inc();
+	sessionPoolMetrics().active.inc();
 	return Session(pPSI);
 }
 
@@ -253,6 +292,7 @@ void SessionPool::putBack(PooledSessionHolderPtr pHolder)
 		else --_nSessions;
 
 		_activeSessions.erase(it);
+		sessionPoolMetrics().active.dec();
 	}
 	else
 	{
@@ -288,6 +328,7 @@ void SessionPool::shutdown()
 	_shutdown = true;
 	_janitorTimer.stop();
 	closeAll(_idleSessions);
+	sessionPoolMetrics().active.dec(static_cast<Poco::Int64>(_activeSessions.size()));
 	closeAll(_activeSessions);
 }
 
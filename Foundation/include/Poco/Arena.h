@@ -0,0 +1,197 @@
+//
+// Arena.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  Arena
+//
+// Definition of the Arena class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Arena_INCLUDED
+#define Foundation_Arena_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API Arena
+	/// A monotonic (bump-pointer) memory arena.
+	///
+	/// Memory is handed out from a chain of blocks by simply
+	/// advancing a pointer. Individual deallocations are
+	/// no-ops (with the exception of the most recent allocation,
+	/// which can be given back), and all memory is released
+	/// at once when the Arena is reset or destroyed.
+	///
+	/// The main purpose of this class is to speed-up
+	/// allocation of many small, short-lived objects that
+	/// all die together, such as the objects created while
+	/// processing a single request (parsed JSON, HTML forms,
+	/// header maps, Dynamic::Var trees, etc.).
+	///
+	/// An optional initial buffer (e.g., a char array on the
+	/// stack) can be given to the Arena. It will be used before
+	/// any memory is allocated from the heap.
+	///
+	/// Objects placed into an Arena are not destroyed by the
+	/// Arena; it is up to the user to call destructors, if
+	/// necessary. See ArenaAllocator for using an Arena with
+	/// standard containers.
+	///
+	/// This class is not thread-safe.
+{
+public:
+	enum
+	{
+		DEFAULT_BLOCK_SIZE = 4096
+	};
+
+	explicit Arena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+		/// Creates an Arena that allocates heap blocks
+		/// of the given size.
+
+	Arena(void* pBuffer, std::size_t bufferSize, std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+		/// Creates an Arena that first uses the given buffer
+		/// before allocating heap blocks of the given size.
+		///
+		/// The buffer is not owned by the Arena and must remain
+		/// valid for the lifetime of the Arena.
+
+	~Arena();
+		/// Destroys the Arena and releases all heap blocks.
+
+	void* allocate(std::size_t size, std::size_t alignment = MAX_ALIGNMENT);
+		/// Returns a pointer to size bytes of memory, aligned
+		/// to the given alignment, which must be a power of two.
+		///
+		/// Requests larger than the block size are satisfied
+		/// with a dedicated heap block.
+
+	void deallocate(void* ptr, std::size_t size);
+		/// Gives the memory back to the Arena, if ptr is the
+		/// most recent allocation. Otherwise, does nothing.
+
+	void reset();
+		/// Releases all heap blocks and makes the initial
+		/// buffer (if any) available again.
+		///
+		/// All pointers obtained from the Arena become
+		/// invalid.
+
+	std::size_t blockSize() const;
+		/// Returns the size of the heap blocks.
+
+	std::size_t allocated() const;
+		/// Returns the number of bytes handed out since the
+		/// Arena has been created or last reset, not counting
+		/// alignment padding.
+
+	std::size_t capacity() const;
+		/// Returns the total size of the initial buffer
+		/// and all heap blocks currently owned by the Arena.
+
+	int blocks() const;
+		/// Returns the number of heap blocks currently owned
+		/// by the Arena.
+
+	static const std::size_t MAX_ALIGNMENT;
+		/// The default alignment, suitable for any scalar type.
+
+private:
+	Arena(const Arena&);
+	Arena& operator = (const Arena&);
+
+	struct Block
+	{
+		Block*      pNext;
+		std::size_t size;
+	};
+
+	void* allocateSlow(std::size_t size, std::size_t alignment);
+	void freeBlocks();
+
+	char*       _pCurrent;
+	char*       _pEnd;
+	char*       _pLast;
+	Block*      _pBlocks;
+	char*       _pBuffer;
+	std::size_t _bufferSize;
+	std::size_t _blockSize;
+	std::size_t _allocated;
+	std::size_t _capacity;
+	int         _blockCount;
+};
+
+
+//
+// inlines
+//
+inline void* Arena::allocate(std::size_t size, std::size_t alignment)
+{
+	poco_assert_dbg (alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	if (_pCurrent)
+	{
+		std::size_t misalign = reinterpret_cast<std::size_t>(_pCurrent) & (alignment - 1);
+		std::size_t padding = misalign ? alignment - misalign : 0;
+		if (padding + size <= static_cast<std::size_t>(_pEnd - _pCurrent))
+		{
+			_pLast = _pCurrent + padding;
+			_pCurrent = _pLast + size;
+			_allocated += size;
+			return _pLast;
+		}
+	}
+	return allocateSlow(size, alignment);
+}
+
+
+inline void Arena::deallocate(void* ptr, std::size_t size)
+{
+	if (ptr && ptr == _pLast && _pLast + size == _pCurrent)
+	{
+		_pCurrent = _pLast;
+		_allocated -= size;
+	}
+}
+
+
+inline std::size_t Arena::blockSize() const
+{
+	return _blockSize;
+}
+
+
+inline std::size_t Arena::allocated() const
+{
+	return _allocated;
+}
+
+
+inline std::size_t Arena::capacity() const
+{
+	return _capacity;
+}
+
+
+inline int Arena::blocks() const
+{
+	return _blockCount;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Arena_INCLUDED
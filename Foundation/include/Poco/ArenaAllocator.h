@@ -0,0 +1,166 @@
+//
+// ArenaAllocator.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  Arena
+//
+// Definition of the ArenaAllocator class template.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ArenaAllocator_INCLUDED
+#define Foundation_ArenaAllocator_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Arena.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+
+namespace Poco {
+
+
+template <typename T>
+class ArenaAllocator
+	/// A standard library compatible allocator that obtains
+	/// its memory from an Arena.
+	///
+	/// A default-constructed ArenaAllocator is not bound to an
+	/// Arena and uses the global operator new and operator delete,
+	/// so containers using an ArenaAllocator behave exactly like
+	/// containers using std::allocator unless an Arena is given.
+	///
+	/// When a container is copied, the copy does not inherit the
+	/// Arena of the original; it allocates from the heap instead.
+	/// This makes it safe to copy data out of an Arena whose
+	/// lifetime ends. Moving or swapping containers, however,
+	/// propagates the Arena.
+	///
+	/// Example:
+	///     char buffer[1024];
+	///     Poco::Arena arena(buffer, sizeof(buffer));
+	///     std::vector<int, Poco::ArenaAllocator<int> > vec(Poco::ArenaAllocator<int>(arena));
+	///     vec.push_back(42);
+{
+public:
+	typedef T                 value_type;
+	typedef T*                pointer;
+	typedef const T*          const_pointer;
+	typedef T&                reference;
+	typedef const T&          const_reference;
+	typedef std::size_t       size_type;
+	typedef std::ptrdiff_t    difference_type;
+
+	typedef std::false_type   propagate_on_container_copy_assignment;
+	typedef std::true_type    propagate_on_container_move_assignment;
+	typedef std::true_type    propagate_on_container_swap;
+
+	template <typename U>
+	struct rebind
+	{
+		typedef ArenaAllocator<U> other;
+	};
+
+	ArenaAllocator():
+		_pArena(0)
+		/// Creates an ArenaAllocator using the heap.
+	{
+	}
+
+	ArenaAllocator(Arena& arena):
+		_pArena(&arena)
+		/// Creates an ArenaAllocator using the given Arena.
+	{
+	}
+
+	ArenaAllocator(const ArenaAllocator& other):
+		_pArena(other._pArena)
+		/// Creates an ArenaAllocator using the same Arena as other.
+	{
+	}
+
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other):
+		_pArena(other.arena())
+		/// Creates an ArenaAllocator using the same Arena as other.
+	{
+	}
+
+	~ArenaAllocator()
+		/// Destroys the ArenaAllocator.
+	{
+	}
+
+	ArenaAllocator& operator = (const ArenaAllocator& other)
+		/// Assigns another ArenaAllocator.
+	{
+		_pArena = other._pArena;
+		return *this;
+	}
+
+	T* allocate(std::size_t n)
+		/// Allocates memory for n objects of type T.
+	{
+		if (_pArena)
+			return static_cast<T*>(_pArena->allocate(n*sizeof(T), alignof(T)));
+		else
+			return static_cast<T*>(::operator new(n*sizeof(T)));
+	}
+
+	void deallocate(T* p, std::size_t n)
+		/// Releases the memory pointed to by p.
+		///
+		/// If the memory has been obtained from an Arena,
+		/// it is only reclaimed when the Arena is reset,
+		/// unless p is the Arena's most recent allocation.
+	{
+		if (_pArena)
+			_pArena->deallocate(p, n*sizeof(T));
+		else
+			::operator delete(p);
+	}
+
+	ArenaAllocator select_on_container_copy_construction() const
+		/// Returns a heap-based ArenaAllocator for copies of
+		/// containers, so that copies never outlive the Arena.
+	{
+		return ArenaAllocator();
+	}
+
+	Arena* arena() const
+		/// Returns the Arena, or null if the allocator uses the heap.
+	{
+		return _pArena;
+	}
+
+private:
+	Arena* _pArena;
+};
+
+
+template <typename T, typename U>
+inline bool operator == (const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2)
+{
+	return a1.arena() == a2.arena();
+}
+
+
+template <typename T, typename U>
+inline bool operator != (const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2)
+{
+	return a1.arena() != a2.arena();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ArenaAllocator_INCLUDED
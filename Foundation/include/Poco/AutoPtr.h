@@ -79,6 +79,13 @@ public:
 		if (_ptr) _ptr->duplicate(); // NOLINT
 	}
 
+	AutoPtr(AutoPtr&& ptr) noexcept: _ptr(ptr._ptr)
+		/// Takes over the reference from ptr, without changing
+		/// the reference count. ptr is null afterwards.
+	{
+		ptr._ptr = 0;
+	}
+
 	template <class Other>
 	AutoPtr(const AutoPtr<Other>& ptr): _ptr(const_cast<Other*>(ptr.get()))
 	{
@@ -174,6 +181,17 @@ public:
 		return assign(ptr);
 	}
 
+	AutoPtr& operator = (AutoPtr&& ptr) noexcept
+	{
+		if (&ptr != this)
+		{
+			if (_ptr) _ptr->release();
+			_ptr = ptr._ptr;
+			ptr._ptr = 0;
+		}
+		return *this;
+	}
+
 	template <class Other>
 	AutoPtr& operator = (const AutoPtr<Other>& ptr)
 	{
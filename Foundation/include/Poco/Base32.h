@@ -0,0 +1,101 @@
+//
+// Base32.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base32
+//
+// Definition of class Base32.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Base32_INCLUDED
+#define Foundation_Base32_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <string>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API Base32
+	/// Base32 encoding and decoding of memory buffers,
+	/// as specified in RFC 4648.
+	///
+	/// In contrast to Base32Encoder and Base32Decoder, which
+	/// transform streams, these functions transform entire
+	/// buffers at once, five bytes at a time.
+{
+public:
+	static std::size_t encodedLength(std::size_t length, bool padding = true);
+		/// Returns the length of the encoding of length bytes.
+
+	static std::size_t encode(const void* data, std::size_t length, char* encoded, bool padding = true);
+		/// Encodes length bytes from data into the encoded buffer,
+		/// which must have room for encodedLength(length, padding)
+		/// characters. Returns the number of characters written.
+
+	static std::string encode(const void* data, std::size_t length, bool padding = true);
+		/// Returns the encoding of length bytes from data.
+
+	static std::string encode(const std::string& data, bool padding = true);
+		/// Returns the encoding of data.
+
+	static std::size_t decodedLength(std::size_t length);
+		/// Returns the maximum length of the data decoded
+		/// from length characters.
+
+	static std::size_t decode(const char* encoded, std::size_t length, void* data);
+		/// Decodes length characters from encoded into the data
+		/// buffer, which must have room for decodedLength(length)
+		/// bytes. Padding is optional. Returns the number of bytes
+		/// written.
+		///
+		/// Throws a DataFormatException if the encoded data is
+		/// invalid.
+
+	static std::string decode(const std::string& encoded);
+		/// Returns the data decoded from encoded.
+
+private:
+	Base32();
+};
+
+
+//
+// inlines
+//
+inline std::size_t Base32::encodedLength(std::size_t length, bool padding)
+{
+	static const std::size_t rest[] = {0, 2, 4, 5, 7};
+	if (padding)
+		return (length + 4)/5*8;
+	else
+		return length/5*8 + rest[length % 5];
+}
+
+
+inline std::size_t Base32::decodedLength(std::size_t length)
+{
+	return (length + 7)/8*5;
+}
+
+
+inline std::string Base32::encode(const std::string& data, bool padding)
+{
+	return encode(data.data(), data.size(), padding);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Base32_INCLUDED
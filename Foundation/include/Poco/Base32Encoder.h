@@ -45,6 +45,12 @@ public:
 
 private:
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize n);
+
+	enum
+	{
+		BLOCK_SIZE = 5*512
+	};
 
 	unsigned char   _group[5];
 	int             _groupLength;
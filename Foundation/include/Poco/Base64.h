@@ -0,0 +1,104 @@
+//
+// Base64.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base64
+//
+// Definition of class Base64.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Base64_INCLUDED
+#define Foundation_Base64_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Base64Encoder.h"
+#include <string>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API Base64
+	/// Base64 encoding and decoding of memory buffers.
+	///
+	/// In contrast to Base64Encoder and Base64Decoder, which
+	/// transform streams, these functions transform entire
+	/// buffers at once, using SSSE3 or AVX2 instructions if
+	/// supported by the processor. They support the same
+	/// options (BASE64_URL_ENCODING, BASE64_NO_PADDING), but
+	/// never insert line breaks, and do not accept whitespace
+	/// in encoded data.
+{
+public:
+	static std::size_t encodedLength(std::size_t length, int options = 0);
+		/// Returns the length of the encoding of length bytes.
+
+	static std::size_t encode(const void* data, std::size_t length, char* encoded, int options = 0);
+		/// Encodes length bytes from data into the encoded buffer,
+		/// which must have room for encodedLength(length, options)
+		/// characters. Returns the number of characters written.
+
+	static std::string encode(const void* data, std::size_t length, int options = 0);
+		/// Returns the encoding of length bytes from data.
+
+	static std::string encode(const std::string& data, int options = 0);
+		/// Returns the encoding of data.
+
+	static std::size_t decodedLength(std::size_t length);
+		/// Returns the maximum length of the data decoded
+		/// from length characters.
+
+	static std::size_t decode(const char* encoded, std::size_t length, void* data, int options = 0);
+		/// Decodes length characters from encoded into the data
+		/// buffer, which must have room for decodedLength(length)
+		/// bytes. Returns the number of bytes written.
+		///
+		/// Throws a DataFormatException if the encoded data is
+		/// invalid, or incomplete (the length must be a multiple of
+		/// four unless BASE64_NO_PADDING is given).
+
+	static std::string decode(const std::string& encoded, int options = 0);
+		/// Returns the data decoded from encoded.
+
+private:
+	Base64();
+};
+
+
+//
+// inlines
+//
+inline std::size_t Base64::encodedLength(std::size_t length, int options)
+{
+	if (options & BASE64_NO_PADDING)
+		return (length/3)*4 + (length % 3 ? length % 3 + 1 : 0);
+	else
+		return (length + 2)/3*4;
+}
+
+
+inline std::size_t Base64::decodedLength(std::size_t length)
+{
+	return (length + 3)/4*3;
+}
+
+
+inline std::string Base64::encode(const std::string& data, int options)
+{
+	return encode(data.data(), data.size(), options);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Base64_INCLUDED
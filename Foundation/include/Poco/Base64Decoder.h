@@ -43,6 +43,13 @@ public:
 private:
 	int readFromDevice();
 	int readOne();
+	std::streamsize xsgetn(char* s, std::streamsize n);
+	std::size_t readEncoded(char* buffer, std::size_t length);
+
+	enum
+	{
+		BLOCK_SIZE = 4*1024
+	};
 
 	int             _options;
 	unsigned char   _group[3];
@@ -69,6 +69,12 @@ public:
 
 private:
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize n);
+
+	enum
+	{
+		BLOCK_SIZE = 3*1024
+	};
 
 	int             _options;
 	unsigned char   _group[3];
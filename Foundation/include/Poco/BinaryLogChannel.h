@@ -0,0 +1,167 @@
+//
+// BinaryLogChannel.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Definition of the BinaryLogChannel class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BinaryLogChannel_INCLUDED
+#define Foundation_BinaryLogChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Channel.h"
+#include "Poco/SharedMemory.h"
+#include "Poco/FlatHashMap.h"
+#include "Poco/Mutex.h"
+
+
+namespace Poco {
+
+
+class Foundation_API BinaryLogChannel: public Channel
+	/// A channel that writes messages in a compact binary
+	/// format to a memory-mapped file.
+	///
+	/// Unlike FileChannel, BinaryLogChannel does not format
+	/// messages. Every message is stored as a length-prefixed
+	/// binary record containing the timestamp, priority,
+	/// process and thread IDs, the message text, the source
+	/// file location and all message parameters. Message sources,
+	/// thread names and source file names are interned: each
+	/// distinct string is written only once per file, and
+	/// subsequent records refer to it by a numeric ID.
+	///
+	/// The log file is preallocated to the rotation size and
+	/// mapped into memory, so logging a message amounts to
+	/// copying its fields into the mapped region. When the file
+	/// is full, it is renamed to <path>.<n> (where n is an
+	/// increasing number) and a new file is started.
+	/// On close, the file is truncated to its actual size.
+	/// If the process terminates unexpectedly, all records logged
+	/// so far remain in the file (the operating system
+	/// writes them back from the page cache), followed by
+	/// zero bytes up to the preallocated size.
+	///
+	/// Use BinaryLogReader to read the messages from a
+	/// binary log file, e.g. for converting them to text
+	/// with a PatternFormatter (see the BinaryLogDecoder sample).
+	///
+	/// Records are written in the byte order of the writing
+	/// machine. BinaryLogReader detects the byte order from the file header.
+	///
+	/// The BinaryLogChannel supports the following properties:
+	///   * path:       The path of the log file.
+	///   * rotation:   The size of the log file, in bytes, or
+	///                 with a K or M suffix (e.g., "64 M").
+	///                 The default is 16 M.
+	///   * purgeCount: The maximum number of archived log files
+	///                 to keep. If not set (default), archived
+	///                 files are never purged.
+{
+public:
+	enum RecordType
+	{
+		RECORD_MESSAGE = 1, /// A log message.
+		RECORD_SOURCE  = 2, /// Definition of an interned message source.
+		RECORD_THREAD  = 3, /// Definition of an interned thread name.
+		RECORD_FILE    = 4  /// Definition of an interned source file name.
+	};
+
+	enum
+	{
+		FILE_MAGIC      = 0x474C4250, /// "PBLG" in little endian byte order.
+		FILE_VERSION    = 1,
+		FILE_HEADER_SIZE = 8,          /// magic (4), version (2), byte order mark (2).
+		RECORD_HEADER_SIZE = 5,        /// record size (4), record type (1).
+		MESSAGE_FIXED_SIZE = 47,       /// time (8), priority (1), source, thread (4 each), tid, pid (8 each), file (4), line (4), text size (4), parameter count (2).
+		DEFAULT_ROTATION = 16*1024*1024
+	};
+
+	BinaryLogChannel();
+		/// Creates the BinaryLogChannel.
+
+	BinaryLogChannel(const std::string& path);
+		/// Creates the BinaryLogChannel with the given path.
+
+	void open();
+		/// Opens the BinaryLogChannel and creates and maps the log file.
+
+	void close();
+		/// Closes the BinaryLogChannel, truncating the
+		/// log file to its actual size.
+
+	void log(const Message& msg);
+		/// Writes the binary record of the message to the log file.
+
+	void setProperty(const std::string& name, const std::string& value);
+		/// Sets the property with the given name to the given value.
+		///
+		/// See the class documentation for supported properties.
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the property with the given name.
+
+	const std::string& path() const;
+		/// Returns the log file's path.
+
+	UInt64 size() const;
+		/// Returns the number of bytes written to the current log file.
+
+	static const std::string PROP_PATH;
+	static const std::string PROP_ROTATION;
+	static const std::string PROP_PURGECOUNT;
+
+protected:
+	~BinaryLogChannel();
+
+	void unsafeOpen(std::size_t minSize);
+	void unsafeClose();
+	void rotate(std::size_t minSize);
+	void purge();
+	UInt32 intern(FlatHashMap<std::string, UInt32>& table, const std::string& str, RecordType type);
+	UInt32 internFile(const char* file);
+	void writeDefinition(RecordType type, UInt32 id, const char* str, std::size_t length);
+
+private:
+	BinaryLogChannel(const BinaryLogChannel&);
+	BinaryLogChannel& operator = (const BinaryLogChannel&);
+
+	std::string  _path;
+	std::size_t  _rotation;
+	int          _purgeCount;
+	int          _archiveIndex;
+	SharedMemory _memory;
+	char*        _pBegin;
+	char*        _pPos;
+	char*        _pEnd;
+	FlatHashMap<std::string, UInt32> _sources;
+	FlatHashMap<std::string, UInt32> _threads;
+	FlatHashMap<UInt64, UInt32>      _files;
+	UInt32       _nextId;
+	mutable FastMutex _mutex;
+};
+
+
+//
+// inlines
+//
+inline const std::string& BinaryLogChannel::path() const
+{
+	return _path;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryLogChannel_INCLUDED
@@ -0,0 +1,104 @@
+//
+// BinaryLogReader.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Definition of the BinaryLogReader class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_BinaryLogReader_INCLUDED
+#define Foundation_BinaryLogReader_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/BinaryReader.h"
+#include <istream>
+#include <map>
+
+
+namespace Poco {
+
+
+class Message;
+
+
+class Foundation_API BinaryLogReader
+	/// This class reads messages from a log file
+	/// written by a BinaryLogChannel.
+	///
+	/// Example:
+	///     Poco::FileInputStream istr("app.blog");
+	///     Poco::BinaryLogReader reader(istr);
+	///     Poco::PatternFormatter formatter("%Y-%m-%d %H:%M:%S.%i [%p] %s: %t");
+	///     Poco::Message msg;
+	///     std::string text;
+	///     while (reader.read(msg))
+	///     {
+	///         text.clear();
+	///         formatter.format(msg, text);
+	///         std::cout << text << std::endl;
+	///     }
+{
+public:
+	explicit BinaryLogReader(std::istream& istr);
+		/// Creates the BinaryLogReader and reads the file header
+		/// from the given stream.
+		///
+		/// Throws a DataFormatException if the stream does not
+		/// contain a binary log file in a supported version.
+
+	~BinaryLogReader();
+		/// Destroys the BinaryLogReader.
+
+	bool read(Message& msg);
+		/// Reads the next message from the stream.
+		///
+		/// Returns false if there are no more messages. This is the
+		/// case at the end of the stream, at the zero-filled end
+		/// of a log file that has not been closed properly, or if the
+		/// last record has been cut off.
+		///
+		/// The source file name of the message (see Message::getSourceFile())
+		/// points to a string owned by the BinaryLogReader and is
+		/// only valid as long as the BinaryLogReader exists.
+
+	int version() const;
+		/// Returns the format version of the log file.
+
+private:
+	typedef std::map<UInt32, std::string> StringMap;
+
+	const std::string& lookup(UInt32 id) const;
+
+	BinaryLogReader();
+	BinaryLogReader(const BinaryLogReader&);
+	BinaryLogReader& operator = (const BinaryLogReader&);
+
+	BinaryReader* _pReader;
+	int           _version;
+	StringMap     _strings;
+	std::string   _buffer;
+};
+
+
+//
+// inlines
+//
+inline int BinaryLogReader::version() const
+{
+	return _version;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_BinaryLogReader_INCLUDED
@@ -0,0 +1,126 @@
+//
+// CPUFeatures.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Definition of the CPUFeatures class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_CPUFeatures_INCLUDED
+#define Foundation_CPUFeatures_INCLUDED
+
+
+#include "Poco/Foundation.h"
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define POCO_HAVE_X86_INTRINSICS 1
+	#define POCO_TARGET(features) __attribute__((target(features)))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#define POCO_HAVE_X86_INTRINSICS 1
+	#define POCO_TARGET(features)
+#endif
+
+
+namespace Poco {
+
+
+class Foundation_API CPUFeatures
+	/// This class detects the instruction set extensions
+	/// supported by the processor (and the operating system)
+	/// at run time.
+	///
+	/// Code using these extensions is compiled for the
+	/// extension with the POCO_TARGET() attribute macro
+	/// (where POCO_HAVE_X86_INTRINSICS is defined), and
+	/// called only if the corresponding method returns true.
+	/// All methods return false on other architectures.
+{
+public:
+	static bool hasSSSE3();
+		/// Returns true if SSSE3 is supported.
+
+	static bool hasSSE42();
+		/// Returns true if SSE 4.2 (including the CRC32
+		/// instruction) is supported.
+
+	static bool hasPCLMUL();
+		/// Returns true if carry-less multiplication
+		/// (PCLMULQDQ) is supported.
+
+	static bool hasAVX2();
+		/// Returns true if AVX2 is supported, and the operating
+		/// system saves the AVX register state.
+
+	static bool hasSHA();
+		/// Returns true if the SHA extensions are supported.
+
+private:
+	enum Feature
+	{
+		FEATURE_SSSE3  = 0x01,
+		FEATURE_SSE42  = 0x02,
+		FEATURE_PCLMUL = 0x04,
+		FEATURE_AVX2   = 0x08,
+		FEATURE_SHA    = 0x10
+	};
+
+	static int features();
+	static int detect();
+
+	CPUFeatures();
+};
+
+
+//
+// inlines
+//
+inline bool CPUFeatures::hasSSSE3()
+{
+	return (features() & FEATURE_SSSE3) != 0;
+}
+
+
+inline bool CPUFeatures::hasSSE42()
+{
+	return (features() & FEATURE_SSE42) != 0;
+}
+
+
+inline bool CPUFeatures::hasPCLMUL()
+{
+	return (features() & FEATURE_PCLMUL) != 0;
+}
+
+
+inline bool CPUFeatures::hasAVX2()
+{
+	return (features() & FEATURE_AVX2) != 0;
+}
+
+
+inline bool CPUFeatures::hasSHA()
+{
+	return (features() & FEATURE_SHA) != 0;
+}
+
+
+inline int CPUFeatures::features()
+{
+	static const int f = detect();
+	return f;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_CPUFeatures_INCLUDED
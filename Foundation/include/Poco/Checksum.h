@@ -19,13 +19,15 @@
 
 
 #include "Poco/Foundation.h"
+#include <string>
+#include <cstddef>
 
 
 namespace Poco {
 
 
 class Foundation_API Checksum
-	/// This class calculates CRC-32 or Adler-32 checksums
+	/// This class calculates CRC-32, CRC-32C or Adler-32 checksums
 	/// for arbitrary data.
 	///
 	/// A cyclic redundancy check (CRC) is a type of hash function, which is used to produce a 
@@ -36,13 +38,23 @@ class Foundation_API Checksum
 	/// It is almost as reliable as a 32-bit cyclic redundancy check for protecting against 
 	/// accidental modification of data, such as distortions occurring during a transmission, 
 	/// but is significantly faster to calculate in software.
-	
+	///
+	/// CRC-32C uses the Castagnoli polynomial, which has better error
+	/// detection properties than the CRC-32 polynomial. It is used by
+	/// iSCSI, SCTP, ext4 and many storage formats.
+	///
+	/// Where the processor supports it, the checksums are computed
+	/// with carry-less multiplication (CRC-32), the SSE 4.2 or ARMv8
+	/// CRC32 instructions (CRC-32C) or SSSE3 (Adler-32). Otherwise,
+	/// the zlib implementations, or a table-driven implementation
+	/// for CRC-32C, are used.
 {
 public:
 	enum Type
 	{
 		TYPE_ADLER32 = 0,
-		TYPE_CRC32
+		TYPE_CRC32,
+		TYPE_CRC32C
 	};
 
 	Checksum();
@@ -57,6 +69,11 @@ public:
 	void update(const char* data, unsigned length);
 		/// Updates the checksum with the given data.
 
+	void updateBytes(const void* data, std::size_t length);
+		/// Updates the checksum with the given data.
+		/// Unlike update(), accepts a pointer to any type
+		/// and lengths that do not fit into an unsigned.
+
 	void update(const std::string& data);
 		/// Updates the checksum with the given data.
 
@@ -80,7 +97,7 @@ private:
 //
 inline void Checksum::update(const std::string& data)
 {
-	update(data.c_str(), static_cast<unsigned int>(data.size()));
+	updateBytes(data.data(), data.size());
 }
 
 
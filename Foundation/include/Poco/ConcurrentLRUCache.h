@@ -0,0 +1,507 @@
+//
+// ConcurrentLRUCache.h
+//
+// Library: Foundation
+// Package: Cache
+// Module:  ConcurrentLRUCache
+//
+// Definition of the ConcurrentLRUCache class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_ConcurrentLRUCache_INCLUDED
+#define Foundation_ConcurrentLRUCache_INCLUDED
+
+
+#include "Poco/KeyValueArgs.h"
+#include "Poco/RWLock.h"
+#include "Poco/Mutex.h"
+#include "Poco/Exception.h"
+#include "Poco/FIFOEvent.h"
+#include "Poco/EventArgs.h"
+#include "Poco/SharedPtr.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Hash.h"
+#include <unordered_map>
+#include <vector>
+#include <list>
+#include <set>
+#include <atomic>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <class TKey, class TValue>
+struct UnitWeigher
+	/// The default weigher for ConcurrentLRUCache.
+	/// Every entry has a weight of one, so the capacity
+	/// of the cache is the number of entries.
+{
+	std::size_t operator () (const TKey&, const TValue&) const
+	{
+		return 1;
+	}
+};
+
+
+template <
+	class TKey,
+	class TValue,
+	class THash = Hash<TKey>,
+	class TWeigher = UnitWeigher<TKey, TValue>,
+	class TEventMutex = FastMutex
+>
+class ConcurrentLRUCache
+	/// A ConcurrentLRUCache is a size (or weight) bounded cache
+	/// designed for concurrent access by many threads.
+	///
+	/// It provides the same interface and events as LRUCache and
+	/// ExpireLRUCache, but instead of protecting a single map and
+	/// a single strategy with one mutex, the cache is split into
+	/// a number of segments, selected by the hash of the key.
+	/// Every segment has its own lock, hash table and recency list,
+	/// so that all operations, including eviction, take constant
+	/// time and threads working on different segments do not
+	/// contend with each other.
+	///
+	/// Two eviction policies are available:
+	///   - EVICT_LRU: least recently used entries are evicted first.
+	///     Every get() moves the entry to the front of its segment's
+	///     list, so get() needs exclusive access to the segment.
+	///   - EVICT_CLOCK: an approximation of LRU (second chance).
+	///     get() only sets a reference bit and thus needs only
+	///     shared access to the segment, so readers of the same
+	///     segment do not block each other. Referenced entries are
+	///     given a second chance when the segment is full.
+	///
+	/// The capacity is divided evenly among segments, so eviction
+	/// order is LRU within a segment, but only approximately LRU
+	/// for the cache as a whole. The number of segments is limited
+	/// to the capacity, so that every segment can hold an entry.
+	///
+	/// Entries are weighed by the TWeigher function object, which
+	/// is called with key and value and must return the weight of
+	/// the entry. The default weigher gives every entry a weight
+	/// of one, so the capacity is the maximum number of entries.
+	///
+	/// If an expire time (in milliseconds) is given, entries also
+	/// expire that long after they have been added or updated,
+	/// like in an ExpireLRUCache.
+	///
+	/// The Get event is fired for every successful get(). As this
+	/// is relatively costly and the event is rarely used, it can
+	/// be disabled with setGetEventEnabled(false).
+{
+public:
+	enum EvictionPolicy
+	{
+		EVICT_LRU,   /// Evict least recently used entries.
+		EVICT_CLOCK  /// Evict entries using the CLOCK (second chance) algorithm.
+	};
+
+	enum
+	{
+		DEFAULT_SEGMENTS = 16
+	};
+
+	FIFOEvent<const KeyValueArgs<TKey, TValue>, TEventMutex> Add;
+	FIFOEvent<const KeyValueArgs<TKey, TValue>, TEventMutex> Update;
+	FIFOEvent<const TKey, TEventMutex>                       Remove;
+	FIFOEvent<const TKey, TEventMutex>                       Get;
+	FIFOEvent<const EventArgs, TEventMutex>                  Clear;
+
+	ConcurrentLRUCache(long capacity = 1024, Timestamp::TimeDiff expire = 0, EvictionPolicy policy = EVICT_LRU, int segments = DEFAULT_SEGMENTS):
+		_segments(segmentCount(capacity, segments)),
+		_expire(expire*1000),
+		_policy(policy),
+		_getEvent(true)
+		/// Creates the ConcurrentLRUCache with the given total capacity,
+		/// expire time in milliseconds (0 means entries never expire),
+		/// eviction policy and number of segments.
+	{
+		if (capacity < 1) throw InvalidArgumentException("capacity must be > 0");
+		if (expire < 0) throw InvalidArgumentException("expire must be >= 0");
+
+		// The first (capacity % segments) segments get one more,
+		// so that the segment capacities add up to capacity.
+		std::size_t segmentCapacity = static_cast<std::size_t>(capacity)/_segments.size();
+		std::size_t remainder = static_cast<std::size_t>(capacity) % _segments.size();
+		for (std::size_t i = 0; i < _segments.size(); ++i)
+		{
+			_segments[i].capacity = segmentCapacity + (i < remainder ? 1 : 0);
+		}
+	}
+
+	~ConcurrentLRUCache()
+		/// Destroys the ConcurrentLRUCache.
+	{
+	}
+
+	void add(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If for the key already an entry exists, it will be overwritten,
+		/// ie. first a remove event is thrown, then an add event.
+	{
+		SharedPtr<TValue> ptr(new TValue(val));
+		add(key, ptr);
+	}
+
+	void add(const TKey& key, SharedPtr<TValue> val)
+		/// Adds the key value pair to the cache. Note that adding a NULL SharedPtr will fail!
+		/// If for the key already an entry exists, it will be overwritten,
+		/// ie. first a remove event is thrown, then an add event.
+	{
+		Segment& seg = segmentFor(key);
+		RWLock::ScopedWriteLock lock(seg.lock);
+		IndexIterator it = seg.index.find(key);
+		if (it != seg.index.end()) doRemove(seg, it);
+		doInsert(seg, key, val);
+	}
+
+	void update(const TKey& key, const TValue& val)
+		/// Adds the key value pair to the cache.
+		/// If for the key already an entry exists, it will be overwritten.
+		/// The difference to add is that no remove or add events are thrown in this case,
+		/// just an Update is thrown.
+		/// If the key does not exist the behavior is equal to add, ie. an add event is thrown.
+	{
+		SharedPtr<TValue> ptr(new TValue(val));
+		update(key, ptr);
+	}
+
+	void update(const TKey& key, SharedPtr<TValue> val)
+		/// Adds the key value pair to the cache. Note that adding a NULL SharedPtr will fail!
+		/// If for the key already an entry exists, it will be overwritten.
+		/// The difference to add is that no remove or add events are thrown in this case,
+		/// just an Update is thrown.
+		/// If the key does not exist the behavior is equal to add, ie. an add event is thrown.
+	{
+		Segment& seg = segmentFor(key);
+		RWLock::ScopedWriteLock lock(seg.lock);
+		IndexIterator it = seg.index.find(key);
+		if (it == seg.index.end())
+		{
+			doInsert(seg, key, val);
+		}
+		else
+		{
+			KeyValueArgs<TKey, TValue> args(key, *val);
+			Update.notify(this, args);
+			Entry& entry = *it->second;
+			std::size_t weight = _weigher(key, *val);
+			seg.weight = seg.weight - entry.weight + weight;
+			entry.value = val;
+			entry.weight = weight;
+			entry.created.update();
+			touch(seg, it->second);
+			doEvict(seg, it->second);
+		}
+	}
+
+	void remove(const TKey& key)
+		/// Removes an entry from the cache. If the entry is not found,
+		/// the remove is ignored.
+	{
+		Segment& seg = segmentFor(key);
+		RWLock::ScopedWriteLock lock(seg.lock);
+		IndexIterator it = seg.index.find(key);
+		if (it != seg.index.end()) doRemove(seg, it);
+	}
+
+	bool has(const TKey& key) const
+		/// Returns true if the cache contains a value for the key.
+	{
+		const Segment& seg = segmentFor(key);
+		RWLock::ScopedReadLock lock(seg.lock);
+		ConstIndexIterator it = seg.index.find(key);
+		return it != seg.index.end() && !isExpired(*it->second);
+	}
+
+	SharedPtr<TValue> get(const TKey& key)
+		/// Returns a SharedPtr of the value. The SharedPointer will remain valid
+		/// even when cache replacement removes the element.
+		/// If for the key no value exists, an empty SharedPtr is returned.
+	{
+		Segment& seg = segmentFor(key);
+		if (_policy == EVICT_CLOCK)
+		{
+			{
+				RWLock::ScopedReadLock lock(seg.lock);
+				IndexIterator it = seg.index.find(key);
+				if (it == seg.index.end()) return SharedPtr<TValue>();
+				Entry& entry = *it->second;
+				if (!isExpired(entry))
+				{
+					entry.referenced.store(true, std::memory_order_relaxed);
+					if (_getEvent) Get.notify(this, key);
+					return entry.value;
+				}
+			}
+			RWLock::ScopedWriteLock lock(seg.lock);
+			IndexIterator it = seg.index.find(key);
+			if (it != seg.index.end() && isExpired(*it->second)) doRemove(seg, it);
+			return SharedPtr<TValue>();
+		}
+		else
+		{
+			RWLock::ScopedWriteLock lock(seg.lock);
+			IndexIterator it = seg.index.find(key);
+			if (it == seg.index.end()) return SharedPtr<TValue>();
+			if (isExpired(*it->second))
+			{
+				doRemove(seg, it);
+				return SharedPtr<TValue>();
+			}
+			touch(seg, it->second);
+			if (_getEvent) Get.notify(this, key);
+			return it->second->value;
+		}
+	}
+
+	void clear()
+		/// Removes all elements from the cache.
+	{
+		static EventArgs _emptyArgs;
+		Clear.notify(this, _emptyArgs);
+		for (typename SegmentVec::iterator it = _segments.begin(); it != _segments.end(); ++it)
+		{
+			RWLock::ScopedWriteLock lock(it->lock);
+			it->index.clear();
+			it->entries.clear();
+			it->weight = 0;
+		}
+	}
+
+	std::size_t size()
+		/// Returns the number of cached elements.
+	{
+		forceReplace();
+		std::size_t result = 0;
+		for (typename SegmentVec::iterator it = _segments.begin(); it != _segments.end(); ++it)
+		{
+			RWLock::ScopedReadLock lock(it->lock);
+			result += it->index.size();
+		}
+		return result;
+	}
+
+	std::size_t weight()
+		/// Returns the total weight of all cached elements.
+	{
+		std::size_t result = 0;
+		for (typename SegmentVec::iterator it = _segments.begin(); it != _segments.end(); ++it)
+		{
+			RWLock::ScopedReadLock lock(it->lock);
+			result += it->weight;
+		}
+		return result;
+	}
+
+	void forceReplace()
+		/// Removes all expired entries from the cache.
+		/// Like all Poco caches, ConcurrentLRUCache uses no background
+		/// thread for removing expired entries. Expired entries are
+		/// removed when they are accessed, or when forceReplace() is called.
+	{
+		if (_expire == 0) return;
+
+		for (typename SegmentVec::iterator it = _segments.begin(); it != _segments.end(); ++it)
+		{
+			RWLock::ScopedWriteLock lock(it->lock);
+			typename EntryList::iterator itEntry = it->entries.begin();
+			while (itEntry != it->entries.end())
+			{
+				typename EntryList::iterator itCur = itEntry++;
+				if (isExpired(*itCur)) doRemove(*it, it->index.find(itCur->key));
+			}
+		}
+	}
+
+	std::set<TKey> getAllKeys()
+		/// Returns a copy of all keys stored in the cache.
+	{
+		forceReplace();
+		std::set<TKey> result;
+		for (typename SegmentVec::iterator it = _segments.begin(); it != _segments.end(); ++it)
+		{
+			RWLock::ScopedReadLock lock(it->lock);
+			for (ConstIndexIterator itIndex = it->index.begin(); itIndex != it->index.end(); ++itIndex)
+			{
+				result.insert(itIndex->first);
+			}
+		}
+		return result;
+	}
+
+	void setGetEventEnabled(bool enabled)
+		/// Enables or disables the Get event. The Get event is
+		/// enabled by default.
+		///
+		/// Should be called before the cache is accessed by
+		/// multiple threads.
+	{
+		_getEvent = enabled;
+	}
+
+	bool getGetEventEnabled() const
+		/// Returns true if the Get event is enabled.
+	{
+		return _getEvent;
+	}
+
+	EvictionPolicy policy() const
+		/// Returns the eviction policy.
+	{
+		return _policy;
+	}
+
+	int segments() const
+		/// Returns the number of segments.
+	{
+		return static_cast<int>(_segments.size());
+	}
+
+private:
+	struct Entry
+	{
+		Entry(const TKey& aKey, const SharedPtr<TValue>& aValue, std::size_t aWeight):
+			key(aKey),
+			value(aValue),
+			weight(aWeight),
+			referenced(false)
+		{
+		}
+
+		TKey              key;
+		SharedPtr<TValue> value;
+		std::size_t       weight;
+		Timestamp         created;
+		std::atomic<bool> referenced;
+	};
+
+	typedef std::list<Entry> EntryList;
+	typedef std::unordered_map<TKey, typename EntryList::iterator, THash> Index;
+	typedef typename Index::iterator IndexIterator;
+	typedef typename Index::const_iterator ConstIndexIterator;
+
+	struct Segment
+	{
+		Segment():
+			capacity(0),
+			weight(0)
+		{
+		}
+
+		Segment(const Segment& seg):
+			capacity(seg.capacity),
+			weight(0)
+		{
+		}
+
+		EntryList      entries; /// Most recently used entries first.
+		Index          index;
+		std::size_t    capacity;
+		std::size_t    weight;
+		mutable RWLock lock;
+	};
+
+	typedef std::vector<Segment> SegmentVec;
+
+	static std::size_t segmentCount(long capacity, int segments)
+	{
+		if (segments < 1) segments = 1;
+		if (capacity > 0 && capacity < segments) return static_cast<std::size_t>(capacity);
+		return static_cast<std::size_t>(segments);
+	}
+
+	Segment& segmentFor(const TKey& key)
+	{
+		std::size_t h = _hash(key);
+		return _segments[(h ^ (h >> 16)) % _segments.size()];
+	}
+
+	const Segment& segmentFor(const TKey& key) const
+	{
+		std::size_t h = _hash(key);
+		return _segments[(h ^ (h >> 16)) % _segments.size()];
+	}
+
+	bool isExpired(const Entry& entry) const
+	{
+		return _expire != 0 && entry.created.isElapsed(_expire);
+	}
+
+	void touch(Segment& seg, typename EntryList::iterator it)
+	{
+		if (_policy == EVICT_LRU)
+			seg.entries.splice(seg.entries.begin(), seg.entries, it);
+		else
+			it->referenced.store(true, std::memory_order_relaxed);
+	}
+
+	void doInsert(Segment& seg, const TKey& key, const SharedPtr<TValue>& val)
+	{
+		KeyValueArgs<TKey, TValue> args(key, *val);
+		Add.notify(this, args);
+		std::size_t weight = _weigher(key, *val);
+		seg.entries.emplace_front(key, val, weight);
+		seg.index[key] = seg.entries.begin();
+		seg.weight += weight;
+		doEvict(seg, seg.entries.begin());
+	}
+
+	void doRemove(Segment& seg, IndexIterator it)
+	{
+		Remove.notify(this, it->first);
+		seg.weight -= it->second->weight;
+		seg.entries.erase(it->second);
+		seg.index.erase(it);
+	}
+
+	void doEvict(Segment& seg, typename EntryList::iterator itKeep)
+		/// Evicts entries from the back of the segment's list until
+		/// the segment's weight fits its capacity. The entry given
+		/// in itKeep (the one just added or updated) is never evicted.
+	{
+		while (seg.weight > seg.capacity && seg.entries.size() > 1)
+		{
+			typename EntryList::iterator itLast = --seg.entries.end();
+			if (itLast == itKeep)
+			{
+				seg.entries.splice(seg.entries.begin(), seg.entries, itLast);
+			}
+			else if (_policy == EVICT_CLOCK && itLast->referenced.load(std::memory_order_relaxed))
+			{
+				itLast->referenced.store(false, std::memory_order_relaxed);
+				seg.entries.splice(seg.entries.begin(), seg.entries, itLast);
+			}
+			else
+			{
+				doRemove(seg, seg.index.find(itLast->key));
+			}
+		}
+	}
+
+	ConcurrentLRUCache(const ConcurrentLRUCache& aCache);
+	ConcurrentLRUCache& operator = (const ConcurrentLRUCache& aCache);
+
+	SegmentVec          _segments;
+	Timestamp::TimeDiff _expire;
+	EvictionPolicy      _policy;
+	bool                _getEvent;
+	THash               _hash;
+	TWeigher            _weigher;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_ConcurrentLRUCache_INCLUDED
@@ -79,6 +79,10 @@ public:
 		///   * %% - percent sign
 		///
 		/// Class DateTimeFormat defines format strings for various standard date/time formats.
+		///
+		/// The most recently used format strings are compiled into
+		/// DateTimePattern objects and cached per thread. Code that
+		/// always uses the same format can use a DateTimePattern directly.
 
 	static std::string format(const DateTime& dateTime, const std::string& fmt, int timeZoneDifferential = UTC);
 		/// Formats the given date and time according to the given format.
@@ -155,8 +159,10 @@ public:
 //
 inline std::string DateTimeFormatter::format(const Timestamp& timestamp, const std::string& fmt, int timeZoneDifferential)
 {
-	DateTime dateTime(timestamp);
-	return format(dateTime, fmt, timeZoneDifferential);
+	std::string result;
+	result.reserve(64);
+	append(result, timestamp, fmt, timeZoneDifferential);
+	return result;
 }
 
 
@@ -184,13 +190,6 @@ inline std::string DateTimeFormatter::format(const Timespan& timespan, const std
 }
 
 
-inline void DateTimeFormatter::append(std::string& str, const Timestamp& timestamp, const std::string& fmt, int timeZoneDifferential)
-{
-	DateTime dateTime(timestamp);
-	append(str, dateTime, fmt, timeZoneDifferential);
-}
-
-
 inline std::string DateTimeFormatter::tzdISO(int timeZoneDifferential)
 {
 	std::string result;
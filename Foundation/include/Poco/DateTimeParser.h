@@ -107,6 +107,8 @@ public:
 protected:
 	static int parseTZD(std::string::const_iterator& it, const std::string::const_iterator& end);
 	static int parseAMPM(std::string::const_iterator& it, const std::string::const_iterator& end, int hour);
+
+	friend class DateTimePattern;
 };
 
 
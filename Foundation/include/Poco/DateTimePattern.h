@@ -0,0 +1,158 @@
+//
+// DateTimePattern.h
+//
+// Library: Foundation
+// Package: DateTime
+// Module:  DateTimePattern
+//
+// Definition of the DateTimePattern class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_DateTimePattern_INCLUDED
+#define Foundation_DateTimePattern_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/DateTime.h"
+#include "Poco/LocalDateTime.h"
+#include "Poco/DateTimeFormatter.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Timestamp;
+
+
+class Foundation_API DateTimePattern
+	/// A DateTimePattern is a date/time format string that has been
+	/// compiled once, so that it can be used for formatting and parsing
+	/// many times without interpreting the format string again.
+	///
+	/// The format string has the same syntax as the one accepted by
+	/// DateTimeFormatter::format() and DateTimeParser::parse(), and
+	/// formatting and parsing give the same results:
+	///
+	///     static const DateTimePattern pattern(DateTimeFormat::HTTP_FORMAT);
+	///     response.set("Date", pattern.format(Timestamp()));
+	///
+	/// The ISO 8601 and RFC 1123/HTTP formats defined in DateTimeFormat
+	/// are formatted and parsed by specialized code. When formatting
+	/// a Timestamp in RFC 1123 or HTTP format, the last result is
+	/// cached per thread, since such dates have a resolution of one
+	/// second and servers typically format the current time for every
+	/// response.
+	///
+	/// DateTimeFormatter and DateTimeParser keep compiled patterns
+	/// for the most recently used format strings in a per-thread cache,
+	/// so existing code benefits from this class without changes.
+{
+public:
+	explicit DateTimePattern(const std::string& fmt);
+		/// Compiles the given format string.
+
+	~DateTimePattern();
+		/// Destroys the DateTimePattern.
+
+	const std::string& pattern() const;
+		/// Returns the format string.
+
+	std::string format(const Timestamp& timestamp, int timeZoneDifferential = DateTimeFormatter::UTC) const;
+		/// Formats the given timestamp.
+
+	std::string format(const DateTime& dateTime, int timeZoneDifferential = DateTimeFormatter::UTC) const;
+		/// Formats the given date and time.
+
+	std::string format(const LocalDateTime& dateTime) const;
+		/// Formats the given local date and time.
+
+	void append(std::string& str, const Timestamp& timestamp, int timeZoneDifferential = DateTimeFormatter::UTC) const;
+		/// Formats the given timestamp and appends it to str.
+
+	void append(std::string& str, const DateTime& dateTime, int timeZoneDifferential = DateTimeFormatter::UTC) const;
+		/// Formats the given date and time and appends it to str.
+
+	void append(std::string& str, const LocalDateTime& dateTime) const;
+		/// Formats the given local date and time and appends it to str.
+
+	void parse(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const;
+		/// Parses a date and time from the given string.
+		/// Throws a SyntaxException if the string cannot be successfully parsed.
+
+	DateTime parse(const std::string& str, int& timeZoneDifferential) const;
+		/// Parses a date and time from the given string.
+		/// Throws a SyntaxException if the string cannot be successfully parsed.
+
+	bool tryParse(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const;
+		/// Parses a date and time from the given string.
+		/// Returns true if the string has been successfully parsed, false otherwise.
+
+private:
+	enum Kind
+	{
+		KIND_GENERIC,
+		KIND_ISO8601,      // DateTimeFormat::ISO8601_FORMAT
+		KIND_ISO8601_FRAC, // DateTimeFormat::ISO8601_FRAC_FORMAT
+		KIND_RFC1123,      // DateTimeFormat::RFC1123_FORMAT
+		KIND_HTTP,         // DateTimeFormat::HTTP_FORMAT
+		KIND_RFC1123_PARSE // RFC 1123 with a two or four digit year; parsing only
+	};
+
+	struct Token
+		/// A literal run of the format string, or a format specifier.
+	{
+		char specifier;     // 0 for a literal
+		std::size_t offset; // literal position in _pattern
+		std::size_t length;
+	};
+
+	void compile();
+	void appendGeneric(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const;
+	void appendISO8601(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const;
+	void appendRFC1123(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const;
+	void parseGeneric(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const;
+	bool parseISO8601(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const;
+	bool parseRFC1123(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const;
+
+	static const DateTimePattern* cached(const std::string& fmt);
+		/// Returns the compiled pattern for fmt from the calling
+		/// thread's pattern cache, or null if the cache is no longer
+		/// available because the thread is terminating.
+		/// The pattern is only valid until the next call.
+
+	std::string _pattern;
+	std::vector<Token> _tokens;
+	Kind _kind;
+
+	friend class DateTimeFormatter;
+	friend class DateTimeParser;
+};
+
+
+//
+// inlines
+//
+inline const std::string& DateTimePattern::pattern() const
+{
+	return _pattern;
+}
+
+
+inline void DateTimePattern::append(std::string& str, const LocalDateTime& dateTime) const
+{
+	append(str, dateTime._dateTime, dateTime._tzd);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_DateTimePattern_INCLUDED
@@ -31,6 +31,9 @@ namespace Poco {
 class Foundation_API DigestBuf: public BufferedStreamBuf
 	/// This streambuf computes a digest of all data going
 	/// through it.
+	///
+	/// Writes of at least BUFFER_SIZE bytes bypass the buffer
+	/// and are passed to the DigestEngine in a single update.
 {
 public:
 	DigestBuf(DigestEngine& eng);
@@ -41,6 +44,9 @@ public:
 	int writeToDevice(const char* buffer, std::streamsize length);
 	void close();
 
+protected:
+	std::streamsize xsputn(const char* s, std::streamsize n);
+
 private:
 	DigestEngine& _eng;
 	std::istream* _pIstr;
@@ -22,6 +22,7 @@
 #include "Poco/Dynamic/Var.h"
 #include "Poco/Dynamic/VarHolder.h"
 #include "Poco/SharedPtr.h"
+#include "Poco/ArenaAllocator.h"
 #include <map>
 #include <set>
 
@@ -35,7 +36,7 @@ class Struct
 	/// Struct allows to define a named collection of Var objects.
 {
 public:
-	typedef typename std::map<K, Var> Data;
+	typedef typename std::map<K, Var, std::less<K>, ArenaAllocator<std::pair<const K, Var> > > Data;
 	typedef typename std::set<K> NameSet;
 	typedef typename Data::iterator Iterator;
 	typedef typename Data::const_iterator ConstIterator;
@@ -49,6 +50,15 @@ public:
 	{
 	}
 
+	explicit Struct(Arena& arena): _data(std::less<K>(), typename Data::allocator_type(arena))
+		/// Creates an empty Struct that allocates its members
+		/// from the given Arena.
+		///
+		/// The Arena must outlive the Struct. Copies of the
+		/// Struct allocate from the heap.
+	{
+	}
+
 	Struct(const Data& val): _data(val)
 		/// Creates the Struct from the given value.
 	{
@@ -23,6 +23,10 @@
 #include "Poco/Timestamp.h"
 #include "Poco/Timespan.h"
 #include "Poco/Mutex.h"
+#include "Poco/Thread.h"
+#include "Poco/Event.h"
+#include "Poco/RunnableAdapter.h"
+#include <atomic>
 
 
 namespace Poco {
@@ -162,6 +166,31 @@ class Foundation_API FileChannel: public Channel
 	///            if it exists (unless other conditions for a rotation are met). 
 	///            This is the default.
 	///
+	/// The bufferSize property enables group commit. Instead of writing
+	/// every message separately, messages are collected in a buffer of
+	/// the given size, which is written to the log file in one go when
+	/// it is full, or at the latest after the flush interval has elapsed.
+	/// The value is given in bytes, or with a K or M suffix in kilobytes
+	/// or megabytes. The default is 0, which disables buffering.
+	/// In group commit mode, rotation is checked and performed when
+	/// the buffer is written, and purging of archived files is done by
+	/// a background thread, which also writes the buffer after the
+	/// flush interval has elapsed. The flush property is ignored, the
+	/// buffer is always flushed to the log file when written.
+	///
+	/// The flushInterval property specifies the maximum time in milliseconds
+	/// a message stays in the buffer (default is 1000) in group commit mode.
+	///
+	/// The sync property specifies whether data written to the log file
+	/// is forced onto the storage device. With group commit, this happens
+	/// whenever the buffer is written, otherwise for every message
+	/// if flush is enabled. Valid values are:
+	///
+	///   * none:  Data is left in the operating system's cache (default).
+	///   * data:  Only file data (and metadata needed to read it back) is
+	///            synchronized (fdatasync() where available).
+	///   * full:  File data and metadata are synchronized (fsync()).
+	///
 	/// For a more lightweight file channel class, see SimpleFileChannel.
 {
 public:
@@ -179,6 +208,9 @@ public:
 
 	void log(const Message& msg);
 		/// Logs the given message to the file.
+
+	void flush();
+		/// Writes all buffered messages to the log file.
 		
 	void setProperty(const std::string& name, const std::string& value);
 		/// Sets the property with the given name. 
@@ -205,6 +237,13 @@ public:
 		///                   for details.
 		///   * rotateOnOpen: Specifies whether an existing log file should be 
 		///                   rotated and archived when the channel is opened.
+		///   * bufferSize:   Size of the group commit buffer. See the FileChannel
+		///                   class for details.
+		///   * flushInterval: Maximum time in milliseconds messages are
+		///                   buffered. See the FileChannel class for details.
+		///   * sync:         Specifies whether written data is forced onto
+		///                   the storage device. See the FileChannel class
+		///                   for details.
 
 	std::string getProperty(const std::string& name) const;
 		/// Returns the value of the property with the given name.
@@ -229,6 +268,9 @@ public:
 	static const std::string PROP_PURGECOUNT;
 	static const std::string PROP_FLUSH;
 	static const std::string PROP_ROTATEONOPEN;
+	static const std::string PROP_BUFFERSIZE;
+	static const std::string PROP_FLUSHINTERVAL;
+	static const std::string PROP_SYNC;
 
 protected:
 	~FileChannel();
@@ -239,14 +281,29 @@ protected:
 	void setPurgeCount(const std::string& count);
 	void setFlush(const std::string& flush);
 	void setRotateOnOpen(const std::string& rotateOnOpen);
+	void setBufferSize(const std::string& size);
+	void setFlushInterval(const std::string& interval);
+	void setSync(const std::string& sync);
 	void purge();
 	void unsafeOpen();
+	void unsafeRotate();
+	void unsafeCommit();
+	void run();
 
 private:
 	bool setNoPurge(const std::string& value);
 	int extractDigit(const std::string& value, std::string::const_iterator* nextToDigit = NULL) const;
 	void setPurgeStrategy(PurgeStrategy* strategy);
 	Timespan::TimeDiff extractFactor(const std::string& value, std::string::const_iterator start) const;
+	void startBackground();
+	void stopBackground();
+
+	enum SyncMode
+	{
+		SYNC_NONE,
+		SYNC_DATA,
+		SYNC_FULL
+	};
 
 	std::string      _path;
 	std::string      _times;
@@ -261,7 +318,19 @@ private:
 	RotateStrategy*  _pRotateStrategy;
 	ArchiveStrategy* _pArchiveStrategy;
 	PurgeStrategy*   _pPurgeStrategy;
+	std::size_t      _bufferSize;
+	long             _flushInterval;
+	SyncMode         _sync;
+	std::string      _buffer;
+	Timestamp        _bufferTime;
+	bool             _purgePending;
 	FastMutex        _mutex;
+	FastMutex        _purgeMutex;
+	FastMutex        _backgroundMutex;
+	Thread           _thread;
+	Event            _wakeUp;
+	std::atomic<bool> _stop;
+	RunnableAdapter<FileChannel> _runnable;
 };
 
 
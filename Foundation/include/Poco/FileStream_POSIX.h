@@ -20,6 +20,7 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/BufferedBidirectionalStreamBuf.h"
+#include "Poco/NativeStreamBuf.h"
 #include <istream>
 #include <ostream>
 
@@ -27,7 +28,7 @@
 namespace Poco {
 
 
-class Foundation_API FileStreamBuf: public BufferedBidirectionalStreamBuf
+class Foundation_API FileStreamBuf: public BufferedBidirectionalStreamBuf, public NativeStreamBuf
 	/// This stream buffer handles Fileio
 {
 public:
@@ -50,6 +51,22 @@ public:
 	std::streampos seekpos(std::streampos pos, std::ios::openmode mode = std::ios::in | std::ios::out);
 		/// Change to specified position, according to mode.
 
+	void flushToDisk(bool dataOnly = false);
+		/// Writes any buffered data to the file and forces the
+		/// operating system to write it to the storage device.
+		///
+		/// If dataOnly is true, file metadata that is not needed
+		/// to read the data back (e.g., the modification time)
+		/// may not be written, if the platform supports this.
+
+	int nativeDescriptor(std::ios::openmode which) const;
+		/// Returns the file descriptor, if the file has been opened
+		/// for the given direction. Files opened in append mode
+		/// are never written to directly.
+
+	void nativeTransferred(std::ios::openmode which, std::streamsize n);
+		/// Updates the file position.
+
 protected:
 	enum
 	{
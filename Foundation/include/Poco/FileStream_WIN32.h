@@ -49,6 +49,14 @@ public:
 	std::streampos seekpos(std::streampos pos, std::ios::openmode mode = std::ios::in | std::ios::out);
 		/// change to specified position, according to mode
 
+	void flushToDisk(bool dataOnly = false);
+		/// Writes any buffered data to the file and forces the
+		/// operating system to write it to the storage device.
+		///
+		/// If dataOnly is true, file metadata that is not needed
+		/// to read the data back (e.g., the modification time)
+		/// may not be written, if the platform supports this.
+
 protected:
 	enum
 	{
@@ -0,0 +1,152 @@
+//
+// FlatHashMap.h
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashTable
+//
+// Definition of the FlatHashMap class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashMap_INCLUDED
+#define Foundation_FlatHashMap_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/FlatHashTable.h"
+#include "Poco/Hash.h"
+#include "Poco/Exception.h"
+#include <functional>
+#include <utility>
+#include <tuple>
+
+
+namespace Poco {
+
+
+template <class Key, class Mapped>
+struct FlatHashMapKeyOf
+	/// This class template is used internally by FlatHashMap.
+{
+	const Key& operator () (const std::pair<const Key, Mapped>& value) const
+	{
+		return value.first;
+	}
+};
+
+
+template <class Key, class Mapped, class HashFunc = Hash<Key>, class KeyEqual = std::equal_to<Key> >
+class FlatHashMap: public FlatHashTable<std::pair<const Key, Mapped>, Key, FlatHashMapKeyOf<Key, Mapped>, HashFunc, KeyEqual>
+	/// This class implements a map using a FlatHashTable, an
+	/// open addressing hash table that stores all entries in a
+	/// single array and probes groups of slots in parallel.
+	///
+	/// A FlatHashMap can be used just like a std::unordered_map,
+	/// with the exception that inserting new entries may move
+	/// existing entries, and thus invalidate references to them.
+	///
+	/// For lookups of std::string keys with C strings, without
+	/// creating a temporary std::string, use StringHash and
+	/// std::equal_to<> as HashFunc and KeyEqual.
+{
+public:
+	typedef FlatHashTable<std::pair<const Key, Mapped>, Key, FlatHashMapKeyOf<Key, Mapped>, HashFunc, KeyEqual> Base;
+
+	typedef Key     KeyType;
+	typedef Mapped  MappedType;
+	typedef Mapped  mapped_type;
+	typedef Mapped& Reference;
+	typedef const Mapped& ConstReference;
+
+	typedef typename Base::value_type     ValueType;
+	typedef typename Base::iterator       iterator;
+	typedef typename Base::const_iterator const_iterator;
+
+	FlatHashMap()
+		/// Creates an empty FlatHashMap.
+	{
+	}
+
+	explicit FlatHashMap(std::size_t initialReserve):
+		Base(initialReserve)
+		/// Creates the FlatHashMap with room for initialReserve entries.
+	{
+	}
+
+	template <class... Args>
+	std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+		/// Inserts an entry with the given key and a value constructed
+		/// from args, unless an entry with the key already exists,
+		/// in which case args are left untouched.
+	{
+		std::size_t index = this->findIndex(key);
+		if (index != this->capacity()) return std::make_pair(this->iteratorAt(index), false);
+		index = this->insertNew(this->hashOf(key), std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+		return std::make_pair(this->iteratorAt(index), true);
+	}
+
+	template <class... Args>
+	std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+	{
+		std::size_t index = this->findIndex(key);
+		if (index != this->capacity()) return std::make_pair(this->iteratorAt(index), false);
+		index = this->insertNew(this->hashOf(key), std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+		return std::make_pair(this->iteratorAt(index), true);
+	}
+
+	template <class M>
+	std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value)
+		/// Inserts a new entry, or assigns value to an existing one.
+	{
+		std::pair<iterator, bool> result = try_emplace(key, std::forward<M>(value));
+		if (!result.second) result.first->second = std::forward<M>(value);
+		return result;
+	}
+
+	Mapped& operator [] (const Key& key)
+		/// Returns a reference to the value for the given key,
+		/// inserting a default-constructed value if necessary.
+	{
+		return try_emplace(key).first->second;
+	}
+
+	Mapped& operator [] (Key&& key)
+	{
+		return try_emplace(std::move(key)).first->second;
+	}
+
+	const Mapped& operator [] (const Key& key) const
+		/// Returns a reference to the value for the given key.
+		/// Throws a NotFoundException if the key does not exist.
+	{
+		return at(key);
+	}
+
+	Mapped& at(const Key& key)
+		/// Returns a reference to the value for the given key.
+		/// Throws a NotFoundException if the key does not exist.
+	{
+		iterator it = this->find(key);
+		if (it == this->end()) throw NotFoundException();
+		return it->second;
+	}
+
+	const Mapped& at(const Key& key) const
+	{
+		const_iterator it = this->find(key);
+		if (it == this->end()) throw NotFoundException();
+		return it->second;
+	}
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashMap_INCLUDED
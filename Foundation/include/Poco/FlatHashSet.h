@@ -0,0 +1,76 @@
+//
+// FlatHashSet.h
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashTable
+//
+// Definition of the FlatHashSet class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashSet_INCLUDED
+#define Foundation_FlatHashSet_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/FlatHashTable.h"
+#include "Poco/Hash.h"
+#include <functional>
+
+
+namespace Poco {
+
+
+template <class Value>
+struct FlatHashSetKeyOf
+	/// This class template is used internally by FlatHashSet.
+{
+	const Value& operator () (const Value& value) const
+	{
+		return value;
+	}
+};
+
+
+template <class Value, class HashFunc = Hash<Value>, class ValueEqual = std::equal_to<Value> >
+class FlatHashSet: public FlatHashTable<Value, Value, FlatHashSetKeyOf<Value>, HashFunc, ValueEqual>
+	/// This class implements a set using a FlatHashTable, an
+	/// open addressing hash table that stores all values in a
+	/// single array and probes groups of slots in parallel.
+	///
+	/// A FlatHashSet can be used just like a std::unordered_set,
+	/// with the exception that inserting new values may move
+	/// existing values, and thus invalidate references to them.
+	///
+	/// For lookups of std::string values with C strings, without
+	/// creating a temporary std::string, use StringHash and
+	/// std::equal_to<> as HashFunc and ValueEqual.
+{
+public:
+	typedef FlatHashTable<Value, Value, FlatHashSetKeyOf<Value>, HashFunc, ValueEqual> Base;
+
+	typedef Value ValueType;
+
+	FlatHashSet()
+		/// Creates an empty FlatHashSet.
+	{
+	}
+
+	explicit FlatHashSet(std::size_t initialReserve):
+		Base(initialReserve)
+		/// Creates the FlatHashSet with room for initialReserve values.
+	{
+	}
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashSet_INCLUDED
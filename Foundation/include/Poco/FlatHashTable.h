@@ -0,0 +1,758 @@
+//
+// FlatHashTable.h
+//
+// Library: Foundation
+// Package: Hashing
+// Module:  FlatHashTable
+//
+// Definition of the FlatHashTable class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FlatHashTable_INCLUDED
+#define Foundation_FlatHashTable_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Exception.h"
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <new>
+#include <cstddef>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POCO_FLAT_HASH_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace Poco {
+
+
+class FlatHashGroup
+	/// This class is used internally by FlatHashTable.
+	///
+	/// A FlatHashGroup holds the control bytes of a group of
+	/// consecutive slots and finds matching slots in parallel.
+	/// With SSE2, a group consists of 16 slots that are probed
+	/// with a single instruction each; otherwise a group consists
+	/// of 8 slots. Matches are returned as bit masks, with bit i
+	/// corresponding to the i-th slot of the group.
+{
+public:
+	enum Control
+	{
+		CTRL_EMPTY   = -128, /// 0b10000000
+		CTRL_DELETED = -2    /// 0b11111110
+		// full slots have the top bit cleared and store
+		// seven bits of the hash value
+	};
+
+#if defined(POCO_FLAT_HASH_SSE2)
+	enum
+	{
+		WIDTH = 16
+	};
+
+	explicit FlatHashGroup(const Int8* pCtrl):
+		_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pCtrl)))
+	{
+	}
+
+	UInt32 match(Int8 h2) const
+	{
+		return static_cast<UInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)));
+	}
+
+	UInt32 matchEmpty() const
+	{
+		return match(static_cast<Int8>(CTRL_EMPTY));
+	}
+
+	UInt32 matchEmptyOrDeleted() const
+	{
+		// only empty and deleted slots have the top bit set
+		return static_cast<UInt32>(_mm_movemask_epi8(_ctrl));
+	}
+
+private:
+	__m128i _ctrl;
+#else
+	enum
+	{
+		WIDTH = 8
+	};
+
+	explicit FlatHashGroup(const Int8* pCtrl)
+	{
+		std::memcpy(_ctrl, pCtrl, WIDTH);
+	}
+
+	UInt32 match(Int8 h2) const
+	{
+		UInt32 result = 0;
+		for (int i = 0; i < WIDTH; ++i)
+		{
+			if (_ctrl[i] == h2) result |= UInt32(1) << i;
+		}
+		return result;
+	}
+
+	UInt32 matchEmpty() const
+	{
+		return match(static_cast<Int8>(CTRL_EMPTY));
+	}
+
+	UInt32 matchEmptyOrDeleted() const
+	{
+		UInt32 result = 0;
+		for (int i = 0; i < WIDTH; ++i)
+		{
+			if (_ctrl[i] < 0) result |= UInt32(1) << i;
+		}
+		return result;
+	}
+
+private:
+	Int8 _ctrl[WIDTH];
+#endif
+
+public:
+	static int lowestBit(UInt32 mask)
+		/// Returns the index of the lowest set bit in mask,
+		/// which must not be zero.
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<int>(index);
+#else
+		int index = 0;
+		while (!(mask & 1))
+		{
+			mask >>= 1;
+			++index;
+		}
+		return index;
+#endif
+	}
+
+	static int highestBit(UInt32 mask)
+		/// Returns the index of the highest set bit in mask,
+		/// which must not be zero.
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return 31 - __builtin_clz(mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, mask);
+		return static_cast<int>(index);
+#else
+		int index = 0;
+		while (mask >>= 1) ++index;
+		return index;
+#endif
+	}
+};
+
+
+template <class Value, class Key, class KeyOf, class THash, class TEqual>
+class FlatHashTable
+	/// This class template is used internally by FlatHashMap and FlatHashSet.
+	///
+	/// A FlatHashTable is a hash table using open addressing
+	/// (in the style of Google's "Swiss tables"). All values are
+	/// stored in a single array of slots, and there is a separate
+	/// array of one control byte per slot, holding seven bits of the
+	/// key's hash, or a marker for an empty or deleted slot.
+	/// Lookups probe groups of control bytes in parallel (using SSE2,
+	/// if available) and only compare keys whose control byte matches,
+	/// so that a lookup usually touches a single cache line of control
+	/// bytes and a single slot.
+	///
+	/// The number of slots is a power of two, and the table grows when
+	/// it would become more than 7/8 full.
+	///
+	/// Unlike with node-based containers, inserting into or erasing
+	/// from a FlatHashTable may move values; iterators, pointers and
+	/// references to values are invalidated by any operation that
+	/// causes a rehash. Erasing does not invalidate iterators to
+	/// other values.
+	///
+	/// KeyOf is a function object returning the key of a value.
+	/// If both THash and TEqual have a nested is_transparent type,
+	/// find(), count() and erase() accept any type that can be
+	/// hashed by THash and compared with a Key by TEqual.
+{
+public:
+	typedef Key         key_type;
+	typedef Value       value_type;
+	typedef std::size_t size_type;
+	typedef THash       hasher;
+	typedef TEqual      key_equal;
+
+	template <class V>
+	class BasicIterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef V                         value_type;
+		typedef std::ptrdiff_t            difference_type;
+		typedef V*                        pointer;
+		typedef V&                        reference;
+
+		BasicIterator():
+			_pCtrl(0),
+			_pEnd(0),
+			_pSlot(0)
+		{
+		}
+
+		BasicIterator(const Int8* pCtrl, const Int8* pEnd, V* pSlot):
+			_pCtrl(pCtrl),
+			_pEnd(pEnd),
+			_pSlot(pSlot)
+		{
+			skipFree();
+		}
+
+		template <class W>
+		BasicIterator(const BasicIterator<W>& it):
+			_pCtrl(it._pCtrl),
+			_pEnd(it._pEnd),
+			_pSlot(it._pSlot)
+		{
+		}
+
+		V& operator * () const
+		{
+			return *_pSlot;
+		}
+
+		V* operator -> () const
+		{
+			return _pSlot;
+		}
+
+		BasicIterator& operator ++ ()
+		{
+			++_pCtrl;
+			++_pSlot;
+			skipFree();
+			return *this;
+		}
+
+		BasicIterator operator ++ (int)
+		{
+			BasicIterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		template <class W>
+		bool operator == (const BasicIterator<W>& it) const
+		{
+			return _pCtrl == it._pCtrl;
+		}
+
+		template <class W>
+		bool operator != (const BasicIterator<W>& it) const
+		{
+			return _pCtrl != it._pCtrl;
+		}
+
+	private:
+		void skipFree()
+		{
+			while (_pCtrl != _pEnd && *_pCtrl < 0)
+			{
+				++_pCtrl;
+				++_pSlot;
+			}
+		}
+
+		const Int8* _pCtrl;
+		const Int8* _pEnd;
+		V*          _pSlot;
+
+		template <class W> friend class BasicIterator;
+		friend class FlatHashTable;
+	};
+
+	typedef BasicIterator<Value>       iterator;
+	typedef BasicIterator<const Value> const_iterator;
+	typedef iterator                   Iterator;
+	typedef const_iterator             ConstIterator;
+
+	FlatHashTable():
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0)
+		/// Creates an empty FlatHashTable. No memory is allocated
+		/// until the first value is inserted.
+	{
+	}
+
+	explicit FlatHashTable(size_type initialReserve):
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0)
+		/// Creates the FlatHashTable with room for initialReserve values.
+	{
+		reserve(initialReserve);
+	}
+
+	FlatHashTable(const FlatHashTable& table):
+		_pCtrl(0),
+		_pSlots(0),
+		_capacity(0),
+		_size(0),
+		_growthLeft(0),
+		_hash(table._hash),
+		_equal(table._equal)
+		/// Creates the FlatHashTable by copying another one.
+	{
+		reserve(table._size);
+		for (const_iterator it = table.begin(); it != table.end(); ++it)
+		{
+			insertNew(hashOf(_keyOf(*it)), *it);
+		}
+	}
+
+	FlatHashTable(FlatHashTable&& table) noexcept:
+		_pCtrl(table._pCtrl),
+		_pSlots(table._pSlots),
+		_capacity(table._capacity),
+		_size(table._size),
+		_growthLeft(table._growthLeft),
+		_hash(table._hash),
+		_equal(table._equal)
+		/// Creates the FlatHashTable by moving another one.
+	{
+		table._pCtrl = 0;
+		table._pSlots = 0;
+		table._capacity = 0;
+		table._size = 0;
+		table._growthLeft = 0;
+	}
+
+	~FlatHashTable()
+		/// Destroys the FlatHashTable.
+	{
+		destroy();
+	}
+
+	FlatHashTable& operator = (const FlatHashTable& table)
+		/// Assigns another FlatHashTable.
+	{
+		FlatHashTable tmp(table);
+		swap(tmp);
+		return *this;
+	}
+
+	FlatHashTable& operator = (FlatHashTable&& table) noexcept
+		/// Move-assigns another FlatHashTable.
+	{
+		FlatHashTable tmp(std::move(table));
+		swap(tmp);
+		return *this;
+	}
+
+	void swap(FlatHashTable& table) noexcept
+		/// Swaps the FlatHashTable with another one.
+	{
+		std::swap(_pCtrl, table._pCtrl);
+		std::swap(_pSlots, table._pSlots);
+		std::swap(_capacity, table._capacity);
+		std::swap(_size, table._size);
+		std::swap(_growthLeft, table._growthLeft);
+		std::swap(_hash, table._hash);
+		std::swap(_equal, table._equal);
+	}
+
+	iterator begin()
+	{
+		return iterator(_pCtrl, _pCtrl + _capacity, _pSlots);
+	}
+
+	iterator end()
+	{
+		return iterator(_pCtrl + _capacity, _pCtrl + _capacity, _pSlots + _capacity);
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(_pCtrl, _pCtrl + _capacity, _pSlots);
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(_pCtrl + _capacity, _pCtrl + _capacity, _pSlots + _capacity);
+	}
+
+	iterator find(const Key& key)
+	{
+		return iteratorAt(findIndex(key));
+	}
+
+	const_iterator find(const Key& key) const
+	{
+		return iteratorAt(findIndex(key));
+	}
+
+	template <class K, class H = THash, class E = TEqual, class = typename H::is_transparent, class = typename E::is_transparent>
+	iterator find(const K& key)
+	{
+		return iteratorAt(findIndex(key));
+	}
+
+	template <class K, class H = THash, class E = TEqual, class = typename H::is_transparent, class = typename E::is_transparent>
+	const_iterator find(const K& key) const
+	{
+		return iteratorAt(findIndex(key));
+	}
+
+	size_type count(const Key& key) const
+	{
+		return findIndex(key) != _capacity ? 1 : 0;
+	}
+
+	template <class K, class H = THash, class E = TEqual, class = typename H::is_transparent, class = typename E::is_transparent>
+	size_type count(const K& key) const
+	{
+		return findIndex(key) != _capacity ? 1 : 0;
+	}
+
+	std::pair<iterator, bool> insert(const Value& value)
+		/// Inserts a copy of value, unless a value with
+		/// the same key is already in the table.
+	{
+		return insertUnique(value);
+	}
+
+	std::pair<iterator, bool> insert(Value&& value)
+		/// Inserts value, unless a value with the same
+		/// key is already in the table.
+	{
+		return insertUnique(std::move(value));
+	}
+
+	template <class InputIt>
+	void insert(InputIt first, InputIt last)
+		/// Inserts all values in the range [first, last).
+	{
+		for (; first != last; ++first) insert(*first);
+	}
+
+	template <class... Args>
+	std::pair<iterator, bool> emplace(Args&&... args)
+		/// Constructs a value from args and inserts it,
+		/// unless a value with the same key is already in the table.
+	{
+		return insertUnique(Value(std::forward<Args>(args)...));
+	}
+
+	iterator erase(const_iterator it)
+		/// Erases the value the iterator points to
+		/// and returns an iterator to the next value.
+	{
+		size_type index = static_cast<size_type>(it._pCtrl - _pCtrl);
+		eraseAt(index);
+		return iterator(_pCtrl + index + 1, _pCtrl + _capacity, _pSlots + index + 1);
+	}
+
+	iterator erase(iterator it)
+	{
+		return erase(const_iterator(it));
+	}
+
+	size_type erase(const Key& key)
+		/// Erases the value with the given key, if it exists.
+		/// Returns the number of erased values (0 or 1).
+	{
+		return eraseKey(key);
+	}
+
+	template <class K, class H = THash, class E = TEqual, class = typename H::is_transparent, class = typename E::is_transparent>
+	size_type erase(const K& key)
+	{
+		return eraseKey(key);
+	}
+
+	void clear()
+		/// Erases all values. The memory of the
+		/// table is kept for further use.
+	{
+		for (size_type i = 0; i < _capacity; ++i)
+		{
+			if (_pCtrl[i] >= 0) _pSlots[i].~Value();
+		}
+		if (_capacity)
+		{
+			std::memset(_pCtrl, FlatHashGroup::CTRL_EMPTY, _capacity + FlatHashGroup::WIDTH);
+		}
+		_size = 0;
+		_growthLeft = maxLoad(_capacity);
+	}
+
+	void reserve(size_type n)
+		/// Makes sure that n values can be stored
+		/// without rehashing the table.
+	{
+		if (n > _size + _growthLeft)
+		{
+			size_type capacity = FlatHashGroup::WIDTH;
+			while (maxLoad(capacity) < n) capacity <<= 1;
+			resize(capacity);
+		}
+	}
+
+	size_type size() const
+	{
+		return _size;
+	}
+
+	bool empty() const
+	{
+		return _size == 0;
+	}
+
+	size_type capacity() const
+		/// Returns the number of slots in the table.
+	{
+		return _capacity;
+	}
+
+	float load_factor() const
+	{
+		return _capacity ? static_cast<float>(_size)/_capacity : 0.0f;
+	}
+
+	hasher hash_function() const
+	{
+		return _hash;
+	}
+
+	key_equal key_eq() const
+	{
+		return _equal;
+	}
+
+protected:
+	template <class K>
+	std::size_t hashOf(const K& key) const
+	{
+		UInt64 h = static_cast<UInt64>(_hash(key))*0x9E3779B97F4A7C15ULL;
+		return static_cast<std::size_t>(h ^ (h >> 32));
+	}
+
+	static Int8 h2(std::size_t hash)
+	{
+		return static_cast<Int8>(hash & 0x7F);
+	}
+
+	template <class K>
+	size_type findIndex(const K& key) const
+		/// Returns the index of the slot holding the key,
+		/// or _capacity if the key is not in the table.
+	{
+		if (_size == 0) return _capacity;
+
+		std::size_t hash = hashOf(key);
+		size_type mask = _capacity - 1;
+		size_type pos = (hash >> 7) & mask;
+		size_type step = 0;
+		for (;;)
+		{
+			FlatHashGroup group(_pCtrl + pos);
+			for (UInt32 match = group.match(h2(hash)); match; match &= match - 1)
+			{
+				size_type index = (pos + FlatHashGroup::lowestBit(match)) & mask;
+				if (_equal(key, _keyOf(_pSlots[index]))) return index;
+			}
+			if (group.matchEmpty()) return _capacity;
+			step += FlatHashGroup::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	size_type findFree(std::size_t hash) const
+		/// Returns the index of the first empty or deleted
+		/// slot in the probe sequence for the given hash.
+	{
+		size_type mask = _capacity - 1;
+		size_type pos = (hash >> 7) & mask;
+		size_type step = 0;
+		for (;;)
+		{
+			FlatHashGroup group(_pCtrl + pos);
+			UInt32 match = group.matchEmptyOrDeleted();
+			if (match) return (pos + FlatHashGroup::lowestBit(match)) & mask;
+			step += FlatHashGroup::WIDTH;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	template <class V>
+	std::pair<iterator, bool> insertUnique(V&& value)
+	{
+		const Key& key = _keyOf(value);
+		size_type index = findIndex(key);
+		if (index != _capacity) return std::make_pair(iteratorAt(index), false);
+		index = insertNew(hashOf(key), std::forward<V>(value));
+		return std::make_pair(iteratorAt(index), true);
+	}
+
+	template <class... Args>
+	size_type insertNew(std::size_t hash, Args&&... args)
+		/// Inserts a new value, which must not be in the table yet.
+	{
+		if (_growthLeft == 0)
+		{
+			// rehash in place if many slots hold deleted
+			// values, otherwise double the capacity
+			if (_capacity && _size <= maxLoad(_capacity)/2)
+				resize(_capacity);
+			else
+				resize(_capacity ? 2*_capacity : FlatHashGroup::WIDTH);
+		}
+		size_type index = findFree(hash);
+		new (_pSlots + index) Value(std::forward<Args>(args)...);
+		if (_pCtrl[index] == FlatHashGroup::CTRL_EMPTY) --_growthLeft;
+		setCtrl(index, h2(hash));
+		++_size;
+		return index;
+	}
+
+	template <class K>
+	size_type eraseKey(const K& key)
+	{
+		size_type index = findIndex(key);
+		if (index == _capacity) return 0;
+		eraseAt(index);
+		return 1;
+	}
+
+	void eraseAt(size_type index)
+	{
+		_pSlots[index].~Value();
+		--_size;
+
+		// If there is no full group around the slot, no probe
+		// sequence can have passed it, so it can be marked empty
+		// instead of deleted.
+		size_type mask = _capacity - 1;
+		UInt32 emptyBefore = FlatHashGroup(_pCtrl + ((index - FlatHashGroup::WIDTH) & mask)).matchEmpty();
+		UInt32 emptyAfter = FlatHashGroup(_pCtrl + index).matchEmpty();
+		if (emptyBefore && emptyAfter &&
+			FlatHashGroup::lowestBit(emptyAfter) + (FlatHashGroup::WIDTH - 1 - FlatHashGroup::highestBit(emptyBefore)) < FlatHashGroup::WIDTH)
+		{
+			setCtrl(index, FlatHashGroup::CTRL_EMPTY);
+			++_growthLeft;
+		}
+		else
+		{
+			setCtrl(index, FlatHashGroup::CTRL_DELETED);
+		}
+	}
+
+	void setCtrl(size_type index, Int8 ctrl)
+	{
+		_pCtrl[index] = ctrl;
+		// the first group is mirrored behind the last slot
+		if (index < FlatHashGroup::WIDTH) _pCtrl[_capacity + index] = ctrl;
+	}
+
+	iterator iteratorAt(size_type index)
+	{
+		return iterator(_pCtrl + index, _pCtrl + _capacity, _pSlots + index);
+	}
+
+	const_iterator iteratorAt(size_type index) const
+	{
+		return const_iterator(_pCtrl + index, _pCtrl + _capacity, _pSlots + index);
+	}
+
+	static size_type maxLoad(size_type capacity)
+	{
+		return capacity - capacity/8;
+	}
+
+	void resize(size_type capacity)
+	{
+		Int8* pOldCtrl = _pCtrl;
+		Value* pOldSlots = _pSlots;
+		size_type oldCapacity = _capacity;
+
+		_pCtrl = new Int8[capacity + FlatHashGroup::WIDTH];
+		try
+		{
+			_pSlots = static_cast<Value*>(::operator new(capacity*sizeof(Value)));
+		}
+		catch (...)
+		{
+			delete [] _pCtrl;
+			_pCtrl = pOldCtrl;
+			throw;
+		}
+		std::memset(_pCtrl, FlatHashGroup::CTRL_EMPTY, capacity + FlatHashGroup::WIDTH);
+		_capacity = capacity;
+		_growthLeft = maxLoad(capacity) - _size;
+
+		for (size_type i = 0; i < oldCapacity; ++i)
+		{
+			if (pOldCtrl[i] >= 0)
+			{
+				Value& value = pOldSlots[i];
+				std::size_t hash = hashOf(_keyOf(value));
+				size_type index = findFree(hash);
+				new (_pSlots + index) Value(std::move(value));
+				setCtrl(index, h2(hash));
+				value.~Value();
+			}
+		}
+		delete [] pOldCtrl;
+		::operator delete(pOldSlots);
+	}
+
+	void destroy()
+	{
+		for (size_type i = 0; i < _capacity; ++i)
+		{
+			if (_pCtrl[i] >= 0) _pSlots[i].~Value();
+		}
+		delete [] _pCtrl;
+		::operator delete(_pSlots);
+	}
+
+private:
+	Int8*     _pCtrl;
+	Value*    _pSlots;
+	size_type _capacity;
+	size_type _size;
+	size_type _growthLeft;
+	THash     _hash;
+	TEqual    _equal;
+	KeyOf     _keyOf;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FlatHashTable_INCLUDED
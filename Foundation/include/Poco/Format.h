@@ -5,7 +5,8 @@
 // Package: Core
 // Module:  Format
 //
-// Definition of the format freestanding function.
+// Definition of the format freestanding functions and the
+// FormatArg and FormatString classes.
 //
 // Copyright (c) 2006, Applied Informatics Software Engineering GmbH.
 // and Contributors.
@@ -21,15 +22,239 @@
 #include "Poco/Foundation.h"
 #include "Poco/Any.h"
 #include <vector>
+#include <string>
+#include <cstring>
 
 
 namespace Poco {
 
 
-std::string Foundation_API format(const std::string& fmt, const Any& value);
+class Foundation_API FormatArg
+	/// A lightweight, non-owning reference to an argument of format().
+	///
+	/// A FormatArg can be constructed from all argument types supported
+	/// by format(), and from a Poco::Any holding one of them. Arguments
+	/// of any other type are formatted as [ERRFMT].
+	///
+	/// A FormatArg must not outlive the value it has been constructed from.
+{
+public:
+	enum Type
+	{
+		FMT_NONE,
+		FMT_BOOL,
+		FMT_CHAR,
+		FMT_SCHAR,
+		FMT_UCHAR,
+		FMT_SHORT,
+		FMT_USHORT,
+		FMT_INT,
+		FMT_UINT,
+		FMT_LONG,
+		FMT_ULONG,
+		FMT_LONG_LONG,
+		FMT_ULONG_LONG,
+		FMT_FLOAT,
+		FMT_DOUBLE,
+		FMT_LONG_DOUBLE,
+		FMT_STRING,
+		FMT_CSTRING
+	};
+
+	FormatArg(bool value);
+	FormatArg(char value);
+	FormatArg(signed char value);
+	FormatArg(unsigned char value);
+	FormatArg(short value);
+	FormatArg(unsigned short value);
+	FormatArg(int value);
+	FormatArg(unsigned value);
+	FormatArg(long value);
+	FormatArg(unsigned long value);
+	FormatArg(long long value);
+	FormatArg(unsigned long long value);
+	FormatArg(float value);
+	FormatArg(double value);
+	FormatArg(const long double& value);
+	FormatArg(const std::string& value);
+	FormatArg(const char* value);
+	FormatArg(char* value);
+
+	FormatArg(const Any& value);
+		/// Creates a FormatArg referring to the value held by the given Any.
+
+	template <typename T>
+	FormatArg(const T&):
+		_type(FMT_NONE)
+		/// Creates a FormatArg for an unsupported type.
+	{
+		_value.intValue = 0;
+	}
+
+	Type type() const;
+		/// Returns the type of the argument.
+
+	bool isInteger() const;
+		/// Returns true if the argument has a bool, character or integer type.
+
+	bool isSigned() const;
+		/// Returns true if the argument has a signed integer type.
+
+	Int64 intValue() const;
+		/// Returns the value of a signed integer, bool or character argument.
+
+	UInt64 uintValue() const;
+		/// Returns the value of an unsigned integer argument.
+
+	double doubleValue() const;
+		/// Returns the value of a float or double argument.
+
+	const long double& longDoubleValue() const;
+		/// Returns the value of a long double argument.
+
+	const std::string& stringValue() const;
+		/// Returns the value of a std::string argument.
+
+	const char* cstringValue() const;
+		/// Returns the value of a C string argument.
+
+private:
+	Type _type;
+	union
+	{
+		Int64              intValue;
+		UInt64             uintValue;
+		double             doubleValue;
+		const long double* pLongDouble;
+		const std::string* pString;
+		const char*        pChars;
+	} _value;
+};
+
+
+class Foundation_API FormatString
+	/// A format string for format() that is parsed once and can then
+	/// be used to format any number of argument lists, which saves
+	/// parsing the format specifications on every call.
+	///
+	/// Results are the same as calling format() with the format string.
+	///
+	/// Usage Example:
+	///     static const FormatString fmt("%s: %5d bytes");
+	///     std::string s = fmt.format(name, size);
+{
+public:
+	struct Spec
+		/// A parsed format specification. For internal use only.
+	{
+		std::size_t literalOffset;
+			/// Offset of the verbatim text preceding the specification.
+		std::size_t literalLength;
+			/// Length of the verbatim text preceding the specification.
+		std::size_t offset;
+			/// Offset of the character following the percent sign.
+		int index;
+			/// Argument index, -1 for the next argument, or -2
+			/// if there is no format specification.
+		bool left;
+		bool showPos;
+		bool zeroPad;
+		bool alternate;
+		int width;
+		int precision;
+		char modifier;
+		char type;
+	};
+
+	explicit FormatString(const std::string& fmt);
+		/// Creates the FormatString by parsing fmt.
+
+	~FormatString();
+		/// Destroys the FormatString.
+
+	const std::string& toString() const;
+		/// Returns the format string.
+
+	std::size_t argumentCount() const;
+		/// Returns the number of arguments the format string refers to,
+		/// which allows to validate argument lists.
+
+	template <typename T, typename... Args>
+	std::string format(const T& arg, const Args&... args) const
+		/// Returns the formatted string.
+	{
+		std::string result;
+		format(result, arg, args...);
+		return result;
+	}
+
+	template <typename T, typename... Args>
+	void format(std::string& result, const T& arg, const Args&... args) const
+		/// Appends the formatted string to result.
+	{
+		const FormatArg values[] = {FormatArg(arg), FormatArg(args)...};
+		vformat(result, values, 1 + sizeof...(Args));
+	}
+
+	template <typename T, typename... Args>
+	std::size_t formatTo(char* buffer, std::size_t size, const T& arg, const Args&... args) const
+		/// Writes at most size characters of the formatted string to buffer,
+		/// and returns the length of the complete formatted string.
+		/// No terminating zero is written.
+	{
+		const FormatArg values[] = {FormatArg(arg), FormatArg(args)...};
+		return vformatTo(buffer, size, values, 1 + sizeof...(Args));
+	}
+
+	void vformat(std::string& result, const FormatArg* values, std::size_t count) const;
+		/// Appends the string formatted from count values to result.
+
+	std::size_t vformatTo(char* buffer, std::size_t size, const FormatArg* values, std::size_t count) const;
+		/// Writes at most size characters of the string formatted from count values
+		/// to buffer, and returns the length of the complete formatted string.
+
+private:
+	FormatString();
+
+	std::string       _fmt;
+	std::vector<Spec> _specs;
+	std::size_t       _argumentCount;
+};
+
+
+void Foundation_API vformat(std::string& result, const char* fmt, std::size_t length, const FormatArg* values, std::size_t count);
+	/// Appends the string formatted from count values to result.
+	/// Used by all other variants of format().
+
+
+std::size_t Foundation_API vformatTo(char* buffer, std::size_t size, const char* fmt, std::size_t length, const FormatArg* values, std::size_t count);
+	/// Writes at most size characters of the string formatted from count values
+	/// to buffer, and returns the length of the complete formatted string.
+	/// Used by all other variants of formatTo().
+
+
+template <typename T, typename... Args>
+void format(std::string& result, const std::string& fmt, const T& arg, const Args&... args)
+	/// Appends the formatted string to result.
+{
+	const FormatArg values[] = {FormatArg(arg), FormatArg(args)...};
+	vformat(result, fmt.data(), fmt.size(), values, 1 + sizeof...(Args));
+}
+
+
+template <typename T, typename... Args>
+void format(std::string& result, const char* fmt, const T& arg, const Args&... args)
+{
+	const FormatArg values[] = {FormatArg(arg), FormatArg(args)...};
+	vformat(result, fmt, std::strlen(fmt), values, 1 + sizeof...(Args));
+}
+
+
+template <typename T, typename... Args>
+std::string format(const std::string& fmt, const T& arg, const Args&... args)
 	/// This function implements sprintf-style formatting in a typesafe way.
-	/// Various variants of the function are available, supporting a
-	/// different number of arguments (up to six).
+	/// Any number of arguments is supported. Arguments are passed by
+	/// reference and formatted without intermediate heap allocations.
 	///
 	/// The formatting is controlled by the format string in fmt.
 	/// Format strings are quite similar to those of the std::printf() function, but
@@ -61,7 +286,7 @@ std::string Foundation_API format(const std::string& fmt, const Any& value);
 	///   * e signed floating-point value in the form [-]d.dddde[<sign>]dd[d]
 	///   * E signed floating-point value in the form [-]d.ddddE[<sign>]dd[d]
 	///   * f signed floating-point value in the form [-]dddd.dddd
-	///   * s std::string
+	///   * s std::string or C string
 	///   * z std::size_t
 	///
 	/// The following flags are supported:
@@ -101,35 +326,237 @@ std::string Foundation_API format(const std::string& fmt, const Any& value);
 	/// Usage Examples:
 	///     std::string s1 = format("The answer to life, the universe, and everything is %d", 42);
 	///     std::string s2 = format("second: %[1]d, first: %[0]d", 1, 2);
+{
+	std::string result;
+	format(result, fmt, arg, args...);
+	return result;
+}
 
-std::string Foundation_API format(const std::string& fmt, const Any& value1, const Any& value2);
-std::string Foundation_API format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-std::string Foundation_API format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-std::string Foundation_API format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-std::string Foundation_API format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-std::string Foundation_API format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-std::string Foundation_API format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-std::string Foundation_API format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-std::string Foundation_API format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
 
+template <typename T, typename... Args>
+std::string format(const char* fmt, const T& arg, const Args&... args)
+{
+	std::string result;
+	format(result, fmt, arg, args...);
+	return result;
+}
 
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value);
-	/// Appends the formatted string to result.
-	
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2);
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-void Foundation_API format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
+
+template <typename T, typename... Args>
+std::size_t formatTo(char* buffer, std::size_t size, const std::string& fmt, const T& arg, const Args&... args)
+	/// Writes at most size characters of the formatted string to buffer,
+	/// and returns the length of the complete formatted string, similar
+	/// to std::snprintf(). No terminating zero is written.
+{
+	const FormatArg values[] = {FormatArg(arg), FormatArg(args)...};
+	return vformatTo(buffer, size, fmt.data(), fmt.size(), values, 1 + sizeof...(Args));
+}
+
+
+template <typename T, typename... Args>
+std::size_t formatTo(char* buffer, std::size_t size, const char* fmt, const T& arg, const Args&... args)
+{
+	const FormatArg values[] = {FormatArg(arg), FormatArg(args)...};
+	return vformatTo(buffer, size, fmt, std::strlen(fmt), values, 1 + sizeof...(Args));
+}
 
 
 void Foundation_API format(std::string& result, const std::string& fmt, const std::vector<Any>& values);
-	/// Supports a variable number of arguments and is used by
-	/// all other variants of format().
+	/// Supports a variable number of arguments given as
+	/// Poco::Any values.
+
+
+void Foundation_API format(std::string& result, const char* fmt, const std::vector<Any>& values);
+	/// Supports a variable number of arguments given as
+	/// Poco::Any values.
+
+
+//
+// inlines
+//
+inline FormatArg::FormatArg(bool value): _type(FMT_BOOL)
+{
+	_value.intValue = value;
+}
+
+
+inline FormatArg::FormatArg(char value): _type(FMT_CHAR)
+{
+	_value.intValue = value;
+}
+
+
+inline FormatArg::FormatArg(signed char value): _type(FMT_SCHAR)
+{
+	_value.intValue = value;
+}
+
+
+inline FormatArg::FormatArg(unsigned char value): _type(FMT_UCHAR)
+{
+	_value.uintValue = value;
+}
+
+
+inline FormatArg::FormatArg(short value): _type(FMT_SHORT)
+{
+	_value.intValue = value;
+}
+
+
+inline FormatArg::FormatArg(unsigned short value): _type(FMT_USHORT)
+{
+	_value.uintValue = value;
+}
+
+
+inline FormatArg::FormatArg(int value): _type(FMT_INT)
+{
+	_value.intValue = value;
+}
+
+
+inline FormatArg::FormatArg(unsigned value): _type(FMT_UINT)
+{
+	_value.uintValue = value;
+}
+
+
+inline FormatArg::FormatArg(long value): _type(FMT_LONG)
+{
+	_value.intValue = value;
+}
+
+
+inline FormatArg::FormatArg(unsigned long value): _type(FMT_ULONG)
+{
+	_value.uintValue = value;
+}
+
+
+inline FormatArg::FormatArg(long long value): _type(FMT_LONG_LONG)
+{
+	_value.intValue = value;
+}
+
+
+inline FormatArg::FormatArg(unsigned long long value): _type(FMT_ULONG_LONG)
+{
+	_value.uintValue = value;
+}
+
+
+inline FormatArg::FormatArg(float value): _type(FMT_FLOAT)
+{
+	_value.doubleValue = value;
+}
+
+
+inline FormatArg::FormatArg(double value): _type(FMT_DOUBLE)
+{
+	_value.doubleValue = value;
+}
+
+
+inline FormatArg::FormatArg(const long double& value): _type(FMT_LONG_DOUBLE)
+{
+	_value.pLongDouble = &value;
+}
+
+
+inline FormatArg::FormatArg(const std::string& value): _type(FMT_STRING)
+{
+	_value.pString = &value;
+}
+
+
+inline FormatArg::FormatArg(const char* value): _type(FMT_CSTRING)
+{
+	_value.pChars = value;
+}
+
+
+inline FormatArg::FormatArg(char* value): _type(FMT_CSTRING)
+{
+	_value.pChars = value;
+}
+
+
+inline FormatArg::Type FormatArg::type() const
+{
+	return _type;
+}
+
+
+inline bool FormatArg::isInteger() const
+{
+	return _type >= FMT_BOOL && _type <= FMT_ULONG_LONG;
+}
+
+
+inline bool FormatArg::isSigned() const
+{
+	switch (_type)
+	{
+	case FMT_CHAR:
+	case FMT_SCHAR:
+	case FMT_SHORT:
+	case FMT_INT:
+	case FMT_LONG:
+	case FMT_LONG_LONG:
+		return true;
+	default:
+		return false;
+	}
+}
+
+
+inline Int64 FormatArg::intValue() const
+{
+	return _value.intValue;
+}
+
+
+inline UInt64 FormatArg::uintValue() const
+{
+	return _value.uintValue;
+}
+
+
+inline double FormatArg::doubleValue() const
+{
+	return _value.doubleValue;
+}
+
+
+inline const long double& FormatArg::longDoubleValue() const
+{
+	return *_value.pLongDouble;
+}
+
+
+inline const std::string& FormatArg::stringValue() const
+{
+	return *_value.pString;
+}
+
+
+inline const char* FormatArg::cstringValue() const
+{
+	return _value.pChars;
+}
+
+
+inline const std::string& FormatString::toString() const
+{
+	return _fmt;
+}
+
+
+inline std::size_t FormatString::argumentCount() const
+{
+	return _argumentCount;
+}
 
 
 } // namespace Poco
@@ -0,0 +1,118 @@
+//
+// FrequencySketch.h
+//
+// Library: Foundation
+// Package: Cache
+// Module:  TinyLFUStrategy
+//
+// Definition of the FrequencySketch class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_FrequencySketch_INCLUDED
+#define Foundation_FrequencySketch_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API FrequencySketch
+	/// A FrequencySketch is a compact, probabilistic estimator of
+	/// how often an item has been seen recently.
+	///
+	/// The sketch is a count-min sketch with four rows of 4-bit
+	/// counters, so the estimated frequency of an item is at most 15.
+	/// Sixteen counters are packed into a single 64-bit word. Each
+	/// row selects the word for an item with its own hash function,
+	/// so the counters of an item are usually located in four
+	/// different words. Within a word, the counters form four
+	/// groups of four, one counter per row; the group used for
+	/// an item is also selected by its hash.
+	///
+	/// To keep the estimates fresh, all counters are halved once the
+	/// number of recorded events reaches the sample size (ten times
+	/// the capacity), so items that were popular long ago gradually
+	/// lose their weight.
+	///
+	/// Items are identified by their hash value only. Collisions
+	/// may cause the frequency of an item to be overestimated,
+	/// but it is never underestimated (except through aging).
+	///
+	/// The FrequencySketch is used by TinyLFUStrategy to decide
+	/// which entries are admitted to the cache.
+{
+public:
+	enum
+	{
+		MAX_FREQUENCY = 15
+	};
+
+	explicit FrequencySketch(std::size_t capacity);
+		/// Creates the FrequencySketch, sized for a cache
+		/// holding the given number of entries.
+
+	~FrequencySketch();
+		/// Destroys the FrequencySketch.
+
+	void increment(std::size_t hash);
+		/// Records an occurrence of the item with the given hash.
+
+	unsigned estimate(std::size_t hash) const;
+		/// Returns the estimated number of occurrences of the
+		/// item with the given hash (0 to MAX_FREQUENCY).
+
+	void clear();
+		/// Resets all counters to zero.
+
+	std::size_t sampleSize() const;
+		/// Returns the number of recorded events after which
+		/// all counters are halved.
+
+	std::size_t additions() const;
+		/// Returns the number of events recorded since the
+		/// counters have been halved the last time.
+
+private:
+	static UInt64 spread(std::size_t hash);
+	int index(UInt64 hash, int row) const;
+	bool incrementAt(int i, int offset);
+	void age();
+
+	FrequencySketch();
+
+	std::vector<UInt64> _table;
+	UInt64              _mask;
+	std::size_t         _sampleSize;
+	std::size_t         _additions;
+};
+
+
+//
+// inlines
+//
+inline std::size_t FrequencySketch::sampleSize() const
+{
+	return _sampleSize;
+}
+
+
+inline std::size_t FrequencySketch::additions() const
+{
+	return _additions;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_FrequencySketch_INCLUDED
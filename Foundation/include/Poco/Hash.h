@@ -20,6 +20,8 @@
 
 #include "Poco/Foundation.h"
 #include <cstddef>
+#include <cstring>
+#include <string>
 
 
 namespace Poco {
@@ -34,6 +36,7 @@ std::size_t Foundation_API hash(UInt32 n);
 std::size_t Foundation_API hash(Int64 n);
 std::size_t Foundation_API hash(UInt64 n);
 std::size_t Foundation_API hash(const std::string& str);
+std::size_t Foundation_API hash(const char* str, std::size_t length);
 
 
 template <class T>
@@ -48,6 +51,30 @@ struct Hash
 };
 
 
+struct StringHash
+	/// A hash function for strings that can also be used
+	/// with C strings, without constructing a std::string.
+	///
+	/// StringHash is transparent, so it can be used together
+	/// with std::equal_to<> for heterogeneous lookup in a
+	/// FlatHashMap or FlatHashSet.
+{
+	typedef void is_transparent;
+
+	std::size_t operator () (const std::string& str) const
+		/// Returns the hash for the given string.
+	{
+		return Poco::hash(str.data(), str.size());
+	}
+
+	std::size_t operator () (const char* str) const
+		/// Returns the hash for the given C string.
+	{
+		return Poco::hash(str, std::strlen(str));
+	}
+};
+
+
 //
 // inlines
 //
@@ -0,0 +1,79 @@
+//
+// HexBinary.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  HexBinary
+//
+// Definition of class HexBinary.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_HexBinary_INCLUDED
+#define Foundation_HexBinary_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <string>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API HexBinary
+	/// Hexadecimal encoding and decoding of memory buffers.
+	///
+	/// In contrast to HexBinaryEncoder and HexBinaryDecoder, which
+	/// transform streams, these functions transform entire
+	/// buffers at once, using SSSE3 or AVX2 instructions if
+	/// supported by the processor. They never insert line breaks,
+	/// and do not accept whitespace in encoded data.
+{
+public:
+	static std::size_t encode(const void* data, std::size_t length, char* encoded, bool uppercase = false);
+		/// Encodes length bytes from data into the encoded buffer,
+		/// which must have room for 2*length characters.
+		/// Returns the number of characters written.
+
+	static std::string encode(const void* data, std::size_t length, bool uppercase = false);
+		/// Returns the encoding of length bytes from data.
+
+	static std::string encode(const std::string& data, bool uppercase = false);
+		/// Returns the encoding of data.
+
+	static std::size_t decode(const char* encoded, std::size_t length, void* data);
+		/// Decodes length characters from encoded into the data
+		/// buffer, which must have room for length/2 bytes.
+		/// Both upper and lower case digits are accepted.
+		/// Returns the number of bytes written.
+		///
+		/// Throws a DataFormatException if the encoded data
+		/// contains invalid characters, or its length is odd.
+
+	static std::string decode(const std::string& encoded);
+		/// Returns the data decoded from encoded.
+
+private:
+	HexBinary();
+};
+
+
+//
+// inlines
+//
+inline std::string HexBinary::encode(const std::string& data, bool uppercase)
+{
+	return encode(data.data(), data.size(), uppercase);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_HexBinary_INCLUDED
@@ -47,6 +47,12 @@ public:
 private:
 	int readFromDevice();
 	int readOne();
+	std::streamsize xsgetn(char* s, std::streamsize n);
+
+	enum
+	{
+		BLOCK_SIZE = 4*1024
+	};
 
 	std::streambuf& _buf;
 };
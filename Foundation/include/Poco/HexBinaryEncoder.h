@@ -63,6 +63,12 @@ public:
 	
 private:
 	int writeToDevice(char c);
+	std::streamsize xsputn(const char* s, std::streamsize n);
+
+	enum
+	{
+		BLOCK_SIZE = 2*1024
+	};
 
 	int _pos;
 	int _lineLength;
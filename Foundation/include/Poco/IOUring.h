@@ -0,0 +1,255 @@
+//
+// IOUring.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  IOUring
+//
+// Definition of the IOUring class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_IOUring_INCLUDED
+#define Foundation_IOUring_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Timespan.h"
+#include <vector>
+#include <deque>
+#include <functional>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API IOUring
+	/// An engine for asynchronous file and socket I/O.
+	///
+	/// On Linux, IOUring uses the kernel's io_uring interface.
+	/// Operations are queued into the submission ring and handed
+	/// to the kernel in batches, with a single system call for
+	/// all operations queued since the last submission. Buffers
+	/// and file descriptors used frequently can be registered
+	/// with the kernel to save the cost of mapping them for
+	/// every operation.
+	///
+	/// Where io_uring is not available (older kernels, other
+	/// Unix platforms, or if io_uring has been disabled by the
+	/// system administrator), IOUring falls back to ordinary
+	/// system calls: file operations are carried out with
+	/// blocking pread()/pwrite()/fsync() calls when submitted,
+	/// socket operations are carried out when poll() reports
+	/// the socket ready. The API and the semantics of results
+	/// are the same in both modes.
+	///
+	/// The result of an operation is passed to its completion
+	/// callback: the number of bytes transferred (or the poll
+	/// events, for pollAdd()) if the operation succeeded, or a
+	/// negative error number (e.g., -EBADF) if it failed.
+	/// Callbacks are invoked from wait() and complete(), in the
+	/// calling thread. A callback may queue further operations.
+	///
+	/// Buffers passed to an operation must stay valid until its
+	/// callback has been invoked.
+	///
+	/// An IOUring is not thread-safe; each thread doing asynchronous
+	/// I/O should have its own instance.
+{
+public:
+	typedef std::function<void(int)> Callback;
+		/// Completion callback, receiving the result of the operation.
+
+	enum Mode
+	{
+		MODE_AUTO,
+			/// Use io_uring if available, otherwise the fallback.
+		MODE_FALLBACK
+			/// Always use the fallback implementation.
+	};
+
+	enum Options
+	{
+		OPT_DEFAULT    = 0,
+		OPT_FIXED_FILE = 1
+			/// The fd argument of the operation is an index into
+			/// the files registered with registerFiles(), rather
+			/// than a file descriptor.
+	};
+
+	enum PollEvents
+	{
+		POLL_READ  = 0x01,
+		POLL_WRITE = 0x04
+	};
+
+	struct Buffer
+	{
+		void*       data;
+		std::size_t size;
+	};
+
+	explicit IOUring(unsigned entries = 256, Mode mode = MODE_AUTO);
+		/// Creates the IOUring with room for the given number
+		/// of queued operations. If more operations are queued
+		/// before submit() is called, the queued operations are
+		/// submitted automatically.
+		///
+		/// If io_uring is not available, or the ring cannot be
+		/// created, the fallback implementation is used.
+
+	~IOUring();
+		/// Destroys the IOUring. Operations still in progress are
+		/// cancelled; their callbacks are not invoked.
+
+	void read(int fd, void* buffer, std::size_t length, UInt64 offset, const Callback& callback, int options = OPT_DEFAULT);
+		/// Queues a read of up to length bytes at the given file offset.
+		/// An offset of UInt64(-1) reads from the current file position,
+		/// which is required for pipes and other non-seekable files.
+
+	void write(int fd, const void* buffer, std::size_t length, UInt64 offset, const Callback& callback, int options = OPT_DEFAULT);
+		/// Queues a write of length bytes at the given file offset.
+		/// An offset of UInt64(-1) writes at the current file position.
+
+	void readFixed(int fd, void* buffer, std::size_t length, UInt64 offset, int bufferIndex, const Callback& callback, int options = OPT_DEFAULT);
+		/// Queues a read into a part of the registered buffer
+		/// with the given index.
+
+	void writeFixed(int fd, const void* buffer, std::size_t length, UInt64 offset, int bufferIndex, const Callback& callback, int options = OPT_DEFAULT);
+		/// Queues a write from a part of the registered buffer
+		/// with the given index.
+
+	void fsync(int fd, bool dataOnly, const Callback& callback, int options = OPT_DEFAULT);
+		/// Queues a flush of the file's data (and metadata,
+		/// unless dataOnly is true) to the storage device.
+		/// The flush is not ordered with respect to writes queued
+		/// earlier; wait for their completion before queueing it.
+
+	void receive(int fd, void* buffer, std::size_t length, int flags, const Callback& callback, int options = OPT_DEFAULT);
+		/// Queues a recv() on the given socket.
+
+	void send(int fd, const void* buffer, std::size_t length, int flags, const Callback& callback, int options = OPT_DEFAULT);
+		/// Queues a send() on the given socket.
+
+	void pollAdd(int fd, int events, const Callback& callback, int options = OPT_DEFAULT);
+		/// Queues a one-shot wait until the given descriptor
+		/// becomes ready for the given events (POLL_READ, POLL_WRITE).
+		/// The result is the set of events that occurred.
+
+	int submit();
+		/// Hands all queued operations to the kernel (or, in
+		/// fallback mode, carries out the file operations) without
+		/// waiting for completions. Returns the number of
+		/// operations submitted.
+
+	int wait(int minCompletions = 1);
+		/// Submits queued operations and waits until at least
+		/// minCompletions operations (but no more than the number
+		/// of operations in progress) have completed, then invokes
+		/// the callbacks of all completed operations.
+		///
+		/// Returns the number of callbacks invoked.
+
+	int wait(const Poco::Timespan& timeout);
+		/// Submits queued operations and waits up to the given
+		/// timeout for at least one operation to complete, then
+		/// invokes the callbacks of all completed operations.
+		///
+		/// Returns the number of callbacks invoked.
+
+	int complete();
+		/// Submits queued operations and invokes the callbacks
+		/// of all operations that have already completed, without
+		/// waiting. Returns the number of callbacks invoked.
+
+	std::size_t pending() const;
+		/// Returns the number of operations whose callbacks
+		/// have not been invoked yet.
+
+	void registerBuffers(const std::vector<Buffer>& buffers);
+		/// Registers the given buffers for use with readFixed()
+		/// and writeFixed(), replacing previously registered buffers.
+		/// No operations must be in progress.
+
+	void unregisterBuffers();
+		/// Unregisters the buffers registered with registerBuffers().
+
+	void registerFiles(const std::vector<int>& fds);
+		/// Registers the given file descriptors for use with
+		/// OPT_FIXED_FILE, replacing previously registered files.
+		/// No operations must be in progress.
+
+	void unregisterFiles();
+		/// Unregisters the files registered with registerFiles().
+
+	bool usesRing() const;
+		/// Returns true if the IOUring uses io_uring, or false
+		/// if it uses the fallback implementation.
+
+	static bool isAvailable();
+		/// Returns true if io_uring is supported by the system.
+
+private:
+	struct Ring;
+
+	struct Operation
+	{
+		Callback    callback;
+		int         opcode;
+		int         fd;
+		void*       buffer;
+		std::size_t length;
+		UInt64      offset;
+		int         flags;
+	};
+
+	Operation& allocate(const Callback& callback, UInt32& index);
+	void release(UInt32 index);
+	void queue(int opcode, int fd, void* buffer, std::size_t length, UInt64 offset, int flags, int bufferIndex, const Callback& callback, int options);
+	int reap();
+	int enter(unsigned toSubmit, unsigned minComplete);
+	void queueTimeout(const Poco::Timespan& timeout);
+	int dispatch();
+	void execute(UInt32 index);
+	bool pollWaiting(int timeoutMs);
+
+	IOUring(const IOUring&);
+	IOUring& operator = (const IOUring&);
+
+	Ring* _pRing;
+	std::deque<Operation> _ops;
+	std::vector<UInt32> _freeOps;
+	std::size_t _pending;
+	std::vector<UInt32> _queued;
+	std::vector<UInt32> _waiting;
+	std::vector<std::pair<UInt32, int> > _completed;
+	std::vector<Buffer> _buffers;
+	std::vector<int> _files;
+};
+
+
+//
+// inlines
+//
+inline std::size_t IOUring::pending() const
+{
+	return _pending;
+}
+
+
+inline bool IOUring::usesRing() const
+{
+	return _pRing != 0;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_IOUring_INCLUDED
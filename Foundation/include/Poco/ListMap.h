@@ -61,6 +61,12 @@ public:
 		/// Creates the ListMap with room for initialReserve entries.
 	{
 	}
+
+	explicit ListMap(const typename Container::allocator_type& allocator):
+		_list(allocator)
+		/// Creates an empty ListMap that uses the given allocator.
+	{
+	}
 	
 	ListMap& operator = (const ListMap& map)
 		/// Assigns another ListMap.
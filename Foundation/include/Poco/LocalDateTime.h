@@ -256,6 +256,7 @@ private:
 	
 	friend class DateTimeFormatter;
 	friend class DateTimeParser;
+	friend class DateTimePattern;
 };
 
 
@@ -49,6 +49,18 @@ public:
 		/// If flush is true, the text will be immediately
 		/// flushed to the file.
 
+	void writeBuffer(const std::string& buffer, bool flush = true);
+		/// Writes the given buffer, which must consist of
+		/// complete lines including line endings, to the log file.
+		/// If flush is true, the buffer will be immediately
+		/// flushed to the file.
+
+	void sync(bool dataOnly = false);
+		/// Forces everything written to the log file so far
+		/// onto the storage device. If dataOnly is true, file
+		/// metadata not needed to read the data back may not
+		/// be synchronized, if the platform supports this.
+
 	UInt64 size() const;
 		/// Returns the current size in bytes of the log file.
 
@@ -69,6 +81,18 @@ inline void LogFile::write(const std::string& text, bool flush)
 }
 
 
+inline void LogFile::writeBuffer(const std::string& buffer, bool flush)
+{
+	writeBufferImpl(buffer, flush);
+}
+
+
+inline void LogFile::sync(bool dataOnly)
+{
+	syncImpl(dataOnly);
+}
+
+
 inline UInt64 LogFile::size() const
 {
 	return sizeImpl();
@@ -26,6 +26,7 @@
 #include <vector>
 #include <cstddef>
 #include <atomic>
+#include <type_traits>
 
 
 namespace Poco {
@@ -34,6 +35,29 @@ namespace Poco {
 class Exception;
 
 
+namespace Impl {
+
+
+template <typename T, typename... Args>
+struct IsFileLine: std::false_type
+	/// True if the arguments following a message are a file
+	/// name and a line number, so that the Logger member
+	/// functions taking a file and a line are used instead of
+	/// formatting the message with the arguments.
+{
+};
+
+
+template <typename T, typename L>
+struct IsFileLine<T, L>: std::integral_constant<bool,
+	std::is_convertible<const T&, const char*>::value && std::is_integral<L>::value>
+{
+};
+
+
+} // namespace Impl
+
+
 class Foundation_API Logger: public Channel
 	/// Logger is a special Channel that acts as the main
 	/// entry point into the logging framework.
@@ -73,11 +97,21 @@ class Foundation_API Logger: public Channel
 	/// are used. The macros also add the source file path and line
 	/// number into the log message so that it is available to formatters.
 	/// Variants of these macros that allow message formatting with Poco::format()
-	/// are also available. Up to four arguments are supported.
+	/// are also available, either with a fixed number of arguments (up to four)
+	/// or with a variable number of arguments (up to ten).
+	///
+	/// Macros for priorities less important than POCO_LOG_LEVEL expand
+	/// to nothing and thus have no run-time cost at all. By default,
+	/// debug and trace messages are only compiled into debug builds.
 	///
 	/// Examples:
 	///     poco_warning(logger, "This is a warning");
 	///     poco_information_f2(logger, "An informational message with args: %d, %d", 1, 2);
+	///     poco_debug_f(logger, "A debug message with args: %s, %d, %d", name, 1, 2);
+	///
+	/// The formatting methods (e.g., information(fmt, arg1, ...)) also
+	/// check the log level before formatting the message, so arguments
+	/// are only formatted if the message is actually logged.
 {
 public:
 	const std::string& name() const;
@@ -151,16 +185,14 @@ public:
 		/// the __FILE__ macro. The string is not copied
 		/// internally for performance reasons.	
 
-	void fatal(const std::string& fmt, const Any& value1);
-	void fatal(const std::string& fmt, const Any& value1, const Any& value2);
-	void fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-	void fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-	void fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-	void fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-	void fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-	void fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-	void fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-	void fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
+	template <typename T, typename... Args>
+	typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type fatal(const std::string& fmt, const T& arg1, const Args&... args);
+		/// If the Logger's log level is at least PRIO_FATAL,
+		/// formats the given arguments using Poco::format()
+		/// and logs the resulting text with priority PRIO_FATAL.
+		///
+		/// The arguments are only formatted if the message
+		/// is actually logged.
 
 	void critical(const std::string& msg);
 		/// If the Logger's log level is at least PRIO_CRITICAL,
@@ -178,16 +210,14 @@ public:
 		/// the __FILE__ macro. The string is not copied
 		/// internally for performance reasons.	
 
-	void critical(const std::string& fmt, const Any& value1);
-	void critical(const std::string& fmt, const Any& value1, const Any& value2);
-	void critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-	void critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-	void critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-	void critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-	void critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-	void critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-	void critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-	void critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
+	template <typename T, typename... Args>
+	typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type critical(const std::string& fmt, const T& arg1, const Args&... args);
+		/// If the Logger's log level is at least PRIO_CRITICAL,
+		/// formats the given arguments using Poco::format()
+		/// and logs the resulting text with priority PRIO_CRITICAL.
+		///
+		/// The arguments are only formatted if the message
+		/// is actually logged.
 
 	void error(const std::string& msg);
 		/// If the Logger's log level is at least PRIO_ERROR,
@@ -205,16 +235,14 @@ public:
 		/// the __FILE__ macro. The string is not copied
 		/// internally for performance reasons.	
 
-	void error(const std::string& fmt, const Any& value1);
-	void error(const std::string& fmt, const Any& value1, const Any& value2);
-	void error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-	void error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-	void error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-	void error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-	void error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-	void error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-	void error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-	void error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
+	template <typename T, typename... Args>
+	typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type error(const std::string& fmt, const T& arg1, const Args&... args);
+		/// If the Logger's log level is at least PRIO_ERROR,
+		/// formats the given arguments using Poco::format()
+		/// and logs the resulting text with priority PRIO_ERROR.
+		///
+		/// The arguments are only formatted if the message
+		/// is actually logged.
 
 	void warning(const std::string& msg);
 		/// If the Logger's log level is at least PRIO_WARNING,
@@ -232,16 +260,14 @@ public:
 		/// the __FILE__ macro. The string is not copied
 		/// internally for performance reasons.	
 
-	void warning(const std::string& fmt, const Any& value1);
-	void warning(const std::string& fmt, const Any& value1, const Any& value2);
-	void warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-	void warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-	void warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-	void warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-	void warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-	void warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-	void warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-	void warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
+	template <typename T, typename... Args>
+	typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type warning(const std::string& fmt, const T& arg1, const Args&... args);
+		/// If the Logger's log level is at least PRIO_WARNING,
+		/// formats the given arguments using Poco::format()
+		/// and logs the resulting text with priority PRIO_WARNING.
+		///
+		/// The arguments are only formatted if the message
+		/// is actually logged.
 
 	void notice(const std::string& msg);
 		/// If the Logger's log level is at least PRIO_NOTICE,
@@ -259,16 +285,14 @@ public:
 		/// the __FILE__ macro. The string is not copied
 		/// internally for performance reasons.	
 
-	void notice(const std::string& fmt, const Any& value1);
-	void notice(const std::string& fmt, const Any& value1, const Any& value2);
-	void notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-	void notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-	void notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-	void notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-	void notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-	void notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-	void notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-	void notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
+	template <typename T, typename... Args>
+	typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type notice(const std::string& fmt, const T& arg1, const Args&... args);
+		/// If the Logger's log level is at least PRIO_NOTICE,
+		/// formats the given arguments using Poco::format()
+		/// and logs the resulting text with priority PRIO_NOTICE.
+		///
+		/// The arguments are only formatted if the message
+		/// is actually logged.
 
 	void information(const std::string& msg);
 		/// If the Logger's log level is at least PRIO_INFORMATION,
@@ -286,16 +310,14 @@ public:
 		/// the __FILE__ macro. The string is not copied
 		/// internally for performance reasons.	
 
-	void information(const std::string& fmt, const Any& value1);
-	void information(const std::string& fmt, const Any& value1, const Any& value2);
-	void information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-	void information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-	void information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-	void information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-	void information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-	void information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-	void information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-	void information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
+	template <typename T, typename... Args>
+	typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type information(const std::string& fmt, const T& arg1, const Args&... args);
+		/// If the Logger's log level is at least PRIO_INFORMATION,
+		/// formats the given arguments using Poco::format()
+		/// and logs the resulting text with priority PRIO_INFORMATION.
+		///
+		/// The arguments are only formatted if the message
+		/// is actually logged.
 
 	void debug(const std::string& msg);
 		/// If the Logger's log level is at least PRIO_DEBUG,
@@ -313,16 +335,14 @@ public:
 		/// the __FILE__ macro. The string is not copied
 		/// internally for performance reasons.	
 
-	void debug(const std::string& fmt, const Any& value1);
-	void debug(const std::string& fmt, const Any& value1, const Any& value2);
-	void debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-	void debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-	void debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-	void debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-	void debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-	void debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-	void debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-	void debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
+	template <typename T, typename... Args>
+	typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type debug(const std::string& fmt, const T& arg1, const Args&... args);
+		/// If the Logger's log level is at least PRIO_DEBUG,
+		/// formats the given arguments using Poco::format()
+		/// and logs the resulting text with priority PRIO_DEBUG.
+		///
+		/// The arguments are only formatted if the message
+		/// is actually logged.
 
 	void trace(const std::string& msg);
 		/// If the Logger's log level is at least PRIO_TRACE,
@@ -340,16 +360,14 @@ public:
 		/// the __FILE__ macro. The string is not copied
 		/// internally for performance reasons.	
 
-	void trace(const std::string& fmt, const Any& value1);
-	void trace(const std::string& fmt, const Any& value1, const Any& value2);
-	void trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3);
-	void trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4);
-	void trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5);
-	void trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6);
-	void trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7);
-	void trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8);
-	void trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9);
-	void trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10);
+	template <typename T, typename... Args>
+	typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type trace(const std::string& fmt, const T& arg1, const Args&... args);
+		/// If the Logger's log level is at least PRIO_TRACE,
+		/// formats the given arguments using Poco::format()
+		/// and logs the resulting text with priority PRIO_TRACE.
+		///
+		/// The arguments are only formatted if the message
+		/// is actually logged.
 
 	void dump(const std::string& msg, const void* buffer, std::size_t length, Message::Priority prio = Message::PRIO_DEBUG);
 		/// Logs the given message, followed by the data in buffer.
@@ -494,6 +512,9 @@ protected:
 	void log(const std::string& text, Message::Priority prio);
 	void log(const std::string& text, Message::Priority prio, const char* file, int line);
 
+	template <typename... Args>
+	void logFormat(Message::Priority prio, const std::string& fmt, const Args&... args);
+
 	static std::string format(const std::string& fmt, int argc, std::string argv[]);
 	static Logger& parent(const std::string& name);
 	static void add(Logger* pLogger);
@@ -510,103 +531,200 @@ private:
 
 	static LoggerMap* _pLoggerMap;
 	static Mutex      _mapMtx;
+	static std::atomic<UInt32> _generation;
+
+	friend class LoggerHandle;
 };
 
 
 //
 // convenience macros
 //
-#define poco_fatal(logger, msg) \
-	if ((logger).fatal()) (logger).fatal(msg, __FILE__, __LINE__); else (void) 0
+// POCO_LOG_LEVEL specifies the lowest priority (as numeric value,
+// see Message::Priority) for which the convenience macros generate code.
+// Macros for less important priorities expand to nothing, so
+// neither the level check nor the argument expressions remain
+// in the compiled code. The default is 8 (PRIO_TRACE) for debug
+// builds or if POCO_LOG_DEBUG is defined, 6 (PRIO_INFORMATION) otherwise.
+//
+#if !defined(POCO_LOG_LEVEL)
+	#if defined(_DEBUG) || defined(POCO_LOG_DEBUG)
+		#define POCO_LOG_LEVEL 8
+	#else
+		#define POCO_LOG_LEVEL 6
+	#endif
+#endif
 
-#define poco_fatal_f1(logger, fmt, arg1) \
-	if ((logger).fatal()) (logger).fatal(Poco::format((fmt), arg1), __FILE__, __LINE__); else (void) 0
 
-#define poco_fatal_f2(logger, fmt, arg1, arg2) \
-	if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+#if POCO_LOG_LEVEL >= 1
+	#define poco_fatal(logger, msg) \
+		if ((logger).fatal()) (logger).fatal(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_fatal_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f1(logger, fmt, arg1) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_fatal_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f2(logger, fmt, arg1, arg2) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#define poco_critical(logger, msg) \
-	if ((logger).critical()) (logger).critical(msg, __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
 
-#define poco_critical_f1(logger, fmt, arg1) \
-	if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
 
-#define poco_critical_f2(logger, fmt, arg1, arg2) \
-	if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+	#define poco_fatal_f(logger, fmt, ...) \
+		if ((logger).fatal()) (logger).fatal(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_fatal(logger, msg)
+	#define poco_fatal_f1(logger, fmt, arg1)
+	#define poco_fatal_f2(logger, fmt, arg1, arg2)
+	#define poco_fatal_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_fatal_f4(logger, fmt, arg1, arg2, arg3, arg4)
+	#define poco_fatal_f(logger, fmt, ...)
+#endif
 
-#define poco_critical_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
 
-#define poco_critical_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+#if POCO_LOG_LEVEL >= 2
+	#define poco_critical(logger, msg) \
+		if ((logger).critical()) (logger).critical(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_error(logger, msg) \
-	if ((logger).error()) (logger).error(msg, __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f1(logger, fmt, arg1) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_error_f1(logger, fmt, arg1) \
-	if ((logger).error()) (logger).error(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f2(logger, fmt, arg1, arg2) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#define poco_error_f2(logger, fmt, arg1, arg2) \
-	if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
 
-#define poco_error_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
 
-#define poco_error_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+	#define poco_critical_f(logger, fmt, ...) \
+		if ((logger).critical()) (logger).critical(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_critical(logger, msg)
+	#define poco_critical_f1(logger, fmt, arg1)
+	#define poco_critical_f2(logger, fmt, arg1, arg2)
+	#define poco_critical_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_critical_f4(logger, fmt, arg1, arg2, arg3, arg4)
+	#define poco_critical_f(logger, fmt, ...)
+#endif
 
-#define poco_warning(logger, msg) \
-	if ((logger).warning()) (logger).warning(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_warning_f1(logger, fmt, arg1) \
-	if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+#if POCO_LOG_LEVEL >= 3
+	#define poco_error(logger, msg) \
+		if ((logger).error()) (logger).error(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_warning_f2(logger, fmt, arg1, arg2) \
-	if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+	#define poco_error_f1(logger, fmt, arg1) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_warning_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+	#define poco_error_f2(logger, fmt, arg1, arg2) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#define poco_warning_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
-	
-#define poco_notice(logger, msg) \
-	if ((logger).notice()) (logger).notice(msg, __FILE__, __LINE__); else (void) 0
+	#define poco_error_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
 
-#define poco_notice_f1(logger, fmt, arg1) \
-	if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+	#define poco_error_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_error_f(logger, fmt, ...) \
+		if ((logger).error()) (logger).error(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_error(logger, msg)
+	#define poco_error_f1(logger, fmt, arg1)
+	#define poco_error_f2(logger, fmt, arg1, arg2)
+	#define poco_error_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_error_f4(logger, fmt, arg1, arg2, arg3, arg4)
+	#define poco_error_f(logger, fmt, ...)
+#endif
 
-#define poco_notice_f2(logger, fmt, arg1, arg2) \
-	if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#define poco_notice_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+#if POCO_LOG_LEVEL >= 4
+	#define poco_warning(logger, msg) \
+		if ((logger).warning()) (logger).warning(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_notice_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+	#define poco_warning_f1(logger, fmt, arg1) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_information(logger, msg) \
-	if ((logger).information()) (logger).information(msg, __FILE__, __LINE__); else (void) 0
+	#define poco_warning_f2(logger, fmt, arg1, arg2) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_warning_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_warning_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_warning_f(logger, fmt, ...) \
+		if ((logger).warning()) (logger).warning(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_warning(logger, msg)
+	#define poco_warning_f1(logger, fmt, arg1)
+	#define poco_warning_f2(logger, fmt, arg1, arg2)
+	#define poco_warning_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_warning_f4(logger, fmt, arg1, arg2, arg3, arg4)
+	#define poco_warning_f(logger, fmt, ...)
+#endif
 
-#define poco_information_f1(logger, fmt, arg1) \
-	if ((logger).information()) (logger).information(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_information_f2(logger, fmt, arg1, arg2) \
-	if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+#if POCO_LOG_LEVEL >= 5
+	#define poco_notice(logger, msg) \
+		if ((logger).notice()) (logger).notice(msg, __FILE__, __LINE__); else (void) 0
 
-#define poco_information_f3(logger, fmt, arg1, arg2, arg3) \
-	if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+	#define poco_notice_f1(logger, fmt, arg1) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
 
-#define poco_information_f4(logger, fmt, arg1, arg2, arg3, arg4) \
-	if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+	#define poco_notice_f2(logger, fmt, arg1, arg2) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
 
-#if defined(_DEBUG) || defined(POCO_LOG_DEBUG)
+	#define poco_notice_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_notice_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_notice_f(logger, fmt, ...) \
+		if ((logger).notice()) (logger).notice(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_notice(logger, msg)
+	#define poco_notice_f1(logger, fmt, arg1)
+	#define poco_notice_f2(logger, fmt, arg1, arg2)
+	#define poco_notice_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_notice_f4(logger, fmt, arg1, arg2, arg3, arg4)
+	#define poco_notice_f(logger, fmt, ...)
+#endif
+
+
+#if POCO_LOG_LEVEL >= 6
+	#define poco_information(logger, msg) \
+		if ((logger).information()) (logger).information(msg, __FILE__, __LINE__); else (void) 0
+
+	#define poco_information_f1(logger, fmt, arg1) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), (arg1)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_information_f2(logger, fmt, arg1, arg2) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_information_f3(logger, fmt, arg1, arg2, arg3) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2), (arg3)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_information_f4(logger, fmt, arg1, arg2, arg3, arg4) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_information_f(logger, fmt, ...) \
+		if ((logger).information()) (logger).information(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_information(logger, msg)
+	#define poco_information_f1(logger, fmt, arg1)
+	#define poco_information_f2(logger, fmt, arg1, arg2)
+	#define poco_information_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_information_f4(logger, fmt, arg1, arg2, arg3, arg4)
+	#define poco_information_f(logger, fmt, ...)
+#endif
+
+
+#if POCO_LOG_LEVEL >= 7
 	#define poco_debug(logger, msg) \
 		if ((logger).debug()) (logger).debug(msg, __FILE__, __LINE__); else (void) 0
 
@@ -622,6 +740,19 @@ private:
 	#define poco_debug_f4(logger, fmt, arg1, arg2, arg3, arg4) \
 		if ((logger).debug()) (logger).debug(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
 
+	#define poco_debug_f(logger, fmt, ...) \
+		if ((logger).debug()) (logger).debug(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
+#else
+	#define poco_debug(logger, msg)
+	#define poco_debug_f1(logger, fmt, arg1)
+	#define poco_debug_f2(logger, fmt, arg1, arg2)
+	#define poco_debug_f3(logger, fmt, arg1, arg2, arg3)
+	#define poco_debug_f4(logger, fmt, arg1, arg2, arg3, arg4)
+	#define poco_debug_f(logger, fmt, ...)
+#endif
+
+
+#if POCO_LOG_LEVEL >= 8
 	#define poco_trace(logger, msg) \
 		if ((logger).trace()) (logger).trace(msg, __FILE__, __LINE__); else (void) 0
 
@@ -636,17 +767,16 @@ private:
 
 	#define poco_trace_f4(logger, fmt, arg1, arg2, arg3, arg4) \
 		if ((logger).trace()) (logger).trace(Poco::format((fmt), (arg1), (arg2), (arg3), (arg4)), __FILE__, __LINE__); else (void) 0
+
+	#define poco_trace_f(logger, fmt, ...) \
+		if ((logger).trace()) (logger).trace(Poco::format((fmt), __VA_ARGS__), __FILE__, __LINE__); else (void) 0
 #else
-	#define poco_debug(logger, msg)
-	#define poco_debug_f1(logger, fmt, arg1)
-	#define poco_debug_f2(logger, fmt, arg1, arg2)
-	#define poco_debug_f3(logger, fmt, arg1, arg2, arg3)
-	#define poco_debug_f4(logger, fmt, arg1, arg2, arg3, arg4)
 	#define poco_trace(logger, msg)
 	#define poco_trace_f1(logger, fmt, arg1)
 	#define poco_trace_f2(logger, fmt, arg1, arg2)
 	#define poco_trace_f3(logger, fmt, arg1, arg2, arg3)
 	#define poco_trace_f4(logger, fmt, arg1, arg2, arg3, arg4)
+	#define poco_trace_f(logger, fmt, ...)
 #endif
 
 
@@ -683,75 +813,32 @@ inline void Logger::log(const std::string& text, Message::Priority prio, const c
 }
 
 
-inline void Logger::fatal(const std::string& msg)
-{
-	log(msg, Message::PRIO_FATAL);
-}
-
-
-inline void Logger::fatal(const std::string& msg, const char* file, int line)
-{
-	log(msg, Message::PRIO_FATAL, file, line);
-}
-
-
-inline void Logger::fatal(const std::string& fmt, const Any& value1)
-{
-	log(Poco::format(fmt, value1), Message::PRIO_FATAL);
-}
-
-
-inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2)
+template <typename... Args>
+inline void Logger::logFormat(Message::Priority prio, const std::string& fmt, const Args&... args)
 {
-	log(Poco::format(fmt, value1, value2), Message::PRIO_FATAL);
-}
-
-
-inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
-{
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_FATAL);
-}
-
-
-inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_FATAL);
-}
-
-
-inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_FATAL);
-}
-
-
-inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_FATAL);
-}
-
-
-inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7), Message::PRIO_FATAL);
+	if (_level >= prio && _pChannel)
+	{
+		_pChannel->log(Message(_name, Poco::format(fmt, args...), prio));
+	}
 }
 
 
-inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
+inline void Logger::fatal(const std::string& msg)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8), Message::PRIO_FATAL);
+	log(msg, Message::PRIO_FATAL);
 }
 
 
-inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
+inline void Logger::fatal(const std::string& msg, const char* file, int line)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9), Message::PRIO_FATAL);
+	log(msg, Message::PRIO_FATAL, file, line);
 }
 
 
-inline void Logger::fatal(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
+template <typename T, typename... Args>
+inline typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type Logger::fatal(const std::string& fmt, const T& arg1, const Args&... args)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10), Message::PRIO_FATAL);
+	logFormat(Message::PRIO_FATAL, fmt, arg1, args...);
 }
 
 
@@ -767,63 +854,10 @@ inline void Logger::critical(const std::string& msg, const char* file, int line)
 }
 
 
-inline void Logger::critical(const std::string& fmt, const Any& value1)
-{
-	log(Poco::format(fmt, value1), Message::PRIO_CRITICAL);
-}
-
-
-inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2)
-{
-	log(Poco::format(fmt, value1, value2), Message::PRIO_CRITICAL);
-}
-
-
-inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
-{
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_CRITICAL);
-}
-
-
-inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_CRITICAL);
-}
-
-
-inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_CRITICAL);
-}
-
-
-inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
+template <typename T, typename... Args>
+inline typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type Logger::critical(const std::string& fmt, const T& arg1, const Args&... args)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_CRITICAL);
-}
-
-
-inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7), Message::PRIO_CRITICAL);
-}
-
-
-inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8), Message::PRIO_CRITICAL);
-}
-
-
-inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9), Message::PRIO_CRITICAL);
-}
-
-
-inline void Logger::critical(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10), Message::PRIO_CRITICAL);
+	logFormat(Message::PRIO_CRITICAL, fmt, arg1, args...);
 }
 
 
@@ -839,63 +873,10 @@ inline void Logger::error(const std::string& msg, const char* file, int line)
 }
 
 
-inline void Logger::error(const std::string& fmt, const Any& value1)
-{
-	log(Poco::format(fmt, value1), Message::PRIO_ERROR);
-}
-
-
-inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2)
-{
-	log(Poco::format(fmt, value1, value2), Message::PRIO_ERROR);
-}
-
-
-inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
-{
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_ERROR);
-}
-
-
-inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_ERROR);
-}
-
-
-inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_ERROR);
-}
-
-
-inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_ERROR);
-}
-
-
-inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7), Message::PRIO_ERROR);
-}
-
-
-inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8), Message::PRIO_ERROR);
-}
-
-
-inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9), Message::PRIO_ERROR);
-}
-
-
-inline void Logger::error(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
+template <typename T, typename... Args>
+inline typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type Logger::error(const std::string& fmt, const T& arg1, const Args&... args)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10), Message::PRIO_ERROR);
+	logFormat(Message::PRIO_ERROR, fmt, arg1, args...);
 }
 
 
@@ -911,63 +892,10 @@ inline void Logger::warning(const std::string& msg, const char* file, int line)
 }
 
 
-inline void Logger::warning(const std::string& fmt, const Any& value1)
-{
-	log(Poco::format(fmt, value1), Message::PRIO_WARNING);
-}
-
-
-inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2)
-{
-	log(Poco::format(fmt, value1, value2), Message::PRIO_WARNING);
-}
-
-
-inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
-{
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_WARNING);
-}
-
-
-inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
+template <typename T, typename... Args>
+inline typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type Logger::warning(const std::string& fmt, const T& arg1, const Args&... args)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_WARNING);
-}
-
-
-inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_WARNING);
-}
-
-
-inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_WARNING);
-}
-
-
-inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7), Message::PRIO_WARNING);
-}
-
-
-inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8), Message::PRIO_WARNING);
-}
-
-
-inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9), Message::PRIO_WARNING);
-}
-
-
-inline void Logger::warning(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10), Message::PRIO_WARNING);
+	logFormat(Message::PRIO_WARNING, fmt, arg1, args...);
 }
 
 
@@ -983,63 +911,10 @@ inline void Logger::notice(const std::string& msg, const char* file, int line)
 }
 
 
-inline void Logger::notice(const std::string& fmt, const Any& value1)
+template <typename T, typename... Args>
+inline typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type Logger::notice(const std::string& fmt, const T& arg1, const Args&... args)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_NOTICE);
-}
-
-
-inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2)
-{
-	log(Poco::format(fmt, value1, value2), Message::PRIO_NOTICE);
-}
-
-
-inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
-{
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_NOTICE);
-}
-
-
-inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_NOTICE);
-}
-
-
-inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_NOTICE);
-}
-
-
-inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_NOTICE);
-}
-
-
-inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7), Message::PRIO_NOTICE);
-}
-
-
-inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8), Message::PRIO_NOTICE);
-}
-
-
-inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9), Message::PRIO_NOTICE);
-}
-
-
-inline void Logger::notice(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10), Message::PRIO_NOTICE);
+	logFormat(Message::PRIO_NOTICE, fmt, arg1, args...);
 }
 
 
@@ -1055,63 +930,10 @@ inline void Logger::information(const std::string& msg, const char* file, int li
 }
 
 
-inline void Logger::information(const std::string& fmt, const Any& value1)
-{
-	log(Poco::format(fmt, value1), Message::PRIO_INFORMATION);
-}
-
-
-inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2)
-{
-	log(Poco::format(fmt, value1, value2), Message::PRIO_INFORMATION);
-}
-
-
-inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
-{
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_INFORMATION);
-}
-
-
-inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_INFORMATION);
-}
-
-
-inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_INFORMATION);
-}
-
-
-inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_INFORMATION);
-}
-
-
-inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7), Message::PRIO_INFORMATION);
-}
-
-
-inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8), Message::PRIO_INFORMATION);
-}
-
-
-inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9), Message::PRIO_INFORMATION);
-}
-
-
-inline void Logger::information(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
+template <typename T, typename... Args>
+inline typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type Logger::information(const std::string& fmt, const T& arg1, const Args&... args)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10), Message::PRIO_INFORMATION);
+	logFormat(Message::PRIO_INFORMATION, fmt, arg1, args...);
 }
 
 
@@ -1127,63 +949,10 @@ inline void Logger::debug(const std::string& msg, const char* file, int line)
 }
 
 
-inline void Logger::debug(const std::string& fmt, const Any& value1)
+template <typename T, typename... Args>
+inline typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type Logger::debug(const std::string& fmt, const T& arg1, const Args&... args)
 {
-	log(Poco::format(fmt, value1), Message::PRIO_DEBUG);
-}
-
-
-inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2)
-{
-	log(Poco::format(fmt, value1, value2), Message::PRIO_DEBUG);
-}
-
-
-inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
-{
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_DEBUG);
-}
-
-
-inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_DEBUG);
-}
-
-
-inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_DEBUG);
-}
-
-
-inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_DEBUG);
-}
-
-
-inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7), Message::PRIO_DEBUG);
-}
-
-
-inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8), Message::PRIO_DEBUG);
-}
-
-
-inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9), Message::PRIO_DEBUG);
-}
-
-
-inline void Logger::debug(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10), Message::PRIO_DEBUG);
+	logFormat(Message::PRIO_DEBUG, fmt, arg1, args...);
 }
 
 
@@ -1199,63 +968,10 @@ inline void Logger::trace(const std::string& msg, const char* file, int line)
 }
 
 
-inline void Logger::trace(const std::string& fmt, const Any& value1)
-{
-	log(Poco::format(fmt, value1), Message::PRIO_TRACE);
-}
-
-
-inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2)
-{
-	log(Poco::format(fmt, value1, value2), Message::PRIO_TRACE);
-}
-
-
-inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
-{
-	log(Poco::format(fmt, value1, value2, value3), Message::PRIO_TRACE);
-}
-
-
-inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4), Message::PRIO_TRACE);
-}
-
-
-inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5), Message::PRIO_TRACE);
-}
-
-
-inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6), Message::PRIO_TRACE);
-}
-
-
-inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7), Message::PRIO_TRACE);
-}
-
-
-inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8), Message::PRIO_TRACE);
-}
-
-
-inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
-{
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9), Message::PRIO_TRACE);
-}
-
-
-inline void Logger::trace(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
+template <typename T, typename... Args>
+inline typename std::enable_if<!Impl::IsFileLine<T, Args...>::value>::type Logger::trace(const std::string& fmt, const T& arg1, const Args&... args)
 {
-	log(Poco::format(fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10), Message::PRIO_TRACE);
+	logFormat(Message::PRIO_TRACE, fmt, arg1, args...);
 }
 
 
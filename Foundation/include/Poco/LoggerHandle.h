@@ -0,0 +1,141 @@
+//
+// LoggerHandle.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  LoggerHandle
+//
+// Definition of the LoggerHandle class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_LoggerHandle_INCLUDED
+#define Foundation_LoggerHandle_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Logger.h"
+#include <atomic>
+
+
+namespace Poco {
+
+
+class LoggerHandle
+	/// A LoggerHandle caches a reference to the Logger with
+	/// a given name, so that the Logger does not have to be
+	/// looked up (which requires locking a global mutex
+	/// and searching the logger map) for every log statement.
+	///
+	/// The handle resolves the Logger on first use. If any
+	/// Logger is destroyed afterwards, via Logger::destroy() or
+	/// Logger::shutdown(), the handle resolves the Logger again
+	/// on its next use. Otherwise, obtaining the Logger costs
+	/// only two atomic loads.
+	///
+	/// LoggerHandle objects are typically static or class members:
+	///     static Poco::LoggerHandle logger("MyApp.Network");
+	///     poco_information(*logger, "Connection established");
+	///
+	/// As with references obtained from Logger::get(),
+	/// a Logger must not be destroyed while another thread
+	/// is using it through a LoggerHandle.
+{
+public:
+	explicit LoggerHandle(const std::string& name);
+		/// Creates the LoggerHandle for the Logger with the given name.
+		/// The Logger is not looked up until the handle is used.
+
+	~LoggerHandle();
+		/// Destroys the LoggerHandle.
+
+	const std::string& name() const;
+		/// Returns the name of the Logger.
+
+	Logger& logger() const;
+		/// Returns a reference to the Logger, creating
+		/// the Logger if it does not yet exist.
+
+	Logger& operator * () const;
+		/// Returns a reference to the Logger.
+
+	Logger* operator -> () const;
+		/// Returns a pointer to the Logger.
+
+private:
+	Logger& resolve() const;
+
+	LoggerHandle();
+	LoggerHandle(const LoggerHandle&);
+	LoggerHandle& operator = (const LoggerHandle&);
+
+	const std::string             _name;
+	mutable std::atomic<Logger*>  _pLogger;
+	mutable std::atomic<UInt32>   _generation;
+};
+
+
+//
+// inlines
+//
+inline LoggerHandle::LoggerHandle(const std::string& name):
+	_name(name),
+	_pLogger(0),
+	_generation(0)
+{
+}
+
+
+inline LoggerHandle::~LoggerHandle()
+{
+}
+
+
+inline const std::string& LoggerHandle::name() const
+{
+	return _name;
+}
+
+
+inline Logger& LoggerHandle::logger() const
+{
+	UInt32 generation = _generation.load(std::memory_order_acquire);
+	Logger* pLogger = _pLogger.load(std::memory_order_acquire);
+	if (pLogger && generation == Logger::_generation.load(std::memory_order_acquire))
+		return *pLogger;
+	else
+		return resolve();
+}
+
+
+inline Logger& LoggerHandle::operator * () const
+{
+	return logger();
+}
+
+
+inline Logger* LoggerHandle::operator -> () const
+{
+	return &logger();
+}
+
+
+inline Logger& LoggerHandle::resolve() const
+{
+	UInt32 generation = Logger::_generation.load(std::memory_order_acquire);
+	Logger& logger = Logger::get(_name);
+	_pLogger.store(&logger, std::memory_order_release);
+	_generation.store(generation, std::memory_order_release);
+	return logger;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_LoggerHandle_INCLUDED
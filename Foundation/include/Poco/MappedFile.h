@@ -0,0 +1,207 @@
+//
+// MappedFile.h
+//
+// Library: Foundation
+// Package: Filesystem
+// Module:  MappedFile
+//
+// Definition of the MappedFile class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MappedFile_INCLUDED
+#define Foundation_MappedFile_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API MappedFile
+	/// A MappedFile maps the contents of a file read-only
+	/// into memory.
+	///
+	/// The file's contents can be accessed directly via begin()
+	/// and end(), without copying them through read() calls.
+	/// Use MappedInputStream to read a mapped file through
+	/// the std::istream interface.
+	///
+	/// The mapping reflects the size of the file at the time
+	/// it was opened. The behavior is undefined if the file is
+	/// truncated while it is mapped.
+	///
+	/// Options and access pattern hints are best effort:
+	/// they are silently ignored on platforms that do not
+	/// support them.
+{
+public:
+	enum Options
+	{
+		OPT_DEFAULT    = 0,
+			/// No special options.
+		OPT_POPULATE   = 1,
+			/// Read the entire file into memory when mapping it
+			/// (MAP_POPULATE on Linux, MADV_WILLNEED elsewhere),
+			/// avoiding page faults on later accesses.
+		OPT_HUGE_PAGES = 2
+			/// Ask the system to back the mapping with huge pages
+			/// (MADV_HUGEPAGE on Linux), reducing TLB misses when
+			/// accessing large files.
+	};
+
+	enum Advice
+	{
+		ADVICE_NORMAL,
+			/// No special treatment (default).
+		ADVICE_SEQUENTIAL,
+			/// The data will be accessed sequentially; read ahead aggressively.
+		ADVICE_RANDOM,
+			/// The data will be accessed in random order; do not read ahead.
+		ADVICE_WILLNEED,
+			/// The data will be accessed soon; start reading it.
+		ADVICE_DONTNEED
+			/// The data will not be accessed soon; its pages may be released.
+	};
+
+	MappedFile();
+		/// Creates an unmapped MappedFile.
+
+	explicit MappedFile(const std::string& path, int options = OPT_DEFAULT);
+		/// Opens the file with the given path and maps its
+		/// contents into memory.
+		///
+		/// Throws a FileNotFoundException, FileAccessDeniedException
+		/// or OpenFileException if the file cannot be opened.
+
+	MappedFile(MappedFile&& other);
+		/// Takes over the mapping of other, leaving it unmapped.
+
+	~MappedFile();
+		/// Unmaps the file.
+
+	MappedFile& operator = (MappedFile&& other);
+		/// Unmaps the file and takes over the mapping of other,
+		/// leaving it unmapped.
+
+	void swap(MappedFile& other);
+		/// Swaps the mapping with another one.
+
+	void open(const std::string& path, int options = OPT_DEFAULT);
+		/// Maps the file with the given path, replacing
+		/// the current mapping, if any.
+
+	void close();
+		/// Unmaps the file.
+
+	bool isOpen() const;
+		/// Returns true if a file has been mapped.
+
+	void advise(Advice advice);
+		/// Tells the system how the entire mapping will be accessed.
+
+	void advise(Advice advice, std::size_t offset, std::size_t length);
+		/// Tells the system how the given range of the mapping
+		/// will be accessed.
+
+	const char* begin() const;
+		/// Returns the start address of the mapped file contents.
+		/// May be null if the file is empty or not mapped.
+
+	const char* end() const;
+		/// Returns the one-past-end address of the mapped file contents.
+
+	const char* data() const;
+		/// Returns the start address of the mapped file contents.
+
+	std::size_t size() const;
+		/// Returns the size of the mapped file.
+
+	bool empty() const;
+		/// Returns true if the file is empty or not mapped.
+
+	const std::string& path() const;
+		/// Returns the path of the mapped file.
+
+	static std::size_t pageSize();
+		/// Returns the system's memory page size.
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator = (const MappedFile&);
+
+	std::string _path;
+	char*       _pData;
+	std::size_t _size;
+	bool        _open;
+};
+
+
+//
+// inlines
+//
+inline bool MappedFile::isOpen() const
+{
+	return _open;
+}
+
+
+inline void MappedFile::advise(Advice advice)
+{
+	advise(advice, 0, _size);
+}
+
+
+inline const char* MappedFile::begin() const
+{
+	return _pData;
+}
+
+
+inline const char* MappedFile::end() const
+{
+	return _pData + _size;
+}
+
+
+inline const char* MappedFile::data() const
+{
+	return _pData;
+}
+
+
+inline std::size_t MappedFile::size() const
+{
+	return _size;
+}
+
+
+inline bool MappedFile::empty() const
+{
+	return _size == 0;
+}
+
+
+inline const std::string& MappedFile::path() const
+{
+	return _path;
+}
+
+
+inline void swap(MappedFile& f1, MappedFile& f2)
+{
+	f1.swap(f2);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MappedFile_INCLUDED
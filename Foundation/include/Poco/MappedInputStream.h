@@ -0,0 +1,134 @@
+//
+// MappedInputStream.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  MappedInputStream
+//
+// Definition of the MappedIOS and MappedInputStream classes.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MappedInputStream_INCLUDED
+#define Foundation_MappedInputStream_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/MappedFile.h"
+#include "Poco/MemoryStream.h"
+#include <istream>
+
+
+namespace Poco {
+
+
+class Foundation_API MappedIOS: public virtual std::ios
+	/// The base class for MappedInputStream.
+	///
+	/// This class is needed to ensure the correct initialization
+	/// order of the mapped file, the stream buffer and base classes.
+{
+public:
+	MappedIOS(const std::string& path, int options);
+		/// Maps the given file and creates the basic stream.
+
+	MappedIOS(const MappedFile& file);
+		/// Creates the basic stream for the given mapped file.
+
+	~MappedIOS();
+		/// Destroys the stream.
+
+	MemoryStreamBuf* rdbuf();
+		/// Returns a pointer to the underlying streambuf.
+
+protected:
+	MappedFile      _file;
+	const char*     _pBegin;
+	const char*     _pEnd;
+	MemoryStreamBuf _buf;
+};
+
+
+class Foundation_API MappedInputStream: public MappedIOS, public std::istream
+	/// An input stream for reading a memory-mapped file.
+	///
+	/// The stream buffer exposes the mapped file contents
+	/// directly, so reading from a MappedInputStream never
+	/// calls read() and does not copy data into an intermediate
+	/// buffer. The stream supports seeking.
+	///
+	/// Parsers that know about MappedInputStream (e.g.,
+	/// Poco::JSON::Parser and the Poco::XML parsers) process
+	/// the remaining contents directly from the mapping.
+{
+public:
+	explicit MappedInputStream(const std::string& path, int options = MappedFile::OPT_DEFAULT);
+		/// Maps the file with the given path and creates
+		/// a MappedInputStream for reading it.
+		///
+		/// See MappedFile for the supported options.
+
+	explicit MappedInputStream(const MappedFile& file);
+		/// Creates a MappedInputStream for reading the given
+		/// mapped file, which must remain mapped as long as the
+		/// stream is used.
+
+	~MappedInputStream();
+		/// Destroys the MappedInputStream.
+
+	const char* begin() const;
+		/// Returns the start address of the mapped file contents.
+
+	const char* end() const;
+		/// Returns the one-past-end address of the mapped file contents.
+
+	std::size_t size() const;
+		/// Returns the size of the mapped file.
+
+	const char* current();
+		/// Returns the address of the next character to be read.
+
+	void skip(std::size_t count);
+		/// Advances the read position by the given number of
+		/// characters, as if they had been read.
+		///
+		/// Sets the eof bit if the end of the mapped file is reached.
+};
+
+
+//
+// inlines
+//
+inline MemoryStreamBuf* MappedIOS::rdbuf()
+{
+	return &_buf;
+}
+
+
+inline const char* MappedInputStream::begin() const
+{
+	return _pBegin;
+}
+
+
+inline const char* MappedInputStream::end() const
+{
+	return _pEnd;
+}
+
+
+inline std::size_t MappedInputStream::size() const
+{
+	return _pEnd - _pBegin;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MappedInputStream_INCLUDED
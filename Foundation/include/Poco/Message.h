@@ -159,6 +159,9 @@ public:
 	bool has(const std::string& param) const;
 		/// Returns true if a parameter with the given name exists.
 
+	bool hasParameters() const;
+		/// Returns true if the message has at least one parameter.
+
 	const std::string& get(const std::string& param) const;
 		/// Returns a const reference to the value of the parameter
 		/// with the given name. Throws a NotFoundException if the
@@ -184,9 +187,14 @@ public:
 		/// If the parameter does not exist, it is created with an
 		/// empty string value.
 
+	typedef std::map<std::string, std::string> StringMap;
+
+	const StringMap& getAll() const;
+		/// Returns a const reference to the map
+		/// containing all parameters of the message.
+
 protected:
 	void init();
-	typedef std::map<std::string, std::string> StringMap;
 
 private:	
 	std::string _source;
@@ -259,6 +267,12 @@ inline int Message::getSourceLine() const
 }
 
 
+inline bool Message::hasParameters() const
+{
+	return _pMap && !_pMap->empty();
+}
+
+
 inline void swap(Message& m1, Message& m2)
 {
 	m1.swap(m2);
@@ -0,0 +1,112 @@
+//
+// Metric.h
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  Metric
+//
+// Definition of the Metric class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_Metric_INCLUDED
+#define Foundation_Metric_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <string>
+#include <ostream>
+
+
+namespace Poco {
+
+
+class Foundation_API Metric
+	/// Metric is the base class for MetricCounter, MetricGauge
+	/// and MetricHistogram.
+	///
+	/// A metric has a name and a help text, and can write its
+	/// current value in the Prometheus text exposition format.
+	/// Metric names must consist of letters, digits, underscores
+	/// and colons, and must not start with a digit.
+	///
+	/// Metrics are usually obtained from a MetricRegistry, which owns
+	/// them and exports them together. Metrics can also be created
+	/// directly, to be queried by the application.
+{
+public:
+	Metric(const std::string& name, const std::string& help);
+		/// Creates the Metric. Throws an InvalidArgumentException
+		/// if the name is not a valid metric name.
+
+	virtual ~Metric();
+		/// Destroys the Metric.
+
+	const std::string& name() const;
+		/// Returns the name of the metric.
+
+	const std::string& help() const;
+		/// Returns the help text of the metric.
+
+	virtual void writePrometheus(std::ostream& ostr) const = 0;
+		/// Writes the metric's current value, preceded by its
+		/// HELP and TYPE lines, in the Prometheus text exposition format.
+
+	static bool isValidName(const std::string& name);
+		/// Returns true if name is a valid metric name.
+
+protected:
+	void writeHeader(std::ostream& ostr, const char* type) const;
+		/// Writes the HELP and TYPE lines for the metric.
+
+	static unsigned shardCount();
+		/// Returns the number of shards that sharded metrics use
+		/// to avoid contention between CPUs. This is the number
+		/// of processors, rounded up to a power of two, at most 64.
+
+	static unsigned shardIndex();
+		/// Returns a shard index for the calling thread. On Linux,
+		/// this is the number of the CPU the thread is running on.
+		/// Elsewhere, each thread is assigned an index when it first
+		/// calls this function. Callers must reduce the index to
+		/// their number of shards.
+
+	enum
+	{
+		CACHE_LINE_SIZE = 64
+	};
+
+private:
+	Metric();
+	Metric(const Metric&);
+	Metric& operator = (const Metric&);
+
+	std::string _name;
+	std::string _help;
+};
+
+
+//
+// inlines
+//
+inline const std::string& Metric::name() const
+{
+	return _name;
+}
+
+
+inline const std::string& Metric::help() const
+{
+	return _help;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_Metric_INCLUDED
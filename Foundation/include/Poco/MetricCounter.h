@@ -0,0 +1,78 @@
+//
+// MetricCounter.h
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  MetricCounter
+//
+// Definition of the MetricCounter class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MetricCounter_INCLUDED
+#define Foundation_MetricCounter_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Metric.h"
+#include <atomic>
+
+
+namespace Poco {
+
+
+class Foundation_API MetricCounter: public Metric
+	/// A MetricCounter is a monotonically increasing counter,
+	/// such as the number of requests served.
+	///
+	/// Unlike an AtomicCounter, a MetricCounter is sharded: it keeps
+	/// one count per CPU, each in its own cache line, so that threads
+	/// running on different CPUs can increment it without contending
+	/// for the same cache line. Reading the value adds up the shards,
+	/// which makes value() slower than inc().
+{
+public:
+	MetricCounter(const std::string& name, const std::string& help);
+		/// Creates the MetricCounter with a value of zero.
+
+	~MetricCounter();
+		/// Destroys the MetricCounter.
+
+	void inc(UInt64 n = 1);
+		/// Increments the counter by n.
+
+	UInt64 value() const;
+		/// Returns the current value of the counter.
+
+	void writePrometheus(std::ostream& ostr) const;
+
+private:
+	struct Shard
+	{
+		std::atomic<UInt64> value;
+		char padding[CACHE_LINE_SIZE - sizeof(std::atomic<UInt64>)];
+	};
+
+	Shard* _pShards;
+	unsigned _mask;
+};
+
+
+//
+// inlines
+//
+inline void MetricCounter::inc(UInt64 n)
+{
+	_pShards[shardIndex() & _mask].value.fetch_add(n, std::memory_order_relaxed);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MetricCounter_INCLUDED
@@ -0,0 +1,92 @@
+//
+// MetricGauge.h
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  MetricGauge
+//
+// Definition of the MetricGauge class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MetricGauge_INCLUDED
+#define Foundation_MetricGauge_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Metric.h"
+#include <atomic>
+
+
+namespace Poco {
+
+
+class Foundation_API MetricGauge: public Metric
+	/// A MetricGauge is a value that can go up and down,
+	/// such as the number of connections currently open.
+	///
+	/// Since a gauge can be set to an absolute value,
+	/// it is not sharded.
+{
+public:
+	MetricGauge(const std::string& name, const std::string& help);
+		/// Creates the MetricGauge with a value of zero.
+
+	~MetricGauge();
+		/// Destroys the MetricGauge.
+
+	void set(Int64 value);
+		/// Sets the gauge to the given value.
+
+	void inc(Int64 n = 1);
+		/// Increments the gauge by n.
+
+	void dec(Int64 n = 1);
+		/// Decrements the gauge by n.
+
+	Int64 value() const;
+		/// Returns the current value of the gauge.
+
+	void writePrometheus(std::ostream& ostr) const;
+
+private:
+	std::atomic<Int64> _value;
+};
+
+
+//
+// inlines
+//
+inline void MetricGauge::set(Int64 value)
+{
+	_value.store(value, std::memory_order_relaxed);
+}
+
+
+inline void MetricGauge::inc(Int64 n)
+{
+	_value.fetch_add(n, std::memory_order_relaxed);
+}
+
+
+inline void MetricGauge::dec(Int64 n)
+{
+	_value.fetch_sub(n, std::memory_order_relaxed);
+}
+
+
+inline Int64 MetricGauge::value() const
+{
+	return _value.load(std::memory_order_relaxed);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MetricGauge_INCLUDED
@@ -0,0 +1,145 @@
+//
+// MetricHistogram.h
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  MetricHistogram
+//
+// Definition of the MetricHistogram class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MetricHistogram_INCLUDED
+#define Foundation_MetricHistogram_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Metric.h"
+#include <atomic>
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API MetricHistogram: public Metric
+	/// A MetricHistogram records the distribution of non-negative
+	/// integer values, such as request latencies in microseconds,
+	/// and estimates percentiles of the recorded values.
+	///
+	/// Like an HDR histogram, it covers the full range of 64-bit values
+	/// with log-linear buckets: each power of two is divided into eight
+	/// buckets of equal width, so estimated percentiles are at most
+	/// 12.5% higher than the actual values. Values below eight are
+	/// counted exactly.
+	///
+	/// Recording a value is lock-free and only increments two atomic
+	/// counters. The buckets are sharded by CPU, like a MetricCounter,
+	/// with up to eight shards.
+	///
+	/// In the Prometheus text format, the histogram is exported as a
+	/// summary with the 50th, 90th, 99th and 99.9th percentiles, and
+	/// the sum and count of all recorded values.
+{
+public:
+	MetricHistogram(const std::string& name, const std::string& help, double unit = 1.0);
+		/// Creates the MetricHistogram. The unit is the value of a
+		/// recorded value of one in the exported values, for example,
+		/// 1e-6 if microseconds are recorded and seconds are exported.
+
+	~MetricHistogram();
+		/// Destroys the MetricHistogram.
+
+	void record(Int64 value);
+		/// Records the given value. Negative values
+		/// are recorded as zero.
+
+	UInt64 count() const;
+		/// Returns the number of recorded values.
+
+	UInt64 sum() const;
+		/// Returns the sum of all recorded values.
+
+	UInt64 percentile(double percent) const;
+		/// Returns an estimate of the value that the given percentage
+		/// (0 .. 100) of the recorded values is less than or equal to.
+		/// The estimate is the largest value in the bucket the percentile
+		/// falls into. Returns 0 if no values have been recorded.
+
+	double unit() const;
+		/// Returns the unit of exported values.
+
+	void writePrometheus(std::ostream& ostr) const;
+
+	static unsigned bucketIndex(UInt64 value);
+		/// Returns the index of the bucket that counts the given value.
+
+	static UInt64 bucketLimit(unsigned index);
+		/// Returns the largest value counted in the bucket
+		/// with the given index.
+
+	enum
+	{
+		SUB_BUCKET_BITS  = 3,
+		SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS,
+		BUCKET_COUNT     = (64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS
+	};
+
+private:
+	struct Shard
+	{
+		std::atomic<UInt64> counts[BUCKET_COUNT];
+		std::atomic<UInt64> sum;
+		char padding[CACHE_LINE_SIZE - sizeof(std::atomic<UInt64>)];
+	};
+
+	UInt64 snapshot(std::vector<UInt64>& counts) const;
+	static UInt64 percentile(const std::vector<UInt64>& counts, UInt64 total, double percent);
+
+	double _unit;
+	Shard* _pShards;
+	unsigned _mask;
+};
+
+
+//
+// inlines
+//
+inline void MetricHistogram::record(Int64 value)
+{
+	UInt64 v = value < 0 ? 0 : static_cast<UInt64>(value);
+	Shard& shard = _pShards[shardIndex() & _mask];
+	shard.counts[bucketIndex(v)].fetch_add(1, std::memory_order_relaxed);
+	shard.sum.fetch_add(v, std::memory_order_relaxed);
+}
+
+
+inline unsigned MetricHistogram::bucketIndex(UInt64 value)
+{
+	if (value < SUB_BUCKET_COUNT) return static_cast<unsigned>(value);
+#if defined(__GNUC__)
+	unsigned exponent = 63 - __builtin_clzll(value);
+#else
+	unsigned exponent = 63;
+	while (!(value >> exponent)) --exponent;
+#endif
+	unsigned subBucket = static_cast<unsigned>(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+	return ((exponent - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) | subBucket;
+}
+
+
+inline double MetricHistogram::unit() const
+{
+	return _unit;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MetricHistogram_INCLUDED
@@ -0,0 +1,112 @@
+//
+// MetricRegistry.h
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  MetricRegistry
+//
+// Definition of the MetricRegistry class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_MetricRegistry_INCLUDED
+#define Foundation_MetricRegistry_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Metric.h"
+#include "Poco/MetricCounter.h"
+#include "Poco/MetricGauge.h"
+#include "Poco/MetricHistogram.h"
+#include "Poco/Mutex.h"
+#include <map>
+#include <vector>
+
+
+namespace Poco {
+
+
+class Foundation_API MetricRegistry
+	/// A MetricRegistry creates, owns and exports metrics.
+	///
+	/// A metric is created the first time it is requested by name,
+	/// and the same metric is returned for all later requests, so
+	/// instrumented code typically keeps a reference to its metrics
+	/// in function-level static variables:
+	///
+	///     static MetricCounter& requests = MetricRegistry::defaultRegistry().counter(
+	///         "myapp_requests_total", "Total number of requests.");
+	///     requests.inc();
+	///
+	/// Metrics live as long as the registry.
+	///
+	/// The POCO libraries register their metrics, whose names start
+	/// with "poco_", with the default registry.
+{
+public:
+	MetricRegistry();
+		/// Creates an empty MetricRegistry.
+
+	~MetricRegistry();
+		/// Destroys the MetricRegistry and all its metrics.
+
+	MetricCounter& counter(const std::string& name, const std::string& help);
+		/// Returns the counter with the given name, creating it if necessary.
+		/// Throws an ExistsException if a metric of another type
+		/// has the same name, or an InvalidArgumentException
+		/// if the name is not a valid metric name.
+
+	MetricGauge& gauge(const std::string& name, const std::string& help);
+		/// Returns the gauge with the given name, creating it if necessary.
+		/// Throws an ExistsException if a metric of another type
+		/// has the same name, or an InvalidArgumentException
+		/// if the name is not a valid metric name.
+
+	MetricHistogram& histogram(const std::string& name, const std::string& help, double unit = 1.0);
+		/// Returns the histogram with the given name, creating it if necessary.
+		/// Throws an ExistsException if a metric of another type
+		/// has the same name, or an InvalidArgumentException
+		/// if the name is not a valid metric name.
+		///
+		/// See MetricHistogram for the meaning of unit.
+
+	Metric* find(const std::string& name) const;
+		/// Returns the metric with the given name, or null
+		/// if there is no such metric.
+
+	void names(std::vector<std::string>& names) const;
+		/// Fills names with the names of all metrics, in sorted order.
+
+	void writePrometheus(std::ostream& ostr) const;
+		/// Writes all metrics, sorted by name, in the
+		/// Prometheus text exposition format.
+
+	static MetricRegistry& defaultRegistry();
+		/// Returns the default MetricRegistry.
+		///
+		/// The default registry is never destroyed, so its
+		/// metrics can be used during program termination.
+
+private:
+	template <class M>
+	M& get(const std::string& name, const std::string& help, double unit);
+
+	MetricRegistry(const MetricRegistry&);
+	MetricRegistry& operator = (const MetricRegistry&);
+
+	typedef std::map<std::string, Metric*> MetricMap;
+
+	MetricMap _metrics;
+	mutable FastMutex _mutex;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_MetricRegistry_INCLUDED
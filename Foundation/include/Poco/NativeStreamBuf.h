@@ -0,0 +1,62 @@
+//
+// NativeStreamBuf.h
+//
+// Library: Foundation
+// Package: Streams
+// Module:  StreamCopier
+//
+// Definition of the NativeStreamBuf interface.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_NativeStreamBuf_INCLUDED
+#define Foundation_NativeStreamBuf_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include <ios>
+
+
+namespace Poco {
+
+
+class Foundation_API NativeStreamBuf
+	/// NativeStreamBuf is an interface for stream buffers that
+	/// read from or write to an operating system file descriptor,
+	/// such as a file, a pipe or a socket.
+	///
+	/// StreamCopier uses this interface to move data between two
+	/// such streams within the kernel, without copying it through
+	/// user space buffers, on platforms that support this (Linux).
+{
+public:
+	virtual ~NativeStreamBuf();
+		/// Destroys the NativeStreamBuf.
+
+	virtual int nativeDescriptor(std::ios::openmode which) const = 0;
+		/// Returns the file descriptor the stream buffer reads from
+		/// (if which is std::ios::in) or writes to (if which is std::ios::out).
+		///
+		/// Returns -1 if there is no such descriptor, or if data
+		/// must not be transferred directly to or from it (for example,
+		/// because the stream buffer transforms the data).
+
+	virtual void nativeTransferred(std::ios::openmode which, std::streamsize n) = 0;
+		/// Notifies the stream buffer that n bytes have been read from
+		/// (if which is std::ios::in) or written to (if which is std::ios::out)
+		/// the descriptor directly, bypassing the stream buffer.
+		///
+		/// Before transferring data directly, StreamCopier empties the
+		/// stream buffer's get area and flushes its put area.
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_NativeStreamBuf_INCLUDED
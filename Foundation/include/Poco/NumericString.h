@@ -30,6 +30,8 @@
 #include <limits>
 #include <cmath>
 #include <cctype>
+#include <cstring>
+#include <type_traits>
 #if !defined(POCO_NO_LOCALE)
 	#include <locale>
 #endif
@@ -76,105 +78,124 @@ inline char thousandSeparator()
 // String to Number Conversions
 //
 
+namespace Impl {
+
+	inline bool isDigits8(UInt64 chunk)
+		/// Returns true if all eight characters in chunk are decimal digits.
+	{
+		return (chunk & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL &&
+			((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL;
+	}
+
+	inline UInt32 parseDigits8(UInt64 chunk)
+		/// Returns the value of the eight decimal digits in chunk,
+		/// loaded from memory in little-endian byte order.
+	{
+		chunk -= 0x3030303030303030ULL;
+		chunk = (chunk*10) + (chunk >> 8);
+		chunk = (((chunk & 0x000000FF000000FFULL)*(100 + (1000000ULL << 32))) +
+			(((chunk >> 16) & 0x000000FF000000FFULL)*(1 + (10000ULL << 32)))) >> 32;
+		return static_cast<UInt32>(chunk);
+	}
+
+	inline int digitValue(char c)
+		/// Returns the value of the hexadecimal digit c, or 16
+		/// if c is not a digit.
+	{
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		return 16;
+	}
+
+} // namespace Impl
+
+
 template <typename I>
-bool strToInt(const char* pStr, I& result, short base, char thSep = ',')
-	/// Converts zero-terminated character array to integer number;
+bool strToInt(const char* pStr, std::size_t length, I& result, short base, char thSep = ',')
+	/// Converts the character array of the given length to integer number;
 	/// Thousand separators are recognized for base10 and current locale;
 	/// it is silently skipped but not verified for correct positioning.
 	/// Function returns true if successful. If parsing was unsuccessful,
-	/// the return value is false with the result value undetermined.
+	/// or the number does not fit into I, the return value is false
+	/// with the result value undetermined.
+	///
+	/// Runs of eight decimal digits are converted at once.
 {
+	typedef typename std::make_unsigned<I>::type U;
+
 	if (!pStr) return false;
-	while (std::isspace(*pStr)) ++pStr;
-	if (*pStr == '\0') return false;
-	short sign = 1;
+	const char* pEnd = pStr + length;
+	while (pStr < pEnd && std::isspace(*pStr)) ++pStr;
+	if (pStr == pEnd) return false;
+	bool negative = false;
 	if ((base == 10) && (*pStr == '-'))
 	{
 		// Unsigned types can't be negative so abort parsing
 		if (std::numeric_limits<I>::min() >= 0) return false;
-		sign = -1;
+		negative = true;
 		++pStr;
 	}
 	else if (*pStr == '+') ++pStr;
 
-	// parser states:
-	const char STATE_SIGNIFICANT_DIGITS = 1;
-	char state = 0;
-	
-	result = 0;
-	I limitCheck = std::numeric_limits<I>::max() / base;
-	for (; *pStr != '\0'; ++pStr)
+	const U limit = negative ? static_cast<U>(static_cast<U>(std::numeric_limits<I>::max()) + 1) : static_cast<U>(std::numeric_limits<I>::max());
+	const U cutoff = limit/base;
+	const int cutlim = static_cast<int>(limit % base);
+	const bool skipThSep = (base == 10) && (thSep == '.' || thSep == ',' || thSep == ' ');
+	U value = 0;
+	while (pStr < pEnd)
 	{
-		switch (*pStr)
+#if defined(POCO_ARCH_LITTLE_ENDIAN)
+		if (base == 10 && pEnd - pStr >= 8)
 		{
-		case '0': 
-			if (state < STATE_SIGNIFICANT_DIGITS) break;
-
-		case '1': case '2': case '3': case '4':
-		case '5': case '6': case '7':
-			if (state < STATE_SIGNIFICANT_DIGITS) state = STATE_SIGNIFICANT_DIGITS;
-			if (result > limitCheck) return false;
-			result = result * base + (*pStr - '0');
-
-			break;
-
-		case '8': case '9':
-			if ((base == 10) || (base == 0x10))
+			UInt64 chunk;
+			std::memcpy(&chunk, pStr, sizeof(chunk));
+			if (Impl::isDigits8(chunk))
 			{
-				if (state < STATE_SIGNIFICANT_DIGITS) state = STATE_SIGNIFICANT_DIGITS;
-				if (result > limitCheck) return false;
-				result = result * base + (*pStr - '0');
+				const UInt64 digits = Impl::parseDigits8(chunk);
+				if (digits > limit || value > (limit - digits)/100000000) return false;
+				value = static_cast<U>(value*100000000 + digits);
+				pStr += 8;
+				continue;
 			}
-			else return false;
-
-			break;
-
-		case 'a': case 'b': case 'c': case 'd': case 'e': case 'f':
-			if (base != 0x10) return false;
-			if (state < STATE_SIGNIFICANT_DIGITS) state = STATE_SIGNIFICANT_DIGITS;
-			if (result > limitCheck) return false;
-			result = result * base + (10 + *pStr - 'a');
-
-			break;
-
-		case 'A': case 'B': case 'C': case 'D': case 'E': case 'F':
-			if (base != 0x10) return false;
-			if (state < STATE_SIGNIFICANT_DIGITS) state = STATE_SIGNIFICANT_DIGITS;
-			if (result > limitCheck) return false;
-			result = result * base + (10 + *pStr - 'A');
-
-			break;
-
-		case '.':
-			if ((base == 10) && (thSep == '.')) break;
-			else return false;
-
-		case ',':
-			if ((base == 10) && (thSep == ',')) break;
-			else return false;
-
-		case ' ':
-			if ((base == 10) && (thSep == ' ')) break;
-			// fallthrough
-
-		default:
-			return false;
 		}
+#endif
+		const char c = *pStr++;
+		const int digit = Impl::digitValue(c);
+		if (digit < base)
+		{
+			if (value > cutoff || (value == cutoff && digit > cutlim)) return false;
+			value = static_cast<U>(value*base + digit);
+		}
+		else if (!skipThSep || c != thSep) return false;
 	}
 
-	if ((sign < 0) && (base == 10)) result *= sign;
-
+	if (negative && value)
+		result = static_cast<I>(-static_cast<I>(value - 1) - 1);
+	else
+		result = static_cast<I>(value);
 	return true;
 }
 
 
+template <typename I>
+bool strToInt(const char* pStr, I& result, short base, char thSep = ',')
+	/// Converts zero-terminated character array to integer number;
+	/// This is a wrapper function, for details see see the
+	/// bool strToInt(const char*, std::size_t, I&, short, char) implementation.
+{
+	if (!pStr) return false;
+	return strToInt(pStr, std::strlen(pStr), result, base, thSep);
+}
+
+
 template <typename I>
 bool strToInt(const std::string& str, I& result, short base, char thSep = ',')
 	/// Converts string to integer number;
 	/// This is a wrapper function, for details see see the
-	/// bool strToInt(const char*, I&, short, char) implementation.
+	/// bool strToInt(const char*, std::size_t, I&, short, char) implementation.
 {
-	return strToInt(str.c_str(), result, base, thSep);
+	return strToInt(str.data(), str.size(), result, base, thSep);
 }
 
 
@@ -252,6 +273,53 @@ namespace Impl {
 		const char* _end;
 };	
 
+	template <typename U>
+	bool uIntToDecimal(U value, bool negative, char* result, std::size_t& size, int width, char fill)
+		/// Decimal fast path of intToStr() and uIntToStr() without thousand
+		/// separators; converts two digits at a time.
+	{
+		static const char DIGIT_PAIRS[] =
+			"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+			"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+
+		char buffer[POCO_MAX_INT_STRING_LEN];
+		char* pEnd = buffer + sizeof(buffer);
+		char* pBegin = pEnd;
+		while (value >= 100)
+		{
+			const unsigned i = static_cast<unsigned>(value % 100)*2;
+			value /= 100;
+			*--pBegin = DIGIT_PAIRS[i + 1];
+			*--pBegin = DIGIT_PAIRS[i];
+		}
+		if (value >= 10)
+		{
+			const unsigned i = static_cast<unsigned>(value)*2;
+			*--pBegin = DIGIT_PAIRS[i + 1];
+			*--pBegin = DIGIT_PAIRS[i];
+		}
+		else *--pBegin = static_cast<char>('0' + value);
+
+		if ('0' == fill)
+		{
+			const int digits = negative ? width - 1 : width;
+			while (pEnd - pBegin < digits) *--pBegin = '0';
+		}
+		if (negative) *--pBegin = '-';
+		if ('0' != fill)
+		{
+			while (pEnd - pBegin < width) *--pBegin = fill;
+		}
+
+		const std::size_t length = pEnd - pBegin;
+		if (length >= size) throw RangeException();
+		std::memcpy(result, pBegin, length);
+		result[length] = '\0';
+		size = length;
+		return true;
+	}
+
 } // namespace Impl
 
 
@@ -278,6 +346,14 @@ bool intToStr(T value,
 		return false;
 	}
 
+	if (base == 10 && !thSep && width < POCO_MAX_INT_STRING_LEN - 1)
+	{
+		typedef typename std::make_unsigned<T>::type U;
+		const bool negative = value < 0;
+		const U magnitude = negative ? static_cast<U>(0 - static_cast<U>(value)) : static_cast<U>(value);
+		return Impl::uIntToDecimal(magnitude, negative, result, size, width, fill);
+	}
+
 	Impl::Ptr ptr(result, size);
 	int thCount = 0;
 	T tmpVal;
@@ -355,6 +431,9 @@ bool uIntToStr(T value,
 		*result = '\0';
 		return false;
 	}
+
+	if (base == 10 && !thSep && width < POCO_MAX_INT_STRING_LEN - 1)
+		return Impl::uIntToDecimal(value, false, result, size, width, fill);
 	
 	Impl::Ptr ptr(result, size);
 	int thCount = 0;
@@ -435,7 +514,9 @@ bool uIntToStr (T number, unsigned short base, std::string& result, bool prefix
 
 
 //
-// Wrappers for double-conversion library (http://code.google.com/p/double-conversion/).
+// Floating-point conversions. floatToStr() and doubleToStr() use Raffaello
+// Giulietti's Schubfach algorithm; all other functions are wrappers for the
+// double-conversion library (http://code.google.com/p/double-conversion/).
 //
 // Library is the implementation of the algorithm described in Florian Loitsch's paper:
 // http://florian.loitsch.com/publications/dtoa-pldi2010.pdf
@@ -532,6 +613,18 @@ Foundation_API float strToFloat(const char* str);
 	/// Function uses double_convesrion::DoubleToStringConverter to do the conversion.
 
 
+Foundation_API bool strToFloat(const char* str, std::size_t length, float& result, char decSep = '.', char thSep = ',');
+	/// Converts the character array of the given length into single-precision
+	/// floating point number. The conversion result is assigned to the result parameter.
+	/// If decimal separator and/or thousand separator are different from defaults, they should be
+	/// supplied to ensure proper conversion.
+	///
+	/// Does not allocate memory unless the number is longer than
+	/// POCO_MAX_FLT_STRING_LEN characters and contains separators.
+	///
+	/// Returns true if successful, false otherwise.
+
+
 Foundation_API bool strToFloat(const std::string&, float& result, char decSep = '.', char thSep = ',');
 	/// Converts the string of characters into single-precision floating point number.
 	/// The conversion result is assigned to the result parameter.
@@ -545,6 +638,18 @@ Foundation_API double strToDouble(const char* str);
 	/// Converts the string of characters into double-precision floating point number.
 
 
+Foundation_API bool strToDouble(const char* str, std::size_t length, double& result, char decSep = '.', char thSep = ',');
+	/// Converts the character array of the given length into double-precision
+	/// floating point number. The conversion result is assigned to the result parameter.
+	/// If decimal separator and/or thousand separator are different from defaults, they should be
+	/// supplied to ensure proper conversion.
+	///
+	/// Does not allocate memory unless the number is longer than
+	/// POCO_MAX_FLT_STRING_LEN characters and contains separators.
+	///
+	/// Returns true if successful, false otherwise.
+
+
 Foundation_API bool strToDouble(const std::string& str, double& result, char decSep = '.', char thSep = ',');
 	/// Converts the string of characters into double-precision floating point number.
 	/// The conversion result is assigned to the result parameter.
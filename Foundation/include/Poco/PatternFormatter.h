@@ -74,6 +74,13 @@ class Foundation_API PatternFormatter: public Formatter
 	///   * %v[width] - the message source (%s) but text length is padded/cropped to 'width'
 	///   * %[name] - the value of the message parameter with the given name
 	///   * %% - percent sign
+	///
+	/// To keep the formatting cost per message low, the pattern is parsed
+	/// only once, and all fields that only change once per second (dates,
+	/// times up to seconds, time zone and node name) are formatted only
+	/// once per second and thread. The time zone offset used for local
+	/// times is determined at most every 15 minutes, which is sufficient
+	/// to catch daylight saving time transitions.
 
 {
 public:
@@ -121,24 +128,33 @@ protected:
 private:
 	struct PatternAction
 	{
-		PatternAction(): key(0), length(0) 
+		PatternAction(): key(0), length(0), perSecond(false)
 		{
 		}
 
 		char key;
 		int length;
+		bool perSecond;
 		std::string property;
 		std::string prepend;
 	};
 
+	struct TimeCache;
+
 	void parsePattern();
 		/// Will parse the _pattern string into the vector of PatternActions,
 		/// which contains the message key, any text that needs to be written first
 		/// a proprety in case of %[] and required length.
 
+	void updateCache(TimeCache& cache, Timestamp::TimeVal second) const;
+		/// Formats all per-second fields for the given second
+		/// and stores them in cache.
+
 	std::vector<PatternAction> _patternActions;
 	bool _localTime;
+	bool _needsOffset;
 	std::string _pattern;
+	UInt64 _id;
 };
 
 
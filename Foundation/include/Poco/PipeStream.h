@@ -21,6 +21,7 @@
 #include "Poco/Foundation.h"
 #include "Poco/Pipe.h"
 #include "Poco/BufferedStreamBuf.h"
+#include "Poco/NativeStreamBuf.h"
 #include <istream>
 #include <ostream>
 
@@ -28,7 +29,7 @@
 namespace Poco {
 
 
-class Foundation_API PipeStreamBuf: public BufferedStreamBuf
+class Foundation_API PipeStreamBuf: public BufferedStreamBuf, public NativeStreamBuf
 	/// This is the streambuf class used for reading from and writing to a Pipe.
 {
 public:
@@ -42,6 +43,13 @@ public:
 		
 	void close();
 		/// Closes the pipe.
+
+	int nativeDescriptor(std::ios::openmode which) const;
+		/// Returns the read or write handle of the pipe, on
+		/// platforms where it is a file descriptor.
+
+	void nativeTransferred(std::ios::openmode which, std::streamsize n);
+		/// Does nothing.
 		
 protected:
 	int readFromDevice(char* buffer, std::streamsize length);
@@ -19,7 +19,7 @@
 
 
 #include "Poco/Foundation.h"
-#include "Poco/AtomicCounter.h"
+#include <atomic>
 
 
 namespace Poco {
@@ -31,6 +31,10 @@ class Foundation_API RefCountedObject
 	///
 	/// Reference-counted objects inhibit construction
 	/// by copying and assignment.
+	///
+	/// Like ReferenceCounter, the reference count is incremented
+	/// with relaxed and decremented with acquire-release memory
+	/// ordering, avoiding full memory barriers.
 {
 public:
 	RefCountedObject();
@@ -56,7 +60,7 @@ private:
 	RefCountedObject(const RefCountedObject&);
 	RefCountedObject& operator = (const RefCountedObject&);
 
-	mutable AtomicCounter _counter;
+	mutable std::atomic<int> _counter;
 };
 
 
@@ -65,13 +69,13 @@ private:
 //
 inline int RefCountedObject::referenceCount() const
 {
-	return _counter.value();
+	return _counter.load(std::memory_order_relaxed);
 }
 
 
 inline void RefCountedObject::duplicate() const
 {
-	++_counter;
+	_counter.fetch_add(1, std::memory_order_relaxed);
 }
 
 
@@ -79,7 +83,7 @@ inline void RefCountedObject::release() const throw()
 {
 	try
 	{
-		if (--_counter == 0) delete this;
+		if (_counter.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
 	}
 	catch (...)
 	{
@@ -33,6 +33,15 @@ class Foundation_API RegularExpression
 	/// Implemented using PCRE, the Perl Compatible
 	/// Regular Expressions library by Philip Hazel
 	/// (see http://www.pcre.org).
+	///
+	/// Studied patterns are JIT-compiled to machine code
+	/// if the PCRE library supports it.
+	///
+	/// A RegularExpression can be used by multiple threads
+	/// concurrently. Passing the same MatchVec or string vector
+	/// to repeated match() or split() calls reuses their storage.
+	/// To avoid compiling the same pattern over and over again,
+	/// see RegularExpressionCache.
 {
 public:
 	enum Options // These must match the corresponding options in pcre.h!
@@ -82,8 +91,9 @@ public:
 	
 	RegularExpression(const std::string& pattern, int options = 0, bool study = true);
 		/// Creates a regular expression and parses the given pattern.
-		/// If study is true, the pattern is analyzed and optimized. This
-		/// is mainly useful if the pattern is used more than once.
+		/// If study is true, the pattern is analyzed and optimized, and
+		/// JIT-compiled if supported by PCRE. This is mainly useful if
+		/// the pattern is used more than once.
 		/// For a description of the options, please see the PCRE documentation.
 		/// Throws a RegularExpressionException if the patter cannot be compiled.
 		
@@ -114,6 +124,10 @@ public:
 		/// If no part of the subject matches the pattern, matches is empty.
 		/// Throws a RegularExpressionException in case of an error.
 		/// Returns the number of matches.
+		///
+		/// The storage of matches is reused, so no memory is allocated
+		/// if matches has been used for a previous match with the same
+		/// regular expression.
 
 	bool match(const std::string& subject, std::string::size_type offset = 0) const;
 		/// Returns true if and only if the subject matches the regular expression.
@@ -168,6 +182,9 @@ public:
 		/// If no part of the subject matches the pattern, captured is empty.
 		/// Throws a RegularExpressionException in case of an error.
 		/// Returns the number of matches.
+		///
+		/// The strings already in the vector are reused, so their
+		/// capacity is preserved across calls.
 	
 	int subst(std::string& subject, const std::string& replacement, int options = 0) const;
 		/// Substitute in subject all matches of the pattern with replacement.
@@ -190,15 +207,21 @@ public:
 	static bool match(const std::string& subject, const std::string& pattern, int options = 0);
 		/// Matches the given subject string against the regular expression given in pattern,
 		/// using the given options.
+		///
+		/// The compiled pattern is taken from (or added to) the
+		/// default RegularExpressionCache.
 
 protected:
 	std::string::size_type substOne(std::string& subject, std::string::size_type offset, const std::string& replacement, int options) const;
+	int exec(const std::string& subject, std::string::size_type offset, int options, int* ovec, int ovecSize) const;
 
 private:
 	// Note: to avoid a dependency on the pcre.h header the following are 
 	// declared as void* and casted to the correct type in the implementation file.
 	void* _pcre;  // Actual type is pcre*
 	void* _extra; // Actual type is struct pcre_extra*
+	int   _ovecSize;
+	bool  _utf8;
 	
 	static const int OVEC_SIZE;
 	
@@ -0,0 +1,90 @@
+//
+// RegularExpressionCache.h
+//
+// Library: Foundation
+// Package: RegExp
+// Module:  RegularExpressionCache
+//
+// Definition of class RegularExpressionCache.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_RegularExpressionCache_INCLUDED
+#define Foundation_RegularExpressionCache_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/RegularExpression.h"
+#include "Poco/ConcurrentLRUCache.h"
+#include "Poco/SharedPtr.h"
+
+
+namespace Poco {
+
+
+class Foundation_API RegularExpressionCache
+	/// A thread-safe cache of compiled (and studied) regular
+	/// expressions, keyed by pattern and constructor options.
+	///
+	/// Compiling a pattern is much more expensive than matching
+	/// it against a short subject, so code that matches against
+	/// patterns only known at runtime (configuration values,
+	/// command line option validators, proxy exclusion lists, etc.)
+	/// should obtain the RegularExpression from a cache instead of
+	/// constructing it for every match.
+	///
+	/// The static RegularExpression::match() function uses the
+	/// default cache.
+{
+public:
+	typedef SharedPtr<RegularExpression> Ptr;
+
+	enum
+	{
+		DEFAULT_CAPACITY = 256
+	};
+
+	explicit RegularExpressionCache(long capacity = DEFAULT_CAPACITY);
+		/// Creates the RegularExpressionCache, holding up to
+		/// capacity compiled expressions.
+
+	~RegularExpressionCache();
+		/// Destroys the RegularExpressionCache.
+
+	Ptr get(const std::string& pattern, int options = 0);
+		/// Returns the compiled regular expression for the given
+		/// pattern and options. If it is not yet in the cache,
+		/// the pattern is compiled and the result is added to the cache.
+		///
+		/// The returned RegularExpression remains valid even if it
+		/// is evicted from the cache, and can be used concurrently by
+		/// multiple threads.
+		///
+		/// Throws a RegularExpressionException if the pattern cannot be compiled.
+
+	void clear();
+		/// Removes all expressions from the cache.
+
+	std::size_t size();
+		/// Returns the number of expressions in the cache.
+
+	static RegularExpressionCache& defaultCache();
+		/// Returns a reference to the default RegularExpressionCache.
+
+private:
+	ConcurrentLRUCache<std::string, RegularExpression> _cache;
+
+	RegularExpressionCache(const RegularExpressionCache&);
+	RegularExpressionCache& operator = (const RegularExpressionCache&);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_RegularExpressionCache_INCLUDED
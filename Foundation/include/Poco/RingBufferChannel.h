@@ -0,0 +1,242 @@
+//
+// RingBufferChannel.h
+//
+// Library: Foundation
+// Package: Logging
+// Module:  RingBufferChannel
+//
+// Definition of the RingBufferChannel class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_RingBufferChannel_INCLUDED
+#define Foundation_RingBufferChannel_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Channel.h"
+#include "Poco/Thread.h"
+#include "Poco/Mutex.h"
+#include "Poco/Event.h"
+#include "Poco/Runnable.h"
+#include "Poco/AutoPtr.h"
+#include <vector>
+#include <atomic>
+
+
+namespace Poco {
+
+
+class Foundation_API RingBufferChannel: public Channel, public Runnable
+	/// A high-throughput replacement for AsyncChannel.
+	///
+	/// Instead of allocating a notification for every message
+	/// and pushing it through a mutex-protected queue, every
+	/// thread logging to a RingBufferChannel gets its own
+	/// single-producer/single-consumer ring buffer. Logging
+	/// a message copies its fields into a preallocated slot
+	/// of the ring buffer without taking any locks. Only messages
+	/// with parameters or with very long texts are copied
+	/// into a heap-allocated Message.
+	///
+	/// A single background thread collects the messages from
+	/// all ring buffers and forwards them in batches to the
+	/// target channel. Any formatting (e.g., by a FormattingChannel
+	/// used as target channel) is thus deferred to the background
+	/// thread.
+	///
+	/// Messages logged by the same thread are delivered in order.
+	/// There is no ordering guarantee for messages logged by
+	/// different threads.
+	///
+	/// If a ring buffer is full, the overflow policy determines
+	/// what happens:
+	///   * OVERFLOW_BLOCK: the logging thread waits until there is
+	///     space in the ring buffer (default).
+	///   * OVERFLOW_DROP: the message is dropped.
+	///   * OVERFLOW_SAMPLE: as soon as the ring buffer is half full,
+	///     only every n-th message (see setSampleRate()) is
+	///     accepted. If the ring buffer is full, the message
+	///     is dropped.
+	/// The number of dropped messages can be obtained with
+	/// droppedMessages().
+{
+public:
+	enum OverflowPolicy
+	{
+		OVERFLOW_BLOCK,
+		OVERFLOW_DROP,
+		OVERFLOW_SAMPLE
+	};
+
+	enum
+	{
+		DEFAULT_CAPACITY = 1024,
+		DEFAULT_SAMPLE_RATE = 10
+	};
+
+	RingBufferChannel(Channel* pChannel = 0, std::size_t capacity = DEFAULT_CAPACITY, OverflowPolicy policy = OVERFLOW_BLOCK, Thread::Priority prio = Thread::PRIO_NORMAL);
+		/// Creates the RingBufferChannel and connects it to
+		/// the given channel.
+		///
+		/// The capacity (number of messages) of the per-thread
+		/// ring buffers is rounded up to the next power of two.
+
+	void setChannel(Channel* pChannel);
+		/// Connects the RingBufferChannel to the given target channel.
+		/// All messages will be forwarded to this channel.
+
+	Channel* getChannel() const;
+		/// Returns the target channel.
+
+	void setOverflowPolicy(OverflowPolicy policy);
+		/// Sets the overflow policy.
+
+	OverflowPolicy getOverflowPolicy() const;
+		/// Returns the overflow policy.
+
+	void setSampleRate(int rate);
+		/// Sets the sample rate for OVERFLOW_SAMPLE.
+
+	int getSampleRate() const;
+		/// Returns the sample rate.
+
+	void setCapacity(std::size_t capacity);
+		/// Sets the capacity of ring buffers. Only ring buffers
+		/// created afterwards (for threads that have not logged
+		/// to this channel yet) are affected.
+
+	std::size_t getCapacity() const;
+		/// Returns the capacity of new ring buffers.
+
+	UInt64 droppedMessages() const;
+		/// Returns the number of messages dropped due to
+		/// the overflow policy.
+
+	void open();
+		/// Opens the channel and creates the
+		/// background logging thread.
+
+	void close();
+		/// Waits until all messages logged so far have been
+		/// delivered, then stops the background logging thread.
+
+	void flush();
+		/// Waits until all messages logged so far by any thread
+		/// have been delivered to the target channel.
+
+	void log(const Message& msg);
+		/// Copies the message into the ring buffer of the
+		/// calling thread for processing by the background thread.
+
+	void setProperty(const std::string& name, const std::string& value);
+		/// Sets or changes a configuration property.
+		///
+		/// The "channel" property allows setting the target
+		/// channel via the LoggingRegistry.
+		/// The "channel" property is set-only.
+		///
+		/// The "priority" property allows setting the thread
+		/// priority. The following values are supported:
+		///    * lowest
+		///    * low
+		///    * normal (default)
+		///    * high
+		///    * highest
+		///
+		/// The "priority" property is set-only.
+		///
+		/// The "capacity" property sets the capacity of new
+		/// ring buffers.
+		///
+		/// The "overflow" property sets the overflow policy.
+		/// Supported values are "block" (default), "drop" and "sample".
+		///
+		/// The "sampleRate" property sets the sample rate.
+
+	std::string getProperty(const std::string& name) const;
+		/// Returns the value of the given property.
+
+	static const std::string PROP_CAPACITY;
+	static const std::string PROP_OVERFLOW;
+	static const std::string PROP_SAMPLERATE;
+
+protected:
+	~RingBufferChannel();
+	void run();
+	void setPriority(const std::string& value);
+	void wakeUp();
+
+private:
+	class Ring;
+	struct ThreadRings;
+
+	Ring* ringForThread();
+	std::size_t deliver(Ring& ring, Message& msg, std::string& buffer);
+	void refreshRings(std::vector<AutoPtr<Ring> >& rings, UInt64& version);
+	bool empty();
+
+	RingBufferChannel(const RingBufferChannel&);
+	RingBufferChannel& operator = (const RingBufferChannel&);
+
+	const UInt64              _id;
+	Channel*                  _pChannel;
+	std::atomic<std::size_t>  _capacity;
+	std::atomic<int>          _policy;
+	std::atomic<int>          _sampleRate;
+	std::atomic<UInt64>       _dropped;
+	Thread                    _thread;
+	FastMutex                 _threadMutex;
+	FastMutex                 _channelMutex;
+	FastMutex                 _ringsMutex;
+	std::vector<AutoPtr<Ring> > _rings;
+	std::atomic<UInt64>       _ringsVersion;
+	std::atomic<bool>         _open;
+	std::atomic<bool>         _stop;
+	std::atomic<bool>         _sleeping;
+	Event                     _wakeUp;
+};
+
+
+//
+// inlines
+//
+inline Channel* RingBufferChannel::getChannel() const
+{
+	return _pChannel;
+}
+
+
+inline RingBufferChannel::OverflowPolicy RingBufferChannel::getOverflowPolicy() const
+{
+	return static_cast<OverflowPolicy>(_policy.load(std::memory_order_relaxed));
+}
+
+
+inline int RingBufferChannel::getSampleRate() const
+{
+	return _sampleRate.load(std::memory_order_relaxed);
+}
+
+
+inline std::size_t RingBufferChannel::getCapacity() const
+{
+	return _capacity.load(std::memory_order_relaxed);
+}
+
+
+inline UInt64 RingBufferChannel::droppedMessages() const
+{
+	return _dropped.load(std::memory_order_relaxed);
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_RingBufferChannel_INCLUDED
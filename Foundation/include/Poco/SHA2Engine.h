@@ -0,0 +1,159 @@
+//
+// SHA2Engine.h
+//
+// Library: Foundation
+// Package: Crypt
+// Module:  SHA2Engine
+//
+// Definition of class SHA2Engine.
+//
+// Secure Hash Standard SHA-2 algorithm
+// (FIPS 180-4, see http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.180-4.pdf)
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_SHA2Engine_INCLUDED
+#define Foundation_SHA2Engine_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/DigestEngine.h"
+
+
+namespace Poco {
+
+
+class Foundation_API SHA2Engine: public DigestEngine
+	/// This class implements the SHA-2 message digest algorithms
+	/// SHA-224, SHA-256, SHA-384 and SHA-512.
+	/// (FIPS 180-4, see http://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.180-4.pdf)
+	///
+	/// SHA-224 and SHA-256 use the SHA extensions of the
+	/// processor, if available.
+{
+public:
+	enum ALGORITHM
+	{
+		SHA_224 = 224,
+		SHA_256 = 256,
+		SHA_384 = 384,
+		SHA_512 = 512
+	};
+
+	SHA2Engine(ALGORITHM algorithm = SHA_256);
+	~SHA2Engine();
+
+	ALGORITHM algorithm() const;
+		/// Returns the algorithm.
+
+	std::size_t digestLength() const;
+	void reset();
+	const DigestEngine::Digest& digest();
+
+protected:
+	void updateImpl(const void* data, std::size_t length);
+
+private:
+	std::size_t blockSize() const;
+	void transform(const unsigned char* data, std::size_t blocks);
+
+	ALGORITHM            _algorithm;
+	UInt32               _state32[8];
+	UInt64               _state64[8];
+	UInt64               _count;
+	unsigned char        _buffer[128];
+	DigestEngine::Digest _digest;
+
+	SHA2Engine(const SHA2Engine&);
+	SHA2Engine& operator = (const SHA2Engine&);
+};
+
+
+class Foundation_API SHA2Engine224: public SHA2Engine
+	/// SHA-224 engine, with the BLOCK_SIZE and DIGEST_SIZE
+	/// constants required by HMACEngine.
+{
+public:
+	enum
+	{
+		BLOCK_SIZE  = 64,
+		DIGEST_SIZE = 28
+	};
+
+	SHA2Engine224();
+	~SHA2Engine224();
+};
+
+
+class Foundation_API SHA2Engine256: public SHA2Engine
+	/// SHA-256 engine, with the BLOCK_SIZE and DIGEST_SIZE
+	/// constants required by HMACEngine.
+{
+public:
+	enum
+	{
+		BLOCK_SIZE  = 64,
+		DIGEST_SIZE = 32
+	};
+
+	SHA2Engine256();
+	~SHA2Engine256();
+};
+
+
+class Foundation_API SHA2Engine384: public SHA2Engine
+	/// SHA-384 engine, with the BLOCK_SIZE and DIGEST_SIZE
+	/// constants required by HMACEngine.
+{
+public:
+	enum
+	{
+		BLOCK_SIZE  = 128,
+		DIGEST_SIZE = 48
+	};
+
+	SHA2Engine384();
+	~SHA2Engine384();
+};
+
+
+class Foundation_API SHA2Engine512: public SHA2Engine
+	/// SHA-512 engine, with the BLOCK_SIZE and DIGEST_SIZE
+	/// constants required by HMACEngine.
+{
+public:
+	enum
+	{
+		BLOCK_SIZE  = 128,
+		DIGEST_SIZE = 64
+	};
+
+	SHA2Engine512();
+	~SHA2Engine512();
+};
+
+
+//
+// inlines
+//
+inline SHA2Engine::ALGORITHM SHA2Engine::algorithm() const
+{
+	return _algorithm;
+}
+
+
+inline std::size_t SHA2Engine::blockSize() const
+{
+	return _algorithm == SHA_224 || _algorithm == SHA_256 ? 64 : 128;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_SHA2Engine_INCLUDED
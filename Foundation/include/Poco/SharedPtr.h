@@ -20,8 +20,11 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/Exception.h"
-#include "Poco/AtomicCounter.h"
 #include <algorithm>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 
 namespace Poco {
@@ -29,9 +32,64 @@ namespace Poco {
 
 class ReferenceCounter
 	/// Simple ReferenceCounter object, does not delete itself when count reaches 0.
+	///
+	/// The counter is thread-safe. Incrementing the counter uses relaxed
+	/// memory ordering, as a new reference can only be created from an
+	/// existing one. Decrementing uses acquire-release ordering, so that
+	/// all accesses to the object happen before it is deleted.
 {
 public:
-	ReferenceCounter(): _cnt(1)
+	typedef void (*Disposer)(ReferenceCounter* pCounter);
+
+	ReferenceCounter(): _cnt(1), _pDisposer(0)
+	{
+	}
+
+	void duplicate()
+	{
+		_cnt.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	int release()
+	{
+		return _cnt.fetch_sub(1, std::memory_order_acq_rel) - 1;
+	}
+	
+	int referenceCount() const
+	{
+		return _cnt.load(std::memory_order_relaxed);
+	}
+
+	void setDisposer(Disposer pDisposer)
+		/// Sets the function that destroys both the object and
+		/// the counter when the reference count reaches zero.
+	{
+		_pDisposer = pDisposer;
+	}
+
+	Disposer disposer() const
+		/// Returns the disposer.
+	{
+		return _pDisposer;
+	}
+
+private:
+	std::atomic<int> _cnt;
+	Disposer _pDisposer;
+};
+
+
+class NonAtomicReferenceCounter
+	/// A ReferenceCounter that is not thread-safe, for
+	/// SharedPtr instances used by a single thread only.
+	/// Avoids the cost of atomic operations, e.g.:
+	///
+	///     typedef SharedPtr<Object, NonAtomicReferenceCounter> ObjectPtr;
+{
+public:
+	typedef void (*Disposer)(NonAtomicReferenceCounter* pCounter);
+
+	NonAtomicReferenceCounter(): _cnt(1), _pDisposer(0)
 	{
 	}
 
@@ -44,14 +102,25 @@ public:
 	{
 		return --_cnt;
 	}
-	
+
 	int referenceCount() const
 	{
-		return _cnt.value();
+		return _cnt;
+	}
+
+	void setDisposer(Disposer pDisposer)
+	{
+		_pDisposer = pDisposer;
+	}
+
+	Disposer disposer() const
+	{
+		return _pDisposer;
 	}
 
 private:
-	AtomicCounter _cnt;
+	int _cnt;
+	Disposer _pDisposer;
 };
 
 
@@ -84,6 +153,10 @@ public:
 };
 
 
+template <class C, class RC> struct SharedPtrBlock;
+template <class C, class RC, class RP> struct SharedPtrHolder;
+
+
 template <class C, class RC = ReferenceCounter, class RP = ReleasePolicy<C> >
 class SharedPtr
 	/// SharedPtr is a "smart" pointer for classes implementing
@@ -111,15 +184,22 @@ class SharedPtr
 	/// SharedPtr also implements all relational operators and
 	/// a cast operator in case dynamic casting of the encapsulated data types
 	/// is required.
+	///
+	/// Use makeShared() to create an object together with its
+	/// reference counter in a single memory allocation.
+	///
+	/// If the reference counter supports a disposer, the object is
+	/// released with the release policy of the SharedPtr that took
+	/// ownership of it.
 {
 public:
-	SharedPtr(): _pCounter(new RC), _ptr(0)
+	SharedPtr(): _pCounter(newCounter(0, 0)), _ptr(0)
 	{
 	}
 
 	SharedPtr(C* ptr)
 	try:
-		_pCounter(new RC), 
+		_pCounter(newCounter(ptr, 0)), 
 		_ptr(ptr)
 	{
 	}
@@ -131,12 +211,20 @@ public:
 	template <class Other, class OtherRP> 
 	SharedPtr(const SharedPtr<Other, RC, OtherRP>& ptr): _pCounter(ptr._pCounter), _ptr(const_cast<Other*>(ptr.get()))
 	{
-		_pCounter->duplicate();
+		if (_pCounter) _pCounter->duplicate();
 	}
 
 	SharedPtr(const SharedPtr& ptr): _pCounter(ptr._pCounter), _ptr(ptr._ptr)
 	{
-		_pCounter->duplicate();
+		if (_pCounter) _pCounter->duplicate();
+	}
+
+	SharedPtr(SharedPtr&& ptr) noexcept: _pCounter(ptr._pCounter), _ptr(ptr._ptr)
+		/// Takes over the reference from ptr, without changing the
+		/// reference count. ptr can only be destroyed or assigned to.
+	{
+		ptr._pCounter = 0;
+		ptr._ptr = 0;
 	}
 
 	~SharedPtr()
@@ -213,6 +301,13 @@ public:
 		return assign(ptr);
 	}
 
+	SharedPtr& operator = (SharedPtr&& ptr) noexcept
+	{
+		SharedPtr tmp(std::move(ptr));
+		swap(tmp);
+		return *this;
+	}
+
 	template <class Other, class OtherRP>
 	SharedPtr& operator = (const SharedPtr<Other, RC, OtherRP>& ptr)
 	{
@@ -248,6 +343,8 @@ public:
 		///    SharedPtr<Sub> sub = super.unsafeCast<Sub>();
 		///    poco_assert (sub.get());
 	{
+		if (!_pCounter) return SharedPtr<Other, RC, RP>(); // moved from
+
 		Other* pOther = static_cast<Other*>(_ptr);
 		return SharedPtr<Other, RC, RP>(_pCounter, pOther);
 	}
@@ -394,7 +491,7 @@ public:
 	
 	int referenceCount() const
 	{
-		return _pCounter->referenceCount();
+		return _pCounter ? _pCounter->referenceCount() : 0;
 	}
 
 private:
@@ -408,23 +505,58 @@ private:
 
 	void release()
 	{
-		poco_assert_dbg (_pCounter);
+		if (!_pCounter) return; // moved from
+
 		int i = _pCounter->release();
 		if (i == 0)
 		{
-			RP::release(_ptr);
+			dispose(_pCounter, _ptr, 0);
 			_ptr = 0;
-
-			delete _pCounter;
 			_pCounter = 0;
 		}
 	}
 
+	template <class Counter = RC>
+	static auto newCounter(C* ptr, int) -> decltype(std::declval<Counter&>().setDisposer(0), static_cast<RC*>(0))
+		/// Creates a counter that releases ptr with the
+		/// release policy RP when it is disposed.
+	{
+		return SharedPtrHolder<C, RC, RP>::create(ptr);
+	}
+
+	template <class Counter = RC>
+	static RC* newCounter(C*, long)
+		/// Overload for reference counters not supporting a disposer.
+	{
+		return new RC;
+	}
+
+	template <class Counter>
+	static auto dispose(Counter* pCounter, C*, int) -> decltype(pCounter->disposer(), void())
+		/// Destroys object and counter through the counter's disposer.
+	{
+		pCounter->disposer()(pCounter);
+	}
+
+	template <class Counter>
+	static void dispose(Counter* pCounter, C* ptr, long)
+		/// Overload for reference counters not supporting a disposer.
+	{
+		RP::release(ptr);
+		delete pCounter;
+	}
+
 	SharedPtr(RC* pCounter, C* ptr): _pCounter(pCounter), _ptr(ptr)
 		/// for cast operation
+	{
+		if (_pCounter) _pCounter->duplicate();
+	}
+
+	SharedPtr(RC* pCounter, C* ptr, bool shared): _pCounter(pCounter), _ptr(ptr)
+		/// for makeShared(); takes over the reference unless shared is true
 	{
 		poco_assert_dbg (_pCounter);
-		_pCounter->duplicate();
+		if (shared) _pCounter->duplicate();
 	}
 
 private:
@@ -432,9 +564,86 @@ private:
 	C*  _ptr;
 
 	template <class OtherC, class OtherRC, class OtherRP> friend class SharedPtr;
+	template <class OtherC, class OtherRC> friend struct SharedPtrBlock;
+};
+
+
+template <class C, class RC, class RP>
+struct SharedPtrHolder: public RC
+	/// This class template is used internally by SharedPtr.
+	/// It holds the reference counter and a pointer to an object
+	/// that has been allocated separately.
+{
+	C* pObj;
+
+	static RC* create(C* ptr)
+	{
+		SharedPtrHolder* pHolder = new SharedPtrHolder;
+		pHolder->pObj = ptr;
+		pHolder->setDisposer(&SharedPtrHolder::dispose);
+		return pHolder;
+	}
+
+	static void dispose(RC* pCounter)
+	{
+		SharedPtrHolder* pHolder = static_cast<SharedPtrHolder*>(pCounter);
+		RP::release(pHolder->pObj);
+		delete pHolder;
+	}
+};
+
+
+template <class C, class RC>
+struct SharedPtrBlock: public RC
+	/// This class template is used internally by makeShared().
+	/// It holds the reference counter and the object in a
+	/// single memory block.
+{
+	typename std::aligned_storage<sizeof(C), alignof(C)>::type storage;
+
+	template <class... Args>
+	static SharedPtr<C, RC> create(Args&&... args)
+	{
+		SharedPtrBlock* pBlock = new SharedPtrBlock;
+		C* pObj;
+		try
+		{
+			pObj = new (&pBlock->storage) C(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			delete pBlock;
+			throw;
+		}
+		pBlock->setDisposer(&SharedPtrBlock::dispose);
+		return SharedPtr<C, RC>(pBlock, pObj, false);
+	}
+
+	static void dispose(RC* pCounter)
+	{
+		SharedPtrBlock* pBlock = static_cast<SharedPtrBlock*>(pCounter);
+		reinterpret_cast<C*>(&pBlock->storage)->~C();
+		delete pBlock;
+	}
 };
 
 
+template <class C, class RC = ReferenceCounter, class... Args>
+inline SharedPtr<C, RC> makeShared(Args&&... args)
+	/// Creates an object of class C, passing args to its constructor,
+	/// and returns a SharedPtr holding it. Unlike SharedPtr<C>(new C(...)),
+	/// the object and its reference counter are allocated in a single
+	/// memory block, e.g.:
+	///
+	///     SharedPtr<std::string> pStr = makeShared<std::string>("Hello");
+	///
+	/// The object is always destroyed with its destructor; the release
+	/// policy of the SharedPtr is not used.
+{
+	return SharedPtrBlock<C, RC>::create(std::forward<Args>(args)...);
+}
+
+
 template <class C, class RC, class RP>
 inline void swap(SharedPtr<C, RC, RP>& p1, SharedPtr<C, RC, RP>& p2)
 {
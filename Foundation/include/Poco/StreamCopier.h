@@ -35,6 +35,11 @@ public:
 	static std::streamsize copyStream(std::istream& istr, std::ostream& ostr, std::size_t bufferSize = 8192);
 		/// Writes all bytes readable from istr to ostr, using an internal buffer.
 		///
+		/// On Linux, if both streams use a NativeStreamBuf (e.g., a FileInputStream
+		/// and a FileOutputStream, PipeOutputStream or SocketOutputStream), the data
+		/// is copied within the kernel using copy_file_range(), sendfile() or splice(),
+		/// without passing it through the internal buffer.
+		///
 		/// Returns the number of bytes copied.
 
 #if defined(POCO_HAVE_INT64)
@@ -0,0 +1,353 @@
+//
+// StringRef.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringRef
+//
+// Definition of the StringRef class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_StringRef_INCLUDED
+#define Foundation_StringRef_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/Ascii.h"
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <ostream>
+
+
+namespace Poco {
+
+
+class Foundation_API StringRef
+	/// A StringRef is a non-owning reference to a sequence of
+	/// characters, similar to std::string_view in C++17.
+	///
+	/// A StringRef consists of a pointer and a length only.
+	/// It is cheap to copy and creating a StringRef, or a slice
+	/// of it with substr(), trim() etc., never allocates memory.
+	///
+	/// The referenced characters must outlive the StringRef.
+	/// In particular, a StringRef must not be created from a
+	/// temporary std::string that is destroyed while the
+	/// StringRef is still in use.
+{
+public:
+	typedef const char* Iterator;
+	typedef const char* const_iterator;
+
+	static const std::size_t npos = static_cast<std::size_t>(-1);
+
+	StringRef();
+		/// Creates an empty StringRef.
+
+	StringRef(const char* str);
+		/// Creates a StringRef referencing the given zero-terminated string.
+
+	StringRef(const char* str, std::size_t length);
+		/// Creates a StringRef referencing length characters starting at str.
+
+	StringRef(const char* begin, const char* end);
+		/// Creates a StringRef referencing the characters in [begin, end).
+
+	StringRef(const std::string& str);
+		/// Creates a StringRef referencing the contents of str.
+
+	const char* data() const;
+		/// Returns a pointer to the first character.
+		/// Note that the characters are not necessarily zero-terminated.
+
+	std::size_t size() const;
+		/// Returns the number of characters.
+
+	std::size_t length() const;
+		/// Returns the number of characters.
+
+	bool empty() const;
+		/// Returns true iff the StringRef is empty.
+
+	Iterator begin() const;
+		/// Returns an iterator to the first character.
+
+	Iterator end() const;
+		/// Returns an iterator past the last character.
+
+	char operator [] (std::size_t index) const;
+		/// Returns the character at the given index.
+		/// The index is not checked.
+
+	char front() const;
+		/// Returns the first character. The StringRef must not be empty.
+
+	char back() const;
+		/// Returns the last character. The StringRef must not be empty.
+
+	StringRef substr(std::size_t pos, std::size_t n = npos) const;
+		/// Returns a StringRef referencing at most n characters
+		/// starting at pos. If pos is beyond the end, an empty
+		/// StringRef is returned.
+
+	std::size_t find(char ch, std::size_t pos = 0) const;
+		/// Returns the position of the first occurence of ch,
+		/// starting at pos, or npos if ch is not found.
+
+	std::size_t find(const StringRef& str, std::size_t pos = 0) const;
+		/// Returns the position of the first occurence of str,
+		/// starting at pos, or npos if str is not found.
+
+	std::size_t rfind(char ch, std::size_t pos = npos) const;
+		/// Returns the position of the last occurence of ch at or
+		/// before pos, or npos if ch is not found.
+
+	std::size_t findFirstOf(const StringRef& chars, std::size_t pos = 0) const;
+		/// Returns the position of the first character, starting at pos,
+		/// that is one of the characters in chars, or npos if there
+		/// is no such character.
+		///
+		/// Sets of up to eight characters are searched 16 characters
+		/// at a time using SSE2, if available.
+
+	bool startsWith(const StringRef& prefix) const;
+		/// Returns true iff the StringRef starts with prefix.
+
+	bool endsWith(const StringRef& suffix) const;
+		/// Returns true iff the StringRef ends with suffix.
+
+	StringRef trimLeft() const;
+		/// Returns a StringRef with leading whitespace removed.
+
+	StringRef trimRight() const;
+		/// Returns a StringRef with trailing whitespace removed.
+
+	StringRef trim() const;
+		/// Returns a StringRef with leading and trailing whitespace removed.
+
+	int compare(const StringRef& str) const;
+		/// Compares the characters lexicographically and returns
+		/// a negative value, zero or a positive value, like
+		/// std::string::compare().
+
+	int icompare(const StringRef& str) const;
+		/// Compares the characters lexicographically, ignoring
+		/// the case of ASCII letters.
+
+	std::string toString() const;
+		/// Returns a std::string containing a copy of the characters.
+
+	void assignTo(std::string& str) const;
+		/// Assigns the characters to str, reusing its storage.
+
+	void appendTo(std::string& str) const;
+		/// Appends the characters to str.
+
+private:
+	const char* _data;
+	std::size_t _length;
+};
+
+
+bool operator == (const StringRef& s1, const StringRef& s2);
+bool operator != (const StringRef& s1, const StringRef& s2);
+bool operator <  (const StringRef& s1, const StringRef& s2);
+std::ostream& operator << (std::ostream& ostr, const StringRef& str);
+
+
+//
+// inlines
+//
+inline StringRef::StringRef():
+	_data(""),
+	_length(0)
+{
+}
+
+
+inline StringRef::StringRef(const char* str):
+	_data(str),
+	_length(std::strlen(str))
+{
+}
+
+
+inline StringRef::StringRef(const char* str, std::size_t length):
+	_data(str),
+	_length(length)
+{
+}
+
+
+inline StringRef::StringRef(const char* begin, const char* end):
+	_data(begin),
+	_length(end - begin)
+{
+}
+
+
+inline StringRef::StringRef(const std::string& str):
+	_data(str.data()),
+	_length(str.size())
+{
+}
+
+
+inline const char* StringRef::data() const
+{
+	return _data;
+}
+
+
+inline std::size_t StringRef::size() const
+{
+	return _length;
+}
+
+
+inline std::size_t StringRef::length() const
+{
+	return _length;
+}
+
+
+inline bool StringRef::empty() const
+{
+	return _length == 0;
+}
+
+
+inline StringRef::Iterator StringRef::begin() const
+{
+	return _data;
+}
+
+
+inline StringRef::Iterator StringRef::end() const
+{
+	return _data + _length;
+}
+
+
+inline char StringRef::operator [] (std::size_t index) const
+{
+	return _data[index];
+}
+
+
+inline char StringRef::front() const
+{
+	return _data[0];
+}
+
+
+inline char StringRef::back() const
+{
+	return _data[_length - 1];
+}
+
+
+inline StringRef StringRef::substr(std::size_t pos, std::size_t n) const
+{
+	if (pos > _length) pos = _length;
+	if (n > _length - pos) n = _length - pos;
+	return StringRef(_data + pos, n);
+}
+
+
+inline std::size_t StringRef::find(char ch, std::size_t pos) const
+{
+	if (pos >= _length) return npos;
+	const void* p = std::memchr(_data + pos, static_cast<unsigned char>(ch), _length - pos);
+	return p ? static_cast<const char*>(p) - _data : npos;
+}
+
+
+inline bool StringRef::startsWith(const StringRef& prefix) const
+{
+	return prefix._length <= _length && std::memcmp(_data, prefix._data, prefix._length) == 0;
+}
+
+
+inline bool StringRef::endsWith(const StringRef& suffix) const
+{
+	return suffix._length <= _length && std::memcmp(_data + _length - suffix._length, suffix._data, suffix._length) == 0;
+}
+
+
+inline StringRef StringRef::trimLeft() const
+{
+	const char* it  = _data;
+	const char* end = _data + _length;
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	return StringRef(it, end);
+}
+
+
+inline StringRef StringRef::trimRight() const
+{
+	const char* end = _data + _length;
+	while (end != _data && Ascii::isSpace(end[-1])) --end;
+	return StringRef(_data, end);
+}
+
+
+inline StringRef StringRef::trim() const
+{
+	return trimLeft().trimRight();
+}
+
+
+inline std::string StringRef::toString() const
+{
+	return std::string(_data, _length);
+}
+
+
+inline void StringRef::assignTo(std::string& str) const
+{
+	str.assign(_data, _length);
+}
+
+
+inline void StringRef::appendTo(std::string& str) const
+{
+	str.append(_data, _length);
+}
+
+
+inline bool operator == (const StringRef& s1, const StringRef& s2)
+{
+	return s1.size() == s2.size() && std::memcmp(s1.data(), s2.data(), s1.size()) == 0;
+}
+
+
+inline bool operator != (const StringRef& s1, const StringRef& s2)
+{
+	return !(s1 == s2);
+}
+
+
+inline bool operator < (const StringRef& s1, const StringRef& s2)
+{
+	return s1.compare(s2) < 0;
+}
+
+
+inline std::ostream& operator << (std::ostream& ostr, const StringRef& str)
+{
+	return ostr.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_StringRef_INCLUDED
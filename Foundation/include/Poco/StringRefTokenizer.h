@@ -0,0 +1,180 @@
+//
+// StringRefTokenizer.h
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringRefTokenizer
+//
+// Definition of the StringRefTokenizer class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_StringRefTokenizer_INCLUDED
+#define Foundation_StringRefTokenizer_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/StringRef.h"
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class Foundation_API StringRefTokenizer
+	/// A lazy tokenizer that splits a string into tokens, which
+	/// are separated by separator characters.
+	///
+	/// Unlike StringTokenizer, StringRefTokenizer does not copy the
+	/// tokens into a vector of strings. Tokens are found one at a time
+	/// while iterating, and each token is a StringRef referencing the
+	/// original string, so tokenizing never allocates memory:
+	///
+	///     StringRefTokenizer tok(str, ",;", StringRefTokenizer::TOK_TRIM);
+	///     for (StringRefTokenizer::Iterator it = tok.begin(); it != tok.end(); ++it)
+	///     {
+	///         const StringRef& token = *it;
+	///         ...
+	///     }
+	///
+	/// The tokens are the same as those produced by a
+	/// StringTokenizer with the same arguments.
+	///
+	/// Both the string and the separators must outlive the
+	/// tokenizer and its iterators.
+{
+public:
+	enum Options
+	{
+		TOK_IGNORE_EMPTY = 1, /// ignore empty tokens
+		TOK_TRIM         = 2  /// remove leading and trailing whitespace from tokens
+	};
+
+	class Foundation_API Iterator
+		/// A forward iterator over the tokens.
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef StringRef                 value_type;
+		typedef std::ptrdiff_t            difference_type;
+		typedef const StringRef*          pointer;
+		typedef const StringRef&          reference;
+
+		Iterator();
+			/// Creates an end iterator.
+
+		const StringRef& operator * () const;
+		const StringRef* operator -> () const;
+
+		Iterator& operator ++ ();
+		Iterator operator ++ (int);
+
+		bool operator == (const Iterator& other) const;
+		bool operator != (const Iterator& other) const;
+
+	private:
+		Iterator(const StringRefTokenizer* pTokenizer);
+
+		void next();
+
+		const StringRefTokenizer* _pTokenizer;
+		const char* _pNext; // start of the next token, or null after the last token
+		StringRef _token;
+		bool _end;
+
+		friend class StringRefTokenizer;
+	};
+
+	StringRefTokenizer(const StringRef& str, const StringRef& separators, int options = 0);
+		/// Creates the tokenizer for the given string. The tokens are expected to be
+		/// separated by one of the separator characters given in separators.
+		/// Additionally, options can be specified:
+		///   * TOK_IGNORE_EMPTY: empty tokens are ignored
+		///   * TOK_TRIM: trailing and leading whitespace is removed from tokens.
+
+	~StringRefTokenizer();
+		/// Destroys the tokenizer.
+
+	Iterator begin() const;
+		/// Returns an iterator to the first token.
+
+	Iterator end() const;
+		/// Returns the end iterator.
+
+	std::size_t split(std::vector<StringRef>& tokens) const;
+		/// Replaces the contents of tokens with all tokens and
+		/// returns their number. The storage of tokens is reused.
+
+private:
+	StringRef _str;
+	StringRef _separators;
+	int _options;
+};
+
+
+//
+// inlines
+//
+inline const StringRef& StringRefTokenizer::Iterator::operator * () const
+{
+	return _token;
+}
+
+
+inline const StringRef* StringRefTokenizer::Iterator::operator -> () const
+{
+	return &_token;
+}
+
+
+inline StringRefTokenizer::Iterator& StringRefTokenizer::Iterator::operator ++ ()
+{
+	next();
+	return *this;
+}
+
+
+inline StringRefTokenizer::Iterator StringRefTokenizer::Iterator::operator ++ (int)
+{
+	Iterator tmp(*this);
+	next();
+	return tmp;
+}
+
+
+inline bool StringRefTokenizer::Iterator::operator == (const Iterator& other) const
+{
+	if (_end || other._end) return _end == other._end;
+	return _pNext == other._pNext && _token.data() == other._token.data();
+}
+
+
+inline bool StringRefTokenizer::Iterator::operator != (const Iterator& other) const
+{
+	return !(*this == other);
+}
+
+
+inline StringRefTokenizer::Iterator StringRefTokenizer::begin() const
+{
+	return Iterator(this);
+}
+
+
+inline StringRefTokenizer::Iterator StringRefTokenizer::end() const
+{
+	return Iterator();
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_StringRefTokenizer_INCLUDED
@@ -30,6 +30,12 @@ class TextEncoding;
 class Foundation_API TextConverter
 	/// A TextConverter converts strings from one encoding
 	/// into another.
+	///
+	/// Conversions without a transform function between Latin-1,
+	/// UTF-8, UTF-16 and UTF-32 are done in bulk by
+	/// UnicodeConverter::transcode(). For other encodings that
+	/// agree with ASCII in the first 128 characters, runs of
+	/// ASCII characters are copied unchanged.
 {
 public:
 	typedef int (*Transform)(int);
@@ -84,6 +90,9 @@ private:
 	const TextEncoding& _inEncoding;
 	const TextEncoding& _outEncoding;
 	int                 _defaultChar;
+	int                 _inFamily;
+	int                 _outFamily;
+	bool                _asciiCompatible;
 };
 
 
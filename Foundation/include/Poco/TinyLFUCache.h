@@ -0,0 +1,59 @@
+//
+// TinyLFUCache.h
+//
+// Library: Foundation
+// Package: Cache
+// Module:  TinyLFUCache
+//
+// Definition of the TinyLFUCache class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_TinyLFUCache_INCLUDED
+#define Foundation_TinyLFUCache_INCLUDED
+
+
+#include "Poco/AbstractCache.h"
+#include "Poco/TinyLFUStrategy.h"
+
+
+namespace Poco {
+
+
+template <
+	class TKey,
+	class TValue,
+	class TMutex = FastMutex,
+	class TEventMutex = FastMutex
+>
+class TinyLFUCache: public AbstractCache<TKey, TValue, TinyLFUStrategy<TKey, TValue>, TMutex, TEventMutex>
+	/// A TinyLFUCache implements W-TinyLFU caching, which combines
+	/// recency and frequency of accesses and is resistant to scans.
+	/// See TinyLFUStrategy for details. The default size for a cache
+	/// is 1024 entries.
+{
+public:
+	TinyLFUCache(long size = 1024, int windowPercent = 1):
+		AbstractCache<TKey, TValue, TinyLFUStrategy<TKey, TValue>, TMutex, TEventMutex>(TinyLFUStrategy<TKey, TValue>(size, windowPercent))
+	{
+	}
+
+	~TinyLFUCache()
+	{
+	}
+
+private:
+	TinyLFUCache(const TinyLFUCache& aCache);
+	TinyLFUCache& operator = (const TinyLFUCache& aCache);
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_TinyLFUCache_INCLUDED
@@ -0,0 +1,265 @@
+//
+// TinyLFUStrategy.h
+//
+// Library: Foundation
+// Package: Cache
+// Module:  TinyLFUStrategy
+//
+// Definition of the TinyLFUStrategy class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_TinyLFUStrategy_INCLUDED
+#define Foundation_TinyLFUStrategy_INCLUDED
+
+
+#include "Poco/KeyValueArgs.h"
+#include "Poco/ValidArgs.h"
+#include "Poco/AbstractStrategy.h"
+#include "Poco/FrequencySketch.h"
+#include "Poco/EventArgs.h"
+#include "Poco/Exception.h"
+#include "Poco/Hash.h"
+#include <list>
+#include <map>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+template <class TKey, class TValue, class THash = Hash<TKey> >
+class TinyLFUStrategy: public AbstractStrategy<TKey, TValue>
+	/// A TinyLFUStrategy implements the W-TinyLFU cache replacement
+	/// and admission policy.
+	///
+	/// Pure LRU replacement performs poorly for workloads containing
+	/// scans, where keys that are accessed only once flush frequently
+	/// used entries out of the cache. W-TinyLFU avoids this by only
+	/// admitting a new entry to the main part of the cache if it has
+	/// been accessed more often recently than the entry it would replace.
+	///
+	/// The cache is divided into two areas:
+	///   - a small admission window (by default 1% of the size),
+	///     managed in LRU order, which new entries enter;
+	///   - the main area, a segmented LRU consisting of a probation
+	///     segment and a protected segment (80% of the main area).
+	///
+	/// When an entry is evicted from the window, it becomes a candidate
+	/// for the probation segment. If the main area is full, the candidate
+	/// competes with the least recently used probation entry, and the
+	/// one with the lower estimated access frequency is evicted.
+	/// Access frequencies are recorded in a FrequencySketch.
+	/// Entries in the probation segment that are accessed again are
+	/// promoted to the protected segment.
+	///
+	/// THash is used to hash keys for the FrequencySketch.
+{
+public:
+	enum Region
+	{
+		REGION_WINDOW,
+		REGION_PROBATION,
+		REGION_PROTECTED
+	};
+
+	typedef std::list<TKey>                   Keys;
+	typedef typename Keys::iterator           Iterator;
+	typedef typename Keys::const_iterator     ConstIterator;
+
+	struct Node
+	{
+		Region   region;
+		Iterator it;
+	};
+
+	typedef std::map<TKey, Node>              KeyIndex;
+	typedef typename KeyIndex::iterator       IndexIterator;
+	typedef typename KeyIndex::const_iterator ConstIndexIterator;
+
+public:
+	TinyLFUStrategy(std::size_t size, int windowPercent = 1):
+		_size(size),
+		_windowSize(0),
+		_protectedSize(0),
+		_sketch(size)
+		/// Creates the TinyLFUStrategy for a cache holding at most
+		/// size entries. windowPercent gives the size of the admission
+		/// window in percent of the cache size. A larger window favors
+		/// recency over frequency.
+	{
+		if (_size < 1) throw InvalidArgumentException("size must be > 0");
+		if (windowPercent < 0 || windowPercent > 100) throw InvalidArgumentException("windowPercent must be between 0 and 100");
+
+		_windowSize = _size*windowPercent/100;
+		if (_windowSize < 1) _windowSize = 1;
+		_protectedSize = (_size - _windowSize)*80/100;
+	}
+
+	~TinyLFUStrategy()
+	{
+	}
+
+	void onUpdate(const void*, const KeyValueArgs <TKey, TValue>& args)
+	{
+		// an update counts as an access and keeps the entry in place
+		onGet(0, args.key());
+	}
+
+	void onAdd(const void*, const KeyValueArgs <TKey, TValue>& args)
+	{
+		onRemove(0, args.key());
+		_sketch.increment(_hash(args.key()));
+		_window.push_front(args.key());
+		Node node = { REGION_WINDOW, _window.begin() };
+		_keyIndex.insert(std::make_pair(args.key(), node));
+	}
+
+	void onRemove(const void*, const TKey& key)
+	{
+		IndexIterator it = _keyIndex.find(key);
+		if (it != _keyIndex.end())
+		{
+			keys(it->second.region).erase(it->second.it);
+			_keyIndex.erase(it);
+		}
+	}
+
+	void onGet(const void*, const TKey& key)
+	{
+		_sketch.increment(_hash(key));
+
+		IndexIterator it = _keyIndex.find(key);
+		if (it != _keyIndex.end())
+		{
+			Node& node = it->second;
+			switch (node.region)
+			{
+			case REGION_WINDOW:
+				_window.splice(_window.begin(), _window, node.it);
+				break;
+			case REGION_PROBATION:
+				_protected.splice(_protected.begin(), _probation, node.it);
+				node.region = REGION_PROTECTED;
+				if (_protected.size() > _protectedSize)
+				{
+					// demote the least recently used protected entry
+					Iterator itDemote = --_protected.end();
+					_keyIndex[*itDemote].region = REGION_PROBATION;
+					_probation.splice(_probation.begin(), _protected, itDemote);
+				}
+				break;
+			case REGION_PROTECTED:
+				_protected.splice(_protected.begin(), _protected, node.it);
+				break;
+			}
+		}
+	}
+
+	void onClear(const void*, const EventArgs& args)
+	{
+		_window.clear();
+		_probation.clear();
+		_protected.clear();
+		_keyIndex.clear();
+		_sketch.clear();
+	}
+
+	void onIsValid(const void*, ValidArgs<TKey>& args)
+	{
+		if (_keyIndex.find(args.key()) == _keyIndex.end())
+		{
+			args.invalidate();
+		}
+	}
+
+	void onReplace(const void*, std::set<TKey>& elemsToRemove)
+	{
+		// Note: evicted keys are removed from the strategy right away,
+		// so that further candidates are judged against the remaining
+		// entries. The Remove events the cache sends for them are ignored.
+		std::size_t mainSize = _size - _windowSize;
+		while (_window.size() > _windowSize)
+		{
+			Iterator itCandidate = --_window.end();
+			_keyIndex[*itCandidate].region = REGION_PROBATION;
+			_probation.splice(_probation.begin(), _window, itCandidate);
+
+			if (_probation.size() + _protected.size() > mainSize)
+			{
+				Iterator itVictim;
+				Region victimRegion = REGION_PROBATION;
+				if (_probation.size() > 1)
+				{
+					itVictim = --_probation.end();
+				}
+				else if (!_protected.empty())
+				{
+					itVictim = --_protected.end();
+					victimRegion = REGION_PROTECTED;
+				}
+				else
+				{
+					itVictim = itCandidate;
+				}
+
+				if (itVictim != itCandidate && _sketch.estimate(_hash(*itCandidate)) > _sketch.estimate(_hash(*itVictim)))
+				{
+					evict(victimRegion, itVictim, elemsToRemove);
+				}
+				else
+				{
+					evict(REGION_PROBATION, itCandidate, elemsToRemove);
+				}
+			}
+		}
+	}
+
+	const FrequencySketch& sketch() const
+		/// Returns the FrequencySketch used for admission decisions.
+	{
+		return _sketch;
+	}
+
+protected:
+	Keys& keys(Region region)
+	{
+		switch (region)
+		{
+		case REGION_WINDOW:
+			return _window;
+		case REGION_PROBATION:
+			return _probation;
+		default:
+			return _protected;
+		}
+	}
+
+	void evict(Region region, Iterator it, std::set<TKey>& elemsToRemove)
+	{
+		elemsToRemove.insert(*it);
+		_keyIndex.erase(*it);
+		keys(region).erase(it);
+	}
+
+	std::size_t     _size;          /// Number of keys the cache can store.
+	std::size_t     _windowSize;    /// Number of keys in the admission window.
+	std::size_t     _protectedSize; /// Number of keys in the protected segment.
+	Keys            _window;
+	Keys            _probation;
+	Keys            _protected;
+	KeyIndex        _keyIndex;      /// For faster access to the key lists.
+	FrequencySketch _sketch;
+	THash           _hash;
+};
+
+
+} // namespace Poco
+
+
+#endif // Foundation_TinyLFUStrategy_INCLUDED
@@ -49,6 +49,9 @@ class Foundation_API URI
 	/// generally works, explicitly setting query strings with setQuery() or extracting
 	/// query strings with getQuery() may lead to ambiguities. See the descriptions of
 	/// setQuery(), setRawQuery(), getQuery() and getRawQuery() for more information.
+	///
+	/// To only inspect a URI, without modifying it, URIRef is more
+	/// efficient, as it neither copies nor decodes the parts of the URI.
 {
 public:
 	typedef std::vector<std::pair<std::string, std::string> > QueryParameters;
@@ -0,0 +1,342 @@
+//
+// URIRef.h
+//
+// Library: Foundation
+// Package: URI
+// Module:  URIRef
+//
+// Definition of the URIRef class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Foundation_URIRef_INCLUDED
+#define Foundation_URIRef_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/StringRef.h"
+#include <iterator>
+#include <cstddef>
+
+
+namespace Poco {
+
+
+class URI;
+
+
+class Foundation_API URIRef
+	/// A URIRef is a read-only view of a URI, as specified in RFC 3986.
+	///
+	/// Parsing a URIRef only records where the parts of the URI
+	/// are located in the original string; it neither copies nor
+	/// decodes them, and never allocates memory. The parts are
+	/// returned as StringRefs in their raw, percent-encoded form.
+	/// Decoding is left to the caller and only done when needed,
+	/// with getPath(), getFragment() or decode().
+	///
+	/// Unlike URI, a URIRef does not normalize the URI. In particular,
+	/// the scheme and host are returned as written, not in lower case.
+	/// Percent-encoded sequences in the path and fragment are only
+	/// checked when they are decoded.
+	///
+	/// The string the URIRef has been created from must outlive it,
+	/// and all StringRefs obtained from it.
+	///
+	/// Query parameters can be iterated in place with a QueryIterator:
+	///
+	///     URIRef uri(request.getURI());
+	///     for (URIRef::QueryIterator it = uri.queryBegin(); it != uri.queryEnd(); ++it)
+	///     {
+	///         if (it->name == "id") URIRef::decodeQueryComponent(it->value, id);
+	///     }
+{
+public:
+	struct QueryParameter
+		/// A name-value pair in a query string, in percent-encoded form.
+	{
+		StringRef name;
+		StringRef value;
+	};
+
+	class Foundation_API QueryIterator
+		/// A forward iterator over the name-value pairs in a
+		/// percent-encoded query string, separated by ampersands.
+		///
+		/// The parameters are the same as those returned by
+		/// URI::getQueryParameters(), but not decoded.
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef QueryParameter            value_type;
+		typedef std::ptrdiff_t            difference_type;
+		typedef const QueryParameter*     pointer;
+		typedef const QueryParameter&     reference;
+
+		QueryIterator();
+			/// Creates an end iterator.
+
+		explicit QueryIterator(const StringRef& query);
+			/// Creates an iterator to the first parameter in
+			/// the given raw query, e.g. URI::getRawQuery().
+
+		const QueryParameter& operator * () const;
+		const QueryParameter* operator -> () const;
+
+		QueryIterator& operator ++ ();
+		QueryIterator operator ++ (int);
+
+		bool operator == (const QueryIterator& other) const;
+		bool operator != (const QueryIterator& other) const;
+
+	private:
+		void next();
+
+		StringRef _rest;
+		QueryParameter _param;
+		bool _end;
+	};
+
+	URIRef();
+		/// Creates an empty URIRef.
+
+	explicit URIRef(const StringRef& uri);
+		/// Parses the given URI. Throws a URISyntaxException
+		/// if the URI is not valid.
+
+	~URIRef();
+		/// Destroys the URIRef.
+
+	void parse(const StringRef& uri);
+		/// Parses the given URI, replacing the current one.
+		/// Throws a URISyntaxException if the URI is not valid.
+
+	const StringRef& getScheme() const;
+		/// Returns the scheme, as written.
+
+	const StringRef& getAuthority() const;
+		/// Returns the user-info, host and port parts, as written.
+
+	const StringRef& getUserInfo() const;
+		/// Returns the user-info part, as written.
+
+	const StringRef& getHost() const;
+		/// Returns the host, as written. An IPv6 address
+		/// is returned without the enclosing brackets.
+
+	unsigned short getPort() const;
+		/// Returns the port number given in the URI or, if there
+		/// is none, the well-known port number for the scheme,
+		/// or 0 if the scheme has no well-known port number.
+
+	const StringRef& getRawPath() const;
+		/// Returns the path, in percent-encoded form.
+
+	std::string getPath() const;
+		/// Returns the decoded path.
+
+	const StringRef& getRawQuery() const;
+		/// Returns the query, in percent-encoded form.
+
+	const StringRef& getRawFragment() const;
+		/// Returns the fragment, in percent-encoded form.
+
+	std::string getFragment() const;
+		/// Returns the decoded fragment.
+
+	StringRef getPathEtc() const;
+		/// Returns the path, query and fragment parts, as written.
+
+	QueryIterator queryBegin() const;
+		/// Returns an iterator to the first query parameter.
+
+	QueryIterator queryEnd() const;
+		/// Returns the end iterator for query parameters.
+
+	bool findQueryParameter(const StringRef& name, std::string& value) const;
+		/// Looks for the first query parameter whose decoded name is name.
+		/// If found, the decoded value is assigned to value and true
+		/// is returned. Otherwise, returns false.
+
+	bool isRelative() const;
+		/// Returns true if the URI is a relative reference,
+		/// that is, if it does not contain a scheme.
+
+	bool empty() const;
+		/// Returns true if the URI is empty.
+
+	const StringRef& toStringRef() const;
+		/// Returns the complete URI.
+
+	static void encode(const StringRef& str, const StringRef& reserved, std::string& encodedStr);
+		/// URI-encodes the given string by escaping reserved and non-ASCII
+		/// characters. The encoded string is appended to encodedStr.
+
+	static void decode(const StringRef& str, std::string& decodedStr, bool plusAsSpace = false);
+		/// URI-decodes the given string by replacing percent-encoded
+		/// characters with the actual character. The decoded string
+		/// is appended to decodedStr.
+		///
+		/// When plusAsSpace is true, non-encoded plus signs following
+		/// a question mark are decoded as spaces.
+
+	static void decodeQueryComponent(const StringRef& str, std::string& decodedStr);
+		/// URI-decodes a query parameter name or value, decoding
+		/// plus signs as spaces. The decoded string is appended
+		/// to decodedStr.
+
+	static unsigned short getWellKnownPort(const StringRef& scheme);
+		/// Returns the well-known port number for the given scheme,
+		/// or 0 if the port number is not known.
+
+private:
+	void clear();
+	void parseAuthority(const StringRef& authority);
+	void parseHostAndPort(const StringRef& hostAndPort);
+	void parsePathEtc(const StringRef& pathEtc);
+
+	StringRef      _uri;
+	StringRef      _scheme;
+	StringRef      _authority;
+	StringRef      _userInfo;
+	StringRef      _host;
+	unsigned short _port;        // port given in the URI, or 0
+	bool           _hasHostAndPort;
+	StringRef      _path;
+	StringRef      _query;
+	StringRef      _fragment;
+
+	friend class URI;
+};
+
+
+//
+// inlines
+//
+inline const URIRef::QueryParameter& URIRef::QueryIterator::operator * () const
+{
+	return _param;
+}
+
+
+inline const URIRef::QueryParameter* URIRef::QueryIterator::operator -> () const
+{
+	return &_param;
+}
+
+
+inline URIRef::QueryIterator& URIRef::QueryIterator::operator ++ ()
+{
+	next();
+	return *this;
+}
+
+
+inline URIRef::QueryIterator URIRef::QueryIterator::operator ++ (int)
+{
+	QueryIterator tmp(*this);
+	next();
+	return tmp;
+}
+
+
+inline bool URIRef::QueryIterator::operator == (const QueryIterator& other) const
+{
+	if (_end || other._end) return _end == other._end;
+	return _param.name.data() == other._param.name.data();
+}
+
+
+inline bool URIRef::QueryIterator::operator != (const QueryIterator& other) const
+{
+	return !(*this == other);
+}
+
+
+inline const StringRef& URIRef::getScheme() const
+{
+	return _scheme;
+}
+
+
+inline const StringRef& URIRef::getAuthority() const
+{
+	return _authority;
+}
+
+
+inline const StringRef& URIRef::getUserInfo() const
+{
+	return _userInfo;
+}
+
+
+inline const StringRef& URIRef::getHost() const
+{
+	return _host;
+}
+
+
+inline unsigned short URIRef::getPort() const
+{
+	return _port ? _port : getWellKnownPort(_scheme);
+}
+
+
+inline const StringRef& URIRef::getRawPath() const
+{
+	return _path;
+}
+
+
+inline const StringRef& URIRef::getRawQuery() const
+{
+	return _query;
+}
+
+
+inline const StringRef& URIRef::getRawFragment() const
+{
+	return _fragment;
+}
+
+
+inline URIRef::QueryIterator URIRef::queryBegin() const
+{
+	return QueryIterator(_query);
+}
+
+
+inline URIRef::QueryIterator URIRef::queryEnd() const
+{
+	return QueryIterator();
+}
+
+
+inline bool URIRef::isRelative() const
+{
+	return _scheme.empty();
+}
+
+
+inline bool URIRef::empty() const
+{
+	return _uri.empty();
+}
+
+
+inline const StringRef& URIRef::toStringRef() const
+{
+	return _uri;
+}
+
+
+} // namespace Poco
+
+
+#endif // Foundation_URIRef_INCLUDED
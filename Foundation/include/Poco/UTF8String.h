@@ -36,6 +36,8 @@ struct Foundation_API UTF8
 	///
 	/// removeBOM() removes the UTF-8 Byte Order Mark sequence (0xEF, 0xBB, 0xBF)
 	/// from the beginning of the given string, if it's there.
+	///
+	/// isValid() checks whether a string is well-formed UTF-8.
 {
 	static int icompare(const std::string& str, std::string::size_type pos, std::string::size_type n, std::string::const_iterator it2, std::string::const_iterator end2);
 	static int icompare(const std::string& str1, const std::string& str2);
@@ -74,6 +76,17 @@ struct Foundation_API UTF8
 
 	static std::string unescape(const std::string::const_iterator& begin, const std::string::const_iterator& end);
 		/// Creates an UTF8 string from a string that contains escaped characters.
+
+	static bool isValid(const std::string& str);
+		/// Returns true if str is well-formed UTF-8, i.e. contains no
+		/// invalid, overlong or truncated sequences, no surrogates and
+		/// no code points beyond U+10FFFF.
+
+	static bool isValid(const char* text, std::size_t length);
+		/// Returns true if the given character sequence is well-formed UTF-8.
+		///
+		/// The sequence is checked 16 or 32 bytes at a time with SSSE3 or AVX2
+		/// if the processor supports it.
 };
 
 
@@ -20,6 +20,8 @@
 
 #include "Poco/Foundation.h"
 #include "Poco/Types.h"
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 
@@ -83,37 +85,24 @@ struct UTF16CharTraits
 
 	static char_type* move(char_type* s1, const char_type* s2, std::size_t n)
 	{
-		char_type* r = s1;
-		if (s1 < s2)
-		{
-			for (; n; --n, ++s1, ++s2)
-				assign(*s1, *s2);
-		}
-		else if (s2 < s1)
-		{
-			s1 += n;
-			s2 += n;
-			for (; n; --n)
-				assign(*--s1, *--s2);
-		}
-		return r;
+		if (n) std::memmove(s1, s2, n*sizeof(char_type));
+		return s1;
 	}
 
 	static char_type* copy(char_type* s1, const char_type* s2, std::size_t n)
 	{
 		poco_assert(s2 < s1 || s2 >= s1 + n);
-		char_type* r = s1;
-		for (; n; --n, ++s1, ++s2)
-			assign(*s1, *s2);
-		return r;
+		if (n) std::memcpy(s1, s2, n*sizeof(char_type));
+		return s1;
 	}
 
 	static char_type* assign(char_type* s, std::size_t n, char_type a)
 	{
-		char_type* r = s;
-		for (; n; --n, ++s)
-			assign(*s, a);
-		return r;
+		if (a == 0)
+			std::memset(s, 0, n*sizeof(char_type)); // resize()
+		else
+			std::fill_n(s, n, a);
+		return s;
 	}
 
 	static int_type  not_eof(int_type c)
@@ -200,37 +189,24 @@ struct UTF32CharTraits
 
 	static char_type* move(char_type* s1, const char_type* s2, std::size_t n)
 	{
-		char_type* r = s1;
-		if (s1 < s2)
-		{
-			for (; n; --n, ++s1, ++s2)
-				assign(*s1, *s2);
-		}
-		else if (s2 < s1)
-		{
-			s1 += n;
-			s2 += n;
-			for (; n; --n)
-				assign(*--s1, *--s2);
-		}
-		return r;
+		if (n) std::memmove(s1, s2, n*sizeof(char_type));
+		return s1;
 	}
 
 	static char_type* copy(char_type* s1, const char_type* s2, std::size_t n)
 	{
 		poco_assert(s2 < s1 || s2 >= s1 + n);
-		char_type* r = s1;
-		for (; n; --n, ++s1, ++s2)
-			assign(*s1, *s2);
-		return r;
+		if (n) std::memcpy(s1, s2, n*sizeof(char_type));
+		return s1;
 	}
 
 	static char_type* assign(char_type* s, std::size_t n, char_type a)
 	{
-		char_type* r = s;
-		for (; n; --n, ++s)
-			assign(*s, a);
-		return r;
+		if (a == 0)
+			std::memset(s, 0, n*sizeof(char_type)); // resize()
+		else
+			std::fill_n(s, n, a);
+		return s;
 	}
 
 	static int_type  not_eof(int_type c)
@@ -48,8 +48,8 @@ public:
 		UUID_DCE_UID         = 0x02,
 		UUID_NAME_BASED      = 0x03,
 		UUID_RANDOM          = 0x04,
-		UUID_NAME_BASED_SHA1 = 0x05
-		
+		UUID_NAME_BASED_SHA1 = 0x05,
+		UUID_TIME_ORDERED    = 0x07  /// Unix time-based, version 7 in RFC 9562
 	};
 
 	UUID();
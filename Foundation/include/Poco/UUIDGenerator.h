@@ -69,6 +69,23 @@ public:
 		
 	UUID createRandom();
 		/// Creates a random UUID.
+		///
+		/// Random bytes are taken from a per-thread pool, which
+		/// is refilled from the operating system's random number
+		/// generator in batches, so no locking is required.
+
+	UUID createTimeOrdered();
+		/// Creates a time-ordered UUID (version 7, as specified in
+		/// RFC 9562), consisting of the number of milliseconds since
+		/// the Unix epoch, followed by a 12-bit counter and 62 random bits.
+		///
+		/// UUIDs created by the same thread are strictly increasing,
+		/// which makes them well suited as database keys. The counter
+		/// starts at a random value in every millisecond; if it overflows,
+		/// the time stamp is advanced by one millisecond. UUIDs created by
+		/// different threads are only ordered by their time stamps.
+		///
+		/// Like createRandom(), this method does not lock.
 		
 	UUID createOne();
 		/// Tries to create and return a time-based UUID (see create()), and, 
@@ -34,6 +34,17 @@ class Foundation_API UnicodeConverter
 	/// and probably won't be of much use anywhere else ???
 {
 public:
+	enum Encoding
+		/// Encodings supported by transcode().
+	{
+		ENCODING_LATIN1,        /// ISO 8859-1
+		ENCODING_UTF8,          /// UTF-8
+		ENCODING_UTF16,         /// UTF-16 in native byte order
+		ENCODING_UTF16_SWAPPED, /// UTF-16 in the other byte order
+		ENCODING_UTF32,         /// UTF-32 in native byte order
+		ENCODING_UTF32_SWAPPED  /// UTF-32 in the other byte order
+	};
+
 	static void convert(const std::string& utf8String, UTF32String& utf32String);
 		/// Converts the given UTF-8 encoded string into an UTF-32 encoded wide string.
 
@@ -70,6 +81,26 @@ public:
 	static void convert(const UTF32Char* utf32String, std::string& utf8String);
 		/// Converts the given UTF-32 encoded zero terminated character sequence into an UTF-8 encoded string.
 
+	static int transcode(Encoding inEncoding, const void* source, std::size_t length, Encoding outEncoding, void* destination, std::size_t& written, int defaultChar = '?');
+		/// Converts length bytes of source from inEncoding to outEncoding
+		/// and stores the result in destination, which must have room
+		/// for maxTranscodedLength() bytes. The number of bytes stored
+		/// is returned in written.
+		///
+		/// Invalid byte sequences, and characters that cannot be represented
+		/// in outEncoding, are replaced with defaultChar, exactly as
+		/// TextConverter does it.
+		///
+		/// Runs of ASCII characters are copied, widened or narrowed
+		/// 16 at a time with SSE2, where available.
+		///
+		/// Returns the number of encoding errors (invalid byte sequences
+		/// in source).
+
+	static std::size_t maxTranscodedLength(Encoding inEncoding, std::size_t length, Encoding outEncoding, int defaultChar = '?');
+		/// Returns the maximum number of bytes transcode() stores for
+		/// length bytes of input.
+
 	template <typename F, typename T>
 	static void toUTF32(const F& f, T& t)
 	{
@@ -0,0 +1,79 @@
+//
+// BinaryLogDecoder.cpp
+//
+// This sample demonstrates the BinaryLogReader class.
+// It converts log files written by a BinaryLogChannel to text.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogReader.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/Message.h"
+#include "Poco/FileStream.h"
+#include "Poco/Exception.h"
+#include <iostream>
+#include <vector>
+
+
+using Poco::BinaryLogReader;
+using Poco::PatternFormatter;
+using Poco::Message;
+using Poco::FileInputStream;
+
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cout << "usage: " << argv[0] << ": [-p pattern] [-l] file..." << std::endl
+		          << "       -p pattern  PatternFormatter pattern for the output" << std::endl
+		          << "       -l          show times in local time" << std::endl;
+		return 1;
+	}
+
+	std::string pattern("%Y-%m-%d %H:%M:%S.%i [%p] %s <%I>: %t");
+	bool local = false;
+	std::vector<std::string> files;
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg(argv[i]);
+		if (arg == "-p" && i + 1 < argc)
+			pattern = argv[++i];
+		else if (arg == "-l")
+			local = true;
+		else
+			files.push_back(arg);
+	}
+
+	PatternFormatter formatter(pattern);
+	if (local) formatter.setProperty(PatternFormatter::PROP_TIMES, "local");
+
+	try
+	{
+		std::string text;
+		for (std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it)
+		{
+			FileInputStream istr(*it);
+			BinaryLogReader reader(istr);
+			Message msg;
+			while (reader.read(msg))
+			{
+				text.clear();
+				formatter.format(msg, text);
+				std::cout << text << std::endl;
+			}
+		}
+	}
+	catch (Poco::Exception& exc)
+	{
+		std::cerr << exc.displayText() << std::endl;
+		return 2;
+	}
+
+	return 0;
+}
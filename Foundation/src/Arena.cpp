@@ -0,0 +1,120 @@
+//
+// Arena.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  Arena
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Arena.h"
+#include <new>
+
+
+namespace Poco {
+
+
+poco_static_assert((alignof(std::max_align_t) & (alignof(std::max_align_t) - 1)) == 0);
+
+
+const std::size_t Arena::MAX_ALIGNMENT = alignof(std::max_align_t);
+
+
+Arena::Arena(std::size_t blockSize):
+	_pCurrent(0),
+	_pEnd(0),
+	_pLast(0),
+	_pBlocks(0),
+	_pBuffer(0),
+	_bufferSize(0),
+	_blockSize(blockSize),
+	_allocated(0),
+	_capacity(0),
+	_blockCount(0)
+{
+	poco_assert (blockSize > 0);
+}
+
+
+Arena::Arena(void* pBuffer, std::size_t bufferSize, std::size_t blockSize):
+	_pCurrent(static_cast<char*>(pBuffer)),
+	_pEnd(static_cast<char*>(pBuffer) + bufferSize),
+	_pLast(0),
+	_pBlocks(0),
+	_pBuffer(static_cast<char*>(pBuffer)),
+	_bufferSize(bufferSize),
+	_blockSize(blockSize),
+	_allocated(0),
+	_capacity(bufferSize),
+	_blockCount(0)
+{
+	poco_check_ptr (pBuffer);
+	poco_assert (blockSize > 0);
+}
+
+
+Arena::~Arena()
+{
+	freeBlocks();
+}
+
+
+void* Arena::allocateSlow(std::size_t size, std::size_t alignment)
+{
+	// Block headers are a multiple of MAX_ALIGNMENT in size, so data
+	// following the header only needs extra room for larger alignments.
+	const std::size_t headerSize = ((sizeof(Block) + MAX_ALIGNMENT - 1)/MAX_ALIGNMENT)*MAX_ALIGNMENT;
+	const std::size_t extra = alignment > MAX_ALIGNMENT ? alignment : 0;
+	const bool dedicated = size + extra > _blockSize/2;
+	const std::size_t dataSize = dedicated ? size + extra : _blockSize;
+
+	Block* pBlock = static_cast<Block*>(::operator new(headerSize + dataSize));
+	pBlock->pNext = _pBlocks;
+	pBlock->size  = dataSize;
+	_pBlocks = pBlock;
+	_capacity += dataSize;
+	++_blockCount;
+
+	char* pData = reinterpret_cast<char*>(pBlock) + headerSize;
+	std::size_t misalign = reinterpret_cast<std::size_t>(pData) & (alignment - 1);
+	char* pResult = misalign ? pData + alignment - misalign : pData;
+	_allocated += size;
+	if (!dedicated)
+	{
+		_pLast    = pResult;
+		_pCurrent = pResult + size;
+		_pEnd     = pData + dataSize;
+	}
+	return pResult;
+}
+
+
+void Arena::reset()
+{
+	freeBlocks();
+	_pCurrent  = _pBuffer;
+	_pEnd      = _pBuffer ? _pBuffer + _bufferSize : 0;
+	_pLast     = 0;
+	_allocated = 0;
+	_capacity  = _bufferSize;
+}
+
+
+void Arena::freeBlocks()
+{
+	while (_pBlocks)
+	{
+		Block* pNext = _pBlocks->pNext;
+		::operator delete(_pBlocks);
+		_pBlocks = pNext;
+	}
+	_blockCount = 0;
+}
+
+
+} // namespace Poco
@@ -0,0 +1,158 @@
+//
+// Base32.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base32
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Base32.h"
+#include "Poco/Exception.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char ENCODING[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+
+	struct DecodingTable
+	{
+		DecodingTable()
+		{
+			std::memset(values, 0xFF, sizeof(values));
+			for (int i = 0; i < 32; ++i)
+			{
+				values[static_cast<unsigned char>(ENCODING[i])] = static_cast<unsigned char>(i);
+			}
+		}
+
+		unsigned char values[256];
+	};
+}
+
+
+std::size_t Base32::encode(const void* data, std::size_t length, char* encoded, bool padding)
+{
+	const unsigned char* in = static_cast<const unsigned char*>(data);
+	char* out = encoded;
+
+	std::size_t i = 0;
+	for (; length - i >= 5; i += 5)
+	{
+		// a 40-bit group yields 8 characters
+		UInt64 group = (static_cast<UInt64>(in[i]) << 32)
+		             | (static_cast<UInt64>(in[i + 1]) << 24)
+		             | (static_cast<UInt64>(in[i + 2]) << 16)
+		             | (static_cast<UInt64>(in[i + 3]) << 8)
+		             | in[i + 4];
+		out[0] = ENCODING[(group >> 35) & 0x1F];
+		out[1] = ENCODING[(group >> 30) & 0x1F];
+		out[2] = ENCODING[(group >> 25) & 0x1F];
+		out[3] = ENCODING[(group >> 20) & 0x1F];
+		out[4] = ENCODING[(group >> 15) & 0x1F];
+		out[5] = ENCODING[(group >> 10) & 0x1F];
+		out[6] = ENCODING[(group >> 5) & 0x1F];
+		out[7] = ENCODING[group & 0x1F];
+		out += 8;
+	}
+	std::size_t rest = length - i;
+	if (rest > 0)
+	{
+		static const int chars[] = {0, 2, 4, 5, 7};
+		UInt64 group = 0;
+		for (std::size_t k = 0; k < rest; ++k)
+		{
+			group |= static_cast<UInt64>(in[i + k]) << (32 - 8*k);
+		}
+		for (int k = 0; k < chars[rest]; ++k)
+		{
+			*out++ = ENCODING[(group >> (35 - 5*k)) & 0x1F];
+		}
+		if (padding)
+		{
+			for (int k = chars[rest]; k < 8; ++k) *out++ = '=';
+		}
+	}
+	return out - encoded;
+}
+
+
+std::string Base32::encode(const void* data, std::size_t length, bool padding)
+{
+	std::string result(encodedLength(length, padding), '\0');
+	if (!result.empty()) encode(data, length, &result[0], padding);
+	return result;
+}
+
+
+std::size_t Base32::decode(const char* encoded, std::size_t length, void* data)
+{
+	static const DecodingTable table;
+	unsigned char* out = static_cast<unsigned char*>(data);
+
+	while (length > 0 && encoded[length - 1] == '=') --length;
+
+	// per RFC 4648, Section 6, the last block has 2, 4, 5, 7 or 8 characters
+	static const int bytes[] = {0, -1, 1, -1, 2, 3, -1, 4};
+	std::size_t rest = length % 8;
+	if (bytes[rest] < 0) throw DataFormatException("Invalid Base32 encoding length");
+
+	std::size_t i = 0;
+	for (; length - i >= 8; i += 8)
+	{
+		UInt64 group = 0;
+		unsigned char invalid = 0;
+		for (int k = 0; k < 8; ++k)
+		{
+			unsigned char v = table.values[static_cast<unsigned char>(encoded[i + k])];
+			invalid |= v;
+			group = (group << 5) | (v & 0x1F);
+		}
+		if (invalid & 0x80) throw DataFormatException("Invalid Base32 character");
+		out[0] = static_cast<unsigned char>(group >> 32);
+		out[1] = static_cast<unsigned char>(group >> 24);
+		out[2] = static_cast<unsigned char>(group >> 16);
+		out[3] = static_cast<unsigned char>(group >> 8);
+		out[4] = static_cast<unsigned char>(group);
+		out += 5;
+	}
+	if (rest > 0)
+	{
+		UInt64 group = 0;
+		for (std::size_t k = 0; k < 8; ++k)
+		{
+			unsigned char v = k < rest ? table.values[static_cast<unsigned char>(encoded[i + k])] : 0;
+			if (v & 0x80) throw DataFormatException("Invalid Base32 character");
+			group = (group << 5) | v;
+		}
+		for (int k = 0; k < bytes[rest]; ++k)
+		{
+			*out++ = static_cast<unsigned char>(group >> (32 - 8*k));
+		}
+	}
+	return out - static_cast<unsigned char*>(data);
+}
+
+
+std::string Base32::decode(const std::string& encoded)
+{
+	std::string result(decodedLength(encoded.size()), '\0');
+	if (!result.empty())
+	{
+		result.resize(decode(encoded.data(), encoded.size(), &result[0]));
+	}
+	return result;
+}
+
+
+} // namespace Poco
@@ -13,6 +13,7 @@
 
 
 #include "Poco/Base32Encoder.h"
+#include "Poco/Base32.h"
 
 
 namespace Poco {
@@ -78,6 +79,33 @@ int Base32EncoderBuf::writeToDevice(char c)
 }
 
 
+std::streamsize Base32EncoderBuf::xsputn(const char* s, std::streamsize n)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	char buffer[BLOCK_SIZE/5*8];
+	std::streamsize written = 0;
+	while (written < n)
+	{
+		if (_groupLength > 0 || n - written < 5)
+		{
+			if (writeToDevice(s[written]) == eof) break;
+			++written;
+			continue;
+		}
+
+		// encode complete groups in one go
+		std::streamsize length = n - written;
+		if (length > BLOCK_SIZE) length = BLOCK_SIZE;
+		length -= length % 5;
+		std::streamsize encoded = static_cast<std::streamsize>(Base32::encode(s + written, static_cast<std::size_t>(length), buffer, _doPadding));
+		if (_buf.sputn(buffer, encoded) != encoded) break;
+		written += length;
+	}
+	return written;
+}
+
+
 int Base32EncoderBuf::close()
 {
 	static const int eof = std::char_traits<char>::eof();
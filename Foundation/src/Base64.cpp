@@ -0,0 +1,364 @@
+//
+// Base64.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  Base64
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Base64.h"
+#include "Poco/CPUFeatures.h"
+#include "Poco/Exception.h"
+#include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char ENCODING[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	const char ENCODING_URL[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+
+	struct DecodingTable
+	{
+		explicit DecodingTable(const char* encoding)
+		{
+			std::memset(values, 0xFF, sizeof(values));
+			for (int i = 0; i < 64; ++i)
+			{
+				values[static_cast<unsigned char>(encoding[i])] = static_cast<unsigned char>(i);
+			}
+		}
+
+		unsigned char values[256];
+	};
+
+
+	const unsigned char* decodingTable(int options)
+	{
+		static const DecodingTable table(ENCODING);
+		static const DecodingTable tableURL(ENCODING_URL);
+		return (options & BASE64_URL_ENCODING) ? tableURL.values : table.values;
+	}
+
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+
+	//
+	// The SIMD kernels follow W. Mula and D. Lemire,
+	// "Faster Base64 Encoding and Decoding Using AVX2 Instructions",
+	// ACM Transactions on the Web 12(3), 2018.
+	//
+
+
+	POCO_TARGET("ssse3")
+	inline __m128i encodeBlock(__m128i in, __m128i shiftLUT)
+	{
+		// split 3 bytes into 4 6-bit indices per 32-bit word
+		in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+		const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+		const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+		const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+		const __m128i indices = _mm_or_si128(t1, t3);
+
+		// translate indices to characters
+		__m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+		const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+		result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+		result = _mm_shuffle_epi8(shiftLUT, result);
+		return _mm_add_epi8(result, indices);
+	}
+
+
+	POCO_TARGET("ssse3")
+	std::size_t encodeSSSE3(const unsigned char* in, std::size_t length, char* out, bool url)
+	{
+		const __m128i shiftLUT = _mm_setr_epi8(
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63, 'A', 0, 0);
+
+		std::size_t i = 0;
+		for (; length - i >= 16; i += 12, out += 16)
+		{
+			__m128i in16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), encodeBlock(in16, shiftLUT));
+		}
+		return i;
+	}
+
+
+	POCO_TARGET("avx2")
+	std::size_t encodeAVX2(const unsigned char* in, std::size_t length, char* out, bool url)
+	{
+		const __m256i shiftLUT = _mm256_setr_epi8(
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63, 'A', 0, 0,
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, url ? '-' - 62 : '+' - 62, url ? '_' - 63 : '/' - 63, 'A', 0, 0);
+		const __m256i shuffle = _mm256_set_epi8(
+			10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+			10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+
+		std::size_t i = 0;
+		for (; length - i >= 28; i += 24, out += 32)
+		{
+			// each 128-bit lane gets 12 input bytes
+			__m256i in32 = _mm256_inserti128_si256(
+				_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+			in32 = _mm256_shuffle_epi8(in32, shuffle);
+			const __m256i t0 = _mm256_and_si256(in32, _mm256_set1_epi32(0x0FC0FC00));
+			const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+			const __m256i t2 = _mm256_and_si256(in32, _mm256_set1_epi32(0x003F03F0));
+			const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+			const __m256i indices = _mm256_or_si256(t1, t3);
+
+			__m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+			const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+			result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+			result = _mm256_shuffle_epi8(shiftLUT, result);
+			result = _mm256_add_epi8(result, indices);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+		}
+		return i;
+	}
+
+
+	POCO_TARGET("ssse3")
+	std::size_t decodeSSSE3(const char* in, std::size_t length, unsigned char* out)
+	{
+		const __m128i lutLo = _mm_setr_epi8(
+			0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+			0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m128i lutHi = _mm_setr_epi8(
+			0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+			0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m128i lutRoll = _mm_setr_epi8(
+			0, 16, 19, 4, -65, -65, -71, -71,
+			0, 0, 0, 0, 0, 0, 0, 0);
+		const __m128i mask2F = _mm_set1_epi8(0x2F);
+
+		std::size_t i = 0;
+		// 16 characters are decoded into 12 bytes, but 16 bytes are stored
+		for (; length - i >= 24; i += 16, out += 12)
+		{
+			const __m128i in16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+			const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in16, 4), mask2F);
+			const __m128i loNibbles = _mm_and_si128(in16, mask2F);
+			const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+			const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+			if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0)
+				break;
+
+			const __m128i eq2F = _mm_cmpeq_epi8(in16, mask2F);
+			const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+			const __m128i values = _mm_add_epi8(in16, roll);
+
+			const __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+			const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+			const __m128i result = _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+		}
+		return i;
+	}
+
+
+	POCO_TARGET("avx2")
+	std::size_t decodeAVX2(const char* in, std::size_t length, unsigned char* out)
+	{
+		const __m256i lutLo = _mm256_setr_epi8(
+			0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+			0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+			0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+			0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+		const __m256i lutHi = _mm256_setr_epi8(
+			0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+			0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+			0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+			0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+		const __m256i lutRoll = _mm256_setr_epi8(
+			0, 16, 19, 4, -65, -65, -71, -71,
+			0, 0, 0, 0, 0, 0, 0, 0,
+			0, 16, 19, 4, -65, -65, -71, -71,
+			0, 0, 0, 0, 0, 0, 0, 0);
+		const __m256i mask2F = _mm256_set1_epi8(0x2F);
+		const __m256i shuffle = _mm256_setr_epi8(
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+		std::size_t i = 0;
+		// 32 characters are decoded into 24 bytes, but 32 bytes are stored
+		for (; length - i >= 48; i += 32, out += 24)
+		{
+			const __m256i in32 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+			const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(in32, 4), mask2F);
+			const __m256i loNibbles = _mm256_and_si256(in32, mask2F);
+			const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+			const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+			if (!_mm256_testz_si256(lo, hi))
+				break;
+
+			const __m256i eq2F = _mm256_cmpeq_epi8(in32, mask2F);
+			const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+			const __m256i values = _mm256_add_epi8(in32, roll);
+
+			const __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+			__m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+			packed = _mm256_shuffle_epi8(packed, shuffle);
+			packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+		}
+		return i;
+	}
+
+
+#endif // POCO_HAVE_X86_INTRINSICS
+}
+
+
+std::size_t Base64::encode(const void* data, std::size_t length, char* encoded, int options)
+{
+	const unsigned char* in = static_cast<const unsigned char*>(data);
+	const char* encoding = (options & BASE64_URL_ENCODING) ? ENCODING_URL : ENCODING;
+	char* out = encoded;
+
+	std::size_t i = 0;
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	if (CPUFeatures::hasAVX2())
+	{
+		i = encodeAVX2(in, length, out, (options & BASE64_URL_ENCODING) != 0);
+		out += i/3*4;
+	}
+	if (CPUFeatures::hasSSSE3())
+	{
+		std::size_t n = encodeSSSE3(in + i, length - i, out, (options & BASE64_URL_ENCODING) != 0);
+		i += n;
+		out += n/3*4;
+	}
+#endif
+	for (; length - i >= 3; i += 3)
+	{
+		UInt32 group = (static_cast<UInt32>(in[i]) << 16) | (static_cast<UInt32>(in[i + 1]) << 8) | in[i + 2];
+		*out++ = encoding[group >> 18];
+		*out++ = encoding[(group >> 12) & 0x3F];
+		*out++ = encoding[(group >> 6) & 0x3F];
+		*out++ = encoding[group & 0x3F];
+	}
+	if (length - i == 1)
+	{
+		*out++ = encoding[in[i] >> 2];
+		*out++ = encoding[(in[i] & 0x03) << 4];
+		if (!(options & BASE64_NO_PADDING))
+		{
+			*out++ = '=';
+			*out++ = '=';
+		}
+	}
+	else if (length - i == 2)
+	{
+		*out++ = encoding[in[i] >> 2];
+		*out++ = encoding[((in[i] & 0x03) << 4) | (in[i + 1] >> 4)];
+		*out++ = encoding[(in[i + 1] & 0x0F) << 2];
+		if (!(options & BASE64_NO_PADDING))
+		{
+			*out++ = '=';
+		}
+	}
+	return out - encoded;
+}
+
+
+std::string Base64::encode(const void* data, std::size_t length, int options)
+{
+	std::string result(encodedLength(length, options), '\0');
+	if (!result.empty()) encode(data, length, &result[0], options);
+	return result;
+}
+
+
+std::size_t Base64::decode(const char* encoded, std::size_t length, void* data, int options)
+{
+	const unsigned char* table = decodingTable(options);
+	unsigned char* out = static_cast<unsigned char*>(data);
+
+	if (!(options & BASE64_NO_PADDING) && length % 4 != 0)
+		throw DataFormatException("Incomplete Base64 encoding");
+	if (length > 0 && encoded[length - 1] == '=')
+	{
+		--length;
+		if (length > 0 && encoded[length - 1] == '=') --length;
+		if (length % 4 < 2) throw DataFormatException("Invalid Base64 padding");
+	}
+
+	std::size_t i = 0;
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	if (!(options & BASE64_URL_ENCODING))
+	{
+		if (CPUFeatures::hasAVX2())
+		{
+			i = decodeAVX2(encoded, length, out);
+			out += i/4*3;
+		}
+		if (CPUFeatures::hasSSSE3())
+		{
+			std::size_t n = decodeSSSE3(encoded + i, length - i, out);
+			i += n;
+			out += n/4*3;
+		}
+	}
+#endif
+	for (; length - i >= 4; i += 4)
+	{
+		UInt32 a = table[static_cast<unsigned char>(encoded[i])];
+		UInt32 b = table[static_cast<unsigned char>(encoded[i + 1])];
+		UInt32 c = table[static_cast<unsigned char>(encoded[i + 2])];
+		UInt32 d = table[static_cast<unsigned char>(encoded[i + 3])];
+		if ((a | b | c | d) & 0x80) throw DataFormatException("Invalid Base64 character");
+		UInt32 group = (a << 18) | (b << 12) | (c << 6) | d;
+		*out++ = static_cast<unsigned char>(group >> 16);
+		*out++ = static_cast<unsigned char>(group >> 8);
+		*out++ = static_cast<unsigned char>(group);
+	}
+	std::size_t rest = length - i;
+	if (rest == 1)
+	{
+		throw DataFormatException("Incomplete Base64 encoding");
+	}
+	else if (rest > 1)
+	{
+		UInt32 a = table[static_cast<unsigned char>(encoded[i])];
+		UInt32 b = table[static_cast<unsigned char>(encoded[i + 1])];
+		UInt32 c = rest == 3 ? table[static_cast<unsigned char>(encoded[i + 2])] : 0;
+		if ((a | b | c) & 0x80) throw DataFormatException("Invalid Base64 character");
+		*out++ = static_cast<unsigned char>((a << 2) | (b >> 4));
+		if (rest == 3) *out++ = static_cast<unsigned char>((b << 4) | (c >> 2));
+	}
+	return out - static_cast<unsigned char*>(data);
+}
+
+
+std::string Base64::decode(const std::string& encoded, int options)
+{
+	std::string result(decodedLength(encoded.size()), '\0');
+	if (!result.empty())
+	{
+		result.resize(decode(encoded.data(), encoded.size(), &result[0], options));
+	}
+	return result;
+}
+
+
+} // namespace Poco
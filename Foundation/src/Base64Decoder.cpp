@@ -14,6 +14,7 @@
 
 #include "Poco/Base64Decoder.h"
 #include "Poco/Base64Encoder.h"
+#include "Poco/Base64.h"
 #include "Poco/Exception.h"
 #include "Poco/Mutex.h"
 
@@ -148,6 +149,87 @@ int Base64DecoderBuf::readOne()
 }
 
 
+std::streamsize Base64DecoderBuf::xsgetn(char* s, std::streamsize n)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (n <= 0) return 0;
+
+	// the first character goes through uflow(), which takes care
+	// of a character that has been peeked at or put back
+	int c = uflow();
+	if (c == eof) return 0;
+	s[0] = static_cast<char>(c);
+	std::streamsize copied = 1;
+	while (copied < n && _groupIndex < _groupLength)
+	{
+		s[copied++] = static_cast<char>(_group[_groupIndex++]);
+	}
+
+	// decode complete groups in blocks, reading no further
+	// ahead than the group-wise decoding would
+	char buffer[BLOCK_SIZE];
+	while (n - copied >= 3)
+	{
+		std::streamsize groups = (n - copied)/3;
+		if (groups > BLOCK_SIZE/4) groups = BLOCK_SIZE/4;
+		std::size_t requested = static_cast<std::size_t>(4*groups);
+		std::size_t length = readEncoded(buffer, requested);
+		if (length < requested)
+		{
+			// end of input: ignore a dangling character, like readFromDevice()
+			if (length % 4 == 1) --length;
+			else if (length % 4 != 0 && !(_options & BASE64_NO_PADDING)) throw DataFormatException();
+		}
+
+		// a padded group ends the data passed to Base64::decode()
+		std::size_t pos = 0;
+		while (pos < length)
+		{
+			std::size_t end = pos;
+			while (end < length && buffer[end] != '=') ++end;
+			if (end < length) end = (end/4 + 1)*4;
+			if (end > length) end = length;
+			copied += static_cast<std::streamsize>(Base64::decode(buffer + pos, end - pos, s + copied, _options | BASE64_NO_PADDING));
+			pos = end;
+		}
+		if (length < requested) return copied;
+	}
+	while (copied < n)
+	{
+		c = readFromDevice();
+		if (c == eof) break;
+		s[copied++] = static_cast<char>(c);
+	}
+	return copied;
+}
+
+
+std::size_t Base64DecoderBuf::readEncoded(char* buffer, std::size_t length)
+{
+	std::size_t n = 0;
+	while (n < length)
+	{
+		std::streamsize got = _buf.sgetn(buffer + n, static_cast<std::streamsize>(length - n));
+		if (got <= 0) break;
+		if (_options & BASE64_URL_ENCODING)
+		{
+			n += static_cast<std::size_t>(got);
+		}
+		else
+		{
+			const char* end = buffer + n + got;
+			for (const char* p = buffer + n; p < end; ++p)
+			{
+				char ch = *p;
+				if (ch != ' ' && ch != '\r' && ch != '\t' && ch != '\n') buffer[n++] = ch;
+			}
+		}
+	}
+	return n;
+}
+
+
 Base64DecoderIOS::Base64DecoderIOS(std::istream& istr, int options): _buf(istr, options)
 {
 	poco_ios_init(&_buf);
@@ -13,6 +13,7 @@
 
 
 #include "Poco/Base64Encoder.h"
+#include "Poco/Base64.h"
 
 
 namespace Poco {
@@ -108,6 +109,46 @@ int Base64EncoderBuf::writeToDevice(char c)
 }
 
 
+std::streamsize Base64EncoderBuf::xsputn(const char* s, std::streamsize n)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	char buffer[BLOCK_SIZE/3*4];
+	std::streamsize written = 0;
+	while (written < n)
+	{
+		if (_groupLength > 0 || n - written < 3)
+		{
+			if (writeToDevice(s[written]) == eof) break;
+			++written;
+			continue;
+		}
+
+		// encode complete groups up to the end of the line in one go
+		std::streamsize length = n - written;
+		if (length > BLOCK_SIZE) length = BLOCK_SIZE;
+		if (_lineLength > 0)
+		{
+			std::streamsize groupsPerLine = (_lineLength - _pos + 3)/4;
+			if (groupsPerLine < 1) groupsPerLine = 1;
+			if (length > 3*groupsPerLine) length = 3*groupsPerLine;
+		}
+		length -= length % 3;
+		std::streamsize encoded = static_cast<std::streamsize>(Base64::encode(s + written, static_cast<std::size_t>(length), buffer, _options));
+		if (_buf.sputn(buffer, encoded) != encoded) break;
+		written += length;
+		_pos += static_cast<int>(encoded);
+		if (_lineLength > 0 && _pos >= _lineLength)
+		{
+			if (_buf.sputc('\r') == eof) break;
+			if (_buf.sputc('\n') == eof) break;
+			_pos = 0;
+		}
+	}
+	return written;
+}
+
+
 int Base64EncoderBuf::close()
 {
 	static const int eof = std::char_traits<char>::eof();
@@ -0,0 +1,346 @@
+//
+// BinaryLogChannel.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogChannel.h"
+#include "Poco/Message.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Ascii.h"
+#include "Poco/Exception.h"
+#include <vector>
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	template <typename T>
+	inline void put(char*& p, T value)
+	{
+		std::memcpy(p, &value, sizeof(value));
+		p += sizeof(value);
+	}
+
+	inline void putString(char*& p, const char* str, std::size_t length)
+	{
+		std::memcpy(p, str, length);
+		p += length;
+	}
+}
+
+
+const std::string BinaryLogChannel::PROP_PATH       = "path";
+const std::string BinaryLogChannel::PROP_ROTATION   = "rotation";
+const std::string BinaryLogChannel::PROP_PURGECOUNT = "purgeCount";
+
+
+BinaryLogChannel::BinaryLogChannel():
+	_rotation(DEFAULT_ROTATION),
+	_purgeCount(0),
+	_archiveIndex(-1),
+	_pBegin(0),
+	_pPos(0),
+	_pEnd(0),
+	_nextId(1)
+{
+}
+
+
+BinaryLogChannel::BinaryLogChannel(const std::string& path):
+	_path(path),
+	_rotation(DEFAULT_ROTATION),
+	_purgeCount(0),
+	_archiveIndex(-1),
+	_pBegin(0),
+	_pPos(0),
+	_pEnd(0),
+	_nextId(1)
+{
+}
+
+
+BinaryLogChannel::~BinaryLogChannel()
+{
+	try
+	{
+		close();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void BinaryLogChannel::open()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	unsafeOpen(0);
+}
+
+
+void BinaryLogChannel::close()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	unsafeClose();
+}
+
+
+void BinaryLogChannel::log(const Message& msg)
+{
+	const std::string& source = msg.getSource();
+	const std::string& thread = msg.getThread();
+	const std::string& text = msg.getText();
+	const char* file = msg.getSourceFile();
+	const Message::StringMap& params = msg.getAll();
+
+	std::size_t recordSize = RECORD_HEADER_SIZE + MESSAGE_FIXED_SIZE + text.size();
+	for (Message::StringMap::const_iterator it = params.begin(); it != params.end(); ++it)
+	{
+		recordSize += 8 + it->first.size() + it->second.size();
+	}
+	// worst case: all interned strings must be defined
+	std::size_t needed = recordSize + 3*(RECORD_HEADER_SIZE + 4) + source.size() + thread.size() + (file ? std::strlen(file) : 0);
+
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (!_pBegin)
+		unsafeOpen(needed);
+	else if (needed > static_cast<std::size_t>(_pEnd - _pPos))
+		rotate(needed);
+
+	UInt32 sourceId = intern(_sources, source, RECORD_SOURCE);
+	UInt32 threadId = thread.empty() ? 0 : intern(_threads, thread, RECORD_THREAD);
+	UInt32 fileId = file ? internFile(file) : 0;
+
+	char* p = _pPos;
+	put<UInt32>(p, static_cast<UInt32>(recordSize));
+	put<UInt8>(p, RECORD_MESSAGE);
+	put<Int64>(p, msg.getTime().epochMicroseconds());
+	put<UInt8>(p, static_cast<UInt8>(msg.getPriority()));
+	put<UInt32>(p, sourceId);
+	put<UInt32>(p, threadId);
+	put<Int64>(p, msg.getTid());
+	put<Int64>(p, msg.getPid());
+	put<UInt32>(p, fileId);
+	put<Int32>(p, msg.getSourceLine());
+	put<UInt32>(p, static_cast<UInt32>(text.size()));
+	put<UInt16>(p, static_cast<UInt16>(params.size()));
+	putString(p, text.data(), text.size());
+	for (Message::StringMap::const_iterator it = params.begin(); it != params.end(); ++it)
+	{
+		put<UInt32>(p, static_cast<UInt32>(it->first.size()));
+		putString(p, it->first.data(), it->first.size());
+		put<UInt32>(p, static_cast<UInt32>(it->second.size()));
+		putString(p, it->second.data(), it->second.size());
+	}
+	poco_assert_dbg (p == _pPos + recordSize);
+	_pPos = p;
+}
+
+
+void BinaryLogChannel::setProperty(const std::string& name, const std::string& value)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (name == PROP_PATH)
+	{
+		_path = value;
+	}
+	else if (name == PROP_ROTATION)
+	{
+		std::string::const_iterator it  = value.begin();
+		std::string::const_iterator end = value.end();
+		std::size_t n = 0;
+		while (it != end && Ascii::isSpace(*it)) ++it;
+		while (it != end && Ascii::isDigit(*it)) { n *= 10; n += *it++ - '0'; }
+		while (it != end && Ascii::isSpace(*it)) ++it;
+		std::string unit;
+		while (it != end && Ascii::isAlpha(*it)) unit += *it++;
+
+		if (unit == "K")
+			n *= 1024;
+		else if (unit == "M")
+			n *= 1024*1024;
+		else if (!unit.empty())
+			throw InvalidArgumentException("rotation", value);
+		if (n < 1024)
+			throw InvalidArgumentException("rotation", value);
+
+		_rotation = n;
+	}
+	else if (name == PROP_PURGECOUNT)
+	{
+		if (value.empty() || value == "none")
+			_purgeCount = 0;
+		else
+			_purgeCount = NumberParser::parse(value);
+		if (_purgeCount < 0)
+			throw InvalidArgumentException("purgeCount", value);
+	}
+	else Channel::setProperty(name, value);
+}
+
+
+std::string BinaryLogChannel::getProperty(const std::string& name) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (name == PROP_PATH)
+		return _path;
+	else if (name == PROP_ROTATION)
+		return NumberFormatter::format(_rotation);
+	else if (name == PROP_PURGECOUNT)
+		return _purgeCount > 0 ? NumberFormatter::format(_purgeCount) : std::string("none");
+	else
+		return Channel::getProperty(name);
+}
+
+
+UInt64 BinaryLogChannel::size() const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	return _pBegin ? static_cast<UInt64>(_pPos - _pBegin) : 0;
+}
+
+
+void BinaryLogChannel::unsafeOpen(std::size_t minSize)
+{
+	if (_pBegin) return;
+	if (_path.empty()) throw PropertyNotSupportedException("BinaryLogChannel requires a path");
+
+	File file(_path);
+	if (file.exists() && file.getSize() > 0)
+	{
+		// never overwrite the log file of a previous run
+		rotate(minSize);
+		return;
+	}
+
+	std::size_t size = _rotation;
+	if (size < minSize + FILE_HEADER_SIZE) size = minSize + FILE_HEADER_SIZE;
+	file.createFile();
+	file.setSize(size);
+	_memory = SharedMemory(file, SharedMemory::AM_WRITE);
+	_pBegin = _memory.begin();
+	_pEnd   = _memory.end();
+	_pPos   = _pBegin;
+
+	put<UInt32>(_pPos, FILE_MAGIC);
+	put<UInt16>(_pPos, FILE_VERSION);
+	put<UInt16>(_pPos, 0xFEFF);
+
+	_sources.clear();
+	_threads.clear();
+	_files.clear();
+	_nextId = 1;
+}
+
+
+void BinaryLogChannel::unsafeClose()
+{
+	if (!_pBegin) return;
+
+	File::FileSize size = _pPos - _pBegin;
+	_memory = SharedMemory();
+	_pBegin = _pPos = _pEnd = 0;
+	File(_path).setSize(size);
+}
+
+
+void BinaryLogChannel::rotate(std::size_t minSize)
+{
+	unsafeClose();
+
+	if (_archiveIndex < 0)
+	{
+		// continue after the highest number of existing archived files
+		Path path(_path);
+		path.makeAbsolute();
+		std::string prefix = path.getFileName() + ".";
+		std::vector<std::string> files;
+		File(path.parent()).list(files);
+		_archiveIndex = 0;
+		for (std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it)
+		{
+			unsigned n;
+			if (it->compare(0, prefix.size(), prefix) == 0 && NumberParser::tryParseUnsigned(it->substr(prefix.size()), n) && static_cast<int>(n) >= _archiveIndex)
+				_archiveIndex = static_cast<int>(n) + 1;
+		}
+	}
+	File(_path).renameTo(_path + "." + NumberFormatter::format(_archiveIndex++));
+	purge();
+
+	unsafeOpen(minSize);
+}
+
+
+void BinaryLogChannel::purge()
+{
+	if (_purgeCount <= 0) return;
+
+	for (int n = _archiveIndex - 1 - _purgeCount; n >= 0; --n)
+	{
+		File file(_path + "." + NumberFormatter::format(n));
+		if (!file.exists()) break;
+		file.remove();
+	}
+}
+
+
+UInt32 BinaryLogChannel::intern(FlatHashMap<std::string, UInt32>& table, const std::string& str, RecordType type)
+{
+	FlatHashMap<std::string, UInt32>::const_iterator it = table.find(str);
+	if (it != table.end()) return it->second;
+
+	UInt32 id = _nextId++;
+	table[str] = id;
+	writeDefinition(type, id, str.data(), str.size());
+	return id;
+}
+
+
+UInt32 BinaryLogChannel::internFile(const char* file)
+{
+	// source file names are static strings, so they are interned by address
+	UInt64 key = reinterpret_cast<UIntPtr>(file);
+	FlatHashMap<UInt64, UInt32>::const_iterator it = _files.find(key);
+	if (it != _files.end()) return it->second;
+
+	UInt32 id = _nextId++;
+	_files[key] = id;
+	writeDefinition(RECORD_FILE, id, file, std::strlen(file));
+	return id;
+}
+
+
+void BinaryLogChannel::writeDefinition(RecordType type, UInt32 id, const char* str, std::size_t length)
+{
+	char* p = _pPos;
+	put<UInt32>(p, static_cast<UInt32>(RECORD_HEADER_SIZE + 4 + length));
+	put<UInt8>(p, static_cast<UInt8>(type));
+	put<UInt32>(p, id);
+	putString(p, str, length);
+	_pPos = p;
+}
+
+
+} // namespace Poco
@@ -0,0 +1,147 @@
+//
+// BinaryLogReader.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  BinaryLogChannel
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/BinaryLogReader.h"
+#include "Poco/BinaryLogChannel.h"
+#include "Poco/Message.h"
+#include "Poco/ByteOrder.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+BinaryLogReader::BinaryLogReader(std::istream& istr):
+	_pReader(0),
+	_version(0)
+{
+	UInt32 magic = 0;
+	istr.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	if (!istr.good()) throw DataFormatException("Not a binary log file");
+
+	BinaryReader::StreamByteOrder order = BinaryReader::NATIVE_BYTE_ORDER;
+	if (magic != BinaryLogChannel::FILE_MAGIC)
+	{
+		if (ByteOrder::flipBytes(magic) != BinaryLogChannel::FILE_MAGIC)
+			throw DataFormatException("Not a binary log file");
+#if defined(POCO_ARCH_BIG_ENDIAN)
+		order = BinaryReader::LITTLE_ENDIAN_BYTE_ORDER;
+#else
+		order = BinaryReader::BIG_ENDIAN_BYTE_ORDER;
+#endif
+	}
+	_pReader = new BinaryReader(istr, order);
+
+	UInt16 version = 0;
+	UInt16 bom = 0;
+	*_pReader >> version >> bom;
+	_version = version;
+	if (_version != BinaryLogChannel::FILE_VERSION)
+	{
+		delete _pReader;
+		throw DataFormatException("Unsupported binary log file version", NumberFormatter::format(_version));
+	}
+}
+
+
+BinaryLogReader::~BinaryLogReader()
+{
+	delete _pReader;
+}
+
+
+bool BinaryLogReader::read(Message& msg)
+{
+	BinaryReader& reader = *_pReader;
+	for (;;)
+	{
+		UInt32 size = 0;
+		UInt8 type = 0;
+		reader >> size;
+		if (!reader.good() || size == 0) return false;
+		if (size < BinaryLogChannel::RECORD_HEADER_SIZE) throw DataFormatException("Invalid record size in binary log file");
+		reader >> type;
+
+		switch (type)
+		{
+		case BinaryLogChannel::RECORD_MESSAGE:
+			{
+				Int64 time;
+				UInt8 prio;
+				UInt32 sourceId;
+				UInt32 threadId;
+				Int64 tid;
+				Int64 pid;
+				UInt32 fileId;
+				Int32 line;
+				UInt32 textSize;
+				UInt16 paramCount;
+				reader >> time >> prio >> sourceId >> threadId >> tid >> pid >> fileId >> line >> textSize >> paramCount;
+				if (prio < Message::PRIO_FATAL || prio > Message::PRIO_TRACE) throw DataFormatException("Invalid message priority in binary log file");
+
+				Message m;
+				m.setTime(Timestamp(time));
+				m.setPriority(static_cast<Message::Priority>(prio));
+				m.setSource(lookup(sourceId));
+				if (threadId) m.setThread(lookup(threadId));
+				m.setTid(static_cast<long>(tid));
+				m.setPid(static_cast<long>(pid));
+				if (fileId) m.setSourceFile(lookup(fileId).c_str());
+				m.setSourceLine(line);
+				reader.readRaw(textSize, _buffer);
+				m.setText(_buffer);
+				for (UInt16 i = 0; i < paramCount; ++i)
+				{
+					UInt32 length;
+					std::string name;
+					reader >> length;
+					reader.readRaw(length, name);
+					reader >> length;
+					reader.readRaw(length, _buffer);
+					m.set(name, _buffer);
+				}
+				if (!reader.good()) return false;
+				swap(msg, m);
+				return true;
+			}
+		case BinaryLogChannel::RECORD_SOURCE:
+		case BinaryLogChannel::RECORD_THREAD:
+		case BinaryLogChannel::RECORD_FILE:
+			{
+				UInt32 id;
+				reader >> id;
+				reader.readRaw(size - BinaryLogChannel::RECORD_HEADER_SIZE - 4, _strings[id]);
+			}
+			break;
+		default:
+			// skip records of unknown type
+			reader.readRaw(size - BinaryLogChannel::RECORD_HEADER_SIZE, _buffer);
+			break;
+		}
+	}
+}
+
+
+const std::string& BinaryLogReader::lookup(UInt32 id) const
+{
+	StringMap::const_iterator it = _strings.find(id);
+	if (it != _strings.end())
+		return it->second;
+	else
+		throw DataFormatException("Undefined string ID in binary log file", NumberFormatter::format(id));
+}
+
+
+} // namespace Poco
@@ -0,0 +1,97 @@
+//
+// CPUFeatures.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  CPUFeatures
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/CPUFeatures.h"
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+namespace Poco {
+
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+
+namespace
+{
+	void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4])
+	{
+#if defined(_MSC_VER)
+		int r[4];
+		__cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+		for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(r[i]);
+#else
+		__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+	}
+
+
+	UInt64 xgetbv()
+	{
+#if defined(_MSC_VER)
+		return _xgetbv(0);
+#else
+		unsigned eax, edx;
+		__asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+		return (static_cast<UInt64>(edx) << 32) | eax;
+#endif
+	}
+}
+
+
+int CPUFeatures::detect()
+{
+	unsigned regs[4];
+	cpuid(0, 0, regs);
+	unsigned maxLeaf = regs[0];
+	if (maxLeaf < 1) return 0;
+
+	int result = 0;
+	cpuid(1, 0, regs);
+	unsigned ecx = regs[2];
+	if (ecx & (1u << 9))  result |= FEATURE_SSSE3;
+	if (ecx & (1u << 20)) result |= FEATURE_SSE42;
+	if (ecx & (1u << 1))  result |= FEATURE_PCLMUL;
+
+	// AVX registers are only usable if the OS saves them (OSXSAVE, XCR0 bits 1 and 2)
+	bool avxState = (ecx & (1u << 27)) && (ecx & (1u << 28)) && (xgetbv() & 0x06) == 0x06;
+	if (maxLeaf >= 7)
+	{
+		cpuid(7, 0, regs);
+		unsigned ebx = regs[1];
+		if (avxState && (ebx & (1u << 5))) result |= FEATURE_AVX2;
+		if (ebx & (1u << 29)) result |= FEATURE_SHA;
+	}
+	return result;
+}
+
+
+#else
+
+
+int CPUFeatures::detect()
+{
+	return 0;
+}
+
+
+#endif
+
+
+} // namespace Poco
@@ -13,31 +13,485 @@
 
 
 #include "Poco/Checksum.h"
+#include "Poco/CPUFeatures.h"
+#include "Poco/ByteOrder.h"
 #if defined(POCO_UNBUNDLED)
 #include <zlib.h>
 #else
 #include "Poco/zlib.h"
 #endif
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+#include <algorithm>
+#include <cstring>
 
 
 namespace Poco {
 
 
+namespace
+{
+	template <typename T>
+	inline T load(const unsigned char* p)
+	{
+		T v;
+		std::memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+
+	class CRC32CTable
+		/// Lookup tables for the slicing-by-8 computation
+		/// of CRC-32C (Castagnoli polynomial).
+	{
+	public:
+		CRC32CTable()
+		{
+			for (UInt32 i = 0; i < 256; ++i)
+			{
+				UInt32 crc = i;
+				for (int k = 0; k < 8; ++k)
+					crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+				table[0][i] = crc;
+			}
+			for (UInt32 i = 0; i < 256; ++i)
+			{
+				for (int t = 1; t < 8; ++t)
+					table[t][i] = (table[t - 1][i] >> 8) ^ table[0][table[t - 1][i] & 0xFF];
+			}
+		}
+
+		UInt32 table[8][256];
+	};
+
+
+	UInt32 crc32cSlicing(UInt32 crc, const unsigned char* data, std::size_t length)
+	{
+		static const CRC32CTable tables;
+		const UInt32 (&t)[8][256] = tables.table;
+
+		crc = ~crc;
+		while (length >= 8)
+		{
+			UInt32 lo;
+			UInt32 hi;
+			std::memcpy(&lo, data, 4);
+			std::memcpy(&hi, data + 4, 4);
+#if defined(POCO_ARCH_BIG_ENDIAN)
+			lo = ByteOrder::flipBytes(lo);
+			hi = ByteOrder::flipBytes(hi);
+#endif
+			lo ^= crc;
+			crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+				^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+			data += 8;
+			length -= 8;
+		}
+		while (length--)
+		{
+			crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+		}
+		return ~crc;
+	}
+
+
+	UInt32 crc32Zlib(UInt32 crc, const unsigned char* data, std::size_t length)
+	{
+		while (length > 0)
+		{
+			uInt n = length > 0x40000000 ? 0x40000000 : static_cast<uInt>(length);
+			crc = static_cast<UInt32>(crc32(crc, data, n));
+			data += n;
+			length -= n;
+		}
+		return crc;
+	}
+
+
+	UInt32 adler32Zlib(UInt32 adler, const unsigned char* data, std::size_t length)
+	{
+		while (length > 0)
+		{
+			uInt n = length > 0x40000000 ? 0x40000000 : static_cast<uInt>(length);
+			adler = static_cast<UInt32>(adler32(adler, data, n));
+			data += n;
+			length -= n;
+		}
+		return adler;
+	}
+
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+
+	POCO_TARGET("sse4.2,pclmul")
+	UInt32 crc32PCLMUL(UInt32 crc, const unsigned char* data, std::size_t length)
+		/// Computes CRC-32 over length bytes by folding 64 bytes at a time
+		/// with carry-less multiplication, followed by a Barrett reduction.
+		/// length must be at least 64, and a multiple of 16. See "Fast CRC
+		/// Computation for Generic Polynomials Using PCLMULQDQ Instruction",
+		/// Intel, 2009.
+	{
+		static const UInt64 k1k2[2] = { 0x0154442bd4, 0x01c6e41596 };
+		static const UInt64 k3k4[2] = { 0x01751997d0, 0x00ccaa009e };
+		static const UInt64 k5k0[2] = { 0x0163cd6124, 0x0000000000 };
+		static const UInt64 poly[2] = { 0x01db710641, 0x01f7011641 };
+
+		__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+		__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
+		__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48));
+		x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(~crc)));
+		__m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k1k2));
+		data += 64;
+		length -= 64;
+
+		while (length >= 64)
+		{
+			__m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+			__m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+			__m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+			__m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+			x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+			x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+			x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+			x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+			x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)));
+			x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)));
+			x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)));
+			data += 64;
+			length -= 64;
+		}
+
+		// fold the four lanes into one
+		k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(k3k4));
+		__m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+		x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+		x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+		while (length >= 16)
+		{
+			x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+			x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), x5);
+			data += 16;
+			length -= 16;
+		}
+
+		// fold 128 bits to 64 bits
+		x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+		x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+		x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+		k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+		x2 = _mm_srli_si128(x1, 4);
+		x1 = _mm_and_si128(x1, x3);
+		x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x00), x2);
+
+		// Barrett reduction to 32 bits
+		k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(poly));
+		x2 = _mm_and_si128(x1, x3);
+		x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+		x2 = _mm_and_si128(x2, x3);
+		x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+
+		return ~static_cast<UInt32>(_mm_extract_epi32(x1, 1));
+	}
+
+
+	class CRC32CShift
+		/// Tables for appending a number of zero bytes to a CRC-32C,
+		/// built from the GF(2) matrix operator for a zero byte.
+		/// Used to combine CRCs computed over adjacent blocks.
+	{
+	public:
+		enum
+		{
+			LONG  = 8192,
+			SHORT = 256
+		};
+
+		CRC32CShift()
+		{
+			build(longShift, LONG);
+			build(shortShift, SHORT);
+		}
+
+		static UInt32 shift(const UInt32 (&table)[4][256], UInt32 crc)
+		{
+			return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^ table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24];
+		}
+
+		UInt32 longShift[4][256];
+		UInt32 shortShift[4][256];
+
+	private:
+		static UInt32 times(const UInt32* mat, UInt32 vec)
+		{
+			UInt32 sum = 0;
+			for (; vec; vec >>= 1, ++mat)
+			{
+				if (vec & 1) sum ^= *mat;
+			}
+			return sum;
+		}
+
+		static void square(UInt32* result, const UInt32* mat)
+		{
+			for (int n = 0; n < 32; ++n) result[n] = times(mat, mat[n]);
+		}
+
+		static void build(UInt32 (&table)[4][256], std::size_t length)
+		{
+			// operator for one zero bit, squared up to one zero byte,
+			// then squared once per bit of length (a power of two)
+			UInt32 odd[32];
+			UInt32 even[32];
+			odd[0] = 0x82F63B78;
+			for (int n = 1; n < 32; ++n) odd[n] = UInt32(1) << (n - 1);
+			square(even, odd);
+			square(odd, even);
+			square(even, odd);
+			UInt32* op = even;
+			UInt32* tmp = odd;
+			for (; length > 1; length >>= 1)
+			{
+				square(tmp, op);
+				std::swap(op, tmp);
+			}
+			for (UInt32 n = 0; n < 256; ++n)
+			{
+				table[0][n] = times(op, n);
+				table[1][n] = times(op, n << 8);
+				table[2][n] = times(op, n << 16);
+				table[3][n] = times(op, n << 24);
+			}
+		}
+	};
+
+
+	POCO_TARGET("sse4.2")
+	UInt32 crc32cSSE42(UInt32 crc, const unsigned char* data, std::size_t length)
+		/// Computes CRC-32C with the SSE 4.2 CRC32 instruction. Large
+		/// buffers are processed as three interleaved streams to hide
+		/// the latency of the instruction, and the partial CRCs are
+		/// combined with the shift tables.
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		typedef UInt64 Word;
+#define POCO_CRC32C_WORD(c, p) static_cast<UInt32>(_mm_crc32_u64(c, load<UInt64>(p)))
+#else
+		typedef UInt32 Word;
+#define POCO_CRC32C_WORD(c, p) _mm_crc32_u32(c, load<UInt32>(p))
+#endif
+		static const CRC32CShift shifts;
+
+		UInt32 c0 = ~crc;
+		while (length > 0 && (reinterpret_cast<std::size_t>(data) & (sizeof(Word) - 1)))
+		{
+			c0 = _mm_crc32_u8(c0, *data++);
+			--length;
+		}
+		while (length >= 3*CRC32CShift::LONG)
+		{
+			UInt32 c1 = 0;
+			UInt32 c2 = 0;
+			const unsigned char* end = data + CRC32CShift::LONG;
+			for (; data < end; data += sizeof(Word))
+			{
+				c0 = POCO_CRC32C_WORD(c0, data);
+				c1 = POCO_CRC32C_WORD(c1, data + CRC32CShift::LONG);
+				c2 = POCO_CRC32C_WORD(c2, data + 2*CRC32CShift::LONG);
+			}
+			c0 = CRC32CShift::shift(shifts.longShift, c0) ^ c1;
+			c0 = CRC32CShift::shift(shifts.longShift, c0) ^ c2;
+			data += 2*CRC32CShift::LONG;
+			length -= 3*CRC32CShift::LONG;
+		}
+		while (length >= 3*CRC32CShift::SHORT)
+		{
+			UInt32 c1 = 0;
+			UInt32 c2 = 0;
+			const unsigned char* end = data + CRC32CShift::SHORT;
+			for (; data < end; data += sizeof(Word))
+			{
+				c0 = POCO_CRC32C_WORD(c0, data);
+				c1 = POCO_CRC32C_WORD(c1, data + CRC32CShift::SHORT);
+				c2 = POCO_CRC32C_WORD(c2, data + 2*CRC32CShift::SHORT);
+			}
+			c0 = CRC32CShift::shift(shifts.shortShift, c0) ^ c1;
+			c0 = CRC32CShift::shift(shifts.shortShift, c0) ^ c2;
+			data += 2*CRC32CShift::SHORT;
+			length -= 3*CRC32CShift::SHORT;
+		}
+		for (; length >= sizeof(Word); length -= sizeof(Word), data += sizeof(Word))
+		{
+			c0 = POCO_CRC32C_WORD(c0, data);
+		}
+		while (length > 0)
+		{
+			c0 = _mm_crc32_u8(c0, *data++);
+			--length;
+		}
+#undef POCO_CRC32C_WORD
+		return ~c0;
+	}
+
+
+	POCO_TARGET("ssse3")
+	UInt32 adler32SSSE3(UInt32 adler, const unsigned char* data, std::size_t length)
+		/// Computes Adler-32 over 32 bytes at a time: the byte sums are
+		/// computed with psadbw, and the position-weighted sums with
+		/// pmaddubsw, reducing modulo 65521 every NMAX bytes.
+	{
+		static const UInt32 BASE = 65521;
+		static const std::size_t NMAX = 5552;
+		static const std::size_t BLOCK = 32;
+
+		UInt32 s1 = adler & 0xFFFF;
+		UInt32 s2 = adler >> 16;
+		std::size_t blocks = length/BLOCK;
+		length -= blocks*BLOCK;
+
+		const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+		const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i ones = _mm_set1_epi16(1);
+		while (blocks > 0)
+		{
+			std::size_t n = NMAX/BLOCK;
+			if (n > blocks) n = blocks;
+			blocks -= n;
+
+			__m128i ps = _mm_cvtsi32_si128(static_cast<int>(s1*n));
+			__m128i v2 = _mm_cvtsi32_si128(static_cast<int>(s2));
+			__m128i v1 = _mm_setzero_si128();
+			for (; n > 0; --n, data += BLOCK)
+			{
+				const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+				const __m128i b2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+				ps = _mm_add_epi32(ps, v1);
+				v1 = _mm_add_epi32(v1, _mm_sad_epu8(b1, zero));
+				v2 = _mm_add_epi32(v2, _mm_madd_epi16(_mm_maddubs_epi16(b1, tap1), ones));
+				v1 = _mm_add_epi32(v1, _mm_sad_epu8(b2, zero));
+				v2 = _mm_add_epi32(v2, _mm_madd_epi16(_mm_maddubs_epi16(b2, tap2), ones));
+			}
+			v2 = _mm_add_epi32(v2, _mm_slli_epi32(ps, 5));
+
+			v1 = _mm_add_epi32(v1, _mm_shuffle_epi32(v1, _MM_SHUFFLE(1, 0, 3, 2)));
+			s1 += static_cast<UInt32>(_mm_cvtsi128_si32(v1));
+			v2 = _mm_add_epi32(v2, _mm_shuffle_epi32(v2, _MM_SHUFFLE(2, 3, 0, 1)));
+			v2 = _mm_add_epi32(v2, _mm_shuffle_epi32(v2, _MM_SHUFFLE(1, 0, 3, 2)));
+			s2 = static_cast<UInt32>(_mm_cvtsi128_si32(v2));
+			s1 %= BASE;
+			s2 %= BASE;
+		}
+		while (length--)
+		{
+			s1 += *data++;
+			s2 += s1;
+		}
+		return (s1 % BASE) | ((s2 % BASE) << 16);
+	}
+
+
+#endif // POCO_HAVE_X86_INTRINSICS
+
+
+#if defined(__ARM_FEATURE_CRC32)
+
+
+	UInt32 crc32ARM(UInt32 crc, const unsigned char* data, std::size_t length)
+	{
+		crc = ~crc;
+		for (; length >= 8; length -= 8, data += 8)
+		{
+			UInt64 w;
+			std::memcpy(&w, data, sizeof(w));
+			crc = __crc32d(crc, w);
+		}
+		while (length--) crc = __crc32b(crc, *data++);
+		return ~crc;
+	}
+
+
+	UInt32 crc32cARM(UInt32 crc, const unsigned char* data, std::size_t length)
+	{
+		crc = ~crc;
+		for (; length >= 8; length -= 8, data += 8)
+		{
+			UInt64 w;
+			std::memcpy(&w, data, sizeof(w));
+			crc = __crc32cd(crc, w);
+		}
+		while (length--) crc = __crc32cb(crc, *data++);
+		return ~crc;
+	}
+
+
+#endif // __ARM_FEATURE_CRC32
+
+
+	UInt32 updateCRC32(UInt32 crc, const unsigned char* data, std::size_t length)
+	{
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (length >= 64 && CPUFeatures::hasPCLMUL() && CPUFeatures::hasSSE42())
+		{
+			std::size_t n = length & ~std::size_t(15);
+			crc = crc32PCLMUL(crc, data, n);
+			data += n;
+			length -= n;
+		}
+#elif defined(__ARM_FEATURE_CRC32)
+		return crc32ARM(crc, data, length);
+#endif
+		return length > 0 ? crc32Zlib(crc, data, length) : crc;
+	}
+
+
+	UInt32 updateCRC32C(UInt32 crc, const unsigned char* data, std::size_t length)
+	{
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (CPUFeatures::hasSSE42()) return crc32cSSE42(crc, data, length);
+#elif defined(__ARM_FEATURE_CRC32)
+		return crc32cARM(crc, data, length);
+#endif
+		return crc32cSlicing(crc, data, length);
+	}
+
+
+	UInt32 updateAdler32(UInt32 adler, const unsigned char* data, std::size_t length)
+	{
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (length >= 64 && CPUFeatures::hasSSSE3()) return adler32SSSE3(adler, data, length);
+#endif
+		return adler32Zlib(adler, data, length);
+	}
+}
+
+
 Checksum::Checksum():
 	_type(TYPE_CRC32),
-	_value(crc32(0L, Z_NULL, 0))
+	_value(0)
 {
 }
 
 
 Checksum::Checksum(Type t):
 	_type(t),
-	_value(0)
+	_value(t == TYPE_ADLER32 ? 1 : 0)
 {
-	if (t == TYPE_CRC32)
-		_value = crc32(0L, Z_NULL, 0);
-	else
-		_value = adler32(0L, Z_NULL, 0);
 }
 
 
@@ -48,10 +502,25 @@ Checksum::~Checksum()
 
 void Checksum::update(const char* data, unsigned length)
 {
-	if (_type == TYPE_ADLER32)
-		_value = adler32(_value, reinterpret_cast<const Bytef*>(data), length);
-	else
-		_value = crc32(_value, reinterpret_cast<const Bytef*>(data), length);
+	updateBytes(data, length);
+}
+
+
+void Checksum::updateBytes(const void* data, std::size_t length)
+{
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	switch (_type)
+	{
+	case TYPE_ADLER32:
+		_value = updateAdler32(_value, p, length);
+		break;
+	case TYPE_CRC32:
+		_value = updateCRC32(_value, p, length);
+		break;
+	case TYPE_CRC32C:
+		_value = updateCRC32C(_value, p, length);
+		break;
+	}
 }
 
 
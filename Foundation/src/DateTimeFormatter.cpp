@@ -13,7 +13,7 @@
 
 
 #include "Poco/DateTimeFormatter.h"
-#include "Poco/DateTimeFormat.h"
+#include "Poco/DateTimePattern.h"
 #include "Poco/Timestamp.h"
 #include "Poco/NumberFormatter.h"
 
@@ -27,52 +27,21 @@ void DateTimeFormatter::append(std::string& str, const LocalDateTime& dateTime,
 }
 
 
+void DateTimeFormatter::append(std::string& str, const Timestamp& timestamp, const std::string& fmt, int timeZoneDifferential)
+{
+	if (const DateTimePattern* pPattern = DateTimePattern::cached(fmt))
+		pPattern->append(str, timestamp, timeZoneDifferential);
+	else
+		DateTimePattern(fmt).append(str, timestamp, timeZoneDifferential);
+}
+
+
 void DateTimeFormatter::append(std::string& str, const DateTime& dateTime, const std::string& fmt, int timeZoneDifferential)
 {
-	std::string::const_iterator it  = fmt.begin();
-	std::string::const_iterator end = fmt.end();
-	while (it != end)
-	{
-		if (*it == '%')
-		{
-			if (++it != end)
-			{
-				switch (*it)
-				{
-				case 'w': str.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
-				case 'W': str.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
-				case 'b': str.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
-				case 'B': str.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
-				case 'd': NumberFormatter::append0(str, dateTime.day(), 2); break;
-				case 'e': NumberFormatter::append(str, dateTime.day()); break;
-				case 'f': NumberFormatter::append(str, dateTime.day(), 2); break;
-				case 'm': NumberFormatter::append0(str, dateTime.month(), 2); break;
-				case 'n': NumberFormatter::append(str, dateTime.month()); break;
-				case 'o': NumberFormatter::append(str, dateTime.month(), 2); break;
-				case 'y': NumberFormatter::append0(str, dateTime.year() % 100, 2); break;
-				case 'Y': NumberFormatter::append0(str, dateTime.year(), 4); break;
-				case 'H': NumberFormatter::append0(str, dateTime.hour(), 2); break;
-				case 'h': NumberFormatter::append0(str, dateTime.hourAMPM(), 2); break;
-				case 'a': str.append(dateTime.isAM() ? "am" : "pm"); break;
-				case 'A': str.append(dateTime.isAM() ? "AM" : "PM"); break;
-				case 'M': NumberFormatter::append0(str, dateTime.minute(), 2); break;
-				case 'S': NumberFormatter::append0(str, dateTime.second(), 2); break;
-				case 's': NumberFormatter::append0(str, dateTime.second(), 2); 
-				          str += '.'; 
-				          NumberFormatter::append0(str, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); 
-				          break;
-				case 'i': NumberFormatter::append0(str, dateTime.millisecond(), 3); break;
-				case 'c': NumberFormatter::append(str, dateTime.millisecond()/100); break;
-				case 'F': NumberFormatter::append0(str, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
-				case 'z': tzdISO(str, timeZoneDifferential); break;
-				case 'Z': tzdRFC(str, timeZoneDifferential); break;
-				default:  str += *it;
-				}
-				++it;
-			}
-		}
-		else str += *it++;
-	}
+	if (const DateTimePattern* pPattern = DateTimePattern::cached(fmt))
+		pPattern->append(str, dateTime, timeZoneDifferential);
+	else
+		DateTimePattern(fmt).append(str, dateTime, timeZoneDifferential);
 }
 
 
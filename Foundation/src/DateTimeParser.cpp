@@ -13,167 +13,58 @@
 
 
 #include "Poco/DateTimeParser.h"
+#include "Poco/DateTimePattern.h"
 #include "Poco/DateTimeFormat.h"
 #include "Poco/DateTime.h"
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
+#include <cstring>
 
 
 namespace Poco {
 
 
-#define SKIP_JUNK() \
-	while (it != end && !Ascii::isDigit(*it)) ++it
-
-
-#define SKIP_DIGITS() \
-	while (it != end && Ascii::isDigit(*it)) ++it
-
-
-#define PARSE_NUMBER(var) \
-	while (it != end && Ascii::isDigit(*it)) var = var*10 + ((*it++) - '0')
-
-
 #define PARSE_NUMBER_N(var, n) \
 	{ int i = 0; while (i++ < n && it != end && Ascii::isDigit(*it)) var = var*10 + ((*it++) - '0'); }
 
 
-#define PARSE_FRACTIONAL_N(var, n) \
-	{ int i = 0; while (i < n && it != end && Ascii::isDigit(*it)) { var = var*10 + ((*it++) - '0'); i++; } while (i++ < n) var *= 10; }
-
-
-void DateTimeParser::parse(const std::string& fmt, const std::string& str, DateTime& dateTime, int& timeZoneDifferential)
+namespace
 {
-	if (fmt.empty() || str.empty())
-		throw SyntaxException("Empty string.");
-
-	int year   = 0;
-	int month  = 0;
-	int day    = 0;
-	int hour   = 0;
-	int minute = 0;
-	int second = 0;
-	int millis = 0;
-	int micros = 0;
-	int tzd    = 0;
+	std::string capitalize(std::string::const_iterator it, std::string::const_iterator end)
+	{
+		std::string result(it, end);
+		for (std::string::iterator itr = result.begin(); itr != result.end(); ++itr)
+		{
+			*itr = itr == result.begin() ? Ascii::toUpper(*itr) : Ascii::toLower(*itr);
+		}
+		return result;
+	}
 
-	std::string::const_iterator it   = str.begin();
-	std::string::const_iterator end  = str.end();
-	std::string::const_iterator itf  = fmt.begin();
-	std::string::const_iterator endf = fmt.end();
 
-	while (itf != endf && it != end)
+	int findName(const std::string names[], int count, std::string::const_iterator it, std::string::const_iterator end)
+		/// Returns the index of the first name that starts with
+		/// the given range (in any case), or -1 if there is none.
 	{
-		if (*itf == '%')
+		std::string::size_type length = end - it;
+		for (int i = 0; i < count; ++i)
 		{
-			if (++itf != endf)
-			{
-				switch (*itf)
-				{
-				case 'w':
-				case 'W':
-					while (it != end && Ascii::isSpace(*it)) ++it;
-					while (it != end && Ascii::isAlpha(*it)) ++it;
-					break;
-				case 'b':
-				case 'B':
-					month = parseMonth(it, end);
-					break;
-				case 'd':
-				case 'e':
-				case 'f':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(day, 2);
-					break;
-				case 'm':
-				case 'n':
-				case 'o':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(month, 2);
-					break;					 
-				case 'y':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(year, 2);
-					if (year >= 69) 
-						year += 1900;
-					else
-						year += 2000;
-					break;
-				case 'Y':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(year, 4);
-					break;
-				case 'r':
-					SKIP_JUNK();
-					PARSE_NUMBER(year);
-					if (year < 1000)
-					{
-						if (year >= 69) 
-							year += 1900;
-						else
-							year += 2000;
-					}
-					break;
-				case 'H':
-				case 'h':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(hour, 2);
-					break;
-				case 'a':
-				case 'A':
-					hour = parseAMPM(it, end, hour);
-					break;
-				case 'M':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(minute, 2);
-					break;
-				case 'S':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(second, 2);
-					break;
-				case 's':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(second, 2);
-					if (it != end && (*it == '.' || *it == ','))
-					{
-						++it;
-						PARSE_FRACTIONAL_N(millis, 3);
-						PARSE_FRACTIONAL_N(micros, 3);
-						SKIP_DIGITS();
-					}
-					break;
-				case 'i':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(millis, 3);
-					break;
-				case 'c':
-					SKIP_JUNK();
-					PARSE_NUMBER_N(millis, 1);
-					millis *= 100;
-					break;
-				case 'F':
-					SKIP_JUNK();
-					PARSE_FRACTIONAL_N(millis, 3);
-					PARSE_FRACTIONAL_N(micros, 3);
-					SKIP_DIGITS();
-					break;
-				case 'z':
-				case 'Z':
-					tzd = parseTZD(it, end);
-					break;
-				}
-				++itf;
-			}
+			const std::string& name = names[i];
+			if (length > name.size()) continue;
+			std::string::size_type k = 0;
+			while (k < length && Ascii::toLower(it[k]) == Ascii::toLower(name[k])) ++k;
+			if (k == length) return i;
 		}
-		else ++itf;
+		return -1;
 	}
-	if (month == 0) month = 1;
-	if (day == 0) day = 1;
-	if (DateTime::isValid(year, month, day, hour, minute, second, millis, micros))
-		dateTime.assign(year, month, day, hour, minute, second, millis, micros);
-	else 
-		throw SyntaxException("date/time component out of range");
-	timeZoneDifferential = tzd;
+}
+
+
+void DateTimeParser::parse(const std::string& fmt, const std::string& str, DateTime& dateTime, int& timeZoneDifferential)
+{
+	if (const DateTimePattern* pPattern = DateTimePattern::cached(fmt))
+		pPattern->parse(str, dateTime, timeZoneDifferential);
+	else
+		DateTimePattern(fmt).parse(str, dateTime, timeZoneDifferential);
 }
 
 
@@ -291,14 +182,13 @@ int DateTimeParser::parseTZD(std::string::const_iterator& it, const std::string:
 	{
 		if (Ascii::isAlpha(*it))
 		{
-			std::string designator;
-			designator += *it++;
-			if (it != end && Ascii::isAlpha(*it)) designator += *it++;
-			if (it != end && Ascii::isAlpha(*it)) designator += *it++;
-			if (it != end && Ascii::isAlpha(*it)) designator += *it++;
+			char designator[5];
+			std::size_t length = 0;
+			while (length < 4 && it != end && Ascii::isAlpha(*it)) designator[length++] = *it++;
+			designator[length] = 0;
 			for (unsigned i = 0; i < sizeof(zones)/sizeof(Zone); ++i)
 			{
-				if (designator == zones[i].designator)
+				if (std::strcmp(designator, zones[i].designator) == 0)
 				{
 					tzd = zones[i].timeZoneDifferential;
 					break;
@@ -323,70 +213,54 @@ int DateTimeParser::parseTZD(std::string::const_iterator& it, const std::string:
 
 int DateTimeParser::parseMonth(std::string::const_iterator& it, const std::string::const_iterator& end)
 {
-	std::string month;
 	while (it != end && (Ascii::isSpace(*it) || Ascii::isPunct(*it))) ++it;
-	bool isFirst = true;
-	while (it != end && Ascii::isAlpha(*it)) 
-	{
-		char ch = (*it++);
-		if (isFirst) { month += Ascii::toUpper(ch); isFirst = false; }
-		else month += Ascii::toLower(ch);
-	}
-	if (month.length() < 3) throw SyntaxException("Month name must be at least three characters long", month);
-	for (int i = 0; i < 12; ++i) 
-	{
-		if (DateTimeFormat::MONTH_NAMES[i].find(month) == 0)
-			return i + 1;
-	}
-	throw SyntaxException("Not a valid month name", month);
+	std::string::const_iterator begin = it;
+	while (it != end && Ascii::isAlpha(*it)) ++it;
+	if (it - begin < 3) throw SyntaxException("Month name must be at least three characters long", capitalize(begin, it));
+	int month = findName(DateTimeFormat::MONTH_NAMES, 12, begin, it);
+	if (month < 0) throw SyntaxException("Not a valid month name", capitalize(begin, it));
+	return month + 1;
 }
 
 
 int DateTimeParser::parseDayOfWeek(std::string::const_iterator& it, const std::string::const_iterator& end)
 {
-	std::string dow;
 	while (it != end && (Ascii::isSpace(*it) || Ascii::isPunct(*it))) ++it;
-	bool isFirst = true;
-	while (it != end && Ascii::isAlpha(*it)) 
-	{
-		char ch = (*it++);
-		if (isFirst) { dow += Ascii::toUpper(ch); isFirst = false; }
-		else dow += Ascii::toLower(ch);
-	}
-	if (dow.length() < 3) throw SyntaxException("Weekday name must be at least three characters long", dow);
-	for (int i = 0; i < 7; ++i) 
-	{
-		if (DateTimeFormat::WEEKDAY_NAMES[i].find(dow) == 0)
-			return i;
-	}
-	throw SyntaxException("Not a valid weekday name", dow);
+	std::string::const_iterator begin = it;
+	while (it != end && Ascii::isAlpha(*it)) ++it;
+	if (it - begin < 3) throw SyntaxException("Weekday name must be at least three characters long", capitalize(begin, it));
+	int dow = findName(DateTimeFormat::WEEKDAY_NAMES, 7, begin, it);
+	if (dow < 0) throw SyntaxException("Not a valid weekday name", capitalize(begin, it));
+	return dow;
 }
 
 
 int DateTimeParser::parseAMPM(std::string::const_iterator& it, const std::string::const_iterator& end, int hour)
 {
-	std::string ampm;
 	while (it != end && (Ascii::isSpace(*it) || Ascii::isPunct(*it))) ++it;
-	while (it != end && Ascii::isAlpha(*it)) 
-	{
-		char ch = (*it++);
-		ampm += Ascii::toUpper(ch);
-	}
-	if (ampm == "AM")
-	{
-		if (hour == 12)
-			return 0;
-		else
-			return hour;
-	}
-	else if (ampm == "PM")
+	std::string::const_iterator begin = it;
+	while (it != end && Ascii::isAlpha(*it)) ++it;
+	if (it - begin == 2 && Ascii::toUpper(begin[1]) == 'M')
 	{
-		if (hour < 12)
-			return hour + 12;
-		else
-			return hour;
+		char c = Ascii::toUpper(begin[0]);
+		if (c == 'A')
+		{
+			if (hour == 12)
+				return 0;
+			else
+				return hour;
+		}
+		else if (c == 'P')
+		{
+			if (hour < 12)
+				return hour + 12;
+			else
+				return hour;
+		}
 	}
-	else throw SyntaxException("Not a valid AM/PM designator", ampm);
+	std::string ampm(begin, it);
+	for (std::string::iterator itr = ampm.begin(); itr != ampm.end(); ++itr) *itr = Ascii::toUpper(*itr);
+	throw SyntaxException("Not a valid AM/PM designator", ampm);
 }
 
 
@@ -0,0 +1,689 @@
+//
+// DateTimePattern.cpp
+//
+// Library: Foundation
+// Package: DateTime
+// Module:  DateTimePattern
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/DateTimePattern.h"
+#include "Poco/DateTimeFormat.h"
+#include "Poco/DateTimeParser.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Exception.h"
+#include "Poco/Ascii.h"
+
+
+namespace Poco {
+
+
+#define SKIP_JUNK() \
+	while (it != end && !Ascii::isDigit(*it)) ++it
+
+
+#define SKIP_DIGITS() \
+	while (it != end && Ascii::isDigit(*it)) ++it
+
+
+#define PARSE_NUMBER(var) \
+	while (it != end && Ascii::isDigit(*it)) var = var*10 + ((*it++) - '0')
+
+
+#define PARSE_NUMBER_N(var, n) \
+	{ int i = 0; while (i++ < n && it != end && Ascii::isDigit(*it)) var = var*10 + ((*it++) - '0'); }
+
+
+#define PARSE_FRACTIONAL_N(var, n) \
+	{ int i = 0; while (i < n && it != end && Ascii::isDigit(*it)) { var = var*10 + ((*it++) - '0'); i++; } while (i++ < n) var *= 10; }
+
+
+namespace
+{
+	const char WEEKDAY_ABBREVIATIONS[] = "SunMonTueWedThuFriSat";
+	const char MONTH_ABBREVIATIONS[]   = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+
+	void appendNumber(std::string& str, int value, int width, char fill)
+		/// Appends a non-negative value, right-aligned in a field of at
+		/// least width characters, like NumberFormatter::append0()
+		/// (fill '0') and NumberFormatter::append() (fill ' ').
+	{
+		char buffer[16];
+		char* end = buffer + sizeof(buffer);
+		char* p = end;
+		do
+		{
+			*--p = static_cast<char>('0' + value % 10);
+			value /= 10;
+		}
+		while (value);
+		while (end - p < width) *--p = fill;
+		str.append(p, end - p);
+	}
+
+
+	inline char* writeDigits(char* p, int value, int n)
+		/// Writes the n lowest decimal digits of value.
+	{
+		for (int i = n - 1; i >= 0; --i)
+		{
+			p[i] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		}
+		return p + n;
+	}
+
+
+	inline bool readDigits(const char* p, int n, int& value)
+	{
+		value = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			if (!Ascii::isDigit(p[i])) return false;
+			value = value*10 + (p[i] - '0');
+		}
+		return true;
+	}
+
+
+	int findMonth(const char* p)
+		/// Returns the number of the month whose name starts with the
+		/// three given letters (in any case), or 0 if there is none.
+	{
+		for (int i = 0; i < 12; ++i)
+		{
+			const char* name = MONTH_ABBREVIATIONS + 3*i;
+			if (Ascii::toLower(p[0]) == Ascii::toLower(name[0]) &&
+			    Ascii::toLower(p[1]) == name[1] &&
+			    Ascii::toLower(p[2]) == name[2])
+				return i + 1;
+		}
+		return 0;
+	}
+
+
+	void appendField(std::string& str, char specifier, const DateTime& dateTime, int timeZoneDifferential)
+	{
+		switch (specifier)
+		{
+		case 'w': str.append(WEEKDAY_ABBREVIATIONS + 3*dateTime.dayOfWeek(), 3); break;
+		case 'W': str.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
+		case 'b': str.append(MONTH_ABBREVIATIONS + 3*(dateTime.month() - 1), 3); break;
+		case 'B': str.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
+		case 'd': appendNumber(str, dateTime.day(), 2, '0'); break;
+		case 'e': appendNumber(str, dateTime.day(), 0, ' '); break;
+		case 'f': appendNumber(str, dateTime.day(), 2, ' '); break;
+		case 'm': appendNumber(str, dateTime.month(), 2, '0'); break;
+		case 'n': appendNumber(str, dateTime.month(), 0, ' '); break;
+		case 'o': appendNumber(str, dateTime.month(), 2, ' '); break;
+		case 'y': appendNumber(str, dateTime.year() % 100, 2, '0'); break;
+		case 'Y': appendNumber(str, dateTime.year(), 4, '0'); break;
+		case 'H': appendNumber(str, dateTime.hour(), 2, '0'); break;
+		case 'h': appendNumber(str, dateTime.hourAMPM(), 2, '0'); break;
+		case 'a': str.append(dateTime.isAM() ? "am" : "pm"); break;
+		case 'A': str.append(dateTime.isAM() ? "AM" : "PM"); break;
+		case 'M': appendNumber(str, dateTime.minute(), 2, '0'); break;
+		case 'S': appendNumber(str, dateTime.second(), 2, '0'); break;
+		case 's': appendNumber(str, dateTime.second(), 2, '0');
+		          str += '.';
+		          appendNumber(str, dateTime.millisecond()*1000 + dateTime.microsecond(), 6, '0');
+		          break;
+		case 'i': appendNumber(str, dateTime.millisecond(), 3, '0'); break;
+		case 'c': appendNumber(str, dateTime.millisecond()/100, 0, ' '); break;
+		case 'F': appendNumber(str, dateTime.millisecond()*1000 + dateTime.microsecond(), 6, '0'); break;
+		case 'z': DateTimeFormatter::tzdISO(str, timeZoneDifferential); break;
+		case 'Z': DateTimeFormatter::tzdRFC(str, timeZoneDifferential); break;
+		default:  str += specifier;
+		}
+	}
+
+
+	struct LastSecond
+		/// The last Timestamp formatted by the calling thread
+		/// in RFC 1123 or HTTP format.
+	{
+		int kind;
+		Timestamp::TimeVal second;
+		int timeZoneDifferential;
+		std::size_t length;
+		char text[48];
+	};
+
+
+	thread_local bool cacheDestroyed = false;
+
+
+	class PatternCache
+		/// The per-thread cache of compiled patterns used by
+		/// DateTimeFormatter and DateTimeParser. The least recently
+		/// compiled pattern is replaced when the cache is full.
+	{
+	public:
+		PatternCache():
+			_next(0)
+		{
+			_patterns.reserve(CACHE_SIZE);
+		}
+
+		~PatternCache()
+		{
+			cacheDestroyed = true;
+		}
+
+		const DateTimePattern& get(const std::string& fmt)
+		{
+			for (std::vector<DateTimePattern>::const_iterator it = _patterns.begin(); it != _patterns.end(); ++it)
+			{
+				if (it->pattern() == fmt) return *it;
+			}
+			if (_patterns.size() < CACHE_SIZE)
+			{
+				_patterns.push_back(DateTimePattern(fmt));
+				return _patterns.back();
+			}
+			DateTimePattern& pattern = _patterns[_next];
+			pattern = DateTimePattern(fmt);
+			_next = (_next + 1) % CACHE_SIZE;
+			return pattern;
+		}
+
+	private:
+		enum
+		{
+			CACHE_SIZE = 8
+		};
+
+		std::vector<DateTimePattern> _patterns;
+		std::size_t _next;
+	};
+
+
+	thread_local PatternCache patternCache;
+}
+
+
+DateTimePattern::DateTimePattern(const std::string& fmt):
+	_pattern(fmt),
+	_kind(KIND_GENERIC)
+{
+	compile();
+}
+
+
+DateTimePattern::~DateTimePattern()
+{
+}
+
+
+void DateTimePattern::compile()
+{
+	std::size_t pos = 0;
+	while (pos < _pattern.size())
+	{
+		if (_pattern[pos] == '%')
+		{
+			if (++pos < _pattern.size())
+			{
+				Token token = {_pattern[pos], pos, 1};
+				_tokens.push_back(token);
+				++pos;
+			}
+		}
+		else
+		{
+			std::size_t next = _pattern.find('%', pos);
+			if (next == std::string::npos) next = _pattern.size();
+			Token token = {0, pos, next - pos};
+			_tokens.push_back(token);
+			pos = next;
+		}
+	}
+
+	if (_pattern == "%Y-%m-%dT%H:%M:%S%z")
+		_kind = KIND_ISO8601;
+	else if (_pattern == "%Y-%m-%dT%H:%M:%s%z")
+		_kind = KIND_ISO8601_FRAC;
+	else if (_pattern == "%w, %e %b %Y %H:%M:%S %Z")
+		_kind = KIND_RFC1123;
+	else if (_pattern == "%w, %d %b %Y %H:%M:%S %Z")
+		_kind = KIND_HTTP;
+	else if (_pattern == "%w, %e %b %r %H:%M:%S %Z")
+		_kind = KIND_RFC1123_PARSE;
+}
+
+
+std::string DateTimePattern::format(const Timestamp& timestamp, int timeZoneDifferential) const
+{
+	std::string result;
+	result.reserve(64);
+	append(result, timestamp, timeZoneDifferential);
+	return result;
+}
+
+
+std::string DateTimePattern::format(const DateTime& dateTime, int timeZoneDifferential) const
+{
+	std::string result;
+	result.reserve(64);
+	append(result, dateTime, timeZoneDifferential);
+	return result;
+}
+
+
+std::string DateTimePattern::format(const LocalDateTime& dateTime) const
+{
+	return format(dateTime._dateTime, dateTime._tzd);
+}
+
+
+void DateTimePattern::append(std::string& str, const Timestamp& timestamp, int timeZoneDifferential) const
+{
+	if (_kind == KIND_RFC1123 || _kind == KIND_HTTP)
+	{
+		static thread_local LastSecond last = {KIND_GENERIC, 0, 0, 0, {0}};
+
+		Timestamp::TimeVal time = timestamp.epochMicroseconds();
+		Timestamp::TimeVal second = time/Timestamp::resolution();
+		if (time < second*Timestamp::resolution()) --second;
+
+		if (last.kind != _kind || last.second != second || last.timeZoneDifferential != timeZoneDifferential)
+		{
+			std::string::size_type pos = str.size();
+			append(str, DateTime(timestamp), timeZoneDifferential);
+			std::size_t length = str.size() - pos;
+			if (length <= sizeof(last.text))
+			{
+				last.kind = _kind;
+				last.second = second;
+				last.timeZoneDifferential = timeZoneDifferential;
+				last.length = length;
+				str.copy(last.text, length, pos);
+			}
+		}
+		else str.append(last.text, last.length);
+	}
+	else append(str, DateTime(timestamp), timeZoneDifferential);
+}
+
+
+void DateTimePattern::append(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const
+{
+	switch (_kind)
+	{
+	case KIND_ISO8601:
+	case KIND_ISO8601_FRAC:
+		appendISO8601(str, dateTime, timeZoneDifferential);
+		break;
+	case KIND_RFC1123:
+	case KIND_HTTP:
+		appendRFC1123(str, dateTime, timeZoneDifferential);
+		break;
+	default:
+		appendGeneric(str, dateTime, timeZoneDifferential);
+	}
+}
+
+
+void DateTimePattern::appendGeneric(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const
+{
+	for (std::vector<Token>::const_iterator it = _tokens.begin(); it != _tokens.end(); ++it)
+	{
+		if (it->specifier)
+			appendField(str, it->specifier, dateTime, timeZoneDifferential);
+		else
+			str.append(_pattern, it->offset, it->length);
+	}
+}
+
+
+void DateTimePattern::appendISO8601(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const
+{
+	char buffer[32];
+	char* p = writeDigits(buffer, dateTime.year(), 4);
+	*p++ = '-';
+	p = writeDigits(p, dateTime.month(), 2);
+	*p++ = '-';
+	p = writeDigits(p, dateTime.day(), 2);
+	*p++ = 'T';
+	p = writeDigits(p, dateTime.hour(), 2);
+	*p++ = ':';
+	p = writeDigits(p, dateTime.minute(), 2);
+	*p++ = ':';
+	p = writeDigits(p, dateTime.second(), 2);
+	if (_kind == KIND_ISO8601_FRAC)
+	{
+		*p++ = '.';
+		p = writeDigits(p, dateTime.millisecond()*1000 + dateTime.microsecond(), 6);
+	}
+	str.append(buffer, p - buffer);
+	DateTimeFormatter::tzdISO(str, timeZoneDifferential);
+}
+
+
+void DateTimePattern::appendRFC1123(std::string& str, const DateTime& dateTime, int timeZoneDifferential) const
+{
+	char buffer[32];
+	char* p = buffer;
+	const char* weekday = WEEKDAY_ABBREVIATIONS + 3*dateTime.dayOfWeek();
+	*p++ = weekday[0];
+	*p++ = weekday[1];
+	*p++ = weekday[2];
+	*p++ = ',';
+	*p++ = ' ';
+	int day = dateTime.day();
+	p = writeDigits(p, day, _kind == KIND_HTTP || day >= 10 ? 2 : 1);
+	*p++ = ' ';
+	const char* month = MONTH_ABBREVIATIONS + 3*(dateTime.month() - 1);
+	*p++ = month[0];
+	*p++ = month[1];
+	*p++ = month[2];
+	*p++ = ' ';
+	p = writeDigits(p, dateTime.year(), 4);
+	*p++ = ' ';
+	p = writeDigits(p, dateTime.hour(), 2);
+	*p++ = ':';
+	p = writeDigits(p, dateTime.minute(), 2);
+	*p++ = ':';
+	p = writeDigits(p, dateTime.second(), 2);
+	*p++ = ' ';
+	str.append(buffer, p - buffer);
+	DateTimeFormatter::tzdRFC(str, timeZoneDifferential);
+}
+
+
+void DateTimePattern::parse(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const
+{
+	switch (_kind)
+	{
+	case KIND_ISO8601:
+	case KIND_ISO8601_FRAC:
+		if (parseISO8601(str, dateTime, timeZoneDifferential)) return;
+		break;
+	case KIND_RFC1123:
+	case KIND_HTTP:
+	case KIND_RFC1123_PARSE:
+		if (parseRFC1123(str, dateTime, timeZoneDifferential)) return;
+		break;
+	default:
+		break;
+	}
+	parseGeneric(str, dateTime, timeZoneDifferential);
+}
+
+
+DateTime DateTimePattern::parse(const std::string& str, int& timeZoneDifferential) const
+{
+	DateTime result;
+	parse(str, result, timeZoneDifferential);
+	return result;
+}
+
+
+bool DateTimePattern::tryParse(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const
+{
+	try
+	{
+		parse(str, dateTime, timeZoneDifferential);
+	}
+	catch (Exception&)
+	{
+		return false;
+	}
+	return true;
+}
+
+
+void DateTimePattern::parseGeneric(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const
+{
+	if (_pattern.empty() || str.empty())
+		throw SyntaxException("Empty string.");
+
+	int year   = 0;
+	int month  = 0;
+	int day    = 0;
+	int hour   = 0;
+	int minute = 0;
+	int second = 0;
+	int millis = 0;
+	int micros = 0;
+	int tzd    = 0;
+
+	std::string::const_iterator it  = str.begin();
+	std::string::const_iterator end = str.end();
+
+	for (std::vector<Token>::const_iterator itt = _tokens.begin(); itt != _tokens.end() && it != end; ++itt)
+	{
+		switch (itt->specifier)
+		{
+		case 'w':
+		case 'W':
+			while (it != end && Ascii::isSpace(*it)) ++it;
+			while (it != end && Ascii::isAlpha(*it)) ++it;
+			break;
+		case 'b':
+		case 'B':
+			month = DateTimeParser::parseMonth(it, end);
+			break;
+		case 'd':
+		case 'e':
+		case 'f':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(day, 2);
+			break;
+		case 'm':
+		case 'n':
+		case 'o':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(month, 2);
+			break;
+		case 'y':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(year, 2);
+			if (year >= 69)
+				year += 1900;
+			else
+				year += 2000;
+			break;
+		case 'Y':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(year, 4);
+			break;
+		case 'r':
+			SKIP_JUNK();
+			PARSE_NUMBER(year);
+			if (year < 1000)
+			{
+				if (year >= 69)
+					year += 1900;
+				else
+					year += 2000;
+			}
+			break;
+		case 'H':
+		case 'h':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(hour, 2);
+			break;
+		case 'a':
+		case 'A':
+			hour = DateTimeParser::parseAMPM(it, end, hour);
+			break;
+		case 'M':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(minute, 2);
+			break;
+		case 'S':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(second, 2);
+			break;
+		case 's':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(second, 2);
+			if (it != end && (*it == '.' || *it == ','))
+			{
+				++it;
+				PARSE_FRACTIONAL_N(millis, 3);
+				PARSE_FRACTIONAL_N(micros, 3);
+				SKIP_DIGITS();
+			}
+			break;
+		case 'i':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(millis, 3);
+			break;
+		case 'c':
+			SKIP_JUNK();
+			PARSE_NUMBER_N(millis, 1);
+			millis *= 100;
+			break;
+		case 'F':
+			SKIP_JUNK();
+			PARSE_FRACTIONAL_N(millis, 3);
+			PARSE_FRACTIONAL_N(micros, 3);
+			SKIP_DIGITS();
+			break;
+		case 'z':
+		case 'Z':
+			tzd = DateTimeParser::parseTZD(it, end);
+			break;
+		}
+	}
+	if (month == 0) month = 1;
+	if (day == 0) day = 1;
+	if (DateTime::isValid(year, month, day, hour, minute, second, millis, micros))
+		dateTime.assign(year, month, day, hour, minute, second, millis, micros);
+	else
+		throw SyntaxException("date/time component out of range");
+	timeZoneDifferential = tzd;
+}
+
+
+bool DateTimePattern::parseISO8601(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const
+{
+	// Accepts YYYY-MM-DDTHH:MM:SS, with a fraction for ISO8601_FRAC_FORMAT,
+	// followed by nothing, Z, +HH:MM or +HHMM. Anything else is left to
+	// parseGeneric(), so that the result is always the same.
+	const char* p   = str.data();
+	const char* end = p + str.size();
+	if (end - p < 19 || p[4] != '-' || p[7] != '-' || p[10] != 'T' || p[13] != ':' || p[16] != ':')
+		return false;
+
+	int year, month, day, hour, minute, second;
+	if (!readDigits(p, 4, year) || !readDigits(p + 5, 2, month) || !readDigits(p + 8, 2, day) ||
+	    !readDigits(p + 11, 2, hour) || !readDigits(p + 14, 2, minute) || !readDigits(p + 17, 2, second))
+		return false;
+	p += 19;
+
+	int millis = 0;
+	int micros = 0;
+	if (_kind == KIND_ISO8601_FRAC && p != end && (*p == '.' || *p == ','))
+	{
+		int n = 0;
+		for (++p; p != end && Ascii::isDigit(*p); ++p, ++n)
+		{
+			if (n < 3)
+				millis = millis*10 + (*p - '0');
+			else if (n < 6)
+				micros = micros*10 + (*p - '0');
+		}
+		for (int i = n; i < 3; ++i) millis *= 10;
+		for (int i = n < 3 ? 3 : n; i < 6; ++i) micros *= 10;
+	}
+
+	int tzd = 0;
+	if (p != end)
+	{
+		if (*p == 'Z')
+		{
+			++p;
+		}
+		else if (*p == '+' || *p == '-')
+		{
+			int sign = *p == '+' ? 1 : -1;
+			int tzHours, tzMinutes;
+			if (end - p == 6 && p[3] == ':' && readDigits(p + 1, 2, tzHours) && readDigits(p + 4, 2, tzMinutes))
+				p += 6;
+			else if (end - p == 5 && readDigits(p + 1, 2, tzHours) && readDigits(p + 3, 2, tzMinutes))
+				p += 5;
+			else
+				return false;
+			tzd = sign*(tzHours*3600 + tzMinutes*60);
+		}
+		if (p != end) return false;
+	}
+
+	if (month == 0) month = 1;
+	if (day == 0) day = 1;
+	if (!DateTime::isValid(year, month, day, hour, minute, second, millis, micros))
+		return false;
+	dateTime.assign(year, month, day, hour, minute, second, millis, micros);
+	timeZoneDifferential = tzd;
+	return true;
+}
+
+
+bool DateTimePattern::parseRFC1123(const std::string& str, DateTime& dateTime, int& timeZoneDifferential) const
+{
+	// Accepts Www, D[D] Mon YYYY HH:MM:SS followed by GMT or +HHMM.
+	// Anything else is left to parseGeneric(), so that the result
+	// is always the same.
+	const char* p   = str.data();
+	const char* end = p + str.size();
+	if (end - p < 28 || !Ascii::isAlpha(p[0]) || !Ascii::isAlpha(p[1]) || !Ascii::isAlpha(p[2]) || p[3] != ',' || p[4] != ' ')
+		return false;
+	p += 5;
+
+	int day;
+	if (readDigits(p, 2, day) && p[2] == ' ')
+		p += 3;
+	else if (readDigits(p, 1, day) && p[1] == ' ')
+		p += 2;
+	else
+		return false;
+
+	if (end - p < 21 || p[3] != ' ' || p[8] != ' ' || p[11] != ':' || p[14] != ':' || p[17] != ' ')
+		return false;
+	int month = findMonth(p);
+	int year, hour, minute, second;
+	if (month == 0 || !readDigits(p + 4, 4, year) || year < 1000 ||
+	    !readDigits(p + 9, 2, hour) || !readDigits(p + 12, 2, minute) || !readDigits(p + 15, 2, second))
+		return false;
+	p += 18;
+
+	int tzd = 0;
+	if (end - p == 3 && p[0] == 'G' && p[1] == 'M' && p[2] == 'T')
+	{
+		tzd = 0;
+	}
+	else if (end - p == 5 && (*p == '+' || *p == '-'))
+	{
+		int tzHours, tzMinutes;
+		if (!readDigits(p + 1, 2, tzHours) || !readDigits(p + 3, 2, tzMinutes))
+			return false;
+		tzd = (*p == '+' ? 1 : -1)*(tzHours*3600 + tzMinutes*60);
+	}
+	else return false;
+
+	if (day == 0) day = 1;
+	if (!DateTime::isValid(year, month, day, hour, minute, second, 0, 0))
+		return false;
+	dateTime.assign(year, month, day, hour, minute, second);
+	timeZoneDifferential = tzd;
+	return true;
+}
+
+
+const DateTimePattern* DateTimePattern::cached(const std::string& fmt)
+{
+	if (cacheDestroyed) return 0;
+	return &patternCache.get(fmt);
+}
+
+
+} // namespace Poco
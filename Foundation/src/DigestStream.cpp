@@ -59,7 +59,7 @@ int DigestBuf::readFromDevice(char* buffer, std::streamsize length)
 	{
 		_pIstr->read(buffer, length);
 		std::streamsize n = _pIstr->gcount();
-		if (n > 0) _eng.update(buffer, static_cast<unsigned>(n));
+		if (n > 0) _eng.update(buffer, static_cast<std::size_t>(n));
 		return static_cast<int>(n);
 	}
 	return -1;
@@ -68,12 +68,23 @@ int DigestBuf::readFromDevice(char* buffer, std::streamsize length)
 
 int DigestBuf::writeToDevice(const char* buffer, std::streamsize length)
 {
-	_eng.update(buffer, (unsigned) length);
+	_eng.update(buffer, static_cast<std::size_t>(length));
 	if (_pOstr) _pOstr->write(buffer, length);
 	return static_cast<int>(length);
 }
 
 
+std::streamsize DigestBuf::xsputn(const char* s, std::streamsize n)
+{
+	if (n < BUFFER_SIZE) return BufferedStreamBuf::xsputn(s, n);
+
+	if (sync() == -1) return 0;
+	_eng.update(s, static_cast<std::size_t>(n));
+	if (_pOstr) _pOstr->write(s, n);
+	return n;
+}
+
+
 void DigestBuf::close()
 {
 	sync();
@@ -18,12 +18,14 @@
 #include "Poco/PurgeStrategy.h"
 #include "Poco/Message.h"
 #include "Poco/NumberParser.h"
+#include "Poco/NumberFormatter.h"
 #include "Poco/DateTimeFormatter.h"
 #include "Poco/DateTime.h"
 #include "Poco/LocalDateTime.h"
 #include "Poco/String.h"
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
+#include "Poco/LineEndingConverter.h"
 
 
 namespace Poco {
@@ -38,6 +40,9 @@ const std::string FileChannel::PROP_PURGEAGE     = "purgeAge";
 const std::string FileChannel::PROP_PURGECOUNT   = "purgeCount";
 const std::string FileChannel::PROP_FLUSH        = "flush";
 const std::string FileChannel::PROP_ROTATEONOPEN = "rotateOnOpen";
+const std::string FileChannel::PROP_BUFFERSIZE   = "bufferSize";
+const std::string FileChannel::PROP_FLUSHINTERVAL = "flushInterval";
+const std::string FileChannel::PROP_SYNC         = "sync";
 
 FileChannel::FileChannel(): 
 	_times("utc"),
@@ -47,7 +52,14 @@ FileChannel::FileChannel():
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
-	_pPurgeStrategy(0)
+	_pPurgeStrategy(0),
+	_bufferSize(0),
+	_flushInterval(1000),
+	_sync(SYNC_NONE),
+	_purgePending(false),
+	_thread("FileChannel"),
+	_stop(false),
+	_runnable(*this, &FileChannel::run)
 {
 }
 
@@ -61,7 +73,14 @@ FileChannel::FileChannel(const std::string& path):
 	_pFile(0),
 	_pRotateStrategy(0),
 	_pArchiveStrategy(new ArchiveByNumberStrategy),
-	_pPurgeStrategy(0)
+	_pPurgeStrategy(0),
+	_bufferSize(0),
+	_flushInterval(1000),
+	_sync(SYNC_NONE),
+	_purgePending(false),
+	_thread("FileChannel"),
+	_stop(false),
+	_runnable(*this, &FileChannel::run)
 {
 }
 
@@ -92,8 +111,11 @@ void FileChannel::open()
 
 void FileChannel::close()
 {
+	stopBackground();
+
 	FastMutex::ScopedLock lock(_mutex);
 
+	if (_pFile) unsafeCommit();
 	delete _pFile;
 	_pFile = 0;
 }
@@ -105,26 +127,21 @@ void FileChannel::log(const Message& msg)
 
 	unsafeOpen();
 
-	if (_pRotateStrategy && _pArchiveStrategy && _pRotateStrategy->mustRotate(_pFile))
+	if (_bufferSize > 0)
 	{
-		try
-		{
-			_pFile = _pArchiveStrategy->archive(_pFile);
-			purge();
-		}
-		catch (...)
-		{
-			_pFile = new LogFile(_path);
-		}
-		// we must call mustRotate() again to give the
-		// RotateByIntervalStrategy a chance to write its timestamp
-		// to the new file.
-		_pRotateStrategy->mustRotate(_pFile);
+		if (_buffer.empty()) _bufferTime.update();
+		_buffer.append(msg.getText());
+		_buffer.append(LineEnding::NEWLINE_DEFAULT);
+		if (_buffer.size() >= _bufferSize) unsafeCommit();
+		return;
 	}
 
+	unsafeRotate();
+
 	try
 	{
 	_pFile->write(msg.getText(), _flush);
+	if (_flush && _sync != SYNC_NONE) _pFile->sync(_sync == SYNC_DATA);
     }
     catch (const WriteFileException & e)
     {
@@ -142,6 +159,15 @@ void FileChannel::log(const Message& msg)
     }
 }
 
+
+
+void FileChannel::flush()
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	if (_pFile) unsafeCommit();
+}
+
 	
 void FileChannel::setProperty(const std::string& name, const std::string& value)
 {
@@ -173,6 +199,12 @@ void FileChannel::setProperty(const std::string& name, const std::string& value)
 		setFlush(value);
 	else if (name == PROP_ROTATEONOPEN)
 		setRotateOnOpen(value);
+	else if (name == PROP_BUFFERSIZE)
+		setBufferSize(value);
+	else if (name == PROP_FLUSHINTERVAL)
+		setFlushInterval(value);
+	else if (name == PROP_SYNC)
+		setSync(value);
 	else
 		Channel::setProperty(name, value);
 }
@@ -198,6 +230,12 @@ std::string FileChannel::getProperty(const std::string& name) const
 		return std::string(_flush ? "true" : "false");
 	else if (name == PROP_ROTATEONOPEN)
 		return std::string(_rotateOnOpen ? "true" : "false");
+	else if (name == PROP_BUFFERSIZE)
+		return NumberFormatter::format(_bufferSize);
+	else if (name == PROP_FLUSHINTERVAL)
+		return NumberFormatter::format(_flushInterval);
+	else if (name == PROP_SYNC)
+		return std::string(_sync == SYNC_FULL ? "full" : (_sync == SYNC_DATA ? "data" : "none"));
 	else
 		return Channel::getProperty(name);
 }
@@ -346,8 +384,57 @@ void FileChannel::setRotateOnOpen(const std::string& rotateOnOpen)
 }
 
 
+void FileChannel::setBufferSize(const std::string& size)
+{
+	std::string::const_iterator it  = size.begin();
+	std::string::const_iterator end = size.end();
+	std::size_t n = 0;
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	while (it != end && Ascii::isDigit(*it)) { n *= 10; n += *it++ - '0'; }
+	while (it != end && Ascii::isSpace(*it)) ++it;
+	std::string unit;
+	while (it != end && Ascii::isAlpha(*it)) unit += *it++;
+
+	if (unit == "K")
+		n *= 1024;
+	else if (unit == "M")
+		n *= 1024*1024;
+	else if (!unit.empty())
+		throw InvalidArgumentException("bufferSize", size);
+
+	if (n == 0 && _pFile) unsafeCommit();
+	_bufferSize = n;
+	_buffer.reserve(n);
+	if (_bufferSize > 0 && _pFile) startBackground();
+}
+
+
+void FileChannel::setFlushInterval(const std::string& interval)
+{
+	long ms = NumberParser::parse(interval);
+	if (ms <= 0) throw InvalidArgumentException("flushInterval", interval);
+	_flushInterval = ms;
+	_wakeUp.set();
+}
+
+
+void FileChannel::setSync(const std::string& sync)
+{
+	if (icompare(sync, "none") == 0)
+		_sync = SYNC_NONE;
+	else if (icompare(sync, "data") == 0)
+		_sync = SYNC_DATA;
+	else if (icompare(sync, "full") == 0)
+		_sync = SYNC_FULL;
+	else
+		throw InvalidArgumentException("sync", sync);
+}
+
+
 void FileChannel::purge()
 {
+	FastMutex::ScopedLock lock(_purgeMutex);
+
 	if (_pPurgeStrategy)
 	{
 		try
@@ -365,6 +452,7 @@ void FileChannel::unsafeOpen()
 {
 	if (!_pFile)
 	{
+		if (_bufferSize > 0) startBackground();
 		_pFile = new LogFile(_path);
 		if (_rotateOnOpen && _pFile->size() > 0)
 		{
@@ -382,10 +470,114 @@ void FileChannel::unsafeOpen()
 }
 
 
+void FileChannel::unsafeRotate()
+{
+	if (_pRotateStrategy && _pArchiveStrategy && _pRotateStrategy->mustRotate(_pFile))
+	{
+		try
+		{
+			_pFile = _pArchiveStrategy->archive(_pFile);
+			if (_bufferSize > 0)
+			{
+				_purgePending = true;
+				_wakeUp.set();
+			}
+			else purge();
+		}
+		catch (...)
+		{
+			_pFile = new LogFile(_path);
+		}
+		// we must call mustRotate() again to give the
+		// RotateByIntervalStrategy a chance to write its timestamp
+		// to the new file.
+		_pRotateStrategy->mustRotate(_pFile);
+	}
+}
+
+
+void FileChannel::unsafeCommit()
+{
+	if (_buffer.empty() || !_pFile) return;
+
+	unsafeRotate();
+
+	try
+	{
+		_pFile->writeBuffer(_buffer, true);
+		if (_sync != SYNC_NONE) _pFile->sync(_sync == SYNC_DATA);
+	}
+	catch (const WriteFileException&)
+	{
+		// see log()
+		if (errno == ENOSPC)
+		{
+			PurgeOneFileStrategy().purge(_path);
+		}
+	}
+	_buffer.clear();
+}
+
+
+void FileChannel::run()
+{
+	for (;;)
+	{
+		bool purgeNow = false;
+		long wait = 0;
+		{
+			FastMutex::ScopedLock lock(_mutex);
+
+			if (!_buffer.empty() && _bufferTime.isElapsed(Timespan::TimeDiff(_flushInterval)*1000))
+			{
+				unsafeCommit();
+			}
+			purgeNow = _purgePending;
+			_purgePending = false;
+			wait = _flushInterval;
+			if (!_buffer.empty())
+			{
+				wait -= static_cast<long>(_bufferTime.elapsed()/1000);
+				if (wait < 1) wait = 1;
+			}
+		}
+		if (purgeNow) purge();
+		if (_stop) break;
+		_wakeUp.tryWait(wait);
+	}
+}
+
+
+void FileChannel::startBackground()
+{
+	// called with _mutex held
+	if (!_thread.isRunning())
+	{
+		_stop = false;
+		_thread.start(_runnable);
+	}
+}
+
+
+void FileChannel::stopBackground()
+{
+	FastMutex::ScopedLock lock(_backgroundMutex);
+
+	if (_thread.isRunning())
+	{
+		_stop = true;
+		_wakeUp.set();
+		_thread.join();
+	}
+}
+
+
 bool FileChannel::setNoPurge(const std::string& value)
 {
 	if (value.empty() || 0 == icompare(value, "none"))
 	{
+		FastMutex::ScopedLock lock(_purgeMutex);
+
 		delete _pPurgeStrategy;
 		_pPurgeStrategy = 0;
 		_purgeAge = "none";
@@ -418,6 +610,8 @@ int FileChannel::extractDigit(const std::string& value, std::string::const_itera
 
 void FileChannel::setPurgeStrategy(PurgeStrategy* strategy)
 {
+	FastMutex::ScopedLock lock(_purgeMutex);
+
 	delete _pPurgeStrategy;
 	_pPurgeStrategy = strategy;
 }
@@ -121,6 +121,35 @@ bool FileStreamBuf::close()
 }
 
 
+void FileStreamBuf::flushToDisk(bool dataOnly)
+{
+	if (_fd != -1 && (getMode() & std::ios::out))
+	{
+		if (sync() == -1) throw WriteFileException(_path);
+#if POCO_OS == POCO_OS_LINUX
+		int rc = dataOnly ? fdatasync(_fd) : fsync(_fd);
+#else
+		int rc = fsync(_fd);
+#endif
+		if (rc != 0) File::handleLastError(_path);
+	}
+}
+
+
+int FileStreamBuf::nativeDescriptor(std::ios::openmode which) const
+{
+	if (!(getMode() & which)) return -1;
+	if ((which & std::ios::out) && (getMode() & std::ios::app)) return -1;
+	return _fd;
+}
+
+
+void FileStreamBuf::nativeTransferred(std::ios::openmode which, std::streamsize n)
+{
+	_pos += n;
+}
+
+
 std::streampos FileStreamBuf::seekoff(std::streamoff off, std::ios::seekdir dir, std::ios::openmode mode)
 {
 	if (_fd == -1 || !(getMode() & mode)) 
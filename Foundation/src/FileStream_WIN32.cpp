@@ -146,6 +146,16 @@ bool FileStreamBuf::close()
 }
 
 
+void FileStreamBuf::flushToDisk(bool)
+{
+	if (_handle != INVALID_HANDLE_VALUE && (getMode() & std::ios::out))
+	{
+		if (sync() == -1) throw WriteFileException(_path);
+		if (!FlushFileBuffers(_handle)) File::handleLastError(_path);
+	}
+}
+
+
 std::streampos FileStreamBuf::seekoff(std::streamoff off, std::ios::seekdir dir, std::ios::openmode mode)
 {
 	if (INVALID_HANDLE_VALUE == _handle || !(getMode() & mode))
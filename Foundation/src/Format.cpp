@@ -15,10 +15,10 @@
 #include "Poco/Format.h"
 #include "Poco/Exception.h"
 #include "Poco/Ascii.h"
-#include <sstream>
-#if !defined(POCO_NO_LOCALE)
-#include <locale>
-#endif
+#include "Poco/NumericString.h"
+#include <algorithm>
+#include <clocale>
+#include <cstdio>
 #include <cstddef>
 
 
@@ -27,449 +27,605 @@ namespace Poco {
 
 namespace
 {
-	void parseFlags(std::ostream& str, std::string::const_iterator& itFmt, const std::string::const_iterator& endFmt)
+	class StringWriter
+		/// Appends formatted output to a std::string.
 	{
-		bool isFlag = true;
-		while (isFlag && itFmt != endFmt)
+	public:
+		StringWriter(std::string& result):
+			_result(result)
 		{
-			switch (*itFmt)
-			{
-			case '-': str.setf(std::ios::left); ++itFmt; break;
-			case '+': str.setf(std::ios::showpos); ++itFmt; break;
-			case '0': str.fill('0'); str.setf(std::ios::internal); ++itFmt; break;
-			case '#': str.setf(std::ios::showpoint | std::ios::showbase); ++itFmt; break;
-			default:  isFlag = false; break;
-			}
 		}
-	}
 
+		void write(const char* data, std::size_t length)
+		{
+			_result.append(data, length);
+		}
 
-	void parseWidth(std::ostream& str, std::string::const_iterator& itFmt, const std::string::const_iterator& endFmt)
+		void fill(std::size_t length, char c)
+		{
+			_result.append(length, c);
+		}
+
+	private:
+		std::string& _result;
+	};
+
+
+	class BufferWriter
+		/// Writes formatted output to a fixed-size buffer, and
+		/// counts the characters that do not fit.
 	{
-		int width = 0;
-		while (itFmt != endFmt && Ascii::isDigit(*itFmt))
+	public:
+		BufferWriter(char* buffer, std::size_t size):
+			_buffer(buffer),
+			_size(size),
+			_length(0)
 		{
-			width = 10*width + *itFmt - '0';
-			++itFmt;
 		}
-		if (width != 0) str.width(width);
+
+		void write(const char* data, std::size_t length)
+		{
+			if (_length < _size) std::memcpy(_buffer + _length, data, std::min(length, _size - _length));
+			_length += length;
+		}
+
+		void fill(std::size_t length, char c)
+		{
+			if (_length < _size) std::memset(_buffer + _length, c, std::min(length, _size - _length));
+			_length += length;
+		}
+
+		std::size_t length() const
+		{
+			return _length;
+		}
+
+	private:
+		char*       _buffer;
+		std::size_t _size;
+		std::size_t _length;
+	};
+
+
+	typedef FormatString::Spec Spec;
+
+
+	template <typename T>
+	inline FormatArg::Type typeOf()
+	{
+		return FormatArg(T()).type();
 	}
-	
-	
-	void parsePrec(std::ostream& str, std::string::const_iterator& itFmt, const std::string::const_iterator& endFmt)
+
+
+	const char* parseSpec(const char* it, const char* end, Spec& spec)
+		/// Parses flags, width, precision, modifier and type of a format
+		/// specification. spec.type is 0 if the format string ends early.
 	{
-		if (itFmt != endFmt && *itFmt == '.')
+		spec.left = spec.showPos = spec.zeroPad = spec.alternate = false;
+		bool isFlag = true;
+		while (isFlag && it != end)
 		{
-			++itFmt;
-			int prec = 0;
-			while (itFmt != endFmt && Ascii::isDigit(*itFmt))
+			switch (*it)
 			{
-				prec = 10*prec + *itFmt - '0';
-				++itFmt;
+			case '-': spec.left = true; ++it; break;
+			case '+': spec.showPos = true; ++it; break;
+			case '0': spec.zeroPad = true; ++it; break;
+			case '#': spec.alternate = true; ++it; break;
+			default:  isFlag = false; break;
 			}
-			if (prec >= 0) str.precision(prec);
 		}
-	}
-	
-	char parseMod(std::string::const_iterator& itFmt, const std::string::const_iterator& endFmt)
-	{
-		char mod = 0;
-		if (itFmt != endFmt)
+		spec.width = 0;
+		while (it != end && Ascii::isDigit(*it))
+		{
+			spec.width = 10*spec.width + *it - '0';
+			++it;
+		}
+		spec.precision = 6;
+		if (it != end && *it == '.')
+		{
+			++it;
+			spec.precision = 0;
+			while (it != end && Ascii::isDigit(*it))
+			{
+				spec.precision = 10*spec.precision + *it - '0';
+				++it;
+			}
+		}
+		spec.modifier = 0;
+		if (it != end)
 		{
-			switch (*itFmt)
+			switch (*it)
 			{
 			case 'l':
 			case 'h':
-			case 'L': 
-			case '?': mod = *itFmt++; break;
+			case 'L':
+			case '?': spec.modifier = *it++; break;
 			}
 		}
-		return mod;
+		spec.type = it != end ? *it++ : 0;
+		return it;
 	}
-	
-	std::size_t parseIndex(std::string::const_iterator& itFmt, const std::string::const_iterator& endFmt)
+
+
+	const char* parseIndex(const char* it, const char* end, int& index)
 	{
-		int index = 0;
-		while (itFmt != endFmt && Ascii::isDigit(*itFmt))
+		index = 0;
+		while (it != end && Ascii::isDigit(*it))
 		{
-			index = 10*index + *itFmt - '0';
-			++itFmt;
+			index = 10*index + *it - '0';
+			++it;
 		}
-		if (itFmt != endFmt && *itFmt == ']') ++itFmt;
-		return index;
+		if (it != end && *it == ']') ++it;
+		return it;
 	}
 
-	void prepareFormat(std::ostream& str, char type)
+
+	bool consumesValue(char type)
+		/// Returns true if a specification of the given type
+		/// formats a value.
 	{
 		switch (type)
 		{
-		case 'd':
-		case 'i': str << std::dec; break;
-		case 'o': str << std::oct; break;
-		case 'x': str << std::hex; break;
-		case 'X': str << std::hex << std::uppercase; break;
-		case 'e': str << std::scientific; break;
-		case 'E': str << std::scientific << std::uppercase; break;
-		case 'f': str << std::fixed; break;
+		case 'b': case 'c': case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+		case 'e': case 'E': case 'f': case 's': case 'z':
+			return true;
+		default:
+			return false;
 		}
 	}
-	
-	
-	void writeAnyInt(std::ostream& str, const Any& any)
-	{
-		if (any.type() == typeid(char))
-			str << static_cast<int>(AnyCast<char>(any));
-		else if (any.type() == typeid(signed char))
-			str << static_cast<int>(AnyCast<signed char>(any));
-		else if (any.type() == typeid(unsigned char))
-			str << static_cast<unsigned>(AnyCast<unsigned char>(any));
-		else if (any.type() == typeid(short))
-			str << AnyCast<short>(any);
-		else if (any.type() == typeid(unsigned short))
-			str << AnyCast<unsigned short>(any);
-		else if (any.type() == typeid(int))
-			str << AnyCast<int>(any);
-		else if (any.type() == typeid(unsigned int))
-			str << AnyCast<unsigned int>(any);
-		else if (any.type() == typeid(long))
-			str << AnyCast<long>(any);
-		else if (any.type() == typeid(unsigned long))
-			str << AnyCast<unsigned long>(any);
-		else if (any.type() == typeid(Int64))
-			str << AnyCast<Int64>(any);
-		else if (any.type() == typeid(UInt64))
-			str << AnyCast<UInt64>(any);
-		else if (any.type() == typeid(bool))
-			str << AnyCast<bool>(any);
-	}
 
 
-	void formatOne(std::string& result, std::string::const_iterator& itFmt, const std::string::const_iterator& endFmt, std::vector<Any>::const_iterator& itVal)
+	template <class W>
+	void writePadded(W& writer, const Spec& spec, const char* data, std::size_t length, bool numeric)
+		/// Writes data padded to the field width the way std::ostream
+		/// does: the 0 flag pads numbers after their sign or base prefix,
+		/// and the - flag left-aligns unless combined with 0.
 	{
-		std::ostringstream str;
-#if !defined(POCO_NO_LOCALE)
-		str.imbue(std::locale::classic());
-#endif
-		try
-		{
-			parseFlags(str, itFmt, endFmt);
-			parseWidth(str, itFmt, endFmt);
-			parsePrec(str, itFmt, endFmt);
-			char mod = parseMod(itFmt, endFmt);
-			if (itFmt != endFmt)
-			{
-				char type = *itFmt++;
-				prepareFormat(str, type);
-				switch (type)
-				{
-				case 'b':
-					str << AnyCast<bool>(*itVal++);
-					break;
-				case 'c':
-					str << AnyCast<char>(*itVal++);
-					break;
-				case 'd':
-				case 'i':
-					switch (mod)
-					{
-					case 'l': str << AnyCast<long>(*itVal++); break;
-					case 'L': str << AnyCast<Int64>(*itVal++); break;
-					case 'h': str << AnyCast<short>(*itVal++); break;
-					case '?': writeAnyInt(str, *itVal++); break;
-					default:  str << AnyCast<int>(*itVal++); break;
-					}
-					break;
-				case 'o':
-				case 'u':
-				case 'x':
-				case 'X':
-					switch (mod)
-					{
-					case 'l': str << AnyCast<unsigned long>(*itVal++); break;
-					case 'L': str << AnyCast<UInt64>(*itVal++); break;
-					case 'h': str << AnyCast<unsigned short>(*itVal++); break;
-					case '?': writeAnyInt(str, *itVal++); break;
-					default:  str << AnyCast<unsigned>(*itVal++); break;
-					}
-					break;
-				case 'e':
-				case 'E':
-				case 'f':
-					switch (mod)
-					{
-					case 'l': str << AnyCast<long double>(*itVal++); break;
-					case 'L': str << AnyCast<long double>(*itVal++); break;
-					case 'h': str << AnyCast<float>(*itVal++); break;
-					default:  str << AnyCast<double>(*itVal++); break;
-					}
-					break;
-				case 's':
-					str << RefAnyCast<std::string>(*itVal++);
-					break;
-				case 'z':
-					str << AnyCast<std::size_t>(*itVal++); 
-					break;
-				case 'I':
-				case 'D':
-				default:
-					str << type;
-				}
-			}
+		std::size_t width = static_cast<std::size_t>(spec.width);
+		if (width <= length)
+		{
+			writer.write(data, length);
+			return;
+		}
+		std::size_t padding = width - length;
+		char fill = spec.zeroPad ? '0' : ' ';
+		if (spec.left && !spec.zeroPad)
+		{
+			writer.write(data, length);
+			writer.fill(padding, fill);
+		}
+		else if (numeric && spec.zeroPad && !spec.left)
+		{
+			std::size_t prefix = 0;
+			if (data[0] == '-' || data[0] == '+')
+				prefix = 1;
+			else if (length > 1 && data[0] == '0' && (data[1] == 'x' || data[1] == 'X'))
+				prefix = 2;
+			writer.write(data, prefix);
+			writer.fill(padding, fill);
+			writer.write(data + prefix, length - prefix);
 		}
-		catch (Poco::BadCastException&)
+		else
 		{
-			str << "[ERRFMT]";
+			writer.fill(padding, fill);
+			writer.write(data, length);
 		}
-		result.append(str.str());
 	}
-}
-
-
-std::string format(const std::string& fmt, const Any& value)
-{
-	std::string result;
-	format(result, fmt, value);
-	return result;
-}
-
-
-std::string format(const std::string& fmt, const Any& value1, const Any& value2)
-{
-	std::string result;
-	format(result, fmt, value1, value2);
-	return result;
-}
-
-
-std::string format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
-{
-	std::string result;
-	format(result, fmt, value1, value2, value3);
-	return result;
-}
-
 
-std::string format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
-{
-	std::string result;
-	format(result, fmt, value1, value2, value3, value4);
-	return result;
-}
 
+	template <class W>
+	void writeError(W& writer, const Spec& spec)
+	{
+		writePadded(writer, spec, "[ERRFMT]", 8, false);
+	}
 
-std::string format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
-{
-	std::string result;
-	format(result, fmt, value1, value2, value3, value4, value5);
-	return result;
-}
 
+	template <class W>
+	void writeInteger(W& writer, const Spec& spec, const FormatArg& value)
+	{
+		const unsigned short base = spec.type == 'o' ? 8 : (spec.type == 'x' || spec.type == 'X' ? 16 : 10);
+		const bool isSigned = value.isSigned() || value.type() == FormatArg::FMT_BOOL;
+		bool negative = false;
+		UInt64 n;
+		if (!isSigned)
+		{
+			n = value.uintValue();
+		}
+		else if (base == 10)
+		{
+			negative = value.intValue() < 0;
+			n = negative ? 0 - static_cast<UInt64>(value.intValue()) : static_cast<UInt64>(value.intValue());
+		}
+		else
+		{
+			// like std::ostream, print octal and hexadecimal
+			// values as the unsigned type of the argument
+			switch (value.type())
+			{
+			case FormatArg::FMT_SHORT:
+				n = static_cast<unsigned short>(value.intValue());
+				break;
+			case FormatArg::FMT_LONG:
+				n = static_cast<unsigned long>(value.intValue());
+				break;
+			case FormatArg::FMT_LONG_LONG:
+				n = static_cast<unsigned long long>(value.intValue());
+				break;
+			default:
+				n = static_cast<unsigned>(value.intValue());
+				break;
+			}
+		}
 
-std::string format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
-{
-	std::string result;
-	format(result, fmt, value1, value2, value3, value4, value5, value6);
-	return result;
-}
+		char buffer[POCO_MAX_INT_STRING_LEN + 2];
+		char* digits = buffer + 2;
+		std::size_t length = POCO_MAX_INT_STRING_LEN;
+		uIntToStr(n, base, digits, length);
+		if (spec.type == 'x')
+		{
+			for (std::size_t i = 0; i < length; ++i)
+				digits[i] = Ascii::toLower(digits[i]);
+		}
 
+		char* begin = digits;
+		if (base == 10)
+		{
+			if (negative)
+				*--begin = '-';
+			else if (spec.showPos && isSigned)
+				*--begin = '+';
+		}
+		else if (spec.alternate && n != 0)
+		{
+			if (base == 16) *--begin = spec.type;
+			*--begin = '0';
+		}
+		writePadded(writer, spec, begin, digits + length - begin, true);
+	}
 
-std::string format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
-{
-	std::string result;
-	format(result, fmt, value1, value2, value3, value4, value5, value6, value7);
-	return result;
-}
 
+	template <typename T>
+	int printFloat(char* buffer, std::size_t size, const Spec& spec, T value, bool isLongDouble)
+	{
+		char fmt[8];
+		char* f = fmt;
+		*f++ = '%';
+		if (spec.showPos) *f++ = '+';
+		if (spec.alternate) *f++ = '#';
+		*f++ = '.';
+		*f++ = '*';
+		if (isLongDouble) *f++ = 'L';
+		*f++ = spec.type;
+		*f = 0;
+		return std::snprintf(buffer, size, fmt, spec.precision, value);
+	}
 
-std::string format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
-{
-	std::string result;
-	format(result, fmt, value1, value2, value3, value4, value5, value6, value7, value8);
-	return result;
-}
 
+	template <class W, typename T>
+	void writeFloat(W& writer, const Spec& spec, T value, bool isLongDouble)
+		/// Uses std::snprintf() like std::ostream does, as it rounds
+		/// exact ties to even, which double-conversion's ToFixed()
+		/// does not.
+	{
+		char buffer[128];
+		int n = printFloat(buffer, sizeof(buffer), spec, value, isLongDouble);
+		if (n < 0) return;
+		std::string large;
+		char* result = buffer;
+		if (static_cast<std::size_t>(n) >= sizeof(buffer))
+		{
+			large.resize(n + 1);
+			result = &large[0];
+			n = printFloat(result, large.size(), spec, value, isLongDouble);
+		}
+		const char point = *std::localeconv()->decimal_point;
+		if (point != '.')
+		{
+			char* p = std::find(result, result + n, point);
+			if (p != result + n) *p = '.';
+		}
+		writePadded(writer, spec, result, n, true);
+	}
 
-std::string format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
-{
-	std::string result;
-	format(result, fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9);
-	return result;
-}
 
+	template <class W>
+	bool formatValue(W& writer, const Spec& spec, const FormatArg& value)
+		/// Formats a value according to spec. Returns true if
+		/// the value has been consumed.
+	{
+		FormatArg::Type expected;
+		switch (spec.type)
+		{
+		case 0:
+			return false;
+		case 'b':
+			expected = FormatArg::FMT_BOOL;
+			break;
+		case 'c':
+			if (value.type() == FormatArg::FMT_CHAR)
+			{
+				const char c = static_cast<char>(value.intValue());
+				writePadded(writer, spec, &c, 1, false);
+			}
+			else writeError(writer, spec);
+			return true;
+		case 'd':
+		case 'i':
+			switch (spec.modifier)
+			{
+			case 'l': expected = FormatArg::FMT_LONG; break;
+			case 'L': expected = typeOf<Int64>(); break;
+			case 'h': expected = FormatArg::FMT_SHORT; break;
+			case '?': expected = value.type(); break;
+			default:  expected = FormatArg::FMT_INT; break;
+			}
+			break;
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+			switch (spec.modifier)
+			{
+			case 'l': expected = FormatArg::FMT_ULONG; break;
+			case 'L': expected = typeOf<UInt64>(); break;
+			case 'h': expected = FormatArg::FMT_USHORT; break;
+			case '?': expected = value.type(); break;
+			default:  expected = FormatArg::FMT_UINT; break;
+			}
+			break;
+		case 'e':
+		case 'E':
+		case 'f':
+			switch (spec.modifier)
+			{
+			case 'l':
+			case 'L': expected = FormatArg::FMT_LONG_DOUBLE; break;
+			case 'h': expected = FormatArg::FMT_FLOAT; break;
+			default:  expected = FormatArg::FMT_DOUBLE; break;
+			}
+			if (value.type() != expected)
+				writeError(writer, spec);
+			else if (expected == FormatArg::FMT_LONG_DOUBLE)
+				writeFloat(writer, spec, value.longDoubleValue(), true);
+			else
+				writeFloat(writer, spec, value.doubleValue(), false);
+			return true;
+		case 's':
+			if (value.type() == FormatArg::FMT_STRING)
+				writePadded(writer, spec, value.stringValue().data(), value.stringValue().size(), false);
+			else if (value.type() == FormatArg::FMT_CSTRING && value.cstringValue())
+				writePadded(writer, spec, value.cstringValue(), std::strlen(value.cstringValue()), false);
+			else
+				writeError(writer, spec);
+			return true;
+		case 'z':
+			expected = typeOf<std::size_t>();
+			break;
+		default:
+			writePadded(writer, spec, &spec.type, 1, false);
+			return false;
+		}
 
-std::string format(const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
-{
-	std::string result;
-	format(result, fmt, value1, value2, value3, value4, value5, value6, value7, value8, value9, value10);
-	return result;
-}
+		// integer types
+		if (!value.isInteger())
+		{
+			// %?d and friends write nothing for non-integer values
+			if (spec.modifier != '?' || spec.type == 'b' || spec.type == 'z') writeError(writer, spec);
+		}
+		else if (value.type() == expected)
+		{
+			writeInteger(writer, spec, value);
+		}
+		else writeError(writer, spec);
+		return true;
+	}
 
 
-void format(std::string& result, const std::string& fmt, const Any& value)
-{
-	std::vector<Any> args;
-	args.push_back(value);
-	format(result, fmt, args);
-}
+	template <class W>
+	void formatRange(W& writer, const char* fmt, const char* it, const char* end, const FormatArg* values, std::size_t count, std::size_t next)
+		/// Formats the format string from it to end, starting
+		/// with the value at index next.
+	{
+		while (it != end)
+		{
+			const char* percent = static_cast<const char*>(std::memchr(it, '%', end - it));
+			if (!percent)
+			{
+				writer.write(it, end - it);
+				break;
+			}
+			writer.write(it, percent - it);
+			it = percent + 1;
+			if (it == end) break;
+			if (*it == '[')
+			{
+				int index;
+				it = parseIndex(it + 1, end, index);
+				if (static_cast<std::size_t>(index) >= count)
+					throw InvalidArgumentException("format argument index out of range", std::string(fmt, end - fmt));
+				Spec spec;
+				it = parseSpec(it, end, spec);
+				formatValue(writer, spec, values[index]);
+			}
+			else if (next < count)
+			{
+				Spec spec;
+				it = parseSpec(it, end, spec);
+				if (formatValue(writer, spec, values[next])) ++next;
+			}
+			else
+			{
+				// copy the specification verbatim, minus the percent sign
+				writer.write(it++, 1);
+			}
+		}
+	}
 
 
-void format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2)
-{
-	std::vector<Any> args;
-	args.push_back(value1);
-	args.push_back(value2);
-	format(result, fmt, args);
+	template <class W>
+	void formatSpecs(W& writer, const std::string& fmt, const std::vector<Spec>& specs, const FormatArg* values, std::size_t count)
+	{
+		const char* begin = fmt.data();
+		std::size_t next = 0;
+		for (std::vector<Spec>::const_iterator it = specs.begin(); it != specs.end(); ++it)
+		{
+			writer.write(begin + it->literalOffset, it->literalLength);
+			if (it->index >= 0)
+			{
+				if (static_cast<std::size_t>(it->index) >= count)
+					throw InvalidArgumentException("format argument index out of range", fmt);
+				formatValue(writer, *it, values[it->index]);
+			}
+			else if (it->index == -1)
+			{
+				if (next < count)
+				{
+					if (formatValue(writer, *it, values[next])) ++next;
+				}
+				else
+				{
+					writer.write(begin + it->offset, 1);
+					formatRange(writer, begin, begin + it->offset + 1, begin + fmt.size(), values, count, next);
+					break;
+				}
+			}
+		}
+	}
 }
 
 
-void format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3)
+FormatArg::FormatArg(const Any& value)
 {
-	std::vector<Any> args;
-	args.push_back(value1);
-	args.push_back(value2);
-	args.push_back(value3);
-	format(result, fmt, args);
+	const std::type_info& type = value.type();
+	if (type == typeid(bool))
+		*this = FormatArg(RefAnyCast<bool>(value));
+	else if (type == typeid(char))
+		*this = FormatArg(RefAnyCast<char>(value));
+	else if (type == typeid(signed char))
+		*this = FormatArg(RefAnyCast<signed char>(value));
+	else if (type == typeid(unsigned char))
+		*this = FormatArg(RefAnyCast<unsigned char>(value));
+	else if (type == typeid(short))
+		*this = FormatArg(RefAnyCast<short>(value));
+	else if (type == typeid(unsigned short))
+		*this = FormatArg(RefAnyCast<unsigned short>(value));
+	else if (type == typeid(int))
+		*this = FormatArg(RefAnyCast<int>(value));
+	else if (type == typeid(unsigned))
+		*this = FormatArg(RefAnyCast<unsigned>(value));
+	else if (type == typeid(long))
+		*this = FormatArg(RefAnyCast<long>(value));
+	else if (type == typeid(unsigned long))
+		*this = FormatArg(RefAnyCast<unsigned long>(value));
+	else if (type == typeid(long long))
+		*this = FormatArg(RefAnyCast<long long>(value));
+	else if (type == typeid(unsigned long long))
+		*this = FormatArg(RefAnyCast<unsigned long long>(value));
+	else if (type == typeid(float))
+		*this = FormatArg(RefAnyCast<float>(value));
+	else if (type == typeid(double))
+		*this = FormatArg(RefAnyCast<double>(value));
+	else if (type == typeid(long double))
+		*this = FormatArg(RefAnyCast<long double>(value));
+	else if (type == typeid(std::string))
+		*this = FormatArg(RefAnyCast<std::string>(value));
+	else if (type == typeid(const char*))
+		*this = FormatArg(RefAnyCast<const char*>(value));
+	else if (type == typeid(char*))
+		*this = FormatArg(RefAnyCast<char*>(value));
+	else
+	{
+		_type = FMT_NONE;
+		_value.intValue = 0;
+	}
 }
 
 
-void format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4)
+FormatString::FormatString(const std::string& fmt):
+	_fmt(fmt),
+	_argumentCount(0)
 {
-	std::vector<Any> args;
-	args.push_back(value1);
-	args.push_back(value2);
-	args.push_back(value3);
-	args.push_back(value4);
-	format(result, fmt, args);
+	const char* begin = _fmt.data();
+	const char* end = begin + _fmt.size();
+	const char* it = begin;
+	std::size_t next = 0;
+	for (;;)
+	{
+		Spec spec;
+		spec.literalOffset = it - begin;
+		spec.index = -2;
+		spec.offset = 0;
+		spec.type = 0;
+		const char* percent = static_cast<const char*>(std::memchr(it, '%', end - it));
+		if (!percent || percent + 1 == end)
+		{
+			spec.literalLength = (percent ? percent : end) - it;
+			_specs.push_back(spec);
+			break;
+		}
+		spec.literalLength = percent - it;
+		it = percent + 1;
+		spec.offset = it - begin;
+		if (*it == '[')
+		{
+			it = parseIndex(it + 1, end, spec.index);
+			_argumentCount = std::max(_argumentCount, static_cast<std::size_t>(spec.index) + 1);
+		}
+		else spec.index = -1;
+		it = parseSpec(it, end, spec);
+		if (spec.index == -1 && consumesValue(spec.type)) ++next;
+		_specs.push_back(spec);
+	}
+	_argumentCount = std::max(_argumentCount, next);
 }
 
 
-void format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5)
+FormatString::~FormatString()
 {
-	std::vector<Any> args;
-	args.push_back(value1);
-	args.push_back(value2);
-	args.push_back(value3);
-	args.push_back(value4);
-	args.push_back(value5);
-	format(result, fmt, args);
 }
 
 
-void format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6)
+void FormatString::vformat(std::string& result, const FormatArg* values, std::size_t count) const
 {
-	std::vector<Any> args;
-	args.push_back(value1);
-	args.push_back(value2);
-	args.push_back(value3);
-	args.push_back(value4);
-	args.push_back(value5);
-	args.push_back(value6);
-	format(result, fmt, args);
+	StringWriter writer(result);
+	formatSpecs(writer, _fmt, _specs, values, count);
 }
 
 
-void format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7)
+std::size_t FormatString::vformatTo(char* buffer, std::size_t size, const FormatArg* values, std::size_t count) const
 {
-	std::vector<Any> args;
-	args.push_back(value1);
-	args.push_back(value2);
-	args.push_back(value3);
-	args.push_back(value4);
-	args.push_back(value5);
-	args.push_back(value6);
-	args.push_back(value7);
-	format(result, fmt, args);
+	BufferWriter writer(buffer, size);
+	formatSpecs(writer, _fmt, _specs, values, count);
+	return writer.length();
 }
 
 
-void format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8)
+void vformat(std::string& result, const char* fmt, std::size_t length, const FormatArg* values, std::size_t count)
 {
-	std::vector<Any> args;
-	args.push_back(value1);
-	args.push_back(value2);
-	args.push_back(value3);
-	args.push_back(value4);
-	args.push_back(value5);
-	args.push_back(value6);
-	args.push_back(value7);
-	args.push_back(value8);
-	format(result, fmt, args);
+	StringWriter writer(result);
+	formatRange(writer, fmt, fmt, fmt + length, values, count, 0);
 }
 
 
-void format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9)
+std::size_t vformatTo(char* buffer, std::size_t size, const char* fmt, std::size_t length, const FormatArg* values, std::size_t count)
 {
-	std::vector<Any> args;
-	args.push_back(value1);
-	args.push_back(value2);
-	args.push_back(value3);
-	args.push_back(value4);
-	args.push_back(value5);
-	args.push_back(value6);
-	args.push_back(value7);
-	args.push_back(value8);
-	args.push_back(value9);
-	format(result, fmt, args);
+	BufferWriter writer(buffer, size);
+	formatRange(writer, fmt, fmt, fmt + length, values, count, 0);
+	return writer.length();
 }
 
 
-void format(std::string& result, const std::string& fmt, const Any& value1, const Any& value2, const Any& value3, const Any& value4, const Any& value5, const Any& value6, const Any& value7, const Any& value8, const Any& value9, const Any& value10)
+void format(std::string& result, const std::string& fmt, const std::vector<Any>& values)
 {
-	std::vector<Any> args;
-	args.push_back(value1);
-	args.push_back(value2);
-	args.push_back(value3);
-	args.push_back(value4);
-	args.push_back(value5);
-	args.push_back(value6);
-	args.push_back(value7);
-	args.push_back(value8);
-	args.push_back(value9);
-	args.push_back(value10);
-	format(result, fmt, args);
+	const std::vector<FormatArg> args(values.begin(), values.end());
+	vformat(result, fmt.data(), fmt.size(), args.data(), args.size());
 }
 
 
-void format(std::string& result, const std::string& fmt, const std::vector<Any>& values)
+void format(std::string& result, const char* fmt, const std::vector<Any>& values)
 {
-	std::string::const_iterator itFmt  = fmt.begin();
-	std::string::const_iterator endFmt = fmt.end();
-	std::vector<Any>::const_iterator itVal  = values.begin();
-	std::vector<Any>::const_iterator endVal = values.end(); 
-	while (itFmt != endFmt)
-	{
-		switch (*itFmt)
-		{
-		case '%':
-			++itFmt;
-			if (itFmt != endFmt && (itVal != endVal || *itFmt == '['))
-			{
-				if (*itFmt == '[')
-				{
-					++itFmt;
-					std::size_t index = parseIndex(itFmt, endFmt);
-					if (index < values.size())
-					{
-						std::vector<Any>::const_iterator it = values.begin() + index;
-						formatOne(result, itFmt, endFmt, it);
-					}
-					else throw InvalidArgumentException("format argument index out of range", fmt);
-				}
-				else
-				{
-					formatOne(result, itFmt, endFmt, itVal);
-				}
-			}
-			else if (itFmt != endFmt)
-			{
-				result += *itFmt++;
-			}
-			break;
-		default:
-			result += *itFmt;
-			++itFmt;
-		}
-	}
+	const std::vector<FormatArg> args(values.begin(), values.end());
+	vformat(result, fmt, std::strlen(fmt), args.data(), args.size());
 }
 
 
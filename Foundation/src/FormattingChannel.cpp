@@ -86,7 +86,9 @@ void FormattingChannel::log(const Message& msg)
 	{
 		if (_pFormatter)
 		{
-			std::string text;
+			// The buffer is reused to avoid growing a new string for every message.
+			static thread_local std::string text;
+			text.clear();
 			_pFormatter->format(msg, text);
 			_pChannel->log(Message(msg, text));
 		}
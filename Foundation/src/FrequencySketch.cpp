@@ -0,0 +1,148 @@
+//
+// FrequencySketch.cpp
+//
+// Library: Foundation
+// Package: Cache
+// Module:  TinyLFUStrategy
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/FrequencySketch.h"
+#include <algorithm>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const UInt64 SEEDS[] =
+	{
+		0xC3A5C85C97CB3127ULL,
+		0xB492B66FBE98F273ULL,
+		0x9AE16A3B2F90404FULL,
+		0xCBF29CE484222325ULL
+	};
+
+	const UInt64 RESET_MASK = 0x7777777777777777ULL;
+	const UInt64 ONE_MASK   = 0x1111111111111111ULL;
+
+	inline int bitCount(UInt64 n)
+	{
+		int count = 0;
+		while (n)
+		{
+			n &= n - 1;
+			++count;
+		}
+		return count;
+	}
+}
+
+
+FrequencySketch::FrequencySketch(std::size_t capacity):
+	_mask(0),
+	_sampleSize(0),
+	_additions(0)
+{
+	std::size_t size = 8;
+	while (size < capacity) size <<= 1;
+	_table.resize(size);
+	_mask = size - 1;
+	_sampleSize = 10*std::max<std::size_t>(capacity, 1);
+}
+
+
+FrequencySketch::~FrequencySketch()
+{
+}
+
+
+void FrequencySketch::increment(std::size_t hash)
+{
+	UInt64 h = spread(hash);
+	int start = static_cast<int>(h & 3) << 2;
+
+	bool added = false;
+	for (int row = 0; row < 4; ++row)
+	{
+		added |= incrementAt(index(h, row), start + row);
+	}
+	if (added && ++_additions >= _sampleSize)
+	{
+		age();
+	}
+}
+
+
+unsigned FrequencySketch::estimate(std::size_t hash) const
+{
+	UInt64 h = spread(hash);
+	int start = static_cast<int>(h & 3) << 2;
+
+	unsigned frequency = MAX_FREQUENCY;
+	for (int row = 0; row < 4; ++row)
+	{
+		unsigned count = static_cast<unsigned>((_table[index(h, row)] >> ((start + row) << 2)) & 0xF);
+		frequency = std::min(frequency, count);
+	}
+	return frequency;
+}
+
+
+void FrequencySketch::clear()
+{
+	std::fill(_table.begin(), _table.end(), UInt64(0));
+	_additions = 0;
+}
+
+
+UInt64 FrequencySketch::spread(std::size_t hash)
+{
+	UInt64 h = static_cast<UInt64>(hash)*0x9E3779B97F4A7C15ULL;
+	return h ^ (h >> 32);
+}
+
+
+int FrequencySketch::index(UInt64 hash, int row) const
+{
+	UInt64 h = (hash + SEEDS[row])*SEEDS[row];
+	h += h >> 32;
+	return static_cast<int>(h & _mask);
+}
+
+
+bool FrequencySketch::incrementAt(int i, int offset)
+{
+	int shift = offset << 2;
+	UInt64 mask = UInt64(0xF) << shift;
+	if ((_table[i] & mask) != mask)
+	{
+		_table[i] += UInt64(1) << shift;
+		return true;
+	}
+	return false;
+}
+
+
+void FrequencySketch::age()
+{
+	// Halve all counters. Counters that are odd lose their remainder,
+	// which is subtracted from the number of additions (each item
+	// increments four counters).
+	std::size_t odd = 0;
+	for (std::vector<UInt64>::iterator it = _table.begin(); it != _table.end(); ++it)
+	{
+		odd += bitCount(*it & ONE_MASK);
+		*it = (*it >> 1) & RESET_MASK;
+	}
+	_additions = odd/4 < _additions ? (_additions - odd/4)/2 : 0;
+}
+
+
+} // namespace Poco
@@ -19,13 +19,18 @@ namespace Poco {
 
 
 std::size_t hash(const std::string& str)
+{
+	return hash(str.data(), str.size());
+}
+
+
+std::size_t hash(const char* str, std::size_t length)
 {
 	std::size_t h = 0;
-	std::string::const_iterator it  = str.begin();
-	std::string::const_iterator end = str.end();
-	while (it != end)
+	const char* end = str + length;
+	while (str != end)
 	{
-		h = h * 0xf4243 ^ *it++;
+		h = h * 0xf4243 ^ *str++;
 	}
 	return h;
 }
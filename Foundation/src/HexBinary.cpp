@@ -0,0 +1,196 @@
+//
+// HexBinary.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  HexBinary
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/HexBinary.h"
+#include "Poco/CPUFeatures.h"
+#include "Poco/Exception.h"
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char DIGITS[] = "0123456789abcdef0123456789ABCDEF";
+
+
+	inline int digitValue(char c)
+	{
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		else if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		else if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		else
+			return -1;
+	}
+
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+
+	POCO_TARGET("ssse3")
+	std::size_t encodeSSSE3(const unsigned char* in, std::size_t length, char* out, const char* digits)
+	{
+		const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+		const __m128i mask = _mm_set1_epi8(0x0F);
+
+		std::size_t i = 0;
+		for (; length - i >= 16; i += 16, out += 32)
+		{
+			const __m128i in16 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+			const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(in16, 4), mask));
+			const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(in16, mask));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(hi, lo));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_unpackhi_epi8(hi, lo));
+		}
+		return i;
+	}
+
+
+	POCO_TARGET("avx2")
+	std::size_t encodeAVX2(const unsigned char* in, std::size_t length, char* out, const char* digits)
+	{
+		const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+		const __m256i mask = _mm256_set1_epi8(0x0F);
+
+		std::size_t i = 0;
+		for (; length - i >= 32; i += 32, out += 64)
+		{
+			// reorder the 64-bit words so that the in-lane unpacks
+			// produce the digits in sequence
+			__m256i in32 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+			in32 = _mm256_permute4x64_epi64(in32, 0xD8);
+			const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(in32, 4), mask));
+			const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(in32, mask));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_unpacklo_epi8(hi, lo));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_unpackhi_epi8(hi, lo));
+		}
+		return i;
+	}
+
+
+	POCO_TARGET("ssse3")
+	inline __m128i digitValues(__m128i c, __m128i& valid)
+	{
+		const __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+		const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+		const __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+		valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isAlpha));
+		return _mm_or_si128(
+			_mm_and_si128(isDigit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+			_mm_and_si128(isAlpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+	}
+
+
+	POCO_TARGET("ssse3")
+	std::size_t decodeSSSE3(const char* in, std::size_t length, unsigned char* out)
+	{
+		const __m128i weights = _mm_set1_epi16(0x0110);
+
+		std::size_t i = 0;
+		for (; length - i >= 32; i += 32, out += 16)
+		{
+			__m128i valid = _mm_set1_epi8(-1);
+			const __m128i v0 = digitValues(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), valid);
+			const __m128i v1 = digitValues(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16)), valid);
+			if (_mm_movemask_epi8(valid) != 0xFFFF) break;
+
+			// combine pairs of digits into bytes: 16*high + low
+			const __m128i b0 = _mm_maddubs_epi16(v0, weights);
+			const __m128i b1 = _mm_maddubs_epi16(v1, weights);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(b0, b1));
+		}
+		return i;
+	}
+
+
+#endif // POCO_HAVE_X86_INTRINSICS
+}
+
+
+std::size_t HexBinary::encode(const void* data, std::size_t length, char* encoded, bool uppercase)
+{
+	const unsigned char* in = static_cast<const unsigned char*>(data);
+	const char* digits = uppercase ? DIGITS + 16 : DIGITS;
+	char* out = encoded;
+
+	std::size_t i = 0;
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	if (CPUFeatures::hasAVX2())
+	{
+		i = encodeAVX2(in, length, out, digits);
+		out += 2*i;
+	}
+	if (CPUFeatures::hasSSSE3())
+	{
+		std::size_t n = encodeSSSE3(in + i, length - i, out, digits);
+		i += n;
+		out += 2*n;
+	}
+#endif
+	for (; i < length; ++i)
+	{
+		*out++ = digits[in[i] >> 4];
+		*out++ = digits[in[i] & 0x0F];
+	}
+	return out - encoded;
+}
+
+
+std::string HexBinary::encode(const void* data, std::size_t length, bool uppercase)
+{
+	std::string result(2*length, '\0');
+	if (!result.empty()) encode(data, length, &result[0], uppercase);
+	return result;
+}
+
+
+std::size_t HexBinary::decode(const char* encoded, std::size_t length, void* data)
+{
+	if (length % 2 != 0) throw DataFormatException("Incomplete hexadecimal encoding");
+
+	unsigned char* out = static_cast<unsigned char*>(data);
+	std::size_t i = 0;
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	if (CPUFeatures::hasSSSE3())
+	{
+		i = decodeSSSE3(encoded, length, out);
+		out += i/2;
+	}
+#endif
+	for (; i < length; i += 2)
+	{
+		int hi = digitValue(encoded[i]);
+		int lo = digitValue(encoded[i + 1]);
+		if (hi < 0 || lo < 0) throw DataFormatException("Invalid hexadecimal digit");
+		*out++ = static_cast<unsigned char>((hi << 4) | lo);
+	}
+	return out - static_cast<unsigned char*>(data);
+}
+
+
+std::string HexBinary::decode(const std::string& encoded)
+{
+	std::string result(encoded.size()/2, '\0');
+	if (!result.empty()) decode(encoded.data(), encoded.size(), &result[0]);
+	return result;
+}
+
+
+} // namespace Poco
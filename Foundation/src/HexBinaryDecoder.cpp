@@ -13,6 +13,7 @@
 
 
 #include "Poco/HexBinaryDecoder.h"
+#include "Poco/HexBinary.h"
 #include "Poco/Exception.h"
 
 
@@ -64,6 +65,43 @@ int HexBinaryDecoderBuf::readOne()
 }
 
 
+std::streamsize HexBinaryDecoderBuf::xsgetn(char* s, std::streamsize n)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	if (n <= 0) return 0;
+
+	// the first character goes through uflow(), which takes care
+	// of a character that has been peeked at or put back
+	int c = uflow();
+	if (c == eof) return 0;
+	s[0] = static_cast<char>(c);
+	std::streamsize copied = 1;
+
+	char buffer[BLOCK_SIZE];
+	while (copied < n)
+	{
+		std::streamsize requested = 2*(n - copied);
+		if (requested > BLOCK_SIZE) requested = BLOCK_SIZE;
+		std::streamsize length = 0;
+		while (length < requested)
+		{
+			std::streamsize got = _buf.sgetn(buffer + length, requested - length);
+			if (got <= 0) break;
+			const char* end = buffer + length + got;
+			for (const char* p = buffer + length; p < end; ++p)
+			{
+				char ch = *p;
+				if (ch != ' ' && ch != '\r' && ch != '\t' && ch != '\n') buffer[length++] = ch;
+			}
+		}
+		copied += static_cast<std::streamsize>(HexBinary::decode(buffer, static_cast<std::size_t>(length), s + copied));
+		if (length < requested) break;
+	}
+	return copied;
+}
+
+
 HexBinaryDecoderIOS::HexBinaryDecoderIOS(std::istream& istr): _buf(istr)
 {
 	poco_ios_init(&_buf);
@@ -13,6 +13,7 @@
 
 
 #include "Poco/HexBinaryEncoder.h"
+#include "Poco/HexBinary.h"
 
 
 namespace Poco {
@@ -74,6 +75,37 @@ int HexBinaryEncoderBuf::writeToDevice(char c)
 }
 
 
+std::streamsize HexBinaryEncoderBuf::xsputn(const char* s, std::streamsize n)
+{
+	static const int eof = std::char_traits<char>::eof();
+
+	char buffer[2*BLOCK_SIZE];
+	std::streamsize written = 0;
+	while (written < n)
+	{
+		// encode up to the end of the line in one go
+		std::streamsize length = n - written;
+		if (length > BLOCK_SIZE) length = BLOCK_SIZE;
+		if (_lineLength > 0)
+		{
+			std::streamsize bytesPerLine = (_lineLength - _pos + 1)/2;
+			if (bytesPerLine < 1) bytesPerLine = 1;
+			if (length > bytesPerLine) length = bytesPerLine;
+		}
+		std::streamsize encoded = static_cast<std::streamsize>(HexBinary::encode(s + written, static_cast<std::size_t>(length), buffer, _uppercase != 0));
+		if (_buf.sputn(buffer, encoded) != encoded) break;
+		written += length;
+		_pos += static_cast<int>(encoded);
+		if (_lineLength > 0 && _pos >= _lineLength)
+		{
+			if (_buf.sputc('\n') == eof) break;
+			_pos = 0;
+		}
+	}
+	return written;
+}
+
+
 int HexBinaryEncoderBuf::close()
 {
 	sync();
@@ -0,0 +1,717 @@
+//
+// IOUring.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  IOUring
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/IOUring.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <cstring>
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(IORING_FEAT_FAST_POLL)
+#define POCO_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+
+#if !defined(MSG_NOSIGNAL)
+#define MSG_NOSIGNAL 0
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	enum Opcode
+	{
+		OP_READ,
+		OP_WRITE,
+		OP_READ_FIXED,
+		OP_WRITE_FIXED,
+		OP_FSYNC,
+		OP_RECV,
+		OP_SEND,
+		OP_POLL,
+		OP_TIMEOUT
+	};
+}
+
+
+#if defined(POCO_HAVE_IO_URING)
+
+
+struct IOUring::Ring
+{
+	int           fd;
+	void*         sqPtr;
+	std::size_t   sqSize;
+	void*         cqPtr;
+	std::size_t   cqSize;
+	io_uring_sqe* sqes;
+	std::size_t   sqesSize;
+	unsigned*     sqHead;
+	unsigned*     sqTail;
+	unsigned      sqMask;
+	unsigned      sqEntries;
+	unsigned*     cqHead;
+	unsigned*     cqTail;
+	unsigned      cqMask;
+	io_uring_cqe* cqes;
+	unsigned      toSubmit;
+	Int64         timeout[2];
+	bool          hasBuffers;
+	bool          hasFiles;
+};
+
+
+namespace
+{
+	int setupRing(unsigned entries, io_uring_params& params)
+	{
+		std::memset(&params, 0, sizeof(params));
+#if defined(IORING_SETUP_CLAMP)
+		params.flags = IORING_SETUP_CLAMP;
+#endif
+		int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+		if (fd >= 0 && !(params.features & IORING_FEAT_FAST_POLL))
+		{
+			// kernels before 5.7 lack some of the operations we need
+			::close(fd);
+			fd = -1;
+		}
+		return fd;
+	}
+}
+
+
+#endif
+
+
+IOUring::IOUring(unsigned entries, Mode mode):
+	_pRing(0),
+	_pending(0)
+{
+	poco_assert (entries > 0);
+	(void) mode;
+
+#if defined(POCO_HAVE_IO_URING)
+	if (mode == MODE_AUTO)
+	{
+		io_uring_params params;
+		int fd = setupRing(entries, params);
+		if (fd >= 0)
+		{
+			Ring* pRing = new Ring;
+			std::memset(pRing, 0, sizeof(Ring));
+			pRing->fd = fd;
+			pRing->sqSize = params.sq_off.array + params.sq_entries*sizeof(unsigned);
+			pRing->cqSize = params.cq_off.cqes + params.cq_entries*sizeof(io_uring_cqe);
+			pRing->sqesSize = params.sq_entries*sizeof(io_uring_sqe);
+			bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+			if (singleMmap)
+			{
+				if (pRing->cqSize > pRing->sqSize) pRing->sqSize = pRing->cqSize;
+				pRing->cqSize = pRing->sqSize;
+			}
+			pRing->sqPtr = ::mmap(0, pRing->sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+			if (pRing->sqPtr != MAP_FAILED)
+			{
+				if (singleMmap)
+					pRing->cqPtr = pRing->sqPtr;
+				else
+					pRing->cqPtr = ::mmap(0, pRing->cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+				if (pRing->cqPtr != MAP_FAILED)
+				{
+					void* sqes = ::mmap(0, pRing->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+					if (sqes != MAP_FAILED)
+					{
+						char* sq = static_cast<char*>(pRing->sqPtr);
+						char* cq = static_cast<char*>(pRing->cqPtr);
+						pRing->sqes      = static_cast<io_uring_sqe*>(sqes);
+						pRing->sqHead    = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+						pRing->sqTail    = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+						pRing->sqMask    = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+						pRing->sqEntries = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+						pRing->cqHead    = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+						pRing->cqTail    = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+						pRing->cqMask    = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+						pRing->cqes      = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+						// SQEs are always consumed in order, so the indirection
+						// array can be set up once.
+						unsigned* sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+						for (unsigned i = 0; i < pRing->sqEntries; ++i) sqArray[i] = i;
+
+						_pRing = pRing;
+						return;
+					}
+					if (!singleMmap) ::munmap(pRing->cqPtr, pRing->cqSize);
+				}
+				::munmap(pRing->sqPtr, pRing->sqSize);
+			}
+			int err = errno;
+			::close(fd);
+			delete pRing;
+			throw SystemException("Cannot map io_uring", err);
+		}
+	}
+#endif
+}
+
+
+IOUring::~IOUring()
+{
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing)
+	{
+		::munmap(_pRing->sqes, _pRing->sqesSize);
+		if (_pRing->cqPtr != _pRing->sqPtr) ::munmap(_pRing->cqPtr, _pRing->cqSize);
+		::munmap(_pRing->sqPtr, _pRing->sqSize);
+		::close(_pRing->fd);
+		delete _pRing;
+	}
+#endif
+}
+
+
+void IOUring::read(int fd, void* buffer, std::size_t length, UInt64 offset, const Callback& callback, int options)
+{
+	queue(OP_READ, fd, buffer, length, offset, 0, -1, callback, options);
+}
+
+
+void IOUring::write(int fd, const void* buffer, std::size_t length, UInt64 offset, const Callback& callback, int options)
+{
+	queue(OP_WRITE, fd, const_cast<void*>(buffer), length, offset, 0, -1, callback, options);
+}
+
+
+void IOUring::readFixed(int fd, void* buffer, std::size_t length, UInt64 offset, int bufferIndex, const Callback& callback, int options)
+{
+	queue(OP_READ_FIXED, fd, buffer, length, offset, 0, bufferIndex, callback, options);
+}
+
+
+void IOUring::writeFixed(int fd, const void* buffer, std::size_t length, UInt64 offset, int bufferIndex, const Callback& callback, int options)
+{
+	queue(OP_WRITE_FIXED, fd, const_cast<void*>(buffer), length, offset, 0, bufferIndex, callback, options);
+}
+
+
+void IOUring::fsync(int fd, bool dataOnly, const Callback& callback, int options)
+{
+	queue(OP_FSYNC, fd, 0, 0, 0, dataOnly ? 1 : 0, -1, callback, options);
+}
+
+
+void IOUring::receive(int fd, void* buffer, std::size_t length, int flags, const Callback& callback, int options)
+{
+	queue(OP_RECV, fd, buffer, length, 0, flags, -1, callback, options);
+}
+
+
+void IOUring::send(int fd, const void* buffer, std::size_t length, int flags, const Callback& callback, int options)
+{
+	queue(OP_SEND, fd, const_cast<void*>(buffer), length, 0, flags | MSG_NOSIGNAL, -1, callback, options);
+}
+
+
+void IOUring::pollAdd(int fd, int events, const Callback& callback, int options)
+{
+	int pollEvents = 0;
+	if (events & POLL_READ) pollEvents |= POLLIN;
+	if (events & POLL_WRITE) pollEvents |= POLLOUT;
+	queue(OP_POLL, fd, 0, 0, 0, pollEvents, -1, callback, options);
+}
+
+
+int IOUring::submit()
+{
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing)
+	{
+		return _pRing->toSubmit > 0 ? enter(_pRing->toSubmit, 0) : 0;
+	}
+#endif
+	int n = static_cast<int>(_queued.size());
+	for (std::vector<UInt32>::const_iterator it = _queued.begin(); it != _queued.end(); ++it)
+	{
+		int opcode = _ops[*it].opcode;
+		if (opcode == OP_RECV || opcode == OP_SEND || opcode == OP_POLL)
+			_waiting.push_back(*it);
+		else
+			execute(*it);
+	}
+	_queued.clear();
+	return n;
+}
+
+
+int IOUring::wait(int minCompletions)
+{
+	std::size_t target = minCompletions > 0 ? static_cast<std::size_t>(minCompletions) : 0;
+	if (target > _pending) target = _pending;
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing)
+	{
+		reap();
+		while (_completed.size() < target)
+		{
+			enter(_pRing->toSubmit, static_cast<unsigned>(target - _completed.size()));
+			reap();
+		}
+		if (_pRing->toSubmit > 0) enter(_pRing->toSubmit, 0);
+		return dispatch();
+	}
+#endif
+	submit();
+	while (_completed.size() < target && !_waiting.empty())
+	{
+		pollWaiting(-1);
+	}
+	return dispatch();
+}
+
+
+int IOUring::wait(const Poco::Timespan& timeout)
+{
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing)
+	{
+		reap();
+		if (_completed.empty() && _pending > 0)
+		{
+			queueTimeout(timeout);
+			enter(_pRing->toSubmit, 1);
+			reap();
+		}
+		else if (_pRing->toSubmit > 0)
+		{
+			enter(_pRing->toSubmit, 0);
+		}
+		return dispatch();
+	}
+#endif
+	submit();
+	if (_completed.empty() && !_waiting.empty())
+	{
+		pollWaiting(static_cast<int>(timeout.totalMilliseconds()));
+	}
+	return dispatch();
+}
+
+
+int IOUring::complete()
+{
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing)
+	{
+		if (_pRing->toSubmit > 0) enter(_pRing->toSubmit, 0);
+		reap();
+		return dispatch();
+	}
+#endif
+	submit();
+	if (!_waiting.empty()) pollWaiting(0);
+	return dispatch();
+}
+
+
+void IOUring::registerBuffers(const std::vector<Buffer>& buffers)
+{
+	poco_assert (_pending == 0);
+
+	unregisterBuffers();
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing && !buffers.empty())
+	{
+		std::vector<struct iovec> iov(buffers.size());
+		for (std::size_t i = 0; i < buffers.size(); ++i)
+		{
+			iov[i].iov_base = buffers[i].data;
+			iov[i].iov_len  = buffers[i].size;
+		}
+		if (::syscall(__NR_io_uring_register, _pRing->fd, IORING_REGISTER_BUFFERS, &iov[0], static_cast<unsigned>(iov.size())) < 0)
+			throw SystemException("Cannot register buffers", errno);
+		_pRing->hasBuffers = true;
+	}
+#endif
+	_buffers = buffers;
+}
+
+
+void IOUring::unregisterBuffers()
+{
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing && _pRing->hasBuffers)
+	{
+		::syscall(__NR_io_uring_register, _pRing->fd, IORING_UNREGISTER_BUFFERS, 0, 0);
+		_pRing->hasBuffers = false;
+	}
+#endif
+	_buffers.clear();
+}
+
+
+void IOUring::registerFiles(const std::vector<int>& fds)
+{
+	poco_assert (_pending == 0);
+
+	unregisterFiles();
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing && !fds.empty())
+	{
+		if (::syscall(__NR_io_uring_register, _pRing->fd, IORING_REGISTER_FILES, &fds[0], static_cast<unsigned>(fds.size())) < 0)
+			throw SystemException("Cannot register files", errno);
+		_pRing->hasFiles = true;
+	}
+#endif
+	_files = fds;
+}
+
+
+void IOUring::unregisterFiles()
+{
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing && _pRing->hasFiles)
+	{
+		::syscall(__NR_io_uring_register, _pRing->fd, IORING_UNREGISTER_FILES, 0, 0);
+		_pRing->hasFiles = false;
+	}
+#endif
+	_files.clear();
+}
+
+
+bool IOUring::isAvailable()
+{
+#if defined(POCO_HAVE_IO_URING)
+	static const bool available = []()
+	{
+		io_uring_params params;
+		int fd = setupRing(1, params);
+		if (fd < 0) return false;
+		::close(fd);
+		return true;
+	}();
+	return available;
+#else
+	return false;
+#endif
+}
+
+
+IOUring::Operation& IOUring::allocate(const Callback& callback, UInt32& index)
+{
+	if (_freeOps.empty())
+	{
+		index = static_cast<UInt32>(_ops.size());
+		_ops.push_back(Operation());
+	}
+	else
+	{
+		index = _freeOps.back();
+		_freeOps.pop_back();
+	}
+	Operation& op = _ops[index];
+	op.callback = callback;
+	return op;
+}
+
+
+void IOUring::release(UInt32 index)
+{
+	_ops[index].callback = Callback();
+	_freeOps.push_back(index);
+}
+
+
+void IOUring::queue(int opcode, int fd, void* buffer, std::size_t length, UInt64 offset, int flags, int bufferIndex, const Callback& callback, int options)
+{
+	if (options & OPT_FIXED_FILE)
+	{
+		if (fd < 0 || static_cast<std::size_t>(fd) >= _files.size())
+			throw InvalidArgumentException("Invalid registered file index");
+	}
+	if (bufferIndex >= 0)
+	{
+		if (static_cast<std::size_t>(bufferIndex) >= _buffers.size())
+			throw InvalidArgumentException("Invalid registered buffer index");
+		const char* begin = static_cast<const char*>(_buffers[bufferIndex].data);
+		const char* end   = begin + _buffers[bufferIndex].size;
+		const char* p     = static_cast<const char*>(buffer);
+		if (p < begin || p > end || length > static_cast<std::size_t>(end - p))
+			throw InvalidArgumentException("Buffer is not within the registered buffer");
+	}
+
+#if defined(POCO_HAVE_IO_URING)
+	if (_pRing)
+	{
+		unsigned tail = *_pRing->sqTail;
+		if (tail - __atomic_load_n(_pRing->sqHead, __ATOMIC_ACQUIRE) >= _pRing->sqEntries)
+		{
+			enter(_pRing->toSubmit, 0);
+			if (tail - __atomic_load_n(_pRing->sqHead, __ATOMIC_ACQUIRE) >= _pRing->sqEntries)
+				throw IOException("io_uring submission queue is full");
+		}
+
+		UInt32 index;
+		Operation& op = allocate(callback, index);
+		op.opcode = opcode;
+
+		io_uring_sqe* sqe = &_pRing->sqes[tail & _pRing->sqMask];
+		std::memset(sqe, 0, sizeof(io_uring_sqe));
+		sqe->fd        = fd;
+		sqe->addr      = reinterpret_cast<UInt64>(buffer);
+		sqe->len       = length > 0xFFFFFFFF ? 0xFFFFFFFF : static_cast<UInt32>(length);
+		sqe->off       = offset;
+		sqe->user_data = index;
+		if (options & OPT_FIXED_FILE) sqe->flags |= IOSQE_FIXED_FILE;
+		switch (opcode)
+		{
+		case OP_READ:
+			sqe->opcode = IORING_OP_READ;
+			break;
+		case OP_WRITE:
+			sqe->opcode = IORING_OP_WRITE;
+			break;
+		case OP_READ_FIXED:
+			sqe->opcode = IORING_OP_READ_FIXED;
+			sqe->buf_index = static_cast<UInt16>(bufferIndex);
+			break;
+		case OP_WRITE_FIXED:
+			sqe->opcode = IORING_OP_WRITE_FIXED;
+			sqe->buf_index = static_cast<UInt16>(bufferIndex);
+			break;
+		case OP_FSYNC:
+			sqe->opcode = IORING_OP_FSYNC;
+			sqe->fsync_flags = flags ? IORING_FSYNC_DATASYNC : 0;
+			break;
+		case OP_RECV:
+			sqe->opcode = IORING_OP_RECV;
+			sqe->msg_flags = flags;
+			break;
+		case OP_SEND:
+			sqe->opcode = IORING_OP_SEND;
+			sqe->msg_flags = flags;
+			break;
+		case OP_POLL:
+			sqe->opcode = IORING_OP_POLL_ADD;
+			sqe->poll_events = static_cast<UInt16>(flags);
+			break;
+		case OP_TIMEOUT:
+			sqe->opcode = IORING_OP_TIMEOUT;
+			sqe->len = 1;
+			sqe->off = 1;
+			break;
+		}
+		__atomic_store_n(_pRing->sqTail, tail + 1, __ATOMIC_RELEASE);
+		++_pRing->toSubmit;
+		if (opcode != OP_TIMEOUT) ++_pending;
+		return;
+	}
+#endif
+
+	UInt32 index;
+	Operation& op = allocate(callback, index);
+	op.opcode = opcode;
+	op.fd     = (options & OPT_FIXED_FILE) ? _files[fd] : fd;
+	op.buffer = buffer;
+	op.length = length;
+	op.offset = offset;
+	op.flags  = flags;
+	_queued.push_back(index);
+	++_pending;
+}
+
+
+int IOUring::reap()
+{
+	int n = 0;
+#if defined(POCO_HAVE_IO_URING)
+	unsigned head = *_pRing->cqHead;
+	unsigned tail = __atomic_load_n(_pRing->cqTail, __ATOMIC_ACQUIRE);
+	while (head != tail)
+	{
+		const io_uring_cqe& cqe = _pRing->cqes[head & _pRing->cqMask];
+		UInt32 index = static_cast<UInt32>(cqe.user_data);
+		if (_ops[index].opcode == OP_TIMEOUT)
+		{
+			release(index);
+		}
+		else
+		{
+			_completed.push_back(std::make_pair(index, cqe.res));
+			++n;
+		}
+		++head;
+	}
+	__atomic_store_n(_pRing->cqHead, head, __ATOMIC_RELEASE);
+#endif
+	return n;
+}
+
+
+int IOUring::enter(unsigned toSubmit, unsigned minComplete)
+{
+#if defined(POCO_HAVE_IO_URING)
+	unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+	int rc = static_cast<int>(::syscall(__NR_io_uring_enter, _pRing->fd, toSubmit, minComplete, flags, 0, 0));
+	if (rc < 0 && (errno == EBUSY || errno == EAGAIN))
+	{
+		// the completion queue is full; make room and retry
+		reap();
+		rc = static_cast<int>(::syscall(__NR_io_uring_enter, _pRing->fd, toSubmit, minComplete, flags, 0, 0));
+	}
+	if (rc < 0)
+	{
+		if (errno == EINTR) return 0;
+		throw SystemException("io_uring_enter failed", errno);
+	}
+	_pRing->toSubmit -= static_cast<unsigned>(rc);
+	return rc;
+#else
+	return 0;
+#endif
+}
+
+
+void IOUring::queueTimeout(const Poco::Timespan& timeout)
+{
+#if defined(POCO_HAVE_IO_URING)
+	// The kernel copies the timeout when the operation is submitted,
+	// so a single timespec per ring is sufficient.
+	_pRing->timeout[0] = timeout.totalSeconds();
+	_pRing->timeout[1] = static_cast<Int64>(timeout.useconds())*1000;
+	queue(OP_TIMEOUT, -1, _pRing->timeout, 0, 0, 0, -1, Callback(), OPT_DEFAULT);
+#endif
+}
+
+
+int IOUring::dispatch()
+{
+	std::vector<std::pair<UInt32, int> > completed;
+	completed.swap(_completed);
+	int n = 0;
+	for (std::vector<std::pair<UInt32, int> >::const_iterator it = completed.begin(); it != completed.end(); ++it)
+	{
+		Callback callback;
+		callback.swap(_ops[it->first].callback);
+		release(it->first);
+		--_pending;
+		++n;
+		try
+		{
+			if (callback) callback(it->second);
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+	}
+	// keep the capacity of the vector for the next round
+	completed.clear();
+	if (_completed.empty()) _completed.swap(completed);
+	return n;
+}
+
+
+void IOUring::execute(UInt32 index)
+{
+	Operation& op = _ops[index];
+	ssize_t rc = 0;
+	switch (op.opcode)
+	{
+	case OP_READ:
+	case OP_READ_FIXED:
+		if (op.offset == static_cast<UInt64>(-1))
+			rc = ::read(op.fd, op.buffer, op.length);
+		else
+			rc = ::pread(op.fd, op.buffer, op.length, static_cast<off_t>(op.offset));
+		break;
+	case OP_WRITE:
+	case OP_WRITE_FIXED:
+		if (op.offset == static_cast<UInt64>(-1))
+			rc = ::write(op.fd, op.buffer, op.length);
+		else
+			rc = ::pwrite(op.fd, op.buffer, op.length, static_cast<off_t>(op.offset));
+		break;
+	case OP_FSYNC:
+#if defined(__linux__)
+		rc = op.flags ? ::fdatasync(op.fd) : ::fsync(op.fd);
+#else
+		rc = ::fsync(op.fd);
+#endif
+		break;
+	case OP_RECV:
+		rc = ::recv(op.fd, op.buffer, op.length, op.flags);
+		break;
+	case OP_SEND:
+		rc = ::send(op.fd, op.buffer, op.length, op.flags);
+		break;
+	}
+	_completed.push_back(std::make_pair(index, rc < 0 ? -errno : static_cast<int>(rc)));
+}
+
+
+bool IOUring::pollWaiting(int timeoutMs)
+{
+	std::vector<struct pollfd> fds(_waiting.size());
+	for (std::size_t i = 0; i < _waiting.size(); ++i)
+	{
+		const Operation& op = _ops[_waiting[i]];
+		fds[i].fd      = op.fd;
+		fds[i].events  = static_cast<short>(op.opcode == OP_POLL ? op.flags : (op.opcode == OP_RECV ? POLLIN : POLLOUT));
+		fds[i].revents = 0;
+	}
+	int rc = ::poll(&fds[0], static_cast<nfds_t>(fds.size()), timeoutMs);
+	if (rc <= 0) return false;
+
+	std::size_t j = 0;
+	for (std::size_t i = 0; i < fds.size(); ++i)
+	{
+		UInt32 index = _waiting[i];
+		if (fds[i].revents)
+		{
+			if (_ops[index].opcode == OP_POLL)
+				_completed.push_back(std::make_pair(index, static_cast<int>(fds[i].revents)));
+			else
+				execute(index);
+		}
+		else _waiting[j++] = index;
+	}
+	_waiting.resize(j);
+	return true;
+}
+
+
+} // namespace Poco
@@ -47,6 +47,21 @@ void LogFileImpl::writeImpl(const std::string& text, bool flush)
 }
 
 
+void LogFileImpl::writeBufferImpl(const std::string& buffer, bool flush)
+{
+	_str.write(buffer.data(), buffer.size());
+	if (flush)
+		_str.flush();
+	if (!_str.good()) throw WriteFileException(_path);
+}
+
+
+void LogFileImpl::syncImpl(bool dataOnly)
+{
+	_str.rdbuf()->flushToDisk(dataOnly);
+}
+
+
 UInt64 LogFileImpl::sizeImpl() const
 {
 	return (UInt64) _str.tellp();
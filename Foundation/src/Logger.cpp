@@ -26,6 +26,7 @@ namespace Poco {
 
 Logger::LoggerMap* Logger::_pLoggerMap = 0;
 Mutex Logger::_mapMtx;
+std::atomic<UInt32> Logger::_generation(0);
 const std::string Logger::ROOT;
 
 
@@ -341,6 +342,7 @@ void Logger::shutdown()
 
 	if (_pLoggerMap)
 	{
+		++_generation;
 		for (LoggerMap::iterator it = _pLoggerMap->begin(); it != _pLoggerMap->end(); ++it)
 		{
 			it->second->release();
@@ -372,6 +374,7 @@ void Logger::destroy(const std::string& name)
 		LoggerMap::iterator it = _pLoggerMap->find(name);
 		if (it != _pLoggerMap->end())
 		{
+			++_generation;
 			it->second->release();
 			_pLoggerMap->erase(it);
 		}
@@ -0,0 +1,256 @@
+//
+// MappedFile.cpp
+//
+// Library: Foundation
+// Package: Filesystem
+// Module:  MappedFile
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedFile.h"
+#include "Poco/Exception.h"
+#include <utility>
+#if defined(POCO_OS_FAMILY_WINDOWS)
+#include "Poco/UnicodeConverter.h"
+#include "Poco/UnWindows.h"
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+
+namespace Poco {
+
+
+MappedFile::MappedFile():
+	_pData(0),
+	_size(0),
+	_open(false)
+{
+}
+
+
+MappedFile::MappedFile(const std::string& path, int options):
+	_pData(0),
+	_size(0),
+	_open(false)
+{
+	open(path, options);
+}
+
+
+MappedFile::MappedFile(MappedFile&& other):
+	_path(std::move(other._path)),
+	_pData(other._pData),
+	_size(other._size),
+	_open(other._open)
+{
+	other._pData = 0;
+	other._size = 0;
+	other._open = false;
+}
+
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+
+MappedFile& MappedFile::operator = (MappedFile&& other)
+{
+	MappedFile tmp(std::move(other));
+	swap(tmp);
+	return *this;
+}
+
+
+void MappedFile::swap(MappedFile& other)
+{
+	using std::swap;
+	swap(_path, other._path);
+	swap(_pData, other._pData);
+	swap(_size, other._size);
+	swap(_open, other._open);
+}
+
+
+#if defined(POCO_OS_FAMILY_WINDOWS)
+
+
+void MappedFile::open(const std::string& path, int /*options*/)
+{
+	close();
+
+	std::wstring upath;
+	UnicodeConverter::toUTF16(path, upath);
+	HANDLE hFile = CreateFileW(upath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		DWORD err = GetLastError();
+		if (err == ERROR_FILE_NOT_FOUND || err == ERROR_PATH_NOT_FOUND)
+			throw FileNotFoundException(path);
+		else if (err == ERROR_ACCESS_DENIED)
+			throw FileAccessDeniedException(path);
+		else
+			throw OpenFileException(path);
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(hFile, &size))
+	{
+		CloseHandle(hFile);
+		throw OpenFileException("Cannot determine size of file", path);
+	}
+	if (size.QuadPart > 0)
+	{
+		HANDLE hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		CloseHandle(hFile);
+		if (!hMapping) throw OpenFileException("Cannot map file", path);
+		void* addr = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(hMapping);
+		if (!addr) throw OpenFileException("Cannot map file", path);
+		_pData = static_cast<char*>(addr);
+		_size = static_cast<std::size_t>(size.QuadPart);
+	}
+	else CloseHandle(hFile);
+
+	_path = path;
+	_open = true;
+}
+
+
+void MappedFile::close()
+{
+	if (_pData)
+	{
+		UnmapViewOfFile(_pData);
+	}
+	_pData = 0;
+	_size = 0;
+	_open = false;
+}
+
+
+void MappedFile::advise(Advice, std::size_t, std::size_t)
+{
+}
+
+
+std::size_t MappedFile::pageSize()
+{
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	return si.dwPageSize;
+}
+
+
+#else
+
+
+void MappedFile::open(const std::string& path, int options)
+{
+	close();
+
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+	{
+		switch (errno)
+		{
+		case ENOENT:
+		case ENOTDIR:
+			throw FileNotFoundException(path);
+		case EACCES:
+			throw FileAccessDeniedException(path);
+		default:
+			throw OpenFileException(path);
+		}
+	}
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0)
+	{
+		::close(fd);
+		throw OpenFileException("Cannot determine size of file", path);
+	}
+	if (st.st_size > 0)
+	{
+		int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+		if (options & OPT_POPULATE) flags |= MAP_POPULATE;
+#endif
+		void* addr = ::mmap(0, static_cast<std::size_t>(st.st_size), PROT_READ, flags, fd, 0);
+		::close(fd);
+		if (addr == MAP_FAILED) throw OpenFileException("Cannot map file", path);
+		_pData = static_cast<char*>(addr);
+		_size = static_cast<std::size_t>(st.st_size);
+
+#if defined(MADV_HUGEPAGE)
+		if (options & OPT_HUGE_PAGES) ::madvise(_pData, _size, MADV_HUGEPAGE);
+#endif
+#if !defined(MAP_POPULATE)
+		if (options & OPT_POPULATE) ::madvise(_pData, _size, MADV_WILLNEED);
+#endif
+	}
+	else ::close(fd);
+
+	_path = path;
+	_open = true;
+}
+
+
+void MappedFile::close()
+{
+	if (_pData)
+	{
+		::munmap(_pData, _size);
+	}
+	_pData = 0;
+	_size = 0;
+	_open = false;
+}
+
+
+void MappedFile::advise(Advice advice, std::size_t offset, std::size_t length)
+{
+	if (!_pData || offset >= _size) return;
+	if (length > _size - offset) length = _size - offset;
+
+	// madvise() requires a page-aligned start address
+	std::size_t align = offset % pageSize();
+	offset -= align;
+	length += align;
+
+	int adv = MADV_NORMAL;
+	switch (advice)
+	{
+	case ADVICE_NORMAL:     adv = MADV_NORMAL; break;
+	case ADVICE_SEQUENTIAL: adv = MADV_SEQUENTIAL; break;
+	case ADVICE_RANDOM:     adv = MADV_RANDOM; break;
+	case ADVICE_WILLNEED:   adv = MADV_WILLNEED; break;
+	case ADVICE_DONTNEED:   adv = MADV_DONTNEED; break;
+	}
+	::madvise(_pData + offset, length, adv);
+}
+
+
+std::size_t MappedFile::pageSize()
+{
+	static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	return size;
+}
+
+
+#endif
+
+
+} // namespace Poco
@@ -0,0 +1,86 @@
+//
+// MappedInputStream.cpp
+//
+// Library: Foundation
+// Package: Streams
+// Module:  MappedInputStream
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MappedInputStream.h"
+
+
+namespace Poco {
+
+
+MappedIOS::MappedIOS(const std::string& path, int options):
+	_file(path, options),
+	_pBegin(_file.begin()),
+	_pEnd(_file.end()),
+	_buf(const_cast<char*>(_pBegin), _file.size())
+{
+	poco_ios_init(&_buf);
+}
+
+
+MappedIOS::MappedIOS(const MappedFile& file):
+	_pBegin(file.begin()),
+	_pEnd(file.end()),
+	_buf(const_cast<char*>(_pBegin), file.size())
+{
+	poco_ios_init(&_buf);
+}
+
+
+MappedIOS::~MappedIOS()
+{
+}
+
+
+MappedInputStream::MappedInputStream(const std::string& path, int options):
+	MappedIOS(path, options),
+	std::istream(&_buf)
+{
+}
+
+
+MappedInputStream::MappedInputStream(const MappedFile& file):
+	MappedIOS(file),
+	std::istream(&_buf)
+{
+}
+
+
+MappedInputStream::~MappedInputStream()
+{
+}
+
+
+const char* MappedInputStream::current()
+{
+	std::streamoff pos = _buf.pubseekoff(0, std::ios_base::cur, std::ios_base::in);
+	if (pos < 0)
+		return _pEnd;
+	else
+		return _pBegin + pos;
+}
+
+
+void MappedInputStream::skip(std::size_t count)
+{
+	std::size_t available = _pEnd - current();
+	if (count > available)
+	{
+		count = available;
+		setstate(std::ios::eofbit);
+	}
+	_buf.pubseekoff(static_cast<std::streamoff>(count), std::ios_base::cur, std::ios_base::in);
+}
+
+
+} // namespace Poco
@@ -233,6 +233,17 @@ const std::string& Message::get(const std::string& param, const std::string& def
 }
 
 
+const Message::StringMap& Message::getAll() const
+{
+	static const StringMap empty;
+
+	if (_pMap)
+		return *_pMap;
+	else
+		return empty;
+}
+
+
 void Message::set(const std::string& param, const std::string& value)
 {
 	if (!_pMap)
@@ -0,0 +1,109 @@
+//
+// Metric.cpp
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  Metric
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Metric.h"
+#include "Poco/Environment.h"
+#include "Poco/Exception.h"
+#include "Poco/Ascii.h"
+#if defined(POCO_OS_FAMILY_UNIX) && defined(__linux__)
+#include <sched.h>
+#else
+#include <atomic>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const unsigned MAX_SHARDS = 64;
+
+
+	unsigned computeShardCount()
+	{
+		unsigned processors = Environment::processorCount();
+		unsigned count = 1;
+		while (count < processors && count < MAX_SHARDS) count *= 2;
+		return count;
+	}
+
+
+#if !defined(POCO_OS_FAMILY_UNIX) || !defined(__linux__)
+	std::atomic<unsigned> nextShardIndex(0);
+#endif
+}
+
+
+Metric::Metric(const std::string& name, const std::string& help):
+	_name(name),
+	_help(help)
+{
+	if (!isValidName(name))
+		throw InvalidArgumentException("Invalid metric name", name);
+}
+
+
+Metric::~Metric()
+{
+}
+
+
+bool Metric::isValidName(const std::string& name)
+{
+	if (name.empty() || Ascii::isDigit(name[0])) return false;
+	for (std::string::const_iterator it = name.begin(); it != name.end(); ++it)
+	{
+		if (!Ascii::isAlphaNumeric(*it) && *it != '_' && *it != ':') return false;
+	}
+	return true;
+}
+
+
+void Metric::writeHeader(std::ostream& ostr, const char* type) const
+{
+	ostr << "# HELP " << _name << ' ';
+	for (std::string::const_iterator it = _help.begin(); it != _help.end(); ++it)
+	{
+		if (*it == '\\')
+			ostr << "\\\\";
+		else if (*it == '\n')
+			ostr << "\\n";
+		else
+			ostr << *it;
+	}
+	ostr << "\n# TYPE " << _name << ' ' << type << '\n';
+}
+
+
+unsigned Metric::shardCount()
+{
+	static const unsigned count = computeShardCount();
+	return count;
+}
+
+
+unsigned Metric::shardIndex()
+{
+#if defined(POCO_OS_FAMILY_UNIX) && defined(__linux__)
+	int cpu = sched_getcpu();
+	return cpu < 0 ? 0 : static_cast<unsigned>(cpu);
+#else
+	static thread_local unsigned index = nextShardIndex++;
+	return index;
+#endif
+}
+
+
+} // namespace Poco
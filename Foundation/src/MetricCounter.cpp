@@ -0,0 +1,58 @@
+//
+// MetricCounter.cpp
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  MetricCounter
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MetricCounter.h"
+#include "Poco/NumberFormatter.h"
+
+
+namespace Poco {
+
+
+MetricCounter::MetricCounter(const std::string& name, const std::string& help):
+	Metric(name, help),
+	_pShards(new Shard[shardCount()]),
+	_mask(shardCount() - 1)
+{
+	for (unsigned i = 0; i <= _mask; ++i)
+	{
+		_pShards[i].value.store(0, std::memory_order_relaxed);
+	}
+}
+
+
+MetricCounter::~MetricCounter()
+{
+	delete [] _pShards;
+}
+
+
+UInt64 MetricCounter::value() const
+{
+	UInt64 result = 0;
+	for (unsigned i = 0; i <= _mask; ++i)
+	{
+		result += _pShards[i].value.load(std::memory_order_relaxed);
+	}
+	return result;
+}
+
+
+void MetricCounter::writePrometheus(std::ostream& ostr) const
+{
+	writeHeader(ostr, "counter");
+	ostr << name() << ' ' << NumberFormatter::format(value()) << '\n';
+}
+
+
+} // namespace Poco
@@ -0,0 +1,41 @@
+//
+// MetricGauge.cpp
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  MetricGauge
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MetricGauge.h"
+#include "Poco/NumberFormatter.h"
+
+
+namespace Poco {
+
+
+MetricGauge::MetricGauge(const std::string& name, const std::string& help):
+	Metric(name, help),
+	_value(0)
+{
+}
+
+
+MetricGauge::~MetricGauge()
+{
+}
+
+
+void MetricGauge::writePrometheus(std::ostream& ostr) const
+{
+	writeHeader(ostr, "gauge");
+	ostr << name() << ' ' << NumberFormatter::format(value()) << '\n';
+}
+
+
+} // namespace Poco
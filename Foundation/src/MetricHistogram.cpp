@@ -0,0 +1,143 @@
+//
+// MetricHistogram.cpp
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  MetricHistogram
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MetricHistogram.h"
+#include "Poco/NumberFormatter.h"
+#include <cmath>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const unsigned MAX_HISTOGRAM_SHARDS = 8;
+}
+
+
+MetricHistogram::MetricHistogram(const std::string& name, const std::string& help, double unit):
+	Metric(name, help),
+	_unit(unit),
+	_pShards(0),
+	_mask(0)
+{
+	unsigned shards = shardCount() < MAX_HISTOGRAM_SHARDS ? shardCount() : MAX_HISTOGRAM_SHARDS;
+	_pShards = new Shard[shards];
+	_mask = shards - 1;
+	for (unsigned i = 0; i < shards; ++i)
+	{
+		for (unsigned k = 0; k < BUCKET_COUNT; ++k)
+		{
+			_pShards[i].counts[k].store(0, std::memory_order_relaxed);
+		}
+		_pShards[i].sum.store(0, std::memory_order_relaxed);
+	}
+}
+
+
+MetricHistogram::~MetricHistogram()
+{
+	delete [] _pShards;
+}
+
+
+UInt64 MetricHistogram::count() const
+{
+	std::vector<UInt64> counts;
+	return snapshot(counts);
+}
+
+
+UInt64 MetricHistogram::sum() const
+{
+	UInt64 result = 0;
+	for (unsigned i = 0; i <= _mask; ++i)
+	{
+		result += _pShards[i].sum.load(std::memory_order_relaxed);
+	}
+	return result;
+}
+
+
+UInt64 MetricHistogram::percentile(double percent) const
+{
+	std::vector<UInt64> counts;
+	UInt64 total = snapshot(counts);
+	return percentile(counts, total, percent);
+}
+
+
+void MetricHistogram::writePrometheus(std::ostream& ostr) const
+{
+	static const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+	std::vector<UInt64> counts;
+	UInt64 total = snapshot(counts);
+	UInt64 valueSum = sum();
+
+	writeHeader(ostr, "summary");
+	for (std::size_t i = 0; i < sizeof(QUANTILES)/sizeof(QUANTILES[0]); ++i)
+	{
+		ostr << name() << "{quantile=\"" << NumberFormatter::format(QUANTILES[i]) << "\"} "
+		     << NumberFormatter::format(percentile(counts, total, 100*QUANTILES[i])*_unit) << '\n';
+	}
+	ostr << name() << "_sum " << NumberFormatter::format(valueSum*_unit) << '\n';
+	ostr << name() << "_count " << NumberFormatter::format(total) << '\n';
+}
+
+
+UInt64 MetricHistogram::bucketLimit(unsigned index)
+{
+	if (index < SUB_BUCKET_COUNT) return index;
+	unsigned shift = (index >> SUB_BUCKET_BITS) - 1;
+	UInt64 lower = static_cast<UInt64>(SUB_BUCKET_COUNT + (index & (SUB_BUCKET_COUNT - 1))) << shift;
+	return lower + ((UInt64(1) << shift) - 1);
+}
+
+
+UInt64 MetricHistogram::snapshot(std::vector<UInt64>& counts) const
+{
+	counts.assign(BUCKET_COUNT, 0);
+	UInt64 total = 0;
+	for (unsigned i = 0; i <= _mask; ++i)
+	{
+		for (unsigned k = 0; k < BUCKET_COUNT; ++k)
+		{
+			UInt64 n = _pShards[i].counts[k].load(std::memory_order_relaxed);
+			counts[k] += n;
+			total += n;
+		}
+	}
+	return total;
+}
+
+
+UInt64 MetricHistogram::percentile(const std::vector<UInt64>& counts, UInt64 total, double percent)
+{
+	if (total == 0) return 0;
+
+	UInt64 rank = static_cast<UInt64>(std::ceil(percent/100*total));
+	if (rank < 1) rank = 1;
+	if (rank > total) rank = total;
+	UInt64 cumulative = 0;
+	for (unsigned k = 0; k < BUCKET_COUNT; ++k)
+	{
+		cumulative += counts[k];
+		if (cumulative >= rank) return bucketLimit(k);
+	}
+	return bucketLimit(BUCKET_COUNT - 1);
+}
+
+
+} // namespace Poco
@@ -0,0 +1,141 @@
+//
+// MetricRegistry.cpp
+//
+// Library: Foundation
+// Package: Metrics
+// Module:  MetricRegistry
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/MetricRegistry.h"
+#include "Poco/Exception.h"
+
+
+namespace Poco {
+
+
+namespace
+{
+	template <class M>
+	M* createMetric(const std::string& name, const std::string& help, double)
+	{
+		return new M(name, help);
+	}
+
+
+	template <>
+	MetricHistogram* createMetric<MetricHistogram>(const std::string& name, const std::string& help, double unit)
+	{
+		return new MetricHistogram(name, help, unit);
+	}
+}
+
+
+MetricRegistry::MetricRegistry()
+{
+}
+
+
+MetricRegistry::~MetricRegistry()
+{
+	for (MetricMap::iterator it = _metrics.begin(); it != _metrics.end(); ++it)
+	{
+		delete it->second;
+	}
+}
+
+
+MetricCounter& MetricRegistry::counter(const std::string& name, const std::string& help)
+{
+	return get<MetricCounter>(name, help, 1.0);
+}
+
+
+MetricGauge& MetricRegistry::gauge(const std::string& name, const std::string& help)
+{
+	return get<MetricGauge>(name, help, 1.0);
+}
+
+
+MetricHistogram& MetricRegistry::histogram(const std::string& name, const std::string& help, double unit)
+{
+	return get<MetricHistogram>(name, help, unit);
+}
+
+
+template <class M>
+M& MetricRegistry::get(const std::string& name, const std::string& help, double unit)
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	MetricMap::iterator it = _metrics.find(name);
+	if (it != _metrics.end())
+	{
+		M* pMetric = dynamic_cast<M*>(it->second);
+		if (!pMetric) throw ExistsException("A metric of another type has the same name", name);
+		return *pMetric;
+	}
+	M* pMetric = createMetric<M>(name, help, unit);
+	_metrics[name] = pMetric;
+	return *pMetric;
+}
+
+
+Metric* MetricRegistry::find(const std::string& name) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	MetricMap::const_iterator it = _metrics.find(name);
+	return it != _metrics.end() ? it->second : 0;
+}
+
+
+void MetricRegistry::names(std::vector<std::string>& names) const
+{
+	FastMutex::ScopedLock lock(_mutex);
+
+	names.clear();
+	for (MetricMap::const_iterator it = _metrics.begin(); it != _metrics.end(); ++it)
+	{
+		names.push_back(it->first);
+	}
+}
+
+
+void MetricRegistry::writePrometheus(std::ostream& ostr) const
+{
+	// Metrics are never removed, so they can be written
+	// without holding the lock.
+	std::vector<const Metric*> metrics;
+	{
+		FastMutex::ScopedLock lock(_mutex);
+
+		metrics.reserve(_metrics.size());
+		for (MetricMap::const_iterator it = _metrics.begin(); it != _metrics.end(); ++it)
+		{
+			metrics.push_back(it->second);
+		}
+	}
+	for (std::vector<const Metric*>::const_iterator it = metrics.begin(); it != metrics.end(); ++it)
+	{
+		(*it)->writePrometheus(ostr);
+	}
+}
+
+
+MetricRegistry& MetricRegistry::defaultRegistry()
+{
+	// The default registry is never destroyed, since the POCO libraries
+	// update their metrics in threads that may still be running while
+	// static objects are destroyed at program termination.
+	static MetricRegistry* pRegistry = new MetricRegistry;
+	return *pRegistry;
+}
+
+
+} // namespace Poco
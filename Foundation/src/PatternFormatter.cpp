@@ -22,24 +22,93 @@
 #include "Poco/Timezone.h"
 #include "Poco/Environment.h"
 #include "Poco/NumberParser.h"
+#include <atomic>
+#include <cstring>
 
 
 namespace Poco {
 
 
+namespace
+{
+	std::atomic<UInt64> nextFormatterId(1);
+
+	const std::size_t CACHE_SIZE = 4;
+		// Number of formatters per thread for which formatted fields are cached.
+
+	const Timestamp::TimeVal OFFSET_INTERVAL = 15*60;
+		// Time zone transitions always happen at multiples of 15 minutes (UTC).
+
+	void appendTimeField(std::string& text, char key, const DateTime& dateTime, int tzd)
+	{
+		switch (key)
+		{
+		case 'N': text.append(Environment::nodeName()); break;
+		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
+		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
+		case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
+		case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
+		case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
+		case 'e': NumberFormatter::append(text, dateTime.day()); break;
+		case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
+		case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
+		case 'n': NumberFormatter::append(text, dateTime.month()); break;
+		case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
+		case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
+		case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
+		case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
+		case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
+		case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
+		case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
+		case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
+		case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
+		case 'z': text.append(DateTimeFormatter::tzdISO(tzd)); break;
+		case 'Z': text.append(DateTimeFormatter::tzdRFC(tzd)); break;
+		}
+	}
+}
+
+
+struct PatternFormatter::TimeCache
+	/// Per-thread cache of the fields that only
+	/// change once per second.
+{
+	TimeCache():
+		formatterId(0),
+		second(0),
+		hasOffset(false),
+		offsetSlot(0),
+		offset(0)
+	{
+	}
+
+	UInt64 formatterId;
+	Timestamp::TimeVal second;
+	bool hasOffset;
+	Timestamp::TimeVal offsetSlot;
+	int offset;
+	std::vector<std::string> texts;
+};
+
+
 const std::string PatternFormatter::PROP_PATTERN = "pattern";
 const std::string PatternFormatter::PROP_TIMES   = "times";
 
 
 PatternFormatter::PatternFormatter():
-	_localTime(false)
+	_localTime(false),
+	_needsOffset(false),
+	_id(0)
 {
+	parsePattern();
 }
 
 
 PatternFormatter::PatternFormatter(const std::string& format):
 	_localTime(false),
-	_pattern(format)
+	_needsOffset(false),
+	_pattern(format),
+	_id(0)
 {
 	parsePattern();
 }
@@ -52,17 +121,32 @@ PatternFormatter::~PatternFormatter()
 
 void PatternFormatter::format(const Message& msg, std::string& text)
 {
-	Timestamp timestamp = msg.getTime();
-	bool localTime = _localTime;
-	if (localTime)
+	static thread_local TimeCache caches[CACHE_SIZE];
+
+	Timestamp::TimeVal time = msg.getTime().epochMicroseconds();
+	Timestamp::TimeVal second = time/Timestamp::resolution();
+	int micros = static_cast<int>(time - second*Timestamp::resolution());
+	if (micros < 0)
 	{
-		timestamp += Timezone::utcOffset()*Timestamp::resolution();
-		timestamp += Timezone::dst()*Timestamp::resolution();
+		--second;
+		micros += static_cast<int>(Timestamp::resolution());
 	}
-	DateTime dateTime = timestamp;
-	for (std::vector<PatternAction>::iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip)
+
+	TimeCache& cache = caches[_id % CACHE_SIZE];
+	if (cache.formatterId != _id || cache.second != second)
+	{
+		updateCache(cache, second);
+	}
+
+	std::vector<std::string>::const_iterator itText = cache.texts.begin();
+	for (std::vector<PatternAction>::const_iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip, ++itText)
 	{
 		text.append(ip->prepend);
+		if (ip->perSecond)
+		{
+			text.append(*itText);
+			continue;
+		}
 		switch (ip->key)
 		{
 		case 's': text.append(msg.getSource()); break;
@@ -73,32 +157,11 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 		case 'P': NumberFormatter::append(text, msg.getPid()); break;
 		case 'T': text.append(msg.getThread()); break;
 		case 'I': NumberFormatter::append(text, msg.getTid()); break;
-		case 'N': text.append(Environment::nodeName()); break;
 		case 'U': text.append(msg.getSourceFile() ? msg.getSourceFile() : ""); break;
 		case 'u': NumberFormatter::append(text, msg.getSourceLine()); break;
-		case 'w': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()], 0, 3); break;
-		case 'W': text.append(DateTimeFormat::WEEKDAY_NAMES[dateTime.dayOfWeek()]); break;
-		case 'b': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1], 0, 3); break;
-		case 'B': text.append(DateTimeFormat::MONTH_NAMES[dateTime.month() - 1]); break;
-		case 'd': NumberFormatter::append0(text, dateTime.day(), 2); break;
-		case 'e': NumberFormatter::append(text, dateTime.day()); break;
-		case 'f': NumberFormatter::append(text, dateTime.day(), 2); break;
-		case 'm': NumberFormatter::append0(text, dateTime.month(), 2); break;
-		case 'n': NumberFormatter::append(text, dateTime.month()); break;
-		case 'o': NumberFormatter::append(text, dateTime.month(), 2); break;
-		case 'y': NumberFormatter::append0(text, dateTime.year() % 100, 2); break;
-		case 'Y': NumberFormatter::append0(text, dateTime.year(), 4); break;
-		case 'H': NumberFormatter::append0(text, dateTime.hour(), 2); break;
-		case 'h': NumberFormatter::append0(text, dateTime.hourAMPM(), 2); break;
-		case 'a': text.append(dateTime.isAM() ? "am" : "pm"); break;
-		case 'A': text.append(dateTime.isAM() ? "AM" : "PM"); break;
-		case 'M': NumberFormatter::append0(text, dateTime.minute(), 2); break;
-		case 'S': NumberFormatter::append0(text, dateTime.second(), 2); break;
-		case 'i': NumberFormatter::append0(text, dateTime.millisecond(), 3); break;
-		case 'c': NumberFormatter::append(text, dateTime.millisecond()/100); break;
-		case 'F': NumberFormatter::append0(text, dateTime.millisecond()*1000 + dateTime.microsecond(), 6); break;
-		case 'z': text.append(DateTimeFormatter::tzdISO(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
-		case 'Z': text.append(DateTimeFormatter::tzdRFC(localTime ? Timezone::tzd() : DateTimeFormatter::UTC)); break;
+		case 'i': NumberFormatter::append0(text, micros/1000, 3); break;
+		case 'c': NumberFormatter::append(text, micros/100000); break;
+		case 'F': NumberFormatter::append0(text, micros, 6); break;
 		case 'E': NumberFormatter::append(text, msg.getTime().epochTime()); break;
 		case 'v':
 			if (ip->length > msg.getSource().length())	//append spaces
@@ -117,15 +180,48 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 			{
 			}
 			break;
-		case 'L':
-			if (!localTime)
-			{
-				localTime = true;
-				timestamp += Timezone::utcOffset()*Timestamp::resolution();
-				timestamp += Timezone::dst()*Timestamp::resolution();
-				dateTime = timestamp;
-			}
-			break;
+		}
+	}
+}
+
+
+void PatternFormatter::updateCache(TimeCache& cache, Timestamp::TimeVal second) const
+{
+	if (cache.formatterId != _id)
+	{
+		cache.formatterId = _id;
+		cache.hasOffset = false;
+		cache.texts.resize(_patternActions.size());
+	}
+	cache.second = second;
+	if (_needsOffset)
+	{
+		Timestamp::TimeVal slot = second/OFFSET_INTERVAL;
+		if (!cache.hasOffset || cache.offsetSlot != slot)
+		{
+			cache.offset = Timezone::utcOffset() + Timezone::dst();
+			cache.offsetSlot = slot;
+			cache.hasOffset = true;
+		}
+	}
+
+	DateTime utcTime = Timestamp(second*Timestamp::resolution());
+	DateTime localTime = _needsOffset ? DateTime(Timestamp((second + cache.offset)*Timestamp::resolution())) : utcTime;
+	bool isLocal = _localTime;
+	std::vector<std::string>::iterator itText = cache.texts.begin();
+	for (std::vector<PatternAction>::const_iterator ip = _patternActions.begin(); ip != _patternActions.end(); ++ip, ++itText)
+	{
+		if (ip->key == 'L')
+		{
+			isLocal = true;
+		}
+		else if (ip->perSecond)
+		{
+			itText->clear();
+			if (isLocal)
+				appendTimeField(*itText, ip->key, localTime, cache.offset);
+			else
+				appendTimeField(*itText, ip->key, utcTime, DateTimeFormatter::UTC);
 		}
 	}
 }
@@ -134,6 +230,8 @@ void PatternFormatter::format(const Message& msg, std::string& text)
 void PatternFormatter::parsePattern()
 {
 	_patternActions.clear();
+	_needsOffset = _localTime;
+	_id = nextFormatterId.fetch_add(1);
 	std::string::const_iterator it  = _pattern.begin();
 	std::string::const_iterator end = _pattern.end();
 	PatternAction endAct;
@@ -174,6 +272,8 @@ void PatternFormatter::parsePattern()
 						}
 					}
 				}
+				act.perSecond = act.key != 0 && std::strchr("NwWbBdefmnoyYHhaAMSzZ", act.key) != 0;
+				if (act.key == 'L') _needsOffset = true;
 				_patternActions.push_back(act);
 				++it;
 			}
@@ -200,6 +300,7 @@ void PatternFormatter::setProperty(const std::string& name, const std::string& v
 	else if (name == PROP_TIMES)
 	{
 		_localTime = (value == "local");
+		parsePattern();
 	}
 	else 
 	{
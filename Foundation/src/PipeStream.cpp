@@ -53,6 +53,22 @@ void PipeStreamBuf::close()
 }
 
 
+int PipeStreamBuf::nativeDescriptor(std::ios::openmode which) const
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	if (!(getMode() & which)) return -1;
+	return which & std::ios::in ? _pipe.readHandle() : _pipe.writeHandle();
+#else
+	return -1;
+#endif
+}
+
+
+void PipeStreamBuf::nativeTransferred(std::ios::openmode which, std::streamsize n)
+{
+}
+
+
 //
 // PipeIOS
 //
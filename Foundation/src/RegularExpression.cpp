@@ -13,6 +13,8 @@
 
 
 #include "Poco/RegularExpression.h"
+#include "Poco/RegularExpressionCache.h"
+#include "Poco/UTF8String.h"
 #include "Poco/Exception.h"
 #include <sstream>
 #if defined(POCO_UNBUNDLED_PCRE)
@@ -26,10 +28,61 @@
 namespace Poco {
 
 
+namespace
+{
+	class OVector
+		/// The output vector for pcre_exec(). Small vectors,
+		/// which is what almost all patterns need, are kept
+		/// on the stack.
+	{
+	public:
+		explicit OVector(int size):
+			_size(size),
+			_pVec(size <= STACK_SIZE ? _buffer : new int[size])
+		{
+		}
+
+		~OVector()
+		{
+			if (_pVec != _buffer) delete [] _pVec;
+		}
+
+		int* data()
+		{
+			return _pVec;
+		}
+
+		int size() const
+		{
+			return _size;
+		}
+
+		int operator [] (int index) const
+		{
+			return _pVec[index];
+		}
+
+	private:
+		enum
+		{
+			STACK_SIZE = 64
+		};
+
+		int  _size;
+		int* _pVec;
+		int  _buffer[STACK_SIZE];
+	};
+}
+
+
 const int RegularExpression::OVEC_SIZE = 63; // must be multiple of 3
 
 
-RegularExpression::RegularExpression(const std::string& pattern, int options, bool study): _pcre(0), _extra(0)
+RegularExpression::RegularExpression(const std::string& pattern, int options, bool study):
+	_pcre(0),
+	_extra(0),
+	_ovecSize(OVEC_SIZE),
+	_utf8(false)
 {
 	const char* error;
 	int offs;
@@ -41,14 +94,21 @@ RegularExpression::RegularExpression(const std::string& pattern, int options, bo
 		throw RegularExpressionException(msg.str());
 	}
 	if (study)
-		_extra = pcre_study(reinterpret_cast<pcre*>(_pcre), 0, &error);
+		_extra = pcre_study(reinterpret_cast<pcre*>(_pcre), PCRE_STUDY_JIT_COMPILE, &error);
+
+	int captureCount = 0;
+	if (pcre_fullinfo(reinterpret_cast<pcre*>(_pcre), 0, PCRE_INFO_CAPTURECOUNT, &captureCount) == 0 && (captureCount + 1)*3 > _ovecSize)
+		_ovecSize = (captureCount + 1)*3;
+	unsigned long compileOptions = 0;
+	if (pcre_fullinfo(reinterpret_cast<pcre*>(_pcre), 0, PCRE_INFO_OPTIONS, &compileOptions) == 0)
+		_utf8 = (compileOptions & PCRE_UTF8) != 0;
 }
 
 
 RegularExpression::~RegularExpression()
 {
 	if (_pcre)  pcre_free(reinterpret_cast<pcre*>(_pcre));
-	if (_extra) pcre_free(reinterpret_cast<struct pcre_extra*>(_extra));
+	if (_extra) pcre_free_study(reinterpret_cast<struct pcre_extra*>(_extra));
 }
 
 
@@ -56,28 +116,14 @@ int RegularExpression::match(const std::string& subject, std::string::size_type
 {
 	poco_assert (offset <= subject.length());
 
-	int ovec[OVEC_SIZE];
-	int rc = pcre_exec(reinterpret_cast<pcre*>(_pcre), reinterpret_cast<struct pcre_extra*>(_extra), subject.c_str(), int(subject.size()), int(offset), options & 0xFFFF, ovec, OVEC_SIZE);
-	if (rc == PCRE_ERROR_NOMATCH)
+	OVector ovec(_ovecSize);
+	int rc = exec(subject, offset, options, ovec.data(), ovec.size());
+	if (rc == 0)
 	{
 		mtch.offset = std::string::npos;
 		mtch.length = 0;
 		return 0;
 	}
-	else if (rc == PCRE_ERROR_BADOPTION)
-	{
-		throw RegularExpressionException("bad option");
-	}
-	else if (rc == 0)
-	{
-		throw RegularExpressionException("too many captured substrings");
-	}
-	else if (rc < 0)
-	{
-		std::ostringstream msg;
-		msg << "PCRE error " << rc;
-		throw RegularExpressionException(msg.str());
-	}
 	mtch.offset = ovec[0] < 0 ? std::string::npos : ovec[0];
 	mtch.length = ovec[1] - mtch.offset;
 	return rc;
@@ -90,33 +136,14 @@ int RegularExpression::match(const std::string& subject, std::string::size_type
 
 	matches.clear();
 
-	int ovec[OVEC_SIZE];
-	int rc = pcre_exec(reinterpret_cast<pcre*>(_pcre), reinterpret_cast<struct pcre_extra*>(_extra), subject.c_str(), int(subject.size()), int(offset), options & 0xFFFF, ovec, OVEC_SIZE);
-	if (rc == PCRE_ERROR_NOMATCH)
-	{
-		return 0;
-	}
-	else if (rc == PCRE_ERROR_BADOPTION)
-	{
-		throw RegularExpressionException("bad option");
-	}
-	else if (rc == 0)
-	{
-		throw RegularExpressionException("too many captured substrings");
-	}
-	else if (rc < 0)
-	{
-		std::ostringstream msg;
-		msg << "PCRE error " << rc;
-		throw RegularExpressionException(msg.str());
-	}
-	matches.reserve(rc);
+	OVector ovec(_ovecSize);
+	int rc = exec(subject, offset, options, ovec.data(), ovec.size());
+	matches.resize(rc);
 	for (int i = 0; i < rc; ++i)
 	{
-		Match m;
+		Match& m = matches[i];
 		m.offset = ovec[i*2] < 0 ? std::string::npos : ovec[i*2] ;
 		m.length = ovec[i*2 + 1] - m.offset;
-		matches.push_back(m);
 	}
 	return rc;
 }
@@ -164,16 +191,17 @@ int RegularExpression::extract(const std::string& subject, std::string::size_typ
 
 int RegularExpression::split(const std::string& subject, std::string::size_type offset, std::vector<std::string>& strings, int options) const
 {
-	MatchVec matches;
-	strings.clear();
-	int rc = match(subject, offset, matches, options);
-	strings.reserve(matches.size());
-	for (MatchVec::const_iterator it = matches.begin(); it != matches.end(); ++it)
+	poco_assert (offset <= subject.length());
+
+	OVector ovec(_ovecSize);
+	int rc = exec(subject, offset, options, ovec.data(), ovec.size());
+	strings.resize(rc);
+	for (int i = 0; i < rc; ++i)
 	{
-		if (it->offset != std::string::npos)
-			strings.push_back(subject.substr(it->offset, it->length));
+		if (ovec[i*2] >= 0)
+			strings[i].assign(subject, ovec[i*2], ovec[i*2 + 1] - ovec[i*2]);
 		else
-			strings.push_back(std::string());
+			strings[i].clear();
 	}
 	return rc;
 }
@@ -203,11 +231,82 @@ std::string::size_type RegularExpression::substOne(std::string& subject, std::st
 {
 	if (offset >= subject.length()) return std::string::npos;
 
-	int ovec[OVEC_SIZE];
-	int rc = pcre_exec(reinterpret_cast<pcre*>(_pcre), reinterpret_cast<struct pcre_extra*>(_extra), subject.c_str(), int(subject.size()), int(offset), options & 0xFFFF, ovec, OVEC_SIZE);
+	OVector ovec(_ovecSize);
+	int rc = exec(subject, offset, options, ovec.data(), ovec.size());
+	if (rc == 0) return std::string::npos;
+
+	std::string::size_type len   = subject.length();
+	std::string::size_type start = ovec[0];
+	std::string::size_type end   = ovec[1];
+	if (start >= len) return std::string::npos;
+
+	std::string result;
+	result.reserve(len + replacement.length());
+	result.append(subject, 0, start);
+	std::string::const_iterator it  = replacement.begin();
+	std::string::const_iterator rend = replacement.end();
+	while (it != rend)
+	{
+		if (*it == '$' && !(options & RE_NO_VARS))
+		{
+			++it;
+			if (it != rend)
+			{
+				char d = *it;
+				if (d >= '0' && d <= '9')
+				{
+					int c = d - '0';
+					if (c < rc && ovec[c*2] >= 0)
+					{
+						int o = ovec[c*2];
+						int l = ovec[c*2 + 1] - o;
+						result.append(subject, o, l);
+					}
+				}
+				else
+				{
+					result += '$';
+					result += d;
+				}
+				++it;
+			}
+			else result += '$';
+		}
+		else result += *it++;
+	}
+	std::string::size_type rp = result.length();
+	result.append(subject, end, std::string::npos);
+	subject.swap(result);
+	return rp;
+}
+
+
+int RegularExpression::exec(const std::string& subject, std::string::size_type offset, int options, int* ovec, int ovecSize) const
+{
+	options &= 0xFFFF;
+	if (_utf8 && !(options & RE_NO_UTF8_CHECK))
+	{
+		// Validating the subject ourselves is considerably faster than
+		// letting PCRE do it. For invalid subjects, PCRE still does the
+		// check in order to report the proper error.
+		if (UTF8::isValid(subject) && (offset == subject.length() || (static_cast<unsigned char>(subject[offset]) & 0xC0) != 0x80))
+			options |= RE_NO_UTF8_CHECK;
+	}
+
+	pcre* pRE = reinterpret_cast<pcre*>(_pcre);
+	pcre_extra* pExtra = reinterpret_cast<pcre_extra*>(_extra);
+	int rc = pcre_exec(pRE, pExtra, subject.data(), int(subject.size()), int(offset), options, ovec, ovecSize);
+	if (rc == PCRE_ERROR_JIT_STACKLIMIT && pExtra)
+	{
+		// The JIT-compiled code ran out of stack; fall back to the interpreter.
+		pcre_extra extra = *pExtra;
+		extra.flags &= ~PCRE_EXTRA_EXECUTABLE_JIT;
+		rc = pcre_exec(pRE, &extra, subject.data(), int(subject.size()), int(offset), options, ovec, ovecSize);
+	}
+
 	if (rc == PCRE_ERROR_NOMATCH)
 	{
-		return std::string::npos;
+		return 0;
 	}
 	else if (rc == PCRE_ERROR_BADOPTION)
 	{
@@ -223,52 +322,7 @@ std::string::size_type RegularExpression::substOne(std::string& subject, std::st
 		msg << "PCRE error " << rc;
 		throw RegularExpressionException(msg.str());
 	}
-	std::string result;
-	std::string::size_type len = subject.length();
-	std::string::size_type pos = 0;
-	std::string::size_type rp = std::string::npos;
-	while (pos < len)
-	{
-		if (ovec[0] == pos)
-		{
-			std::string::const_iterator it  = replacement.begin();
-			std::string::const_iterator end = replacement.end();
-			while (it != end)
-			{
-				if (*it == '$' && !(options & RE_NO_VARS))
-				{
-					++it;
-					if (it != end)
-					{
-						char d = *it;
-						if (d >= '0' && d <= '9')
-						{
-							int c = d - '0';
-							if (c < rc)
-							{
-								int o = ovec[c*2];
-								int l = ovec[c*2 + 1] - o;
-								result.append(subject, o, l);
-							}
-						}
-						else
-						{
-							result += '$';
-							result += d;
-						}
-						++it;
-					}
-					else result += '$';
-				}
-				else result += *it++;
-			}
-			pos = ovec[1];
-			rp = result.length();
-		}
-		else result += subject[pos++];
-	}
-	subject = result;
-	return rp;
+	return rc;
 }
 
 
@@ -276,8 +330,8 @@ bool RegularExpression::match(const std::string& subject, const std::string& pat
 {
 	int ctorOptions = options & (RE_CASELESS | RE_MULTILINE | RE_DOTALL | RE_EXTENDED | RE_ANCHORED | RE_DOLLAR_ENDONLY | RE_EXTRA | RE_UNGREEDY | RE_UTF8 | RE_NO_AUTO_CAPTURE);
 	int mtchOptions = options & (RE_ANCHORED | RE_NOTBOL | RE_NOTEOL | RE_NOTEMPTY | RE_NO_AUTO_CAPTURE | RE_NO_UTF8_CHECK);
-	RegularExpression re(pattern, ctorOptions, false);
-	return re.match(subject, 0, mtchOptions);
+	RegularExpressionCache::Ptr pRE = RegularExpressionCache::defaultCache().get(pattern, ctorOptions);
+	return pRE->match(subject, 0, mtchOptions);
 }
 
 
@@ -0,0 +1,86 @@
+//
+// RegularExpressionCache.cpp
+//
+// Library: Foundation
+// Package: RegExp
+// Module:  RegularExpressionCache
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/RegularExpressionCache.h"
+#include "Poco/SingletonHolder.h"
+
+
+namespace Poco {
+
+
+namespace
+{
+	std::string makeKey(const std::string& pattern, int options)
+	{
+		std::string key(reinterpret_cast<const char*>(&options), sizeof(options));
+		key += pattern;
+		return key;
+	}
+}
+
+
+RegularExpressionCache::RegularExpressionCache(long capacity):
+	_cache(capacity, 0, ConcurrentLRUCache<std::string, RegularExpression>::EVICT_CLOCK,
+		capacity < ConcurrentLRUCache<std::string, RegularExpression>::DEFAULT_SEGMENTS ? static_cast<int>(capacity) : ConcurrentLRUCache<std::string, RegularExpression>::DEFAULT_SEGMENTS)
+{
+	_cache.setGetEventEnabled(false);
+}
+
+
+RegularExpressionCache::~RegularExpressionCache()
+{
+}
+
+
+RegularExpressionCache::Ptr RegularExpressionCache::get(const std::string& pattern, int options)
+{
+	std::string key = makeKey(pattern, options);
+	Ptr pRE = _cache.get(key);
+	if (!pRE)
+	{
+		// Compile outside of the cache's locks. If another thread
+		// compiles the same pattern at the same time, the last
+		// one added wins, which is harmless.
+		pRE = new RegularExpression(pattern, options);
+		_cache.add(key, pRE);
+	}
+	return pRE;
+}
+
+
+void RegularExpressionCache::clear()
+{
+	_cache.clear();
+}
+
+
+std::size_t RegularExpressionCache::size()
+{
+	return _cache.size();
+}
+
+
+namespace
+{
+	static SingletonHolder<RegularExpressionCache> sh;
+}
+
+
+RegularExpressionCache& RegularExpressionCache::defaultCache()
+{
+	return *sh.get();
+}
+
+
+} // namespace Poco
@@ -0,0 +1,625 @@
+//
+// RingBufferChannel.cpp
+//
+// Library: Foundation
+// Package: Logging
+// Module:  RingBufferChannel
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/RingBufferChannel.h"
+#include "Poco/Message.h"
+#include "Poco/RefCountedObject.h"
+#include "Poco/LoggingRegistry.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/ErrorHandler.h"
+#include "Poco/Exception.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	std::atomic<UInt64> nextChannelId(1);
+
+	const std::size_t BATCH_SIZE = 256;
+	const long IDLE_WAIT = 100;
+	const int SPIN_COUNT = 64;
+}
+
+
+const std::string RingBufferChannel::PROP_CAPACITY   = "capacity";
+const std::string RingBufferChannel::PROP_OVERFLOW   = "overflow";
+const std::string RingBufferChannel::PROP_SAMPLERATE = "sampleRate";
+
+
+class RingBufferChannel::Ring: public RefCountedObject
+	/// A bounded single-producer/single-consumer queue of messages.
+	///
+	/// Slots are written by the thread owning the Ring and read
+	/// by the background thread of the RingBufferChannel.
+{
+public:
+	struct Slot
+	{
+		enum
+		{
+			DATA_SIZE = 192
+		};
+
+		Timestamp::TimeVal time;
+		long               tid;
+		long               pid;
+		const char*        file;
+		int                line;
+		int                prio;
+		Message*           pMessage;
+		UInt16             sourceLength;
+		UInt16             threadLength;
+		UInt16             textLength;
+		char               data[DATA_SIZE];
+	};
+
+	explicit Ring(std::size_t capacity):
+		_slots(capacity),
+		_mask(capacity - 1),
+		_head(0),
+		_cachedTail(0),
+		_sampleCounter(0),
+		_tail(0),
+		_cachedHead(0),
+		_abandoned(false)
+		/// Creates the Ring. Capacity must be a power of two.
+	{
+		poco_assert ((capacity & _mask) == 0);
+	}
+
+	Slot* back()
+		/// Returns the slot for the next message, or null if the
+		/// Ring is full. Must only be called by the producer.
+	{
+		std::size_t head = _head.load(std::memory_order_relaxed);
+		if (head - _cachedTail > _mask)
+		{
+			_cachedTail = _tail.load(std::memory_order_acquire);
+			if (head - _cachedTail > _mask) return 0;
+		}
+		return &_slots[head & _mask];
+	}
+
+	void push()
+		/// Publishes the slot returned by back().
+	{
+		_head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	Slot* front()
+		/// Returns the oldest message, or null if the Ring is empty.
+		/// Must only be called by the consumer.
+	{
+		std::size_t tail = _tail.load(std::memory_order_relaxed);
+		if (tail == _cachedHead)
+		{
+			_cachedHead = _head.load(std::memory_order_acquire);
+			if (tail == _cachedHead) return 0;
+		}
+		return &_slots[tail & _mask];
+	}
+
+	void pop()
+		/// Releases the slot returned by front().
+	{
+		_tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	std::size_t size() const
+		/// Returns the number of messages in the Ring.
+	{
+		std::size_t tail = _tail.load(std::memory_order_acquire);
+		return _head.load(std::memory_order_acquire) - tail;
+	}
+
+	std::size_t capacity() const
+	{
+		return _mask + 1;
+	}
+
+	bool sample(int rate)
+		/// Returns true for every rate-th call.
+		/// Must only be called by the producer.
+	{
+		return rate <= 1 || ++_sampleCounter % static_cast<unsigned>(rate) == 0;
+	}
+
+	void abandon()
+		/// Marks the Ring as no longer used by its producer.
+	{
+		_abandoned.store(true, std::memory_order_release);
+	}
+
+	bool abandoned() const
+	{
+		return _abandoned.load(std::memory_order_acquire);
+	}
+
+protected:
+	~Ring()
+	{
+		while (Slot* pSlot = front())
+		{
+			delete pSlot->pMessage;
+			pop();
+		}
+	}
+
+private:
+	std::vector<Slot>        _slots;
+	const std::size_t        _mask;
+	char                     _pad1[64];
+	std::atomic<std::size_t> _head;
+	std::size_t              _cachedTail;
+	unsigned                 _sampleCounter;
+	char                     _pad2[64];
+	std::atomic<std::size_t> _tail;
+	std::size_t              _cachedHead;
+	char                     _pad3[64];
+	std::atomic<bool>        _abandoned;
+};
+
+
+struct RingBufferChannel::ThreadRings
+	/// The rings of all RingBufferChannels a thread has logged to.
+{
+	struct Entry
+	{
+		UInt64        channelId;
+		AutoPtr<Ring> pRing;
+	};
+
+	~ThreadRings()
+	{
+		for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+		{
+			it->pRing->abandon();
+		}
+	}
+
+	std::vector<Entry> entries;
+};
+
+
+RingBufferChannel::RingBufferChannel(Channel* pChannel, std::size_t capacity, OverflowPolicy policy, Thread::Priority prio):
+	_id(nextChannelId.fetch_add(1)),
+	_pChannel(pChannel),
+	_capacity(0),
+	_policy(policy),
+	_sampleRate(DEFAULT_SAMPLE_RATE),
+	_dropped(0),
+	_thread("RingBufferChannel"),
+	_ringsVersion(0),
+	_open(false),
+	_stop(false),
+	_sleeping(false)
+{
+	if (_pChannel) _pChannel->duplicate();
+	setCapacity(capacity);
+	_thread.setPriority(prio);
+}
+
+
+RingBufferChannel::~RingBufferChannel()
+{
+	try
+	{
+		close();
+		if (_pChannel) _pChannel->release();
+	}
+	catch (...)
+	{
+		poco_unexpected();
+	}
+}
+
+
+void RingBufferChannel::setChannel(Channel* pChannel)
+{
+	FastMutex::ScopedLock lock(_channelMutex);
+
+	if (_pChannel) _pChannel->release();
+	_pChannel = pChannel;
+	if (_pChannel) _pChannel->duplicate();
+}
+
+
+void RingBufferChannel::setOverflowPolicy(OverflowPolicy policy)
+{
+	_policy.store(policy, std::memory_order_relaxed);
+}
+
+
+void RingBufferChannel::setSampleRate(int rate)
+{
+	if (rate < 1) throw InvalidArgumentException("sample rate must be positive");
+
+	_sampleRate.store(rate, std::memory_order_relaxed);
+}
+
+
+void RingBufferChannel::setCapacity(std::size_t capacity)
+{
+	std::size_t n = 2;
+	while (n < capacity) n <<= 1;
+	_capacity.store(n, std::memory_order_relaxed);
+}
+
+
+void RingBufferChannel::open()
+{
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	if (!_thread.isRunning())
+	{
+		_stop.store(false);
+		_thread.start(*this);
+	}
+	_open.store(true, std::memory_order_release);
+}
+
+
+void RingBufferChannel::close()
+{
+	FastMutex::ScopedLock lock(_threadMutex);
+
+	_open.store(false, std::memory_order_release);
+	if (_thread.isRunning())
+	{
+		_stop.store(true);
+		_wakeUp.set();
+		_thread.join();
+	}
+}
+
+
+void RingBufferChannel::flush()
+{
+	open();
+	while (!empty())
+	{
+		wakeUp();
+		Thread::sleep(1);
+	}
+}
+
+
+void RingBufferChannel::log(const Message& msg)
+{
+	if (!_open.load(std::memory_order_acquire)) open();
+
+	Ring* pRing = ringForThread();
+	int policy = _policy.load(std::memory_order_relaxed);
+	if (policy == OVERFLOW_SAMPLE && pRing->size() >= pRing->capacity()/2 && !pRing->sample(_sampleRate.load(std::memory_order_relaxed)))
+	{
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	Ring::Slot* pSlot = pRing->back();
+	if (!pSlot)
+	{
+		if (policy != OVERFLOW_BLOCK)
+		{
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		int spins = 0;
+		do
+		{
+			wakeUp();
+			if (++spins < SPIN_COUNT)
+			{
+				Thread::yield();
+			}
+			else
+			{
+				if (!_open.load(std::memory_order_acquire)) open();
+				Thread::sleep(1);
+			}
+			pSlot = pRing->back();
+		}
+		while (!pSlot);
+	}
+
+	const std::string& source = msg.getSource();
+	const std::string& thread = msg.getThread();
+	const std::string& text = msg.getText();
+	if (msg.hasParameters() || source.size() + thread.size() + text.size() > Ring::Slot::DATA_SIZE)
+	{
+		pSlot->pMessage = new Message(msg);
+	}
+	else
+	{
+		pSlot->time = msg.getTime().raw();
+		pSlot->tid = msg.getTid();
+		pSlot->pid = msg.getPid();
+		pSlot->file = msg.getSourceFile();
+		pSlot->line = msg.getSourceLine();
+		pSlot->prio = msg.getPriority();
+		pSlot->pMessage = 0;
+		pSlot->sourceLength = static_cast<UInt16>(source.size());
+		pSlot->threadLength = static_cast<UInt16>(thread.size());
+		pSlot->textLength = static_cast<UInt16>(text.size());
+		char* p = pSlot->data;
+		std::memcpy(p, source.data(), source.size());
+		p += source.size();
+		std::memcpy(p, thread.data(), thread.size());
+		p += thread.size();
+		std::memcpy(p, text.data(), text.size());
+	}
+	pRing->push();
+
+	if (_sleeping.load(std::memory_order_relaxed)) wakeUp();
+}
+
+
+void RingBufferChannel::setProperty(const std::string& name, const std::string& value)
+{
+	if (name == "channel")
+	{
+		setChannel(LoggingRegistry::defaultRegistry().channelForName(value));
+	}
+	else if (name == "priority")
+	{
+		setPriority(value);
+	}
+	else if (name == PROP_CAPACITY)
+	{
+		setCapacity(NumberParser::parseUnsigned(value));
+	}
+	else if (name == PROP_OVERFLOW)
+	{
+		if (value == "block")
+			setOverflowPolicy(OVERFLOW_BLOCK);
+		else if (value == "drop")
+			setOverflowPolicy(OVERFLOW_DROP);
+		else if (value == "sample")
+			setOverflowPolicy(OVERFLOW_SAMPLE);
+		else
+			throw InvalidArgumentException("overflow policy", value);
+	}
+	else if (name == PROP_SAMPLERATE)
+	{
+		setSampleRate(NumberParser::parse(value));
+	}
+	else Channel::setProperty(name, value);
+}
+
+
+std::string RingBufferChannel::getProperty(const std::string& name) const
+{
+	if (name == PROP_CAPACITY)
+	{
+		return NumberFormatter::format(getCapacity());
+	}
+	else if (name == PROP_OVERFLOW)
+	{
+		switch (getOverflowPolicy())
+		{
+		case OVERFLOW_DROP:
+			return "drop";
+		case OVERFLOW_SAMPLE:
+			return "sample";
+		default:
+			return "block";
+		}
+	}
+	else if (name == PROP_SAMPLERATE)
+	{
+		return NumberFormatter::format(getSampleRate());
+	}
+	else return Channel::getProperty(name);
+}
+
+
+void RingBufferChannel::run()
+{
+	std::vector<AutoPtr<Ring> > rings;
+	UInt64 version = ~UInt64(0);
+	Message msg;
+	std::string buffer;
+	for (;;)
+	{
+		refreshRings(rings, version);
+
+		std::size_t count = 0;
+		{
+			FastMutex::ScopedLock lock(_channelMutex);
+
+			for (std::vector<AutoPtr<Ring> >::iterator it = rings.begin(); it != rings.end(); ++it)
+			{
+				count += deliver(**it, msg, buffer);
+			}
+		}
+
+		for (std::vector<AutoPtr<Ring> >::iterator it = rings.begin(); it != rings.end(); ++it)
+		{
+			if ((*it)->abandoned() && (*it)->size() == 0)
+			{
+				FastMutex::ScopedLock lock(_ringsMutex);
+
+				for (std::vector<AutoPtr<Ring> >::iterator itR = _rings.begin(); itR != _rings.end(); ++itR)
+				{
+					if (*itR == *it)
+					{
+						_rings.erase(itR);
+						_ringsVersion.fetch_add(1, std::memory_order_release);
+						break;
+					}
+				}
+			}
+		}
+
+		if (count == 0)
+		{
+			if (_stop.load()) break;
+
+			// A producer only signals the event if it sees _sleeping set,
+			// so check the rings once more after setting it. As producers
+			// do not use a full fence, a wakeup may still be missed,
+			// therefore the wait is bounded.
+			_sleeping.store(true);
+			if (empty()) _wakeUp.tryWait(IDLE_WAIT);
+			_sleeping.store(false);
+		}
+	}
+}
+
+
+std::size_t RingBufferChannel::deliver(Ring& ring, Message& msg, std::string& buffer)
+{
+	std::size_t count = 0;
+	while (count < BATCH_SIZE)
+	{
+		Ring::Slot* pSlot = ring.front();
+		if (!pSlot) break;
+
+		try
+		{
+			if (pSlot->pMessage)
+			{
+				if (_pChannel) _pChannel->log(*pSlot->pMessage);
+			}
+			else if (_pChannel)
+			{
+				const char* p = pSlot->data;
+				buffer.assign(p, pSlot->sourceLength);
+				msg.setSource(buffer);
+				p += pSlot->sourceLength;
+				buffer.assign(p, pSlot->threadLength);
+				msg.setThread(buffer);
+				p += pSlot->threadLength;
+				buffer.assign(p, pSlot->textLength);
+				msg.setText(buffer);
+				msg.setTime(Timestamp(pSlot->time));
+				msg.setTid(pSlot->tid);
+				msg.setPid(pSlot->pid);
+				msg.setSourceFile(pSlot->file);
+				msg.setSourceLine(pSlot->line);
+				msg.setPriority(static_cast<Message::Priority>(pSlot->prio));
+				_pChannel->log(msg);
+			}
+		}
+		catch (Exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (std::exception& exc)
+		{
+			ErrorHandler::handle(exc);
+		}
+		catch (...)
+		{
+			ErrorHandler::handle();
+		}
+		delete pSlot->pMessage;
+		pSlot->pMessage = 0;
+		ring.pop();
+		++count;
+	}
+	return count;
+}
+
+
+void RingBufferChannel::refreshRings(std::vector<AutoPtr<Ring> >& rings, UInt64& version)
+{
+	if (_ringsVersion.load(std::memory_order_acquire) != version)
+	{
+		FastMutex::ScopedLock lock(_ringsMutex);
+
+		rings = _rings;
+		version = _ringsVersion.load(std::memory_order_relaxed);
+	}
+}
+
+
+bool RingBufferChannel::empty()
+{
+	FastMutex::ScopedLock lock(_ringsMutex);
+
+	for (std::vector<AutoPtr<Ring> >::const_iterator it = _rings.begin(); it != _rings.end(); ++it)
+	{
+		if ((*it)->size() != 0) return false;
+	}
+	return true;
+}
+
+
+RingBufferChannel::Ring* RingBufferChannel::ringForThread()
+{
+	static thread_local ThreadRings threadRings;
+
+	std::vector<ThreadRings::Entry>& entries = threadRings.entries;
+	for (std::vector<ThreadRings::Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+	{
+		if (it->channelId == _id) return it->pRing.get();
+	}
+
+	// Forget the rings of channels that have been destroyed.
+	std::vector<ThreadRings::Entry>::iterator it = entries.begin();
+	while (it != entries.end())
+	{
+		if (it->pRing->referenceCount() == 1)
+			it = entries.erase(it);
+		else
+			++it;
+	}
+
+	ThreadRings::Entry entry;
+	entry.channelId = _id;
+	entry.pRing = new Ring(getCapacity());
+	{
+		FastMutex::ScopedLock lock(_ringsMutex);
+
+		_rings.push_back(entry.pRing);
+		_ringsVersion.fetch_add(1, std::memory_order_release);
+	}
+	entries.push_back(entry);
+	return entry.pRing.get();
+}
+
+
+void RingBufferChannel::wakeUp()
+{
+	if (_sleeping.exchange(false)) _wakeUp.set();
+}
+
+
+void RingBufferChannel::setPriority(const std::string& value)
+{
+	Thread::Priority prio = Thread::PRIO_NORMAL;
+
+	if (value == "lowest")
+		prio = Thread::PRIO_LOWEST;
+	else if (value == "low")
+		prio = Thread::PRIO_LOW;
+	else if (value == "normal")
+		prio = Thread::PRIO_NORMAL;
+	else if (value == "high")
+		prio = Thread::PRIO_HIGH;
+	else if (value == "highest")
+		prio = Thread::PRIO_HIGHEST;
+	else
+		throw InvalidArgumentException("thread priority", value);
+
+	_thread.setPriority(prio);
+}
+
+
+} // namespace Poco
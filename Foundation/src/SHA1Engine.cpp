@@ -16,7 +16,11 @@
 
 
 #include "Poco/SHA1Engine.h"
+#include "Poco/CPUFeatures.h"
 #include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <immintrin.h>
+#endif
 
 
 #ifdef POCO_ARCH_LITTLE_ENDIAN
@@ -29,6 +33,71 @@
 namespace Poco {
 
 
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+
+namespace
+{
+	template <int G>
+	POCO_TARGET("sha,sse4.1")
+	inline void sha1Rounds(__m128i& abcd, __m128i& e, __m128i& next, __m128i& msg, __m128i& msgNext, __m128i& msgPrev, __m128i& msgPrev2)
+		/// Computes rounds 4*G to 4*G + 3 with SHA1RNDS4, deriving E with
+		/// SHA1NEXTE, while SHA1MSG1/MSG2 compute the message schedule.
+	{
+		e = G == 0 ? _mm_add_epi32(e, msg) : _mm_sha1nexte_epu32(e, msg);
+		next = abcd;
+		if (G >= 3 && G <= 18) msgNext = _mm_sha1msg2_epu32(msgNext, msg);
+		abcd = _mm_sha1rnds4_epu32(abcd, e, G/5);
+		if (G >= 1 && G <= 16) msgPrev = _mm_sha1msg1_epu32(msgPrev, msg);
+		if (G >= 2 && G <= 17) msgPrev2 = _mm_xor_si128(msgPrev2, msg);
+	}
+
+
+#define POCO_SHA1_ROUNDS16(g) \
+	sha1Rounds<g>(abcd, e0, e1, m0, m1, m3, m2); \
+	sha1Rounds<g + 1>(abcd, e1, e0, m1, m2, m0, m3); \
+	sha1Rounds<g + 2>(abcd, e0, e1, m2, m3, m1, m0); \
+	sha1Rounds<g + 3>(abcd, e1, e0, m3, m0, m2, m1)
+
+
+	POCO_TARGET("sha,sse4.1")
+	void sha1BlocksSHA(UInt32* state, const unsigned char* data, std::size_t blocks)
+		/// Processes blocks using the SHA extensions.
+	{
+		const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+		__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+		__m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+		__m128i e1 = _mm_setzero_si128();
+		for (; blocks > 0; --blocks, data += 64)
+		{
+			const __m128i abcdSave = abcd;
+			const __m128i eSave = e0;
+			__m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), mask);
+			__m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), mask);
+			__m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), mask);
+			__m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), mask);
+			POCO_SHA1_ROUNDS16(0);
+			POCO_SHA1_ROUNDS16(4);
+			POCO_SHA1_ROUNDS16(8);
+			POCO_SHA1_ROUNDS16(12);
+			POCO_SHA1_ROUNDS16(16);
+			e0 = _mm_sha1nexte_epu32(e0, eSave);
+			abcd = _mm_add_epi32(abcd, abcdSave);
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+		state[4] = static_cast<UInt32>(_mm_extract_epi32(e0, 3));
+	}
+
+
+#undef POCO_SHA1_ROUNDS16
+}
+
+
+#endif // POCO_HAVE_X86_INTRINSICS
+
+
 SHA1Engine::SHA1Engine()
 {
 	_digest.reserve(16);
@@ -64,20 +133,47 @@ void SHA1Engine::updateImpl(const void* buffer_, std::size_t count)
 	if ((_context.countLo + ((UInt32) count << 3)) < _context.countLo)
 		_context.countHi++; /* Carry from low to high bitCount */
 	_context.countLo += ((UInt32) count << 3);
-	_context.countHi += ((UInt32 ) count >> 29);
+	_context.countHi += static_cast<UInt32>(static_cast<UInt64>(count) >> 29);
+
+	/* Fill up a partially filled block first */
+	if (_context.slop > 0)
+	{
+		std::size_t n = BLOCK_SIZE - _context.slop;
+		if (n > count) n = count;
+		std::memcpy(db + _context.slop, buffer, n);
+		_context.slop += static_cast<UInt32>(n);
+		buffer += n;
+		count -= n;
+		if (_context.slop < BLOCK_SIZE) return;
+		SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
+		transform();
+		_context.slop = 0;
+	}
 
-	/* Process data in BLOCK_SIZE chunks */
-	while (count-- > 0)
+	/* Process complete blocks directly from the buffer */
+	std::size_t blocks = count/BLOCK_SIZE;
+	if (blocks > 0)
 	{
-		db[_context.slop++] = *(buffer++);
-		if (_context.slop == BLOCK_SIZE)
-		{ 
-			/* transform this one block */
+#if defined(POCO_HAVE_X86_INTRINSICS)
+		if (CPUFeatures::hasSHA() && CPUFeatures::hasSSE42())
+		{
+			sha1BlocksSHA(_context.digest, buffer, blocks);
+			buffer += blocks*BLOCK_SIZE;
+		}
+		else
+#endif
+		for (std::size_t i = 0; i < blocks; ++i, buffer += BLOCK_SIZE)
+		{
+			std::memcpy(db, buffer, BLOCK_SIZE);
 			SHA1_BYTE_REVERSE(_context.data, BLOCK_SIZE);
 			transform();
-			_context.slop = 0 ;	/* no slop left */
 		}
+		count -= blocks*BLOCK_SIZE;
 	}
+
+	/* Save the remaining bytes */
+	std::memcpy(db, buffer, count);
+	_context.slop = static_cast<UInt32>(count);
 }
 
 
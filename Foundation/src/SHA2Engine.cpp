@@ -0,0 +1,434 @@
+//
+// SHA2Engine.cpp
+//
+// Library: Foundation
+// Package: Crypt
+// Module:  SHA2Engine
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/SHA2Engine.h"
+#include "Poco/CPUFeatures.h"
+#include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <immintrin.h>
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const UInt32 K256[64] =
+	{
+		0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+		0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+		0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+		0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+		0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+		0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+		0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+		0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+	};
+
+
+	const UInt64 K512[80] =
+	{
+		0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+		0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+		0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+		0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+		0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+		0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+		0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+		0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+		0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+		0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+		0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+		0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+		0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+		0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+		0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+		0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+		0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+		0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+		0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+		0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+	};
+
+
+	inline UInt32 rotr(UInt32 x, int n)
+	{
+		return (x >> n) | (x << (32 - n));
+	}
+
+
+	inline UInt64 rotr(UInt64 x, int n)
+	{
+		return (x >> n) | (x << (64 - n));
+	}
+
+
+	inline UInt32 load32(const unsigned char* p)
+	{
+		return (UInt32(p[0]) << 24) | (UInt32(p[1]) << 16) | (UInt32(p[2]) << 8) | UInt32(p[3]);
+	}
+
+
+	inline UInt64 load64(const unsigned char* p)
+	{
+		return (UInt64(load32(p)) << 32) | load32(p + 4);
+	}
+
+
+	inline void store32(unsigned char* p, UInt32 v)
+	{
+		p[0] = static_cast<unsigned char>(v >> 24);
+		p[1] = static_cast<unsigned char>(v >> 16);
+		p[2] = static_cast<unsigned char>(v >> 8);
+		p[3] = static_cast<unsigned char>(v);
+	}
+
+
+	inline void store64(unsigned char* p, UInt64 v)
+	{
+		store32(p, static_cast<UInt32>(v >> 32));
+		store32(p + 4, static_cast<UInt32>(v));
+	}
+
+
+	void sha256Blocks(UInt32* state, const unsigned char* data, std::size_t blocks)
+	{
+		for (; blocks > 0; --blocks, data += 64)
+		{
+			UInt32 w[64];
+			for (int i = 0; i < 16; ++i)
+				w[i] = load32(data + 4*i);
+			for (int i = 16; i < 64; ++i)
+			{
+				UInt32 s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+				UInt32 s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+				w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+			}
+
+			UInt32 a = state[0], b = state[1], c = state[2], d = state[3];
+			UInt32 e = state[4], f = state[5], g = state[6], h = state[7];
+			for (int i = 0; i < 64; ++i)
+			{
+				UInt32 t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K256[i] + w[i];
+				UInt32 t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+				h = g;
+				g = f;
+				f = e;
+				e = d + t1;
+				d = c;
+				c = b;
+				b = a;
+				a = t1 + t2;
+			}
+			state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+			state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+		}
+	}
+
+
+	void sha512Blocks(UInt64* state, const unsigned char* data, std::size_t blocks)
+	{
+		for (; blocks > 0; --blocks, data += 128)
+		{
+			UInt64 w[80];
+			for (int i = 0; i < 16; ++i)
+				w[i] = load64(data + 8*i);
+			for (int i = 16; i < 80; ++i)
+			{
+				UInt64 s0 = rotr(w[i - 15], 1) ^ rotr(w[i - 15], 8) ^ (w[i - 15] >> 7);
+				UInt64 s1 = rotr(w[i - 2], 19) ^ rotr(w[i - 2], 61) ^ (w[i - 2] >> 6);
+				w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+			}
+
+			UInt64 a = state[0], b = state[1], c = state[2], d = state[3];
+			UInt64 e = state[4], f = state[5], g = state[6], h = state[7];
+			for (int i = 0; i < 80; ++i)
+			{
+				UInt64 t1 = h + (rotr(e, 14) ^ rotr(e, 18) ^ rotr(e, 41)) + ((e & f) ^ (~e & g)) + K512[i] + w[i];
+				UInt64 t2 = (rotr(a, 28) ^ rotr(a, 34) ^ rotr(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+				h = g;
+				g = f;
+				f = e;
+				e = d + t1;
+				d = c;
+				c = b;
+				b = a;
+				a = t1 + t2;
+			}
+			state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+			state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+		}
+	}
+
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+
+	template <int G>
+	POCO_TARGET("sha,sse4.1")
+	inline void sha256Rounds(__m128i& state0, __m128i& state1, __m128i& msg, __m128i& msgNext, __m128i& msgPrev)
+		/// Computes rounds 4*G to 4*G + 3, two at a time with SHA256RNDS2,
+		/// while SHA256MSG1/MSG2 compute the message schedule.
+	{
+		const __m128i m = _mm_add_epi32(msg, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K256 + 4*G)));
+		state1 = _mm_sha256rnds2_epu32(state1, state0, m);
+		if (G >= 3 && G <= 14)
+		{
+			msgNext = _mm_add_epi32(msgNext, _mm_alignr_epi8(msg, msgPrev, 4));
+			msgNext = _mm_sha256msg2_epu32(msgNext, msg);
+		}
+		state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(m, 0x0E));
+		if (G >= 1 && G <= 12) msgPrev = _mm_sha256msg1_epu32(msgPrev, msg);
+	}
+
+
+#define POCO_SHA256_ROUNDS16(g) \
+	sha256Rounds<g>(state0, state1, m0, m1, m3); \
+	sha256Rounds<g + 1>(state0, state1, m1, m2, m0); \
+	sha256Rounds<g + 2>(state0, state1, m2, m3, m1); \
+	sha256Rounds<g + 3>(state0, state1, m3, m0, m2)
+
+
+	POCO_TARGET("sha,sse4.1")
+	void sha256BlocksSHA(UInt32* state, const unsigned char* data, std::size_t blocks)
+		/// Processes blocks using the SHA extensions.
+	{
+		const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+		// state is kept as ABEF and CDGH
+		__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+		__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+		__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+		state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+		for (; blocks > 0; --blocks, data += 64)
+		{
+			const __m128i abefSave = state0;
+			const __m128i cdghSave = state1;
+			__m128i m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), mask);
+			__m128i m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), mask);
+			__m128i m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), mask);
+			__m128i m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), mask);
+			POCO_SHA256_ROUNDS16(0);
+			POCO_SHA256_ROUNDS16(4);
+			POCO_SHA256_ROUNDS16(8);
+			POCO_SHA256_ROUNDS16(12);
+			state0 = _mm_add_epi32(state0, abefSave);
+			state1 = _mm_add_epi32(state1, cdghSave);
+		}
+
+		tmp = _mm_shuffle_epi32(state0, 0x1B);
+		state1 = _mm_shuffle_epi32(state1, 0xB1);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(tmp, state1, 0xF0));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(state1, tmp, 8));
+	}
+
+
+#undef POCO_SHA256_ROUNDS16
+
+
+#endif // POCO_HAVE_X86_INTRINSICS
+}
+
+
+SHA2Engine::SHA2Engine(ALGORITHM algorithm):
+	_algorithm(algorithm)
+{
+	_digest.reserve(digestLength());
+	reset();
+}
+
+
+SHA2Engine::~SHA2Engine()
+{
+	reset();
+}
+
+
+std::size_t SHA2Engine::digestLength() const
+{
+	return _algorithm/8;
+}
+
+
+void SHA2Engine::reset()
+{
+	static const UInt32 IV224[8] =
+	{
+		0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+	};
+	static const UInt32 IV256[8] =
+	{
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+	static const UInt64 IV384[8] =
+	{
+		0xcbbb9d5dc1059ed8ULL, 0x629a292a367cd507ULL, 0x9159015a3070dd17ULL, 0x152fecd8f70e5939ULL,
+		0x67332667ffc00b31ULL, 0x8eb44a8768581511ULL, 0xdb0c2e0d64f98fa7ULL, 0x47b5481dbefa4fa4ULL
+	};
+	static const UInt64 IV512[8] =
+	{
+		0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+		0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+	};
+
+	std::memset(_state32, 0, sizeof(_state32));
+	std::memset(_state64, 0, sizeof(_state64));
+	switch (_algorithm)
+	{
+	case SHA_224:
+		std::memcpy(_state32, IV224, sizeof(_state32));
+		break;
+	case SHA_256:
+		std::memcpy(_state32, IV256, sizeof(_state32));
+		break;
+	case SHA_384:
+		std::memcpy(_state64, IV384, sizeof(_state64));
+		break;
+	case SHA_512:
+		std::memcpy(_state64, IV512, sizeof(_state64));
+		break;
+	}
+	_count = 0;
+	std::memset(_buffer, 0, sizeof(_buffer));
+}
+
+
+void SHA2Engine::updateImpl(const void* data, std::size_t length)
+{
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	const std::size_t blockLength = blockSize();
+	std::size_t used = static_cast<std::size_t>(_count % blockLength);
+	_count += length;
+
+	if (used > 0)
+	{
+		std::size_t n = blockLength - used;
+		if (n > length) n = length;
+		std::memcpy(_buffer + used, p, n);
+		p += n;
+		length -= n;
+		if (used + n < blockLength) return;
+		transform(_buffer, 1);
+	}
+	if (length >= blockLength)
+	{
+		std::size_t blocks = length/blockLength;
+		transform(p, blocks);
+		p += blocks*blockLength;
+		length -= blocks*blockLength;
+	}
+	if (length > 0) std::memcpy(_buffer, p, length);
+}
+
+
+void SHA2Engine::transform(const unsigned char* data, std::size_t blocks)
+{
+	if (blockSize() == 128)
+	{
+		sha512Blocks(_state64, data, blocks);
+		return;
+	}
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	if (CPUFeatures::hasSHA() && CPUFeatures::hasSSE42())
+	{
+		sha256BlocksSHA(_state32, data, blocks);
+		return;
+	}
+#endif
+	sha256Blocks(_state32, data, blocks);
+}
+
+
+const DigestEngine::Digest& SHA2Engine::digest()
+{
+	const std::size_t blockLength = blockSize();
+	const std::size_t lengthSize = blockLength/8;
+	std::size_t used = static_cast<std::size_t>(_count % blockLength);
+
+	// pad with 0x80 and zeros, followed by the big-endian bit count
+	_buffer[used++] = 0x80;
+	if (used > blockLength - lengthSize)
+	{
+		std::memset(_buffer + used, 0, blockLength - used);
+		transform(_buffer, 1);
+		used = 0;
+	}
+	std::memset(_buffer + used, 0, blockLength - used);
+	store64(_buffer + blockLength - 8, _count << 3);
+	if (lengthSize == 16) store64(_buffer + blockLength - 16, _count >> 61);
+	transform(_buffer, 1);
+
+	unsigned char hash[64];
+	if (blockLength == 64)
+	{
+		for (int i = 0; i < 8; ++i) store32(hash + 4*i, _state32[i]);
+	}
+	else
+	{
+		for (int i = 0; i < 8; ++i) store64(hash + 8*i, _state64[i]);
+	}
+	_digest.clear();
+	_digest.insert(_digest.begin(), hash, hash + digestLength());
+	reset();
+	return _digest;
+}
+
+
+SHA2Engine224::SHA2Engine224():
+	SHA2Engine(SHA_224)
+{
+}
+
+
+SHA2Engine224::~SHA2Engine224()
+{
+}
+
+
+SHA2Engine256::SHA2Engine256():
+	SHA2Engine(SHA_256)
+{
+}
+
+
+SHA2Engine256::~SHA2Engine256()
+{
+}
+
+
+SHA2Engine384::SHA2Engine384():
+	SHA2Engine(SHA_384)
+{
+}
+
+
+SHA2Engine384::~SHA2Engine384()
+{
+}
+
+
+SHA2Engine512::SHA2Engine512():
+	SHA2Engine(SHA_512)
+{
+}
+
+
+SHA2Engine512::~SHA2Engine512()
+{
+}
+
+
+} // namespace Poco
@@ -13,18 +13,173 @@
 
 
 #include "Poco/StreamCopier.h"
+#include "Poco/NativeStreamBuf.h"
 #include "Poco/Buffer.h"
+#if POCO_OS == POCO_OS_LINUX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#define POCO_STREAMCOPIER_NATIVE
+#endif
 
 
 namespace Poco {
 
 
+NativeStreamBuf::~NativeStreamBuf()
+{
+}
+
+
+namespace
+{
+#if defined(POCO_STREAMCOPIER_NATIVE)
+
+	enum CopyMethod
+	{
+		COPY_FILE_RANGE, /// regular file to regular file, may share blocks on file systems that support it
+		COPY_SENDFILE,   /// regular file to anything, e.g. a socket
+		COPY_SPLICE      /// from or to a pipe
+	};
+
+	const std::size_t MAX_CHUNK_SIZE = 0x40000000;
+
+
+	ssize_t transfer(CopyMethod method, int in, int out)
+	{
+		switch (method)
+		{
+		case COPY_FILE_RANGE:
+#if defined(__NR_copy_file_range)
+			// Invoked through syscall(), as the glibc wrapper requires glibc 2.27.
+			return syscall(__NR_copy_file_range, in, static_cast<loff_t*>(0), out, static_cast<loff_t*>(0), MAX_CHUNK_SIZE, 0u);
+#else
+			errno = ENOSYS;
+			return -1;
+#endif
+		case COPY_SENDFILE:
+			return sendfile(out, in, 0, MAX_CHUNK_SIZE);
+		default:
+			return splice(in, 0, out, 0, MAX_CHUNK_SIZE, SPLICE_F_MOVE);
+		}
+	}
+
+
+	bool isUnsupported(int err)
+		/// Returns true if err indicates that the kernel cannot
+		/// copy between the given descriptors with a method.
+	{
+		return err == EINVAL || err == ENOSYS || err == EXDEV || err == EOPNOTSUPP || err == EBADF || err == ESPIPE;
+	}
+
+
+	bool copyNative(std::istream& istr, std::ostream& ostr, Poco::UInt64& len)
+		/// Copies all data from istr to ostr within the kernel, if both
+		/// streams have a NativeStreamBuf with suitable descriptors.
+		/// Returns false if the copy must be done by the caller.
+		/// The number of bytes copied is added to len.
+	{
+		if (!istr.good() || !ostr.good()) return false;
+
+		NativeStreamBuf* pIn  = dynamic_cast<NativeStreamBuf*>(istr.rdbuf());
+		NativeStreamBuf* pOut = dynamic_cast<NativeStreamBuf*>(ostr.rdbuf());
+		if (!pIn || !pOut) return false;
+
+		int in  = pIn->nativeDescriptor(std::ios::in);
+		int out = pOut->nativeDescriptor(std::ios::out);
+		if (in == -1 || out == -1 || in == out) return false;
+
+		struct stat inStat;
+		struct stat outStat;
+		if (fstat(in, &inStat) != 0 || fstat(out, &outStat) != 0) return false;
+
+		CopyMethod method;
+		if (S_ISREG(inStat.st_mode) && inStat.st_size > 0) // files in /proc report a size of 0
+			method = S_ISREG(outStat.st_mode) ? COPY_FILE_RANGE : COPY_SENDFILE;
+		else if (S_ISFIFO(inStat.st_mode) || S_ISFIFO(outStat.st_mode))
+			method = COPY_SPLICE;
+		else
+			return false;
+
+		// Data already read into the input stream's buffer
+		// must be written before the rest of the file.
+		std::streamsize avail = istr.rdbuf()->in_avail();
+		if (avail > 0)
+		{
+			Buffer<char> buffer(static_cast<std::size_t>(avail));
+			istr.read(buffer.begin(), avail);
+			std::streamsize n = istr.gcount();
+			len += n;
+			ostr.write(buffer.begin(), n);
+		}
+		ostr.flush();
+		if (!istr.good() || !ostr.good()) return false;
+
+		Poco::UInt64 total = 0;
+		for (;;)
+		{
+			ssize_t n = transfer(method, in, out);
+			if (n > 0)
+			{
+				total += n;
+			}
+			else if (n == 0)
+			{
+				// Some file systems report a size, but cannot be copied by the kernel.
+				if (total == 0 && method != COPY_SPLICE && lseek(in, 0, SEEK_CUR) < inStat.st_size) return false;
+				break;
+			}
+			else if (errno != EINTR)
+			{
+				if (total == 0 && isUnsupported(errno))
+				{
+					if (method == COPY_FILE_RANGE)
+						method = COPY_SENDFILE;
+					else
+						return false;
+				}
+				else
+				{
+					pIn->nativeTransferred(std::ios::in, static_cast<std::streamsize>(total));
+					pOut->nativeTransferred(std::ios::out, static_cast<std::streamsize>(total));
+					len += total;
+					ostr.setstate(std::ios::badbit);
+					return true;
+				}
+			}
+		}
+		pIn->nativeTransferred(std::ios::in, static_cast<std::streamsize>(total));
+		pOut->nativeTransferred(std::ios::out, static_cast<std::streamsize>(total));
+		len += total;
+		istr.setstate(std::ios::eofbit | std::ios::failbit);
+		return true;
+	}
+
+#else
+
+	bool copyNative(std::istream& istr, std::ostream& ostr, Poco::UInt64& len)
+	{
+		return false;
+	}
+
+#endif // POCO_STREAMCOPIER_NATIVE
+}
+
+
 std::streamsize StreamCopier::copyStream(std::istream& istr, std::ostream& ostr, std::size_t bufferSize)
 {
 	poco_assert (bufferSize > 0);
 
+	Poco::UInt64 copied = 0;
+	bool done = copyNative(istr, ostr, copied);
+	std::streamsize len = static_cast<std::streamsize>(copied);
+	if (done) return len;
+
 	Buffer<char> buffer(bufferSize);
-	std::streamsize len = 0;
 	istr.read(buffer.begin(), bufferSize);
 	std::streamsize n = istr.gcount();
 	while (n > 0)
@@ -47,8 +202,10 @@ Poco::UInt64 StreamCopier::copyStream64(std::istream& istr, std::ostream& ostr,
 {
 	poco_assert (bufferSize > 0);
 
-	Buffer<char> buffer(bufferSize);
 	Poco::UInt64 len = 0;
+	if (copyNative(istr, ostr, len)) return len;
+
+	Buffer<char> buffer(bufferSize);
 	istr.read(buffer.begin(), bufferSize);
 	std::streamsize n = istr.gcount();
 	while (n > 0)
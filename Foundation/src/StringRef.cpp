@@ -0,0 +1,176 @@
+//
+// StringRef.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringRef
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/StringRef.h"
+#include "Poco/CPUFeatures.h"
+#include <algorithm>
+#if defined(POCO_HAVE_X86_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define POCO_STRINGREF_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+
+namespace Poco {
+
+
+namespace
+{
+	const std::size_t MAX_SIMD_CHARS = 8;
+
+	std::size_t findFirstOfTable(const unsigned char* begin, const unsigned char* end, const unsigned char* chars, std::size_t nChars)
+	{
+		UInt32 table[8] = {0};
+		for (std::size_t i = 0; i < nChars; ++i)
+		{
+			table[chars[i] >> 5] |= UInt32(1) << (chars[i] & 31);
+		}
+		for (const unsigned char* it = begin; it != end; ++it)
+		{
+			if (table[*it >> 5] & (UInt32(1) << (*it & 31))) return it - begin;
+		}
+		return StringRef::npos;
+	}
+
+
+#if defined(POCO_STRINGREF_SSE2)
+
+	std::size_t findFirstOfSSE2(const unsigned char* begin, const unsigned char* end, const unsigned char* chars, std::size_t nChars)
+	{
+		__m128i sets[MAX_SIMD_CHARS];
+		for (std::size_t i = 0; i < nChars; ++i)
+		{
+			sets[i] = _mm_set1_epi8(static_cast<char>(chars[i]));
+		}
+		const unsigned char* it = begin;
+		while (end - it >= 16)
+		{
+			__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+			__m128i hits = _mm_cmpeq_epi8(block, sets[0]);
+			for (std::size_t i = 1; i < nChars; ++i)
+			{
+				hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, sets[i]));
+			}
+			int mask = _mm_movemask_epi8(hits);
+			if (mask)
+			{
+#if defined(_MSC_VER)
+				unsigned long bit;
+				_BitScanForward(&bit, mask);
+				return (it - begin) + bit;
+#else
+				return (it - begin) + __builtin_ctz(mask);
+#endif
+			}
+			it += 16;
+		}
+		for (; it != end; ++it)
+		{
+			for (std::size_t i = 0; i < nChars; ++i)
+			{
+				if (*it == chars[i]) return it - begin;
+			}
+		}
+		return StringRef::npos;
+	}
+
+#endif // POCO_STRINGREF_SSE2
+}
+
+
+const std::size_t StringRef::npos;
+
+
+std::size_t StringRef::find(const StringRef& str, std::size_t pos) const
+{
+	if (pos > _length || str._length > _length - pos) return npos;
+	if (str._length == 0) return pos;
+
+	const char* it  = _data + pos;
+	const char* end = _data + _length - str._length + 1;
+	while (it < end)
+	{
+		const void* p = std::memchr(it, static_cast<unsigned char>(str._data[0]), end - it);
+		if (!p) break;
+		it = static_cast<const char*>(p);
+		if (std::memcmp(it + 1, str._data + 1, str._length - 1) == 0) return it - _data;
+		++it;
+	}
+	return npos;
+}
+
+
+std::size_t StringRef::rfind(char ch, std::size_t pos) const
+{
+	if (_length == 0) return npos;
+	if (pos >= _length) pos = _length - 1;
+	const char* it = _data + pos + 1;
+	while (it != _data)
+	{
+		if (*--it == ch) return it - _data;
+	}
+	return npos;
+}
+
+
+std::size_t StringRef::findFirstOf(const StringRef& chars, std::size_t pos) const
+{
+	if (pos >= _length || chars._length == 0) return npos;
+
+	const unsigned char* begin = reinterpret_cast<const unsigned char*>(_data) + pos;
+	const unsigned char* end   = reinterpret_cast<const unsigned char*>(_data) + _length;
+	const unsigned char* set   = reinterpret_cast<const unsigned char*>(chars._data);
+	std::size_t result;
+	if (chars._length == 1)
+	{
+		return find(chars._data[0], pos);
+	}
+#if defined(POCO_STRINGREF_SSE2)
+	else if (chars._length <= MAX_SIMD_CHARS)
+	{
+		result = findFirstOfSSE2(begin, end, set, chars._length);
+	}
+#endif
+	else
+	{
+		result = findFirstOfTable(begin, end, set, chars._length);
+	}
+	return result == npos ? npos : result + pos;
+}
+
+
+int StringRef::compare(const StringRef& str) const
+{
+	int rc = std::memcmp(_data, str._data, std::min(_length, str._length));
+	if (rc != 0) return rc;
+	return _length < str._length ? -1 : (_length > str._length ? 1 : 0);
+}
+
+
+int StringRef::icompare(const StringRef& str) const
+{
+	std::size_t n = std::min(_length, str._length);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		int c1 = Ascii::toLower(static_cast<unsigned char>(_data[i]));
+		int c2 = Ascii::toLower(static_cast<unsigned char>(str._data[i]));
+		if (c1 != c2) return c1 < c2 ? -1 : 1;
+	}
+	return _length < str._length ? -1 : (_length > str._length ? 1 : 0);
+}
+
+
+} // namespace Poco
@@ -0,0 +1,93 @@
+//
+// StringRefTokenizer.cpp
+//
+// Library: Foundation
+// Package: Core
+// Module:  StringRefTokenizer
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/StringRefTokenizer.h"
+
+
+namespace Poco {
+
+
+StringRefTokenizer::Iterator::Iterator():
+	_pTokenizer(0),
+	_pNext(0),
+	_end(true)
+{
+}
+
+
+StringRefTokenizer::Iterator::Iterator(const StringRefTokenizer* pTokenizer):
+	_pTokenizer(pTokenizer),
+	_pNext(pTokenizer->_str.empty() ? 0 : pTokenizer->_str.data()),
+	_end(false)
+{
+	next();
+}
+
+
+void StringRefTokenizer::Iterator::next()
+{
+	const char* end = _pTokenizer->_str.end();
+	bool doTrim = (_pTokenizer->_options & TOK_TRIM) != 0;
+	bool ignoreEmpty = (_pTokenizer->_options & TOK_IGNORE_EMPTY) != 0;
+	for (;;)
+	{
+		if (!_pNext)
+		{
+			_end = true;
+			_token = StringRef();
+			return;
+		}
+		StringRef rest(_pNext, end);
+		std::size_t pos = rest.findFirstOf(_pTokenizer->_separators);
+		if (pos == StringRef::npos)
+		{
+			_token = rest;
+			_pNext = 0;
+		}
+		else
+		{
+			_token = StringRef(_pNext, pos);
+			_pNext += pos + 1;
+		}
+		if (doTrim) _token = _token.trim();
+		if (!ignoreEmpty || !_token.empty()) return;
+	}
+}
+
+
+StringRefTokenizer::StringRefTokenizer(const StringRef& str, const StringRef& separators, int options):
+	_str(str),
+	_separators(separators),
+	_options(options)
+{
+}
+
+
+StringRefTokenizer::~StringRefTokenizer()
+{
+}
+
+
+std::size_t StringRefTokenizer::split(std::vector<StringRef>& tokens) const
+{
+	tokens.clear();
+	for (Iterator it = begin(); it != end(); ++it)
+	{
+		tokens.push_back(*it);
+	}
+	return tokens.size();
+}
+
+
+} // namespace Poco
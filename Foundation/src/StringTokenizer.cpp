@@ -13,6 +13,7 @@
 
 
 #include "Poco/StringTokenizer.h"
+#include "Poco/StringRefTokenizer.h"
 #include "Poco/Ascii.h"
 #include <algorithm>
 
@@ -22,37 +23,10 @@ namespace Poco {
 
 StringTokenizer::StringTokenizer(const std::string& str, const std::string& separators, int options)
 {
-	std::string::const_iterator it = str.begin();
-	std::string::const_iterator end = str.end();
-	std::string token;
-	bool doTrim = ((options & TOK_TRIM) != 0);
-	bool ignoreEmpty = ((options & TOK_IGNORE_EMPTY) != 0);
-	bool lastToken = false;
-
-	for (; it != end; ++it)
+	StringRefTokenizer tok(str, separators, options);
+	for (StringRefTokenizer::Iterator it = tok.begin(); it != tok.end(); ++it)
 	{
-		if (separators.find(*it) != std::string::npos) 
-		{
-			if (doTrim) trim(token);
-			if (!token.empty() || !ignoreEmpty) _tokens.push_back(token);
-			if (!ignoreEmpty) lastToken = true;
-			token.clear();
-		}
-		else
-		{
-			token += *it;
-			lastToken = false;
-		}
-	}
-
-	if (!token.empty())
-	{
-		if (doTrim) trim(token);
-		if (!token.empty() || !ignoreEmpty) _tokens.push_back(token);
-	}
-	else if (lastToken) 
-	{
-		_tokens.push_back(std::string());
+		_tokens.push_back(it->toString());
 	}
 }
 
@@ -15,6 +15,12 @@
 #include "Poco/TextConverter.h"
 #include "Poco/TextIterator.h"
 #include "Poco/TextEncoding.h"
+#include "Poco/Latin1Encoding.h"
+#include "Poco/UTF8Encoding.h"
+#include "Poco/UTF16Encoding.h"
+#include "Poco/UTF32Encoding.h"
+#include "Poco/UnicodeConverter.h"
+#include <cstring>
 
 
 namespace {
@@ -22,6 +28,92 @@ namespace {
 	{
 		return ch;
 	}
+
+
+	enum Family
+	{
+		FAMILY_OTHER,
+		FAMILY_LATIN1,
+		FAMILY_UTF8,
+		FAMILY_UTF16,
+		FAMILY_UTF32
+	};
+
+
+	int familyOf(const Poco::TextEncoding& encoding)
+	{
+		if (dynamic_cast<const Poco::UTF8Encoding*>(&encoding))
+			return FAMILY_UTF8;
+		else if (dynamic_cast<const Poco::Latin1Encoding*>(&encoding))
+			return FAMILY_LATIN1;
+		else if (dynamic_cast<const Poco::UTF16Encoding*>(&encoding))
+			return FAMILY_UTF16;
+		else if (dynamic_cast<const Poco::UTF32Encoding*>(&encoding))
+			return FAMILY_UTF32;
+		else
+			return FAMILY_OTHER;
+	}
+
+
+	bool isASCIICompatible(const Poco::TextEncoding& encoding)
+	{
+		const Poco::TextEncoding::CharacterMap& map = encoding.characterMap();
+		for (int i = 0; i < 0x80; ++i)
+		{
+			if (map[i] != i) return false;
+		}
+		return true;
+	}
+
+
+	template <class E>
+	bool isSwapped(const Poco::TextEncoding& encoding)
+	{
+#if defined(POCO_ARCH_BIG_ENDIAN)
+		return static_cast<const E&>(encoding).getByteOrder() != E::BIG_ENDIAN_BYTE_ORDER;
+#else
+		return static_cast<const E&>(encoding).getByteOrder() != E::LITTLE_ENDIAN_BYTE_ORDER;
+#endif
+	}
+
+
+	bool unicodeEncoding(int family, const Poco::TextEncoding& encoding, Poco::UnicodeConverter::Encoding& result)
+		/// The byte order of UTF-16 and UTF-32 encodings can change
+		/// after the TextConverter has been created, so it is
+		/// determined for every conversion.
+	{
+		switch (family)
+		{
+		case FAMILY_LATIN1:
+			result = Poco::UnicodeConverter::ENCODING_LATIN1;
+			return true;
+		case FAMILY_UTF8:
+			result = Poco::UnicodeConverter::ENCODING_UTF8;
+			return true;
+		case FAMILY_UTF16:
+			result = isSwapped<Poco::UTF16Encoding>(encoding) ? Poco::UnicodeConverter::ENCODING_UTF16_SWAPPED : Poco::UnicodeConverter::ENCODING_UTF16;
+			return true;
+		case FAMILY_UTF32:
+			result = isSwapped<Poco::UTF32Encoding>(encoding) ? Poco::UnicodeConverter::ENCODING_UTF32_SWAPPED : Poco::UnicodeConverter::ENCODING_UTF32;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+
+	const unsigned char* skipASCII(const unsigned char* it, const unsigned char* end)
+	{
+		while (end - it >= 8)
+		{
+			Poco::UInt64 word;
+			std::memcpy(&word, it, sizeof(word));
+			if (word & 0x8080808080808080ULL) break;
+			it += 8;
+		}
+		while (it < end && *it < 0x80) ++it;
+		return it;
+	}
 }
 
 
@@ -31,7 +123,10 @@ namespace Poco {
 TextConverter::TextConverter(const TextEncoding& inEncoding, const TextEncoding& outEncoding, int defaultChar):
 	_inEncoding(inEncoding),
 	_outEncoding(outEncoding),
-	_defaultChar(defaultChar)
+	_defaultChar(defaultChar),
+	_inFamily(familyOf(inEncoding)),
+	_outFamily(familyOf(outEncoding)),
+	_asciiCompatible(isASCIICompatible(inEncoding) && isASCIICompatible(outEncoding))
 {
 }
 
@@ -71,9 +166,18 @@ int TextConverter::convert(const void* source, int length, std::string& destinat
 	const unsigned char* it  = (const unsigned char*) source;
 	const unsigned char* end = (const unsigned char*) source + length;
 	unsigned char buffer[TextEncoding::MAX_SEQUENCE_LENGTH];
+	const bool copyASCII = _asciiCompatible && trans == nullTransform;
 	
 	while (it < end)
 	{
+		if (copyASCII && *it < 0x80)
+		{
+			const unsigned char* ascii = it;
+			it = skipASCII(it, end);
+			destination.append((const char*) ascii, it - ascii);
+			continue;
+		}
+
 		int n = _inEncoding.queryConvert(it, 1);
 		int uc;
 		int read = 1;
@@ -115,13 +219,29 @@ int TextConverter::convert(const void* source, int length, std::string& destinat
 
 int TextConverter::convert(const std::string& source, std::string& destination)
 {
-	return convert(source, destination, nullTransform);
+	if ((_inFamily != FAMILY_OTHER && _outFamily != FAMILY_OTHER) || _asciiCompatible)
+		return convert(source.data(), (int) source.size(), destination);
+	else
+		return convert(source, destination, nullTransform);
 }
 
 
 int TextConverter::convert(const void* source, int length, std::string& destination)
 {
-	return convert(source, length, destination, nullTransform);
+	poco_check_ptr (source);
+
+	UnicodeConverter::Encoding inEncoding;
+	UnicodeConverter::Encoding outEncoding;
+	if (unicodeEncoding(_inFamily, _inEncoding, inEncoding) && unicodeEncoding(_outFamily, _outEncoding, outEncoding))
+	{
+		std::string::size_type offset = destination.size();
+		destination.resize(offset + UnicodeConverter::maxTranscodedLength(inEncoding, length, outEncoding, _defaultChar));
+		std::size_t written = 0;
+		int errors = UnicodeConverter::transcode(inEncoding, source, length, outEncoding, &destination[0] + offset, written, _defaultChar);
+		destination.resize(offset + written);
+		return errors;
+	}
+	else return convert(source, length, destination, nullTransform);
 }
 
 
@@ -18,6 +18,8 @@
 #include "Poco/Event.h"
 #include "Poco/ThreadLocal.h"
 #include "Poco/ErrorHandler.h"
+#include "Poco/MetricRegistry.h"
+#include "Poco/Timestamp.h"
 #include <sstream>
 #include <ctime>
 #if defined(_WIN32_WCE) && _WIN32_WCE < 0x800
@@ -28,6 +30,37 @@
 namespace Poco {
 
 
+namespace
+{
+	struct ThreadPoolMetrics
+	{
+		ThreadPoolMetrics():
+			tasks(MetricRegistry::defaultRegistry().counter("poco_threadpool_tasks_total",
+				"Total number of tasks started by thread pools.")),
+			rejectedTasks(MetricRegistry::defaultRegistry().counter("poco_threadpool_tasks_rejected_total",
+				"Total number of tasks rejected by thread pools because no thread was available.")),
+			busyThreads(MetricRegistry::defaultRegistry().gauge("poco_threadpool_threads_busy",
+				"Number of thread pool threads currently running a task.")),
+			taskDuration(MetricRegistry::defaultRegistry().histogram("poco_threadpool_task_duration_seconds",
+				"Time taken to run thread pool tasks.", 1e-6))
+		{
+		}
+
+		MetricCounter&   tasks;
+		MetricCounter&   rejectedTasks;
+		MetricGauge&     busyThreads;
+		MetricHistogram& taskDuration;
+	};
+
+
+	ThreadPoolMetrics& threadPoolMetrics()
+	{
+		static ThreadPoolMetrics metrics;
+		return metrics;
+	}
+}
+
+
 class PooledThread: public Runnable
 {
 public:
@@ -194,6 +227,10 @@ void PooledThread::run()
 		{
 			Runnable* pTarget = _pTarget;
 			_mutex.unlock();
+			ThreadPoolMetrics& metrics = threadPoolMetrics();
+			metrics.tasks.inc();
+			metrics.busyThreads.inc();
+			Timestamp started;
 			try
 			{
 				pTarget->run();
@@ -210,6 +247,8 @@ void PooledThread::run()
 			{
 				ErrorHandler::handle();
 			}
+			metrics.taskDuration.record(started.elapsed());
+			metrics.busyThreads.dec();
 			FastMutex::ScopedLock lock(_mutex);
 			_pTarget  = 0;
 #if defined(_WIN32_WCE) && _WIN32_WCE < 0x800
@@ -467,7 +506,10 @@ PooledThread* ThreadPool::getThread()
 			}
 		}
 		else
+		{
+			threadPoolMetrics().rejectedTasks.inc();
 			throw NoThreadAvailableException();
+		}
 	}
 	pThread->activate();
 	return pThread;
@@ -16,13 +16,23 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/Exception.h"
 #include "Poco/String.h"
-#include "Poco/NumberParser.h"
 #include "Poco/Path.h"
+#include "Poco/URIRef.h"
+#include <algorithm>
 
 
 namespace Poco {
 
 
+namespace
+{
+	StringRef makeRef(std::string::const_iterator begin, std::string::const_iterator end)
+	{
+		return begin == end ? StringRef() : StringRef(&*begin, end - begin);
+	}
+}
+
+
 const std::string URI::RESERVED_PATH        = "?#";
 const std::string URI::RESERVED_QUERY       = "?#/:;+@";
 const std::string URI::RESERVED_QUERY_PARAM = "?#/:;+@&=";
@@ -199,6 +209,7 @@ void URI::clear()
 std::string URI::toString() const
 {
 	std::string uri;
+	uri.reserve(_scheme.size() + _userInfo.size() + _host.size() + _path.size() + _query.size() + _fragment.size() + 16);
 	if (isRelative())
 	{
 		encode(_path, RESERVED_PATH, uri);
@@ -350,38 +361,11 @@ std::string URI::getQuery() const
 URI::QueryParameters URI::getQueryParameters() const
 {
 	QueryParameters result;
-	std::string::const_iterator it(_query.begin());
-	std::string::const_iterator end(_query.end());
-	while (it != end)
+	for (URIRef::QueryIterator it(_query); it != URIRef::QueryIterator(); ++it)
 	{
-		std::string name;
-		std::string value;
-		while (it != end && *it != '=' && *it != '&')
-		{
-			if (*it == '+')
-				name += ' ';
-			else
-				name += *it;
-			++it;
-		}
-		if (it != end && *it == '=')
-		{
-			++it;
-			while (it != end && *it != '&')
-			{
-				if (*it == '+')
-					value += ' ';
-				else
-					value += *it;
-				++it;
-			}
-		}
-		std::string decodedName;
-		std::string decodedValue;
-		URI::decode(name, decodedName);
-		URI::decode(value, decodedValue);
-		result.push_back(std::make_pair(decodedName, decodedValue));
-		if (it != end && *it == '&') ++it;	
+		result.push_back(std::make_pair(std::string(), std::string()));
+		URIRef::decodeQueryComponent(it->name, result.back().first);
+		URIRef::decodeQueryComponent(it->value, result.back().second);
 	}
 	return result;
 }
@@ -623,62 +607,13 @@ void URI::getPathSegments(const std::string& path, std::vector<std::string>& seg
 
 void URI::encode(const std::string& str, const std::string& reserved, std::string& encodedStr)
 {
-	for (std::string::const_iterator it = str.begin(); it != str.end(); ++it)
-	{
-		char c = *it;
-		if ((c >= 'a' && c <= 'z') ||
-		    (c >= 'A' && c <= 'Z') ||
-		    (c >= '0' && c <= '9') ||
-		    c == '-' || c == '_' ||
-		    c == '.' || c == '~')
-		{
-			encodedStr += c;
-		}
-		else if (c <= 0x20 || c >= 0x7F || ILLEGAL.find(c) != std::string::npos || reserved.find(c) != std::string::npos)
-		{
-			encodedStr += '%';
-			encodedStr += NumberFormatter::formatHex((unsigned) (unsigned char) c, 2);
-		}
-		else encodedStr += c;
-	}
+	URIRef::encode(str, reserved, encodedStr);
 }
 
 	
 void URI::decode(const std::string& str, std::string& decodedStr, bool plusAsSpace)
 {
-	bool inQuery = false;
-	std::string::const_iterator it  = str.begin();
-	std::string::const_iterator end = str.end();
-	while (it != end)
-	{
-		char c = *it++;
-		if (c == '?') inQuery = true;
-		// spaces may be encoded as plus signs in the query
-		if (inQuery && plusAsSpace && c == '+') c = ' ';
-		else if (c == '%')
-		{
-			if (it == end) throw URISyntaxException("URI encoding: no hex digit following percent sign", str);
-			char hi = *it++;
-			if (it == end) throw URISyntaxException("URI encoding: two hex digits must follow percent sign", str);
-			char lo = *it++;
-			if (hi >= '0' && hi <= '9')
-				c = hi - '0';
-			else if (hi >= 'A' && hi <= 'F')
-				c = hi - 'A' + 10;
-			else if (hi >= 'a' && hi <= 'f')
-				c = hi - 'a' + 10;
-			else throw URISyntaxException("URI encoding: not a hex digit");
-			c *= 16;
-			if (lo >= '0' && lo <= '9')
-				c += lo - '0';
-			else if (lo >= 'A' && lo <= 'F')
-				c += lo - 'A' + 10;
-			else if (lo >= 'a' && lo <= 'f')
-				c += lo - 'a' + 10;
-			else throw URISyntaxException("URI encoding: not a hex digit");
-		}
-		decodedStr += c;
-	}
+	URIRef::decode(str, decodedStr, plusAsSpace);
 }
 
 
@@ -690,137 +625,66 @@ bool URI::isWellKnownPort() const
 
 unsigned short URI::getWellKnownPort() const
 {
-	if (_scheme == "ftp")
-		return 21;
-	else if (_scheme == "ssh")
-		return 22;
-	else if (_scheme == "telnet")
-		return 23;
-	else if (_scheme == "http" || _scheme == "ws")
-		return 80;
-	else if (_scheme == "nntp")
-		return 119;
-	else if (_scheme == "ldap")
-		return 389;
-	else if (_scheme == "https" || _scheme == "wss")
-		return 443;
-	else if (_scheme == "rtsp")
-		return 554;
-	else if (_scheme == "sip")
-		return 5060;
-	else if (_scheme == "sips")
-		return 5061;
-	else if (_scheme == "xmpp")
-		return 5222;
-	else
-		return 0;
+	return URIRef::getWellKnownPort(_scheme);
 }
 
 
 void URI::parse(const std::string& uri)
 {
-	std::for_each(uri.begin(), uri.end(), [] (char ch) {
-		if (static_cast<signed char>(ch) <= 32 || ch == '\x7F')
-			throw URISyntaxException("URI contains invalid characters");
-	});
-
-	std::string::const_iterator it  = uri.begin();
-	std::string::const_iterator end = uri.end();
-	if (it == end) return;
-	if (*it != '/' && *it != '.' && *it != '?' && *it != '#')
+	URIRef ref(uri);
+	if (!ref.isRelative())
+		setScheme(ref._scheme.toString());
+	ref._userInfo.assignTo(_userInfo);
+	if (ref._hasHostAndPort)
 	{
-		std::string scheme;
-		while (it != end && *it != ':' && *it != '?' && *it != '#' && *it != '/') scheme += *it++;
-		if (it != end && *it == ':')
-		{
-			++it;
-			if (it == end) throw URISyntaxException("URI scheme must be followed by authority or path", uri);
-			setScheme(scheme);
-			if (*it == '/')
-			{
-				++it;
-				if (it != end && *it == '/')
-				{
-					++it;
-					parseAuthority(it, end);
-				}
-				else --it;
-			}
-			parsePathEtc(it, end);
-		}
-		else
-		{
-			it = uri.begin();
-			parsePathEtc(it, end);
-		}
+		ref._host.assignTo(_host);
+		toLowerInPlace(_host);
+		_port = ref._port ? ref._port : getWellKnownPort();
 	}
-	else parsePathEtc(it, end);
+	URIRef::decode(ref._path, _path);
+	if (!ref._query.empty())
+		ref._query.assignTo(_query);
+	URIRef::decode(ref._fragment, _fragment);
 }
 
 
 void URI::parseAuthority(std::string::const_iterator& it, const std::string::const_iterator& end)
 {
-	std::string userInfo;
-	std::string part;
-	while (it != end && *it != '/' && *it != '?' && *it != '#')
+	std::string::const_iterator authEnd = it;
+	while (authEnd != end && *authEnd != '/' && *authEnd != '?' && *authEnd != '#') ++authEnd;
+	URIRef ref;
+	ref.parseAuthority(makeRef(it, authEnd));
+	it = authEnd;
+	if (ref._hasHostAndPort)
 	{
-		if (*it == '@')
-		{
-			userInfo = part;
-			part.clear();
-		}
-		else part += *it;
-		++it;
+		ref._host.assignTo(_host);
+		toLowerInPlace(_host);
+		_port = ref._port ? ref._port : getWellKnownPort();
 	}
-	std::string::const_iterator pbeg = part.begin();
-	std::string::const_iterator pend = part.end();
-	parseHostAndPort(pbeg, pend);
-	_userInfo = userInfo;
+	ref._userInfo.assignTo(_userInfo);
 }
 
 
 void URI::parseHostAndPort(std::string::const_iterator& it, const std::string::const_iterator& end)
 {
-	if (it == end) return;
-	std::string host;
-	if (*it == '[')
-	{
-		// IPv6 address
-		++it;
-		while (it != end && *it != ']') host += *it++;
-		if (it == end) throw URISyntaxException("unterminated IPv6 address");
-		++it;
-	}
-	else
+	URIRef ref;
+	ref.parseHostAndPort(makeRef(it, end));
+	it = end;
+	if (ref._hasHostAndPort)
 	{
-		while (it != end && *it != ':') host += *it++;
-	}
-	if (it != end && *it == ':')
-	{
-		++it;
-		std::string port;
-		while (it != end) port += *it++;
-		if (!port.empty())
-		{
-			int nport = 0;
-			if (NumberParser::tryParse(port, nport) && nport > 0 && nport < 65536)
-				_port = (unsigned short) nport;
-			else
-				throw URISyntaxException("bad or invalid port number", port);
-		}
-		else _port = getWellKnownPort();
+		ref._host.assignTo(_host);
+		toLowerInPlace(_host);
+		_port = ref._port ? ref._port : getWellKnownPort();
 	}
-	else _port = getWellKnownPort();
-	_host = host;
-	toLowerInPlace(_host);
 }
 
 
 void URI::parsePath(std::string::const_iterator& it, const std::string::const_iterator& end)
 {
-	std::string path;
-	while (it != end && *it != '?' && *it != '#') path += *it++;
-	decode(path, _path);
+	std::string::const_iterator pathEnd = it;
+	while (pathEnd != end && *pathEnd != '?' && *pathEnd != '#') ++pathEnd;
+	URIRef::decode(makeRef(it, pathEnd), _path);
+	it = pathEnd;
 }
 
 
@@ -844,16 +708,16 @@ void URI::parsePathEtc(std::string::const_iterator& it, const std::string::const
 
 void URI::parseQuery(std::string::const_iterator& it, const std::string::const_iterator& end)
 {
-	_query.clear();
-	while (it != end && *it != '#') _query += *it++;
+	std::string::const_iterator queryEnd = std::find(it, end, '#');
+	_query.assign(it, queryEnd);
+	it = queryEnd;
 }
 
 
 void URI::parseFragment(std::string::const_iterator& it, const std::string::const_iterator& end)
 {
-	std::string fragment;
-	while (it != end) fragment += *it++;
-	decode(fragment, _fragment);
+	URIRef::decode(makeRef(it, end), _fragment);
+	it = end;
 }
 
 
@@ -0,0 +1,429 @@
+//
+// URIRef.cpp
+//
+// Library: Foundation
+// Package: URI
+// Module:  URIRef
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/URIRef.h"
+#include "Poco/Exception.h"
+#include "Poco/NumberParser.h"
+#include <cstring>
+
+
+namespace Poco {
+
+
+namespace
+{
+	const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+
+	class EncodingTable
+		/// Marks the characters that URIRef::encode() always escapes:
+		/// control characters, space, non-ASCII characters and
+		/// the characters in URI::ILLEGAL.
+	{
+	public:
+		EncodingTable()
+		{
+			for (int c = 0; c < 256; ++c)
+			{
+				_escape[c] = c <= 0x20 || c >= 0x7F;
+				_unreserved[c] = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_' || c == '.' || c == '~';
+			}
+			for (const char* p = "%<>{}|\\\"^`!*'()$,[]"; *p; ++p)
+			{
+				_escape[static_cast<unsigned char>(*p)] = true;
+			}
+		}
+
+		const bool* escape() const
+		{
+			return _escape;
+		}
+
+		bool unreserved(unsigned char c) const
+		{
+			return _unreserved[c];
+		}
+
+	private:
+		bool _escape[256];
+		bool _unreserved[256];
+	};
+
+
+	const EncodingTable encodingTable;
+
+
+	inline int hexValue(char c)
+	{
+		if (c >= '0' && c <= '9')
+			return c - '0';
+		else if (c >= 'A' && c <= 'F')
+			return c - 'A' + 10;
+		else if (c >= 'a' && c <= 'f')
+			return c - 'a' + 10;
+		else
+			return -1;
+	}
+
+
+	void decodeRange(const StringRef& str, std::string& decodedStr, bool plusAsSpace, bool inQuery)
+	{
+		// Plain characters are copied in runs; StringRef::findFirstOf()
+		// looks for the next special character 16 bytes at a time.
+		StringRef specials = plusAsSpace ? (inQuery ? "%+" : "%+?") : "%";
+		decodedStr.reserve(decodedStr.size() + str.size());
+		std::size_t pos = 0;
+		while (pos < str.size())
+		{
+			std::size_t next = str.findFirstOf(specials, pos);
+			if (next == StringRef::npos)
+			{
+				decodedStr.append(str.data() + pos, str.size() - pos);
+				break;
+			}
+			decodedStr.append(str.data() + pos, next - pos);
+			pos = next + 1;
+			char c = str[next];
+			if (c == '?')
+			{
+				// spaces may be encoded as plus signs in the query
+				inQuery = true;
+				specials = "%+";
+			}
+			else if (c == '+')
+			{
+				if (inQuery) c = ' ';
+			}
+			else
+			{
+				if (pos == str.size()) throw URISyntaxException("URI encoding: no hex digit following percent sign", str.toString());
+				if (pos + 1 == str.size()) throw URISyntaxException("URI encoding: two hex digits must follow percent sign", str.toString());
+				int hi = hexValue(str[pos]);
+				if (hi < 0) throw URISyntaxException("URI encoding: not a hex digit");
+				int lo = hexValue(str[pos + 1]);
+				if (lo < 0) throw URISyntaxException("URI encoding: not a hex digit");
+				c = static_cast<char>(hi*16 + lo);
+				pos += 2;
+			}
+			decodedStr += c;
+		}
+	}
+}
+
+
+//
+// URIRef::QueryIterator
+//
+
+
+URIRef::QueryIterator::QueryIterator():
+	_end(true)
+{
+}
+
+
+URIRef::QueryIterator::QueryIterator(const StringRef& query):
+	_rest(query),
+	_end(false)
+{
+	next();
+}
+
+
+void URIRef::QueryIterator::next()
+{
+	if (_rest.empty())
+	{
+		_end = true;
+		return;
+	}
+	std::size_t amp = _rest.find('&');
+	StringRef param = _rest.substr(0, amp);
+	_rest = amp == StringRef::npos ? StringRef(_rest.end(), _rest.end()) : _rest.substr(amp + 1);
+
+	std::size_t eq = param.find('=');
+	_param.name  = param.substr(0, eq);
+	_param.value = eq == StringRef::npos ? StringRef(param.end(), param.end()) : param.substr(eq + 1);
+}
+
+
+//
+// URIRef
+//
+
+
+URIRef::URIRef():
+	_port(0),
+	_hasHostAndPort(false)
+{
+}
+
+
+URIRef::URIRef(const StringRef& uri):
+	_port(0),
+	_hasHostAndPort(false)
+{
+	parse(uri);
+}
+
+
+URIRef::~URIRef()
+{
+}
+
+
+void URIRef::clear()
+{
+	_uri = StringRef();
+	_scheme = StringRef();
+	_authority = StringRef();
+	_userInfo = StringRef();
+	_host = StringRef();
+	_port = 0;
+	_hasHostAndPort = false;
+	_path = StringRef();
+	_query = StringRef();
+	_fragment = StringRef();
+}
+
+
+void URIRef::parse(const StringRef& uri)
+{
+	clear();
+	for (StringRef::Iterator it = uri.begin(); it != uri.end(); ++it)
+	{
+		if (static_cast<signed char>(*it) <= 32 || *it == '\x7F')
+			throw URISyntaxException("URI contains invalid characters");
+	}
+	_uri = uri;
+
+	const char* it  = uri.begin();
+	const char* end = uri.end();
+	if (it == end) return;
+	if (*it != '/' && *it != '.' && *it != '?' && *it != '#')
+	{
+		const char* schemeEnd = it;
+		while (schemeEnd != end && *schemeEnd != ':' && *schemeEnd != '?' && *schemeEnd != '#' && *schemeEnd != '/') ++schemeEnd;
+		if (schemeEnd != end && *schemeEnd == ':')
+		{
+			_scheme = StringRef(it, schemeEnd);
+			it = schemeEnd + 1;
+			if (it == end) throw URISyntaxException("URI scheme must be followed by authority or path", uri.toString());
+			if (end - it >= 2 && it[0] == '/' && it[1] == '/')
+			{
+				it += 2;
+				const char* authEnd = it;
+				while (authEnd != end && *authEnd != '/' && *authEnd != '?' && *authEnd != '#') ++authEnd;
+				parseAuthority(StringRef(it, authEnd));
+				it = authEnd;
+			}
+		}
+	}
+	parsePathEtc(StringRef(it, end));
+}
+
+
+void URIRef::parseAuthority(const StringRef& authority)
+{
+	_authority = authority;
+	std::size_t at = authority.rfind('@');
+	if (at != StringRef::npos)
+	{
+		// If there are several at signs, the user-info is
+		// the part between the last two.
+		std::size_t prev = at > 0 ? authority.rfind('@', at - 1) : StringRef::npos;
+		std::size_t begin = prev == StringRef::npos ? 0 : prev + 1;
+		_userInfo = authority.substr(begin, at - begin);
+		parseHostAndPort(authority.substr(at + 1));
+	}
+	else
+	{
+		_userInfo = authority.substr(0, 0);
+		parseHostAndPort(authority);
+	}
+}
+
+
+void URIRef::parseHostAndPort(const StringRef& hostAndPort)
+{
+	_hasHostAndPort = !hostAndPort.empty();
+	if (!_hasHostAndPort) return;
+
+	StringRef rest;
+	if (hostAndPort[0] == '[')
+	{
+		// IPv6 address
+		std::size_t close = hostAndPort.find(']', 1);
+		if (close == StringRef::npos) throw URISyntaxException("unterminated IPv6 address");
+		_host = hostAndPort.substr(1, close - 1);
+		rest = hostAndPort.substr(close + 1);
+	}
+	else
+	{
+		std::size_t colon = hostAndPort.find(':');
+		_host = hostAndPort.substr(0, colon);
+		rest = hostAndPort.substr(_host.size());
+	}
+	if (!rest.empty() && rest[0] == ':')
+	{
+		StringRef port = rest.substr(1);
+		if (!port.empty())
+		{
+			int nport = 0;
+			if (NumberParser::tryParse(port.toString(), nport) && nport > 0 && nport < 65536)
+				_port = static_cast<unsigned short>(nport);
+			else
+				throw URISyntaxException("bad or invalid port number", port.toString());
+		}
+	}
+}
+
+
+void URIRef::parsePathEtc(const StringRef& pathEtc)
+{
+	std::size_t pos = pathEtc.findFirstOf("?#");
+	_path = pathEtc.substr(0, pos);
+	if (pos != StringRef::npos && pathEtc[pos] == '?')
+	{
+		std::size_t hash = pathEtc.find('#', pos + 1);
+		_query = pathEtc.substr(pos + 1, hash == StringRef::npos ? StringRef::npos : hash - pos - 1);
+		pos = hash;
+	}
+	if (pos != StringRef::npos)
+	{
+		_fragment = pathEtc.substr(pos + 1);
+	}
+}
+
+
+std::string URIRef::getPath() const
+{
+	std::string path;
+	decode(_path, path);
+	return path;
+}
+
+
+std::string URIRef::getFragment() const
+{
+	std::string fragment;
+	decode(_fragment, fragment);
+	return fragment;
+}
+
+
+StringRef URIRef::getPathEtc() const
+{
+	if (_uri.empty()) return StringRef();
+	return StringRef(_path.data(), _uri.end());
+}
+
+
+bool URIRef::findQueryParameter(const StringRef& name, std::string& value) const
+{
+	std::string decodedName;
+	for (QueryIterator it = queryBegin(); it != queryEnd(); ++it)
+	{
+		bool match;
+		if (it->name.findFirstOf("%+") == StringRef::npos)
+		{
+			match = it->name == name;
+		}
+		else
+		{
+			decodedName.clear();
+			decodeQueryComponent(it->name, decodedName);
+			match = StringRef(decodedName) == name;
+		}
+		if (match)
+		{
+			value.clear();
+			decodeQueryComponent(it->value, value);
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void URIRef::encode(const StringRef& str, const StringRef& reserved, std::string& encodedStr)
+{
+	bool escape[256];
+	std::memcpy(escape, encodingTable.escape(), sizeof(escape));
+	for (StringRef::Iterator it = reserved.begin(); it != reserved.end(); ++it)
+	{
+		unsigned char c = static_cast<unsigned char>(*it);
+		if (!encodingTable.unreserved(c)) escape[c] = true;
+	}
+
+	encodedStr.reserve(encodedStr.size() + str.size());
+	const char* it  = str.begin();
+	const char* end = str.end();
+	while (it != end)
+	{
+		const char* run = it;
+		while (it != end && !escape[static_cast<unsigned char>(*it)]) ++it;
+		encodedStr.append(run, it - run);
+		if (it == end) break;
+		unsigned char c = static_cast<unsigned char>(*it++);
+		char hex[3] = {'%', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0x0F]};
+		encodedStr.append(hex, sizeof(hex));
+	}
+}
+
+
+void URIRef::decode(const StringRef& str, std::string& decodedStr, bool plusAsSpace)
+{
+	decodeRange(str, decodedStr, plusAsSpace, false);
+}
+
+
+void URIRef::decodeQueryComponent(const StringRef& str, std::string& decodedStr)
+{
+	decodeRange(str, decodedStr, true, true);
+}
+
+
+unsigned short URIRef::getWellKnownPort(const StringRef& scheme)
+{
+	if (scheme.empty())
+		return 0;
+	else if (scheme.icompare("ftp") == 0)
+		return 21;
+	else if (scheme.icompare("ssh") == 0)
+		return 22;
+	else if (scheme.icompare("telnet") == 0)
+		return 23;
+	else if (scheme.icompare("http") == 0 || scheme.icompare("ws") == 0)
+		return 80;
+	else if (scheme.icompare("nntp") == 0)
+		return 119;
+	else if (scheme.icompare("ldap") == 0)
+		return 389;
+	else if (scheme.icompare("https") == 0 || scheme.icompare("wss") == 0)
+		return 443;
+	else if (scheme.icompare("rtsp") == 0)
+		return 554;
+	else if (scheme.icompare("sip") == 0)
+		return 5060;
+	else if (scheme.icompare("sips") == 0)
+		return 5061;
+	else if (scheme.icompare("xmpp") == 0)
+		return 5222;
+	else
+		return 0;
+}
+
+
+} // namespace Poco
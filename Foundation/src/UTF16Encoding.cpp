@@ -124,7 +124,7 @@ int UTF16Encoding::convert(const unsigned char* bytes) const
 
 	if (_flipBytes)
 	{
-		ByteOrder::flipBytes(uc);
+		uc = ByteOrder::flipBytes(uc);
 	}
 
 	if (uc >= 0xd800 && uc < 0xdc00)
@@ -136,7 +136,7 @@ int UTF16Encoding::convert(const unsigned char* bytes) const
 
 		if (_flipBytes)
 		{
-			ByteOrder::flipBytes(uc2);
+			uc2 = ByteOrder::flipBytes(uc2);
 		}
 		if (uc2 >= 0xdc00 && uc2 < 0xe000)
 		{
@@ -202,7 +202,7 @@ int UTF16Encoding::queryConvert(const unsigned char* bytes, int length) const
 		*p++ = *bytes++;
 		*p++ = *bytes++;
 		if (_flipBytes) 
-			ByteOrder::flipBytes(uc);
+			uc = ByteOrder::flipBytes(uc);
 		if (uc >= 0xd800 && uc < 0xdc00)
 		{
 			if (length >= 4)
@@ -212,8 +212,8 @@ int UTF16Encoding::queryConvert(const unsigned char* bytes, int length) const
 				*p++ = *bytes++;
 				*p++ = *bytes++;
 				if (_flipBytes) 
-					ByteOrder::flipBytes(uc2);
-				if (uc2 >= 0xdc00 && uc < 0xe000)
+					uc2 = ByteOrder::flipBytes(uc2);
+				if (uc2 >= 0xdc00 && uc2 < 0xe000)
 				{
 					ret = ((uc & 0x3ff) << 10) + (uc2 & 0x3ff) + 0x10000;
 				}
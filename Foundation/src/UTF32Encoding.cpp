@@ -126,7 +126,7 @@ int UTF32Encoding::convert(const unsigned char* bytes) const
 
 	if (_flipBytes)
 	{
-		ByteOrder::flipBytes(uc);
+		uc = ByteOrder::flipBytes(uc);
 	}
 
 	return uc;
@@ -161,8 +161,9 @@ int UTF32Encoding::queryConvert(const unsigned char* bytes, int length) const
 		*p++ = *bytes++;
 		*p++ = *bytes++;
 		if (_flipBytes) 
-			ByteOrder::flipBytes(uc);
-		return uc;
+			uc = ByteOrder::flipBytes(uc);
+		// values that do not fit into an int are malformed
+		return uc <= 0x7FFFFFFF ? static_cast<int>(uc) : -1;
 	}
 
 	return ret;
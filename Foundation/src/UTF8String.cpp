@@ -19,7 +19,12 @@
 #include "Poco/UTF8Encoding.h"
 #include "Poco/NumberFormatter.h"
 #include "Poco/Ascii.h"
+#include "Poco/CPUFeatures.h"
 #include <algorithm>
+#include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS)
+#include <immintrin.h>
+#endif
 
 
 namespace Poco {
@@ -28,6 +33,225 @@ namespace Poco {
 namespace
 {
 	static UTF8Encoding utf8;
+
+
+	bool isValidScalar(const unsigned char* p, const unsigned char* end)
+	{
+		while (p < end)
+		{
+			if (end - p >= 8)
+			{
+				UInt64 word;
+				std::memcpy(&word, p, 8);
+				if ((word & 0x8080808080808080ULL) == 0)
+				{
+					p += 8;
+					continue;
+				}
+			}
+			if (*p < 0x80)
+			{
+				++p;
+				continue;
+			}
+			int n = *p >= 0xF0 ? 4 : (*p >= 0xE0 ? 3 : (*p >= 0xC0 ? 2 : 1));
+			if (end - p < n || !UTF8Encoding::isLegal(p, n)) return false;
+			p += n;
+		}
+		return true;
+	}
+
+
+#if defined(POCO_HAVE_X86_INTRINSICS)
+
+
+	//
+	// The SIMD validator follows J. Keiser and D. Lemire,
+	// "Validating UTF-8 In Less Than One Instruction Per Byte",
+	// Software: Practice and Experience 51(5), 2021.
+	//
+	// Every byte is classified by three 16-entry tables, indexed by
+	// the high and low nibble of the preceding byte and the high nibble
+	// of the byte itself. Each table entry is a set of the errors
+	// possible for that nibble; a byte pair is invalid if an error
+	// is in all three sets.
+	//
+
+	enum
+	{
+		TOO_SHORT      = 1 << 0, // lead byte or ASCII followed by lead byte
+		TOO_LONG       = 1 << 1, // ASCII followed by continuation
+		OVERLONG_3     = 1 << 2, // E0 80..9F
+		TOO_LARGE      = 1 << 3, // F4 90..BF, F5..FF 90..BF
+		SURROGATE      = 1 << 4, // ED A0..BF
+		OVERLONG_2     = 1 << 5, // C0..C1
+		TOO_LARGE_1000 = 1 << 6, // F5..FF 80..8F
+		OVERLONG_4     = 1 << 6, // F0 80..8F
+		TWO_CONTS      = 1 << 7, // continuation followed by continuation
+		CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS
+	};
+
+
+	const unsigned char BYTE_1_HIGH[16] =
+	{
+		TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+		TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+		TOO_SHORT | OVERLONG_2,
+		TOO_SHORT,
+		TOO_SHORT | OVERLONG_3 | SURROGATE,
+		TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+	};
+
+
+	const unsigned char BYTE_1_LOW[16] =
+	{
+		CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+		CARRY | OVERLONG_2,
+		CARRY,
+		CARRY,
+		CARRY | TOO_LARGE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+		CARRY | TOO_LARGE | TOO_LARGE_1000,
+		CARRY | TOO_LARGE | TOO_LARGE_1000
+	};
+
+
+	const unsigned char BYTE_2_HIGH[16] =
+	{
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+		TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+	};
+
+
+	POCO_TARGET("ssse3")
+	inline __m128i checkBlock(__m128i input, __m128i previous, __m128i byte1High, __m128i byte1Low, __m128i byte2High)
+	{
+		const __m128i nibble = _mm_set1_epi8(0x0F);
+		const __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+		__m128i special = _mm_shuffle_epi8(byte1High, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+		special = _mm_and_si128(special, _mm_shuffle_epi8(byte1Low, _mm_and_si128(prev1, nibble)));
+		special = _mm_and_si128(special, _mm_shuffle_epi8(byte2High, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+
+		// the third and fourth byte of a sequence must be continuations
+		const __m128i third = _mm_subs_epu8(_mm_alignr_epi8(input, previous, 14), _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+		const __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(input, previous, 13), _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+		const __m128i must23 = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+		return _mm_xor_si128(must23, special);
+	}
+
+
+	POCO_TARGET("ssse3")
+	bool isValidSSSE3(const unsigned char* p, std::size_t length)
+	{
+		const __m128i byte1High = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_1_HIGH));
+		const __m128i byte1Low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_1_LOW));
+		const __m128i byte2High = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_2_HIGH));
+		// a sequence is incomplete if one of the last three bytes
+		// starts a sequence longer than the remaining bytes
+		const __m128i incompleteMax = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+
+		__m128i error = _mm_setzero_si128();
+		__m128i previous = _mm_setzero_si128();
+		__m128i incomplete = _mm_setzero_si128();
+		unsigned char tail[16] = {0};
+		for (std::size_t i = 0; i < length; i += 16)
+		{
+			__m128i input;
+			if (length - i >= 16)
+			{
+				input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			}
+			else
+			{
+				std::memcpy(tail, p + i, length - i);
+				input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail));
+			}
+			if (_mm_movemask_epi8(input) == 0)
+			{
+				error = _mm_or_si128(error, incomplete);
+				incomplete = _mm_setzero_si128();
+			}
+			else
+			{
+				error = _mm_or_si128(error, checkBlock(input, previous, byte1High, byte1Low, byte2High));
+				incomplete = _mm_subs_epu8(input, incompleteMax);
+			}
+			previous = input;
+		}
+		error = _mm_or_si128(error, incomplete);
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+	}
+
+
+	POCO_TARGET("avx2")
+	bool isValidAVX2(const unsigned char* p, std::size_t length)
+	{
+		const __m256i byte1High = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_1_HIGH)));
+		const __m256i byte1Low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_1_LOW)));
+		const __m256i byte2High = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_2_HIGH)));
+		const __m256i incompleteMax = _mm256_setr_epi8(
+			-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+		const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+		__m256i error = _mm256_setzero_si256();
+		__m256i previous = _mm256_setzero_si256();
+		__m256i incomplete = _mm256_setzero_si256();
+		unsigned char tail[32] = {0};
+		for (std::size_t i = 0; i < length; i += 32)
+		{
+			__m256i input;
+			if (length - i >= 32)
+			{
+				input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+			}
+			else
+			{
+				std::memcpy(tail, p + i, length - i);
+				input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail));
+			}
+			if (_mm256_movemask_epi8(input) == 0)
+			{
+				error = _mm256_or_si256(error, incomplete);
+				incomplete = _mm256_setzero_si256();
+			}
+			else
+			{
+				// the last 16 bytes of previous followed by the first 16 bytes of input
+				const __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+				const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+				__m256i special = _mm256_shuffle_epi8(byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+				special = _mm256_and_si256(special, _mm256_shuffle_epi8(byte1Low, _mm256_and_si256(prev1, nibble)));
+				special = _mm256_and_si256(special, _mm256_shuffle_epi8(byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+				const __m256i third = _mm256_subs_epu8(_mm256_alignr_epi8(input, shifted, 14), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+				const __m256i fourth = _mm256_subs_epu8(_mm256_alignr_epi8(input, shifted, 13), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+				const __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+				error = _mm256_or_si256(error, _mm256_xor_si256(must23, special));
+				incomplete = _mm256_subs_epu8(input, incompleteMax);
+			}
+			previous = input;
+		}
+		error = _mm256_or_si256(error, incomplete);
+		return _mm256_movemask_epi8(_mm256_cmpeq_epi8(error, _mm256_setzero_si256())) == -1;
+	}
+
+
+#endif // POCO_HAVE_X86_INTRINSICS
 }
 
 
@@ -374,4 +598,23 @@ std::string UTF8::unescape(const std::string::const_iterator& begin, const std::
 }
 
 
+bool UTF8::isValid(const std::string& str)
+{
+	return isValid(str.data(), str.size());
+}
+
+
+bool UTF8::isValid(const char* text, std::size_t length)
+{
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+#if defined(POCO_HAVE_X86_INTRINSICS)
+	if (CPUFeatures::hasAVX2())
+		return isValidAVX2(p, length);
+	if (CPUFeatures::hasSSSE3())
+		return isValidSSSE3(p, length);
+#endif
+	return isValidScalar(p, p + length);
+}
+
+
 } // namespace Poco
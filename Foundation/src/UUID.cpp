@@ -22,6 +22,48 @@
 namespace Poco {
 
 
+namespace
+{
+	const char HEX_DIGITS[] = "0123456789abcdef";
+
+	// Positions of the 16 pairs of hex digits in a UUID string
+	// with and without hyphens.
+	const int HYPHENATED_OFFSETS[16] = { 0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34 };
+	const int PLAIN_OFFSETS[16]      = { 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30 };
+
+
+	class NibbleTable
+	{
+	public:
+		NibbleTable()
+		{
+			for (int c = 0; c < 256; ++c)
+			{
+				if (c >= 'a' && c <= 'f')
+					_values[c] = static_cast<Int8>(c - 'a' + 10);
+				else if (c >= 'A' && c <= 'F')
+					_values[c] = static_cast<Int8>(c - 'A' + 10);
+				else if (c >= '0' && c <= '9')
+					_values[c] = static_cast<Int8>(c - '0');
+				else
+					_values[c] = -1;
+			}
+		}
+
+		int operator [] (char hex) const
+		{
+			return _values[static_cast<unsigned char>(hex)];
+		}
+
+	private:
+		Int8 _values[256];
+	};
+
+
+	const NibbleTable nibbles;
+}
+
+
 UUID::UUID(): 
 	_timeLow(0), 
 	_timeMid(0),
@@ -139,71 +181,35 @@ bool UUID::tryParse(const std::string& uuid)
 		else
 			return false;
 	}
-	
-	UUID newUUID;
-	std::string::const_iterator it = uuid.begin();
-	newUUID._timeLow = 0;
-	for (int i = 0; i < 8; ++i)
-	{
-		Int16 n = nibble(*it++);
-		if (n < 0) return false;
-		newUUID._timeLow = (newUUID._timeLow << 4) | n;
-	}
-	if (haveHyphens) ++it;
-	newUUID._timeMid = 0;
-	for (int i = 0; i < 4; ++i)
-	{
-		Int16 n = nibble(*it++);
-		if (n < 0) return false;
-		newUUID._timeMid = (newUUID._timeMid << 4) | n;
-	}
-	if (haveHyphens) ++it;
-	newUUID._timeHiAndVersion = 0;
-	for (int i = 0; i < 4; ++i)
-	{
-		Int16 n = nibble(*it++);
-		if (n < 0) return false;
-		newUUID._timeHiAndVersion = (newUUID._timeHiAndVersion << 4) | n;
-	}
-	if (haveHyphens) ++it;
-	newUUID._clockSeq = 0;
-	for (int i = 0; i < 4; ++i)
-	{
-		Int16 n = nibble(*it++);
-		if (n < 0) return false;
-		newUUID._clockSeq = (newUUID._clockSeq << 4) | n;
-	}
-	if (haveHyphens) ++it;
-	for (int i = 0; i < 6; ++i)
-	{
-		Int16 n1 = nibble(*it++);
-		if (n1 < 0) return false;
-		Int16 n2 = nibble(*it++);
-		if (n2 < 0) return false;
 
-		newUUID._node[i] = (n1 << 4) | n2;			
+	const int* offsets = haveHyphens ? HYPHENATED_OFFSETS : PLAIN_OFFSETS;
+	const char* str = uuid.data();
+	char bytes[16];
+	for (int i = 0; i < 16; ++i)
+	{
+		int hi = nibbles[str[offsets[i]]];
+		int lo = nibbles[str[offsets[i] + 1]];
+		if ((hi | lo) < 0) return false;
+		bytes[i] = static_cast<char>((hi << 4) | lo);
 	}
-	swap(newUUID);
-
+	copyFrom(bytes);
 	return true;
 }
 
 
 std::string UUID::toString() const
 {
-	std::string result;
-	result.reserve(36);
-	appendHex(result, _timeLow);
-	result += '-';
-	appendHex(result, _timeMid);
-	result += '-';
-	appendHex(result, _timeHiAndVersion);
-	result += '-';
-	appendHex(result, _clockSeq);
-	result += '-';
-	for (int i = 0; i < sizeof(_node); ++i)
-		appendHex(result, _node[i]);
-	return result;
+	char bytes[16];
+	copyTo(bytes);
+	char result[36];
+	for (int i = 0; i < 16; ++i)
+	{
+		unsigned char b = static_cast<unsigned char>(bytes[i]);
+		result[HYPHENATED_OFFSETS[i]]     = HEX_DIGITS[b >> 4];
+		result[HYPHENATED_OFFSETS[i] + 1] = HEX_DIGITS[b & 0xF];
+	}
+	result[8] = result[13] = result[18] = result[23] = '-';
+	return std::string(result, sizeof(result));
 }
 
 
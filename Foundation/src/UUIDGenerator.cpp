@@ -20,11 +20,151 @@
 #include "Poco/SHA1Engine.h"
 #include "Poco/SingletonHolder.h"
 #include <cstring>
+#if defined(POCO_OS_FAMILY_UNIX)
+#include <pthread.h>
+#endif
+#if POCO_OS == POCO_OS_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
 
 
 namespace Poco {
 
 
+namespace
+{
+	void fillRandom(char* buffer, std::size_t length)
+		/// Fills the buffer with random bytes, using the getrandom()
+		/// system call if available, or a RandomInputStream otherwise.
+	{
+#if POCO_OS == POCO_OS_LINUX && defined(SYS_getrandom)
+		while (length > 0)
+		{
+			long n = syscall(SYS_getrandom, buffer, length, 0);
+			if (n > 0)
+			{
+				buffer += n;
+				length -= n;
+			}
+			else if (n < 0 && errno != EINTR)
+			{
+				break;
+			}
+		}
+		if (length == 0) return;
+#endif
+		RandomInputStream ris;
+		ris.read(buffer, static_cast<std::streamsize>(length));
+	}
+
+
+	int forkGeneration = 0;
+
+#if defined(POCO_OS_FAMILY_UNIX)
+	void onFork()
+	{
+		// The child process must not hand out random bytes
+		// already handed out by the parent.
+		++forkGeneration;
+	}
+
+
+	class ForkHandler
+	{
+	public:
+		ForkHandler()
+		{
+			pthread_atfork(0, 0, onFork);
+		}
+	};
+
+
+	ForkHandler forkHandler;
+#endif
+
+
+	class ThreadState
+		/// The per-thread state of the UUID generator: a pool of random
+		/// bytes that is refilled in batches, and the time stamp and
+		/// counter of the last time-ordered UUID.
+	{
+	public:
+		ThreadState():
+			_pos(POOL_SIZE),
+			_generation(forkGeneration),
+			_lastMillis(0),
+			_counter(0)
+		{
+		}
+
+		~ThreadState()
+		{
+			std::memset(_pool, 0, sizeof(_pool));
+		}
+
+		void random(char* buffer, std::size_t length)
+		{
+			poco_assert_dbg (length <= POOL_SIZE);
+
+			if (POOL_SIZE - _pos < length || _generation != forkGeneration)
+			{
+				fillRandom(_pool, POOL_SIZE);
+				_pos = 0;
+				_generation = forkGeneration;
+			}
+			std::memcpy(buffer, _pool + _pos, length);
+			std::memset(_pool + _pos, 0, length);
+			_pos += length;
+		}
+
+		UInt64 nextMillis(UInt64 millis, const char* random)
+			/// Returns the time stamp for the next time-ordered UUID
+			/// and updates the counter.
+		{
+			if (millis > _lastMillis)
+			{
+				_lastMillis = millis;
+				// Start with a random value, leaving room for
+				// at least 2048 UUIDs in this millisecond.
+				_counter = ((UInt8(random[0]) << 8) | UInt8(random[1])) & 0x07FF;
+			}
+			else if (++_counter > 0x0FFF)
+			{
+				++_lastMillis;
+				_counter = ((UInt8(random[0]) << 8) | UInt8(random[1])) & 0x07FF;
+			}
+			return _lastMillis;
+		}
+
+		UInt16 counter() const
+		{
+			return _counter;
+		}
+
+	private:
+		enum
+		{
+			POOL_SIZE = 4096
+		};
+
+		char        _pool[POOL_SIZE];
+		std::size_t _pos;
+		int         _generation;
+		UInt64      _lastMillis;
+		UInt16      _counter;
+	};
+
+
+	ThreadState& threadState()
+	{
+		static thread_local ThreadState state;
+		return state;
+	}
+}
+
+
 UUIDGenerator::UUIDGenerator(): _ticks(0), _haveNode(false)
 {
 }
@@ -94,12 +234,29 @@ UUID UUIDGenerator::createFromName(const UUID& nsid, const std::string& name, Di
 UUID UUIDGenerator::createRandom()
 {
 	char buffer[16];
-	RandomInputStream ris;
-	ris.read(buffer, sizeof(buffer));
+	threadState().random(buffer, sizeof(buffer));
 	return UUID(buffer, UUID::UUID_RANDOM);
 }
 
 
+UUID UUIDGenerator::createTimeOrdered()
+{
+	ThreadState& state = threadState();
+	char buffer[16];
+	state.random(buffer + 6, 10);
+	UInt64 millis = state.nextMillis(static_cast<UInt64>(Timestamp().epochMicroseconds()/1000), buffer + 6);
+	for (int i = 5; i >= 0; --i)
+	{
+		buffer[i] = static_cast<char>(millis & 0xFF);
+		millis >>= 8;
+	}
+	UInt16 counter = state.counter();
+	buffer[6] = static_cast<char>(counter >> 8);
+	buffer[7] = static_cast<char>(counter & 0xFF);
+	return UUID(buffer, UUID::UUID_TIME_ORDERED);
+}
+
+
 Timestamp::UtcTimeVal UUIDGenerator::timeStamp()
 {
 	Timestamp now;
@@ -13,41 +13,609 @@
 
 
 #include "Poco/UnicodeConverter.h"
-#include "Poco/TextConverter.h"
-#include "Poco/TextIterator.h"
-#include "Poco/UTF8Encoding.h"
-#include "Poco/UTF16Encoding.h"
-#include "Poco/UTF32Encoding.h"
+#include "Poco/UTF8String.h"
+#include "Poco/ByteOrder.h"
+#include "Poco/CPUFeatures.h"
 #include <cstring>
+#if defined(POCO_HAVE_X86_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define POCO_UNICODE_SSE2
+#include <emmintrin.h>
+#endif
 
 
 namespace Poco {
 
 
-void UnicodeConverter::convert(const std::string& utf8String, UTF32String& utf32String)
+namespace
 {
-	utf32String.clear();
-	UTF8Encoding utf8Encoding;
-	TextIterator it(utf8String, utf8Encoding);
-	TextIterator end(utf8String);
+	inline UInt16 load16(const unsigned char* p, bool flip)
+	{
+		UInt16 value;
+		std::memcpy(&value, p, sizeof(value));
+		return flip ? ByteOrder::flipBytes(value) : value;
+	}
+
+
+	inline UInt32 load32(const unsigned char* p, bool flip)
+	{
+		UInt32 value;
+		std::memcpy(&value, p, sizeof(value));
+		return flip ? ByteOrder::flipBytes(value) : value;
+	}
+
+
+	inline void store16(unsigned char*& p, UInt16 value, bool flip)
+	{
+		if (flip) value = ByteOrder::flipBytes(value);
+		std::memcpy(p, &value, sizeof(value));
+		p += sizeof(value);
+	}
+
+
+	inline void store32(unsigned char*& p, UInt32 value, bool flip)
+	{
+		if (flip) value = ByteOrder::flipBytes(value);
+		std::memcpy(p, &value, sizeof(value));
+		p += sizeof(value);
+	}
+
+
+	//
+	// Each codec decodes one character with the same result as
+	// queryConvert() of the corresponding TextEncoding (-1 for an invalid
+	// or truncated sequence), and encodes one character like convert()
+	// (false if the character cannot be represented).
+	//
+
+	struct Latin1Codec
+	{
+		enum { UNIT = 1 };
+
+		static int ascii(const unsigned char* in, const unsigned char* /*end*/, bool /*flip*/)
+		{
+			return *in < 0x80 ? *in : -1;
+		}
+
+		static int decode(const unsigned char*& in, const unsigned char* /*end*/, bool /*flip*/)
+		{
+			return *in++;
+		}
+
+		static bool encode(int ch, unsigned char*& out, bool /*flip*/)
+		{
+			if (ch < 0 || ch > 0xFF) return false;
+			*out++ = static_cast<unsigned char>(ch);
+			return true;
+		}
+
+		static void putASCII(int ch, unsigned char*& out, bool /*flip*/)
+		{
+			*out++ = static_cast<unsigned char>(ch);
+		}
+	};
+
+
+	struct UTF8Codec
+	{
+		enum { UNIT = 1 };
+
+		static int ascii(const unsigned char* in, const unsigned char* /*end*/, bool /*flip*/)
+		{
+			return *in < 0x80 ? *in : -1;
+		}
+
+		static int decode(const unsigned char*& in, const unsigned char* end, bool /*flip*/)
+		{
+			const unsigned char* p = in;
+			int ch = *p;
+			if (ch < 0x80)
+			{
+				in = p + 1;
+				return ch;
+			}
+			if (ch < 0xC0 || ch >= 0xF8)
+			{
+				in = p + 1;
+				return -1;
+			}
+			int n = ch >= 0xF0 ? 4 : (ch >= 0xE0 ? 3 : 2);
+			if (end - p < n)
+			{
+				in = end;
+				return -1;
+			}
+			in = p + n;
+			switch (n)
+			{
+			case 2:
+				if (ch < 0xC2 || (p[1] & 0xC0) != 0x80) return -1;
+				return ((ch & 0x1F) << 6) | (p[1] & 0x3F);
+			case 3:
+				if ((p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80) return -1;
+				if ((ch == 0xE0 && p[1] < 0xA0) || (ch == 0xED && p[1] > 0x9F)) return -1;
+				return ((ch & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+			default:
+				if ((p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80) return -1;
+				if (ch > 0xF4 || (ch == 0xF0 && p[1] < 0x90) || (ch == 0xF4 && p[1] > 0x8F)) return -1;
+				return ((ch & 0x07) << 18) | ((p[1] & 0x3F) << 12) | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+			}
+		}
+
+		static bool encode(int ch, unsigned char*& out, bool /*flip*/)
+		{
+			if (ch <= 0x7F)
+			{
+				*out++ = static_cast<unsigned char>(ch);
+			}
+			else if (ch <= 0x7FF)
+			{
+				*out++ = static_cast<unsigned char>(((ch >> 6) & 0x1F) | 0xC0);
+				*out++ = static_cast<unsigned char>((ch & 0x3F) | 0x80);
+			}
+			else if (ch <= 0xFFFF)
+			{
+				*out++ = static_cast<unsigned char>(((ch >> 12) & 0x0F) | 0xE0);
+				*out++ = static_cast<unsigned char>(((ch >> 6) & 0x3F) | 0x80);
+				*out++ = static_cast<unsigned char>((ch & 0x3F) | 0x80);
+			}
+			else if (ch <= 0x10FFFF)
+			{
+				*out++ = static_cast<unsigned char>(((ch >> 18) & 0x07) | 0xF0);
+				*out++ = static_cast<unsigned char>(((ch >> 12) & 0x3F) | 0x80);
+				*out++ = static_cast<unsigned char>(((ch >> 6) & 0x3F) | 0x80);
+				*out++ = static_cast<unsigned char>((ch & 0x3F) | 0x80);
+			}
+			else return false;
+			return true;
+		}
+
+		static void putASCII(int ch, unsigned char*& out, bool /*flip*/)
+		{
+			*out++ = static_cast<unsigned char>(ch);
+		}
+	};
+
+
+	struct UTF16Codec
+	{
+		enum { UNIT = 2 };
+
+		static int ascii(const unsigned char* in, const unsigned char* end, bool flip)
+		{
+			if (end - in < 2) return -1;
+			int ch = load16(in, flip);
+			return ch < 0x80 ? ch : -1;
+		}
+
+		static int decode(const unsigned char*& in, const unsigned char* end, bool flip)
+		{
+			if (end - in < 2)
+			{
+				in = end;
+				return -1;
+			}
+			int ch = load16(in, flip);
+			if (ch >= 0xD800 && ch < 0xDC00)
+			{
+				if (end - in < 4)
+				{
+					in = end;
+					return -1;
+				}
+				int ch2 = load16(in + 2, flip);
+				in += 4;
+				if (ch2 >= 0xDC00 && ch2 < 0xE000)
+					return ((ch & 0x3FF) << 10) + (ch2 & 0x3FF) + 0x10000;
+				else
+					return -1;
+			}
+			in += 2;
+			return ch;
+		}
+
+		static bool encode(int ch, unsigned char*& out, bool flip)
+		{
+			if (ch <= 0xFFFF)
+			{
+				store16(out, static_cast<UInt16>(ch), flip);
+			}
+			else
+			{
+				ch -= 0x10000;
+				store16(out, static_cast<UInt16>(0xD800 + ((ch >> 10) & 0x3FF)), flip);
+				store16(out, static_cast<UInt16>(0xDC00 + (ch & 0x3FF)), flip);
+			}
+			return true;
+		}
+
+		static void putASCII(int ch, unsigned char*& out, bool flip)
+		{
+			store16(out, static_cast<UInt16>(ch), flip);
+		}
+	};
+
+
+	struct UTF32Codec
+	{
+		enum { UNIT = 4 };
+
+		static int ascii(const unsigned char* in, const unsigned char* end, bool flip)
+		{
+			if (end - in < 4) return -1;
+			UInt32 ch = load32(in, flip);
+			return ch < 0x80 ? static_cast<int>(ch) : -1;
+		}
+
+		static int decode(const unsigned char*& in, const unsigned char* end, bool flip)
+		{
+			if (end - in < 4)
+			{
+				in = end;
+				return -1;
+			}
+			int ch = static_cast<int>(load32(in, flip));
+			in += 4;
+			return ch;
+		}
+
+		static bool encode(int ch, unsigned char*& out, bool flip)
+		{
+			store32(out, static_cast<UInt32>(ch), flip);
+			return true;
+		}
+
+		static void putASCII(int ch, unsigned char*& out, bool flip)
+		{
+			store32(out, static_cast<UInt32>(ch), flip);
+		}
+	};
+
+
+	template <int InUnit, int OutUnit>
+	struct ASCIIBlocks
+		/// Copies blocks of 16 ASCII characters from in to out,
+		/// converting the code unit size, and returns the number of
+		/// characters copied. Stops at the first block containing
+		/// a non-ASCII character.
+	{
+		static std::size_t copy(const unsigned char* /*in*/, std::size_t /*count*/, unsigned char* /*out*/, bool /*flipIn*/, bool /*flipOut*/)
+		{
+			return 0;
+		}
+	};
+
+
+#if defined(POCO_UNICODE_SSE2)
+
+
+	template <>
+	struct ASCIIBlocks<1, 1>
+	{
+		static std::size_t copy(const unsigned char* in, std::size_t count, unsigned char* out, bool /*flipIn*/, bool /*flipOut*/)
+		{
+			std::size_t i = 0;
+			for (; count - i >= 32; i += 32)
+			{
+				const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16));
+				if (_mm_movemask_epi8(_mm_or_si128(v0, v1))) break;
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v0);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 16), v1);
+			}
+			for (; count - i >= 16; i += 16)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				if (_mm_movemask_epi8(v)) break;
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+			}
+			return i;
+		}
+	};
+
+
+	template <>
+	struct ASCIIBlocks<1, 2>
+	{
+		static std::size_t copy(const unsigned char* in, std::size_t count, unsigned char* out, bool /*flipIn*/, bool flipOut)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			std::size_t i = 0;
+			for (; count - i >= 16; i += 16)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				if (_mm_movemask_epi8(v)) break;
+				const __m128i lo = flipOut ? _mm_unpacklo_epi8(zero, v) : _mm_unpacklo_epi8(v, zero);
+				const __m128i hi = flipOut ? _mm_unpackhi_epi8(zero, v) : _mm_unpackhi_epi8(v, zero);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2*i), lo);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2*i + 16), hi);
+			}
+			return i;
+		}
+	};
+
+
+	template <>
+	struct ASCIIBlocks<1, 4>
+	{
+		static std::size_t copy(const unsigned char* in, std::size_t count, unsigned char* out, bool /*flipIn*/, bool flipOut)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			std::size_t i = 0;
+			for (; count - i >= 16; i += 16)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				if (_mm_movemask_epi8(v)) break;
+				__m128i* p = reinterpret_cast<__m128i*>(out + 4*i);
+				if (flipOut)
+				{
+					const __m128i lo = _mm_unpacklo_epi8(zero, v);
+					const __m128i hi = _mm_unpackhi_epi8(zero, v);
+					_mm_storeu_si128(p, _mm_unpacklo_epi16(zero, lo));
+					_mm_storeu_si128(p + 1, _mm_unpackhi_epi16(zero, lo));
+					_mm_storeu_si128(p + 2, _mm_unpacklo_epi16(zero, hi));
+					_mm_storeu_si128(p + 3, _mm_unpackhi_epi16(zero, hi));
+				}
+				else
+				{
+					const __m128i lo = _mm_unpacklo_epi8(v, zero);
+					const __m128i hi = _mm_unpackhi_epi8(v, zero);
+					_mm_storeu_si128(p, _mm_unpacklo_epi16(lo, zero));
+					_mm_storeu_si128(p + 1, _mm_unpackhi_epi16(lo, zero));
+					_mm_storeu_si128(p + 2, _mm_unpacklo_epi16(hi, zero));
+					_mm_storeu_si128(p + 3, _mm_unpackhi_epi16(hi, zero));
+				}
+			}
+			return i;
+		}
+	};
+
+
+	template <>
+	struct ASCIIBlocks<2, 1>
+	{
+		static std::size_t copy(const unsigned char* in, std::size_t count, unsigned char* out, bool flipIn, bool /*flipOut*/)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i mask = _mm_set1_epi16(static_cast<short>(flipIn ? 0x80FF : 0xFF80));
+			std::size_t i = 0;
+			for (; count - i >= 16; i += 16)
+			{
+				const __m128i* p = reinterpret_cast<const __m128i*>(in + 2*i);
+				__m128i v0 = _mm_loadu_si128(p);
+				__m128i v1 = _mm_loadu_si128(p + 1);
+				const __m128i bits = _mm_and_si128(_mm_or_si128(v0, v1), mask);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(bits, zero)) != 0xFFFF) break;
+				if (flipIn)
+				{
+					v0 = _mm_srli_epi16(v0, 8);
+					v1 = _mm_srli_epi16(v1, 8);
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(v0, v1));
+			}
+			return i;
+		}
+	};
+
+
+	template <>
+	struct ASCIIBlocks<4, 1>
+	{
+		static std::size_t copy(const unsigned char* in, std::size_t count, unsigned char* out, bool flipIn, bool /*flipOut*/)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i mask = _mm_set1_epi32(static_cast<int>(flipIn ? 0x80FFFFFFu : 0xFFFFFF80u));
+			std::size_t i = 0;
+			for (; count - i >= 16; i += 16)
+			{
+				const __m128i* p = reinterpret_cast<const __m128i*>(in + 4*i);
+				__m128i v0 = _mm_loadu_si128(p);
+				__m128i v1 = _mm_loadu_si128(p + 1);
+				__m128i v2 = _mm_loadu_si128(p + 2);
+				__m128i v3 = _mm_loadu_si128(p + 3);
+				const __m128i bits = _mm_and_si128(_mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3)), mask);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(bits, zero)) != 0xFFFF) break;
+				if (flipIn)
+				{
+					v0 = _mm_srli_epi32(v0, 24);
+					v1 = _mm_srli_epi32(v1, 24);
+					v2 = _mm_srli_epi32(v2, 24);
+					v3 = _mm_srli_epi32(v3, 24);
+				}
+				const __m128i lo = _mm_packs_epi32(v0, v1);
+				const __m128i hi = _mm_packs_epi32(v2, v3);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+			}
+			return i;
+		}
+	};
+
+
+#endif // POCO_UNICODE_SSE2
+
+
+	template <class In, class Out>
+	inline void copyASCII(const unsigned char*& in, const unsigned char* end, unsigned char*& out, bool flipIn, bool flipOut)
+	{
+		std::size_t n = ASCIIBlocks<In::UNIT, Out::UNIT>::copy(in, (end - in)/In::UNIT, out, flipIn, flipOut);
+		in += n*In::UNIT;
+		out += n*Out::UNIT;
+		int ch;
+		while (in < end && (ch = In::ascii(in, end, flipIn)) >= 0)
+		{
+			Out::putASCII(ch, out, flipOut);
+			in += In::UNIT;
+		}
+	}
+
+
+	template <class In, class Out>
+	int transcodeImpl(const unsigned char* in, const unsigned char* end, unsigned char*& out, bool flipIn, bool flipOut, const unsigned char* replacement, int replacementLength)
+	{
+		int errors = 0;
+		while (in < end)
+		{
+			if (In::ascii(in, end, flipIn) >= 0)
+			{
+				copyASCII<In, Out>(in, end, out, flipIn, flipOut);
+			}
+			else
+			{
+				int ch = In::decode(in, end, flipIn);
+				if (ch < 0)
+					++errors;
+				else if (Out::encode(ch, out, flipOut))
+					continue;
+				std::memcpy(out, replacement, replacementLength);
+				out += replacementLength;
+			}
+		}
+		return errors;
+	}
+
+
+	template <class In>
+	int transcodeFrom(const unsigned char* in, const unsigned char* end, UnicodeConverter::Encoding outEncoding, unsigned char*& out, bool flipIn, bool flipOut, const unsigned char* replacement, int replacementLength)
+	{
+		switch (outEncoding)
+		{
+		case UnicodeConverter::ENCODING_LATIN1:
+			return transcodeImpl<In, Latin1Codec>(in, end, out, flipIn, flipOut, replacement, replacementLength);
+		case UnicodeConverter::ENCODING_UTF8:
+			return transcodeImpl<In, UTF8Codec>(in, end, out, flipIn, flipOut, replacement, replacementLength);
+		case UnicodeConverter::ENCODING_UTF16:
+		case UnicodeConverter::ENCODING_UTF16_SWAPPED:
+			return transcodeImpl<In, UTF16Codec>(in, end, out, flipIn, flipOut, replacement, replacementLength);
+		default:
+			return transcodeImpl<In, UTF32Codec>(in, end, out, flipIn, flipOut, replacement, replacementLength);
+		}
+	}
+
+
+	inline bool isSwapped(UnicodeConverter::Encoding encoding)
+	{
+		return encoding == UnicodeConverter::ENCODING_UTF16_SWAPPED || encoding == UnicodeConverter::ENCODING_UTF32_SWAPPED;
+	}
+
+
+	int encodeReplacement(UnicodeConverter::Encoding encoding, int defaultChar, unsigned char* buffer)
+	{
+		unsigned char* p = buffer;
+		bool ok;
+		switch (encoding)
+		{
+		case UnicodeConverter::ENCODING_LATIN1:
+			ok = Latin1Codec::encode(defaultChar, p, false);
+			break;
+		case UnicodeConverter::ENCODING_UTF8:
+			ok = UTF8Codec::encode(defaultChar, p, false);
+			break;
+		case UnicodeConverter::ENCODING_UTF16:
+		case UnicodeConverter::ENCODING_UTF16_SWAPPED:
+			ok = UTF16Codec::encode(defaultChar, p, isSwapped(encoding));
+			break;
+		default:
+			ok = UTF32Codec::encode(defaultChar, p, isSwapped(encoding));
+			break;
+		}
+		return ok ? static_cast<int>(p - buffer) : 0;
+	}
+
 
-	while (it != end)
+	int family(UnicodeConverter::Encoding encoding)
+		/// Returns 0 for Latin-1, 1 for UTF-8, 2 for UTF-16 and 3 for UTF-32.
 	{
-		int cc = *it++;
-		utf32String += (UTF32Char) cc;
+		switch (encoding)
+		{
+		case UnicodeConverter::ENCODING_LATIN1:
+			return 0;
+		case UnicodeConverter::ENCODING_UTF8:
+			return 1;
+		case UnicodeConverter::ENCODING_UTF16:
+		case UnicodeConverter::ENCODING_UTF16_SWAPPED:
+			return 2;
+		default:
+			return 3;
+		}
 	}
 }
 
 
-void UnicodeConverter::convert(const char* utf8String, std::size_t length, UTF32String& utf32String)
+int UnicodeConverter::transcode(Encoding inEncoding, const void* source, std::size_t length, Encoding outEncoding, void* destination, std::size_t& written, int defaultChar)
 {
-	if (!utf8String || !length)
+	const unsigned char* in = static_cast<const unsigned char*>(source);
+	unsigned char* begin = static_cast<unsigned char*>(destination);
+
+	if ((inEncoding == ENCODING_LATIN1 && outEncoding == ENCODING_LATIN1) ||
+		(inEncoding == ENCODING_UTF8 && outEncoding == ENCODING_UTF8 && UTF8::isValid(static_cast<const char*>(source), length)))
 	{
-		utf32String.clear();
-		return;
+		if (length > 0) std::memcpy(begin, in, length);
+		written = length;
+		return 0;
+	}
+
+	unsigned char replacement[4];
+	int replacementLength = encodeReplacement(outEncoding, defaultChar, replacement);
+	bool flipIn = isSwapped(inEncoding);
+	bool flipOut = isSwapped(outEncoding);
+	unsigned char* out = begin;
+	int errors;
+	switch (family(inEncoding))
+	{
+	case 0:
+		errors = transcodeFrom<Latin1Codec>(in, in + length, outEncoding, out, flipIn, flipOut, replacement, replacementLength);
+		break;
+	case 1:
+		errors = transcodeFrom<UTF8Codec>(in, in + length, outEncoding, out, flipIn, flipOut, replacement, replacementLength);
+		break;
+	case 2:
+		errors = transcodeFrom<UTF16Codec>(in, in + length, outEncoding, out, flipIn, flipOut, replacement, replacementLength);
+		break;
+	default:
+		errors = transcodeFrom<UTF32Codec>(in, in + length, outEncoding, out, flipIn, flipOut, replacement, replacementLength);
+		break;
 	}
+	written = out - begin;
+	return errors;
+}
+
+
+std::size_t UnicodeConverter::maxTranscodedLength(Encoding inEncoding, std::size_t length, Encoding outEncoding, int defaultChar)
+{
+	// maximum number of bytes written for one input code unit
+	static const int MAX_LENGTH[4][4] =
+	{
+		/* Latin-1 */ {1, 2, 2, 4},
+		/* UTF-8   */ {1, 1, 2, 4},
+		/* UTF-16  */ {1, 3, 2, 4},
+		/* UTF-32  */ {1, 4, 4, 4}
+	};
+	static const int UNIT[4] = {1, 1, 2, 4};
+
+	unsigned char replacement[4];
+	int inFamily = family(inEncoding);
+	std::size_t maxLength = MAX_LENGTH[inFamily][family(outEncoding)];
+	std::size_t replacementLength = encodeReplacement(outEncoding, defaultChar, replacement);
+	if (replacementLength > maxLength) maxLength = replacementLength;
+	return (length + UNIT[inFamily] - 1)/UNIT[inFamily]*maxLength;
+}
+
+
+void UnicodeConverter::convert(const std::string& utf8String, UTF32String& utf32String)
+{
+	convert(utf8String.data(), utf8String.size(), utf32String);
+}
+
 
-	convert(std::string(utf8String, utf8String + length), utf32String);
+void UnicodeConverter::convert(const char* utf8String, std::size_t length, UTF32String& utf32String)
+{
+	utf32String.clear();
+	if (!utf8String || !length) return;
+
+	// invalid sequences are converted to (UTF32Char) -1
+	utf32String.resize(maxTranscodedLength(ENCODING_UTF8, length, ENCODING_UTF32, -1)/sizeof(UTF32Char));
+	std::size_t written;
+	transcode(ENCODING_UTF8, utf8String, length, ENCODING_UTF32, &utf32String[0], written, -1);
+	utf32String.resize(written/sizeof(UTF32Char));
 }
 
 
@@ -65,36 +633,20 @@ void UnicodeConverter::convert(const char* utf8String, UTF32String& utf32String)
 
 void UnicodeConverter::convert(const std::string& utf8String, UTF16String& utf16String)
 {
-	utf16String.clear();
-	UTF8Encoding utf8Encoding;
-	TextIterator it(utf8String, utf8Encoding);
-	TextIterator end(utf8String);
-	while (it != end) 
-	{
-		int cc = *it++;
-		if (cc <= 0xffff)
-		{
-			utf16String += (UTF16Char) cc;
-		}
-		else
-		{
-			cc -= 0x10000;
-			utf16String += (UTF16Char) ((cc >> 10) & 0x3ff) | 0xd800;
-			utf16String += (UTF16Char) (cc & 0x3ff) | 0xdc00;
-		}
-	}
+	convert(utf8String.data(), utf8String.size(), utf16String);
 }
 
 
 void UnicodeConverter::convert(const char* utf8String,  std::size_t length, UTF16String& utf16String)
 {
-	if (!utf8String || !length)
-	{
-		utf16String.clear();
-		return;
-	}
+	utf16String.clear();
+	if (!utf8String || !length) return;
 
-	convert(std::string(utf8String, utf8String + length), utf16String);
+	// invalid sequences are converted to (UTF16Char) -1
+	utf16String.resize(maxTranscodedLength(ENCODING_UTF8, length, ENCODING_UTF16, -1)/sizeof(UTF16Char));
+	std::size_t written;
+	transcode(ENCODING_UTF8, utf8String, length, ENCODING_UTF16, &utf16String[0], written, -1);
+	utf16String.resize(written/sizeof(UTF16Char));
 }
 
 
@@ -106,43 +658,47 @@ void UnicodeConverter::convert(const char* utf8String, UTF16String& utf16String)
 		return;
 	}
 
-	convert(std::string(utf8String), utf16String);
+	convert(utf8String, std::strlen(utf8String), utf16String);
 }
 
 
 void UnicodeConverter::convert(const UTF16String& utf16String, std::string& utf8String)
 {
-	utf8String.clear();
-	UTF8Encoding utf8Encoding;
-	UTF16Encoding utf16Encoding;
-	TextConverter converter(utf16Encoding, utf8Encoding);
-	converter.convert(utf16String.data(), (int) utf16String.length() * sizeof(UTF16Char), utf8String);
+	convert(utf16String.data(), utf16String.length(), utf8String);
 }
 
 
 void UnicodeConverter::convert(const UTF32String& utf32String, std::string& utf8String)
 {
-	utf8String.clear();
-	UTF8Encoding utf8Encoding;
-	UTF32Encoding utf32Encoding;
-	TextConverter converter(utf32Encoding, utf8Encoding);
-	converter.convert(utf32String.data(), (int) utf32String.length() * sizeof(UTF32Char), utf8String);
+	convert(utf32String.data(), utf32String.length(), utf8String);
 }
 
 
 void UnicodeConverter::convert(const UTF16Char* utf16String,  std::size_t length, std::string& utf8String)
 {
+	poco_check_ptr (utf16String);
+
 	utf8String.clear();
-	UTF8Encoding utf8Encoding;
-	UTF16Encoding utf16Encoding;
-	TextConverter converter(utf16Encoding, utf8Encoding);
-	converter.convert(utf16String, (int) length * sizeof(UTF16Char), utf8String);
+	if (!length) return;
+
+	utf8String.resize(maxTranscodedLength(ENCODING_UTF16, length*sizeof(UTF16Char), ENCODING_UTF8));
+	std::size_t written;
+	transcode(ENCODING_UTF16, utf16String, length*sizeof(UTF16Char), ENCODING_UTF8, &utf8String[0], written);
+	utf8String.resize(written);
 }
 
 
 void UnicodeConverter::convert(const UTF32Char* utf32String,  std::size_t length, std::string& utf8String)
 {
-	toUTF8(UTF32String(utf32String, length), utf8String);
+	poco_check_ptr (utf32String);
+
+	utf8String.clear();
+	if (!length) return;
+
+	utf8String.resize(maxTranscodedLength(ENCODING_UTF32, length*sizeof(UTF32Char), ENCODING_UTF8));
+	std::size_t written;
+	transcode(ENCODING_UTF32, utf32String, length*sizeof(UTF32Char), ENCODING_UTF8, &utf8String[0], written);
+	utf8String.resize(written);
 }
 
 
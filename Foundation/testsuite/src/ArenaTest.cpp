@@ -0,0 +1,224 @@
+//
+// ArenaTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ArenaTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Arena.h"
+#include "Poco/ArenaAllocator.h"
+#include "Poco/Dynamic/Struct.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstring>
+
+
+using Poco::Arena;
+using Poco::ArenaAllocator;
+using Poco::Dynamic::Struct;
+using Poco::Dynamic::Var;
+
+
+ArenaTest::ArenaTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ArenaTest::~ArenaTest()
+{
+}
+
+
+void ArenaTest::testAllocate()
+{
+	Arena arena(1024);
+	assert (arena.blockSize() == 1024);
+	assert (arena.blocks() == 0);
+	assert (arena.capacity() == 0);
+	assert (arena.allocated() == 0);
+
+	char* p1 = static_cast<char*>(arena.allocate(100));
+	std::memset(p1, 'a', 100);
+	assert (arena.blocks() == 1);
+	assert (arena.capacity() == 1024);
+	assert (arena.allocated() == 100);
+
+	char* p2 = static_cast<char*>(arena.allocate(100));
+	std::memset(p2, 'b', 100);
+	assert (arena.blocks() == 1);
+	assert (arena.allocated() == 200);
+	assert (p2 >= p1 + 100);
+	assert (p1[99] == 'a');
+
+	for (int i = 0; i < 20; ++i) arena.allocate(100);
+	assert (arena.blocks() > 1);
+	assert (arena.allocated() == 2200);
+}
+
+
+void ArenaTest::testInitialBuffer()
+{
+	char buffer[256];
+	Arena arena(buffer, sizeof(buffer), 1024);
+	assert (arena.capacity() == sizeof(buffer));
+
+	char* p1 = static_cast<char*>(arena.allocate(64));
+	assert (p1 >= buffer && p1 < buffer + sizeof(buffer));
+	assert (arena.blocks() == 0);
+
+	char* p2 = static_cast<char*>(arena.allocate(256));
+	assert (p2 < buffer || p2 >= buffer + sizeof(buffer));
+	assert (arena.blocks() == 1);
+	assert (arena.capacity() == sizeof(buffer) + 1024);
+}
+
+
+void ArenaTest::testAlignment()
+{
+	Arena arena(1024);
+	arena.allocate(1, 1);
+	void* p = arena.allocate(8, 8);
+	assert ((reinterpret_cast<std::size_t>(p) & 7) == 0);
+	arena.allocate(3, 1);
+	assert ((Arena::MAX_ALIGNMENT & (Arena::MAX_ALIGNMENT - 1)) == 0);
+	p = arena.allocate(16);
+	assert ((reinterpret_cast<std::size_t>(p) & (Arena::MAX_ALIGNMENT - 1)) == 0);
+	arena.allocate(1, 1);
+	p = arena.allocate(64, 64);
+	assert ((reinterpret_cast<std::size_t>(p) & 63) == 0);
+	p = arena.allocate(2048, 128);
+	assert ((reinterpret_cast<std::size_t>(p) & 127) == 0);
+}
+
+
+void ArenaTest::testLargeAllocation()
+{
+	Arena arena(1024);
+	char* p1 = static_cast<char*>(arena.allocate(16));
+	char* p2 = static_cast<char*>(arena.allocate(4096));
+	std::memset(p2, 0, 4096);
+	assert (arena.blocks() == 2);
+	assert (arena.capacity() == 1024 + 4096);
+
+	// a dedicated block does not replace the current block
+	char* p3 = static_cast<char*>(arena.allocate(16));
+	assert (p3 > p1 && p3 < p1 + 1024);
+	assert (arena.blocks() == 2);
+}
+
+
+void ArenaTest::testDeallocate()
+{
+	Arena arena(1024);
+	void* p1 = arena.allocate(100);
+	void* p2 = arena.allocate(100);
+	arena.deallocate(p1, 100);
+	assert (arena.allocated() == 200);
+	arena.deallocate(p2, 100);
+	assert (arena.allocated() == 100);
+	void* p3 = arena.allocate(100);
+	assert (p3 == p2);
+}
+
+
+void ArenaTest::testReset()
+{
+	char buffer[128];
+	Arena arena(buffer, sizeof(buffer), 256);
+	for (int i = 0; i < 10; ++i) arena.allocate(100);
+	assert (arena.blocks() > 0);
+	arena.reset();
+	assert (arena.blocks() == 0);
+	assert (arena.allocated() == 0);
+	assert (arena.capacity() == sizeof(buffer));
+	char* p = static_cast<char*>(arena.allocate(16));
+	assert (p >= buffer && p < buffer + sizeof(buffer));
+}
+
+
+void ArenaTest::testAllocator()
+{
+	Arena arena(4096);
+	typedef std::vector<int, ArenaAllocator<int> > Vec;
+	Vec vec((ArenaAllocator<int>(arena)));
+	for (int i = 0; i < 100; ++i) vec.push_back(i);
+	assert (vec.size() == 100);
+	assert (vec[99] == 99);
+	assert (arena.allocated() > 0);
+	assert (vec.get_allocator().arena() == &arena);
+
+	Vec copy(vec);
+	assert (copy.get_allocator().arena() == 0);
+	assert (copy == vec);
+
+	Vec heap;
+	heap.swap(vec);
+	assert (heap.get_allocator().arena() == &arena);
+	assert (vec.get_allocator().arena() == 0);
+
+	typedef std::map<int, std::string, std::less<int>, ArenaAllocator<std::pair<const int, std::string> > > Map;
+	Map m((Map::allocator_type(arena)));
+	m[1] = "one";
+	m[2] = "two";
+	assert (m.size() == 2);
+	assert (m[2] == "two");
+
+	ArenaAllocator<int> a1(arena);
+	ArenaAllocator<char> a2(a1);
+	ArenaAllocator<int> a3;
+	assert (a1 == a2);
+	assert (a1 != a3);
+}
+
+
+void ArenaTest::testStruct()
+{
+	Arena arena;
+	Struct<std::string> s(arena);
+	s["name"] = "Poco";
+	s["version"] = 1;
+	assert (s.size() == 2);
+	assert (arena.allocated() > 0);
+	assert (s["name"] == "Poco");
+
+	Struct<std::string> copy(s);
+	assert (copy.size() == 2);
+	assert (copy["version"] == 1);
+
+	Var v(s);
+	assert (v["name"] == "Poco");
+}
+
+
+void ArenaTest::setUp()
+{
+}
+
+
+void ArenaTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ArenaTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ArenaTest");
+
+	CppUnit_addTest(pSuite, ArenaTest, testAllocate);
+	CppUnit_addTest(pSuite, ArenaTest, testInitialBuffer);
+	CppUnit_addTest(pSuite, ArenaTest, testAlignment);
+	CppUnit_addTest(pSuite, ArenaTest, testLargeAllocation);
+	CppUnit_addTest(pSuite, ArenaTest, testDeallocate);
+	CppUnit_addTest(pSuite, ArenaTest, testReset);
+	CppUnit_addTest(pSuite, ArenaTest, testAllocator);
+	CppUnit_addTest(pSuite, ArenaTest, testStruct);
+
+	return pSuite;
+}
@@ -165,6 +165,28 @@ void AutoPtrTest::testOps()
 }
 
 
+void AutoPtrTest::testMove()
+{
+	{
+		AutoPtr<TestObj> ptr = new TestObj;
+		AutoPtr<TestObj> ptr2(std::move(ptr));
+		assert (ptr.isNull());
+		assert (ptr2->rc() == 1);
+
+		AutoPtr<TestObj> ptr3 = new TestObj;
+		assert (TestObj::count() == 2);
+		ptr3 = std::move(ptr2);
+		assert (TestObj::count() == 1);
+		assert (ptr2.isNull());
+		assert (ptr3->rc() == 1);
+
+		ptr3 = std::move(ptr3);
+		assert (ptr3->rc() == 1);
+	}
+	assert (TestObj::count() == 0);
+}
+
+
 void AutoPtrTest::setUp()
 {
 }
@@ -181,6 +203,7 @@ CppUnit::Test* AutoPtrTest::suite()
 
 	CppUnit_addTest(pSuite, AutoPtrTest, testAutoPtr);
 	CppUnit_addTest(pSuite, AutoPtrTest, testOps);
+	CppUnit_addTest(pSuite, AutoPtrTest, testMove);
 
 	return pSuite;
 }
@@ -26,6 +26,7 @@ public:
 
 	void testAutoPtr();
 	void testOps();
+	void testMove();
 
 	void setUp();
 	void tearDown();
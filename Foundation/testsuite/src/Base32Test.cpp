@@ -13,15 +13,39 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Base32Encoder.h"
 #include "Poco/Base32Decoder.h"
+#include "Poco/Base32.h"
+#include "Poco/Stopwatch.h"
 #include "Poco/Exception.h"
 #include <sstream>
+#include <iostream>
 
 
 using Poco::Base32Encoder;
 using Poco::Base32Decoder;
+using Poco::Base32;
 using Poco::DataFormatException;
 
 
+namespace
+{
+	std::string testData(std::size_t length)
+	{
+		std::string data;
+		for (std::size_t i = 0; i < length; ++i) data += static_cast<char>(i*37 + i/7);
+		return data;
+	}
+
+	std::string encodeByChar(const std::string& data, bool padding)
+	{
+		std::ostringstream str;
+		Base32Encoder encoder(str, padding);
+		for (std::string::const_iterator it = data.begin(); it != data.end(); ++it) encoder.put(*it);
+		encoder.close();
+		return str.str();
+	}
+}
+
+
 Base32Test::Base32Test(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -160,6 +184,91 @@ void Base32Test::testEncodeDecode()
 }
 
 
+void Base32Test::testBuffer()
+{
+	for (int padding = 0; padding < 2; ++padding)
+	{
+		for (std::size_t length = 0; length < 300; ++length)
+		{
+			std::string data = testData(length);
+			std::string encoded = Base32::encode(data, padding != 0);
+			assert (encoded == encodeByChar(data, padding != 0));
+			assert (encoded.size() == Base32::encodedLength(length, padding != 0));
+			assert (Base32::decode(encoded) == data);
+		}
+	}
+
+	assert (Base32::encode(std::string("foobar")) == "MZXW6YTBOI======");
+	assert (Base32::decode(std::string("MZXW6YTBOI======")) == "foobar");
+	assert (Base32::decode(std::string("MZXW6YTBOI")) == "foobar");
+
+	try
+	{
+		Base32::decode(std::string("MZXW6YTB0I======"));
+		fail("invalid character - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+
+	try
+	{
+		Base32::decode(std::string("MZXW6YTBO"));
+		fail("invalid length - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void Base32Test::testStreamBlocks()
+{
+	std::string data = testData(20000);
+	for (int padding = 0; padding < 2; ++padding)
+	{
+		std::ostringstream ostr;
+		Base32Encoder encoder(ostr, padding != 0);
+		std::size_t pos = 0;
+		std::size_t block = 1;
+		while (pos < data.size())
+		{
+			std::size_t n = std::min(block, data.size() - pos);
+			encoder.write(data.data() + pos, n);
+			pos += n;
+			block = block*3 + 1;
+		}
+		encoder.close();
+		assert (ostr.str() == encodeByChar(data, padding != 0));
+		assert (Base32::decode(ostr.str()) == data);
+	}
+}
+
+
+void Base32Test::benchmarkCodec()
+{
+	const std::size_t size = 1024*1024;
+	const int rounds = 100;
+	std::string data = testData(size);
+	std::string encoded(Base32::encodedLength(size), '\0');
+	std::string decoded(size, '\0');
+
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < rounds; ++i) Base32::encode(data.data(), size, &encoded[0]);
+	sw.stop();
+	double encodeRate = double(size)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e9;
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i) Base32::decode(encoded.data(), encoded.size(), &decoded[0]);
+	sw.stop();
+	double decodeRate = double(size)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e9;
+	assert (decoded == data);
+
+	std::cout << std::endl << "Base32 encode: " << encodeRate << " GB/s, decode: " << decodeRate << " GB/s" << std::endl;
+}
+
+
 void Base32Test::setUp()
 {
 }
@@ -177,6 +286,9 @@ CppUnit::Test* Base32Test::suite()
 	CppUnit_addTest(pSuite, Base32Test, testEncoder);
 	CppUnit_addTest(pSuite, Base32Test, testDecoder);
 	CppUnit_addTest(pSuite, Base32Test, testEncodeDecode);
+	CppUnit_addTest(pSuite, Base32Test, testBuffer);
+	CppUnit_addTest(pSuite, Base32Test, testStreamBlocks);
+	//CppUnit_addTest(pSuite, Base32Test, benchmarkCodec);
 
 	return pSuite;
 }
@@ -27,6 +27,9 @@ public:
 	void testEncoder();
 	void testDecoder();
 	void testEncodeDecode();
+	void testBuffer();
+	void testStreamBlocks();
+	void benchmarkCodec();
 
 	void setUp();
 	void tearDown();
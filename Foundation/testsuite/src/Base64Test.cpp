@@ -13,15 +13,41 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Base64Encoder.h"
 #include "Poco/Base64Decoder.h"
+#include "Poco/Base64.h"
+#include "Poco/Stopwatch.h"
 #include "Poco/Exception.h"
 #include <sstream>
+#include <iostream>
+#include <vector>
 
 
 using Poco::Base64Encoder;
 using Poco::Base64Decoder;
+using Poco::Base64;
 using Poco::DataFormatException;
 
 
+namespace
+{
+	std::string testData(std::size_t length)
+	{
+		std::string data;
+		for (std::size_t i = 0; i < length; ++i) data += static_cast<char>(i*37 + i/7);
+		return data;
+	}
+
+	std::string encodeByChar(const std::string& data, int options, int lineLength)
+	{
+		std::ostringstream str;
+		Base64Encoder encoder(str, options);
+		encoder.rdbuf()->setLineLength(lineLength);
+		for (std::string::const_iterator it = data.begin(); it != data.end(); ++it) encoder.put(*it);
+		encoder.close();
+		return str.str();
+	}
+}
+
+
 Base64Test::Base64Test(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -343,6 +369,168 @@ void Base64Test::testEncodeDecode()
 }
 
 
+void Base64Test::testBuffer()
+{
+	const int options[] = { 0, Poco::BASE64_URL_ENCODING, Poco::BASE64_NO_PADDING, Poco::BASE64_URL_ENCODING | Poco::BASE64_NO_PADDING };
+	for (int o = 0; o < 4; ++o)
+	{
+		for (std::size_t length = 0; length < 300; ++length)
+		{
+			std::string data = testData(length);
+			std::string encoded = Base64::encode(data, options[o]);
+			assert (encoded == encodeByChar(data, options[o], 0));
+			assert (encoded.size() == Base64::encodedLength(length, options[o]));
+			assert (Base64::decode(encoded, options[o]) == data);
+		}
+	}
+
+	assert (Base64::encode(std::string("Hello, world!")) == "SGVsbG8sIHdvcmxkIQ==");
+	assert (Base64::decode(std::string("SGVsbG8sIHdvcmxkIQ==")) == "Hello, world!");
+	assert (Base64::decode(std::string("SGVsbG8sIHdvcmxkIQ"), Poco::BASE64_NO_PADDING) == "Hello, world!");
+	assert (Base64::decode(std::string("SGVsbG8sIHdvcmxkIQ=="), Poco::BASE64_NO_PADDING) == "Hello, world!");
+}
+
+
+void Base64Test::testBufferInvalid()
+{
+	// an invalid character at every position, to hit both the vectorized and the scalar code
+	std::string encoded = Base64::encode(testData(150));
+	for (std::size_t i = 0; i < encoded.size() - 2; ++i)
+	{
+		std::string invalid(encoded);
+		invalid[i] = '*';
+		try
+		{
+			Base64::decode(invalid);
+			fail("invalid character - must throw");
+		}
+		catch (DataFormatException&)
+		{
+		}
+	}
+
+	try
+	{
+		Base64::decode(std::string("SGVsbG8"));
+		fail("incomplete group - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+
+	try
+	{
+		Base64::decode(std::string("SGVsb"), Poco::BASE64_NO_PADDING);
+		fail("dangling character - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+
+	try
+	{
+		Base64::decode(std::string("SGVs===="));
+		fail("invalid padding - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+
+	try
+	{
+		Base64::decode(std::string("SGV-"));
+		fail("URL alphabet character - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void Base64Test::testStreamBlocks()
+{
+	std::string data = testData(20000);
+	const int lineLengths[] = { 0, 1, 4, 72, 76, 1000 };
+	for (int l = 0; l < 6; ++l)
+	{
+		for (int o = 0; o < 2; ++o)
+		{
+			int options = o ? Poco::BASE64_NO_PADDING : 0;
+			std::string expected = encodeByChar(data, options, lineLengths[l]);
+
+			// write in blocks of varying size, starting with a partial group
+			std::ostringstream ostr;
+			Base64Encoder encoder(ostr, options);
+			encoder.rdbuf()->setLineLength(lineLengths[l]);
+			std::size_t pos = 0;
+			std::size_t block = 1;
+			while (pos < data.size())
+			{
+				std::size_t n = std::min(block, data.size() - pos);
+				encoder.write(data.data() + pos, n);
+				pos += n;
+				block = block*3 + 1;
+			}
+			encoder.close();
+			assert (ostr.str() == expected);
+
+			// read in blocks of varying size, interleaved with get() and peek()
+			std::istringstream istr(expected);
+			Base64Decoder decoder(istr, options);
+			std::string decoded;
+			std::vector<char> buffer(10000);
+			block = 1;
+			while (decoder.good())
+			{
+				decoder.read(&buffer[0], std::min<std::size_t>(block, buffer.size()));
+				decoded.append(&buffer[0], static_cast<std::size_t>(decoder.gcount()));
+				if (decoder.peek() != -1) decoded += static_cast<char>(decoder.get());
+				block = block*2 + 1;
+			}
+			assert (decoded == data);
+		}
+	}
+
+	// concatenated padded encodings
+	std::istringstream istr("SGVsbG8=IHdvcmxkIQ==");
+	Base64Decoder decoder(istr);
+	char buffer[32];
+	decoder.read(buffer, sizeof(buffer));
+	assert (std::string(buffer, static_cast<std::size_t>(decoder.gcount())) == "Hello world!");
+
+	// the decoder does not read beyond what it needs
+	std::istringstream istr2("SGVsbG8sIHdvcmxkIQ==!");
+	Base64Decoder decoder2(istr2);
+	decoder2.read(buffer, 12);
+	assert (std::string(buffer, 12) == "Hello, world");
+	assert (istr2.tellg() == 16);
+}
+
+
+void Base64Test::benchmarkCodec()
+{
+	const std::size_t size = 1024*1024;
+	const int rounds = 200;
+	std::string data = testData(size);
+	std::string encoded(Base64::encodedLength(size), '\0');
+	std::string decoded(size, '\0');
+
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < rounds; ++i) Base64::encode(data.data(), size, &encoded[0]);
+	sw.stop();
+	double encodeRate = double(size)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e9;
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i) Base64::decode(encoded.data(), encoded.size(), &decoded[0]);
+	sw.stop();
+	double decodeRate = double(size)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e9;
+	assert (decoded == data);
+
+	std::cout << std::endl << "Base64 encode: " << encodeRate << " GB/s, decode: " << decodeRate << " GB/s" << std::endl;
+}
+
+
 void Base64Test::setUp()
 {
 }
@@ -364,6 +552,10 @@ CppUnit::Test* Base64Test::suite()
 	CppUnit_addTest(pSuite, Base64Test, testDecoderURL);
 	CppUnit_addTest(pSuite, Base64Test, testDecoderNoPadding);
 	CppUnit_addTest(pSuite, Base64Test, testEncodeDecode);
+	CppUnit_addTest(pSuite, Base64Test, testBuffer);
+	CppUnit_addTest(pSuite, Base64Test, testBufferInvalid);
+	CppUnit_addTest(pSuite, Base64Test, testStreamBlocks);
+	//CppUnit_addTest(pSuite, Base64Test, benchmarkCodec);
 
 	return pSuite;
 }
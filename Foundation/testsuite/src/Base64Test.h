@@ -31,6 +31,10 @@ public:
 	void testDecoderURL();
 	void testDecoderNoPadding();
 	void testEncodeDecode();
+	void testBuffer();
+	void testBufferInvalid();
+	void testStreamBlocks();
+	void benchmarkCodec();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,420 @@
+//
+// BinaryLogChannelTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "BinaryLogChannelTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/BinaryLogChannel.h"
+#include "Poco/BinaryLogReader.h"
+#include "Poco/FileChannel.h"
+#include "Poco/FormattingChannel.h"
+#include "Poco/PatternFormatter.h"
+#include "Poco/Message.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/FileStream.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include "Poco/DirectoryIterator.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include <sstream>
+#include <vector>
+#include <iostream>
+
+
+using Poco::BinaryLogChannel;
+using Poco::BinaryLogReader;
+using Poco::FileChannel;
+using Poco::FormattingChannel;
+using Poco::PatternFormatter;
+using Poco::Message;
+using Poco::AutoPtr;
+using Poco::FileInputStream;
+using Poco::File;
+using Poco::Path;
+using Poco::DirectoryIterator;
+using Poco::TemporaryFile;
+using Poco::NumberFormatter;
+using Poco::NumberParser;
+using Poco::Stopwatch;
+using Poco::Timestamp;
+
+
+BinaryLogChannelTest::BinaryLogChannelTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+BinaryLogChannelTest::~BinaryLogChannelTest()
+{
+}
+
+
+void BinaryLogChannelTest::testWriteRead()
+{
+	Message msg1("Source1", "Text1", Message::PRIO_WARNING, __FILE__, __LINE__);
+	msg1.setThread("Thread1");
+	msg1.setTid(42);
+	msg1.setPid(4711);
+	Message msg2("Source2", "Text2", Message::PRIO_TRACE);
+	Message msg3("Source1", std::string(10000, 'x'), Message::PRIO_ERROR, __FILE__, __LINE__);
+	msg3.setThread("Thread1");
+
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(_path);
+	pChannel->open();
+	pChannel->log(msg1);
+	pChannel->log(msg2);
+	pChannel->log(msg3);
+	pChannel->close();
+	assert (File(_path).getSize() > 10000);
+	assert (File(_path).getSize() < 10500);
+
+	FileInputStream istr(_path);
+	BinaryLogReader reader(istr);
+	assert (reader.version() == BinaryLogChannel::FILE_VERSION);
+
+	Message msg;
+	assert (reader.read(msg));
+	assert (msg.getSource() == "Source1");
+	assert (msg.getText() == "Text1");
+	assert (msg.getPriority() == Message::PRIO_WARNING);
+	assert (msg.getTime() == msg1.getTime());
+	assert (msg.getThread() == "Thread1");
+	assert (msg.getTid() == 42);
+	assert (msg.getPid() == 4711);
+	assert (std::string(msg.getSourceFile()) == msg1.getSourceFile());
+	assert (msg.getSourceLine() == msg1.getSourceLine());
+
+	assert (reader.read(msg));
+	assert (msg.getSource() == "Source2");
+	assert (msg.getText() == "Text2");
+	assert (msg.getPriority() == Message::PRIO_TRACE);
+	assert (msg.getThread().empty());
+	assert (msg.getSourceFile() == 0);
+	assert (msg.getSourceLine() == 0);
+
+	assert (reader.read(msg));
+	assert (msg.getSource() == "Source1");
+	assert (msg.getText() == msg3.getText());
+	assert (msg.getThread() == "Thread1");
+	assert (std::string(msg.getSourceFile()) == msg3.getSourceFile());
+
+	assert (!reader.read(msg));
+}
+
+
+void BinaryLogChannelTest::testParameters()
+{
+	Message msg1("Source", "Text", Message::PRIO_INFORMATION);
+	msg1.set("user", "guest");
+	msg1.set("request", "GET /index.html");
+
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(_path);
+	pChannel->log(msg1);
+	pChannel->log(Message("Source", "Text", Message::PRIO_INFORMATION));
+	pChannel->close();
+
+	FileInputStream istr(_path);
+	BinaryLogReader reader(istr);
+	Message msg;
+	assert (reader.read(msg));
+	assert (msg.getAll().size() == 2);
+	assert (msg["user"] == "guest");
+	assert (msg["request"] == "GET /index.html");
+
+	assert (reader.read(msg));
+	assert (!msg.hasParameters());
+	assert (!reader.read(msg));
+}
+
+
+void BinaryLogChannelTest::testRotation()
+{
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(_path);
+	pChannel->setProperty(BinaryLogChannel::PROP_ROTATION, "2 K");
+	for (int i = 0; i < 200; ++i)
+	{
+		Message msg("Source", NumberFormatter::format(i), Message::PRIO_INFORMATION, __FILE__, __LINE__);
+		msg.setThread("Thread");
+		pChannel->log(msg);
+	}
+	pChannel->close();
+
+	std::vector<std::string> files;
+	for (int n = 0; File(_path + "." + NumberFormatter::format(n)).exists(); ++n)
+	{
+		files.push_back(_path + "." + NumberFormatter::format(n));
+		assert (File(files.back()).getSize() <= 2048);
+	}
+	assert (files.size() >= 5);
+	files.push_back(_path);
+
+	int next = 0;
+	for (std::vector<std::string>::const_iterator it = files.begin(); it != files.end(); ++it)
+	{
+		FileInputStream istr(*it);
+		BinaryLogReader reader(istr);
+		Message msg;
+		while (reader.read(msg))
+		{
+			assert (NumberParser::parse(msg.getText()) == next++);
+			assert (msg.getSource() == "Source");
+			assert (msg.getThread() == "Thread");
+			assert (msg.getSourceFile() != 0);
+		}
+	}
+	assert (next == 200);
+}
+
+
+void BinaryLogChannelTest::testPurge()
+{
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(_path);
+	pChannel->setProperty(BinaryLogChannel::PROP_ROTATION, "1 K");
+	pChannel->setProperty(BinaryLogChannel::PROP_PURGECOUNT, "2");
+	for (int i = 0; i < 200; ++i)
+	{
+		pChannel->log(Message("Source", "Text", Message::PRIO_INFORMATION));
+	}
+	pChannel->close();
+
+	int archived = 0;
+	int highest = 0;
+	for (int n = 0; n < 100; ++n)
+	{
+		if (File(_path + "." + NumberFormatter::format(n)).exists())
+		{
+			++archived;
+			highest = n;
+		}
+	}
+	assert (archived == 2);
+	assert (highest >= 3);
+	assert (File(_path + "." + NumberFormatter::format(highest - 1)).exists());
+}
+
+
+void BinaryLogChannelTest::testReopen()
+{
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(_path);
+	pChannel->log(Message("Source", "First", Message::PRIO_INFORMATION));
+	pChannel->close();
+	pChannel->log(Message("Source", "Second", Message::PRIO_INFORMATION));
+	pChannel->close();
+
+	pChannel = new BinaryLogChannel(_path);
+	pChannel->log(Message("Source", "Third", Message::PRIO_INFORMATION));
+	pChannel->close();
+
+	Message msg;
+	{
+		FileInputStream istr(_path + ".0");
+		BinaryLogReader reader(istr);
+		assert (reader.read(msg));
+		assert (msg.getText() == "First");
+	}
+	{
+		FileInputStream istr(_path + ".1");
+		BinaryLogReader reader(istr);
+		assert (reader.read(msg));
+		assert (msg.getText() == "Second");
+	}
+	{
+		FileInputStream istr(_path);
+		BinaryLogReader reader(istr);
+		assert (reader.read(msg));
+		assert (msg.getText() == "Third");
+		assert (!reader.read(msg));
+	}
+}
+
+
+void BinaryLogChannelTest::testUnclosedFile()
+{
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel(_path);
+	pChannel->setProperty(BinaryLogChannel::PROP_ROTATION, "64 K");
+	pChannel->log(Message("Source", "Text1", Message::PRIO_INFORMATION));
+	pChannel->log(Message("Source", "Text2", Message::PRIO_INFORMATION));
+	assert (pChannel->size() > 0);
+
+	// a copy of the mapped file shows the state after a crash
+	std::string copy = _path + ".copy";
+	File(_path).copyTo(copy);
+	pChannel->close();
+	assert (File(copy).getSize() == 64*1024);
+
+	FileInputStream istr(copy);
+	BinaryLogReader reader(istr);
+	Message msg;
+	assert (reader.read(msg));
+	assert (msg.getText() == "Text1");
+	assert (reader.read(msg));
+	assert (msg.getText() == "Text2");
+	assert (!reader.read(msg));
+}
+
+
+void BinaryLogChannelTest::testInvalidFile()
+{
+	std::istringstream istr1("not a log file");
+	try
+	{
+		BinaryLogReader reader(istr1);
+		fail("not a binary log - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+
+	std::istringstream istr2("");
+	try
+	{
+		BinaryLogReader reader(istr2);
+		fail("empty stream - must throw");
+	}
+	catch (Poco::DataFormatException&)
+	{
+	}
+}
+
+
+void BinaryLogChannelTest::testProperties()
+{
+	AutoPtr<BinaryLogChannel> pChannel = new BinaryLogChannel;
+	assert (pChannel->getProperty(BinaryLogChannel::PROP_ROTATION) == NumberFormatter::format(16*1024*1024));
+	assert (pChannel->getProperty(BinaryLogChannel::PROP_PURGECOUNT) == "none");
+
+	pChannel->setProperty(BinaryLogChannel::PROP_PATH, _path);
+	assert (pChannel->path() == _path);
+	pChannel->setProperty(BinaryLogChannel::PROP_ROTATION, "4 K");
+	assert (pChannel->getProperty(BinaryLogChannel::PROP_ROTATION) == "4096");
+	pChannel->setProperty(BinaryLogChannel::PROP_PURGECOUNT, "5");
+	assert (pChannel->getProperty(BinaryLogChannel::PROP_PURGECOUNT) == "5");
+
+	try
+	{
+		pChannel->setProperty(BinaryLogChannel::PROP_ROTATION, "10 G");
+		fail("invalid unit - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		pChannel->setProperty(BinaryLogChannel::PROP_ROTATION, "100");
+		fail("rotation too small - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	AutoPtr<BinaryLogChannel> pNoPath = new BinaryLogChannel;
+	try
+	{
+		pNoPath->open();
+		fail("no path - must throw");
+	}
+	catch (Poco::PropertyNotSupportedException&)
+	{
+	}
+}
+
+
+void BinaryLogChannelTest::benchmarkLog()
+{
+	const int count = 1000000;
+	Message msg("Benchmark", "A log message of typical length, logged by the benchmark", Message::PRIO_INFORMATION, __FILE__, __LINE__);
+	msg.setThread("Thread");
+
+	AutoPtr<FileChannel> pFile = new FileChannel(_path + ".txt");
+	AutoPtr<FormattingChannel> pFormatting = new FormattingChannel(new PatternFormatter("%Y-%m-%d %H:%M:%S.%i [%p] %s <%T>: %t (%U:%u)"), pFile);
+	pFile->setProperty(FileChannel::PROP_BUFFERSIZE, "64 K");
+	pFormatting->open();
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < count; ++i) pFormatting->log(msg);
+	sw.stop();
+	pFormatting->close();
+	double nsText = sw.elapsed()*1000.0/count;
+
+	AutoPtr<BinaryLogChannel> pBinary = new BinaryLogChannel(_path);
+	pBinary->setProperty(BinaryLogChannel::PROP_ROTATION, "256 M");
+	pBinary->open();
+	sw.restart();
+	for (int i = 0; i < count; ++i) pBinary->log(msg);
+	sw.stop();
+	pBinary->close();
+	double nsBinary = sw.elapsed()*1000.0/count;
+
+	std::cout << std::endl;
+	std::cout << "FileChannel (formatted): " << nsText << " [ns/log], " << File(_path + ".txt").getSize() << " bytes" << std::endl;
+	std::cout << "BinaryLogChannel:        " << nsBinary << " [ns/log], " << File(_path).getSize() << " bytes" << std::endl;
+}
+
+
+void BinaryLogChannelTest::setUp()
+{
+	_path = Path(TemporaryFile::tempName()).getFileName() + ".blog";
+}
+
+
+void BinaryLogChannelTest::tearDown()
+{
+	remove(_path);
+}
+
+
+void BinaryLogChannelTest::remove(const std::string& baseName)
+{
+	DirectoryIterator it(Path::current());
+	DirectoryIterator end;
+	std::vector<std::string> files;
+	while (it != end)
+	{
+		if (it.name().find(baseName) == 0)
+		{
+			files.push_back(it.name());
+		}
+		++it;
+	}
+	for (std::vector<std::string>::iterator it = files.begin(); it != files.end(); ++it)
+	{
+		try
+		{
+			File f(*it);
+			f.remove();
+		}
+		catch (...)
+		{
+		}
+	}
+}
+
+
+CppUnit::Test* BinaryLogChannelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("BinaryLogChannelTest");
+
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testWriteRead);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testParameters);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testRotation);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testPurge);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testReopen);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testUnclosedFile);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testInvalidFile);
+	CppUnit_addTest(pSuite, BinaryLogChannelTest, testProperties);
+	// CppUnit_addTest(pSuite, BinaryLogChannelTest, benchmarkLog);
+
+	return pSuite;
+}
@@ -0,0 +1,49 @@
+//
+// BinaryLogChannelTest.h
+//
+// Definition of the BinaryLogChannelTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef BinaryLogChannelTest_INCLUDED
+#define BinaryLogChannelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class BinaryLogChannelTest: public CppUnit::TestCase
+{
+public:
+	BinaryLogChannelTest(const std::string& name);
+	~BinaryLogChannelTest();
+
+	void testWriteRead();
+	void testParameters();
+	void testRotation();
+	void testPurge();
+	void testReopen();
+	void testUnclosedFile();
+	void testInvalidFile();
+	void testProperties();
+	void benchmarkLog();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+	void remove(const std::string& baseName);
+
+	std::string _path;
+};
+
+
+#endif // BinaryLogChannelTest_INCLUDED
@@ -0,0 +1,224 @@
+//
+// ChecksumTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ChecksumTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Checksum.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <vector>
+
+
+using Poco::Checksum;
+using Poco::UInt32;
+
+
+namespace
+{
+	UInt32 crcBitwise(UInt32 poly, const std::vector<unsigned char>& data, std::size_t offset, std::size_t length)
+	{
+		UInt32 crc = 0xFFFFFFFF;
+		for (std::size_t i = offset; i < offset + length; ++i)
+		{
+			crc ^= data[i];
+			for (int k = 0; k < 8; ++k)
+				crc = (crc >> 1) ^ (poly & (0 - (crc & 1)));
+		}
+		return ~crc;
+	}
+
+	UInt32 adlerSimple(const std::vector<unsigned char>& data, std::size_t offset, std::size_t length)
+	{
+		UInt32 a = 1;
+		UInt32 b = 0;
+		for (std::size_t i = offset; i < offset + length; ++i)
+		{
+			a = (a + data[i]) % 65521;
+			b = (b + a) % 65521;
+		}
+		return (b << 16) | a;
+	}
+
+	std::vector<unsigned char> testData(std::size_t length)
+	{
+		std::vector<unsigned char> data(length);
+		UInt32 x = 12345;
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			x = x*1103515245 + 12345;
+			data[i] = static_cast<unsigned char>(x >> 16);
+		}
+		return data;
+	}
+
+	UInt32 checksum(Checksum::Type type, const std::vector<unsigned char>& data, std::size_t offset, std::size_t length)
+	{
+		Checksum cs(type);
+		cs.updateBytes(length ? &data[offset] : 0, length);
+		return cs.checksum();
+	}
+}
+
+
+ChecksumTest::ChecksumTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ChecksumTest::~ChecksumTest()
+{
+}
+
+
+void ChecksumTest::testCRC32()
+{
+	Checksum cs;
+	assert (cs.type() == Checksum::TYPE_CRC32);
+	assert (cs.checksum() == 0);
+	cs.update(std::string("123456789"));
+	assert (cs.checksum() == 0xCBF43926);
+
+	// all lengths around the block sizes of the vectorized code, at all alignments
+	std::vector<unsigned char> data = testData(70000);
+	for (std::size_t length = 0; length < 300; ++length)
+	{
+		for (std::size_t offset = 0; offset < 16; ++offset)
+		{
+			assert (checksum(Checksum::TYPE_CRC32, data, offset, length) == crcBitwise(0xEDB88320, data, offset, length));
+		}
+	}
+	assert (checksum(Checksum::TYPE_CRC32, data, 3, 69997) == crcBitwise(0xEDB88320, data, 3, 69997));
+}
+
+
+void ChecksumTest::testCRC32C()
+{
+	Checksum cs(Checksum::TYPE_CRC32C);
+	assert (cs.type() == Checksum::TYPE_CRC32C);
+	assert (cs.checksum() == 0);
+	cs.update(std::string("123456789"));
+	assert (cs.checksum() == 0xE3069283);
+
+	std::vector<unsigned char> data = testData(70000);
+	for (std::size_t length = 0; length < 1000; ++length)
+	{
+		std::size_t offset = length % 16;
+		assert (checksum(Checksum::TYPE_CRC32C, data, offset, length) == crcBitwise(0x82F63B78, data, offset, length));
+	}
+
+	// lengths exercising the interleaved code and the combination of the partial CRCs
+	const std::size_t lengths[] = { 3*256 - 1, 3*256, 3*256 + 7, 3*8192 - 1, 3*8192, 3*8192 + 3*256 + 9, 69990 };
+	for (std::size_t i = 0; i < sizeof(lengths)/sizeof(lengths[0]); ++i)
+	{
+		assert (checksum(Checksum::TYPE_CRC32C, data, 5, lengths[i]) == crcBitwise(0x82F63B78, data, 5, lengths[i]));
+	}
+}
+
+
+void ChecksumTest::testAdler32()
+{
+	Checksum cs(Checksum::TYPE_ADLER32);
+	assert (cs.type() == Checksum::TYPE_ADLER32);
+	assert (cs.checksum() == 1);
+	cs.update(std::string("123456789"));
+	assert (cs.checksum() == 0x091E01DE);
+
+	std::vector<unsigned char> data = testData(70000);
+	for (std::size_t length = 0; length < 300; ++length)
+	{
+		for (std::size_t offset = 0; offset < 16; ++offset)
+		{
+			assert (checksum(Checksum::TYPE_ADLER32, data, offset, length) == adlerSimple(data, offset, length));
+		}
+	}
+	assert (checksum(Checksum::TYPE_ADLER32, data, 1, 69999) == adlerSimple(data, 1, 69999));
+
+	// maximum byte values, to check the reduction
+	std::vector<unsigned char> ff(100000, 0xFF);
+	assert (checksum(Checksum::TYPE_ADLER32, ff, 0, ff.size()) == adlerSimple(ff, 0, ff.size()));
+}
+
+
+void ChecksumTest::testIncremental()
+{
+	std::vector<unsigned char> data = testData(100000);
+	const Checksum::Type types[] = { Checksum::TYPE_CRC32, Checksum::TYPE_CRC32C, Checksum::TYPE_ADLER32 };
+	for (int t = 0; t < 3; ++t)
+	{
+		UInt32 expected = checksum(types[t], data, 0, data.size());
+		Checksum cs(types[t]);
+		std::size_t pos = 0;
+		std::size_t block = 1;
+		while (pos < data.size())
+		{
+			std::size_t n = std::min(block, data.size() - pos);
+			cs.updateBytes(&data[pos], n);
+			pos += n;
+			block = block*3 + 1;
+		}
+		assert (cs.checksum() == expected);
+
+		Checksum bytewise(types[t]);
+		for (std::size_t i = 0; i < 1000; ++i) bytewise.update(static_cast<char>(data[i]));
+		assert (bytewise.checksum() == checksum(types[t], data, 0, 1000));
+
+		char* pChars = reinterpret_cast<char*>(&data[0]);
+		Checksum chars(types[t]);
+		chars.update(pChars, std::size_t(500));
+		chars.update(pChars + 500, 500);
+		assert (chars.checksum() == checksum(types[t], data, 0, 1000));
+	}
+}
+
+
+void ChecksumTest::benchmarkChecksum()
+{
+	const std::size_t size = 1024*1024;
+	const int rounds = 500;
+	std::vector<unsigned char> data = testData(size);
+	const Checksum::Type types[] = { Checksum::TYPE_CRC32, Checksum::TYPE_CRC32C, Checksum::TYPE_ADLER32 };
+	const char* names[] = { "CRC-32:   ", "CRC-32C:  ", "Adler-32: " };
+
+	std::cout << std::endl;
+	for (int t = 0; t < 3; ++t)
+	{
+		Poco::Stopwatch sw;
+		sw.start();
+		Checksum cs(types[t]);
+		for (int i = 0; i < rounds; ++i) cs.updateBytes(&data[0], size);
+		sw.stop();
+		std::cout << names[t] << double(size)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e9 << " GB/s" << std::endl;
+	}
+}
+
+
+void ChecksumTest::setUp()
+{
+}
+
+
+void ChecksumTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ChecksumTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ChecksumTest");
+
+	CppUnit_addTest(pSuite, ChecksumTest, testCRC32);
+	CppUnit_addTest(pSuite, ChecksumTest, testCRC32C);
+	CppUnit_addTest(pSuite, ChecksumTest, testAdler32);
+	CppUnit_addTest(pSuite, ChecksumTest, testIncremental);
+	//CppUnit_addTest(pSuite, ChecksumTest, benchmarkChecksum);
+
+	return pSuite;
+}
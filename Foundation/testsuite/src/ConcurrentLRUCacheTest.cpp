@@ -0,0 +1,463 @@
+//
+// ConcurrentLRUCacheTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "ConcurrentLRUCacheTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Exception.h"
+#include "Poco/ConcurrentLRUCache.h"
+#include "Poco/LRUCache.h"
+#include "Poco/Bugcheck.h"
+#include "Poco/Delegate.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <string>
+
+
+using namespace Poco;
+
+
+namespace
+{
+	struct StringWeigher
+	{
+		std::size_t operator () (const int&, const std::string& value) const
+		{
+			return value.size();
+		}
+	};
+
+	template <class C>
+	class CacheRunnable: public Runnable
+	{
+	public:
+		CacheRunnable(C& cache, int keys, int ops, int seed):
+			_cache(cache),
+			_keys(keys),
+			_ops(ops),
+			_seed(seed),
+			_hits(0)
+		{
+		}
+
+		void run()
+		{
+			unsigned n = _seed;
+			for (int i = 0; i < _ops; ++i)
+			{
+				n = n*1103515245 + 12345;
+				int key = static_cast<int>((n >> 8) % _keys);
+				if ((n >> 4) % 10 == 0)
+				{
+					_cache.add(key, key);
+				}
+				else
+				{
+					SharedPtr<int> p = _cache.get(key);
+					if (p)
+					{
+						poco_assert (*p == key);
+						++_hits;
+					}
+				}
+			}
+		}
+
+		int hits() const
+		{
+			return _hits;
+		}
+
+	private:
+		C&  _cache;
+		int _keys;
+		int _ops;
+		int _seed;
+		int _hits;
+	};
+
+	template <class C>
+	double runThreads(C& cache, int threads, int keys, int ops)
+	{
+		std::vector<CacheRunnable<C>*> runnables;
+		std::vector<Thread*> workers;
+		for (int i = 0; i < threads; ++i)
+		{
+			runnables.push_back(new CacheRunnable<C>(cache, keys, ops, i + 1));
+			workers.push_back(new Thread);
+		}
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < threads; ++i) workers[i]->start(*runnables[i]);
+		for (int i = 0; i < threads; ++i) workers[i]->join();
+		sw.stop();
+		for (int i = 0; i < threads; ++i)
+		{
+			delete workers[i];
+			delete runnables[i];
+		}
+		return sw.elapsed()/1000.0;
+	}
+}
+
+
+ConcurrentLRUCacheTest::ConcurrentLRUCacheTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+ConcurrentLRUCacheTest::~ConcurrentLRUCacheTest()
+{
+}
+
+
+void ConcurrentLRUCacheTest::testClear()
+{
+	ConcurrentLRUCache<int, int> aCache(30);
+	assert (aCache.size() == 0);
+	assert (aCache.getAllKeys().size() == 0);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	aCache.add(5, 6);
+	assert (aCache.size() == 3);
+	assert (aCache.getAllKeys().size() == 3);
+	assert (aCache.has(1));
+	assert (aCache.has(3));
+	assert (aCache.has(5));
+	assert (*aCache.get(1) == 2);
+	assert (*aCache.get(3) == 4);
+	assert (*aCache.get(5) == 6);
+	aCache.clear();
+	assert (!aCache.has(1));
+	assert (!aCache.has(3));
+	assert (!aCache.has(5));
+	assert (aCache.size() == 0);
+}
+
+
+void ConcurrentLRUCacheTest::testCacheSize0()
+{
+	// cache size 0 is illegal
+	try
+	{
+		ConcurrentLRUCache<int, int> aCache(0);
+		failmsg ("cache size of 0 is illegal, test should fail");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void ConcurrentLRUCacheTest::testCacheSize1()
+{
+	ConcurrentLRUCache<int, int> aCache(1, 0, ConcurrentLRUCache<int, int>::EVICT_LRU, 1);
+	aCache.add(1, 2);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+
+	aCache.add(3, 4); // replaces 1
+	assert (!aCache.has(1));
+	assert (aCache.has(3));
+	assert (*aCache.get(3) == 4);
+
+	aCache.remove(3);
+	assert (!aCache.has(3));
+
+	// removing illegal entries should work too
+	aCache.remove(666);
+}
+
+
+void ConcurrentLRUCacheTest::testCacheSizeN()
+{
+	// 3-1 represents the cache sorted by pos, elements get replaced at the end of the list
+	ConcurrentLRUCache<int, int> aCache(3, 0, ConcurrentLRUCache<int, int>::EVICT_LRU, 1);
+	aCache.add(1, 2); // 1
+	aCache.add(3, 4); // 3-1
+	assert (*aCache.get(1) == 2); // 1-3
+	assert (*aCache.get(3) == 4); // 3-1
+
+	aCache.add(5, 6); // 5-3-1
+	assert (aCache.has(1));
+	assert (aCache.has(3));
+	assert (aCache.has(5));
+	assert (*aCache.get(5) == 6);  // 5-3-1
+	assert (*aCache.get(3) == 4);  // 3-5-1
+
+	aCache.add(7, 8); // 7-3-5|1
+	assert (!aCache.has(1));
+	assert (aCache.has(7));
+	assert (aCache.has(3));
+	assert (aCache.has(5));
+	assert (*aCache.get(5) == 6);  // 5-7-3
+	assert (*aCache.get(7) == 8);  // 7-5-3
+
+	aCache.add(9, 10); // 9-7-5|3
+	assert (!aCache.has(3));
+	assert (aCache.size() == 3);
+}
+
+
+void ConcurrentLRUCacheTest::testDuplicateAdd()
+{
+	ConcurrentLRUCache<int, int> aCache(3);
+	aCache.add(1, 2); // 1
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+	aCache.add(1, 3);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 3);
+	assert (aCache.size() == 1);
+}
+
+
+void ConcurrentLRUCacheTest::testUpdate()
+{
+	addCnt = 0;
+	updateCnt = 0;
+	removeCnt = 0;
+	ConcurrentLRUCache<int, int> aCache(3);
+	aCache.Add += delegate(this, &ConcurrentLRUCacheTest::onAdd);
+	aCache.Remove += delegate(this, &ConcurrentLRUCacheTest::onRemove);
+	aCache.Update += delegate(this, &ConcurrentLRUCacheTest::onUpdate);
+	aCache.add(1, 2); // 1 ,one add event
+	assert (addCnt == 1);
+	assert (updateCnt == 0);
+	assert (removeCnt == 0);
+
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+	aCache.update(1, 3); // one update event only!
+	assert (addCnt == 1);
+	assert (updateCnt == 1);
+	assert (removeCnt == 0);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 3);
+
+	aCache.add(1, 4); // remove and add
+	assert (addCnt == 2);
+	assert (removeCnt == 1);
+}
+
+
+void ConcurrentLRUCacheTest::testClock()
+{
+	typedef ConcurrentLRUCache<int, int> Cache;
+	Cache aCache(3, 0, Cache::EVICT_CLOCK, 1);
+	assert (aCache.policy() == Cache::EVICT_CLOCK);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	aCache.add(5, 6);
+	assert (*aCache.get(1) == 2); // 1 gets a second chance
+
+	aCache.add(7, 8); // evicts 3
+	assert (aCache.has(1));
+	assert (!aCache.has(3));
+	assert (aCache.has(5));
+	assert (aCache.has(7));
+
+	aCache.add(9, 10); // evicts 5
+	assert (aCache.has(1));
+	assert (!aCache.has(5));
+	assert (aCache.has(7));
+	assert (aCache.has(9));
+	assert (aCache.size() == 3);
+}
+
+
+void ConcurrentLRUCacheTest::testWeight()
+{
+	typedef ConcurrentLRUCache<int, std::string, Hash<int>, StringWeigher> Cache;
+	Cache aCache(10, 0, Cache::EVICT_LRU, 1);
+	aCache.add(1, "abcd");
+	aCache.add(2, "efgh");
+	assert (aCache.weight() == 8);
+	aCache.add(3, "ijkl"); // evicts 1
+	assert (!aCache.has(1));
+	assert (aCache.has(2));
+	assert (aCache.has(3));
+	assert (aCache.weight() == 8);
+
+	aCache.update(2, "e");
+	assert (aCache.weight() == 5);
+	aCache.add(4, "mnopqrstuvwxyz"); // too heavy, but the newest entry is kept
+	assert (aCache.has(4));
+	assert (aCache.size() == 1);
+	assert (aCache.weight() == 14);
+}
+
+
+void ConcurrentLRUCacheTest::testExpire()
+{
+	ConcurrentLRUCache<int, int> aCache(10, 200);
+	aCache.add(1, 2);
+	assert (aCache.has(1));
+	Thread::sleep(300);
+	assert (!aCache.has(1));
+	assert (aCache.get(1).isNull());
+
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	Thread::sleep(300);
+	aCache.add(5, 6);
+	assert (aCache.size() == 1);
+	assert (aCache.getAllKeys().size() == 1);
+	assert (aCache.has(5));
+}
+
+
+void ConcurrentLRUCacheTest::testSegments()
+{
+	ConcurrentLRUCache<int, int> aCache(1000, 0, ConcurrentLRUCache<int, int>::EVICT_LRU, 8);
+	assert (aCache.segments() == 8);
+	for (int i = 0; i < 10000; ++i)
+	{
+		aCache.add(i, i);
+	}
+	assert (aCache.size() <= 1000);
+	assert (aCache.size() > 500);
+	assert (*aCache.get(9999) == 9999);
+
+	// the segment capacities must add up to the capacity
+	for (long capacity = 1; capacity <= 40; ++capacity)
+	{
+		ConcurrentLRUCache<int, int> cache(capacity);
+		assert (cache.segments() <= capacity);
+		for (int i = 0; i < 1000; ++i)
+		{
+			cache.add(i, i);
+			assert (cache.size() <= static_cast<std::size_t>(capacity));
+		}
+		assert (cache.size() > 0);
+	}
+
+	ConcurrentLRUCache<std::string, int> sCache(100);
+	sCache.add("foo", 1);
+	sCache.add("bar", 2);
+	assert (*sCache.get("foo") == 1);
+	assert (*sCache.get("bar") == 2);
+	assert (!sCache.has("baz"));
+}
+
+
+void ConcurrentLRUCacheTest::testGetEvent()
+{
+	getCnt = 0;
+	ConcurrentLRUCache<int, int> aCache(3);
+	assert (aCache.getGetEventEnabled());
+	aCache.Get += delegate(this, &ConcurrentLRUCacheTest::onGet);
+	aCache.add(1, 2);
+	aCache.get(1);
+	aCache.get(2);
+	assert (getCnt == 1);
+
+	aCache.setGetEventEnabled(false);
+	aCache.get(1);
+	assert (getCnt == 1);
+}
+
+
+void ConcurrentLRUCacheTest::testConcurrentAccess()
+{
+	typedef ConcurrentLRUCache<int, int> Cache;
+	Cache lruCache(500, 0, Cache::EVICT_LRU);
+	runThreads(lruCache, 4, 1000, 20000);
+	assert (lruCache.size() <= 500 + Cache::DEFAULT_SEGMENTS);
+
+	Cache clockCache(500, 0, Cache::EVICT_CLOCK);
+	runThreads(clockCache, 4, 1000, 20000);
+	assert (clockCache.size() <= 500 + Cache::DEFAULT_SEGMENTS);
+}
+
+
+void ConcurrentLRUCacheTest::benchmarkConcurrentAccess()
+{
+	const int keys = 100000;
+	const int ops = 1000000;
+	typedef ConcurrentLRUCache<int, int> Cache;
+
+	for (int threads = 1; threads <= 8; threads *= 2)
+	{
+		LRUCache<int, int> lru(keys/2);
+		double timeLRU = runThreads(lru, threads, keys, ops);
+
+		Cache concLRU(keys/2, 0, Cache::EVICT_LRU);
+		concLRU.setGetEventEnabled(false);
+		double timeConcLRU = runThreads(concLRU, threads, keys, ops);
+
+		Cache concClock(keys/2, 0, Cache::EVICT_CLOCK);
+		concClock.setGetEventEnabled(false);
+		double timeConcClock = runThreads(concClock, threads, keys, ops);
+
+		std::cout << std::endl << threads << " thread(s), " << ops << " operations per thread:" << std::endl;
+		std::cout << "LRUCache:                      " << timeLRU << " [ms]" << std::endl;
+		std::cout << "ConcurrentLRUCache (LRU):      " << timeConcLRU << " [ms]" << std::endl;
+		std::cout << "ConcurrentLRUCache (CLOCK):    " << timeConcClock << " [ms]" << std::endl;
+	}
+}
+
+
+void ConcurrentLRUCacheTest::onUpdate(const void* pSender, const Poco::KeyValueArgs<int, int>& args)
+{
+	++updateCnt;
+}
+
+
+void ConcurrentLRUCacheTest::onAdd(const void* pSender, const Poco::KeyValueArgs<int, int>& args)
+{
+	++addCnt;
+}
+
+
+void ConcurrentLRUCacheTest::onRemove(const void* pSender, const int& args)
+{
+	++removeCnt;
+}
+
+
+void ConcurrentLRUCacheTest::onGet(const void* pSender, const int& args)
+{
+	++getCnt;
+}
+
+
+void ConcurrentLRUCacheTest::setUp()
+{
+}
+
+
+void ConcurrentLRUCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* ConcurrentLRUCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ConcurrentLRUCacheTest");
+
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testClear);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testCacheSize0);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testCacheSize1);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testCacheSizeN);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testDuplicateAdd);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testUpdate);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testClock);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testWeight);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testExpire);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testSegments);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testGetEvent);
+	CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, testConcurrentAccess);
+	//CppUnit_addTest(pSuite, ConcurrentLRUCacheTest, benchmarkConcurrentAccess);
+
+	return pSuite;
+}
@@ -0,0 +1,59 @@
+//
+// ConcurrentLRUCacheTest.h
+//
+// Tests for ConcurrentLRUCache
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+#ifndef ConcurrentLRUCacheTest_INCLUDED
+#define ConcurrentLRUCacheTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/KeyValueArgs.h"
+#include "CppUnit/TestCase.h"
+
+
+class ConcurrentLRUCacheTest: public CppUnit::TestCase
+{
+public:
+	ConcurrentLRUCacheTest(const std::string& name);
+	~ConcurrentLRUCacheTest();
+
+	void testClear();
+	void testCacheSize0();
+	void testCacheSize1();
+	void testCacheSizeN();
+	void testDuplicateAdd();
+	void testUpdate();
+	void testClock();
+	void testWeight();
+	void testExpire();
+	void testSegments();
+	void testGetEvent();
+	void testConcurrentAccess();
+	void benchmarkConcurrentAccess();
+
+	void setUp();
+	void tearDown();
+	static CppUnit::Test* suite();
+
+private:
+	void onUpdate(const void* pSender, const Poco::KeyValueArgs<int, int>& args);
+	void onAdd(const void* pSender, const Poco::KeyValueArgs<int, int>& args);
+	void onRemove(const void* pSender, const int& args);
+	void onGet(const void* pSender, const int& args);
+
+private:
+	int addCnt;
+	int updateCnt;
+	int removeCnt;
+	int getCnt;
+};
+
+
+#endif // ConcurrentLRUCacheTest_INCLUDED
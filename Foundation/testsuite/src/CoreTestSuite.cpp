@@ -17,6 +17,7 @@
 #include "ByteOrderTest.h"
 #include "StringTest.h"
 #include "StringTokenizerTest.h"
+#include "StringRefTest.h"
 #ifndef POCO_VXWORKS
 #include "FPETest.h"
 #endif
@@ -25,6 +26,7 @@
 #include "NumberFormatterTest.h"
 #include "NumberParserTest.h"
 #include "DynamicFactoryTest.h"
+#include "ArenaTest.h"
 #include "MemoryPoolTest.h"
 #include "AnyTest.h"
 #include "VarTest.h"
@@ -36,6 +38,7 @@
 #include "TypeListTest.h"
 #include "ObjectPoolTest.h"
 #include "ListMapTest.h"
+#include "ChecksumTest.h"
 
 
 CppUnit::Test* CoreTestSuite::suite()
@@ -50,6 +53,7 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(ByteOrderTest::suite());
 	pSuite->addTest(StringTest::suite());
 	pSuite->addTest(StringTokenizerTest::suite());
+	pSuite->addTest(StringRefTest::suite());
 #ifndef POCO_VXWORKS
 	pSuite->addTest(FPETest::suite());
 #endif
@@ -58,6 +62,7 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(NumberFormatterTest::suite());
 	pSuite->addTest(NumberParserTest::suite());
 	pSuite->addTest(DynamicFactoryTest::suite());
+	pSuite->addTest(ArenaTest::suite());
 	pSuite->addTest(MemoryPoolTest::suite());
 	pSuite->addTest(AnyTest::suite());
 	pSuite->addTest(VarTest::suite());
@@ -69,6 +74,7 @@ CppUnit::Test* CoreTestSuite::suite()
 	pSuite->addTest(TypeListTest::suite());
 	pSuite->addTest(ObjectPoolTest::suite());
 	pSuite->addTest(ListMapTest::suite());
+	pSuite->addTest(ChecksumTest::suite());
 
 	return pSuite;
 }
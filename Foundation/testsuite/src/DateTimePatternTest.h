@@ -0,0 +1,45 @@
+//
+// DateTimePatternTest.h
+//
+// Definition of the DateTimePatternTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef DateTimePatternTest_INCLUDED
+#define DateTimePatternTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class DateTimePatternTest: public CppUnit::TestCase
+{
+public:
+	DateTimePatternTest(const std::string& name);
+	~DateTimePatternTest();
+
+	void testFormat();
+	void testFormatStandard();
+	void testFormatTimestamp();
+	void testParse();
+	void testParseStandard();
+	void testParseInvalid();
+	void testFormatterCache();
+	void benchmarkFormatParse();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // DateTimePatternTest_INCLUDED
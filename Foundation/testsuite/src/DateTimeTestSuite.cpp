@@ -17,6 +17,7 @@
 #include "LocalDateTimeTest.h"
 #include "DateTimeFormatterTest.h"
 #include "DateTimeParserTest.h"
+#include "DateTimePatternTest.h"
 
 
 CppUnit::Test* DateTimeTestSuite::suite()
@@ -31,6 +32,7 @@ CppUnit::Test* DateTimeTestSuite::suite()
 	pSuite->addTest(LocalDateTimeTest::suite());
 	pSuite->addTest(DateTimeFormatterTest::suite());
 	pSuite->addTest(DateTimeParserTest::suite());
+	pSuite->addTest(DateTimePatternTest::suite());
 
 	return pSuite;
 }
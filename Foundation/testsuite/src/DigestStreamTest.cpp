@@ -81,6 +81,27 @@ void DigestStreamTest::testToFromHex()
 }
 
 
+void DigestStreamTest::testLargeWrite()
+{
+	std::string data;
+	for (int i = 0; i < 100000; ++i) data += static_cast<char>(i*31 + i/5);
+	MD5Engine engine;
+	engine.update(data);
+	std::string expected = DigestEngine::digestToHex(engine.digest());
+
+	// large writes bypass the buffer, mixed with buffered small writes
+	std::ostringstream ostr;
+	DigestOutputStream ds(engine, ostr);
+	ds.write(data.data(), 10);
+	ds.write(data.data() + 10, 50000);
+	ds << data[50010];
+	ds.write(data.data() + 50011, data.size() - 50011);
+	ds.flush();
+	assert (DigestEngine::digestToHex(engine.digest()) == expected);
+	assert (ostr.str() == data);
+}
+
+
 void DigestStreamTest::setUp()
 {
 }
@@ -99,6 +120,7 @@ CppUnit::Test* DigestStreamTest::suite()
 	CppUnit_addTest(pSuite, DigestStreamTest, testOutputStream1);
 	CppUnit_addTest(pSuite, DigestStreamTest, testOutputStream2);
 	CppUnit_addTest(pSuite, DigestStreamTest, testToFromHex);
+	CppUnit_addTest(pSuite, DigestStreamTest, testLargeWrite);
 	
 	return pSuite;
 }
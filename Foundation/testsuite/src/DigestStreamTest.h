@@ -28,6 +28,7 @@ public:
 	void testOutputStream1();
 	void testOutputStream2();
 	void testToFromHex();
+	void testLargeWrite();
 
 	void setUp();
 	void tearDown();
@@ -26,6 +26,7 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/DirectoryIterator.h"
 #include "Poco/Exception.h"
+#include "Poco/LineEndingConverter.h"
 #include <vector>
 
 
@@ -544,6 +545,101 @@ void FileChannelTest::testWrongPurgeOption()
 }
 
 
+void FileChannelTest::testGroupCommit()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "4 K");
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "200");
+		pChannel->setProperty(FileChannel::PROP_SYNC, "data");
+		assert (pChannel->getProperty(FileChannel::PROP_BUFFERSIZE) == "4096");
+		assert (pChannel->getProperty(FileChannel::PROP_FLUSHINTERVAL) == "200");
+		assert (pChannel->getProperty(FileChannel::PROP_SYNC) == "data");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		const File::FileSize lineSize = msg.getText().size() + std::string(Poco::LineEnding::NEWLINE_DEFAULT).size();
+		for (int i = 0; i < 10; ++i)
+		{
+			pChannel->log(msg);
+		}
+		File f(name);
+		assert (f.getSize() == 0);
+		Thread::sleep(1000);
+		assert (f.getSize() == 10*lineSize);
+
+		pChannel->log(msg);
+		pChannel->flush();
+		assert (f.getSize() == 11*lineSize);
+
+		// a full buffer is written immediately
+		pChannel->setProperty(FileChannel::PROP_FLUSHINTERVAL, "10000");
+		for (int i = 0; i < 200; ++i)
+		{
+			pChannel->log(msg);
+		}
+		assert (f.getSize() >= 4096);
+
+		pChannel->close();
+		assert (f.getSize() == 211*lineSize);
+
+		try
+		{
+			pChannel->setProperty(FileChannel::PROP_SYNC, "always");
+			fail("invalid sync mode - must throw");
+		}
+		catch (InvalidArgumentException&)
+		{
+		}
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
+void FileChannelTest::testGroupCommitRotate()
+{
+	std::string name = filename();
+	try
+	{
+		AutoPtr<FileChannel> pChannel = new FileChannel(name);
+		pChannel->setProperty(FileChannel::PROP_BUFFERSIZE, "100");
+		pChannel->setProperty(FileChannel::PROP_ROTATION, "1 K");
+		pChannel->setProperty(FileChannel::PROP_ARCHIVE, "number");
+		pChannel->setProperty(FileChannel::PROP_PURGECOUNT, "2");
+		pChannel->open();
+		Message msg("source", "This is a log file entry", Message::PRIO_INFORMATION);
+		for (int i = 0; i < 400; ++i)
+		{
+			pChannel->log(msg);
+		}
+		pChannel->close();
+
+		// all files have been rotated within a short time, so it
+		// is undefined which of them are purged
+		int archived = 0;
+		DirectoryIterator it(Path::current());
+		DirectoryIterator end;
+		for (; it != end; ++it)
+		{
+			if (it.name().find(name + ".") == 0) ++archived;
+		}
+		assert (archived == 2);
+	}
+	catch (...)
+	{
+		remove(name);
+		throw;
+	}
+	remove(name);
+}
+
+
 void FileChannelTest::setUp()
 {
 }
@@ -647,6 +743,8 @@ CppUnit::Test* FileChannelTest::suite()
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeAge);
 	CppUnit_addTest(pSuite, FileChannelTest, testPurgeCount);
 	CppUnit_addTest(pSuite, FileChannelTest, testWrongPurgeOption);
+	CppUnit_addTest(pSuite, FileChannelTest, testGroupCommit);
+	CppUnit_addTest(pSuite, FileChannelTest, testGroupCommitRotate);
 
 	return pSuite;
 }
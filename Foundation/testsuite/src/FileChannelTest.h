@@ -44,6 +44,8 @@ public:
 	void testPurgeAge();
 	void testPurgeCount();
 	void testWrongPurgeOption();
+	void testGroupCommit();
+	void testGroupCommitRotate();
 
 	void setUp();
 	void tearDown();
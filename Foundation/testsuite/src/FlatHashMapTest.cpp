@@ -0,0 +1,542 @@
+//
+// FlatHashMapTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "FlatHashMapTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/FlatHashMap.h"
+#include "Poco/FlatHashSet.h"
+#include "Poco/HashMap.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include <unordered_map>
+#include <map>
+#include <vector>
+#include <memory>
+#include <iostream>
+
+
+using Poco::FlatHashMap;
+using Poco::FlatHashSet;
+using Poco::HashMap;
+using Poco::StringHash;
+using Poco::Stopwatch;
+
+
+namespace
+{
+	template <class M, class K, class V>
+	void runBenchmark(const std::string& name, const std::vector<K>& keys, const std::vector<V>& values)
+	{
+		Stopwatch sw;
+		M map;
+		std::size_t n = keys.size();
+
+		sw.start();
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			map.insert(std::make_pair(keys[i], values[i]));
+		}
+		sw.stop();
+		double insertTime = double(sw.elapsed())/Stopwatch::resolution();
+
+		sw.restart();
+		std::size_t found = 0;
+		for (int r = 0; r < 4; ++r)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				if (map.find(keys[i]) != map.end()) ++found;
+			}
+		}
+		sw.stop();
+		double findTime = double(sw.elapsed())/Stopwatch::resolution();
+		poco_assert (found == 4*n);
+
+		sw.restart();
+		for (std::size_t i = 0; i < n; i += 2)
+		{
+			map.erase(keys[i]);
+		}
+		for (std::size_t i = 0; i < n; i += 2)
+		{
+			map.insert(std::make_pair(keys[i], values[i]));
+			map.erase(keys[i + 1 < n ? i + 1 : i]);
+		}
+		sw.stop();
+		double mixedTime = double(sw.elapsed())/Stopwatch::resolution();
+
+		std::cout << name << ": insert " << insertTime << "s, find " << findTime << "s, erase/insert " << mixedTime << "s" << std::endl;
+	}
+}
+
+
+FlatHashMapTest::FlatHashMapTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+FlatHashMapTest::~FlatHashMapTest()
+{
+}
+
+
+void FlatHashMapTest::testInsert()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	assert (hm.empty());
+	assert (hm.capacity() == 0);
+	assert (hm.find(42) == hm.end());
+
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntMap::Iterator, bool> res = hm.insert(IntMap::ValueType(i, i*2));
+		assert (res.first->first == i);
+		assert (res.first->second == i*2);
+		assert (res.second);
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->first == i);
+		assert (it->second == i*2);
+		assert (hm.count(i) == 1);
+		assert (hm.size() == i + 1);
+	}
+
+	assert (!hm.empty());
+	assert (hm.load_factor() <= 0.875f);
+
+	for (int i = 0; i < N; ++i)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->first == i);
+		assert (it->second == i*2);
+	}
+
+	for (int i = 0; i < N; ++i)
+	{
+		std::pair<IntMap::Iterator, bool> res = hm.insert(IntMap::ValueType(i, 0));
+		assert (res.first->first == i);
+		assert (res.first->second == i*2);
+		assert (!res.second);
+	}
+	assert (hm.size() == N);
+}
+
+
+void FlatHashMapTest::testErase()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+	assert (hm.size() == N);
+
+	for (int i = 0; i < N; i += 2)
+	{
+		assert (hm.erase(i) == 1);
+		IntMap::Iterator it = hm.find(i);
+		assert (it == hm.end());
+	}
+	assert (hm.size() == N/2);
+	assert (hm.erase(0) == 0);
+
+	for (int i = 0; i < N; i += 2)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it == hm.end());
+	}
+
+	for (int i = 1; i < N; i += 2)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->first == i);
+	}
+
+	for (int i = 0; i < N; i += 2)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+
+	for (int i = 0; i < N; ++i)
+	{
+		IntMap::Iterator it = hm.find(i);
+		assert (it != hm.end());
+		assert (it->first == i);
+		assert (it->second == i*2);
+	}
+
+	IntMap::Iterator it = hm.begin();
+	while (it != hm.end())
+	{
+		if (it->first % 3 == 0)
+			it = hm.erase(it);
+		else
+			++it;
+	}
+	assert (hm.size() == N - (N + 2)/3);
+	for (int i = 0; i < N; ++i)
+	{
+		assert (hm.count(i) == (i % 3 == 0 ? 0 : 1));
+	}
+
+	hm.clear();
+	assert (hm.empty());
+	assert (hm.find(1) == hm.end());
+	assert (hm.capacity() > 0);
+}
+
+
+void FlatHashMapTest::testIterator()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+
+	std::map<int, int> values;
+	IntMap::Iterator it; // do not initialize here to test proper behavior of uninitialized iterators
+	it = hm.begin();
+	while (it != hm.end())
+	{
+		assert (values.find(it->first) == values.end());
+		values[it->first] = it->second;
+		it->second = -it->second;
+		++it;
+	}
+
+	assert (values.size() == N);
+	assert (hm[10] == -20);
+}
+
+
+void FlatHashMapTest::testConstIterator()
+{
+	const int N = 1000;
+
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	for (int i = 0; i < N; ++i)
+	{
+		hm.insert(IntMap::ValueType(i, i*2));
+	}
+
+	std::map<int, int> values;
+	IntMap::ConstIterator it = hm.begin();
+	while (it != hm.end())
+	{
+		assert (values.find(it->first) == values.end());
+		values[it->first] = it->second;
+		++it;
+	}
+
+	assert (values.size() == N);
+
+	const IntMap& chm = hm;
+	int sum = 0;
+	for (IntMap::ConstIterator cit = chm.begin(); cit != chm.end(); cit++)
+	{
+		sum += cit->first;
+	}
+	assert (sum == N*(N - 1)/2);
+}
+
+
+void FlatHashMapTest::testIndex()
+{
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+
+	hm[1] = 2;
+	hm[2] = 4;
+	hm[3] = 6;
+
+	assert (hm.size() == 3);
+	assert (hm[1] == 2);
+	assert (hm[2] == 4);
+	assert (hm[3] == 6);
+
+	try
+	{
+		const IntMap& im = hm;
+		(void) im[4];
+		fail("no such key - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+
+	try
+	{
+		hm.at(4);
+		fail("no such key - must throw");
+	}
+	catch (Poco::NotFoundException&)
+	{
+	}
+	assert (hm.size() == 3);
+}
+
+
+void FlatHashMapTest::testEmplace()
+{
+	typedef FlatHashMap<int, std::unique_ptr<int> > PtrMap;
+	PtrMap hm;
+
+	std::pair<PtrMap::Iterator, bool> res = hm.try_emplace(1, new int(10));
+	assert (res.second);
+	assert (*res.first->second == 10);
+
+	std::unique_ptr<int> p(new int(20));
+	res = hm.try_emplace(1, std::move(p));
+	assert (!res.second);
+	assert (p.get() != 0); // not moved
+	assert (*hm.at(1) == 10);
+
+	res = hm.emplace(2, std::move(p));
+	assert (res.second);
+	assert (*hm.at(2) == 20);
+
+	// moves values when growing
+	for (int i = 3; i < 1000; ++i)
+	{
+		hm.try_emplace(i, new int(i*10));
+	}
+	for (int i = 1; i < 1000; ++i)
+	{
+		assert (*hm.at(i) == i*10);
+	}
+
+	FlatHashMap<int, std::string> sm;
+	sm.insert_or_assign(1, "one");
+	sm.insert_or_assign(1, "uno");
+	assert (sm.size() == 1);
+	assert (sm[1] == "uno");
+}
+
+
+void FlatHashMapTest::testStringKeys()
+{
+	typedef FlatHashMap<std::string, int> StringMap;
+	StringMap hm;
+	for (int i = 0; i < 1000; ++i)
+	{
+		hm[Poco::NumberFormatter::format(i)] = i;
+	}
+	assert (hm.size() == 1000);
+	for (int i = 0; i < 1000; ++i)
+	{
+		assert (hm[Poco::NumberFormatter::format(i)] == i);
+	}
+	assert (hm.find("1000") == hm.end());
+}
+
+
+void FlatHashMapTest::testHeterogeneousLookup()
+{
+	typedef FlatHashMap<std::string, int, StringHash, std::equal_to<> > StringMap;
+	StringMap hm;
+	hm["one"] = 1;
+	hm["two"] = 2;
+	hm["three"] = 3;
+
+	const char* key = "two";
+	StringMap::Iterator it = hm.find(key);
+	assert (it != hm.end());
+	assert (it->second == 2);
+	assert (hm.count("three") == 1);
+	assert (hm.count("four") == 0);
+	assert (hm.find(std::string("one"))->second == 1);
+
+	assert (hm.erase("one") == 1);
+	assert (hm.size() == 2);
+
+	typedef FlatHashSet<std::string, StringHash, std::equal_to<> > StringSet;
+	StringSet hs;
+	hs.insert("foo");
+	assert (hs.count("foo") == 1);
+	assert (hs.count("bar") == 0);
+
+	StringHash h;
+	assert (h("foo") == h(std::string("foo")));
+	assert (h("foo") == Poco::hash(std::string("foo")));
+}
+
+
+void FlatHashMapTest::testCopyMove()
+{
+	typedef FlatHashMap<int, std::string> Map;
+	Map hm;
+	for (int i = 0; i < 100; ++i)
+	{
+		hm[i] = Poco::NumberFormatter::format(i);
+	}
+
+	Map copy(hm);
+	assert (copy.size() == 100);
+	assert (copy[42] == "42");
+	copy[42] = "x";
+	assert (hm[42] == "42");
+
+	Map moved(std::move(copy));
+	assert (moved.size() == 100);
+	assert (moved[42] == "x");
+	assert (copy.empty());
+	assert (copy.find(42) == copy.end());
+
+	copy = hm;
+	assert (copy.size() == 100);
+	assert (copy[99] == "99");
+
+	Map assigned;
+	assigned = std::move(moved);
+	assert (assigned[42] == "x");
+
+	assigned.swap(hm);
+	assert (hm[42] == "x");
+	assert (assigned[42] == "42");
+}
+
+
+void FlatHashMapTest::testEraseInsertCycle()
+{
+	// Repeated erasing and inserting leaves deleted slots,
+	// which must not lead to endless probing or unbounded growth.
+	typedef FlatHashMap<int, int> IntMap;
+	IntMap hm;
+	hm.reserve(100);
+	std::size_t capacity = hm.capacity();
+	for (int i = 0; i < 100000; ++i)
+	{
+		hm[i] = i;
+		if (i >= 50) assert (hm.erase(i - 50) == 1);
+		assert (hm.size() <= 51);
+	}
+	assert (hm.size() == 50);
+	assert (hm.capacity() == capacity);
+	for (int i = 100000 - 50; i < 100000; ++i)
+	{
+		assert (hm.at(i) == i);
+	}
+}
+
+
+void FlatHashMapTest::testSet()
+{
+	typedef FlatHashSet<int> IntSet;
+	IntSet hs;
+	for (int i = 0; i < 1000; ++i)
+	{
+		std::pair<IntSet::Iterator, bool> res = hs.insert(i);
+		assert (res.second);
+		assert (*res.first == i);
+	}
+	assert (!hs.insert(10).second);
+	assert (hs.size() == 1000);
+	for (int i = 0; i < 1000; ++i)
+	{
+		assert (hs.count(i) == 1);
+	}
+	assert (hs.count(1000) == 0);
+	assert (hs.erase(10) == 1);
+	assert (hs.find(10) == hs.end());
+
+	int sum = 0;
+	for (IntSet::ConstIterator it = hs.begin(); it != hs.end(); ++it)
+	{
+		sum += *it;
+	}
+	assert (sum == 999*1000/2 - 10);
+}
+
+
+void FlatHashMapTest::benchmarkIntMap()
+{
+	const int N = 1000000;
+	std::vector<int> keys;
+	std::vector<int> values;
+	for (int i = 0; i < N; ++i)
+	{
+		keys.push_back(i*37);
+		values.push_back(i);
+	}
+
+	std::cout << std::endl << N << " int keys:" << std::endl;
+	runBenchmark<HashMap<int, int> >("Poco::HashMap     ", keys, values);
+	runBenchmark<std::unordered_map<int, int> >("std::unordered_map", keys, values);
+	runBenchmark<FlatHashMap<int, int> >("Poco::FlatHashMap ", keys, values);
+}
+
+
+void FlatHashMapTest::benchmarkStringMap()
+{
+	const int N = 1000000;
+	std::vector<std::string> keys;
+	std::vector<int> values;
+	for (int i = 0; i < N; ++i)
+	{
+		keys.push_back("key-" + Poco::NumberFormatter::format(i*37));
+		values.push_back(i);
+	}
+
+	std::cout << std::endl << N << " string keys:" << std::endl;
+	runBenchmark<HashMap<std::string, int> >("Poco::HashMap     ", keys, values);
+	runBenchmark<std::unordered_map<std::string, int> >("std::unordered_map", keys, values);
+	runBenchmark<FlatHashMap<std::string, int, StringHash> >("Poco::FlatHashMap ", keys, values);
+}
+
+
+void FlatHashMapTest::setUp()
+{
+}
+
+
+void FlatHashMapTest::tearDown()
+{
+}
+
+
+CppUnit::Test* FlatHashMapTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("FlatHashMapTest");
+
+	CppUnit_addTest(pSuite, FlatHashMapTest, testInsert);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testErase);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testIterator);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testConstIterator);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testIndex);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testEmplace);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testStringKeys);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testHeterogeneousLookup);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testCopyMove);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testEraseInsertCycle);
+	CppUnit_addTest(pSuite, FlatHashMapTest, testSet);
+	//CppUnit_addTest(pSuite, FlatHashMapTest, benchmarkIntMap);
+	//CppUnit_addTest(pSuite, FlatHashMapTest, benchmarkStringMap);
+
+	return pSuite;
+}
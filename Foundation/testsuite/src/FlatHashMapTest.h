@@ -0,0 +1,50 @@
+//
+// FlatHashMapTest.h
+//
+// Definition of the FlatHashMapTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef FlatHashMapTest_INCLUDED
+#define FlatHashMapTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class FlatHashMapTest: public CppUnit::TestCase
+{
+public:
+	FlatHashMapTest(const std::string& name);
+	~FlatHashMapTest();
+
+	void testInsert();
+	void testErase();
+	void testIterator();
+	void testConstIterator();
+	void testIndex();
+	void testEmplace();
+	void testStringKeys();
+	void testHeterogeneousLookup();
+	void testCopyMove();
+	void testEraseInsertCycle();
+	void testSet();
+	void benchmarkIntMap();
+	void benchmarkStringMap();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // FlatHashMapTest_INCLUDED
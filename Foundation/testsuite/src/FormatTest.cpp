@@ -14,10 +14,17 @@
 #include "Poco/Any.h"
 #include "Poco/Format.h"
 #include "Poco/Exception.h"
+#include "Poco/Stopwatch.h"
+#include <sstream>
+#include <iostream>
 
 
 using Poco::format;
+using Poco::formatTo;
+using Poco::FormatString;
+using Poco::Any;
 using Poco::BadCastException;
+using Poco::InvalidArgumentException;
 using Poco::Int64;
 using Poco::UInt64;
 
@@ -353,6 +360,148 @@ void FormatTest::testIndex()
 }
 
 
+void FormatTest::testCString()
+{
+	std::string s(format("%s", "foo"));
+	assert (s == "foo");
+
+	const char* foo = "foo";
+	s = format("%5s|%-5s|", foo, foo);
+	assert (s == "  foo|foo  |");
+
+	const char* null = 0;
+	s = format("%s", null);
+	assert (s == "[ERRFMT]");
+}
+
+
+void FormatTest::testAny()
+{
+	Any i(42);
+	Any str(std::string("foo"));
+	std::string s(format("%d %s", i, str));
+	assert (s == "42 foo");
+
+	s = format("%s", i);
+	assert (s == "[ERRFMT]");
+
+	std::vector<Any> values;
+	values.push_back(42);
+	values.push_back(std::string("foo"));
+	values.push_back(1.5);
+	s.clear();
+	format(s, "%[1]s %[0]d %[2].1f", values);
+	assert (s == "foo 42 1.5");
+}
+
+
+void FormatTest::testFormatTo()
+{
+	char buffer[16];
+	std::size_t n = formatTo(buffer, sizeof(buffer), "%d-%s", 42, "foo");
+	assert (n == 6);
+	assert (std::string(buffer, n) == "42-foo");
+
+	n = formatTo(buffer, 4, "%d-%s", 42, "foo");
+	assert (n == 6);
+	assert (std::string(buffer, 4) == "42-f");
+
+	n = formatTo(buffer, 0, std::string("%05d"), 42);
+	assert (n == 5);
+}
+
+
+void FormatTest::testFormatString()
+{
+	FormatString fmt("%s: %5d items, %.2f ms");
+	assert (fmt.argumentCount() == 3);
+	std::string s = fmt.format("foo", 42, 1.5);
+	assert (s == "foo:    42 items, 1.50 ms");
+	s = fmt.format(std::string("bar"), 7, 0.25);
+	assert (s == "bar:     7 items, 0.25 ms");
+
+	char buffer[64];
+	std::size_t n = fmt.formatTo(buffer, sizeof(buffer), "baz", 1, 2.0);
+	assert (std::string(buffer, n) == "baz:     1 items, 2.00 ms");
+
+	FormatString indexed("%%%d%%%d%%%[0]d");
+	assert (indexed.argumentCount() == 2);
+	s = indexed.format(1, 2);
+	assert (s == "%1%2%1");
+
+	FormatString missing("a%db%dc%[0]d");
+	s = missing.format(1);
+	assert (s == format("a%db%dc%[0]d", 1));
+	assert (s == "a1bdc1");
+
+	FormatString outOfRange("%[2]d");
+	try
+	{
+		outOfRange.format(1);
+		fail("index out of range - must throw");
+	}
+	catch (InvalidArgumentException&)
+	{
+	}
+}
+
+
+void FormatTest::benchmarkFormat()
+{
+	const int n = 1000000;
+	const std::string name("items");
+	std::string s;
+	std::size_t length = 0;
+	Poco::Stopwatch sw;
+
+	sw.start();
+	for (int i = 0; i < n; ++i)
+	{
+		std::ostringstream str;
+		str << name << ": " << i << " in " << 1.5*i << " ms";
+		length += str.str().size();
+	}
+	sw.stop();
+	std::cout << "std::ostringstream: " << sw.elapsed()/1000 << " ms" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < n; ++i)
+	{
+		s.clear();
+		format(s, "%s: %d in %.1f ms", name, i, 1.5*i);
+		length += s.size();
+	}
+	sw.stop();
+	std::cout << "format(): " << sw.elapsed()/1000 << " ms" << std::endl;
+
+	std::vector<Any> values(3);
+	sw.restart();
+	for (int i = 0; i < n; ++i)
+	{
+		values[0] = name;
+		values[1] = i;
+		values[2] = 1.5*i;
+		s.clear();
+		format(s, "%s: %d in %.1f ms", values);
+		length += s.size();
+	}
+	sw.stop();
+	std::cout << "format() with Any values: " << sw.elapsed()/1000 << " ms" << std::endl;
+
+	const FormatString fmt("%s: %d in %.1f ms");
+	sw.restart();
+	for (int i = 0; i < n; ++i)
+	{
+		s.clear();
+		fmt.format(s, name, i, 1.5*i);
+		length += s.size();
+	}
+	sw.stop();
+	std::cout << "FormatString::format(): " << sw.elapsed()/1000 << " ms" << std::endl;
+	assert (length > 0);
+}
+
+
 void FormatTest::setUp()
 {
 }
@@ -376,6 +525,11 @@ CppUnit::Test* FormatTest::suite()
 	CppUnit_addTest(pSuite, FormatTest, testString);
 	CppUnit_addTest(pSuite, FormatTest, testMultiple);
 	CppUnit_addTest(pSuite, FormatTest, testIndex);
+	CppUnit_addTest(pSuite, FormatTest, testCString);
+	CppUnit_addTest(pSuite, FormatTest, testAny);
+	CppUnit_addTest(pSuite, FormatTest, testFormatTo);
+	CppUnit_addTest(pSuite, FormatTest, testFormatString);
+	//CppUnit_addTest(pSuite, FormatTest, benchmarkFormat);
 
 	return pSuite;
 }
@@ -30,6 +30,11 @@ public:
 	void testString();
 	void testMultiple();
 	void testIndex();
+	void testCString();
+	void testAny();
+	void testFormatTo();
+	void testFormatString();
+	void benchmarkFormat();
 
 	void setUp();
 	void tearDown();
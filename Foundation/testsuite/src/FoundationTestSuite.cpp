@@ -28,6 +28,7 @@
 #include "EventTestSuite.h"
 #include "CacheTestSuite.h"
 #include "HashingTestSuite.h"
+#include "MetricsTestSuite.h"
 
 
 CppUnit::Test* FoundationTestSuite::suite()
@@ -53,6 +54,7 @@ CppUnit::Test* FoundationTestSuite::suite()
 	pSuite->addTest(EventTestSuite::suite());
 	pSuite->addTest(CacheTestSuite::suite());
 	pSuite->addTest(HashingTestSuite::suite());
+	pSuite->addTest(MetricsTestSuite::suite());
 
 	return pSuite;
 }
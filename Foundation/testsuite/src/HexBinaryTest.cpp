@@ -13,15 +13,42 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/HexBinaryEncoder.h"
 #include "Poco/HexBinaryDecoder.h"
+#include "Poco/HexBinary.h"
+#include "Poco/Stopwatch.h"
 #include "Poco/Exception.h"
 #include <sstream>
+#include <iostream>
+#include <vector>
 
 
 using Poco::HexBinaryEncoder;
 using Poco::HexBinaryDecoder;
+using Poco::HexBinary;
 using Poco::DataFormatException;
 
 
+namespace
+{
+	std::string testData(std::size_t length)
+	{
+		std::string data;
+		for (std::size_t i = 0; i < length; ++i) data += static_cast<char>(i*37 + i/7);
+		return data;
+	}
+
+	std::string encodeByChar(const std::string& data, bool uppercase, int lineLength)
+	{
+		std::ostringstream str;
+		HexBinaryEncoder encoder(str);
+		encoder.rdbuf()->setUppercase(uppercase);
+		encoder.rdbuf()->setLineLength(lineLength);
+		for (std::string::const_iterator it = data.begin(); it != data.end(); ++it) encoder.put(*it);
+		encoder.close();
+		return str.str();
+	}
+}
+
+
 HexBinaryTest::HexBinaryTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -183,6 +210,123 @@ void HexBinaryTest::testEncodeDecode()
 }
 
 
+void HexBinaryTest::testBuffer()
+{
+	for (int uppercase = 0; uppercase < 2; ++uppercase)
+	{
+		for (std::size_t length = 0; length < 300; ++length)
+		{
+			std::string data = testData(length);
+			std::string encoded = HexBinary::encode(data, uppercase != 0);
+			assert (encoded == encodeByChar(data, uppercase != 0, 0));
+			assert (HexBinary::decode(encoded) == data);
+		}
+	}
+
+	assert (HexBinary::decode(std::string("00fF7fA0aB0123456789abcdefABCDEF")) == std::string("\x00\xff\x7f\xa0\xab\x01\x23\x45\x67\x89\xab\xcd\xef\xab\xcd\xef", 16));
+
+	// an invalid character at every position, to hit both the vectorized and the scalar code
+	std::string encoded = HexBinary::encode(testData(50));
+	const char invalid[] = { 'g', 'G', '/', ':', '@', '`', ' ', '\x80' };
+	for (std::size_t i = 0; i < encoded.size(); ++i)
+	{
+		for (std::size_t k = 0; k < sizeof(invalid); ++k)
+		{
+			std::string s(encoded);
+			s[i] = invalid[k];
+			try
+			{
+				HexBinary::decode(s);
+				fail("invalid character - must throw");
+			}
+			catch (DataFormatException&)
+			{
+			}
+		}
+	}
+
+	try
+	{
+		HexBinary::decode(std::string("abc"));
+		fail("odd length - must throw");
+	}
+	catch (DataFormatException&)
+	{
+	}
+}
+
+
+void HexBinaryTest::testStreamBlocks()
+{
+	std::string data = testData(20000);
+	const int lineLengths[] = { 0, 1, 2, 7, 72, 1000 };
+	for (int l = 0; l < 6; ++l)
+	{
+		std::string expected = encodeByChar(data, false, lineLengths[l]);
+
+		std::ostringstream ostr;
+		HexBinaryEncoder encoder(ostr);
+		encoder.rdbuf()->setLineLength(lineLengths[l]);
+		std::size_t pos = 0;
+		std::size_t block = 1;
+		while (pos < data.size())
+		{
+			std::size_t n = std::min(block, data.size() - pos);
+			encoder.write(data.data() + pos, n);
+			pos += n;
+			block = block*3 + 1;
+		}
+		encoder.close();
+		assert (ostr.str() == expected);
+
+		std::istringstream istr(expected);
+		HexBinaryDecoder decoder(istr);
+		std::string decoded;
+		std::vector<char> buffer(10000);
+		block = 1;
+		while (decoder.good())
+		{
+			decoder.read(&buffer[0], std::min<std::size_t>(block, buffer.size()));
+			decoded.append(&buffer[0], static_cast<std::size_t>(decoder.gcount()));
+			if (decoder.peek() != -1) decoded += static_cast<char>(decoder.get());
+			block = block*2 + 1;
+		}
+		assert (decoded == data);
+	}
+
+	std::istringstream istr("48656c6c6f!");
+	HexBinaryDecoder decoder(istr);
+	char buffer[8];
+	decoder.read(buffer, 4);
+	assert (std::string(buffer, 4) == "Hell");
+	assert (istr.tellg() == 8);
+}
+
+
+void HexBinaryTest::benchmarkCodec()
+{
+	const std::size_t size = 1024*1024;
+	const int rounds = 200;
+	std::string data = testData(size);
+	std::string encoded(2*size, '\0');
+	std::string decoded(size, '\0');
+
+	Poco::Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < rounds; ++i) HexBinary::encode(data.data(), size, &encoded[0]);
+	sw.stop();
+	double encodeRate = double(size)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e9;
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i) HexBinary::decode(encoded.data(), encoded.size(), &decoded[0]);
+	sw.stop();
+	double decodeRate = double(size)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e9;
+	assert (decoded == data);
+
+	std::cout << std::endl << "HexBinary encode: " << encodeRate << " GB/s, decode: " << decodeRate << " GB/s" << std::endl;
+}
+
+
 void HexBinaryTest::setUp()
 {
 }
@@ -200,6 +344,9 @@ CppUnit::Test* HexBinaryTest::suite()
 	CppUnit_addTest(pSuite, HexBinaryTest, testEncoder);
 	CppUnit_addTest(pSuite, HexBinaryTest, testDecoder);
 	CppUnit_addTest(pSuite, HexBinaryTest, testEncodeDecode);
+	CppUnit_addTest(pSuite, HexBinaryTest, testBuffer);
+	CppUnit_addTest(pSuite, HexBinaryTest, testStreamBlocks);
+	//CppUnit_addTest(pSuite, HexBinaryTest, benchmarkCodec);
 
 	return pSuite;
 }
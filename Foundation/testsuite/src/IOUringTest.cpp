@@ -0,0 +1,413 @@
+//
+// IOUringTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "IOUringTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <cstring>
+
+
+using Poco::IOUring;
+using Poco::TemporaryFile;
+using Poco::File;
+using Poco::Timespan;
+
+
+namespace
+{
+	struct Result
+		/// Stores the result of an operation.
+	{
+		Result(): done(false), result(0)
+		{
+		}
+
+		void operator () (int r)
+		{
+			done = true;
+			result = r;
+		}
+
+		bool done;
+		int result;
+	};
+}
+
+
+IOUringTest::IOUringTest(const std::string& name): CppUnit::TestCase(name), _fd(-1)
+{
+}
+
+
+IOUringTest::~IOUringTest()
+{
+}
+
+
+void IOUringTest::testMode()
+{
+	IOUring ring;
+	assert (ring.usesRing() == IOUring::isAvailable());
+	assert (ring.pending() == 0);
+
+	IOUring fallback(16, IOUring::MODE_FALLBACK);
+	assert (!fallback.usesRing());
+	assert (fallback.wait() == 0);
+	assert (fallback.complete() == 0);
+}
+
+
+void IOUringTest::testReadWrite()
+{
+	doReadWrite(IOUring::MODE_AUTO);
+}
+
+
+void IOUringTest::testReadWriteFallback()
+{
+	doReadWrite(IOUring::MODE_FALLBACK);
+}
+
+
+void IOUringTest::testBatching()
+{
+	doBatching(IOUring::MODE_AUTO);
+}
+
+
+void IOUringTest::testBatchingFallback()
+{
+	doBatching(IOUring::MODE_FALLBACK);
+}
+
+
+void IOUringTest::testRegistered()
+{
+	doRegistered(IOUring::MODE_AUTO);
+}
+
+
+void IOUringTest::testRegisteredFallback()
+{
+	doRegistered(IOUring::MODE_FALLBACK);
+}
+
+
+void IOUringTest::testSocket()
+{
+	doSocket(IOUring::MODE_AUTO);
+}
+
+
+void IOUringTest::testSocketFallback()
+{
+	doSocket(IOUring::MODE_FALLBACK);
+}
+
+
+void IOUringTest::testTimeout()
+{
+	doTimeout(IOUring::MODE_AUTO);
+}
+
+
+void IOUringTest::testTimeoutFallback()
+{
+	doTimeout(IOUring::MODE_FALLBACK);
+}
+
+
+void IOUringTest::testErrors()
+{
+	doErrors(IOUring::MODE_AUTO);
+}
+
+
+void IOUringTest::testErrorsFallback()
+{
+	doErrors(IOUring::MODE_FALLBACK);
+}
+
+
+void IOUringTest::doReadWrite(IOUring::Mode mode)
+{
+	IOUring ring(16, mode);
+
+	const std::string hello("Hello, ");
+	const std::string world("world!");
+	Result r1, r2, r3;
+	ring.write(_fd, hello.data(), hello.size(), 0, std::ref(r1));
+	ring.write(_fd, world.data(), world.size(), hello.size(), std::ref(r2));
+	assert (ring.pending() == 2);
+	assert (ring.wait(2) == 2);
+	assert (r1.done && r1.result == static_cast<int>(hello.size()));
+	assert (r2.done && r2.result == static_cast<int>(world.size()));
+	assert (ring.pending() == 0);
+
+	ring.fsync(_fd, true, std::ref(r3));
+	assert (ring.wait() == 1);
+	assert (r3.done && r3.result == 0);
+
+	char buffer[64];
+	Result r4;
+	ring.read(_fd, buffer, sizeof(buffer), 0, std::ref(r4));
+	assert (ring.submit() == 1);
+	ring.wait();
+	assert (r4.done && r4.result == 13);
+	assert (std::string(buffer, r4.result) == "Hello, world!");
+
+	Result r5;
+	ring.read(_fd, buffer, sizeof(buffer), 100, std::ref(r5));
+	ring.wait();
+	assert (r5.done && r5.result == 0);
+
+	// a callback queueing the next operation
+	std::string chained;
+	int completions = 0;
+	ring.read(_fd, buffer, 5, 0, [&](int n)
+	{
+		chained.assign(buffer, n);
+		++completions;
+		ring.read(_fd, buffer, 5, 7, [&](int m)
+		{
+			chained.append(buffer, m);
+			++completions;
+		});
+	});
+	while (ring.pending() > 0) ring.wait();
+	assert (completions == 2);
+	assert (chained == "Helloworld");
+}
+
+
+void IOUringTest::doBatching(IOUring::Mode mode)
+{
+	IOUring ring(4, mode);
+
+	// more operations than the ring has entries
+	const int count = 100;
+	std::string data;
+	for (int i = 0; i < count; ++i) data += static_cast<char>('A' + i % 26);
+
+	int written = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		ring.write(_fd, data.data() + i, 1, i, [&written](int n)
+		{
+			written += n;
+		});
+	}
+	assert (ring.pending() == count);
+	while (ring.pending() > 0) ring.wait();
+	assert (written == count);
+
+	std::string buffer(count, '\0');
+	int read = 0;
+	ring.read(_fd, &buffer[0], count, 0, [&read](int n)
+	{
+		read = n;
+	});
+	ring.wait();
+	assert (read == count);
+	assert (buffer == data);
+}
+
+
+void IOUringTest::doRegistered(IOUring::Mode mode)
+{
+	IOUring ring(16, mode);
+
+	std::vector<char> buffer(4096);
+	std::vector<IOUring::Buffer> buffers(1);
+	buffers[0].data = &buffer[0];
+	buffers[0].size = buffer.size();
+	ring.registerBuffers(buffers);
+
+	std::vector<int> files(1, _fd);
+	ring.registerFiles(files);
+
+	std::memcpy(&buffer[0], "registered", 10);
+	Result r1;
+	ring.writeFixed(0, &buffer[0], 10, 0, 0, std::ref(r1), IOUring::OPT_FIXED_FILE);
+	ring.wait();
+	assert (r1.done && r1.result == 10);
+
+	Result r2;
+	ring.readFixed(0, &buffer[100], 10, 0, 0, std::ref(r2), IOUring::OPT_FIXED_FILE);
+	ring.wait();
+	assert (r2.done && r2.result == 10);
+	assert (std::string(&buffer[100], 10) == "registered");
+
+	Result r3;
+	ring.read(_fd, &buffer[200], 10, 0, std::ref(r3));
+	ring.wait();
+	assert (r3.done && r3.result == 10);
+	assert (std::string(&buffer[200], 10) == "registered");
+
+	try
+	{
+		ring.readFixed(_fd, &buffer[4090], 10, 0, 0, std::ref(r3));
+		fail("buffer outside registered buffer - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		ring.readFixed(_fd, &buffer[0], 10, 0, 1, std::ref(r3));
+		fail("invalid buffer index - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		ring.read(1, &buffer[0], 10, 0, std::ref(r3), IOUring::OPT_FIXED_FILE);
+		fail("invalid file index - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	assert (ring.pending() == 0);
+
+	ring.unregisterFiles();
+	ring.unregisterBuffers();
+}
+
+
+void IOUringTest::doSocket(IOUring::Mode mode)
+{
+	int fds[2];
+	assert (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+	IOUring ring(16, mode);
+
+	char buffer[64];
+	Result r1, r2, r3;
+	ring.pollAdd(fds[1], IOUring::POLL_READ, std::ref(r1));
+	ring.send(fds[0], "ping", 4, 0, std::ref(r2));
+	while (ring.pending() > 0) ring.wait();
+	assert (r1.done && (r1.result & IOUring::POLL_READ));
+	assert (r2.done && r2.result == 4);
+
+	ring.receive(fds[1], buffer, sizeof(buffer), 0, std::ref(r3));
+	ring.wait();
+	assert (r3.done && r3.result == 4);
+	assert (std::string(buffer, 4) == "ping");
+
+	Result r4;
+	ring.pollAdd(fds[0], IOUring::POLL_WRITE, std::ref(r4));
+	ring.wait();
+	assert (r4.done && (r4.result & IOUring::POLL_WRITE));
+
+	::close(fds[0]);
+	Result r5;
+	ring.receive(fds[1], buffer, sizeof(buffer), 0, std::ref(r5));
+	ring.wait();
+	assert (r5.done && r5.result == 0);
+	::close(fds[1]);
+}
+
+
+void IOUringTest::doTimeout(IOUring::Mode mode)
+{
+	int fds[2];
+	assert (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+	IOUring ring(16, mode);
+	assert (ring.wait(Timespan(0, 10000)) == 0);
+
+	char buffer[64];
+	Result r;
+	ring.receive(fds[1], buffer, sizeof(buffer), 0, std::ref(r));
+	assert (ring.wait(Timespan(0, 50000)) == 0);
+	assert (!r.done);
+	assert (ring.complete() == 0);
+	assert (ring.pending() == 1);
+
+	assert (::send(fds[0], "pong", 4, 0) == 4);
+	assert (ring.wait(Timespan(5, 0)) == 1);
+	assert (r.done && r.result == 4);
+	assert (ring.pending() == 0);
+
+	::close(fds[0]);
+	::close(fds[1]);
+}
+
+
+void IOUringTest::doErrors(IOUring::Mode mode)
+{
+	IOUring ring(16, mode);
+
+	char buffer[16];
+	Result r1, r2;
+	ring.read(-1, buffer, sizeof(buffer), 0, std::ref(r1));
+	ring.receive(_fd, buffer, sizeof(buffer), 0, std::ref(r2));
+	while (ring.pending() > 0) ring.wait();
+	assert (r1.done && r1.result == -EBADF);
+	assert (r2.done && r2.result == -ENOTSOCK);
+
+	// exceptions thrown by callbacks go to the ErrorHandler
+	ring.read(_fd, buffer, sizeof(buffer), 0, [](int)
+	{
+		throw Poco::IOException("callback");
+	});
+	assert (ring.wait() == 1);
+	assert (ring.pending() == 0);
+}
+
+
+void IOUringTest::setUp()
+{
+	_path = TemporaryFile::tempName();
+	_fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+	poco_assert (_fd != -1);
+}
+
+
+void IOUringTest::tearDown()
+{
+	if (_fd != -1) ::close(_fd);
+	_fd = -1;
+	File f(_path);
+	if (f.exists()) f.remove();
+}
+
+
+CppUnit::Test* IOUringTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("IOUringTest");
+
+	CppUnit_addTest(pSuite, IOUringTest, testMode);
+	CppUnit_addTest(pSuite, IOUringTest, testReadWrite);
+	CppUnit_addTest(pSuite, IOUringTest, testReadWriteFallback);
+	CppUnit_addTest(pSuite, IOUringTest, testBatching);
+	CppUnit_addTest(pSuite, IOUringTest, testBatchingFallback);
+	CppUnit_addTest(pSuite, IOUringTest, testRegistered);
+	CppUnit_addTest(pSuite, IOUringTest, testRegisteredFallback);
+	CppUnit_addTest(pSuite, IOUringTest, testSocket);
+	CppUnit_addTest(pSuite, IOUringTest, testSocketFallback);
+	CppUnit_addTest(pSuite, IOUringTest, testTimeout);
+	CppUnit_addTest(pSuite, IOUringTest, testTimeoutFallback);
+	CppUnit_addTest(pSuite, IOUringTest, testErrors);
+	CppUnit_addTest(pSuite, IOUringTest, testErrorsFallback);
+
+	return pSuite;
+}
@@ -0,0 +1,60 @@
+//
+// IOUringTest.h
+//
+// Definition of the IOUringTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef IOUringTest_INCLUDED
+#define IOUringTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "Poco/IOUring.h"
+#include "CppUnit/TestCase.h"
+
+
+class IOUringTest: public CppUnit::TestCase
+{
+public:
+	IOUringTest(const std::string& name);
+	~IOUringTest();
+
+	void testMode();
+	void testReadWrite();
+	void testReadWriteFallback();
+	void testBatching();
+	void testBatchingFallback();
+	void testRegistered();
+	void testRegisteredFallback();
+	void testSocket();
+	void testSocketFallback();
+	void testTimeout();
+	void testTimeoutFallback();
+	void testErrors();
+	void testErrorsFallback();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+	void doReadWrite(Poco::IOUring::Mode mode);
+	void doBatching(Poco::IOUring::Mode mode);
+	void doRegistered(Poco::IOUring::Mode mode);
+	void doSocket(Poco::IOUring::Mode mode);
+	void doTimeout(Poco::IOUring::Mode mode);
+	void doErrors(Poco::IOUring::Mode mode);
+
+	std::string _path;
+	int _fd;
+};
+
+
+#endif // IOUringTest_INCLUDED
@@ -12,16 +12,39 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/Logger.h"
+#include "Poco/LoggerHandle.h"
 #include "Poco/AutoPtr.h"
 #include "TestChannel.h"
 
 
 using Poco::Logger;
+using Poco::LoggerHandle;
 using Poco::Channel;
 using Poco::Message;
 using Poco::AutoPtr;
 
 
+namespace
+{
+	struct Counted
+		/// Counts how often it has been copied.
+	{
+		Counted()
+		{
+		}
+
+		Counted(const Counted&)
+		{
+			++copies;
+		}
+
+		static int copies;
+	};
+
+	int Counted::copies = 0;
+}
+
+
 LoggerTest::LoggerTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -234,6 +257,110 @@ void LoggerTest::testFormatAny()
 }
 
 
+void LoggerTest::testLazyFormat()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	Logger& root = Logger::root();
+	root.setChannel(pChannel.get());
+	root.setLevel(Message::PRIO_INFORMATION);
+
+	Counted counted;
+	root.debug("%s", counted);
+	root.trace("%s %d", counted, 42);
+	assert (Counted::copies == 0);
+	assert (pChannel->list().empty());
+
+	root.information("%s", counted);
+	assert (Counted::copies == 0);
+	assert (pChannel->list().size() == 1);
+	assert (pChannel->getLastMessage().getText() == "[ERRFMT]");
+	pChannel->clear();
+
+	root.information("%s %d", std::string("foo"), 42);
+	assert (pChannel->list().size() == 1);
+	assert (pChannel->getLastMessage().getText() == "foo 42");
+	assert (pChannel->getLastMessage().getPriority() == Message::PRIO_INFORMATION);
+
+	// a file name and a line number are not format arguments,
+	// whatever the integer type of the line number
+	long line = 42;
+	root.information("100%", __FILE__, line);
+	assert (pChannel->getLastMessage().getText() == "100%");
+	assert (pChannel->getLastMessage().getSourceLine() == 42);
+	assert (std::string(pChannel->getLastMessage().getSourceFile()) == __FILE__);
+
+	std::size_t sizeLine = 43;
+	const char* file = "file.cpp";
+	root.error("%s", file, sizeLine);
+	assert (pChannel->getLastMessage().getText() == "%s");
+	assert (pChannel->getLastMessage().getSourceLine() == 43);
+	assert (pChannel->getLastMessage().getPriority() == Message::PRIO_ERROR);
+
+	root.warning("%u%%", 5u);
+	assert (pChannel->getLastMessage().getText() == "5%");
+}
+
+
+void LoggerTest::testMacros()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	Logger& root = Logger::root();
+	root.setChannel(pChannel.get());
+	root.setLevel(Message::PRIO_INFORMATION);
+
+	poco_warning(root, "warning");
+	assert (pChannel->getLastMessage().getText() == "warning");
+	assert (pChannel->getLastMessage().getSourceFile() != 0);
+
+	poco_error_f2(root, "%d-%d", 1, 2);
+	assert (pChannel->getLastMessage().getText() == "1-2");
+
+	poco_information_f(root, "%s %d %d %d %d %d", std::string("foo"), 1, 2, 3, 4, 5);
+	assert (pChannel->getLastMessage().getText() == "foo 1 2 3 4 5");
+	assert (pChannel->getLastMessage().getPriority() == Message::PRIO_INFORMATION);
+	assert (pChannel->list().size() == 3);
+
+	int evaluated = 0;
+	poco_debug_f(root, "%d", ++evaluated);
+	poco_trace_f(root, "%d %d", ++evaluated, 2);
+	assert (evaluated == 0);
+	assert (pChannel->list().size() == 3);
+}
+
+
+void LoggerTest::testLoggerHandle()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	Logger::root().setChannel(pChannel.get());
+
+	LoggerHandle handle("LoggerTest.Handle");
+	assert (handle.name() == "LoggerTest.Handle");
+	assert (Logger::has("LoggerTest.Handle") == 0);
+
+	Logger& logger = handle.logger();
+	assert (&logger == Logger::has("LoggerTest.Handle"));
+	assert (&*handle == &logger);
+	assert (handle->name() == "LoggerTest.Handle");
+
+	handle->error("error");
+	assert (pChannel->getLastMessage().getSource() == "LoggerTest.Handle");
+
+	Logger::destroy("LoggerTest.Handle");
+	assert (Logger::has("LoggerTest.Handle") == 0);
+	handle->setLevel(Message::PRIO_DEBUG);
+	assert (Logger::has("LoggerTest.Handle") != 0);
+	assert (Logger::get("LoggerTest.Handle").getLevel() == Message::PRIO_DEBUG);
+
+	Logger::shutdown();
+	Logger::root().setChannel(pChannel.get());
+	pChannel->clear();
+	poco_warning(*handle, "warning");
+	assert (pChannel->list().size() == 1);
+	assert (pChannel->getLastMessage().getSource() == "LoggerTest.Handle");
+	assert (Logger::get("LoggerTest.Handle").getLevel() == Logger::root().getLevel());
+}
+
+
 void LoggerTest::testDump()
 {
 	AutoPtr<TestChannel> pChannel = new TestChannel;
@@ -292,6 +419,9 @@ CppUnit::Test* LoggerTest::suite()
 	CppUnit_addTest(pSuite, LoggerTest, testLogger);
 	CppUnit_addTest(pSuite, LoggerTest, testFormat);
 	CppUnit_addTest(pSuite, LoggerTest, testFormatAny);
+	CppUnit_addTest(pSuite, LoggerTest, testLazyFormat);
+	CppUnit_addTest(pSuite, LoggerTest, testMacros);
+	CppUnit_addTest(pSuite, LoggerTest, testLoggerHandle);
 	CppUnit_addTest(pSuite, LoggerTest, testDump);
 
 	return pSuite;
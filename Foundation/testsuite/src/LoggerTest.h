@@ -27,6 +27,9 @@ public:
 	void testLogger();
 	void testFormat();
 	void testFormatAny();
+	void testLazyFormat();
+	void testMacros();
+	void testLoggerHandle();
 	void testDump();
 
 	void setUp();
@@ -20,6 +20,7 @@
 #endif
 #include "Poco/FileChannel.h"
 #include "Poco/SplitterChannel.h"
+#include "Poco/RingBufferChannel.h"
 #include "Poco/Formatter.h"
 #include "Poco/PatternFormatter.h"
 #include "Poco/Message.h"
@@ -33,6 +34,7 @@ using Poco::Channel;
 using Poco::ConsoleChannel;
 using Poco::FileChannel;
 using Poco::SplitterChannel;
+using Poco::RingBufferChannel;
 using Poco::Formatter;
 using Poco::PatternFormatter;
 using Poco::Message;
@@ -86,6 +88,9 @@ void LoggingFactoryTest::testBuiltins()
 	AutoPtr<Channel> pSplitterChannel = fact.createChannel("SplitterChannel");
 	assert (dynamic_cast<SplitterChannel*>(pSplitterChannel.get()) != 0);
 	
+	AutoPtr<Channel> pRingBufferChannel = fact.createChannel("RingBufferChannel");
+	assert (dynamic_cast<RingBufferChannel*>(pRingBufferChannel.get()) != 0);
+	
 	try
 	{
 		AutoPtr<Channel> pUnknownChannel = fact.createChannel("UnknownChannel");
@@ -17,6 +17,8 @@
 #include "LoggingFactoryTest.h"
 #include "LoggingRegistryTest.h"
 #include "LogStreamTest.h"
+#include "RingBufferChannelTest.h"
+#include "BinaryLogChannelTest.h"
 
 
 CppUnit::Test* LoggingTestSuite::suite()
@@ -31,6 +33,8 @@ CppUnit::Test* LoggingTestSuite::suite()
 	pSuite->addTest(LoggingFactoryTest::suite());
 	pSuite->addTest(LoggingRegistryTest::suite());
 	pSuite->addTest(LogStreamTest::suite());
+	pSuite->addTest(RingBufferChannelTest::suite());
+	pSuite->addTest(BinaryLogChannelTest::suite());
 
 	return pSuite;
 }
@@ -0,0 +1,236 @@
+//
+// MappedFileTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MappedFileTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/MappedFile.h"
+#include "Poco/MappedInputStream.h"
+#include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/File.h"
+#include "Poco/Exception.h"
+#include <utility>
+
+
+using Poco::MappedFile;
+using Poco::MappedInputStream;
+using Poco::FileOutputStream;
+using Poco::TemporaryFile;
+using Poco::File;
+
+
+MappedFileTest::MappedFileTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+MappedFileTest::~MappedFileTest()
+{
+}
+
+
+void MappedFileTest::testMap()
+{
+	std::string content("Hello, world!\n");
+	for (int i = 0; i < 1000; ++i) content += "line\n";
+	createFile(content);
+
+	MappedFile file(_path);
+	assert (file.isOpen());
+	assert (file.path() == _path);
+	assert (file.size() == content.size());
+	assert (!file.empty());
+	assert (file.end() - file.begin() == static_cast<std::ptrdiff_t>(content.size()));
+	assert (std::string(file.begin(), file.end()) == content);
+
+	file.close();
+	assert (!file.isOpen());
+	assert (file.size() == 0);
+
+	file.open(_path);
+	assert (file.isOpen());
+	assert (std::string(file.data(), file.size()) == content);
+}
+
+
+void MappedFileTest::testEmptyFile()
+{
+	createFile("");
+
+	MappedFile file(_path);
+	assert (file.isOpen());
+	assert (file.empty());
+	assert (file.size() == 0);
+	assert (file.begin() == file.end());
+
+	MappedInputStream istr(file);
+	assert (istr.get() == std::char_traits<char>::eof());
+	assert (istr.eof());
+}
+
+
+void MappedFileTest::testNotFound()
+{
+	try
+	{
+		MappedFile file("/nonexistent/path/to/file");
+		fail("file does not exist - must throw");
+	}
+	catch (Poco::FileNotFoundException&)
+	{
+	}
+
+	try
+	{
+		MappedInputStream istr("/nonexistent/path/to/file");
+		fail("file does not exist - must throw");
+	}
+	catch (Poco::FileNotFoundException&)
+	{
+	}
+}
+
+
+void MappedFileTest::testOptions()
+{
+	std::string content(3*MappedFile::pageSize() + 123, 'x');
+	createFile(content);
+
+	MappedFile file(_path, MappedFile::OPT_POPULATE | MappedFile::OPT_HUGE_PAGES);
+	assert (std::string(file.begin(), file.end()) == content);
+
+	file.advise(MappedFile::ADVICE_SEQUENTIAL);
+	file.advise(MappedFile::ADVICE_WILLNEED, MappedFile::pageSize() + 17, 100);
+	file.advise(MappedFile::ADVICE_RANDOM, 0, 10*content.size());
+	file.advise(MappedFile::ADVICE_DONTNEED, 2*content.size(), 1);
+	file.advise(MappedFile::ADVICE_NORMAL);
+	assert (std::string(file.begin(), file.end()) == content);
+}
+
+
+void MappedFileTest::testMove()
+{
+	createFile("content");
+
+	MappedFile file1(_path);
+	const char* pData = file1.data();
+	MappedFile file2(std::move(file1));
+	assert (!file1.isOpen());
+	assert (file1.data() == 0);
+	assert (file2.isOpen());
+	assert (file2.data() == pData);
+	assert (std::string(file2.begin(), file2.end()) == "content");
+
+	MappedFile file3;
+	file3 = std::move(file2);
+	assert (!file2.isOpen());
+	assert (file3.data() == pData);
+
+	swap(file1, file3);
+	assert (file1.data() == pData);
+	assert (!file3.isOpen());
+}
+
+
+void MappedFileTest::testInputStream()
+{
+	createFile("line 1\nline 2\n42 3.5\n");
+
+	MappedInputStream istr(_path);
+	assert (istr.size() == 21);
+	std::string line;
+	std::getline(istr, line);
+	assert (line == "line 1");
+	std::getline(istr, line);
+	assert (line == "line 2");
+	int i;
+	double d;
+	istr >> i >> d;
+	assert (i == 42);
+	assert (d == 3.5);
+	assert (istr.get() == '\n');
+	assert (istr.get() == std::char_traits<char>::eof());
+	assert (istr.eof());
+}
+
+
+void MappedFileTest::testInputStreamSeek()
+{
+	createFile("0123456789");
+
+	MappedFile file(_path);
+	MappedInputStream istr(file);
+	assert (istr.begin() == file.begin());
+	istr.seekg(5);
+	assert (istr.get() == '5');
+	assert (istr.tellg() == std::streampos(6));
+	istr.seekg(-2, std::ios::end);
+	assert (istr.get() == '8');
+	istr.seekg(-4, std::ios::cur);
+	assert (istr.get() == '5');
+	istr.seekg(0, std::ios::beg);
+	assert (istr.get() == '0');
+	assert (istr.current() == file.begin() + 1);
+}
+
+
+void MappedFileTest::testInputStreamSkip()
+{
+	createFile("0123456789");
+
+	MappedInputStream istr(_path);
+	istr.skip(3);
+	assert (istr.current() == istr.begin() + 3);
+	assert (istr.get() == '3');
+	istr.skip(6);
+	assert (istr.current() == istr.end());
+	assert (istr.good());
+	istr.skip(1);
+	assert (istr.eof());
+	assert (istr.current() == istr.end());
+}
+
+
+void MappedFileTest::setUp()
+{
+	_path = TemporaryFile::tempName();
+}
+
+
+void MappedFileTest::tearDown()
+{
+	File file(_path);
+	if (file.exists()) file.remove();
+}
+
+
+void MappedFileTest::createFile(const std::string& content)
+{
+	FileOutputStream ostr(_path);
+	ostr << content;
+}
+
+
+CppUnit::Test* MappedFileTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MappedFileTest");
+
+	CppUnit_addTest(pSuite, MappedFileTest, testMap);
+	CppUnit_addTest(pSuite, MappedFileTest, testEmptyFile);
+	CppUnit_addTest(pSuite, MappedFileTest, testNotFound);
+	CppUnit_addTest(pSuite, MappedFileTest, testOptions);
+	CppUnit_addTest(pSuite, MappedFileTest, testMove);
+	CppUnit_addTest(pSuite, MappedFileTest, testInputStream);
+	CppUnit_addTest(pSuite, MappedFileTest, testInputStreamSeek);
+	CppUnit_addTest(pSuite, MappedFileTest, testInputStreamSkip);
+
+	return pSuite;
+}
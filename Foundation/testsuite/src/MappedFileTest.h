@@ -0,0 +1,48 @@
+//
+// MappedFileTest.h
+//
+// Definition of the MappedFileTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MappedFileTest_INCLUDED
+#define MappedFileTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class MappedFileTest: public CppUnit::TestCase
+{
+public:
+	MappedFileTest(const std::string& name);
+	~MappedFileTest();
+
+	void testMap();
+	void testEmptyFile();
+	void testNotFound();
+	void testOptions();
+	void testMove();
+	void testInputStream();
+	void testInputStreamSeek();
+	void testInputStreamSkip();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+	void createFile(const std::string& content);
+
+	std::string _path;
+};
+
+
+#endif // MappedFileTest_INCLUDED
@@ -0,0 +1,260 @@
+//
+// MetricCounterTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MetricCounterTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/MetricCounter.h"
+#include "Poco/MetricGauge.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/Exception.h"
+#include <sstream>
+#include <iostream>
+
+
+using Poco::MetricCounter;
+using Poco::MetricGauge;
+using Poco::AtomicCounter;
+using Poco::Thread;
+
+
+namespace
+{
+	const int THREAD_COUNT = 4;
+
+
+	class CounterRunnable: public Poco::Runnable
+	{
+	public:
+		CounterRunnable(MetricCounter& counter, MetricGauge& gauge, int rounds):
+			_counter(counter),
+			_gauge(gauge),
+			_rounds(rounds)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _rounds; ++i)
+			{
+				_counter.inc();
+				_gauge.inc();
+				_gauge.dec();
+			}
+		}
+
+	private:
+		MetricCounter& _counter;
+		MetricGauge& _gauge;
+		int _rounds;
+	};
+
+
+	class AtomicCounterRunnable: public Poco::Runnable
+	{
+	public:
+		AtomicCounterRunnable(AtomicCounter& counter, int rounds):
+			_counter(counter),
+			_rounds(rounds)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _rounds; ++i) ++_counter;
+		}
+
+	private:
+		AtomicCounter& _counter;
+		int _rounds;
+	};
+
+
+	class MetricCounterRunnable: public Poco::Runnable
+	{
+	public:
+		MetricCounterRunnable(MetricCounter& counter, int rounds):
+			_counter(counter),
+			_rounds(rounds)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _rounds; ++i) _counter.inc();
+		}
+
+	private:
+		MetricCounter& _counter;
+		int _rounds;
+	};
+
+
+	template <class R, class C>
+	void runThreads(C& counter, int rounds)
+	{
+		R r1(counter, rounds);
+		R r2(counter, rounds);
+		R r3(counter, rounds);
+		R r4(counter, rounds);
+		Thread t1;
+		Thread t2;
+		Thread t3;
+		Thread t4;
+		t1.start(r1);
+		t2.start(r2);
+		t3.start(r3);
+		t4.start(r4);
+		t1.join();
+		t2.join();
+		t3.join();
+		t4.join();
+	}
+}
+
+
+MetricCounterTest::MetricCounterTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+MetricCounterTest::~MetricCounterTest()
+{
+}
+
+
+void MetricCounterTest::testCounter()
+{
+	MetricCounter counter("test_requests_total", "Number of requests.");
+	assert (counter.name() == "test_requests_total");
+	assert (counter.help() == "Number of requests.");
+	assert (counter.value() == 0);
+
+	counter.inc();
+	assert (counter.value() == 1);
+	counter.inc(41);
+	assert (counter.value() == 42);
+
+	std::ostringstream ostr;
+	counter.writePrometheus(ostr);
+	assert (ostr.str() ==
+		"# HELP test_requests_total Number of requests.\n"
+		"# TYPE test_requests_total counter\n"
+		"test_requests_total 42\n");
+
+	try
+	{
+		MetricCounter invalid("1st_counter", "");
+		fail("invalid name - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void MetricCounterTest::testGauge()
+{
+	MetricGauge gauge("test_connections", "Number of connections.");
+	assert (gauge.value() == 0);
+
+	gauge.inc();
+	gauge.inc(2);
+	assert (gauge.value() == 3);
+	gauge.dec();
+	assert (gauge.value() == 2);
+	gauge.dec(5);
+	assert (gauge.value() == -3);
+	gauge.set(7);
+	assert (gauge.value() == 7);
+
+	std::ostringstream ostr;
+	gauge.writePrometheus(ostr);
+	assert (ostr.str() ==
+		"# HELP test_connections Number of connections.\n"
+		"# TYPE test_connections gauge\n"
+		"test_connections 7\n");
+}
+
+
+void MetricCounterTest::testThreads()
+{
+	MetricCounter counter("test_counter", "");
+	MetricGauge gauge("test_gauge", "");
+	const int rounds = 100000;
+
+	CounterRunnable r1(counter, gauge, rounds);
+	CounterRunnable r2(counter, gauge, rounds);
+	CounterRunnable r3(counter, gauge, rounds);
+	CounterRunnable r4(counter, gauge, rounds);
+	Thread t1;
+	Thread t2;
+	Thread t3;
+	Thread t4;
+	t1.start(r1);
+	t2.start(r2);
+	t3.start(r3);
+	t4.start(r4);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+
+	assert (counter.value() == THREAD_COUNT*rounds);
+	assert (gauge.value() == 0);
+}
+
+
+void MetricCounterTest::benchmarkContention()
+{
+	const int rounds = 10000000;
+	Poco::Stopwatch sw;
+
+	AtomicCounter atomicCounter;
+	sw.start();
+	runThreads<AtomicCounterRunnable>(atomicCounter, rounds);
+	sw.stop();
+	std::cout << "AtomicCounter: " << double(THREAD_COUNT)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e6 << " M/s" << std::endl;
+
+	MetricCounter metricCounter("benchmark_total", "");
+	sw.restart();
+	runThreads<MetricCounterRunnable>(metricCounter, rounds);
+	sw.stop();
+	std::cout << "MetricCounter: " << double(THREAD_COUNT)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e6 << " M/s" << std::endl;
+
+	assert (atomicCounter.value() == THREAD_COUNT*rounds);
+	assert (metricCounter.value() == THREAD_COUNT*rounds);
+}
+
+
+void MetricCounterTest::setUp()
+{
+}
+
+
+void MetricCounterTest::tearDown()
+{
+}
+
+
+CppUnit::Test* MetricCounterTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MetricCounterTest");
+
+	CppUnit_addTest(pSuite, MetricCounterTest, testCounter);
+	CppUnit_addTest(pSuite, MetricCounterTest, testGauge);
+	CppUnit_addTest(pSuite, MetricCounterTest, testThreads);
+	//CppUnit_addTest(pSuite, MetricCounterTest, benchmarkContention);
+
+	return pSuite;
+}
@@ -0,0 +1,41 @@
+//
+// MetricCounterTest.h
+//
+// Definition of the MetricCounterTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MetricCounterTest_INCLUDED
+#define MetricCounterTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class MetricCounterTest: public CppUnit::TestCase
+{
+public:
+	MetricCounterTest(const std::string& name);
+	~MetricCounterTest();
+
+	void testCounter();
+	void testGauge();
+	void testThreads();
+	void benchmarkContention();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // MetricCounterTest_INCLUDED
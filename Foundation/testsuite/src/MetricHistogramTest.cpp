@@ -0,0 +1,171 @@
+//
+// MetricHistogramTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MetricHistogramTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/MetricHistogram.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include <sstream>
+
+
+using Poco::MetricHistogram;
+using Poco::UInt64;
+
+
+namespace
+{
+	class HistogramRunnable: public Poco::Runnable
+	{
+	public:
+		HistogramRunnable(MetricHistogram& histogram):
+			_histogram(histogram)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 1; i <= 10000; ++i) _histogram.record(i);
+		}
+
+	private:
+		MetricHistogram& _histogram;
+	};
+}
+
+
+MetricHistogramTest::MetricHistogramTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+MetricHistogramTest::~MetricHistogramTest()
+{
+}
+
+
+void MetricHistogramTest::testBuckets()
+{
+	for (unsigned i = 0; i < MetricHistogram::SUB_BUCKET_COUNT; ++i)
+	{
+		assert (MetricHistogram::bucketIndex(i) == i);
+		assert (MetricHistogram::bucketLimit(i) == i);
+	}
+	assert (MetricHistogram::bucketIndex(8) == 8);
+	assert (MetricHistogram::bucketIndex(15) == 15);
+	assert (MetricHistogram::bucketIndex(16) == 16);
+	assert (MetricHistogram::bucketIndex(17) == 16);
+	assert (MetricHistogram::bucketLimit(16) == 17);
+	assert (MetricHistogram::bucketIndex(18) == 17);
+	assert (MetricHistogram::bucketIndex(1000) == MetricHistogram::bucketIndex(1023));
+	assert (MetricHistogram::bucketIndex(1024) == MetricHistogram::bucketIndex(1023) + 1);
+	assert (MetricHistogram::bucketIndex(~UInt64(0)) == MetricHistogram::BUCKET_COUNT - 1);
+	assert (MetricHistogram::bucketLimit(MetricHistogram::BUCKET_COUNT - 1) == ~UInt64(0));
+
+	// every value is counted in a bucket whose limit is at least the value,
+	// and the relative error is at most 1/SUB_BUCKET_COUNT
+	for (unsigned shift = 0; shift < 64; ++shift)
+	{
+		UInt64 values[] = {UInt64(1) << shift, (UInt64(1) << shift) + 1, (UInt64(3) << shift) / 2, (UInt64(1) << shift)*2 - 1};
+		for (std::size_t i = 0; i < sizeof(values)/sizeof(values[0]); ++i)
+		{
+			UInt64 v = values[i];
+			unsigned index = MetricHistogram::bucketIndex(v);
+			assert (index < MetricHistogram::BUCKET_COUNT);
+			assert (MetricHistogram::bucketLimit(index) >= v);
+			assert (MetricHistogram::bucketLimit(index) - v <= v/MetricHistogram::SUB_BUCKET_COUNT);
+			if (index > 0) assert (MetricHistogram::bucketLimit(index - 1) < v);
+		}
+	}
+}
+
+
+void MetricHistogramTest::testPercentile()
+{
+	MetricHistogram histogram("test_latency", "Latency.");
+	assert (histogram.count() == 0);
+	assert (histogram.sum() == 0);
+	assert (histogram.percentile(50) == 0);
+
+	for (int i = 1; i <= 100; ++i) histogram.record(i);
+	assert (histogram.count() == 100);
+	assert (histogram.sum() == 5050);
+	assert (histogram.percentile(0) == 1);
+	assert (histogram.percentile(5) == 5);
+	assert (histogram.percentile(50) == 51);
+	assert (histogram.percentile(90) == 95);
+	assert (histogram.percentile(100) == 103);
+
+	histogram.record(-5);
+	assert (histogram.count() == 101);
+	assert (histogram.sum() == 5050);
+	assert (histogram.percentile(0) == 0);
+}
+
+
+void MetricHistogramTest::testThreads()
+{
+	MetricHistogram histogram("test_latency", "");
+	HistogramRunnable r1(histogram);
+	HistogramRunnable r2(histogram);
+	Poco::Thread t1;
+	Poco::Thread t2;
+	t1.start(r1);
+	t2.start(r2);
+	t1.join();
+	t2.join();
+
+	assert (histogram.count() == 20000);
+	assert (histogram.sum() == 2*50005000);
+}
+
+
+void MetricHistogramTest::testPrometheus()
+{
+	MetricHistogram histogram("test_duration_seconds", "Duration.", 0.001);
+	for (int i = 0; i < 1000; ++i) histogram.record(4);
+	histogram.record(1000);
+
+	std::ostringstream ostr;
+	histogram.writePrometheus(ostr);
+	assert (ostr.str() ==
+		"# HELP test_duration_seconds Duration.\n"
+		"# TYPE test_duration_seconds summary\n"
+		"test_duration_seconds{quantile=\"0.5\"} 0.004\n"
+		"test_duration_seconds{quantile=\"0.9\"} 0.004\n"
+		"test_duration_seconds{quantile=\"0.99\"} 0.004\n"
+		"test_duration_seconds{quantile=\"0.999\"} 0.004\n"
+		"test_duration_seconds_sum 5\n"
+		"test_duration_seconds_count 1001\n");
+}
+
+
+void MetricHistogramTest::setUp()
+{
+}
+
+
+void MetricHistogramTest::tearDown()
+{
+}
+
+
+CppUnit::Test* MetricHistogramTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MetricHistogramTest");
+
+	CppUnit_addTest(pSuite, MetricHistogramTest, testBuckets);
+	CppUnit_addTest(pSuite, MetricHistogramTest, testPercentile);
+	CppUnit_addTest(pSuite, MetricHistogramTest, testThreads);
+	CppUnit_addTest(pSuite, MetricHistogramTest, testPrometheus);
+
+	return pSuite;
+}
@@ -0,0 +1,41 @@
+//
+// MetricHistogramTest.h
+//
+// Definition of the MetricHistogramTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MetricHistogramTest_INCLUDED
+#define MetricHistogramTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class MetricHistogramTest: public CppUnit::TestCase
+{
+public:
+	MetricHistogramTest(const std::string& name);
+	~MetricHistogramTest();
+
+	void testBuckets();
+	void testPercentile();
+	void testThreads();
+	void testPrometheus();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // MetricHistogramTest_INCLUDED
@@ -0,0 +1,186 @@
+//
+// MetricRegistryTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MetricRegistryTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/MetricRegistry.h"
+#include "Poco/MetricCounter.h"
+#include "Poco/MetricGauge.h"
+#include "Poco/MetricHistogram.h"
+#include "Poco/ThreadPool.h"
+#include "Poco/Runnable.h"
+#include "Poco/Exception.h"
+#include <sstream>
+
+
+using Poco::MetricRegistry;
+using Poco::MetricCounter;
+using Poco::MetricGauge;
+using Poco::MetricHistogram;
+using Poco::Metric;
+
+
+namespace
+{
+	class NullRunnable: public Poco::Runnable
+	{
+	public:
+		void run()
+		{
+		}
+	};
+}
+
+
+MetricRegistryTest::MetricRegistryTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+MetricRegistryTest::~MetricRegistryTest()
+{
+}
+
+
+void MetricRegistryTest::testRegistry()
+{
+	MetricRegistry registry;
+	assert (registry.find("test_requests_total") == 0);
+
+	MetricCounter& counter = registry.counter("test_requests_total", "Number of requests.");
+	MetricGauge& gauge = registry.gauge("test_connections", "Number of connections.");
+	MetricHistogram& histogram = registry.histogram("test_duration_seconds", "Duration.", 1e-6);
+	assert (histogram.unit() == 1e-6);
+
+	assert (&registry.counter("test_requests_total", "") == &counter);
+	assert (&registry.gauge("test_connections", "") == &gauge);
+	assert (&registry.histogram("test_duration_seconds", "") == &histogram);
+	assert (registry.find("test_requests_total") == &counter);
+	assert (registry.find("test_connections") == &gauge);
+	assert (registry.find("test_duration_seconds") == &histogram);
+	assert (registry.find("test_other") == 0);
+
+	try
+	{
+		registry.gauge("test_requests_total", "");
+		fail("type clash - must throw");
+	}
+	catch (Poco::ExistsException&)
+	{
+	}
+
+	try
+	{
+		registry.histogram("test_connections", "");
+		fail("type clash - must throw");
+	}
+	catch (Poco::ExistsException&)
+	{
+	}
+
+	std::vector<std::string> names;
+	registry.names(names);
+	assert (names.size() == 3);
+	assert (names[0] == "test_connections");
+	assert (names[1] == "test_duration_seconds");
+	assert (names[2] == "test_requests_total");
+}
+
+
+void MetricRegistryTest::testInvalid()
+{
+	MetricRegistry registry;
+	const char* invalid[] = {"", "1st", "test-metric", "test metric", "test.metric"};
+	for (std::size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); ++i)
+	{
+		assert (!Metric::isValidName(invalid[i]));
+		try
+		{
+			registry.counter(invalid[i], "");
+			fail("invalid name - must throw");
+		}
+		catch (Poco::InvalidArgumentException&)
+		{
+		}
+	}
+	assert (registry.find("1st") == 0);
+
+	assert (Metric::isValidName("_test"));
+	assert (Metric::isValidName("test:metric_2"));
+}
+
+
+void MetricRegistryTest::testPrometheus()
+{
+	MetricRegistry registry;
+	std::ostringstream empty;
+	registry.writePrometheus(empty);
+	assert (empty.str().empty());
+
+	registry.counter("test_requests_total", "Number of requests\nin total, see C:\\log.").inc(3);
+	registry.gauge("test_connections", "Number of connections.").set(2);
+
+	std::ostringstream ostr;
+	registry.writePrometheus(ostr);
+	assert (ostr.str() ==
+		"# HELP test_connections Number of connections.\n"
+		"# TYPE test_connections gauge\n"
+		"test_connections 2\n"
+		"# HELP test_requests_total Number of requests\\nin total, see C:\\\\log.\n"
+		"# TYPE test_requests_total counter\n"
+		"test_requests_total 3\n");
+}
+
+
+void MetricRegistryTest::testDefaultRegistry()
+{
+	MetricRegistry& registry = MetricRegistry::defaultRegistry();
+	assert (&MetricRegistry::defaultRegistry() == &registry);
+
+	Poco::ThreadPool pool(1, 1);
+	NullRunnable runnable;
+	pool.start(runnable);
+	pool.joinAll();
+
+	Metric* pTasks = registry.find("poco_threadpool_tasks_total");
+	assert (pTasks != 0);
+	MetricCounter* pCounter = dynamic_cast<MetricCounter*>(pTasks);
+	assert (pCounter != 0);
+	assert (pCounter->value() >= 1);
+
+	std::ostringstream ostr;
+	registry.writePrometheus(ostr);
+	assert (ostr.str().find("# TYPE poco_threadpool_tasks_total counter\n") != std::string::npos);
+	assert (ostr.str().find("# TYPE poco_threadpool_task_duration_seconds summary\n") != std::string::npos);
+}
+
+
+void MetricRegistryTest::setUp()
+{
+}
+
+
+void MetricRegistryTest::tearDown()
+{
+}
+
+
+CppUnit::Test* MetricRegistryTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MetricRegistryTest");
+
+	CppUnit_addTest(pSuite, MetricRegistryTest, testRegistry);
+	CppUnit_addTest(pSuite, MetricRegistryTest, testInvalid);
+	CppUnit_addTest(pSuite, MetricRegistryTest, testPrometheus);
+	CppUnit_addTest(pSuite, MetricRegistryTest, testDefaultRegistry);
+
+	return pSuite;
+}
@@ -0,0 +1,41 @@
+//
+// MetricRegistryTest.h
+//
+// Definition of the MetricRegistryTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MetricRegistryTest_INCLUDED
+#define MetricRegistryTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class MetricRegistryTest: public CppUnit::TestCase
+{
+public:
+	MetricRegistryTest(const std::string& name);
+	~MetricRegistryTest();
+
+	void testRegistry();
+	void testInvalid();
+	void testPrometheus();
+	void testDefaultRegistry();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // MetricRegistryTest_INCLUDED
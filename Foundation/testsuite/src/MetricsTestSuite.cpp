@@ -0,0 +1,26 @@
+//
+// MetricsTestSuite.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "MetricsTestSuite.h"
+#include "MetricCounterTest.h"
+#include "MetricHistogramTest.h"
+#include "MetricRegistryTest.h"
+
+
+CppUnit::Test* MetricsTestSuite::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("MetricsTestSuite");
+
+	pSuite->addTest(MetricCounterTest::suite());
+	pSuite->addTest(MetricHistogramTest::suite());
+	pSuite->addTest(MetricRegistryTest::suite());
+
+	return pSuite;
+}
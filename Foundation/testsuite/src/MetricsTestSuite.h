@@ -0,0 +1,27 @@
+//
+// MetricsTestSuite.h
+//
+// Definition of the MetricsTestSuite class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef MetricsTestSuite_INCLUDED
+#define MetricsTestSuite_INCLUDED
+
+
+#include "CppUnit/TestSuite.h"
+
+
+class MetricsTestSuite
+{
+public:
+	static CppUnit::Test* suite();
+};
+
+
+#endif // MetricsTestSuite_INCLUDED
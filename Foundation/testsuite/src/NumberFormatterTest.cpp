@@ -12,7 +12,15 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/NumericString.h"
+#include "Poco/Stopwatch.h"
 #include <sstream>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
 
 
 using Poco::NumberFormatter;
@@ -315,6 +323,111 @@ void NumberFormatterTest::testAppend()
 }
 
 
+void NumberFormatterTest::testShortest()
+{
+	assert (NumberFormatter::format(0.3) == "0.3");
+	assert (NumberFormatter::format(0.1 + 0.2) == "0.30000000000000004");
+	assert (NumberFormatter::format(-0.0) == "0");
+	assert (NumberFormatter::format(5e-324) == "5e-324");
+	assert (NumberFormatter::format(1e-323) == "1e-323");
+	assert (NumberFormatter::format(2.2250738585072014e-308) == "2.2250738585072014e-308");
+	assert (NumberFormatter::format(1.7976931348623157e308) == "1.7976931348623157e+308");
+	assert (NumberFormatter::format(9007199254740993.0) == "9.007199254740992e+15");
+	assert (NumberFormatter::format(1e14) == "100000000000000");
+	assert (NumberFormatter::format(1e15) == "1e+15");
+	assert (NumberFormatter::format(1e23) == "1e+23");
+	assert (NumberFormatter::format(123456.0) == "123456");
+	assert (NumberFormatter::format(5.9604644775390625e-8) == "0.00000005960464477539063");
+	assert (NumberFormatter::format(std::numeric_limits<double>::infinity()) == "inf");
+	assert (NumberFormatter::format(-std::numeric_limits<double>::infinity()) == "-inf");
+	assert (NumberFormatter::format(std::numeric_limits<double>::quiet_NaN()) == "nan");
+
+	assert (NumberFormatter::format(1.4e-45f) == "1e-45");
+	assert (NumberFormatter::format(3.4028235e38f) == "3.4028235e+38");
+	assert (NumberFormatter::format(16777216.0f) == "1.6777216e+7");
+	assert (NumberFormatter::format(0.3f) == "0.3");
+
+	char buffer[32];
+	Poco::doubleToStr(buffer, sizeof(buffer), 12345.678, -5, 3);
+	assert (std::string(buffer) == "1.2345678e+4");
+	Poco::doubleToStr(buffer, sizeof(buffer), 0.00012, -3, 5);
+	assert (std::string(buffer) == "1.2e-4");
+	Poco::doubleToStr(buffer, 6, 0.00012, -5, 5);
+	assert (std::string(buffer) == "0.000");
+
+	UInt64 x = 88172645463325252ULL;
+	for (int i = 0; i < 100000; ++i)
+	{
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		double d;
+		std::memcpy(&d, &x, sizeof(d));
+		if (d != d || d - d != 0) continue;
+		assert (Poco::NumberParser::parseFloat(NumberFormatter::format(d)) == d);
+		float f;
+		Poco::UInt32 y = static_cast<Poco::UInt32>(x);
+		std::memcpy(&f, &y, sizeof(f));
+		if (f != f || f - f != 0) continue;
+		float g;
+		assert (Poco::strToFloat(NumberFormatter::format(f), g) && g == f);
+	}
+}
+
+
+void NumberFormatterTest::benchmarkFormat()
+{
+	const int count = 1000000;
+	std::vector<double> values;
+	UInt64 x = 88172645463325252ULL;
+	while (values.size() < 1000)
+	{
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		double d;
+		std::memcpy(&d, &x, sizeof(d));
+		if (d == d && d - d == 0) values.push_back(d);
+	}
+
+	Poco::Stopwatch sw;
+	char buffer[64];
+	std::size_t length = 0;
+	sw.start();
+	for (int i = 0; i < count; ++i)
+	{
+		length += std::snprintf(buffer, sizeof(buffer), "%.17g", values[i % values.size()]);
+	}
+	sw.stop();
+	double timeSnprintf = sw.elapsed()/1000.0;
+
+	sw.restart();
+	for (int i = 0; i < count; ++i)
+	{
+		Poco::doubleToStr(buffer, sizeof(buffer), values[i % values.size()]);
+		length += std::strlen(buffer);
+	}
+	sw.stop();
+	double timeDoubleToStr = sw.elapsed()/1000.0;
+
+	std::string str;
+	sw.restart();
+	for (int i = 0; i < count; ++i)
+	{
+		str.clear();
+		NumberFormatter::append(str, static_cast<Int64>(x + i));
+		length += str.size();
+	}
+	sw.stop();
+	double timeAppend = sw.elapsed()/1000.0;
+
+	std::cout << std::endl;
+	std::cout << std::setw(24) << "snprintf %.17g:" << std::setw(10) << timeSnprintf << " [ms]" << std::endl;
+	std::cout << std::setw(24) << "doubleToStr:" << std::setw(10) << timeDoubleToStr << " [ms]" << std::endl;
+	std::cout << std::setw(24) << "append(Int64):" << std::setw(10) << timeAppend << " [ms] " << length << std::endl;
+}
+
+
 void NumberFormatterTest::setUp()
 {
 }
@@ -335,6 +448,8 @@ CppUnit::Test* NumberFormatterTest::suite()
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatHex);
 	CppUnit_addTest(pSuite, NumberFormatterTest, testFormatFloat);
 	CppUnit_addTest(pSuite, NumberFormatterTest, testAppend);
+	CppUnit_addTest(pSuite, NumberFormatterTest, testShortest);
+	//CppUnit_addTest(pSuite, NumberFormatterTest, benchmarkFormat);
 
 	return pSuite;
 }
@@ -30,6 +30,8 @@ public:
 	void testFormatHex();
 	void testFormatFloat();
 	void testAppend();
+	void testShortest();
+	void benchmarkFormat();
 
 	void setUp();
 	void tearDown();
@@ -20,6 +20,8 @@
 #include <iostream>
 #include <iomanip>
 #include <cstdio>
+#include <cinttypes>
+#include <vector>
 
 
 using Poco::NumberParser;
@@ -303,6 +305,161 @@ void NumberParserTest::testParseError()
 }
 
 
+void NumberParserTest::testParseRange()
+{
+	const char* s = "123456789012345678 -42 12,345,678,901 1.5e3 4294967295";
+	int i;
+	unsigned u;
+	assert (NumberParser::tryParse(s + 19, 3, i));
+	assert (i == -42);
+	assert (NumberParser::tryParse(s, 3, i));
+	assert (i == 123);
+	assert (!NumberParser::tryParse(s, 19, i));
+	assert (!NumberParser::tryParse(s, 0, i));
+	assert (NumberParser::tryParseUnsigned(s + 44, 10, u));
+	assert (u == 4294967295U);
+	assert (!NumberParser::tryParseUnsigned(s + 19, 3, u));
+
+#if defined(POCO_HAVE_INT64)
+	Int64 i64;
+	UInt64 u64;
+	assert (NumberParser::tryParse64(s, 18, i64));
+	assert (i64 == 123456789012345678LL);
+	assert (NumberParser::tryParse64(s + 23, 14, i64));
+	assert (i64 == 12345678901LL);
+	assert (!NumberParser::tryParse64(s + 23, 14, i64, '.'));
+	assert (NumberParser::tryParseUnsigned64(s, 17, u64));
+	assert (u64 == 12345678901234567ULL);
+	assert (NumberParser::tryParse64(s + 1, 8, i64));
+	assert (i64 == 23456789);
+	assert (NumberParser::tryParse64(s + 1, 9, i64));
+	assert (i64 == 234567890);
+#endif
+
+	double d;
+	assert (NumberParser::tryParseFloat(s + 38, 5, d));
+	assert (d == 1500);
+	assert (NumberParser::tryParseFloat(s + 38, 3, d));
+	assert (d == 1.5);
+	assert (!NumberParser::tryParseFloat(s + 38, 7, d));
+	assert (!NumberParser::tryParseFloat(s, 0, d));
+	assert (NumberParser::tryParseFloat("1.234,5", 7, d, ',', '.'));
+	assert (d == 1234.5);
+	assert (NumberParser::tryParseFloat("1,234.5f", 8, d));
+	assert (d == 1234.5);
+
+	std::string big(1000, '0');
+	big += "1,234.5";
+	assert (NumberParser::tryParseFloat(big.data(), big.size(), d));
+	assert (d == 1234.5);
+}
+
+
+void NumberParserTest::testOverflow()
+{
+	int i;
+	unsigned u;
+	assert (NumberParser::tryParse("2147483647", i));
+	assert (i == 2147483647);
+	assert (NumberParser::tryParse("-2147483648", i));
+	assert (i == -2147483647 - 1);
+	assert (!NumberParser::tryParse("2147483648", i));
+	assert (!NumberParser::tryParse("-2147483649", i));
+	assert (!NumberParser::tryParse("10000000000", i));
+	assert (NumberParser::tryParseUnsigned("4294967295", u));
+	assert (!NumberParser::tryParseUnsigned("4294967296", u));
+	assert (!NumberParser::tryParseUnsigned("4294967300", u));
+	assert (NumberParser::tryParseUnsigned("0000000000004294967295", u));
+	assert (u == 4294967295U);
+	assert (NumberParser::tryParseHex("FFFFFFFF", u));
+	assert (!NumberParser::tryParseHex("100000000", u));
+	assert (!NumberParser::tryParseOct("8", u));
+
+#if defined(POCO_HAVE_INT64)
+	Int64 i64;
+	UInt64 u64;
+	assert (NumberParser::tryParse64("9223372036854775807", i64));
+	assert (i64 == std::numeric_limits<Int64>::max());
+	assert (NumberParser::tryParse64("-9223372036854775808", i64));
+	assert (i64 == std::numeric_limits<Int64>::min());
+	assert (!NumberParser::tryParse64("9223372036854775808", i64));
+	assert (!NumberParser::tryParse64("-9223372036854775809", i64));
+	assert (NumberParser::tryParseUnsigned64("18446744073709551615", u64));
+	assert (u64 == std::numeric_limits<UInt64>::max());
+	assert (!NumberParser::tryParseUnsigned64("18446744073709551616", u64));
+	assert (!NumberParser::tryParseUnsigned64("18446744073709551620", u64));
+	assert (!NumberParser::tryParseUnsigned64("100000000000000000000", u64));
+	assert (NumberParser::tryParseUnsigned64("18,446,744,073,709,551,615", u64));
+	assert (u64 == std::numeric_limits<UInt64>::max());
+	assert (NumberParser::tryParseHex64("FFFFFFFFFFFFFFFF", u64));
+	assert (!NumberParser::tryParseHex64("10000000000000000", u64));
+#endif
+}
+
+
+void NumberParserTest::benchmarkParse()
+{
+	const int count = 1000000;
+	std::vector<std::string> ints;
+	std::vector<std::string> floats;
+	for (int i = 0; i < 1000; ++i)
+	{
+		ints.push_back(NumberFormatter::format((Int64(i)*7919*104729*1299709) % 10000000000000LL));
+		floats.push_back(NumberFormatter::format(i*1299709/7919.0));
+	}
+
+	Poco::Stopwatch sw;
+	Int64 i64 = 0;
+	Int64 sum = 0;
+	sw.start();
+	for (int i = 0; i < count; ++i)
+	{
+		const std::string& s = ints[i % ints.size()];
+		std::sscanf(s.c_str(), "%" PRId64, &i64);
+		sum += i64;
+	}
+	sw.stop();
+	double timeScanf = sw.elapsed()/1000.0;
+
+	sw.restart();
+	for (int i = 0; i < count; ++i)
+	{
+		const std::string& s = ints[i % ints.size()];
+		NumberParser::tryParse64(s.data(), s.size(), i64);
+		sum -= i64;
+	}
+	sw.stop();
+	double timeParse64 = sw.elapsed()/1000.0;
+	assert (sum == 0);
+
+	double d = 0;
+	double dsum = 0;
+	sw.restart();
+	for (int i = 0; i < count; ++i)
+	{
+		dsum += std::strtod(floats[i % floats.size()].c_str(), 0);
+	}
+	sw.stop();
+	double timeStrtod = sw.elapsed()/1000.0;
+
+	sw.restart();
+	for (int i = 0; i < count; ++i)
+	{
+		const std::string& s = floats[i % floats.size()];
+		NumberParser::tryParseFloat(s.data(), s.size(), d);
+		dsum -= d;
+	}
+	sw.stop();
+	double timeParseFloat = sw.elapsed()/1000.0;
+
+	std::cout << std::endl;
+	std::cout << std::setw(24) << "sscanf:" << std::setw(10) << timeScanf << " [ms]" << std::endl;
+	std::cout << std::setw(24) << "tryParse64:" << std::setw(10) << timeParse64 << " [ms]" << std::endl;
+	std::cout << std::setw(24) << "strtod:" << std::setw(10) << timeStrtod << " [ms]" << std::endl;
+	std::cout << std::setw(24) << "tryParseFloat:" << std::setw(10) << timeParseFloat << " [ms] " << dsum << std::endl;
+}
+
+
 void NumberParserTest::setUp()
 {
 }
@@ -320,6 +477,9 @@ CppUnit::Test* NumberParserTest::suite()
 	CppUnit_addTest(pSuite, NumberParserTest, testParse);
 	CppUnit_addTest(pSuite, NumberParserTest, testLimits);
 	CppUnit_addTest(pSuite, NumberParserTest, testParseError);
+	CppUnit_addTest(pSuite, NumberParserTest, testParseRange);
+	CppUnit_addTest(pSuite, NumberParserTest, testOverflow);
+	//CppUnit_addTest(pSuite, NumberParserTest, benchmarkParse);
 
 	return pSuite;
 }
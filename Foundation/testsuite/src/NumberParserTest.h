@@ -31,6 +31,9 @@ public:
 	void testParse();
 	void testLimits();
 	void testParseError();
+	void testParseRange();
+	void testOverflow();
+	void benchmarkParse();
 
 	void setUp();
 	void tearDown();
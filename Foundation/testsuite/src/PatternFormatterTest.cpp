@@ -14,11 +14,23 @@
 #include "Poco/PatternFormatter.h"
 #include "Poco/Message.h"
 #include "Poco/DateTime.h"
+#include "Poco/Timezone.h"
+#include "Poco/Timespan.h"
+#include "Poco/DateTimeFormatter.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/AutoPtr.h"
+#include <vector>
+#include <iostream>
 
 
 using Poco::PatternFormatter;
 using Poco::Message;
 using Poco::DateTime;
+using Poco::Timezone;
+using Poco::Timespan;
+using Poco::DateTimeFormatter;
+using Poco::Stopwatch;
+using Poco::AutoPtr;
 
 
 PatternFormatterTest::PatternFormatterTest(const std::string& name): CppUnit::TestCase(name)
@@ -94,6 +106,101 @@ void PatternFormatterTest::testPatternFormatter()
 }
 
 
+void PatternFormatterTest::testCachedTime()
+{
+	Message msg("TestSource", "Text", Message::PRIO_INFORMATION);
+	PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i %F %c %t");
+
+	std::string result;
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 500, 250).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2005-01-01 14:30:15.500 500250 5 Text");
+
+	result.clear();
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15, 7, 3).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2005-01-01 14:30:15.007 007003 0 Text");
+
+	result.clear();
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 16).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2005-01-01 14:30:16.000 000000 0 Text");
+
+	result.clear();
+	msg.setTime(DateTime(2004, 12, 31, 23, 59, 59, 999).timestamp());
+	fmt.format(msg, result);
+	assert (result == "2004-12-31 23:59:59.999 999000 9 Text");
+
+	// pre-epoch times
+	result.clear();
+	msg.setTime(DateTime(1969, 12, 31, 23, 59, 58, 250).timestamp());
+	fmt.format(msg, result);
+	assert (result == "1969-12-31 23:59:58.250 250000 2 Text");
+
+	// many formatters used by the same thread
+	std::vector<AutoPtr<PatternFormatter> > formatters;
+	for (int i = 0; i < 10; ++i)
+	{
+		formatters.push_back(new PatternFormatter(i % 2 ? "%H:%M:%S" : "%Y"));
+	}
+	msg.setTime(DateTime(2005, 1, 1, 14, 30, 15).timestamp());
+	for (int n = 0; n < 2; ++n)
+	{
+		for (int i = 0; i < 10; ++i)
+		{
+			result.clear();
+			formatters[i]->format(msg, result);
+			assert (result == (i % 2 ? "14:30:15" : "2005"));
+		}
+	}
+}
+
+
+void PatternFormatterTest::testLocalTime()
+{
+	Message msg("TestSource", "Text", Message::PRIO_INFORMATION);
+	DateTime utc(2005, 1, 1, 14, 30, 15);
+	msg.setTime(utc.timestamp());
+	DateTime local = utc + Timespan(Timezone::tzd(), 0);
+
+	std::string result;
+	PatternFormatter fmt("%H:%M:%S %Z %L%H:%M:%S %Z");
+	fmt.format(msg, result);
+	assert (result == DateTimeFormatter::format(utc, "%H:%M:%S GMT ") + DateTimeFormatter::format(local, "%H:%M:%S ") + DateTimeFormatter::tzdRFC(Timezone::tzd()));
+
+	result.clear();
+	fmt.setProperty("pattern", "%H:%M:%S %z");
+	fmt.setProperty("times", "local");
+	fmt.format(msg, result);
+	assert (result == DateTimeFormatter::format(local, "%H:%M:%S ") + DateTimeFormatter::tzdISO(Timezone::tzd()));
+
+	result.clear();
+	fmt.setProperty("times", "UTC");
+	fmt.format(msg, result);
+	assert (result == "14:30:15 Z");
+}
+
+
+void PatternFormatterTest::benchmarkFormat()
+{
+	const int count = 1000000;
+	PatternFormatter fmt("%Y-%m-%d %H:%M:%S.%i [%P:%I] <%p> %s: %t");
+	fmt.setProperty("times", "local");
+	Message msg("HTTPServer", "GET /index.html HTTP/1.1 200 1234", Message::PRIO_INFORMATION);
+	std::string result;
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < count; ++i)
+	{
+		result.clear();
+		msg.setTime(msg.getTime() + 10);
+		fmt.format(msg, result);
+	}
+	sw.stop();
+	std::cout << std::endl << "PatternFormatter: " << sw.elapsed()*1000.0/count << " [ns/message]" << std::endl;
+}
+
+
 void PatternFormatterTest::setUp()
 {
 }
@@ -109,6 +216,9 @@ CppUnit::Test* PatternFormatterTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("PatternFormatterTest");
 
 	CppUnit_addTest(pSuite, PatternFormatterTest, testPatternFormatter);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testCachedTime);
+	CppUnit_addTest(pSuite, PatternFormatterTest, testLocalTime);
+	// CppUnit_addTest(pSuite, PatternFormatterTest, benchmarkFormat);
 
 	return pSuite;
 }
@@ -25,6 +25,9 @@ public:
 	~PatternFormatterTest();
 
 	void testPatternFormatter();
+	void testCachedTime();
+	void testLocalTime();
+	void benchmarkFormat();
 
 	void setUp();
 	void tearDown();
@@ -12,11 +12,16 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/RegularExpression.h"
+#include "Poco/RegularExpressionCache.h"
 #include "Poco/Exception.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
 
 
 using Poco::RegularExpression;
+using Poco::RegularExpressionCache;
 using Poco::RegularExpressionException;
+using Poco::Stopwatch;
 
 
 RegularExpressionTest::RegularExpressionTest(const std::string& name): CppUnit::TestCase(name)
@@ -263,6 +268,147 @@ void RegularExpressionTest::testError()
 }
 
 
+void RegularExpressionTest::testManyGroups()
+{
+	std::string pattern;
+	std::string subject;
+	for (int i = 0; i < 30; ++i)
+	{
+		pattern += "([a-z])";
+		subject += char('a' + i % 26);
+	}
+	RegularExpression re(pattern);
+	RegularExpression::MatchVec matches;
+	assert (re.match(subject, 0, matches) == 31);
+	assert (matches.size() == 31);
+	assert (matches[0].offset == 0 && matches[0].length == 30);
+	assert (matches[30].offset == 29 && matches[30].length == 1);
+
+	std::vector<std::string> strings;
+	assert (re.split(subject, strings) == 31);
+	assert (strings[0] == subject);
+	assert (strings[27] == "a");
+
+	std::string s = subject;
+	assert (re.subst(s, "$2$1") == 1);
+	assert (s == "ba");
+}
+
+
+void RegularExpressionTest::testUTF8()
+{
+	RegularExpression re("^\\w+ (.)$", RegularExpression::RE_UTF8);
+	RegularExpression::MatchVec matches;
+	assert (re.match("abc \xC3\xA4", 0, matches) == 2);
+	assert (matches[1].offset == 4 && matches[1].length == 2);
+
+	assert (RegularExpression::match("\xE2\x82\xAC", "^.$", RegularExpression::RE_UTF8));
+	assert (!RegularExpression::match("\xE2\x82\xAC", "^.$"));
+
+	try
+	{
+		re.match("abc \xC3", 0, matches);
+		failmsg("invalid UTF-8 - must throw exception");
+	}
+	catch (RegularExpressionException&)
+	{
+	}
+
+	try
+	{
+		re.match("abc \xC3\xA4", 5, matches);
+		failmsg("offset inside character - must throw exception");
+	}
+	catch (RegularExpressionException&)
+	{
+	}
+
+	assert (re.match("abc \xC3\xA4", 0, matches, RegularExpression::RE_NO_UTF8_CHECK) == 2);
+}
+
+
+void RegularExpressionTest::testCache()
+{
+	RegularExpressionCache cache(64);
+	RegularExpressionCache::Ptr pRE1 = cache.get("[0-9]+");
+	RegularExpressionCache::Ptr pRE2 = cache.get("[0-9]+");
+	RegularExpressionCache::Ptr pRE3 = cache.get("[0-9]+", RegularExpression::RE_CASELESS);
+	assert (pRE1.get() == pRE2.get());
+	assert (pRE1.get() != pRE3.get());
+	assert (cache.size() == 2);
+	assert (pRE1->match("123"));
+
+	for (int i = 0; i < 100; ++i)
+	{
+		cache.get(std::string(i + 1, 'a'));
+	}
+	assert (cache.size() <= 64);
+	assert (pRE1->match("456"));
+
+	try
+	{
+		cache.get("(0-9]");
+		failmsg("bad regexp - must throw exception");
+	}
+	catch (RegularExpressionException&)
+	{
+	}
+
+	cache.clear();
+	assert (cache.size() == 0);
+
+	assert (RegularExpression::match("abc", "[a-z]+"));
+	assert (RegularExpressionCache::defaultCache().get("[a-z]+")->match("def"));
+}
+
+
+void RegularExpressionTest::benchmarkMatch()
+{
+	// Validator style: match against a pattern given as string.
+	const int rounds = 100000;
+	std::string value("2019-05-27T10:32:00");
+	std::string pattern("[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9]{2}:[0-9]{2}:[0-9]{2}");
+	int matches = 0;
+	Stopwatch sw;
+	sw.start();
+	for (int i = 0; i < rounds; ++i)
+	{
+		RegularExpression re(pattern, RegularExpression::RE_ANCHORED | RegularExpression::RE_UTF8, false);
+		if (re.match(value, 0, RegularExpression::RE_ANCHORED)) ++matches;
+	}
+	sw.stop();
+	std::cout << "compile and match: " << sw.elapsed()*1000.0/rounds << " ns/match" << std::endl;
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		if (RegularExpression::match(value, pattern, RegularExpression::RE_ANCHORED | RegularExpression::RE_UTF8)) ++matches;
+	}
+	sw.stop();
+	std::cout << "cached match: " << sw.elapsed()*1000.0/rounds << " ns/match" << std::endl;
+	assert (matches == 2*rounds);
+
+	// Glob style: filter file names with a precompiled pattern.
+	std::vector<std::string> names;
+	for (int i = 0; i < 1000; ++i)
+	{
+		names.push_back("src/module" + std::to_string(i) + (i % 3 ? ".cpp" : ".h"));
+	}
+	RegularExpression re("^src/[^/]*\\.cpp$");
+	matches = 0;
+	sw.restart();
+	for (int r = 0; r < 100; ++r)
+	{
+		for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+		{
+			if (re.match(*it, 0, 0)) ++matches;
+		}
+	}
+	sw.stop();
+	std::cout << "glob match: " << sw.elapsed()*1000.0/(100*names.size()) << " ns/match" << std::endl;
+	assert (matches == 66600);
+}
+
+
 void RegularExpressionTest::setUp()
 {
 }
@@ -292,6 +438,10 @@ CppUnit::Test* RegularExpressionTest::suite()
 	CppUnit_addTest(pSuite, RegularExpressionTest, testSubst3);
 	CppUnit_addTest(pSuite, RegularExpressionTest, testSubst4);
 	CppUnit_addTest(pSuite, RegularExpressionTest, testError);
+	CppUnit_addTest(pSuite, RegularExpressionTest, testManyGroups);
+	CppUnit_addTest(pSuite, RegularExpressionTest, testUTF8);
+	CppUnit_addTest(pSuite, RegularExpressionTest, testCache);
+	//CppUnit_addTest(pSuite, RegularExpressionTest, benchmarkMatch);
 
 	return pSuite;
 }
@@ -39,6 +39,10 @@ public:
 	void testSubst3();
 	void testSubst4();
 	void testError();
+	void testManyGroups();
+	void testUTF8();
+	void testCache();
+	void benchmarkMatch();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,377 @@
+//
+// RingBufferChannelTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "RingBufferChannelTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/RingBufferChannel.h"
+#include "Poco/AsyncChannel.h"
+#include "Poco/NullChannel.h"
+#include "Poco/AutoPtr.h"
+#include "Poco/Message.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Event.h"
+#include "Poco/Stopwatch.h"
+#include "Poco/NumberFormatter.h"
+#include "Poco/NumberParser.h"
+#include "Poco/Exception.h"
+#include "TestChannel.h"
+#include <atomic>
+#include <vector>
+#include <iostream>
+
+
+using Poco::RingBufferChannel;
+using Poco::AsyncChannel;
+using Poco::NullChannel;
+using Poco::Channel;
+using Poco::Message;
+using Poco::AutoPtr;
+using Poco::Thread;
+using Poco::Runnable;
+using Poco::Event;
+using Poco::Stopwatch;
+using Poco::NumberFormatter;
+using Poco::NumberParser;
+
+
+namespace
+{
+	class GateChannel: public Channel
+		/// Blocks in log() until the gate is opened.
+	{
+	public:
+		GateChannel():
+			_gate(false),
+			_count(0)
+		{
+		}
+
+		void log(const Message&)
+		{
+			_gate.wait();
+			++_count;
+		}
+
+		void openGate()
+		{
+			_gate.set();
+		}
+
+		int count() const
+		{
+			return _count;
+		}
+
+	private:
+		Event _gate;
+		std::atomic<int> _count;
+	};
+
+	class LogRunnable: public Runnable
+	{
+	public:
+		LogRunnable(Channel& channel, const std::string& source, int count):
+			_channel(channel),
+			_source(source),
+			_count(count)
+		{
+		}
+
+		void run()
+		{
+			for (int i = 0; i < _count; ++i)
+			{
+				_channel.log(Message(_source, NumberFormatter::format(i), Message::PRIO_INFORMATION));
+			}
+		}
+
+	private:
+		Channel& _channel;
+		std::string _source;
+		int _count;
+	};
+
+	double runThreads(Channel& channel, int threads, int count)
+	{
+		std::vector<LogRunnable*> runnables;
+		std::vector<Thread*> workers;
+		for (int i = 0; i < threads; ++i)
+		{
+			runnables.push_back(new LogRunnable(channel, "Benchmark", count));
+			workers.push_back(new Thread);
+		}
+		Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < threads; ++i) workers[i]->start(*runnables[i]);
+		for (int i = 0; i < threads; ++i) workers[i]->join();
+		sw.stop();
+		for (int i = 0; i < threads; ++i)
+		{
+			delete workers[i];
+			delete runnables[i];
+		}
+		return sw.elapsed()*1000.0/count;
+	}
+}
+
+
+RingBufferChannelTest::RingBufferChannelTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+RingBufferChannelTest::~RingBufferChannelTest()
+{
+}
+
+
+void RingBufferChannelTest::testLog()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<RingBufferChannel> pRing = new RingBufferChannel(pChannel);
+	Message msg("Source", "Text", Message::PRIO_WARNING, __FILE__, __LINE__);
+	msg.setThread("Thread");
+	msg.setTid(42);
+	pRing->log(msg);
+	pRing->log(Message("Source2", "Text2", Message::PRIO_ERROR));
+	pRing->close();
+	assert (pChannel->list().size() == 2);
+
+	const Message& msg1 = pChannel->list().front();
+	assert (msg1.getSource() == "Source");
+	assert (msg1.getText() == "Text");
+	assert (msg1.getPriority() == Message::PRIO_WARNING);
+	assert (msg1.getThread() == "Thread");
+	assert (msg1.getTid() == 42);
+	assert (msg1.getPid() == msg.getPid());
+	assert (msg1.getTime() == msg.getTime());
+	assert (msg1.getSourceFile() == msg.getSourceFile());
+	assert (msg1.getSourceLine() == msg.getSourceLine());
+
+	const Message& msg2 = pChannel->list().back();
+	assert (msg2.getSource() == "Source2");
+	assert (msg2.getText() == "Text2");
+	assert (msg2.getPriority() == Message::PRIO_ERROR);
+	assert (msg2.getSourceFile() == 0);
+
+	pRing->log(msg);
+	pRing->flush();
+	assert (pChannel->list().size() == 3);
+	assert (pRing->droppedMessages() == 0);
+}
+
+
+void RingBufferChannelTest::testLongMessage()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<RingBufferChannel> pRing = new RingBufferChannel(pChannel);
+	std::string text(1000, 'x');
+	pRing->log(Message("Source", text, Message::PRIO_INFORMATION));
+	Message msg("Source", "Text", Message::PRIO_INFORMATION);
+	msg.set("param", "value");
+	pRing->log(msg);
+	pRing->flush();
+	assert (pChannel->list().size() == 2);
+	assert (pChannel->list().front().getText() == text);
+	assert (pChannel->list().back().get("param") == "value");
+}
+
+
+void RingBufferChannelTest::testThreads()
+{
+	const int threads = 4;
+	const int count = 2000;
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<RingBufferChannel> pRing = new RingBufferChannel(pChannel, 64);
+	std::vector<LogRunnable*> runnables;
+	std::vector<Thread*> workers;
+	for (int i = 0; i < threads; ++i)
+	{
+		runnables.push_back(new LogRunnable(*pRing, NumberFormatter::format(i), count));
+		workers.push_back(new Thread);
+	}
+	for (int i = 0; i < threads; ++i) workers[i]->start(*runnables[i]);
+	for (int i = 0; i < threads; ++i) workers[i]->join();
+	pRing->close();
+	for (int i = 0; i < threads; ++i)
+	{
+		delete workers[i];
+		delete runnables[i];
+	}
+
+	assert (pChannel->list().size() == threads*count);
+	std::vector<int> next(threads, 0);
+	for (TestChannel::MsgList::const_iterator it = pChannel->list().begin(); it != pChannel->list().end(); ++it)
+	{
+		int t = NumberParser::parse(it->getSource());
+		assert (NumberParser::parse(it->getText()) == next[t]);
+		++next[t];
+	}
+}
+
+
+void RingBufferChannelTest::testThreadExit()
+{
+	AutoPtr<TestChannel> pChannel = new TestChannel;
+	AutoPtr<RingBufferChannel> pRing = new RingBufferChannel(pChannel);
+	for (int i = 0; i < 10; ++i)
+	{
+		LogRunnable runnable(*pRing, "Source", 10);
+		Thread thread;
+		thread.start(runnable);
+		thread.join();
+	}
+	pRing->flush();
+	assert (pChannel->list().size() == 100);
+
+	// rings of terminated threads are discarded
+	pRing->log(Message("Source", "Text", Message::PRIO_INFORMATION));
+	pRing->flush();
+	assert (pChannel->list().size() == 101);
+}
+
+
+void RingBufferChannelTest::testOverflowBlock()
+{
+	AutoPtr<GateChannel> pChannel = new GateChannel;
+	AutoPtr<RingBufferChannel> pRing = new RingBufferChannel(pChannel, 4, RingBufferChannel::OVERFLOW_BLOCK);
+	LogRunnable runnable(*pRing, "Source", 100);
+	Thread thread;
+	thread.start(runnable);
+	Thread::sleep(100);
+	assert (thread.isRunning());
+	pChannel->openGate();
+	thread.join();
+	pRing->close();
+	assert (pChannel->count() == 100);
+	assert (pRing->droppedMessages() == 0);
+}
+
+
+void RingBufferChannelTest::testOverflowDrop()
+{
+	AutoPtr<GateChannel> pChannel = new GateChannel;
+	AutoPtr<RingBufferChannel> pRing = new RingBufferChannel(pChannel, 4, RingBufferChannel::OVERFLOW_DROP);
+	for (int i = 0; i < 100; ++i)
+	{
+		pRing->log(Message("Source", "Text", Message::PRIO_INFORMATION));
+	}
+	assert (pRing->droppedMessages() >= 95);
+	pChannel->openGate();
+	pRing->close();
+	assert (pChannel->count() + pRing->droppedMessages() == 100);
+}
+
+
+void RingBufferChannelTest::testOverflowSample()
+{
+	AutoPtr<GateChannel> pChannel = new GateChannel;
+	AutoPtr<RingBufferChannel> pRing = new RingBufferChannel(pChannel, 16, RingBufferChannel::OVERFLOW_SAMPLE);
+	pRing->setSampleRate(4);
+	for (int i = 0; i < 100; ++i)
+	{
+		pRing->log(Message("Source", "Text", Message::PRIO_INFORMATION));
+	}
+	pChannel->openGate();
+	pRing->close();
+	assert (pChannel->count() >= 16);
+	assert (pRing->droppedMessages() >= 60);
+	assert (pChannel->count() + pRing->droppedMessages() == 100);
+}
+
+
+void RingBufferChannelTest::testProperties()
+{
+	AutoPtr<RingBufferChannel> pRing = new RingBufferChannel;
+	assert (pRing->getProperty(RingBufferChannel::PROP_CAPACITY) == "1024");
+	assert (pRing->getProperty(RingBufferChannel::PROP_OVERFLOW) == "block");
+	assert (pRing->getProperty(RingBufferChannel::PROP_SAMPLERATE) == "10");
+
+	pRing->setProperty(RingBufferChannel::PROP_CAPACITY, "100");
+	assert (pRing->getCapacity() == 128);
+	pRing->setProperty(RingBufferChannel::PROP_OVERFLOW, "drop");
+	assert (pRing->getOverflowPolicy() == RingBufferChannel::OVERFLOW_DROP);
+	pRing->setProperty(RingBufferChannel::PROP_OVERFLOW, "sample");
+	assert (pRing->getProperty(RingBufferChannel::PROP_OVERFLOW) == "sample");
+	pRing->setProperty(RingBufferChannel::PROP_SAMPLERATE, "100");
+	assert (pRing->getSampleRate() == 100);
+
+	try
+	{
+		pRing->setProperty(RingBufferChannel::PROP_OVERFLOW, "wait");
+		fail("invalid overflow policy - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+
+	try
+	{
+		pRing->setProperty(RingBufferChannel::PROP_SAMPLERATE, "0");
+		fail("invalid sample rate - must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void RingBufferChannelTest::benchmarkLog()
+{
+	const int count = 100000;
+	AutoPtr<NullChannel> pNull = new NullChannel;
+
+	for (int threads = 1; threads <= 32; threads *= 2)
+	{
+		AutoPtr<AsyncChannel> pAsync = new AsyncChannel(pNull);
+		pAsync->open();
+		double nsAsync = runThreads(*pAsync, threads, count);
+		pAsync->close();
+
+		AutoPtr<RingBufferChannel> pRing = new RingBufferChannel(pNull, 8192);
+		pRing->open();
+		double nsRing = runThreads(*pRing, threads, count);
+		pRing->close();
+
+		std::cout << std::endl << threads << " thread(s), " << count << " messages per thread:" << std::endl;
+		std::cout << "AsyncChannel:      " << nsAsync << " [ns/log]" << std::endl;
+		std::cout << "RingBufferChannel: " << nsRing << " [ns/log]" << std::endl;
+	}
+}
+
+
+void RingBufferChannelTest::setUp()
+{
+}
+
+
+void RingBufferChannelTest::tearDown()
+{
+}
+
+
+CppUnit::Test* RingBufferChannelTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("RingBufferChannelTest");
+
+	CppUnit_addTest(pSuite, RingBufferChannelTest, testLog);
+	CppUnit_addTest(pSuite, RingBufferChannelTest, testLongMessage);
+	CppUnit_addTest(pSuite, RingBufferChannelTest, testThreads);
+	CppUnit_addTest(pSuite, RingBufferChannelTest, testThreadExit);
+	CppUnit_addTest(pSuite, RingBufferChannelTest, testOverflowBlock);
+	CppUnit_addTest(pSuite, RingBufferChannelTest, testOverflowDrop);
+	CppUnit_addTest(pSuite, RingBufferChannelTest, testOverflowSample);
+	CppUnit_addTest(pSuite, RingBufferChannelTest, testProperties);
+	// CppUnit_addTest(pSuite, RingBufferChannelTest, benchmarkLog);
+
+	return pSuite;
+}
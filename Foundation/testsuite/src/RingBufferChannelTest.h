@@ -0,0 +1,46 @@
+//
+// RingBufferChannelTest.h
+//
+// Definition of the RingBufferChannelTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef RingBufferChannelTest_INCLUDED
+#define RingBufferChannelTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class RingBufferChannelTest: public CppUnit::TestCase
+{
+public:
+	RingBufferChannelTest(const std::string& name);
+	~RingBufferChannelTest();
+
+	void testLog();
+	void testLongMessage();
+	void testThreads();
+	void testThreadExit();
+	void testOverflowBlock();
+	void testOverflowDrop();
+	void testOverflowSample();
+	void testProperties();
+	void benchmarkLog();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // RingBufferChannelTest_INCLUDED
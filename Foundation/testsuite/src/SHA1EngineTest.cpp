@@ -46,6 +46,27 @@ void SHA1EngineTest::testSHA1()
 }
 
 
+void SHA1EngineTest::testBlocks()
+{
+	SHA1Engine engine;
+
+	engine.update(std::string(1000000, 'a'));
+	assert (DigestEngine::digestToHex(engine.digest()) == "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+
+	// the digest must not depend on how the data is split into updates
+	std::string data;
+	for (int i = 0; i < 10000; ++i) data += static_cast<char>(i*31 + i/5);
+	engine.update(data);
+	std::string expected = DigestEngine::digestToHex(engine.digest());
+	for (std::size_t first = 0; first < 130; first += 3)
+	{
+		engine.update(data.data(), first);
+		engine.update(data.data() + first, data.size() - first);
+		assert (DigestEngine::digestToHex(engine.digest()) == expected);
+	}
+}
+
+
 void SHA1EngineTest::setUp()
 {
 }
@@ -61,6 +82,7 @@ CppUnit::Test* SHA1EngineTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SHA1EngineTest");
 
 	CppUnit_addTest(pSuite, SHA1EngineTest, testSHA1);
+	CppUnit_addTest(pSuite, SHA1EngineTest, testBlocks);
 
 	return pSuite;
 }
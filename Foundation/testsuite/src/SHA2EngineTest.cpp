@@ -0,0 +1,210 @@
+//
+// SHA2EngineTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "SHA2EngineTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/SHA2Engine.h"
+#include "Poco/SHA1Engine.h"
+#include "Poco/MD5Engine.h"
+#include "Poco/HMACEngine.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+#include <vector>
+
+
+using Poco::SHA2Engine;
+using Poco::DigestEngine;
+
+
+namespace
+{
+	const std::string MSG1("abc");
+	const std::string MSG2("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+	const std::string MSG3("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu");
+
+	std::string hash(SHA2Engine::ALGORITHM algorithm, const std::string& data)
+	{
+		SHA2Engine engine(algorithm);
+		engine.update(data);
+		return DigestEngine::digestToHex(engine.digest());
+	}
+}
+
+
+SHA2EngineTest::SHA2EngineTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+SHA2EngineTest::~SHA2EngineTest()
+{
+}
+
+
+void SHA2EngineTest::testSHA224()
+{
+	// test vectors from FIPS 180-4 examples
+
+	assert (hash(SHA2Engine::SHA_224, MSG1) == "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7");
+	assert (hash(SHA2Engine::SHA_224, MSG2) == "75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525");
+	assert (hash(SHA2Engine::SHA_224, std::string(1000000, 'a')) == "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67");
+}
+
+
+void SHA2EngineTest::testSHA256()
+{
+	SHA2Engine engine;
+	assert (engine.algorithm() == SHA2Engine::SHA_256);
+	assert (engine.digestLength() == 32);
+	assert (DigestEngine::digestToHex(engine.digest()) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+	engine.update(MSG1);
+	assert (DigestEngine::digestToHex(engine.digest()) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+	engine.update(MSG2);
+	assert (DigestEngine::digestToHex(engine.digest()) == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+	engine.update(MSG3);
+	assert (DigestEngine::digestToHex(engine.digest()) == "cf5b16a778af8380036ce59e7b0492370b249b11e8f07a51afac45037afee9d1");
+
+	for (int i = 0; i < 1000000; ++i)
+		engine.update('a');
+	assert (DigestEngine::digestToHex(engine.digest()) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+
+void SHA2EngineTest::testSHA384()
+{
+	assert (hash(SHA2Engine::SHA_384, "") == "38b060a751ac96384cd9327eb1b1e36a21fdb71114be07434c0cc7bf63f6e1da274edebfe76f65fbd51ad2f14898b95b");
+	assert (hash(SHA2Engine::SHA_384, MSG1) == "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7");
+	assert (hash(SHA2Engine::SHA_384, std::string(1000000, 'a')) == "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985");
+}
+
+
+void SHA2EngineTest::testSHA512()
+{
+	SHA2Engine engine(SHA2Engine::SHA_512);
+	assert (engine.digestLength() == 64);
+	assert (DigestEngine::digestToHex(engine.digest()) == "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+
+	engine.update(MSG1);
+	assert (DigestEngine::digestToHex(engine.digest()) == "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+
+	engine.update(MSG3);
+	assert (DigestEngine::digestToHex(engine.digest()) == "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+
+	for (int i = 0; i < 1000000; ++i)
+		engine.update('a');
+	assert (DigestEngine::digestToHex(engine.digest()) == "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b");
+}
+
+
+void SHA2EngineTest::testBlocks()
+{
+	// the digest must not depend on how the data is split into updates,
+	// including lengths around the block size and the length field
+	std::string data;
+	for (int i = 0; i < 10000; ++i) data += static_cast<char>(i*31 + i/5);
+
+	const SHA2Engine::ALGORITHM algorithms[] = { SHA2Engine::SHA_224, SHA2Engine::SHA_256, SHA2Engine::SHA_384, SHA2Engine::SHA_512 };
+	for (int a = 0; a < 4; ++a)
+	{
+		for (std::size_t length = 0; length < 300; length += 7)
+		{
+			std::string expected = hash(algorithms[a], data.substr(0, length));
+			SHA2Engine engine(algorithms[a]);
+			for (std::size_t i = 0; i < length; ++i) engine.update(data[i]);
+			assert (DigestEngine::digestToHex(engine.digest()) == expected);
+		}
+
+		std::string expected = hash(algorithms[a], data);
+		SHA2Engine engine(algorithms[a]);
+		std::size_t pos = 0;
+		std::size_t block = 1;
+		while (pos < data.size())
+		{
+			std::size_t n = std::min(block, data.size() - pos);
+			engine.update(data.data() + pos, n);
+			pos += n;
+			block = block*2 + 1;
+		}
+		assert (DigestEngine::digestToHex(engine.digest()) == expected);
+	}
+}
+
+
+void SHA2EngineTest::testHMAC()
+{
+	// test case 2 from RFC 4231
+	std::string key("Jefe");
+	std::string data("what do ya want for nothing?");
+
+	Poco::HMACEngine<Poco::SHA2Engine256> hmac256(key);
+	hmac256.update(data);
+	assert (DigestEngine::digestToHex(hmac256.digest()) == "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+
+	Poco::HMACEngine<Poco::SHA2Engine512> hmac512(key);
+	hmac512.update(data);
+	assert (DigestEngine::digestToHex(hmac512.digest()) == "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea2505549758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737");
+}
+
+
+void SHA2EngineTest::benchmarkDigest()
+{
+	const std::size_t size = 1024*1024;
+	const int rounds = 100;
+	std::vector<char> data(size);
+	for (std::size_t i = 0; i < size; ++i) data[i] = static_cast<char>(i*31 + i/5);
+
+	Poco::MD5Engine md5;
+	Poco::SHA1Engine sha1;
+	SHA2Engine sha256(SHA2Engine::SHA_256);
+	SHA2Engine sha512(SHA2Engine::SHA_512);
+	DigestEngine* engines[] = { &md5, &sha1, &sha256, &sha512 };
+	const char* names[] = { "MD5:     ", "SHA-1:   ", "SHA-256: ", "SHA-512: " };
+
+	std::cout << std::endl;
+	for (int e = 0; e < 4; ++e)
+	{
+		Poco::Stopwatch sw;
+		sw.start();
+		for (int i = 0; i < rounds; ++i) engines[e]->update(&data[0], size);
+		engines[e]->digest();
+		sw.stop();
+		std::cout << names[e] << double(size)*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e9 << " GB/s" << std::endl;
+	}
+}
+
+
+void SHA2EngineTest::setUp()
+{
+}
+
+
+void SHA2EngineTest::tearDown()
+{
+}
+
+
+CppUnit::Test* SHA2EngineTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("SHA2EngineTest");
+
+	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA224);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA256);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA384);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testSHA512);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testBlocks);
+	CppUnit_addTest(pSuite, SHA2EngineTest, testHMAC);
+	//CppUnit_addTest(pSuite, SHA2EngineTest, benchmarkDigest);
+
+	return pSuite;
+}
@@ -12,10 +12,16 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/SharedPtr.h"
+#include "Poco/AtomicCounter.h"
+#include "Poco/Stopwatch.h"
 #include "Poco/Exception.h"
+#include <vector>
+#include <iostream>
 
 
 using Poco::SharedPtr;
+using Poco::makeShared;
+using Poco::NonAtomicReferenceCounter;
 using Poco::NullPointerException;
 
 
@@ -51,6 +57,56 @@ namespace
 	
 	int TestObject::_count = 0;
 
+	class ThrowingObject: public TestObject
+	{
+	public:
+		ThrowingObject(): TestObject("throw")
+		{
+			throw Poco::InvalidArgumentException("ThrowingObject");
+		}
+	};
+
+	class SeqCstReferenceCounter
+		/// The previous ReferenceCounter implementation, for benchmarks.
+	{
+	public:
+		SeqCstReferenceCounter(): _cnt(1)
+		{
+		}
+
+		void duplicate()
+		{
+			++_cnt;
+		}
+
+		int release()
+		{
+			return --_cnt;
+		}
+
+		int referenceCount() const
+		{
+			return _cnt.value();
+		}
+
+	private:
+		Poco::AtomicCounter _cnt;
+	};
+
+	template <class P>
+	double benchmarkCopies(const P& ptr, int n)
+	{
+		Poco::Stopwatch sw;
+		std::vector<P> copies(16);
+		sw.start();
+		for (int i = 0; i < n; ++i)
+		{
+			copies[i & 15] = ptr;
+		}
+		sw.stop();
+		return sw.elapsed()/1000.0;
+	}
+
 	class DerivedObject: public TestObject
 	{
 	public:
@@ -195,6 +251,143 @@ void SharedPtrTest::testExplicitCast()
 }
 
 
+void SharedPtrTest::testMove()
+{
+	SharedPtr<TestObject> ptr1 = new TestObject("one");
+	assert (ptr1.referenceCount() == 1);
+	SharedPtr<TestObject> ptr2(std::move(ptr1));
+	assert (ptr2.referenceCount() == 1);
+	assert (ptr2->data() == "one");
+	assert (ptr1.isNull());
+	assert (ptr1.referenceCount() == 0);
+
+	// moved-from pointers can be cast
+	SharedPtr<DerivedObject> pDerived = ptr1.unsafeCast<DerivedObject>();
+	assert (pDerived.isNull());
+	assert (pDerived.referenceCount() == 1);
+	pDerived = ptr1.cast<DerivedObject>();
+	assert (pDerived.isNull());
+	assert (pDerived.referenceCount() == 1);
+	SharedPtr<TestObject> pCopy(ptr1.unsafeCast<TestObject>());
+	assert (pCopy.isNull());
+
+	SharedPtr<TestObject> ptr3;
+	ptr3 = std::move(ptr2);
+	assert (ptr3.referenceCount() == 1);
+	assert (ptr2.isNull());
+	assert (TestObject::count() == 1);
+
+	// moved-from pointers can be assigned and copied
+	ptr2 = ptr3;
+	assert (ptr3.referenceCount() == 2);
+	SharedPtr<TestObject> ptr4(ptr1);
+	assert (ptr4.isNull());
+	ptr1 = new TestObject("two");
+	assert (TestObject::count() == 2);
+
+	std::vector<SharedPtr<TestObject> > vec;
+	for (int i = 0; i < 100; ++i)
+	{
+		vec.push_back(ptr3);
+	}
+	assert (ptr3.referenceCount() == 102);
+	vec.clear();
+	assert (ptr3.referenceCount() == 2);
+
+	ptr1 = 0;
+	ptr2 = 0;
+	ptr3 = 0;
+	assert (TestObject::count() == 0);
+}
+
+
+void SharedPtrTest::testMakeShared()
+{
+	{
+		SharedPtr<TestObject> ptr1 = makeShared<TestObject>("one");
+		assert (TestObject::count() == 1);
+		assert (ptr1->data() == "one");
+		assert (ptr1.referenceCount() == 1);
+
+		SharedPtr<TestObject> ptr2 = ptr1;
+		assert (ptr1.referenceCount() == 2);
+		ptr1 = 0;
+		assert (TestObject::count() == 1);
+		assert (ptr2.referenceCount() == 1);
+	}
+	assert (TestObject::count() == 0);
+
+	{
+		SharedPtr<TestObject> ptr1 = makeShared<DerivedObject>("derived", 42);
+		assert (TestObject::count() == 1);
+		SharedPtr<DerivedObject> ptr2 = ptr1.cast<DerivedObject>();
+		assert (ptr2->number() == 42);
+		ptr1 = 0;
+		assert (ptr2.referenceCount() == 1);
+	}
+	assert (TestObject::count() == 0);
+
+	try
+	{
+		SharedPtr<ThrowingObject> ptr = makeShared<ThrowingObject>();
+		fail ("must throw");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+	assert (TestObject::count() == 0);
+
+	SharedPtr<std::string> pStr = makeShared<std::string>(5, 'x');
+	assert (*pStr == "xxxxx");
+}
+
+
+void SharedPtrTest::testNonAtomic()
+{
+	typedef SharedPtr<TestObject, NonAtomicReferenceCounter> Ptr;
+	{
+		Ptr ptr1 = new TestObject("one");
+		Ptr ptr2 = ptr1;
+		assert (ptr1.referenceCount() == 2);
+		ptr1 = 0;
+		assert (ptr2.referenceCount() == 1);
+		assert (TestObject::count() == 1);
+
+		Ptr ptr3 = makeShared<TestObject, NonAtomicReferenceCounter>("two");
+		assert (ptr3->data() == "two");
+		assert (TestObject::count() == 2);
+	}
+	assert (TestObject::count() == 0);
+}
+
+
+void SharedPtrTest::benchmarkSharedPtr()
+{
+	const int N = 10000000;
+	Poco::Stopwatch sw;
+
+	sw.start();
+	for (int i = 0; i < N; ++i)
+	{
+		SharedPtr<int> ptr(new int(i));
+	}
+	sw.stop();
+	std::cout << std::endl << "SharedPtr(new int):          " << sw.elapsed()/1000.0 << " [ms]" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < N; ++i)
+	{
+		SharedPtr<int> ptr = makeShared<int>(i);
+	}
+	sw.stop();
+	std::cout << "makeShared<int>:             " << sw.elapsed()/1000.0 << " [ms]" << std::endl;
+
+	std::cout << "Copy (sequentially consistent): " << benchmarkCopies(SharedPtr<int, SeqCstReferenceCounter>(new int(1)), N) << " [ms]" << std::endl;
+	std::cout << "Copy (acquire-release):         " << benchmarkCopies(SharedPtr<int>(new int(1)), N) << " [ms]" << std::endl;
+	std::cout << "Copy (non-atomic):              " << benchmarkCopies(SharedPtr<int, NonAtomicReferenceCounter>(new int(1)), N) << " [ms]" << std::endl;
+}
+
+
 void SharedPtrTest::setUp()
 {
 }
@@ -212,6 +405,10 @@ CppUnit::Test* SharedPtrTest::suite()
 	CppUnit_addTest(pSuite, SharedPtrTest, testSharedPtr);
 	CppUnit_addTest(pSuite, SharedPtrTest, testImplicitCast);
 	CppUnit_addTest(pSuite, SharedPtrTest, testExplicitCast);
+	CppUnit_addTest(pSuite, SharedPtrTest, testMove);
+	CppUnit_addTest(pSuite, SharedPtrTest, testMakeShared);
+	CppUnit_addTest(pSuite, SharedPtrTest, testNonAtomic);
+	//CppUnit_addTest(pSuite, SharedPtrTest, benchmarkSharedPtr);
 
 	return pSuite;
 }
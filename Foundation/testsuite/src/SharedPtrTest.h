@@ -28,6 +28,10 @@ public:
 
 	void testImplicitCast();
 	void testExplicitCast();
+	void testMove();
+	void testMakeShared();
+	void testNonAtomic();
+	void benchmarkSharedPtr();
 
 	void setUp();
 	void tearDown();
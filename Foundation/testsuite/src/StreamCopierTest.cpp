@@ -12,10 +12,50 @@
 #include "CppUnit/TestCaller.h"
 #include "CppUnit/TestSuite.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/FileStream.h"
+#include "Poco/PipeStream.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/Stopwatch.h"
 #include <sstream>
+#include <iostream>
+#include <fstream>
 
 
 using Poco::StreamCopier;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::Pipe;
+using Poco::PipeInputStream;
+using Poco::PipeOutputStream;
+using Poco::TemporaryFile;
+
+
+namespace
+{
+	std::string makeData(std::size_t size)
+	{
+		std::string data;
+		data.reserve(size);
+		for (std::size_t i = 0; i < size; ++i) data += char((i*7) % 251);
+		return data;
+	}
+
+
+	void writeFile(const std::string& path, const std::string& data)
+	{
+		FileOutputStream ostr(path);
+		ostr.write(data.data(), data.size());
+	}
+
+
+	std::string readFile(const std::string& path)
+	{
+		FileInputStream istr(path);
+		std::string data;
+		StreamCopier::copyToString(istr, data);
+		return data;
+	}
+}
 
 
 StreamCopierTest::StreamCopierTest(const std::string& name): CppUnit::TestCase(name)
@@ -160,6 +200,123 @@ void StreamCopierTest::testCopyToString64()
 #endif
 
 
+void StreamCopierTest::testCopyFile()
+{
+	TemporaryFile src;
+	TemporaryFile dest;
+	std::string data = makeData(300000);
+	writeFile(src.path(), data);
+	{
+		FileInputStream istr(src.path());
+		FileOutputStream ostr(dest.path());
+		std::streamsize n = StreamCopier::copyStream(istr, ostr);
+		assert (n == data.size());
+		assert (istr.eof());
+		assert (ostr.good());
+		assert (ostr.tellp() == std::streampos(data.size()));
+		ostr << "end";
+	}
+	assert (readFile(dest.path()) == data + "end");
+
+	// data already in the input stream's buffer must be copied first
+	{
+		FileInputStream istr(src.path());
+		char buffer[100];
+		istr.read(buffer, sizeof(buffer));
+		FileOutputStream ostr(dest.path());
+		ostr << "begin";
+		Poco::UInt64 n = StreamCopier::copyStream64(istr, ostr);
+		assert (n == data.size() - sizeof(buffer));
+	}
+	assert (readFile(dest.path()) == "begin" + data.substr(100));
+
+	// empty file
+	{
+		TemporaryFile empty;
+		writeFile(empty.path(), "");
+		FileInputStream istr(empty.path());
+		FileOutputStream ostr(dest.path());
+		std::streamsize n = StreamCopier::copyStream(istr, ostr);
+		assert (n == 0);
+	}
+	assert (readFile(dest.path()).empty());
+}
+
+
+void StreamCopierTest::testCopyFileAppend()
+{
+	TemporaryFile src;
+	TemporaryFile dest;
+	std::string data = makeData(10000);
+	writeFile(src.path(), data);
+	writeFile(dest.path(), "begin");
+	{
+		FileInputStream istr(src.path());
+		FileOutputStream ostr(dest.path(), std::ios::out | std::ios::app);
+		std::streamsize n = StreamCopier::copyStream(istr, ostr);
+		assert (n == data.size());
+	}
+	assert (readFile(dest.path()) == "begin" + data);
+}
+
+
+void StreamCopierTest::testCopyPipe()
+{
+	TemporaryFile src;
+	TemporaryFile dest;
+	std::string data = makeData(20000); // must fit into the pipe's buffer
+	writeFile(src.path(), data);
+
+	Pipe pipe;
+	{
+		FileInputStream istr(src.path());
+		PipeOutputStream ostr(pipe);
+		std::streamsize n = StreamCopier::copyStream(istr, ostr);
+		assert (n == data.size());
+		ostr.flush();
+		pipe.close(Pipe::CLOSE_WRITE);
+	}
+	{
+		PipeInputStream istr(pipe);
+		FileOutputStream ostr(dest.path());
+		std::streamsize n = StreamCopier::copyStream(istr, ostr);
+		assert (n == data.size());
+	}
+	assert (readFile(dest.path()) == data);
+}
+
+
+void StreamCopierTest::benchmarkCopyFile()
+{
+	const std::size_t size = 256*1024*1024;
+	TemporaryFile src;
+	TemporaryFile dest;
+	writeFile(src.path(), makeData(size));
+
+	{
+		FileInputStream istr(src.path());
+		FileOutputStream ostr(dest.path());
+		Poco::Stopwatch sw;
+		sw.start();
+		StreamCopier::copyStream(istr, ostr);
+		ostr.close();
+		sw.stop();
+		std::cout << "copyStream (file to file): " << double(size)*Poco::Stopwatch::resolution()/sw.elapsed()/1e9 << " GB/s" << std::endl;
+	}
+	{
+		// std::filebuf is not a NativeStreamBuf, so this uses the buffered copy
+		std::ifstream istr(src.path().c_str(), std::ios::binary);
+		std::ofstream ostr(dest.path().c_str(), std::ios::binary);
+		Poco::Stopwatch sw;
+		sw.start();
+		StreamCopier::copyStream(istr, ostr);
+		ostr.close();
+		sw.stop();
+		std::cout << "copyStream (file to file, buffered): " << double(size)*Poco::Stopwatch::resolution()/sw.elapsed()/1e9 << " GB/s" << std::endl;
+	}
+}
+
+
 void StreamCopierTest::setUp()
 {
 }
@@ -183,6 +340,10 @@ CppUnit::Test* StreamCopierTest::suite()
 	CppUnit_addTest(pSuite, StreamCopierTest, testUnbufferedCopy64);
 	CppUnit_addTest(pSuite, StreamCopierTest, testCopyToString64);
 #endif
+	CppUnit_addTest(pSuite, StreamCopierTest, testCopyFile);
+	CppUnit_addTest(pSuite, StreamCopierTest, testCopyFileAppend);
+	CppUnit_addTest(pSuite, StreamCopierTest, testCopyPipe);
+	//CppUnit_addTest(pSuite, StreamCopierTest, benchmarkCopyFile);
 
 	return pSuite;
 }
@@ -32,6 +32,10 @@ public:
 	void testUnbufferedCopy64();
 	void testCopyToString64();
 #endif
+	void testCopyFile();
+	void testCopyFileAppend();
+	void testCopyPipe();
+	void benchmarkCopyFile();
 
 	void setUp();
 	void tearDown();
@@ -23,6 +23,9 @@
 #include "FileStreamTest.h"
 #include "MemoryStreamTest.h"
 #include "FIFOBufferStreamTest.h"
+#if defined(POCO_OS_FAMILY_UNIX)
+#include "IOUringTest.h"
+#endif
 
 
 CppUnit::Test* StreamsTestSuite::suite()
@@ -43,6 +46,9 @@ CppUnit::Test* StreamsTestSuite::suite()
 	pSuite->addTest(FileStreamTest::suite());
 	pSuite->addTest(MemoryStreamTest::suite());
 	pSuite->addTest(FIFOBufferStreamTest::suite());
+#if defined(POCO_OS_FAMILY_UNIX)
+	pSuite->addTest(IOUringTest::suite());
+#endif
 
 	return pSuite;
 }
@@ -0,0 +1,46 @@
+//
+// StringRefTest.h
+//
+// Definition of the StringRefTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef StringRefTest_INCLUDED
+#define StringRefTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class StringRefTest: public CppUnit::TestCase
+{
+public:
+	StringRefTest(const std::string& name);
+	~StringRefTest();
+
+	void testStringRef();
+	void testFind();
+	void testFindFirstOf();
+	void testTrim();
+	void testCompare();
+	void testTokenizer();
+	void testTokenizerOptions();
+	void testTokenizerSplit();
+	void benchmarkTokenizer();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // StringRefTest_INCLUDED
@@ -20,6 +20,10 @@
 #include "Poco/Windows1251Encoding.h"
 #include "Poco/Windows1252Encoding.h"
 #include "Poco/UTF8Encoding.h"
+#include "Poco/UTF16Encoding.h"
+#include "Poco/UTF32Encoding.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
 
 
 using namespace Poco;
@@ -326,6 +330,183 @@ void TextConverterTest::testErrors()
 }
 
 
+namespace
+{
+	int identity(int ch)
+	{
+		return ch;
+	}
+}
+
+
+void TextConverterTest::testUTF8toUTF16()
+{
+	UTF8Encoding utf8Encoding;
+	UTF16Encoding utf16Encoding(UTF16Encoding::LITTLE_ENDIAN_BYTE_ORDER);
+	TextConverter converter(utf8Encoding, utf16Encoding);
+
+	// "A\u00e4\u20ac\U0001F600" followed by 40 ASCII characters
+	std::string text("A\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80");
+	std::string ascii("The quick brown fox jumps over a lazy dog");
+	const unsigned char utf16Chars[] = {0x41, 0x00, 0xE4, 0x00, 0xAC, 0x20, 0x3D, 0xD8, 0x00, 0xDE};
+	std::string expected((const char*) utf16Chars, sizeof(utf16Chars));
+	for (std::string::const_iterator it = ascii.begin(); it != ascii.end(); ++it)
+	{
+		expected += *it;
+		expected += '\0';
+	}
+
+	std::string result;
+	int errors = converter.convert(text + ascii, result);
+	assert (result == expected);
+	assert (errors == 0);
+
+	utf16Encoding.setByteOrder(UTF16Encoding::BIG_ENDIAN_BYTE_ORDER);
+	std::string result1;
+	errors = converter.convert(text + ascii, result1);
+	assert (result1.size() == expected.size());
+	for (std::size_t i = 0; i < expected.size(); i += 2)
+	{
+		assert (result1[i] == expected[i + 1] && result1[i + 1] == expected[i]);
+	}
+	assert (errors == 0);
+
+	// invalid sequences
+	std::string result2;
+	errors = converter.convert(std::string("a\xC0\xAF" "b\xED\xA0\x80" "c\xE2\x82"), result2);
+	assert (result2 == std::string("\0a\0?\0b\0?\0c\0?", 12));
+	assert (errors == 3);
+}
+
+
+void TextConverterTest::testUTF16toUTF8()
+{
+	UTF16Encoding utf16Encoding(UTF16Encoding::BIG_ENDIAN_BYTE_ORDER);
+	UTF8Encoding utf8Encoding;
+	TextConverter converter(utf16Encoding, utf8Encoding);
+
+	const unsigned char utf16Chars[] = {0x00, 0x41, 0x00, 0xE4, 0x20, 0xAC, 0xD8, 0x3D, 0xDE, 0x00};
+	std::string result;
+	int errors = converter.convert(utf16Chars, sizeof(utf16Chars), result);
+	assert (result == "A\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80");
+	assert (errors == 0);
+
+	// a high surrogate must be followed by a low surrogate
+	const unsigned char badChars[] = {0xD8, 0x3D, 0xE0, 0x00, 0x00, 0x41, 0xD8};
+	std::string result1;
+	errors = converter.convert(badChars, sizeof(badChars), result1);
+	assert (result1 == "?A?");
+	assert (errors == 2);
+
+	std::string result2;
+	assert (converter.convert(badChars, sizeof(badChars), result2, identity) == 2);
+	assert (result2 == result1);
+}
+
+
+void TextConverterTest::testUTF8toUTF32()
+{
+	UTF8Encoding utf8Encoding;
+	UTF32Encoding utf32Encoding(UTF32Encoding::LITTLE_ENDIAN_BYTE_ORDER);
+	TextConverter converter(utf8Encoding, utf32Encoding);
+	TextConverter reverseConverter(utf32Encoding, utf8Encoding);
+
+	std::string text("abcdefghijklmnopqrstuvwxyz\xC3\xA4\xF0\x9F\x98\x80");
+	std::string utf32Text;
+	int errors = converter.convert(text, utf32Text);
+	assert (utf32Text.size() == 28*4);
+	assert (utf32Text.compare(0, 8, std::string("a\0\0\0b\0\0\0", 8)) == 0);
+	assert (utf32Text.compare(104, 8, std::string("\xE4\0\0\0\0\xF6\x01\0", 8)) == 0);
+	assert (errors == 0);
+
+	std::string result;
+	errors = reverseConverter.convert(utf32Text, result);
+	assert (result == text);
+	assert (errors == 0);
+
+	// code points beyond U+10FFFF cannot be represented in UTF-8
+	const unsigned char badChars[] = {0x00, 0x00, 0x11, 0x00, 0x41, 0x00, 0x00, 0x00};
+	std::string result1;
+	errors = reverseConverter.convert(badChars, sizeof(badChars), result1);
+	assert (result1 == "?A");
+	assert (errors == 0);
+}
+
+
+void TextConverterTest::testFastPath()
+{
+	// conversions without a transform function must give the same
+	// result as conversions with one
+	UTF8Encoding utf8Encoding;
+	Latin1Encoding latin1Encoding;
+	Windows1252Encoding cp1252Encoding;
+	UTF16Encoding utf16Encoding;
+	UTF32Encoding utf32Encoding;
+	TextEncoding* encodings[] = {&utf8Encoding, &latin1Encoding, &cp1252Encoding, &utf16Encoding, &utf32Encoding};
+	const int count = sizeof(encodings)/sizeof(encodings[0]);
+
+	std::string text;
+	for (int i = 0; i < 16; ++i)
+	{
+		text += "The quick brown fox \xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80 jumps over the lazy dog ";
+		text += static_cast<char>(0x80 + i*8);
+		text += static_cast<char>(0xF0 + i);
+		text += static_cast<char>(i);
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		for (int j = 0; j < count; ++j)
+		{
+			TextConverter converter(*encodings[i], *encodings[j], 0xFFFD);
+			std::string result;
+			std::string expected;
+			int errors = converter.convert(text.data(), static_cast<int>(text.size()), result);
+			int expectedErrors = converter.convert(text.data(), static_cast<int>(text.size()), expected, identity);
+			assert (result == expected);
+			assert (errors == expectedErrors);
+		}
+	}
+}
+
+
+void TextConverterTest::benchmarkConvert()
+{
+	std::string ascii;
+	std::string mixed;
+	for (int i = 0; i < 20000; ++i)
+	{
+		ascii += "The quick brown fox jumps over the lazy dog. ";
+		mixed += "Gr\xC3\xBC\xC3\x9F" "e aus K\xC3\xB6ln, \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82! ";
+	}
+	UTF8Encoding utf8Encoding;
+	UTF16Encoding utf16Encoding;
+	Latin1Encoding latin1Encoding;
+	const int rounds = 50;
+
+	std::cout << std::endl;
+	for (int k = 0; k < 2; ++k)
+	{
+		const std::string& text = k == 0 ? ascii : mixed;
+		TextEncoding* outEncodings[] = {&utf16Encoding, &latin1Encoding};
+		const char* names[] = {"UTF-8 to UTF-16:  ", "UTF-8 to Latin-1: "};
+		for (int e = 0; e < 2; ++e)
+		{
+			TextConverter converter(utf8Encoding, *outEncodings[e]);
+			Poco::Stopwatch sw;
+			sw.start();
+			for (int i = 0; i < rounds; ++i)
+			{
+				std::string result;
+				converter.convert(text, result);
+			}
+			sw.stop();
+			std::cout << (k == 0 ? "ASCII " : "mixed ") << names[e] << double(text.size())*rounds*Poco::Stopwatch::resolution()/sw.elapsed()/1e9 << " GB/s" << std::endl;
+		}
+	}
+}
+
+
 void TextConverterTest::setUp()
 {
 }
@@ -350,6 +531,11 @@ CppUnit::Test* TextConverterTest::suite()
 	CppUnit_addTest(pSuite, TextConverterTest, testCP1251toUTF8);
 	CppUnit_addTest(pSuite, TextConverterTest, testCP1252toUTF8);
 	CppUnit_addTest(pSuite, TextConverterTest, testErrors);
+	CppUnit_addTest(pSuite, TextConverterTest, testUTF8toUTF16);
+	CppUnit_addTest(pSuite, TextConverterTest, testUTF16toUTF8);
+	CppUnit_addTest(pSuite, TextConverterTest, testUTF8toUTF32);
+	CppUnit_addTest(pSuite, TextConverterTest, testFastPath);
+	//CppUnit_addTest(pSuite, TextConverterTest, benchmarkConvert);
 
 	return pSuite;
 }
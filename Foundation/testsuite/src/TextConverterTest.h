@@ -34,6 +34,11 @@ public:
 	void testCP1251toUTF8();
 	void testCP1252toUTF8();
 	void testErrors();
+	void testUTF8toUTF16();
+	void testUTF16toUTF8();
+	void testUTF8toUTF32();
+	void testFastPath();
+	void benchmarkConvert();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,372 @@
+//
+// TinyLFUCacheTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "TinyLFUCacheTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/Exception.h"
+#include "Poco/TinyLFUCache.h"
+#include "Poco/FrequencySketch.h"
+#include "Poco/LRUCache.h"
+#include "Poco/ConcurrentLRUCache.h"
+#include "Poco/StrategyCollection.h"
+#include "Poco/ExpireStrategy.h"
+#include "Poco/Random.h"
+#include "Poco/Thread.h"
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+
+
+using namespace Poco;
+
+
+namespace
+{
+	typedef std::vector<int> Trace;
+
+	void zipfTrace(Trace& trace, std::size_t requests, int keys, double skew, int offset, Random& rnd)
+		/// Appends requests following a Zipf distribution.
+	{
+		std::vector<double> cdf(keys);
+		double sum = 0;
+		for (int i = 0; i < keys; ++i)
+		{
+			sum += 1.0/std::pow(i + 1.0, skew);
+			cdf[i] = sum;
+		}
+		for (std::size_t i = 0; i < requests; ++i)
+		{
+			double r = rnd.nextDouble()*sum;
+			trace.push_back(offset + static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), r) - cdf.begin()));
+		}
+	}
+
+	void scanTrace(Trace& trace, int first, int count)
+		/// Appends a scan over count consecutive keys.
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			trace.push_back(first + i);
+		}
+	}
+
+	template <class C>
+	double replay(C& cache, const Trace& trace)
+		/// Replays the trace and returns the hit rate in percent.
+	{
+		std::size_t hits = 0;
+		for (Trace::const_iterator it = trace.begin(); it != trace.end(); ++it)
+		{
+			if (cache.get(*it))
+				++hits;
+			else
+				cache.add(*it, *it);
+		}
+		return 100.0*hits/trace.size();
+	}
+}
+
+
+TinyLFUCacheTest::TinyLFUCacheTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+TinyLFUCacheTest::~TinyLFUCacheTest()
+{
+}
+
+
+void TinyLFUCacheTest::testFrequencySketch()
+{
+	FrequencySketch sketch(512);
+	assert (sketch.sampleSize() == 5120);
+	assert (sketch.estimate(42) == 0);
+
+	for (int i = 0; i < 5; ++i) sketch.increment(42);
+	assert (sketch.estimate(42) == 5);
+	assert (sketch.estimate(43) == 0);
+
+	for (int i = 0; i < 20; ++i) sketch.increment(42);
+	assert (sketch.estimate(42) == FrequencySketch::MAX_FREQUENCY);
+
+	sketch.clear();
+	assert (sketch.estimate(42) == 0);
+	assert (sketch.additions() == 0);
+}
+
+
+void TinyLFUCacheTest::testFrequencySketchAging()
+{
+	FrequencySketch sketch(64);
+	for (int i = 0; i < 10; ++i) sketch.increment(7);
+	assert (sketch.estimate(7) == 10);
+
+	// record distinct items until the counters are halved
+	std::size_t n = 1000;
+	std::size_t additions;
+	unsigned before;
+	do
+	{
+		additions = sketch.additions();
+		before = sketch.estimate(7);
+		sketch.increment(n++);
+	}
+	while (sketch.additions() >= additions);
+
+	assert (additions + 1 == sketch.sampleSize());
+	assert (sketch.additions() <= sketch.sampleSize()/2);
+	assert (sketch.estimate(7) >= 5);
+	assert (sketch.estimate(7) <= (before + 1)/2);
+}
+
+
+void TinyLFUCacheTest::testClear()
+{
+	TinyLFUCache<int, int> aCache(3);
+	assert (aCache.size() == 0);
+	assert (aCache.getAllKeys().size() == 0);
+	aCache.add(1, 2);
+	aCache.add(3, 4);
+	aCache.add(5, 6);
+	assert (aCache.size() == 3);
+	assert (aCache.getAllKeys().size() == 3);
+	assert (aCache.has(1));
+	assert (aCache.has(3));
+	assert (aCache.has(5));
+	assert (*aCache.get(1) == 2);
+	assert (*aCache.get(3) == 4);
+	assert (*aCache.get(5) == 6);
+	aCache.clear();
+	assert (!aCache.has(1));
+	assert (!aCache.has(3));
+	assert (!aCache.has(5));
+}
+
+
+void TinyLFUCacheTest::testCacheSize0()
+{
+	// cache size 0 is illegal
+	try
+	{
+		TinyLFUCache<int, int> aCache(0);
+		failmsg ("cache size of 0 is illegal, test should fail");
+	}
+	catch (Poco::InvalidArgumentException&)
+	{
+	}
+}
+
+
+void TinyLFUCacheTest::testCacheSize1()
+{
+	TinyLFUCache<int, int> aCache(1);
+	aCache.add(1, 2);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+
+	aCache.add(3, 4); // replaces 1
+	assert (!aCache.has(1));
+	assert (aCache.has(3));
+	assert (*aCache.get(3) == 4);
+
+	aCache.remove(3);
+	assert (!aCache.has(3));
+
+	// removing illegal entries should work too
+	aCache.remove(666);
+}
+
+
+void TinyLFUCacheTest::testCacheSizeN()
+{
+	TinyLFUCache<int, int> aCache(100, 10);
+	for (int i = 0; i < 100; ++i)
+	{
+		aCache.add(i, i);
+	}
+	assert (aCache.size() == 100);
+	for (int i = 0; i < 100; ++i)
+	{
+		assert (*aCache.get(i) == i);
+	}
+	for (int i = 100; i < 1000; ++i)
+	{
+		aCache.add(i, i);
+		assert (aCache.size() <= 100);
+	}
+	assert (aCache.size() == 100);
+
+	// the most recently added entry is always in the window
+	assert (aCache.has(999));
+}
+
+
+void TinyLFUCacheTest::testDuplicateAdd()
+{
+	TinyLFUCache<int, int> aCache(3);
+	aCache.add(1, 2);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 2);
+	aCache.add(1, 3);
+	assert (aCache.has(1));
+	assert (*aCache.get(1) == 3);
+	assert (aCache.size() == 1);
+}
+
+
+void TinyLFUCacheTest::testUpdate()
+{
+	TinyLFUCache<int, int> aCache(3);
+	aCache.update(1, 2);
+	assert (*aCache.get(1) == 2);
+	aCache.update(1, 3);
+	assert (*aCache.get(1) == 3);
+	assert (aCache.size() == 1);
+}
+
+
+void TinyLFUCacheTest::testScanResistance()
+{
+	TinyLFUCache<int, int> tinyLFU(100);
+	LRUCache<int, int> lru(100);
+
+	// a working set of frequently used entries
+	for (int i = 0; i < 50; ++i)
+	{
+		tinyLFU.add(i, i);
+		lru.add(i, i);
+	}
+	for (int n = 0; n < 5; ++n)
+	{
+		for (int i = 0; i < 50; ++i)
+		{
+			assert (tinyLFU.get(i));
+			assert (lru.get(i));
+		}
+	}
+
+	// a scan over keys used only once
+	for (int i = 1000; i < 2000; ++i)
+	{
+		tinyLFU.add(i, i);
+		lru.add(i, i);
+	}
+
+	int tinyLFUHits = 0;
+	int lruHits = 0;
+	for (int i = 0; i < 50; ++i)
+	{
+		if (tinyLFU.has(i)) ++tinyLFUHits;
+		if (lru.has(i)) ++lruHits;
+	}
+	assert (tinyLFUHits == 50);
+	assert (lruHits == 0);
+	assert (tinyLFU.size() == 100);
+}
+
+
+void TinyLFUCacheTest::testStrategyCollection()
+{
+	StrategyCollection<int, int> strategies;
+	strategies.pushBack(new TinyLFUStrategy<int, int>(10));
+	strategies.pushBack(new ExpireStrategy<int, int>(200));
+	AbstractCache<int, int, StrategyCollection<int, int> > aCache(strategies);
+
+	for (int i = 0; i < 20; ++i)
+	{
+		aCache.add(i, i);
+	}
+	assert (aCache.size() == 10);
+	assert (aCache.has(19));
+
+	Thread::sleep(300);
+	assert (!aCache.has(19));
+	assert (aCache.size() == 0);
+}
+
+
+void TinyLFUCacheTest::benchmarkHitRate()
+{
+	const int cacheSize = 1000;
+	const std::size_t requests = 1000000;
+
+	std::vector<std::string> names;
+	std::vector<Trace> traces(3);
+	Random rnd;
+	rnd.seed(42);
+
+	names.push_back("Zipf (s=0.9)");
+	zipfTrace(traces[0], requests, 100000, 0.9, 0, rnd);
+
+	names.push_back("Zipf with scans");
+	int scanKey = 1000000;
+	while (traces[1].size() < requests)
+	{
+		zipfTrace(traces[1], 20000, 100000, 0.9, 0, rnd);
+		scanTrace(traces[1], scanKey, 5000);
+		scanKey += 5000;
+	}
+
+	names.push_back("Loop");
+	while (traces[2].size() < requests)
+	{
+		scanTrace(traces[2], 0, cacheSize + cacheSize/5);
+	}
+
+	std::cout << std::endl << "Hit rates for a cache of " << cacheSize << " entries:" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+	for (std::size_t i = 0; i < traces.size(); ++i)
+	{
+		LRUCache<int, int> lru(cacheSize);
+		TinyLFUCache<int, int> tinyLFU(cacheSize);
+		ConcurrentLRUCache<int, int> concLRU(cacheSize, 0, ConcurrentLRUCache<int, int>::EVICT_LRU);
+		ConcurrentLRUCache<int, int> concClock(cacheSize, 0, ConcurrentLRUCache<int, int>::EVICT_CLOCK);
+
+		std::cout << names[i] << ", " << traces[i].size() << " requests:" << std::endl;
+		std::cout << "  LRUCache:                   " << replay(lru, traces[i]) << "%" << std::endl;
+		std::cout << "  TinyLFUCache:               " << replay(tinyLFU, traces[i]) << "%" << std::endl;
+		std::cout << "  ConcurrentLRUCache (LRU):   " << replay(concLRU, traces[i]) << "%" << std::endl;
+		std::cout << "  ConcurrentLRUCache (CLOCK): " << replay(concClock, traces[i]) << "%" << std::endl;
+	}
+}
+
+
+void TinyLFUCacheTest::setUp()
+{
+}
+
+
+void TinyLFUCacheTest::tearDown()
+{
+}
+
+
+CppUnit::Test* TinyLFUCacheTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("TinyLFUCacheTest");
+
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testFrequencySketch);
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testFrequencySketchAging);
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testClear);
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testCacheSize0);
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testCacheSize1);
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testCacheSizeN);
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testDuplicateAdd);
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testUpdate);
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testScanResistance);
+	CppUnit_addTest(pSuite, TinyLFUCacheTest, testStrategyCollection);
+	//CppUnit_addTest(pSuite, TinyLFUCacheTest, benchmarkHitRate);
+
+	return pSuite;
+}
@@ -0,0 +1,44 @@
+//
+// TinyLFUCacheTest.h
+//
+// Tests for TinyLFUCache
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+#ifndef TinyLFUCacheTest_INCLUDED
+#define TinyLFUCacheTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class TinyLFUCacheTest: public CppUnit::TestCase
+{
+public:
+	TinyLFUCacheTest(const std::string& name);
+	~TinyLFUCacheTest();
+
+	void testFrequencySketch();
+	void testFrequencySketchAging();
+	void testClear();
+	void testCacheSize0();
+	void testCacheSize1();
+	void testCacheSizeN();
+	void testDuplicateAdd();
+	void testUpdate();
+	void testScanResistance();
+	void testStrategyCollection();
+	void benchmarkHitRate();
+
+	void setUp();
+	void tearDown();
+	static CppUnit::Test* suite();
+};
+
+
+#endif // TinyLFUCacheTest_INCLUDED
@@ -0,0 +1,340 @@
+//
+// URIRefTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "URIRefTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "Poco/URIRef.h"
+#include "Poco/URI.h"
+#include "Poco/Exception.h"
+#include "Poco/String.h"
+#include "Poco/Stopwatch.h"
+#include <iostream>
+
+
+using Poco::URIRef;
+using Poco::URI;
+using Poco::StringRef;
+using Poco::Stopwatch;
+
+
+URIRefTest::URIRefTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+URIRefTest::~URIRefTest()
+{
+}
+
+
+void URIRefTest::testParse()
+{
+	std::string s("HTTP://user:pw@Www.AppInf.com:8080/dir%201/file.html?a=1&b=x+y#frag%21");
+	URIRef uri(s);
+	assert (uri.getScheme() == "HTTP");
+	assert (uri.getAuthority() == "user:pw@Www.AppInf.com:8080");
+	assert (uri.getUserInfo() == "user:pw");
+	assert (uri.getHost() == "Www.AppInf.com");
+	assert (uri.getPort() == 8080);
+	assert (uri.getRawPath() == "/dir%201/file.html");
+	assert (uri.getPath() == "/dir 1/file.html");
+	assert (uri.getRawQuery() == "a=1&b=x+y");
+	assert (uri.getRawFragment() == "frag%21");
+	assert (uri.getFragment() == "frag!");
+	assert (!uri.isRelative());
+	assert (uri.toStringRef().data() == s.data());
+	assert (uri.getHost().data() == s.data() + 15);
+
+	uri.parse("https://[::1]/");
+	assert (uri.getScheme() == "https");
+	assert (uri.getHost() == "::1");
+	assert (uri.getPort() == 443);
+	assert (uri.getRawPath() == "/");
+	assert (uri.getRawQuery().empty());
+
+	uri.parse("ftp://a@b@c:21");
+	assert (uri.getUserInfo() == "b");
+	assert (uri.getHost() == "c");
+	assert (uri.getPort() == 21);
+	assert (uri.getRawPath().empty());
+
+	uri.parse("mailto:john.doe@appinf.com");
+	assert (uri.getScheme() == "mailto");
+	assert (uri.getAuthority().empty());
+	assert (uri.getRawPath() == "john.doe@appinf.com");
+	assert (uri.getPort() == 0);
+
+	uri.parse("//www.appinf.com/index.html");
+	assert (uri.isRelative());
+	assert (uri.getHost().empty());
+	assert (uri.getRawPath() == "//www.appinf.com/index.html");
+
+	uri.parse("?query#fragment");
+	assert (uri.isRelative());
+	assert (uri.getRawPath().empty());
+	assert (uri.getRawQuery() == "query");
+	assert (uri.getRawFragment() == "fragment");
+
+	uri.parse("");
+	assert (uri.empty());
+	assert (uri.isRelative());
+}
+
+
+void URIRefTest::testParseInvalid()
+{
+	const char* invalid[] =
+	{
+		"http:",
+		"http://[::1/",
+		"http://host:0/",
+		"http://host:65536/",
+		"http://host:8o/",
+		"http://host/a b",
+		"http://host/\x7f"
+	};
+	for (std::size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); ++i)
+	{
+		try
+		{
+			URIRef uri(invalid[i]);
+			failmsg(invalid[i]);
+		}
+		catch (Poco::SyntaxException&)
+		{
+		}
+	}
+
+	// percent-encoded sequences are checked when decoding
+	URIRef uri("http://host/a%2");
+	assert (uri.getRawPath() == "/a%2");
+	try
+	{
+		uri.getPath();
+		fail("bad percent encoding - must throw");
+	}
+	catch (Poco::SyntaxException&)
+	{
+	}
+}
+
+
+void URIRefTest::testPathEtc()
+{
+	URIRef uri("http://www.appinf.com:8080/index.html?q=1#top");
+	assert (uri.getPathEtc() == "/index.html?q=1#top");
+
+	uri.parse("http://www.appinf.com");
+	assert (uri.getPathEtc().empty());
+
+	uri.parse("http://www.appinf.com?q");
+	assert (uri.getPathEtc() == "?q");
+
+	uri.parse("/index.html");
+	assert (uri.getPathEtc() == "/index.html");
+
+	uri.parse("");
+	assert (uri.getPathEtc().empty());
+}
+
+
+void URIRefTest::testQueryIterator()
+{
+	URIRef uri("/p?name=value&flag&x%20y=a+b&&last=");
+	URIRef::QueryIterator it = uri.queryBegin();
+	assert (it != uri.queryEnd());
+	assert (it->name == "name");
+	assert (it->value == "value");
+	++it;
+	assert (it->name == "flag");
+	assert (it->value.empty());
+	++it;
+	assert (it->name == "x%20y");
+	assert (it->value == "a+b");
+	std::string decoded;
+	URIRef::decodeQueryComponent(it->value, decoded);
+	assert (decoded == "a b");
+	++it;
+	assert (it->name.empty());
+	assert (it->value.empty());
+	++it;
+	assert (it->name == "last");
+	assert (it->value.empty());
+	++it;
+	assert (it == uri.queryEnd());
+
+	uri.parse("/p");
+	assert (uri.queryBegin() == uri.queryEnd());
+
+	// the iterator also works on URI's raw query
+	URI u("/p?a=1&b=2");
+	int n = 0;
+	for (URIRef::QueryIterator qit(u.getRawQuery()); qit != URIRef::QueryIterator(); ++qit) ++n;
+	assert (n == 2);
+}
+
+
+void URIRefTest::testFindQueryParameter()
+{
+	URIRef uri("/search?q=poco+uri&lang=en&na%6De=%41&lang=de");
+	std::string value;
+	assert (uri.findQueryParameter("q", value));
+	assert (value == "poco uri");
+	assert (uri.findQueryParameter("lang", value));
+	assert (value == "en");
+	assert (uri.findQueryParameter("name", value));
+	assert (value == "A");
+	assert (!uri.findQueryParameter("x", value));
+}
+
+
+void URIRefTest::testEncodeDecode()
+{
+	std::string encoded;
+	URIRef::encode("http://google.com/search?q=hello+world#frag ment", "+#?", encoded);
+	assert (encoded == "http://google.com/search%3Fq=hello%2Bworld%23frag%20ment");
+
+	encoded.clear();
+	URIRef::encode("a-b_c.d~e\xc3\xa4", "", encoded);
+	assert (encoded == "a-b_c.d~e%C3%A4");
+
+	encoded.clear();
+	URIRef::encode("abc", "abc", encoded);
+	assert (encoded == "abc");
+
+	std::string decoded;
+	URIRef::decode("a%20b%2fc+d?e+f", decoded);
+	assert (decoded == "a b/c+d?e+f");
+
+	decoded.clear();
+	URIRef::decode("a%20b%2fc+d?e+f", decoded, true);
+	assert (decoded == "a b/c+d?e f");
+
+	decoded.clear();
+	URIRef::decodeQueryComponent("a+b%2B", decoded);
+	assert (decoded == "a b+");
+
+	const char* invalid[] = { "%", "%4", "%G0", "%0G" };
+	for (std::size_t i = 0; i < sizeof(invalid)/sizeof(invalid[0]); ++i)
+	{
+		try
+		{
+			decoded.clear();
+			URIRef::decode(invalid[i], decoded);
+			failmsg(invalid[i]);
+		}
+		catch (Poco::SyntaxException&)
+		{
+		}
+	}
+}
+
+
+void URIRefTest::testCompareURI()
+{
+	const char* uris[] =
+	{
+		"http://user:pw@www.appinf.com:8000/a%20b/c?x=1&y=%41+b#frag%21",
+		"HTTPS://WWW.AppInf.COM/",
+		"ftp://anonymous@ftp.appinf.com/pub/",
+		"http://[2001:db8::7]:8080/c=GB?objectClass?one",
+		"http://host:/path",
+		"file:///tmp/file.txt",
+		"urn:oasis:names:specification:docbook:dtd:xml:4.1.2",
+		"../../a/b?q#f",
+		"#fragment"
+	};
+	for (std::size_t i = 0; i < sizeof(uris)/sizeof(uris[0]); ++i)
+	{
+		URI uri(uris[i]);
+		URIRef ref(uris[i]);
+		assert (Poco::toLower(ref.getScheme().toString()) == uri.getScheme());
+		assert (ref.getUserInfo() == uri.getUserInfo());
+		assert (Poco::toLower(ref.getHost().toString()) == uri.getHost());
+		assert (ref.getPort() == uri.getPort());
+		assert (ref.getPath() == uri.getPath());
+		assert (ref.getRawQuery() == uri.getRawQuery());
+		assert (ref.getFragment() == uri.getFragment());
+	}
+}
+
+
+void URIRefTest::benchmarkParse()
+{
+	const int rounds = 1000000;
+	const std::string s("http://www.example.com:8080/api/v1/items/12345/details?format=json&fields=name%2Cprice&sort=desc&q=red+shoes#reviews");
+
+	Stopwatch sw;
+	std::size_t n = 0;
+	sw.start();
+	for (int i = 0; i < rounds; ++i)
+	{
+		URI uri(s);
+		URI::QueryParameters params = uri.getQueryParameters();
+		for (URI::QueryParameters::const_iterator it = params.begin(); it != params.end(); ++it)
+		{
+			if (it->first == "q") n += it->second.size();
+		}
+	}
+	sw.stop();
+	std::cout << "URI: " << double(rounds)*Stopwatch::resolution()/sw.elapsed()/1e6 << " M/s" << std::endl;
+
+	std::string value;
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		URIRef uri(s);
+		if (uri.findQueryParameter("q", value)) n += value.size();
+	}
+	sw.stop();
+	std::cout << "URIRef: " << double(rounds)*Stopwatch::resolution()/sw.elapsed()/1e6 << " M/s" << std::endl;
+
+	std::string encoded;
+	const std::string path("/api/v1/items/12345/some file name with spaces & symbols.html");
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		encoded.clear();
+		URI::encode(path, "?#", encoded);
+		value.clear();
+		URI::decode(encoded, value);
+	}
+	sw.stop();
+	std::cout << "encode/decode: " << double(rounds)*Stopwatch::resolution()/sw.elapsed()/1e6 << " M/s" << std::endl;
+	assert (n > 0 && value == path);
+}
+
+
+void URIRefTest::setUp()
+{
+}
+
+
+void URIRefTest::tearDown()
+{
+}
+
+
+CppUnit::Test* URIRefTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("URIRefTest");
+
+	CppUnit_addTest(pSuite, URIRefTest, testParse);
+	CppUnit_addTest(pSuite, URIRefTest, testParseInvalid);
+	CppUnit_addTest(pSuite, URIRefTest, testPathEtc);
+	CppUnit_addTest(pSuite, URIRefTest, testQueryIterator);
+	CppUnit_addTest(pSuite, URIRefTest, testFindQueryParameter);
+	CppUnit_addTest(pSuite, URIRefTest, testEncodeDecode);
+	CppUnit_addTest(pSuite, URIRefTest, testCompareURI);
+	//CppUnit_addTest(pSuite, URIRefTest, benchmarkParse);
+
+	return pSuite;
+}
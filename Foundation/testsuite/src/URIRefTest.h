@@ -0,0 +1,45 @@
+//
+// URIRefTest.h
+//
+// Definition of the URIRefTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef URIRefTest_INCLUDED
+#define URIRefTest_INCLUDED
+
+
+#include "Poco/Foundation.h"
+#include "CppUnit/TestCase.h"
+
+
+class URIRefTest: public CppUnit::TestCase
+{
+public:
+	URIRefTest(const std::string& name);
+	~URIRefTest();
+
+	void testParse();
+	void testParseInvalid();
+	void testPathEtc();
+	void testQueryIterator();
+	void testFindQueryParameter();
+	void testEncodeDecode();
+	void testCompareURI();
+	void benchmarkParse();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+
+private:
+};
+
+
+#endif // URIRefTest_INCLUDED
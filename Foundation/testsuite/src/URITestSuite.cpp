@@ -10,6 +10,7 @@
 
 #include "URITestSuite.h"
 #include "URITest.h"
+#include "URIRefTest.h"
 #include "URIStreamOpenerTest.h"
 
 
@@ -18,6 +19,7 @@ CppUnit::Test* URITestSuite::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("URITestSuite");
 
 	pSuite->addTest(URITest::suite());
+	pSuite->addTest(URIRefTest::suite());
 	pSuite->addTest(URIStreamOpenerTest::suite());
 
 	return pSuite;
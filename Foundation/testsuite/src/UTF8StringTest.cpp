@@ -102,6 +102,38 @@ void UTF8StringTest::testUnescape()
 }
 
 
+void UTF8StringTest::testIsValid()
+{
+	assert (UTF8::isValid(""));
+	assert (UTF8::isValid("plain ASCII"));
+	assert (UTF8::isValid("Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF"));
+	assert (!UTF8::isValid("\x80"));                 // continuation without lead byte
+	assert (!UTF8::isValid("\xC3"));                 // truncated
+	assert (!UTF8::isValid("\xC3" "A"));
+	assert (!UTF8::isValid("\xC0\xAF"));             // overlong
+	assert (!UTF8::isValid("\xE0\x80\xAF"));
+	assert (!UTF8::isValid("\xF0\x80\x80\xAF"));
+	assert (!UTF8::isValid("\xED\xA0\x80"));         // surrogate
+	assert (!UTF8::isValid("\xF4\x90\x80\x80"));     // beyond U+10FFFF
+	assert (!UTF8::isValid("\xF8\x88\x80\x80\x80"));
+	assert (!UTF8::isValid("\xFF"));
+
+	// errors at every position of long strings
+	std::string text;
+	for (int i = 0; i < 8; ++i)
+	{
+		text += "The quick brown fox \xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80 jumps over the lazy dog. ";
+	}
+	assert (UTF8::isValid(text));
+	for (std::size_t i = 0; i < text.size(); ++i)
+	{
+		std::string bad(text);
+		bad[i] = static_cast<unsigned char>(bad[i]) < 0x80 ? '\x80' : 'x';
+		assert (!UTF8::isValid(bad));
+	}
+}
+
+
 void UTF8StringTest::setUp()
 {
 }
@@ -120,6 +152,7 @@ CppUnit::Test* UTF8StringTest::suite()
 	CppUnit_addTest(pSuite, UTF8StringTest, testTransform);
 	CppUnit_addTest(pSuite, UTF8StringTest, testEscape);
 	CppUnit_addTest(pSuite, UTF8StringTest, testUnescape);
+	CppUnit_addTest(pSuite, UTF8StringTest, testIsValid);
 
 	return pSuite;
 }
@@ -29,6 +29,7 @@ public:
 
 	void testEscape();
 	void testUnescape();
+	void testIsValid();
 
 	void setUp();
 	void tearDown();
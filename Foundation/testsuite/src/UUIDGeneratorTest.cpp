@@ -14,13 +14,39 @@
 #include "Poco/UUIDGenerator.h"
 #include "Poco/UUID.h"
 #include "Poco/SHA1Engine.h"
+#include "Poco/Timestamp.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
+#include "Poco/Stopwatch.h"
 #include <set>
+#include <vector>
+#include <iostream>
 
 
 using Poco::UUIDGenerator;
 using Poco::UUID;
 
 
+namespace
+{
+	class RandomUUIDRunnable: public Poco::Runnable
+	{
+	public:
+		void run()
+		{
+			UUIDGenerator& gen = UUIDGenerator::defaultGenerator();
+			for (int i = 0; i < 1000; ++i)
+			{
+				uuids.push_back(gen.createRandom());
+				uuids.push_back(gen.createTimeOrdered());
+			}
+		}
+
+		std::vector<UUID> uuids;
+	};
+}
+
+
 UUIDGeneratorTest::UUIDGeneratorTest(const std::string& name): CppUnit::TestCase(name)
 {
 }
@@ -61,6 +87,51 @@ void UUIDGeneratorTest::testRandom()
 }
 
 
+void UUIDGeneratorTest::testTimeOrdered()
+{
+	UUIDGenerator& gen = UUIDGenerator::defaultGenerator();
+
+	Poco::UInt64 before = Poco::Timestamp().epochMicroseconds()/1000;
+	UUID last = gen.createTimeOrdered();
+	for (int i = 0; i < 100000; ++i)
+	{
+		UUID uuid = gen.createTimeOrdered();
+		assert (uuid.version() == UUID::UUID_TIME_ORDERED);
+		assert (uuid.variant() == 2);
+		assert (uuid > last);
+		last = uuid;
+	}
+	Poco::UInt64 after = Poco::Timestamp().epochMicroseconds()/1000;
+
+	char bytes[16];
+	last.copyTo(bytes);
+	Poco::UInt64 millis = 0;
+	for (int i = 0; i < 6; ++i)
+	{
+		millis = (millis << 8) | Poco::UInt8(bytes[i]);
+	}
+	// the counter may advance the time stamp slightly
+	assert (millis >= before && millis <= after + 100);
+}
+
+
+void UUIDGeneratorTest::testThreads()
+{
+	RandomUUIDRunnable r1;
+	RandomUUIDRunnable r2;
+	Poco::Thread t1;
+	Poco::Thread t2;
+	t1.start(r1);
+	t2.start(r2);
+	t1.join();
+	t2.join();
+
+	std::set<UUID> uuids(r1.uuids.begin(), r1.uuids.end());
+	uuids.insert(r2.uuids.begin(), r2.uuids.end());
+	assert (uuids.size() == r1.uuids.size() + r2.uuids.size());
+}
+
+
 void UUIDGeneratorTest::testNameBased()
 {
 	UUIDGenerator& gen = UUIDGenerator::defaultGenerator();
@@ -92,6 +163,41 @@ void UUIDGeneratorTest::testNameBased()
 }
 
 
+void UUIDGeneratorTest::benchmarkCreate()
+{
+	UUIDGenerator& gen = UUIDGenerator::defaultGenerator();
+	const int rounds = 1000000;
+	Poco::Stopwatch sw;
+
+	sw.start();
+	for (int i = 0; i < rounds; ++i) gen.create();
+	sw.stop();
+	std::cout << "create(): " << double(rounds)*Poco::Stopwatch::resolution()/sw.elapsed()/1e6 << " M/s" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i) gen.createRandom();
+	sw.stop();
+	std::cout << "createRandom(): " << double(rounds)*Poco::Stopwatch::resolution()/sw.elapsed()/1e6 << " M/s" << std::endl;
+
+	sw.restart();
+	for (int i = 0; i < rounds; ++i) gen.createTimeOrdered();
+	sw.stop();
+	std::cout << "createTimeOrdered(): " << double(rounds)*Poco::Stopwatch::resolution()/sw.elapsed()/1e6 << " M/s" << std::endl;
+
+	UUID uuid = gen.createRandom();
+	std::size_t n = 0;
+	sw.restart();
+	for (int i = 0; i < rounds; ++i)
+	{
+		std::string s = uuid.toString();
+		n += uuid.tryParse(s);
+	}
+	sw.stop();
+	std::cout << "toString()/tryParse(): " << double(rounds)*Poco::Stopwatch::resolution()/sw.elapsed()/1e6 << " M/s" << std::endl;
+	assert (n == rounds);
+}
+
+
 void UUIDGeneratorTest::setUp()
 {
 }
@@ -108,7 +214,10 @@ CppUnit::Test* UUIDGeneratorTest::suite()
 
 	CppUnit_addTest(pSuite, UUIDGeneratorTest, testTimeBased);
 	CppUnit_addTest(pSuite, UUIDGeneratorTest, testRandom);
+	CppUnit_addTest(pSuite, UUIDGeneratorTest, testTimeOrdered);
+	CppUnit_addTest(pSuite, UUIDGeneratorTest, testThreads);
 	CppUnit_addTest(pSuite, UUIDGeneratorTest, testNameBased);
+	//CppUnit_addTest(pSuite, UUIDGeneratorTest, benchmarkCreate);
 
 	return pSuite;
 }
@@ -26,7 +26,10 @@ public:
 
 	void testTimeBased();
 	void testRandom();
+	void testTimeOrdered();
+	void testThreads();
 	void testNameBased();
+	void benchmarkCreate();
 	
 	void setUp();
 	void tearDown();
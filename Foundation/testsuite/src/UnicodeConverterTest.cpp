@@ -48,6 +48,74 @@ void UnicodeConverterTest::testUTF32()
 }
 
 
+void UnicodeConverterTest::testErrors()
+{
+	// invalid sequences are converted to (UTF16Char) -1 and (UTF32Char) -1
+	std::string text("a\x80" "b\xF0\x9F\x98\x80\xFF");
+	UTF16String utf16Text;
+	UnicodeConverter::convert(text, utf16Text);
+	assert (utf16Text.size() == 6);
+	assert (utf16Text[0] == 'a' && utf16Text[1] == 0xFFFF && utf16Text[2] == 'b');
+	assert (utf16Text[3] == 0xD83D && utf16Text[4] == 0xDE00 && utf16Text[5] == 0xFFFF);
+
+	UTF32String utf32Text;
+	UnicodeConverter::convert(text, utf32Text);
+	assert (utf32Text.size() == 5);
+	assert (utf32Text[1] == static_cast<UTF32Char>(-1) && utf32Text[3] == 0x1F600 && utf32Text[4] == static_cast<UTF32Char>(-1));
+
+	// a lone high surrogate
+	UTF16String badText(utf16Text, 0, 4);
+	std::string result;
+	UnicodeConverter::convert(badText, result);
+	assert (result == "a\xEF\xBF\xBF" "b?");
+}
+
+
+void UnicodeConverterTest::testTranscode()
+{
+	std::string text("Gr\xC3\xBC\xC3\x9F" "e aus K\xC3\xB6ln, \xE2\x82\xAC 5, \xD0\x9C\xD0\xB8\xD1\x80");
+	char latin1[64];
+	std::size_t latin1Length;
+	assert (UnicodeConverter::maxTranscodedLength(UnicodeConverter::ENCODING_UTF8, text.size(), UnicodeConverter::ENCODING_LATIN1) <= sizeof(latin1));
+	int errors = UnicodeConverter::transcode(UnicodeConverter::ENCODING_UTF8, text.data(), text.size(), UnicodeConverter::ENCODING_LATIN1, latin1, latin1Length);
+	assert (std::string(latin1, latin1Length) == "Gr\xFC\xDF" "e aus K\xF6ln, ? 5, ???");
+	assert (errors == 0);
+
+	char utf8[128];
+	std::size_t utf8Length;
+	assert (UnicodeConverter::maxTranscodedLength(UnicodeConverter::ENCODING_LATIN1, latin1Length, UnicodeConverter::ENCODING_UTF8) <= sizeof(utf8));
+	errors = UnicodeConverter::transcode(UnicodeConverter::ENCODING_LATIN1, latin1, latin1Length, UnicodeConverter::ENCODING_UTF8, utf8, utf8Length);
+	assert (std::string(utf8, utf8Length) == "Gr\xC3\xBC\xC3\x9F" "e aus K\xC3\xB6ln, ? 5, ???");
+	assert (errors == 0);
+
+	// UTF-16 in the other byte order, and back
+	char utf16[128];
+	std::size_t utf16Length;
+	assert (UnicodeConverter::maxTranscodedLength(UnicodeConverter::ENCODING_UTF8, text.size(), UnicodeConverter::ENCODING_UTF16_SWAPPED) <= sizeof(utf16));
+	errors = UnicodeConverter::transcode(UnicodeConverter::ENCODING_UTF8, text.data(), text.size(), UnicodeConverter::ENCODING_UTF16_SWAPPED, utf16, utf16Length);
+	assert (utf16Length == 2*24);
+	assert (errors == 0);
+
+	UTF16String utf16Text;
+	UnicodeConverter::convert(text, utf16Text);
+	assert (utf16Text.size() == 24);
+	for (std::size_t i = 0; i < utf16Text.size(); ++i)
+	{
+		assert (static_cast<unsigned char>(utf16[2*i]) == (utf16Text[i] >> 8));
+		assert (static_cast<unsigned char>(utf16[2*i + 1]) == (utf16Text[i] & 0xFF));
+	}
+
+	errors = UnicodeConverter::transcode(UnicodeConverter::ENCODING_UTF16_SWAPPED, utf16, utf16Length, UnicodeConverter::ENCODING_UTF8, utf8, utf8Length);
+	assert (std::string(utf8, utf8Length) == text);
+	assert (errors == 0);
+
+	// invalid input
+	errors = UnicodeConverter::transcode(UnicodeConverter::ENCODING_UTF8, "a\x80\xE2\x82", 4, UnicodeConverter::ENCODING_UTF8, utf8, utf8Length, '#');
+	assert (std::string(utf8, utf8Length) == "a##");
+	assert (errors == 2);
+}
+
+
 void UnicodeConverterTest::setUp()
 {
 }
@@ -64,6 +132,8 @@ CppUnit::Test* UnicodeConverterTest::suite()
 
 	CppUnit_addTest(pSuite, UnicodeConverterTest, testUTF16);
 	CppUnit_addTest(pSuite, UnicodeConverterTest, testUTF32);
+	CppUnit_addTest(pSuite, UnicodeConverterTest, testErrors);
+	CppUnit_addTest(pSuite, UnicodeConverterTest, testTranscode);
 
 	return pSuite;
 }
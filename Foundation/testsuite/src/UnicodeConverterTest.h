@@ -29,6 +29,8 @@ public:
 
 	void testUTF16();
 	void testUTF32();
+	void testErrors();
+	void testTranscode();
 
 	void setUp();
 	void tearDown();
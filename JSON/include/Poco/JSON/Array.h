@@ -21,6 +21,7 @@
 #include "Poco/JSON/JSON.h"
 #include "Poco/SharedPtr.h"
 #include "Poco/Dynamic/Var.h"
+#include "Poco/ArenaAllocator.h"
 #include <vector>
 #include <sstream>
 
@@ -58,9 +59,9 @@ class JSON_API Array
 	/// ----
 {
 public:
-	typedef std::vector<Dynamic::Var>                 ValueVec;
-	typedef std::vector<Dynamic::Var>::iterator       Iterator;
-	typedef std::vector<Dynamic::Var>::const_iterator ConstIterator;
+	typedef std::vector<Dynamic::Var, ArenaAllocator<Dynamic::Var> > ValueVec;
+	typedef ValueVec::iterator                                       Iterator;
+	typedef ValueVec::const_iterator                                 ConstIterator;
 	typedef SharedPtr<Array> Ptr;
 
 	Array(int options = 0);
@@ -70,6 +71,15 @@ public:
 		/// stringified, all unicode characters will be escaped in the
 		/// resulting string.
 
+	explicit Array(Arena& arena, int options = 0);
+		/// Creates an empty Array that allocates its
+		/// elements from the given Arena.
+		///
+		/// The Arena must outlive the Array. Copies of
+		/// the Array allocate from the heap.
+		///
+		/// See Array(int) for a description of options.
+
 	Array(const Array& copy);
 		/// Creates an Array by copying another one.
 
@@ -26,6 +26,7 @@
 #include "Poco/Dynamic/Var.h"
 #include "Poco/Dynamic/Struct.h"
 #include "Poco/Nullable.h"
+#include "Poco/ArenaAllocator.h"
 #include <map>
 #include <vector>
 #include <deque>
@@ -61,7 +62,8 @@ class JSON_API Object
 {
 public:
 	typedef SharedPtr<Object>                   Ptr;
-	typedef std::map<std::string, Dynamic::Var> ValueMap;
+	typedef std::map<std::string, Dynamic::Var, std::less<std::string>,
+		ArenaAllocator<std::pair<const std::string, Dynamic::Var> > > ValueMap;
 	typedef ValueMap::value_type                ValueType;
 	typedef ValueMap::iterator                  Iterator;
 	typedef ValueMap::const_iterator            ConstIterator;
@@ -78,6 +80,15 @@ public:
 		/// stringified, all unicode characters will be escaped in the
 		/// resulting string.
 
+	explicit Object(Arena& arena, int options = 0);
+		/// Creates an empty Object that allocates its
+		/// properties from the given Arena.
+		///
+		/// The Arena must outlive the Object. Copies of
+		/// the Object allocate from the heap.
+		///
+		/// See Object(int) for a description of options.
+
 	Object(const Object& copy);
 		/// Creates an Object by copying another one.
 		///
@@ -233,7 +244,8 @@ public:
 		/// Insertion order preservation property is left intact.
 
 private:
-	typedef std::deque<ValueMap::const_iterator>  KeyList;
+	typedef std::deque<ValueMap::const_iterator,
+		ArenaAllocator<ValueMap::const_iterator> > KeyList;
 	typedef Poco::DynamicStruct::Ptr              StructPtr;
 
 	void resetDynStruct() const;
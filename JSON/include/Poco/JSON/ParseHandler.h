@@ -19,6 +19,7 @@
 
 
 #include "Poco/JSON/Handler.h"
+#include "Poco/Arena.h"
 #include <stack>
 
 
@@ -40,6 +41,15 @@ public:
 		/// inside objects is preserved. Otherwise, items
 		/// will be sorted by keys.
 
+	explicit ParseHandler(Arena& arena, bool preserveObjectOrder = false);
+		/// Creates the ParseHandler. The contents of all objects
+		/// and arrays are allocated from the given Arena, which
+		/// must outlive the parse result.
+		///
+		/// If preserveObjectOrder is true, the order of properties
+		/// inside objects is preserved. Otherwise, items
+		/// will be sorted by keys.
+
 	virtual ~ParseHandler();
 		/// Destroys the ParseHandler.
 
@@ -100,6 +110,7 @@ private:
 	std::string  _key;
 	Dynamic::Var _result;
 	bool         _preserveObjectOrder;
+	Arena*       _pArena;
 };
 
 
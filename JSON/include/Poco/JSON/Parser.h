@@ -68,6 +68,14 @@ public:
 	Parser(const Handler::Ptr& pHandler = new ParseHandler, std::size_t bufSize = JSON_PARSE_BUFFER_SIZE);
 		/// Creates JSON Parser, using the given Handler and buffer size.
 
+	explicit Parser(Arena& arena, std::size_t bufSize = JSON_PARSE_BUFFER_SIZE);
+		/// Creates JSON Parser, using a ParseHandler that allocates
+		/// the contents of parsed objects and arrays from the given
+		/// Arena, so that they can be released in one shot when the
+		/// Arena is reset or destroyed.
+		///
+		/// The Arena must outlive all parse results.
+
 	virtual ~Parser();
 		/// Destroys JSON Parser.
 
@@ -101,8 +109,16 @@ public:
 	Dynamic::Var parse(const std::string& json);
 		/// Parses JSON from a string.
 
+	Dynamic::Var parse(const char* json, std::size_t length);
+		/// Parses JSON from a memory buffer, e.g. a MappedFile,
+		/// without copying it.
+
 	Dynamic::Var parse(std::istream& in);
 		/// Parses JSON from an input stream.
+		///
+		/// If the stream is a Poco::MappedInputStream, the
+		/// remaining contents of the mapped file are parsed
+		/// directly from memory.
 
 	void setHandler(const Handler::Ptr& pHandler);
 		/// Set the Handler.
@@ -191,6 +207,12 @@ inline Dynamic::Var Parser::parse(const std::string& json)
 }
 
 
+inline Dynamic::Var Parser::parse(const char* json, std::size_t length)
+{
+	return parseImpl(json, length);
+}
+
+
 inline Dynamic::Var Parser::parse(std::istream& in)
 {
 	return parseImpl(in);
@@ -78,6 +78,9 @@ protected:
 	Dynamic::Var parseImpl(const std::string& json);
 		/// Parses JSON from a string.
 
+	Dynamic::Var parseImpl(const char* json, std::size_t length);
+		/// Parses JSON from a memory buffer.
+
 	Dynamic::Var parseImpl(std::istream& in);
 		/// Parses JSON from an input stream.
 
@@ -101,6 +104,7 @@ private:
 	void handleObject();
 	void handle();
 	void handle(const std::string& json);
+	void handle(const char* json, std::size_t length);
 	void stripComments(std::string& json);
 	bool checkError();
 
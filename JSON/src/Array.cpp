@@ -31,6 +31,14 @@ Array::Array(int options): _modified(false),
 }
 
 
+Array::Array(Arena& arena, int options):
+	_values(ValueVec::allocator_type(arena)),
+	_modified(false),
+	_escapeUnicode((options & Poco::JSON_ESCAPE_UNICODE) != 0)
+{
+}
+
+
 Array::Array(const Array& other) : _values(other._values),
 	_pArray(other._pArray),
 	_modified(other._modified)
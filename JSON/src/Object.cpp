@@ -32,6 +32,16 @@ Object::Object(int options):
 }
 
 
+Object::Object(Arena& arena, int options):
+	_values(std::less<std::string>(), ValueMap::allocator_type(arena)),
+	_keys(KeyList::allocator_type(arena)),
+	_preserveInsOrder((options & Poco::JSON_PRESERVE_KEY_ORDER) != 0),
+	_escapeUnicode((options & Poco::JSON_ESCAPE_UNICODE) != 0),
+	_modified(false)
+{
+}
+
+
 Object::Object(const Object& other) : _values(other._values),
 	_preserveInsOrder(other._preserveInsOrder),
 	_escapeUnicode(other._escapeUnicode),
@@ -25,7 +25,15 @@ namespace JSON {
 
 
 ParseHandler::ParseHandler(bool preserveObjectOrder) : Handler(),
-	_preserveObjectOrder(preserveObjectOrder)
+	_preserveObjectOrder(preserveObjectOrder),
+	_pArena(0)
+{
+}
+
+
+ParseHandler::ParseHandler(Arena& arena, bool preserveObjectOrder) : Handler(),
+	_preserveObjectOrder(preserveObjectOrder),
+	_pArena(&arena)
 {
 }
 
@@ -45,7 +53,8 @@ void ParseHandler::reset()
 
 void ParseHandler::startObject()
 {
-	Object::Ptr newObj = new Object(_preserveObjectOrder);
+	int options = _preserveObjectOrder ? Poco::JSON_PRESERVE_KEY_ORDER : 0;
+	Object::Ptr newObj = _pArena ? new Object(*_pArena, options) : new Object(options);
 	if (_stack.empty()) // The first object
 	{
 		_result = newObj;
@@ -80,7 +89,7 @@ void ParseHandler::endObject()
 
 void ParseHandler::startArray()
 {
-	Array::Ptr newArr = new Array();
+	Array::Ptr newArr = _pArena ? new Array(*_pArena) : new Array();
 
 	if (_stack.empty()) // The first array
 	{
@@ -35,6 +35,12 @@ Parser::Parser(const Handler::Ptr& pHandler, std::size_t bufSize):
 }
 
 
+Parser::Parser(Arena& arena, std::size_t bufSize):
+	ParserImpl(new ParseHandler(arena), bufSize)
+{
+}
+
+
 Parser::~Parser()
 {
 }
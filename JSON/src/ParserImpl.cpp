@@ -15,14 +15,18 @@
 #include "Poco/JSON/Parser.h"
 #include "Poco/JSON/JSONException.h"
 #include "Poco/Ascii.h"
+#include "Poco/NumberParser.h"
 #include "Poco/Token.h"
 #include "Poco/UTF8Encoding.h"
 #include "Poco/String.h"
 #include "Poco/StreamCopier.h"
+#include "Poco/MappedInputStream.h"
+#include <algorithm>
 #undef min
 #undef max
 #include <limits>
 #include <clocale>
+#include <cstring>
 #include <istream>
 #include "pdjson.h"
 
@@ -53,12 +57,19 @@ ParserImpl::~ParserImpl()
 
 void ParserImpl::handle(const std::string& json)
 {
-	if (!_allowNullByte && json.find("\\u0000") != json.npos)
+	handle(json.data(), json.size());
+}
+
+
+void ParserImpl::handle(const char* json, std::size_t length)
+{
+	static const char nullByte[] = "\\u0000";
+	if (!_allowNullByte && std::search(json, json + length, nullByte, nullByte + sizeof(nullByte) - 1) != json + length)
 		throw JSONException("Null bytes in strings not allowed.");
 
 	try
 	{
-		json_open_buffer(_pJSON, json.data(), json.size());
+		json_open_buffer(_pJSON, json, length);
 		checkError();
 		//////////////////////////////////
 		// Underlying parser is capable of parsing multiple consecutive JSONs;
@@ -82,14 +93,20 @@ void ParserImpl::handle(const std::string& json)
 
 
 Dynamic::Var ParserImpl::parseImpl(const std::string& json)
+{
+	return parseImpl(json.data(), json.size());
+}
+
+
+Dynamic::Var ParserImpl::parseImpl(const char* json, std::size_t length)
 {
 	if (_allowComments)
 	{
-		std::string str = json;
+		std::string str(json, length);
 		stripComments(str);
 		handle(str);
 	}
-	else handle(json);
+	else handle(json, length);
 
 	return asVarImpl();
 }
@@ -97,6 +114,16 @@ Dynamic::Var ParserImpl::parseImpl(const std::string& json)
 
 Dynamic::Var ParserImpl::parseImpl(std::istream& in)
 {
+	MappedInputStream* pMapped = dynamic_cast<MappedInputStream*>(&in);
+	if (pMapped)
+	{
+		// parse directly from the mapped file
+		const char* json = pMapped->current();
+		std::size_t length = pMapped->end() - json;
+		pMapped->skip(length);
+		return parseImpl(json, length);
+	}
+
 	std::ostringstream os;
 	StreamCopier::copyStream(in, os);
 	return parseImpl(os.str());
@@ -187,18 +214,30 @@ void ParserImpl::handle()
 		{
 			if (_pHandler)
 			{
-				std::string str(json_get_string(_pJSON, NULL));
-				if (str.find(_decimalPoint) != str.npos || str.find('e') != str.npos || str.find('E') != str.npos)
+				std::size_t length = 0;
+				const char* str = json_get_string(_pJSON, &length);
+				if (length > 0) --length; // terminating zero
+				if (std::memchr(str, _decimalPoint, length) || std::memchr(str, 'e', length) || std::memchr(str, 'E', length))
 				{
-					_pHandler->value(NumberParser::parseFloat(str));
+					double val;
+					if (NumberParser::tryParseFloat(str, length, val))
+						_pHandler->value(val);
+					else
+						throw SyntaxException("Not a valid floating-point number", std::string(str, length));
 				}
 				else
 				{
 					Poco::Int64 val;
-					if (NumberParser::tryParse64(str, val))
+					Poco::UInt64 uval;
+					double dval;
+					if (NumberParser::tryParse64(str, length, val))
 						_pHandler->value(val);
+					else if (NumberParser::tryParseUnsigned64(str, length, uval))
+						_pHandler->value(uval);
+					else if (NumberParser::tryParseFloat(str, length, dval)) // out of 64-bit range
+						_pHandler->value(dval);
 					else
-						_pHandler->value(NumberParser::parseUnsigned64(str));
+						throw SyntaxException("Not a valid integer", std::string(str, length));
 				}
 			}
 			break;
@@ -15,6 +15,8 @@
 #include "Poco/Environment.h"
 #include "Poco/File.h"
 #include "Poco/FileStream.h"
+#include "Poco/MappedInputStream.h"
+#include "Poco/TemporaryFile.h"
 #include "Poco/Glob.h"
 #include "Poco/UTF8Encoding.h"
 #include "Poco/Latin1Encoding.h"
@@ -23,6 +25,7 @@
 #include "Poco/Dynamic/Struct.h"
 #include "Poco/DateTime.h"
 #include "Poco/DateTimeFormatter.h"
+#include "Poco/Arena.h"
 #include <set>
 #include <iostream>
 
@@ -45,6 +48,53 @@ JSONTest::~JSONTest()
 }
 
 
+void JSONTest::testArena()
+{
+	std::string json = "{ \"name\" : \"Franky\", \"children\" : [ \"Jonas\", \"Ellen\" ], \"age\" : 42 }";
+
+	Poco::Arena arena;
+	{
+		Parser parser(arena);
+		Var result = parser.parse(json);
+		assert (arena.allocated() > 0);
+		assert (result.type() == typeid(Object::Ptr));
+
+		Object::Ptr object = result.extract<Object::Ptr>();
+		assert (object->getValue<std::string>("name") == "Franky");
+		assert (object->getValue<int>("age") == 42);
+
+		Poco::JSON::Array::Ptr children = object->getArray("children");
+		assert (!children.isNull());
+		assert (children->size() == 2);
+		assert (children->getElement<std::string>(1) == "Ellen");
+
+		Object copy(*object);
+		assert (copy.size() == 3);
+		assert (copy.getValue<std::string>("name") == "Franky");
+
+		std::ostringstream ostr;
+		object->stringify(ostr);
+		assert (ostr.str() == "{\"age\":42,\"children\":[\"Jonas\",\"Ellen\"],\"name\":\"Franky\"}");
+	}
+	arena.reset();
+	assert (arena.allocated() == 0);
+
+	Object obj(arena, Poco::JSON_PRESERVE_KEY_ORDER);
+	obj.set("foo", 0);
+	obj.set("bar", 1);
+	Object::NameList nl = obj.getNames();
+	assert (nl.size() == 2);
+	assert (nl[0] == "foo");
+	assert (nl[1] == "bar");
+
+	Poco::JSON::Array arr(arena);
+	arr.add(1);
+	arr.add("two");
+	assert (arr.size() == 2);
+	assert (arr.getElement<std::string>(1) == "two");
+}
+
+
 void JSONTest::setUp()
 {
 }
@@ -296,6 +346,24 @@ void JSONTest::testUnsignedNumber64Property()
 */
 }
 
+
+void JSONTest::testHugeNumberProperty()
+{
+	// integers out of the 64-bit range are parsed as floating-point numbers
+	std::string json = "{ \"big\" : 18446744073709551616, \"small\" : -9223372036854775809 }";
+	Parser parser;
+	Var result = parser.parse(json);
+	assert(result.type() == typeid(Object::Ptr));
+
+	Object::Ptr object = result.extract<Object::Ptr>();
+	Var big = object->get("big");
+	assert(big.type() == typeid(double));
+	assert(big.extract<double>() == 18446744073709551616.0);
+	Var small = object->get("small");
+	assert(small.type() == typeid(double));
+	assert(small.extract<double>() == -9223372036854775809.0);
+}
+
 #endif
 
 
@@ -1243,6 +1311,49 @@ void JSONTest::testComment()
 }
 
 
+void JSONTest::testParseBuffer()
+{
+	std::string json = "{ \"name\" : \"Franky\", \"children\" : [ \"Jonas\", \"Ellen\" ] } trailing";
+	Parser parser;
+	Var result = parser.parse(json.data(), json.size() - 9);
+	assert (result.type() == typeid(Object::Ptr));
+	Query query(result);
+	assert (query.findValue("children[1]", "") == "Ellen");
+
+	parser.reset();
+	try
+	{
+		parser.parse(json.data(), json.size());
+		fail("excess characters - must fail");
+	}
+	catch (JSONException&)
+	{
+	}
+}
+
+
+void JSONTest::testParseMapped()
+{
+	std::string json = "{ \"name\" : \"Franky\" /* father */, \"children\" : [ \"Jonas\", \"Ellen\" ] }";
+	Poco::TemporaryFile tempFile;
+	{
+		Poco::FileOutputStream ostr(tempFile.path());
+		ostr << "xx" << json;
+	}
+
+	Poco::MappedInputStream istr(tempFile.path());
+	istr.ignore(2);
+	Parser parser;
+	parser.setAllowComments(true);
+	Var result = parser.parse(istr);
+	assert (istr.current() == istr.end());
+	assert (result.type() == typeid(Object::Ptr));
+	Query query(result);
+	assert (query.findValue("name", "") == "Franky");
+	assert (query.findValue("children[0]", "") == "Jonas");
+}
+
+
 void JSONTest::testPrintHandler()
 {
 	std::string json = "{ \"name\" : \"Homer\", \"age\" : 38, \"wife\" : \"Marge\", \"age\" : 36, \"children\" : [ \"Bart\", \"Lisa\", \"Maggie\" ] }";
@@ -2175,6 +2286,7 @@ CppUnit::Test* JSONTest::suite()
 #if defined(POCO_HAVE_INT64)
 	CppUnit_addTest(pSuite, JSONTest, testNumber64Property);
 	CppUnit_addTest(pSuite, JSONTest, testUnsignedNumber64Property);
+	CppUnit_addTest(pSuite, JSONTest, testHugeNumberProperty);
 #endif
 	CppUnit_addTest(pSuite, JSONTest, testStringProperty);
 	CppUnit_addTest(pSuite, JSONTest, testEmptyObject);
@@ -2199,6 +2311,8 @@ CppUnit::Test* JSONTest::suite()
 	CppUnit_addTest(pSuite, JSONTest, testOptValue);
 	CppUnit_addTest(pSuite, JSONTest, testQuery);
 	CppUnit_addTest(pSuite, JSONTest, testComment);
+	CppUnit_addTest(pSuite, JSONTest, testParseBuffer);
+	CppUnit_addTest(pSuite, JSONTest, testParseMapped);
 	CppUnit_addTest(pSuite, JSONTest, testPrintHandler);
 	CppUnit_addTest(pSuite, JSONTest, testStringify);
 	CppUnit_addTest(pSuite, JSONTest, testStringifyPreserveOrder);
@@ -2213,6 +2327,7 @@ CppUnit::Test* JSONTest::suite()
 	CppUnit_addTest(pSuite, JSONTest, testEscapeUnicode);
 	CppUnit_addTest(pSuite, JSONTest, testCopy);
 	CppUnit_addTest(pSuite, JSONTest, testMove);
+	CppUnit_addTest(pSuite, JSONTest, testArena);
 
 	return pSuite;
 }
@@ -41,6 +41,7 @@ public:
 #if defined(POCO_HAVE_INT64)
 	void testNumber64Property();
 	void testUnsignedNumber64Property();
+	void testHugeNumberProperty();
 #endif
 	void testStringProperty();
 	void testEmptyObject();
@@ -65,6 +66,8 @@ public:
 	void testOptValue();
 	void testQuery();
 	void testComment();
+	void testParseBuffer();
+	void testParseMapped();
 	void testPrintHandler();
 	void testStringify();
 	void testStringifyPreserveOrder();
@@ -81,6 +84,7 @@ public:
 
 	void testCopy();
 	void testMove();
+	void testArena();
 
 	void setUp();
 	void tearDown();
@@ -0,0 +1,140 @@
+//
+// AsyncSocketIO.h
+//
+// Library: Net
+// Package: Reactor
+// Module:  AsyncSocketIO
+//
+// Definition of the AsyncSocketIO class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_AsyncSocketIO_INCLUDED
+#define Net_AsyncSocketIO_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/IOUring.h"
+#include "Poco/Runnable.h"
+#include "Poco/Timespan.h"
+#include <functional>
+#include <memory>
+#include <atomic>
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API AsyncSocketIO: public Poco::Runnable
+	/// AsyncSocketIO submits socket operations to a Poco::IOUring
+	/// and runs the loop dispatching their completions.
+	///
+	/// It is an alternative to the SocketReactor for servers
+	/// handling many connections: instead of being notified that a
+	/// socket has become readable and then calling receiveBytes(),
+	/// a handler queues a receive together with a callback, which
+	/// is invoked with the received data already in the buffer.
+	/// Operations queued in the same round of the loop are handed
+	/// to the kernel with a single system call.
+	///
+	/// Where io_uring is not available, the IOUring's fallback
+	/// implementation based on poll() is used.
+	///
+	/// AsyncSocketIO keeps a reference to the socket of every
+	/// operation in progress, so a socket is not closed before
+	/// its callbacks have been invoked.
+	///
+	/// Operations must be queued either from callbacks, or before
+	/// the loop is started with run(). stop() may be called from
+	/// any thread.
+{
+public:
+	typedef Poco::IOUring::Callback Callback;
+		/// Completion callback, receiving the number of bytes
+		/// transferred or a negative error number.
+
+	typedef std::function<void(StreamSocket&)> AcceptCallback;
+		/// Callback receiving an accepted connection.
+
+	AsyncSocketIO();
+		/// Creates the AsyncSocketIO with a default timeout
+		/// of 250 milliseconds.
+
+	explicit AsyncSocketIO(const Poco::Timespan& timeout);
+		/// Creates the AsyncSocketIO, using the given timeout.
+
+	~AsyncSocketIO();
+		/// Destroys the AsyncSocketIO.
+
+	void receiveBytes(const StreamSocket& socket, void* buffer, int length, const Callback& callback, int flags = 0);
+		/// Queues the receipt of up to length bytes from the socket.
+		/// A result of 0 means that the peer has closed the connection.
+
+	void sendBytes(const StreamSocket& socket, const void* buffer, int length, const Callback& callback, int flags = 0);
+		/// Queues sending length bytes to the socket. Partial sends are
+		/// continued until all bytes have been sent; the callback receives
+		/// length, or a negative error number.
+
+	void acceptConnection(const ServerSocket& socket, const AcceptCallback& callback);
+		/// Queues accepting the next connection on the server socket.
+		/// To accept further connections, call acceptConnection()
+		/// again from the callback.
+
+	void run();
+		/// Runs the loop until stop() is called, dispatching
+		/// completed operations.
+
+	void stop();
+		/// Stops the loop. The loop will stop after the next
+		/// completion or timeout.
+
+	void setTimeout(const Poco::Timespan& timeout);
+		/// Sets the timeout used when waiting for completions.
+
+	const Poco::Timespan& getTimeout() const;
+		/// Returns the timeout.
+
+	Poco::IOUring& ring();
+		/// Returns the underlying IOUring, for queueing
+		/// other operations.
+
+private:
+	struct SendState;
+
+	void sendMore(const std::shared_ptr<SendState>& pState);
+
+	AsyncSocketIO(const AsyncSocketIO&);
+	AsyncSocketIO& operator = (const AsyncSocketIO&);
+
+	enum
+	{
+		DEFAULT_TIMEOUT = 250000
+	};
+
+	Poco::IOUring     _ring;
+	Poco::Timespan    _timeout;
+	std::atomic<bool> _stop;
+};
+
+
+//
+// inlines
+//
+inline Poco::IOUring& AsyncSocketIO::ring()
+{
+	return _ring;
+}
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_AsyncSocketIO_INCLUDED
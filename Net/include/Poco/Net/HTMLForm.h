@@ -208,6 +208,7 @@ public:
 
 protected:
 	void readUrl(std::istream& istr);
+	void readQuery(const std::string& query);
 	void readMultipart(std::istream& istr, PartHandler& handler);
 	void writeUrl(std::ostream& ostr);
 	void writeMultipart(std::ostream& ostr);
@@ -21,6 +21,8 @@
 #include "Poco/Net/Net.h"
 #include "Poco/String.h"
 #include "Poco/ListMap.h"
+#include "Poco/ArenaAllocator.h"
+#include <list>
 #include <cstddef>
 
 
@@ -38,13 +40,22 @@ class Net_API NameValueCollection
 	/// same name.
 {
 public:
-	typedef Poco::ListMap<std::string, std::string> HeaderMap;
+	typedef std::pair<std::string, std::string> NameValuePair;
+	typedef Poco::ListMap<std::string, std::string, std::list<NameValuePair, Poco::ArenaAllocator<NameValuePair> > > HeaderMap;
 	typedef HeaderMap::Iterator Iterator;
 	typedef HeaderMap::ConstIterator ConstIterator;
 	
 	NameValueCollection();
 		/// Creates an empty NameValueCollection.
 
+	explicit NameValueCollection(Poco::Arena& arena);
+		/// Creates an empty NameValueCollection that allocates
+		/// its name-value pairs from the given Arena.
+		///
+		/// The Arena must outlive the NameValueCollection.
+		/// Copies of the NameValueCollection allocate from
+		/// the heap.
+
 	NameValueCollection(const NameValueCollection& nvc);
 		/// Creates a NameValueCollection by copying another one.
 
@@ -0,0 +1,67 @@
+//
+// PrometheusRequestHandler.h
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  PrometheusRequestHandler
+//
+// Definition of the PrometheusRequestHandler class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef Net_PrometheusRequestHandler_INCLUDED
+#define Net_PrometheusRequestHandler_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/MetricRegistry.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+class Net_API PrometheusRequestHandler: public HTTPRequestHandler
+	/// A PrometheusRequestHandler responds to GET and HEAD requests
+	/// with the metrics of a MetricRegistry, in the Prometheus text
+	/// exposition format, so that a Prometheus server can scrape them.
+	///
+	/// HTTPServer does not export metrics by itself. To export them,
+	/// the application's HTTPRequestHandlerFactory creates a
+	/// PrometheusRequestHandler for the metrics path:
+	///
+	///     if (request.getURI() == "/metrics")
+	///         return new PrometheusRequestHandler;
+{
+public:
+	PrometheusRequestHandler();
+		/// Creates a PrometheusRequestHandler for
+		/// MetricRegistry::defaultRegistry().
+
+	explicit PrometheusRequestHandler(const Poco::MetricRegistry& registry);
+		/// Creates a PrometheusRequestHandler for the given registry,
+		/// which must outlive the handler.
+
+	~PrometheusRequestHandler();
+		/// Destroys the PrometheusRequestHandler.
+
+	void handleRequest(HTTPServerRequest& request, HTTPServerResponse& response);
+
+	static const std::string CONTENT_TYPE;
+		/// The content type of the Prometheus text exposition format.
+
+private:
+	const Poco::MetricRegistry& _registry;
+};
+
+
+} } // namespace Poco::Net
+
+
+#endif // Net_PrometheusRequestHandler_INCLUDED
@@ -21,6 +21,7 @@
 #include "Poco/Net/Net.h"
 #include "Poco/Net/StreamSocket.h"
 #include "Poco/BufferedBidirectionalStreamBuf.h"
+#include "Poco/NativeStreamBuf.h"
 #include <istream>
 #include <ostream>
 
@@ -32,7 +33,7 @@ namespace Net {
 class StreamSocketImpl;
 
 
-class Net_API SocketStreamBuf: public Poco::BufferedBidirectionalStreamBuf
+class Net_API SocketStreamBuf: public Poco::BufferedBidirectionalStreamBuf, public Poco::NativeStreamBuf
 	/// This is the streambuf class used for reading from and writing to a socket.
 {
 public:
@@ -47,6 +48,18 @@ public:
 		
 	StreamSocketImpl* socketImpl() const;
 		/// Returns the internal SocketImpl.
+
+	int nativeDescriptor(std::ios::openmode which) const;
+		/// Returns the socket descriptor for writing, if the socket
+		/// is a plain, blocking StreamSocket without a send timeout.
+		/// Data sent through secure or WebSocket sockets must be
+		/// transformed, and is never written to the descriptor directly.
+		///
+		/// Returns -1 for reading, so that receive timeouts
+		/// are always handled by the SocketImpl.
+
+	void nativeTransferred(std::ios::openmode which, std::streamsize n);
+		/// Does nothing.
 	
 protected:
 	int readFromDevice(char* buffer, std::streamsize length);
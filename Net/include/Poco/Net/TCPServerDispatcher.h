@@ -24,6 +24,7 @@
 #include "Poco/Net/TCPServerParams.h"
 #include "Poco/Runnable.h"
 #include "Poco/NotificationQueue.h"
+#include <atomic>
 #include "Poco/ThreadPool.h"
 #include "Poco/Mutex.h"
 
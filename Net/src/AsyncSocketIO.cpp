@@ -0,0 +1,142 @@
+//
+// AsyncSocketIO.cpp
+//
+// Library: Net
+// Package: Reactor
+// Module:  AsyncSocketIO
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/AsyncSocketIO.h"
+#include "Poco/Net/NetException.h"
+#include "Poco/Thread.h"
+
+
+namespace Poco {
+namespace Net {
+
+
+struct AsyncSocketIO::SendState
+{
+	StreamSocket socket;
+	const char*  buffer;
+	int          length;
+	int          sent;
+	int          flags;
+	Callback     callback;
+};
+
+
+AsyncSocketIO::AsyncSocketIO():
+	_timeout(DEFAULT_TIMEOUT),
+	_stop(false)
+{
+}
+
+
+AsyncSocketIO::AsyncSocketIO(const Poco::Timespan& timeout):
+	_timeout(timeout),
+	_stop(false)
+{
+}
+
+
+AsyncSocketIO::~AsyncSocketIO()
+{
+}
+
+
+void AsyncSocketIO::receiveBytes(const StreamSocket& socket, void* buffer, int length, const Callback& callback, int flags)
+{
+	poco_assert (length >= 0);
+
+	_ring.receive(socket.impl()->sockfd(), buffer, static_cast<std::size_t>(length), flags, [socket, callback](int result)
+	{
+		callback(result);
+	});
+}
+
+
+void AsyncSocketIO::sendBytes(const StreamSocket& socket, const void* buffer, int length, const Callback& callback, int flags)
+{
+	poco_assert (length >= 0);
+
+	std::shared_ptr<SendState> pState(new SendState);
+	pState->socket   = socket;
+	pState->buffer   = static_cast<const char*>(buffer);
+	pState->length   = length;
+	pState->sent     = 0;
+	pState->flags    = flags;
+	pState->callback = callback;
+	sendMore(pState);
+}
+
+
+void AsyncSocketIO::acceptConnection(const ServerSocket& socket, const AcceptCallback& callback)
+{
+	ServerSocket server(socket);
+	_ring.pollAdd(server.impl()->sockfd(), Poco::IOUring::POLL_READ, [server, callback](int result) mutable
+	{
+		if (result < 0) throw NetException("Cannot accept connection", -result);
+		StreamSocket connection = server.acceptConnection();
+		callback(connection);
+	});
+}
+
+
+void AsyncSocketIO::run()
+{
+	while (!_stop)
+	{
+		if (_ring.pending() == 0)
+			Thread::trySleep(static_cast<long>(_timeout.totalMilliseconds()));
+		else
+			_ring.wait(_timeout);
+	}
+}
+
+
+void AsyncSocketIO::stop()
+{
+	_stop = true;
+}
+
+
+void AsyncSocketIO::setTimeout(const Poco::Timespan& timeout)
+{
+	_timeout = timeout;
+}
+
+
+const Poco::Timespan& AsyncSocketIO::getTimeout() const
+{
+	return _timeout;
+}
+
+
+void AsyncSocketIO::sendMore(const std::shared_ptr<SendState>& pState)
+{
+	_ring.send(pState->socket.impl()->sockfd(), pState->buffer + pState->sent, static_cast<std::size_t>(pState->length - pState->sent), pState->flags, [this, pState](int result)
+	{
+		if (result < 0)
+		{
+			pState->callback(result);
+		}
+		else
+		{
+			pState->sent += result;
+			if (pState->sent < pState->length && result > 0)
+				sendMore(pState);
+			else
+				pState->callback(pState->sent);
+		}
+	});
+}
+
+
+} } // namespace Poco::Net
@@ -27,12 +27,15 @@
 #include "Poco/String.h"
 #include "Poco/CountingStream.h"
 #include "Poco/UTF8String.h"
+#include "Poco/StringRef.h"
+#include <algorithm>
 #include <sstream>
 
 
 using Poco::NullInputStream;
 using Poco::StreamCopier;
 using Poco::SyntaxException;
+using Poco::StringRef;
 using Poco::URI;
 using Poco::icompare;
 
@@ -141,11 +144,7 @@ void HTMLForm::load(const HTTPRequest& request, std::istream& requestBody, PartH
 
 	URI uri(request.getURI());
 	const std::string& query = uri.getRawQuery();
-	if (!query.empty())
-	{
-		std::istringstream istr(query);
-		readUrl(istr);
-	}
+	readQuery(query);
 
 	if (request.getMethod() == HTTPRequest::HTTP_POST || request.getMethod() == HTTPRequest::HTTP_PUT)
 	{
@@ -198,8 +197,7 @@ void HTMLForm::read(std::istream& istr)
 
 void HTMLForm::read(const std::string& queryString)
 {
-	std::istringstream istr(queryString);
-	readUrl(istr);
+	readQuery(queryString);
 }
 
 
@@ -339,6 +337,45 @@ void HTMLForm::readUrl(std::istream& istr)
 }
 
 
+void HTMLForm::readQuery(const std::string& query)
+{
+	int fields = 0;
+	std::string name;
+	std::string value;
+	StringRef rest(query);
+	while (!rest.empty())
+	{
+		if (_fieldLimit > 0 && fields == _fieldLimit)
+			throw HTMLFormException("Too many form fields");
+		std::size_t amp = rest.find('&');
+		StringRef field = rest.substr(0, amp);
+		rest = amp == StringRef::npos ? StringRef() : rest.substr(amp + 1);
+		std::size_t eq = field.find('=');
+		StringRef nameRef = field.substr(0, eq);
+		StringRef valueRef = eq == StringRef::npos ? StringRef() : field.substr(eq + 1);
+		if (nameRef.size() > MAX_NAME_LENGTH)
+			throw HTMLFormException("Field name too long");
+		if (valueRef.size() > static_cast<std::size_t>(_valueLengthLimit))
+			throw HTMLFormException("Field value too long");
+		nameRef.assignTo(name);
+		valueRef.assignTo(value);
+		std::replace(name.begin(), name.end(), '+', ' ');
+		std::replace(value.begin(), value.end(), '+', ' ');
+		// remove UTF-8 byte order mark from first name, if present
+		if (fields == 0)
+		{
+			UTF8::removeBOM(name);
+		}
+		std::string decodedName;
+		std::string decodedValue;
+		URI::decode(name, decodedName);
+		URI::decode(value, decodedValue);
+		add(decodedName, decodedValue);
+		++fields;
+	}
+}
+
+
 void HTMLForm::readMultipart(std::istream& istr, PartHandler& handler)
 {
 	static const int eof = std::char_traits<char>::eof();
@@ -22,6 +22,7 @@
 #include "Poco/NumberFormatter.h"
 #include "Poco/Timestamp.h"
 #include "Poco/Delegate.h"
+#include "Poco/MetricRegistry.h"
 #include <memory>
 
 
@@ -29,6 +30,54 @@ namespace Poco {
 namespace Net {
 
 
+namespace
+{
+	struct HTTPServerMetrics
+	{
+		HTTPServerMetrics():
+			requests(Poco::MetricRegistry::defaultRegistry().counter("poco_http_server_requests_total",
+				"Total number of requests received by HTTP servers.")),
+			errors(Poco::MetricRegistry::defaultRegistry().counter("poco_http_server_error_responses_total",
+				"Total number of error responses sent by HTTP servers because a request was invalid, not handled or failed.")),
+			duration(Poco::MetricRegistry::defaultRegistry().histogram("poco_http_server_request_duration_seconds",
+				"Time taken to handle HTTP requests, after reading the request header.", 1e-6))
+		{
+		}
+
+		Poco::MetricCounter&   requests;
+		Poco::MetricCounter&   errors;
+		Poco::MetricHistogram& duration;
+	};
+
+
+	HTTPServerMetrics& httpServerMetrics()
+	{
+		static HTTPServerMetrics metrics;
+		return metrics;
+	}
+
+
+	class RequestTimer
+		/// Records the time taken to handle a request.
+	{
+	public:
+		RequestTimer(const Poco::Timestamp& started):
+			_started(started)
+		{
+			httpServerMetrics().requests.inc();
+		}
+
+		~RequestTimer()
+		{
+			httpServerMetrics().duration.record(_started.elapsed());
+		}
+
+	private:
+		const Poco::Timestamp& _started;
+	};
+}
+
+
 HTTPServerConnection::HTTPServerConnection(const StreamSocket& socket, HTTPServerParams::Ptr pParams, HTTPRequestHandlerFactory::Ptr pFactory):
 	TCPServerConnection(socket),
 	_pParams(pParams),
@@ -69,6 +118,7 @@ void HTTPServerConnection::run()
 				HTTPServerRequestImpl request(response, session, _pParams);
 			
 				Poco::Timestamp now;
+				RequestTimer timer(now);
 				response.setDate(now);
 				response.setVersion(request.getVersion());
 				response.setKeepAlive(_pParams->getKeepAlive() && request.getKeepAlive() && session.canKeepAlive());
@@ -129,6 +179,7 @@ void HTTPServerConnection::run()
 
 void HTTPServerConnection::sendErrorResponse(HTTPServerSession& session, HTTPResponse::HTTPStatus status)
 {
+	httpServerMetrics().errors.inc();
 	HTTPServerResponseImpl response(session);
 	response.setVersion(HTTPMessage::HTTP_1_1);
 	response.setStatusAndReason(status);
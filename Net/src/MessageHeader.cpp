@@ -18,6 +18,7 @@
 #include "Poco/Ascii.h"
 #include "Poco/TextConverter.h"
 #include "Poco/StringTokenizer.h"
+#include "Poco/StringRef.h"
 #include "Poco/Base64Decoder.h"
 #include "Poco/UTF8Encoding.h"
 #include <sstream>
@@ -139,6 +140,21 @@ bool MessageHeader::hasToken(const std::string& fieldName, const std::string& to
 void MessageHeader::splitElements(const std::string& s, std::vector<std::string>& elements, bool ignoreEmpty)
 {
 	elements.clear();
+	Poco::StringRef rest(s);
+	if (rest.findFirstOf("\"\\") == Poco::StringRef::npos)
+	{
+		// no quoting, so elements can be sliced out of s directly
+		while (!rest.empty())
+		{
+			std::size_t comma = rest.find(',');
+			Poco::StringRef elem = rest.substr(0, comma).trim();
+			rest = comma == Poco::StringRef::npos ? Poco::StringRef() : rest.substr(comma + 1);
+			if (!ignoreEmpty || !elem.empty())
+				elements.push_back(elem.toString());
+		}
+		return;
+	}
+
 	std::string::const_iterator it  = s.begin();
 	std::string::const_iterator end = s.end();
 	std::string elem;
@@ -187,58 +203,70 @@ void MessageHeader::splitParameters(const std::string& s, std::string& value, Na
 {
 	value.clear();
 	parameters.clear();
-	std::string::const_iterator it  = s.begin();
-	std::string::const_iterator end = s.end();
-	while (it != end && Poco::Ascii::isSpace(*it)) ++it;
-	while (it != end && *it != ';') value += *it++;
-	Poco::trimRightInPlace(value);
-	if (it != end) ++it;
-	splitParameters(it, end, parameters);
+	Poco::StringRef str = Poco::StringRef(s).trimLeft();
+	std::size_t semi = str.find(';');
+	str.substr(0, semi).trimRight().assignTo(value);
+	if (semi != Poco::StringRef::npos)
+		splitParameters(s.begin() + (str.data() + semi + 1 - s.data()), s.end(), parameters);
 }
 
 
 void MessageHeader::splitParameters(const std::string::const_iterator& begin, const std::string::const_iterator& end, NameValueCollection& parameters)
 {
+	if (begin == end) return;
+
 	std::string pname;
 	std::string pvalue;
-	pname.reserve(32);
 	pvalue.reserve(64);
-	std::string::const_iterator it = begin;
-	while (it != end)
+	Poco::StringRef rest(&*begin, end - begin);
+	while (!rest.empty())
 	{
-		pname.clear();
-		pvalue.clear();
-		while (it != end && Poco::Ascii::isSpace(*it)) ++it;
-		while (it != end && *it != '=' && *it != ';') pname += *it++;
-		Poco::trimRightInPlace(pname);
-		if (it != end && *it != ';') ++it;
-		while (it != end && Poco::Ascii::isSpace(*it)) ++it;
-		while (it != end && *it != ';')
+		rest = rest.trimLeft();
+		std::size_t pos = rest.findFirstOf("=;");
+		rest.substr(0, pos).trimRight().assignTo(pname);
+		rest = rest.substr(pos == Poco::StringRef::npos ? rest.size() : pos);
+		if (!rest.empty() && rest.front() != ';') rest = rest.substr(1);
+		rest = rest.trimLeft();
+		pos = rest.findFirstOf(";\"\\");
+		if (pos == Poco::StringRef::npos || rest[pos] == ';')
+		{
+			// no quoting, so the value can be sliced out directly
+			rest.substr(0, pos).trimRight().assignTo(pvalue);
+			rest = rest.substr(pos == Poco::StringRef::npos ? rest.size() : pos);
+		}
+		else
 		{
-			if (*it == '"')
+			pvalue.clear();
+			const char* it = rest.begin();
+			const char* rend = rest.end();
+			while (it != rend && *it != ';')
 			{
-				++it;
-				while (it != end && *it != '"')
+				if (*it == '"')
 				{
-					if (*it == '\\')
+					++it;
+					while (it != rend && *it != '"')
 					{
-						++it;
-						if (it != end) pvalue += *it++;
+						if (*it == '\\')
+						{
+							++it;
+							if (it != rend) pvalue += *it++;
+						}
+						else pvalue += *it++;
 					}
-					else pvalue += *it++;
+					if (it != rend) ++it;
 				}
-				if (it != end) ++it;
-			}
-			else if (*it == '\\')
-			{
-				++it;
-				if (it != end) pvalue += *it++;
+				else if (*it == '\\')
+				{
+					++it;
+					if (it != rend) pvalue += *it++;
+				}
+				else pvalue += *it++;
 			}
-			else pvalue += *it++;
+			Poco::trimRightInPlace(pvalue);
+			rest = Poco::StringRef(it, rend);
 		}
-		Poco::trimRightInPlace(pvalue);
 		if (!pname.empty()) parameters.add(pname, pvalue);
-		if (it != end) ++it;
+		if (!rest.empty()) rest = rest.substr(1);
 	}
 }
 
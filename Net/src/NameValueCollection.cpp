@@ -29,6 +29,12 @@ NameValueCollection::NameValueCollection()
 }
 
 
+NameValueCollection::NameValueCollection(Poco::Arena& arena):
+	_map(Poco::ArenaAllocator<NameValuePair>(arena))
+{
+}
+
+
 NameValueCollection::NameValueCollection(const NameValueCollection& nvc):
 	_map(nvc._map)
 {
@@ -52,7 +58,7 @@ NameValueCollection& NameValueCollection::operator = (const NameValueCollection&
 
 void NameValueCollection::swap(NameValueCollection& nvc)
 {
-	std::swap(_map, nvc._map);
+	_map.swap(nvc._map);
 }
 
 	
@@ -0,0 +1,69 @@
+//
+// PrometheusRequestHandler.cpp
+//
+// Library: Net
+// Package: HTTPServer
+// Module:  PrometheusRequestHandler
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "Poco/Net/PrometheusRequestHandler.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include <sstream>
+
+
+namespace Poco {
+namespace Net {
+
+
+const std::string PrometheusRequestHandler::CONTENT_TYPE("text/plain; version=0.0.4; charset=utf-8");
+
+
+PrometheusRequestHandler::PrometheusRequestHandler():
+	_registry(Poco::MetricRegistry::defaultRegistry())
+{
+}
+
+
+PrometheusRequestHandler::PrometheusRequestHandler(const Poco::MetricRegistry& registry):
+	_registry(registry)
+{
+}
+
+
+PrometheusRequestHandler::~PrometheusRequestHandler()
+{
+}
+
+
+void PrometheusRequestHandler::handleRequest(HTTPServerRequest& request, HTTPServerResponse& response)
+{
+	if (request.getMethod() != HTTPRequest::HTTP_GET && request.getMethod() != HTTPRequest::HTTP_HEAD)
+	{
+		response.setStatusAndReason(HTTPResponse::HTTP_METHOD_NOT_ALLOWED);
+		response.set("Allow", "GET, HEAD");
+		response.setContentLength(0);
+		response.send();
+		return;
+	}
+
+	std::ostringstream ostr;
+	_registry.writePrometheus(ostr);
+	std::string body = ostr.str();
+
+	response.setContentType(CONTENT_TYPE);
+	response.setContentLength(static_cast<std::streamsize>(body.size()));
+	if (request.getMethod() == HTTPRequest::HTTP_HEAD)
+		response.send();
+	else
+		response.sendBuffer(body.data(), body.size());
+}
+
+
+} } // namespace Poco::Net
@@ -15,6 +15,7 @@
 #include "Poco/Net/SocketStream.h"
 #include "Poco/Net/StreamSocketImpl.h"
 #include "Poco/Exception.h"
+#include <typeinfo>
 
 
 using Poco::BufferedBidirectionalStreamBuf;
@@ -59,6 +60,27 @@ int SocketStreamBuf::writeToDevice(const char* buffer, std::streamsize length)
 }
 
 
+int SocketStreamBuf::nativeDescriptor(std::ios::openmode which) const
+{
+#if defined(POCO_OS_FAMILY_UNIX)
+	if ((which & std::ios::out) && (getMode() & std::ios::out) && typeid(*_pImpl) == typeid(StreamSocketImpl) && _pImpl->getBlocking())
+	{
+#if defined(POCO_BROKEN_TIMEOUTS)
+		// The send timeout is implemented by SocketImpl::sendBytes().
+		if (_pImpl->getSendTimeout().totalMicroseconds() != 0) return -1;
+#endif
+		return _pImpl->sockfd();
+	}
+#endif
+	return -1;
+}
+
+
+void SocketStreamBuf::nativeTransferred(std::ios::openmode which, std::streamsize n)
+{
+}
+
+
 //
 // SocketIOS
 //
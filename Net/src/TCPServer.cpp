@@ -19,15 +19,43 @@
 #include "Poco/Timespan.h"
 #include "Poco/Exception.h"
 #include "Poco/ErrorHandler.h"
+#include "Poco/MetricRegistry.h"
 
 
 using Poco::ErrorHandler;
+using Poco::MetricRegistry;
+using Poco::MetricCounter;
 
 
 namespace Poco {
 namespace Net {
 
 
+namespace
+{
+	struct TCPServerMetrics
+	{
+		TCPServerMetrics():
+			accepted(MetricRegistry::defaultRegistry().counter("poco_tcp_server_connections_accepted_total",
+				"Total number of connections accepted by TCP servers.")),
+			filtered(MetricRegistry::defaultRegistry().counter("poco_tcp_server_connections_filtered_total",
+				"Total number of accepted connections rejected by a TCPServerConnectionFilter."))
+		{
+		}
+
+		MetricCounter& accepted;
+		MetricCounter& filtered;
+	};
+
+
+	TCPServerMetrics& tcpServerMetrics()
+	{
+		static TCPServerMetrics metrics;
+		return metrics;
+	}
+}
+
+
 //
 // TCPServerConnectionFilter
 //
@@ -135,6 +163,7 @@ void TCPServer::run()
 				try
 				{
 					StreamSocket ss = _socket.acceptConnection();
+					tcpServerMetrics().accepted.inc();
 					
 					if (!_pConnectionFilter || _pConnectionFilter->accept(ss))
 					{
@@ -147,6 +176,7 @@ void TCPServer::run()
 						}
 						_pDispatcher->enqueue(ss);
 					}
+					else tcpServerMetrics().filtered.inc();
 				}
 				catch (Poco::Exception& exc)
 				{
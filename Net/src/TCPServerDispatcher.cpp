@@ -17,18 +17,52 @@
 #include "Poco/Notification.h"
 #include "Poco/AutoPtr.h"
 #include "Poco/ErrorHandler.h"
+#include "Poco/MetricRegistry.h"
+#include "Poco/Timestamp.h"
 #include <memory>
 
 
 using Poco::Notification;
 using Poco::FastMutex;
 using Poco::AutoPtr;
+using Poco::MetricRegistry;
+using Poco::MetricCounter;
+using Poco::MetricGauge;
+using Poco::MetricHistogram;
 
 
 namespace Poco {
 namespace Net {
 
 
+namespace
+{
+	struct DispatcherMetrics
+	{
+		DispatcherMetrics():
+			refused(MetricRegistry::defaultRegistry().counter("poco_tcp_server_connections_refused_total",
+				"Total number of connections refused because the queue was full or no thread was available.")),
+			active(MetricRegistry::defaultRegistry().gauge("poco_tcp_server_connections_active",
+				"Number of connections currently being handled by TCP servers.")),
+			duration(MetricRegistry::defaultRegistry().histogram("poco_tcp_server_connection_duration_seconds",
+				"Time taken to handle TCP server connections.", 1e-6))
+		{
+		}
+
+		MetricCounter&   refused;
+		MetricGauge&     active;
+		MetricHistogram& duration;
+	};
+
+
+	DispatcherMetrics& dispatcherMetrics()
+	{
+		static DispatcherMetrics metrics;
+		return metrics;
+	}
+}
+
+
 class TCPConnectionNotification: public Notification
 {
 public:
@@ -111,7 +145,9 @@ void TCPServerDispatcher::run()
 						std::unique_ptr<TCPServerConnection> pConnection(_pConnectionFactory->createConnection(pCNf->socket()));
 						poco_check_ptr(pConnection.get());
 						beginConnection();
+						Timestamp started;
 						pConnection->start();
+						dispatcherMetrics().duration.record(started.elapsed());
 						endConnection();
 					}
 				}
@@ -147,6 +183,7 @@ void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 			catch (Poco::Exception&)
 			{
 				++_refusedConnections;
+				dispatcherMetrics().refused.inc();
 				return;
 			}
 		}
@@ -155,6 +192,7 @@ void TCPServerDispatcher::enqueue(const StreamSocket& socket)
 	else
 	{
 		++_refusedConnections;
+		dispatcherMetrics().refused.inc();
 	}
 }
 
@@ -218,12 +256,14 @@ void TCPServerDispatcher::beginConnection()
 	++_currentConnections;
 	if (_currentConnections > _maxConcurrentConnections)
 		_maxConcurrentConnections.store(_currentConnections);
+	dispatcherMetrics().active.inc();
 }
 
 
 void TCPServerDispatcher::endConnection()
 {
 	--_currentConnections;
+	dispatcherMetrics().active.dec();
 }
 
 
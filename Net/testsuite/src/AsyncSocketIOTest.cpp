@@ -0,0 +1,178 @@
+//
+// AsyncSocketIOTest.cpp
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#include "AsyncSocketIOTest.h"
+#include "CppUnit/TestCaller.h"
+#include "CppUnit/TestSuite.h"
+#include "EchoServer.h"
+#include "Poco/Net/AsyncSocketIO.h"
+#include "Poco/Net/StreamSocket.h"
+#include "Poco/Net/ServerSocket.h"
+#include "Poco/Net/SocketAddress.h"
+#include <vector>
+
+
+using Poco::Net::AsyncSocketIO;
+using Poco::Net::StreamSocket;
+using Poco::Net::ServerSocket;
+using Poco::Net::SocketAddress;
+
+
+AsyncSocketIOTest::AsyncSocketIOTest(const std::string& name): CppUnit::TestCase(name)
+{
+}
+
+
+AsyncSocketIOTest::~AsyncSocketIOTest()
+{
+}
+
+
+void AsyncSocketIOTest::testEcho()
+{
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", echoServer.port()));
+
+	AsyncSocketIO io;
+	char buffer[256];
+	int sent = 0;
+	int received = 0;
+	io.sendBytes(ss, "hello", 5, [&](int n)
+	{
+		sent = n;
+		io.receiveBytes(ss, buffer, sizeof(buffer), [&](int n)
+		{
+			received = n;
+			io.stop();
+		});
+	});
+	io.run();
+	assert (sent == 5);
+	assert (received == 5);
+	assert (std::string(buffer, 5) == "hello");
+	ss.close();
+}
+
+
+void AsyncSocketIOTest::testAccept()
+{
+	ServerSocket server(SocketAddress("127.0.0.1", 0));
+	StreamSocket client;
+	client.connect(SocketAddress("127.0.0.1", server.address().port()));
+	client.sendBytes("ping", 4);
+
+	AsyncSocketIO io(Poco::Timespan(0, 100000));
+	char buffer[256];
+	std::string request;
+	io.acceptConnection(server, [&](StreamSocket& connection)
+	{
+		io.receiveBytes(connection, buffer, sizeof(buffer), [&, connection](int n)
+		{
+			request.assign(buffer, n);
+			io.sendBytes(connection, "pong", 4, [&](int)
+			{
+				io.stop();
+			});
+		});
+	});
+	io.run();
+	assert (request == "ping");
+
+	int n = client.receiveBytes(buffer, sizeof(buffer));
+	assert (n == 4);
+	assert (std::string(buffer, n) == "pong");
+}
+
+
+void AsyncSocketIOTest::testSendLarge()
+{
+	ServerSocket server(SocketAddress("127.0.0.1", 0));
+	StreamSocket client;
+	client.connect(SocketAddress("127.0.0.1", server.address().port()));
+	StreamSocket connection = server.acceptConnection();
+
+	const int size = 4*1024*1024;
+	std::vector<char> data(size);
+	for (int i = 0; i < size; ++i) data[i] = static_cast<char>(i*7);
+
+	AsyncSocketIO io;
+	int sent = 0;
+	io.sendBytes(client, &data[0], size, [&](int n)
+	{
+		sent = n;
+	});
+
+	// receive with the same loop, otherwise the sender would block
+	std::vector<char> received;
+	std::vector<char> buffer(65536);
+	std::function<void(int)> onReceive = [&](int n)
+	{
+		if (n > 0)
+		{
+			received.insert(received.end(), buffer.begin(), buffer.begin() + n);
+			if (received.size() < data.size())
+			{
+				io.receiveBytes(connection, &buffer[0], static_cast<int>(buffer.size()), onReceive);
+				return;
+			}
+		}
+		io.stop();
+	};
+	io.receiveBytes(connection, &buffer[0], static_cast<int>(buffer.size()), onReceive);
+	io.run();
+
+	assert (sent == size);
+	assert (received == data);
+}
+
+
+void AsyncSocketIOTest::testClosed()
+{
+	ServerSocket server(SocketAddress("127.0.0.1", 0));
+	StreamSocket client;
+	client.connect(SocketAddress("127.0.0.1", server.address().port()));
+	StreamSocket connection = server.acceptConnection();
+	client.close();
+
+	AsyncSocketIO io;
+	char buffer[16];
+	int result = -1;
+	io.receiveBytes(connection, buffer, sizeof(buffer), [&](int n)
+	{
+		result = n;
+		io.stop();
+	});
+	io.run();
+	assert (result == 0);
+}
+
+
+void AsyncSocketIOTest::setUp()
+{
+}
+
+
+void AsyncSocketIOTest::tearDown()
+{
+}
+
+
+CppUnit::Test* AsyncSocketIOTest::suite()
+{
+	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("AsyncSocketIOTest");
+
+	CppUnit_addTest(pSuite, AsyncSocketIOTest, testEcho);
+	CppUnit_addTest(pSuite, AsyncSocketIOTest, testAccept);
+	CppUnit_addTest(pSuite, AsyncSocketIOTest, testSendLarge);
+	CppUnit_addTest(pSuite, AsyncSocketIOTest, testClosed);
+
+	return pSuite;
+}
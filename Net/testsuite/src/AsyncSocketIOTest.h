@@ -0,0 +1,39 @@
+//
+// AsyncSocketIOTest.h
+//
+// Definition of the AsyncSocketIOTest class.
+//
+// Copyright (c) 2019, Applied Informatics Software Engineering GmbH.
+// and Contributors.
+//
+// SPDX-License-Identifier:	BSL-1.0
+//
+
+
+#ifndef AsyncSocketIOTest_INCLUDED
+#define AsyncSocketIOTest_INCLUDED
+
+
+#include "Poco/Net/Net.h"
+#include "CppUnit/TestCase.h"
+
+
+class AsyncSocketIOTest: public CppUnit::TestCase
+{
+public:
+	AsyncSocketIOTest(const std::string& name);
+	~AsyncSocketIOTest();
+
+	void testEcho();
+	void testAccept();
+	void testSendLarge();
+	void testClosed();
+
+	void setUp();
+	void tearDown();
+
+	static CppUnit::Test* suite();
+};
+
+
+#endif // AsyncSocketIOTest_INCLUDED
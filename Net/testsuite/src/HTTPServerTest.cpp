@@ -15,6 +15,7 @@
 #include "Poco/Net/HTTPServerParams.h"
 #include "Poco/Net/AbstractHTTPRequestHandler.h"
 #include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/PrometheusRequestHandler.h"
 #include "Poco/Net/HTTPClientSession.h"
 #include "Poco/Net/HTTPRequest.h"
 #include "Poco/Net/HTTPServerRequest.h"
@@ -30,6 +31,7 @@ using Poco::Net::HTTPServerParams;
 using Poco::Net::HTTPRequestHandler;
 using Poco::Net::AbstractHTTPRequestHandler;
 using Poco::Net::HTTPRequestHandlerFactory;
+using Poco::Net::PrometheusRequestHandler;
 using Poco::Net::HTTPClientSession;
 using Poco::Net::HTTPRequest;
 using Poco::Net::HTTPServerRequest;
@@ -119,6 +121,8 @@ namespace
 				return new AuthRequestHandler();
 			else if (request.getURI() == "/buffer")
 				return new BufferRequestHandler();
+			else if (request.getURI() == "/metrics")
+				return new PrometheusRequestHandler();
 			else
 				return 0;
 		}
@@ -516,6 +520,36 @@ void HTTPServerTest::testBuffer()
 }
 
 
+void HTTPServerTest::testPrometheus()
+{
+	ServerSocket svs(0);
+	HTTPServerParams* pParams = new HTTPServerParams;
+	pParams->setKeepAlive(false);
+	HTTPServer srv(new RequestHandlerFactory, svs, pParams);
+	srv.start();
+	
+	HTTPClientSession cs("127.0.0.1", svs.address().port());
+	HTTPRequest request("GET", "/metrics");
+	cs.sendRequest(request);
+	HTTPResponse response;
+	std::string rbody;
+	StreamCopier::copyToString(cs.receiveResponse(response), rbody);
+	assert (response.getStatus() == HTTPResponse::HTTP_OK);
+	assert (response.getContentType() == PrometheusRequestHandler::CONTENT_TYPE);
+	assert (response.getContentLength() == rbody.size());
+	assert (rbody.find("# TYPE poco_http_server_requests_total counter\n") != std::string::npos);
+	assert (rbody.find("# TYPE poco_tcp_server_connections_active gauge\n") != std::string::npos);
+
+	HTTPClientSession cs2("127.0.0.1", svs.address().port());
+	HTTPRequest request2("POST", "/metrics");
+	request2.setContentLength(0);
+	cs2.sendRequest(request2);
+	cs2.receiveResponse(response) >> rbody;
+	assert (response.getStatus() == HTTPResponse::HTTP_METHOD_NOT_ALLOWED);
+	assert (response.get("Allow") == "GET, HEAD");
+}
+
+
 void HTTPServerTest::setUp()
 {
 }
@@ -544,6 +578,7 @@ CppUnit::Test* HTTPServerTest::suite()
 	CppUnit_addTest(pSuite, HTTPServerTest, testAuth);
 	CppUnit_addTest(pSuite, HTTPServerTest, testNotImpl);
 	CppUnit_addTest(pSuite, HTTPServerTest, testBuffer);
+	CppUnit_addTest(pSuite, HTTPServerTest, testPrometheus);
 
 	return pSuite;
 }
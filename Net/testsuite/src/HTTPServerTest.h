@@ -38,6 +38,7 @@ public:
 	void testAuth();
 	void testNotImpl();
 	void testBuffer();
+	void testPrometheus();
 
 	void setUp();
 	void tearDown();
@@ -13,6 +13,7 @@
 #include "CppUnit/TestSuite.h"
 #include "Poco/Net/NameValueCollection.h"
 #include "Poco/Exception.h"
+#include "Poco/Arena.h"
 
 
 using Poco::Net::NameValueCollection;
@@ -106,6 +107,34 @@ void NameValueCollectionTest::testNameValueCollection()
 }
 
 
+void NameValueCollectionTest::testArena()
+{
+	Poco::Arena arena;
+	NameValueCollection nvc(arena);
+
+	nvc.set("name", "value");
+	nvc.add("name2", "value2");
+	assert (nvc.size() == 2);
+	assert (nvc["Name"] == "value");
+	assert (nvc.get("name2") == "value2");
+	assert (arena.allocated() > 0);
+
+	NameValueCollection copy(nvc);
+	assert (copy.size() == 2);
+	assert (copy["name2"] == "value2");
+
+	NameValueCollection other;
+	other.swap(nvc);
+	assert (other.size() == 2);
+	assert (nvc.empty());
+
+	other.erase("name");
+	assert (other.size() == 1);
+	other.clear();
+	assert (other.empty());
+}
+
+
 void NameValueCollectionTest::setUp()
 {
 }
@@ -121,6 +150,7 @@ CppUnit::Test* NameValueCollectionTest::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("NameValueCollectionTest");
 
 	CppUnit_addTest(pSuite, NameValueCollectionTest, testNameValueCollection);
+	CppUnit_addTest(pSuite, NameValueCollectionTest, testArena);
 
 	return pSuite;
 }
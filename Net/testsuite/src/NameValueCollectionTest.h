@@ -25,6 +25,7 @@ public:
 	~NameValueCollectionTest();
 
 	void testNameValueCollection();
+	void testArena();
 
 	void setUp();
 	void tearDown();
@@ -10,6 +10,9 @@
 
 #include "ReactorTestSuite.h"
 #include "SocketReactorTest.h"
+#if defined(POCO_OS_FAMILY_UNIX)
+#include "AsyncSocketIOTest.h"
+#endif
 
 
 CppUnit::Test* ReactorTestSuite::suite()
@@ -17,6 +20,9 @@ CppUnit::Test* ReactorTestSuite::suite()
 	CppUnit::TestSuite* pSuite = new CppUnit::TestSuite("ReactorTestSuite");
 
 	pSuite->addTest(SocketReactorTest::suite());
+#if defined(POCO_OS_FAMILY_UNIX)
+	pSuite->addTest(AsyncSocketIOTest::suite());
+#endif
 
 	return pSuite;
 }
@@ -17,12 +17,19 @@
 #include "Poco/Net/ServerSocket.h"
 #include "Poco/Net/SocketAddress.h"
 #include "Poco/Net/NetException.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/FileStream.h"
+#include "Poco/TemporaryFile.h"
+#include "Poco/Thread.h"
+#include "Poco/Runnable.h"
 #include "Poco/Timespan.h"
 #include "Poco/Stopwatch.h"
+#include <iostream>
 
 
 using Poco::Net::Socket;
 using Poco::Net::SocketStream;
+using Poco::Net::SocketOutputStream;
 using Poco::Net::StreamSocket;
 using Poco::Net::ServerSocket;
 using Poco::Net::SocketAddress;
@@ -31,6 +38,44 @@ using Poco::Timespan;
 using Poco::Stopwatch;
 using Poco::TimeoutException;
 using Poco::InvalidArgumentException;
+using Poco::StreamCopier;
+using Poco::FileInputStream;
+using Poco::FileOutputStream;
+using Poco::TemporaryFile;
+
+
+namespace
+{
+	class DiscardingReceiver: public Poco::Runnable
+	{
+	public:
+		DiscardingReceiver(const StreamSocket& socket):
+			_socket(socket),
+			_received(0)
+		{
+		}
+
+		void run()
+		{
+			char buffer[65536];
+			int n = _socket.receiveBytes(buffer, sizeof(buffer));
+			while (n > 0)
+			{
+				_received += n;
+				n = _socket.receiveBytes(buffer, sizeof(buffer));
+			}
+		}
+
+		Poco::UInt64 received() const
+		{
+			return _received;
+		}
+
+	private:
+		StreamSocket _socket;
+		Poco::UInt64 _received;
+	};
+}
 
 
 SocketStreamTest::SocketStreamTest(const std::string& name): CppUnit::TestCase(name)
@@ -120,6 +165,70 @@ void SocketStreamTest::testEOF()
 }
 
 
+void SocketStreamTest::testCopyFile()
+{
+	std::string data;
+	for (int i = 0; i < 30000; ++i) data += char(i % 251);
+	TemporaryFile file;
+	{
+		FileOutputStream ostr(file.path());
+		ostr << data;
+	}
+
+	EchoServer echoServer;
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", echoServer.port()));
+	SocketStream str(ss);
+	str << "hello";
+	FileInputStream istr(file.path());
+	std::streamsize n = StreamCopier::copyStream(istr, str);
+	assert (n == data.size());
+	assert (str.good());
+	str << "bye";
+	str.flush();
+	ss.shutdownSend();
+
+	std::string echo;
+	StreamCopier::copyToString(str, echo);
+	assert (echo == "hello" + data + "bye");
+
+	ss.close();
+}
+
+
+void SocketStreamTest::benchmarkCopyFile()
+{
+	const std::size_t size = 256*1024*1024;
+	TemporaryFile file;
+	{
+		FileOutputStream ostr(file.path());
+		std::string block(1024*1024, 'x');
+		for (std::size_t i = 0; i < size/block.size(); ++i) ostr << block;
+	}
+
+	ServerSocket server(SocketAddress("127.0.0.1", 0));
+	StreamSocket ss;
+	ss.connect(SocketAddress("127.0.0.1", server.address().port()));
+	DiscardingReceiver receiver(server.acceptConnection());
+	Poco::Thread thread;
+	thread.start(receiver);
+
+	SocketOutputStream str(ss);
+	FileInputStream istr(file.path());
+	Stopwatch sw;
+	sw.start();
+	StreamCopier::copyStream(istr, str);
+	str.flush();
+	ss.shutdownSend();
+	thread.join();
+	sw.stop();
+	assert (receiver.received() == size);
+	std::cout << "copyStream (file to socket): " << double(size)*Stopwatch::resolution()/sw.elapsed()/1e9 << " GB/s" << std::endl;
+
+	ss.close();
+}
+
+
 void SocketStreamTest::setUp()
 {
 }
@@ -137,6 +246,8 @@ CppUnit::Test* SocketStreamTest::suite()
 	CppUnit_addTest(pSuite, SocketStreamTest, testStreamEcho);
 	CppUnit_addTest(pSuite, SocketStreamTest, testLargeStreamEcho);
 	CppUnit_addTest(pSuite, SocketStreamTest, testEOF);
+	CppUnit_addTest(pSuite, SocketStreamTest, testCopyFile);
+	//CppUnit_addTest(pSuite, SocketStreamTest, benchmarkCopyFile);
 
 	return pSuite;
 }
@@ -27,6 +27,8 @@ public:
 	void testStreamEcho();
 	void testLargeStreamEcho();
 	void testEOF();
+	void testCopyFile();
+	void benchmarkCopyFile();
 
 	void setUp();
 	void tearDown();
@@ -105,7 +105,7 @@ void JSONConfiguration::getIndexes(std::string& name, std::vector<int>& indexes)
 	RegularExpression::MatchVec matches;
 	int firstOffset = -1;
 	int offset = 0;
-	RegularExpression regex("\\[([0-9]+)\\]");
+	static const RegularExpression regex("\\[([0-9]+)\\]");
 	while(regex.match(name, offset, matches) > 0 )
 	{
 		if ( firstOffset == -1 )
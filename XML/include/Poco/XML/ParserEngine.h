@@ -186,8 +186,15 @@ protected:
 	void init();
 		/// initializes expat
 
+	void parseBuffer(const char* pBuffer, std::size_t size);
+		/// Parses an entity from the given buffer.
+
 	void parseByteInputStream(XMLByteInputStream& istr);
 		/// Parses an entity from the given stream.
+		///
+		/// If the stream is a Poco::MappedInputStream and partial
+		/// reads are disabled, the remaining contents of the mapped
+		/// file are parsed directly from memory.
 
 	void parseCharInputStream(XMLCharInputStream& istr);
 		/// Parses an entity from the given stream.
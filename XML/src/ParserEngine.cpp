@@ -27,6 +27,7 @@
 #include "Poco/SAX/LocatorImpl.h"
 #include "Poco/SAX/SAXException.h"
 #include "Poco/URI.h"
+#include "Poco/MappedInputStream.h"
 #include <cstring>
 
 
@@ -243,6 +244,14 @@ void ParserEngine::parse(const char* pBuffer, std::size_t size)
 	pushContext(_parser, &src);
 	if (_pContentHandler) _pContentHandler->setDocumentLocator(this);
 	if (_pContentHandler) _pContentHandler->startDocument();
+	parseBuffer(pBuffer, size);
+	if (_pContentHandler) _pContentHandler->endDocument();
+	popContext();
+}
+
+
+void ParserEngine::parseBuffer(const char* pBuffer, std::size_t size)
+{
 	std::size_t processed = 0;
 	while (processed < size)
 	{
@@ -253,13 +262,22 @@ void ParserEngine::parse(const char* pBuffer, std::size_t size)
 	}
 	if (!XML_Parse(_parser, pBuffer+processed, 0, 1))
 		handleError(XML_GetErrorCode(_parser));
-	if (_pContentHandler) _pContentHandler->endDocument();
-	popContext();
 }
 
 
 void ParserEngine::parseByteInputStream(XMLByteInputStream& istr)
 {
+	Poco::MappedInputStream* pMapped = _enablePartialReads ? 0 : dynamic_cast<Poco::MappedInputStream*>(&istr);
+	if (pMapped)
+	{
+		// parse directly from the mapped file
+		const char* pBuffer = pMapped->current();
+		std::size_t size = pMapped->end() - pBuffer;
+		pMapped->skip(size);
+		parseBuffer(pBuffer, size);
+		return;
+	}
+
 	std::streamsize n = readBytes(istr, _pBuffer, PARSE_BUFFER_SIZE);
 	while (n > 0)
 	{
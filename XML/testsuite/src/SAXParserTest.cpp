@@ -19,6 +19,8 @@
 #include "Poco/XML/XMLWriter.h"
 #include "Poco/Latin9Encoding.h"
 #include "Poco/FileStream.h"
+#include "Poco/MappedInputStream.h"
+#include "Poco/TemporaryFile.h"
 #include <sstream>
 
 
@@ -313,6 +315,28 @@ void SAXParserTest::testParsePartialReads()
 }
 
 
+void SAXParserTest::testParseMapped()
+{
+	Poco::TemporaryFile tempFile;
+	{
+		Poco::FileOutputStream ostr(tempFile.path());
+		ostr << WSDL;
+	}
+	Poco::MappedInputStream istr(tempFile.path());
+	std::ostringstream ostr;
+	XMLWriter writer(ostr, XMLWriter::CANONICAL | XMLWriter::PRETTY_PRINT);
+	writer.setNewLine(XMLWriter::NEWLINE_LF);
+	SAXParser parser;
+	parser.setContentHandler(&writer);
+	parser.setDTDHandler(&writer);
+	parser.setProperty(XMLReader::PROPERTY_LEXICAL_HANDLER, static_cast<Poco::XML::LexicalHandler*>(&writer));
+	InputSource source(istr);
+	parser.parse(&source);
+	assert (ostr.str() == WSDL);
+	assert (istr.current() == istr.end());
+}
+
+
 void SAXParserTest::setUp()
 {
 }
@@ -378,6 +402,7 @@ CppUnit::Test* SAXParserTest::suite()
 	CppUnit_addTest(pSuite, SAXParserTest, testCharacters);
 	CppUnit_addTest(pSuite, SAXParserTest, testParseMemory);
 	CppUnit_addTest(pSuite, SAXParserTest, testParsePartialReads);
+	CppUnit_addTest(pSuite, SAXParserTest, testParseMapped);
 
 	return pSuite;
 }